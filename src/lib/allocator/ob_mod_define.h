@@ -231,6 +231,7 @@ MOD_ITEM_DEF(OB_PROXY_SHARDING_EXPR)
 MOD_ITEM_DEF(OB_PROXY_SHARDING_PARSE)
 MOD_ITEM_DEF(OB_PROXY_SHARDING_CONFIG)
 MOD_ITEM_DEF(OB_PROXY_SHARDING_DDL)
+MOD_ITEM_DEF(OB_PROXY_SHARDING_MULTI_STMT)
 MOD_ITEM_DEF(OB_PROXY_QOS)
 MOD_ITEM_DEF(OB_PROXY_SSL_RELATED)
 MOD_ITEM_DEF(OB_PROXY_CONFIG_TABLE)
@@ -51,6 +51,9 @@ enum
   OB_TC_PROTECTED_QUEUE_AL_SIZE,
   OB_TC_PROTECTED_QUEUE_LOCAL_SIZE,
   OB_TC_PRIORITY_QUEUE_SIZE,
+  OB_TC_IOBUFFER_CACHE_HIT,
+  OB_TC_IOBUFFER_CACHE_MISS,
+  OB_TC_IOBUFFER_CACHED_BYTES,
   OB_TC_MAX_THREAD_COLUMN_ID,
 };
 
@@ -108,7 +111,10 @@ const ObProxyColumnSchema THREAD_COLUMN_ARRAY[OB_TC_MAX_THREAD_COLUMN_ID] = {
     ObProxyColumnSchema::make_schema(OB_TC_TOTAL_WRITE_BYTES,            "total_write_bytes",                      OB_MYSQL_TYPE_LONGLONG),
     ObProxyColumnSchema::make_schema(OB_TC_PROTECTED_QUEUE_AL_SIZE,      "protected_queue_al_size",                OB_MYSQL_TYPE_LONGLONG),
     ObProxyColumnSchema::make_schema(OB_TC_PROTECTED_QUEUE_LOCAL_SIZE,   "protected_queue_local_size",             OB_MYSQL_TYPE_LONGLONG),
-    ObProxyColumnSchema::make_schema(OB_TC_PRIORITY_QUEUE_SIZE,          "priority_queue_size",                    OB_MYSQL_TYPE_LONGLONG)
+    ObProxyColumnSchema::make_schema(OB_TC_PRIORITY_QUEUE_SIZE,          "priority_queue_size",                    OB_MYSQL_TYPE_LONGLONG),
+    ObProxyColumnSchema::make_schema(OB_TC_IOBUFFER_CACHE_HIT,           "iobuffer_cache_hit",                     OB_MYSQL_TYPE_LONGLONG),
+    ObProxyColumnSchema::make_schema(OB_TC_IOBUFFER_CACHE_MISS,          "iobuffer_cache_miss",                    OB_MYSQL_TYPE_LONGLONG),
+    ObProxyColumnSchema::make_schema(OB_TC_IOBUFFER_CACHED_BYTES,        "iobuffer_cached_bytes",                  OB_MYSQL_TYPE_LONGLONG)
 };
 
 const ObProxyColumnSchema CONN_COLUMN_ARRAY[OB_CC_MAX_CONN_COLUMN_ID] = {
@@ -352,6 +358,9 @@ int ObShowNetHandler::dump_single_thread(ObEThread *ethread, const ObNetHandler
     ObObj cells[OB_TC_MAX_THREAD_COLUMN_ID];
     int64_t current_conn_count = 0;
     int64_t result = ethread->get_net_poll().get_poll_descriptor().result_;
+    int64_t iobuf_hit_count = 0;
+    int64_t iobuf_miss_count = 0;
+    int64_t iobuf_cached_bytes = 0;
     forl_LL(ObUnixNetVConnection, vc, nh.open_list_) {
       ++current_conn_count;
     }
@@ -378,6 +387,11 @@ int ObShowNetHandler::dump_single_thread(ObEThread *ethread, const ObNetHandler
     cells[OB_TC_PROTECTED_QUEUE_AL_SIZE].set_int(ethread->event_queue_external_.get_atomic_list_size());
     cells[OB_TC_PROTECTED_QUEUE_LOCAL_SIZE].set_int(ethread->event_queue_external_.get_local_queue_size());
     cells[OB_TC_PRIORITY_QUEUE_SIZE].set_int(ethread->event_queue_.get_queue_size());
+    // the freelists are thread local, this runs on ethread
+    get_thread_iobuffer_cache_stat(iobuf_hit_count, iobuf_miss_count, iobuf_cached_bytes);
+    cells[OB_TC_IOBUFFER_CACHE_HIT].set_int(iobuf_hit_count);
+    cells[OB_TC_IOBUFFER_CACHE_MISS].set_int(iobuf_miss_count);
+    cells[OB_TC_IOBUFFER_CACHED_BYTES].set_int(iobuf_cached_bytes);
 
     row.cells_ = cells;
     row.count_ = OB_TC_MAX_THREAD_COLUMN_ID;
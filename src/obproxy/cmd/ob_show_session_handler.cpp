@@ -495,6 +495,8 @@ int ObShowSessionHandler::dump_cs_attribute(const ObMysqlClientSession &cs)
       WARN_ICMD("fail to dump attribute item", K(ret));
     } else if (OB_FAIL(dump_cs_attribute_item("db_name_version", client_info.get_db_name_version(), cs_var_info))) {
       WARN_ICMD("fail to dump attribute item", K(ret));
+    } else if (OB_FAIL(dump_cs_attribute_item("same_value_sys_var_set_count", client_info.get_same_value_sys_var_set_count(), cs_var_info))) {
+      WARN_ICMD("fail to dump attribute item", K(ret));
     } else {}
   }
 
@@ -125,6 +125,9 @@ int ObProxyParallelExecuteCont::init(const ObProxyParallelParam &parallel_param,
       LOG_WARN("fail to create mysql client pool", K(username), K(database_name), K(ret));
     } else if (OB_FAIL(deep_copy_sql(parallel_param.request_sql_))) {
       LOG_WARN("fail to deep_copy_sql", K(parallel_param.request_sql_), K(ret));
+    } else if (!parallel_param.session_sql_.empty()
+               && OB_FAIL(ob_write_string(*allocator, parallel_param.session_sql_, session_sql_))) {
+      LOG_WARN("fail to write session sql", K(parallel_param.session_sql_), K(ret));
     } else {
       cont_index_ = cont_index;
       allocator_ = allocator;
@@ -166,12 +169,14 @@ void ObProxyParallelExecuteCont::reset_request_sql()
 
 int ObProxyParallelExecuteCont::init_task()
 {
-  int ret = OB_SUCCESS;  
+  int ret = OB_SUCCESS;
 
   ObMysqlRequestParam request_param;
   request_param.ob_client_flags_.client_flags_.OB_CLIENT_SKIP_AUTOCOMMIT = 1;
   request_param.ob_client_flags_.client_flags_.OB_CLIENT_SEND_REQUEST_DIRECT = 1;
   request_param.sql_ = request_sql_;
+  // the mysql client sends it right before request_sql_ on the same connection
+  request_param.session_sql_ = session_sql_;
   if (OB_FAIL(mysql_proxy_->async_read(this, request_param, pending_action_))) {
     LOG_WARN("fail to async read", K_(request_sql), K(ret));
   }
@@ -187,6 +192,7 @@ int ObProxyParallelExecuteCont::finish_task(void *data)
             KP_(cb_cont), K_(request_sql), KPC_(shard_conn), K(ret));
 
   if (NULL != data) {
+    // an error of the session sql is returned as the error of this stmt
     ObClientMysqlResp *resp = NULL;
     if (OB_ISNULL(result_set_ = op_alloc_args(ObProxyParallelResp, cont_index_))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -40,6 +40,7 @@ public:
   bool is_resultset_resp() const { return resp_->is_resultset_resp(); }
   uint16_t get_err_code() const { return resp_->get_err_code(); }
   common::ObString get_err_msg() const {return resp_->get_err_msg(); }
+  int get_affected_rows(int64_t &affected_rows) { return resp_->get_affected_rows(affected_rows); }
 
   ObMysqlField *get_field() const { return rs_fetcher_->get_field(); }
   int64_t get_column_count() { return column_count_; }
@@ -59,8 +60,8 @@ class ObProxyParallelExecuteCont : public obutils::ObAsyncCommonTask
 public:
   ObProxyParallelExecuteCont(event::ObProxyMutex *m, event::ObContinuation *cb_cont, event::ObEThread *submit_thread)
       : ObAsyncCommonTask(m, "parallel execute cont", cb_cont, submit_thread),
-        shard_conn_(NULL), is_deep_copy_(false), request_sql_(), mysql_proxy_(NULL),
-        result_set_(NULL), cont_index_(-1) {}
+        shard_conn_(NULL), is_deep_copy_(false), request_sql_(), session_sql_(),
+        mysql_proxy_(NULL), result_set_(NULL), cont_index_(-1) {}
   ~ObProxyParallelExecuteCont() {}
 
   int init(const ObProxyParallelParam &parallel_param, const int64_t cont_index,
@@ -82,6 +83,7 @@ private:
   dbconfig::ObShardConnector* shard_conn_;
   bool is_deep_copy_;
   common::ObString request_sql_;
+  common::ObString session_sql_;
   proxy::ObMysqlProxy* mysql_proxy_;
   ObProxyParallelResp *result_set_;
   int64_t cont_index_;
@@ -27,15 +27,17 @@ namespace executor
 class ObProxyParallelParam
 {
 public:    
-  ObProxyParallelParam() : shard_conn_(NULL), shard_prop_(NULL), request_sql_() {}
+  ObProxyParallelParam() : shard_conn_(NULL), shard_prop_(NULL), request_sql_(), session_sql_() {}
   ~ObProxyParallelParam() {}
 
-  TO_STRING_KV(KPC_(shard_conn), K_(request_sql));
+  TO_STRING_KV(KPC_(shard_conn), K_(request_sql), K_(session_sql));
 
 public:    
   dbconfig::ObShardConnector* shard_conn_;
   dbconfig::ObShardProp* shard_prop_;
   common::ObString request_sql_;
+  // optional, set the session variables of the client before request_sql_
+  common::ObString session_sql_;
 };
 
 class ObProxyParallelProcessor
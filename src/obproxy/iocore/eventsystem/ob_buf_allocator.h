@@ -49,41 +49,32 @@ namespace event
 #define DEFAULT_BUFFER_BASE_SHIFT    7
 #define DEFAULT_BUFFER_BASE_SIZE     (1 << DEFAULT_BUFFER_BASE_SHIFT)
 
-/**
- * These are defines so that code that used 2
- * for buffer size index when 2 was 2K will
- * still work if it uses BUFFER_SIZE_INDEX_2K
- * instead.
- */
-#define BUFFER_SIZE_INDEX_128           0
-#define BUFFER_SIZE_INDEX_256           1
-#define BUFFER_SIZE_INDEX_512           2
-#define BUFFER_SIZE_INDEX_1K            3
-#define BUFFER_SIZE_INDEX_2K            4
-#define BUFFER_SIZE_INDEX_4K            5
-#define BUFFER_SIZE_INDEX_8K            6
-#define MAX_BUFFER_SIZE_INDEX           6
-#define BUFFER_SIZE_INDEX_COUNT         (MAX_BUFFER_SIZE_INDEX + 1)
-
+// BUFFER_SIZE_INDEX_* are defined in ob_thread_allocator.h
 #define BUFFER_SIZE_FOR_INDEX(i)     (DEFAULT_BUFFER_BASE_SIZE * (1 << (i)))
 #define DEFAULT_MAX_BUFFER_SIZE      BUFFER_SIZE_FOR_INDEX(MAX_BUFFER_SIZE_INDEX)
 #define DEFAULT_SMALL_BUFFER_SIZE    BUFFER_SIZE_FOR_INDEX(BUFFER_SIZE_INDEX_512)
 #define DEFAULT_LARGE_BUFFER_SIZE    BUFFER_SIZE_FOR_INDEX(BUFFER_SIZE_INDEX_8K)
 
+// bytes of each size class cached by one thread, see iobuffer_thread_cache_size
+#define DEFAULT_THREAD_BUF_CACHE_SIZE   (512 * 1024)
+
 class ObBufAllocator
 {
 public:
-  ObBufAllocator() { }
+  ObBufAllocator() { set_thread_cache_size(DEFAULT_THREAD_BUF_CACHE_SIZE); }
 
   ~ObBufAllocator() { }
 
+  // every size class is served from the per thread freelist first, a chunk
+  // freed by another thread is kept by that thread, and flows back to the
+  // global allocator in batch once the freelist goes beyond the high watermark
+  // of its class
   void *alloc(const int64_t size)
   {
     void *ret = NULL;
-    if (DEFAULT_MAX_BUFFER_SIZE == size) {
-      ret = op_thread_fixed_mem_alloc(buf_allocator_[buffer_size_to_index(size)], get_8k_block_allocator());
-    } else if (size < DEFAULT_MAX_BUFFER_SIZE) {
-      ret = buf_allocator_[buffer_size_to_index(next_pow2(size))].alloc_void();
+    if (size <= DEFAULT_MAX_BUFFER_SIZE) {
+      const int64_t idx = buffer_size_to_index(size);
+      ret = op_thread_fixed_mem_alloc(buf_allocator_[idx], get_buf_freelist(idx));
     } else {
       ret = common::ob_malloc_align(DEFAULT_BUFFER_ALIGNMENT, size,
                                     common::ObModIds::OB_LARGE_IO_BUFFER);
@@ -93,10 +84,9 @@ public:
 
   void free(void *ptr, const int64_t size)
   {
-    if (DEFAULT_MAX_BUFFER_SIZE == size) {
-      op_thread_fixed_mem_free(buf_allocator_[buffer_size_to_index(size)], ptr, get_8k_block_allocator());
-    } else if (size < DEFAULT_MAX_BUFFER_SIZE) {
-      buf_allocator_[buffer_size_to_index(next_pow2(size))].free_void(ptr);
+    if (size <= DEFAULT_MAX_BUFFER_SIZE) {
+      const int64_t idx = buffer_size_to_index(size);
+      op_thread_fixed_mem_free(buf_allocator_[idx], ptr, get_buf_freelist(idx), high_watermarks_[idx]);
     } else {
       common::ob_free_align(ptr);
     }
@@ -122,6 +112,20 @@ public:
     return g_buf_allocator;
   }
 
+  // the high watermark of a class is the chunk count of thread_cache_size bytes,
+  // no more than g_thread_freelist_high_watermark, so every class caches about
+  // the same bytes per thread instead of the same chunk count, 0 disables the cache
+  void set_thread_cache_size(const int64_t thread_cache_size)
+  {
+    const int64_t cache_size = thread_cache_size > 0 ? thread_cache_size : 0;
+    for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+      const int64_t count = std::min(cache_size / BUFFER_SIZE_FOR_INDEX(i), g_thread_freelist_high_watermark);
+      ATOMIC_STORE(&high_watermarks_[i], count);
+    }
+  }
+
+  int64_t get_high_watermark(const int64_t idx) const { return high_watermarks_[idx]; }
+
 private:
   int init_buffer_allocators()
   {
@@ -152,11 +156,7 @@ private:
     return ret;
   }
 
-  int64_t next_pow2(const int64_t x)
-  {
-    return x ? (1ULL << (8 * sizeof(int64_t) - __builtin_clzll(x - 1))) : 1;
-  }
-
+  // round up to the size class
   int64_t buffer_size_to_index(const int64_t size)
   {
     return size > DEFAULT_BUFFER_BASE_SIZE
@@ -165,6 +165,7 @@ private:
 
 private:
   common::ObFixedMemAllocator buf_allocator_[BUFFER_SIZE_INDEX_COUNT];
+  int64_t high_watermarks_[BUFFER_SIZE_INDEX_COUNT];
 
   DISALLOW_COPY_AND_ASSIGN(ObBufAllocator);
 };
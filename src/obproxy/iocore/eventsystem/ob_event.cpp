@@ -150,7 +150,7 @@ int64_t ObEvent::to_string(char *buf, const int64_t buf_len) const
   int64_t pos = 0;
   J_OBJ_START();
   J_KV(K_(is_inited), K_(in_the_prot_queue), K_(in_the_priority_queue),
-       K_(in_heap), K_(callback_event), K_(timeout_at), K_(period)
+       "wheel_slot", wheel_entry_.slot_, K_(callback_event), K_(timeout_at), K_(period)
 #ifdef ENABLE_TIME_TRACE
        , K_(start_time)
 #endif
@@ -32,6 +32,7 @@
 #define OBPROXY_EVENT_H
 
 #include "iocore/eventsystem/ob_action.h"
+#include "iocore/eventsystem/ob_timing_wheel.h"
 
 namespace oceanbase
 {
@@ -207,7 +208,6 @@ public:
   uint32_t is_inited_:1;
   uint32_t in_the_prot_queue_:1;
   uint32_t in_the_priority_queue_:1;
-  uint32_t in_heap_:4;
   uint32_t is_thread_pool_event_;
   int32_t callback_event_;
 
@@ -221,6 +221,7 @@ public:
    * is called.
    */
   void *cookie_;
+  ObTimingWheelEntry wheel_entry_;
 
 #ifdef ENABLE_TIME_TRACE
   ObHRTime start_time_;
@@ -235,7 +236,6 @@ inline ObEvent::ObEvent()
     : is_inited_(false),
       in_the_prot_queue_(false),
       in_the_priority_queue_(false),
-      in_heap_(0),
       is_thread_pool_event_(false),
       callback_event_(EVENT_NONE),
       timeout_at_(0),
@@ -281,7 +281,8 @@ int ObEventProcessor::start(const int64_t net_thread_count, const int64_t stacks
 
           if (core_number > 0 && (core_number >= event_thread_count_ || 0 == (event_thread_count_ % cpu_number))) {
             bind_cpu = true;
-            PROXY_NET_LOG(INFO, "we will bind cpu to work thread", K(core_number), K(cpu_number), K_(event_thread_count));
+            PROXY_NET_LOG(INFO, "we will bind cpu to work thread", K(core_number), K(cpu_number),
+                          "numa_node_number", cpu_topology->get_numa_node_number(), K_(event_thread_count));
           } else {
             PROXY_NET_LOG(INFO, "we can't bind cpu to work thread", K(core_number), K(cpu_number), K_(event_thread_count));
           }
@@ -310,7 +311,9 @@ int ObEventProcessor::start(const int64_t net_thread_count, const int64_t stacks
           LOG_WARN("fail to start event thread", K(thr_name), K(ret));
         } else {
           if (bind_cpu) {
-            core_id = i % core_number;
+            // net threads are laid out node by node, a client session and
+            // the server sessions it drives stay on one thread, so on one node
+            core_id = cpu_topology->get_numa_ordered_core_id(i % core_number);
             if (OB_ISNULL(core_info = cpu_topology->get_core_info(core_id))) {
               ret = OB_ENTRY_NOT_EXIST;
               LOG_WARN("fail to get core_info", K(core_info), K(core_id), K(ret));
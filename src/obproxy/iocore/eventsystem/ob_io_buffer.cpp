@@ -358,6 +358,23 @@ void ObIOBufferReader::replace_with_char(const char mark,
   }
 }
 
+void get_thread_iobuffer_cache_stat(int64_t &hit_count, int64_t &miss_count, int64_t &cached_bytes)
+{
+  ObThreadAllocator &allocator = get_thread_allocator();
+  const ObProxyThreadAllocator &block_allocator = allocator.io_block_allocator_;
+  const ObProxyThreadAllocator &data_allocator = allocator.io_data_allocator_;
+  hit_count = block_allocator.hit_count_ + data_allocator.hit_count_;
+  miss_count = block_allocator.miss_count_ + data_allocator.miss_count_;
+  cached_bytes = block_allocator.allocated_ * static_cast<int64_t>(sizeof(ObIOBufferBlock))
+                 + data_allocator.allocated_ * static_cast<int64_t>(sizeof(ObIOBufferData));
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    const ObProxyThreadAllocator &buf_allocator = allocator.buf_allocator_[i];
+    hit_count += buf_allocator.hit_count_;
+    miss_count += buf_allocator.miss_count_;
+    cached_bytes += buf_allocator.allocated_ * BUFFER_SIZE_FOR_INDEX(i);
+  }
+}
+
 } // end of namespace event
 } // end of namespace obproxy
 } // end of namespace oceanbase
@@ -953,18 +953,7 @@ public:
   int check_add_block(const int64_t total_size);
   ObIOBufferBlock *get_current_block();
 
-  void reset()
-  {
-    if (NULL != writer_) {
-      writer_->reset();
-    }
-
-    for (int64_t i = 0; i < MAX_MIOBUFFER_READERS; ++i) {
-      if (readers_[i].is_allocated()) {
-        readers_[i].reset();
-      }
-    }
-  }
+  void reset();
 
   void init_readers()
   {
@@ -1103,6 +1092,11 @@ private:
 #endif
 extern void free_miobuffer(ObMIOBuffer *mio);
 
+// hits and misses of the io buffer freelists of the current thread,
+// and the bytes they are holding
+extern void get_thread_iobuffer_cache_stat(int64_t &hit_count, int64_t &miss_count,
+                                           int64_t &cached_bytes);
+
 extern ObIOBufferBlock *new_iobufferblock_internal(
 #ifdef TRACK_BUFFER_USER
     const char *loc
@@ -1765,6 +1759,27 @@ inline ObMIOBuffer::ObMIOBuffer()
 #endif
 }
 
+inline void ObMIOBuffer::reset()
+{
+  ObIOBufferData *data = NULL;
+  if (NULL != writer_) {
+    // the data may still be read by a cloned block or by a MSG_ZEROCOPY
+    // send the kernel has not completed, do not write over it in place
+    if (DEFAULT_ALLOC == writer_->data_->mem_type_ && writer_->data_->refcount() > 1
+        && NULL != (data = new_iobufferdata(writer_->get_block_size()))) {
+      writer_->set(data, 0, 0);
+    } else {
+      writer_->reset();
+    }
+  }
+
+  for (int64_t i = 0; i < MAX_MIOBUFFER_READERS; ++i) {
+    if (readers_[i].is_allocated()) {
+      readers_[i].reset();
+    }
+  }
+}
+
 inline ObMIOBuffer *new_miobuffer_internal(
 #ifdef TRACK_BUFFER_USER
     const char *location,
@@ -33,6 +33,7 @@
 #define OBPROXY_PRIORITY_EVENT_QUEUE_H
 
 #include "iocore/eventsystem/ob_event.h"
+#include "iocore/eventsystem/ob_timing_wheel.h"
 
 namespace oceanbase
 {
@@ -40,14 +41,17 @@ namespace obproxy
 {
 namespace event
 {
-// <1ms, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024
-#define PQ_BUCKET_TIME(i) (HRTIME_MSECONDS(1) << (i))
+// timed events live in a 1ms tick timing wheel, 4 levels of 64 slots cover
+// about 4.6 hours, longer timeouts are placed again when they come down
+#define PQ_TICK_TIME HRTIME_MSECONDS(1)
 
 class ObEThread;
 
 class ObPriorityEventQueue
 {
 public:
+  typedef ObTimingWheel<ObEvent, ObEvent::Link_link_, &ObEvent::wheel_entry_> ObEventTimingWheel;
+
   ObPriorityEventQueue();
   ~ObPriorityEventQueue() { }
 
@@ -58,12 +62,14 @@ public:
   ObHRTime earliest_timeout();
   int64_t get_queue_size() const { return after_queue_size_; };
 
+private:
+  void purge_cancelled();
+
 public:
-  static const int64_t PQ_LIST_COUNT = 10;
-  Que(ObEvent, link_) after_queue_[PQ_LIST_COUNT];
+  ObEventTimingWheel wheel_;
+  Que(ObEvent, link_) ready_queue_;
 
   ObHRTime last_check_time_;
-  uint64_t last_check_buckets_;
   int64_t after_queue_size_;
 
 private:
@@ -73,61 +79,21 @@ private:
 inline ObPriorityEventQueue::ObPriorityEventQueue()
 {
   last_check_time_ = common::get_hrtime_internal();
-  last_check_buckets_ = static_cast<uint64_t>(last_check_time_ / PQ_BUCKET_TIME(0));
+  wheel_.init(PQ_TICK_TIME, last_check_time_);
   after_queue_size_ = 0;
 }
 
 inline void ObPriorityEventQueue::enqueue(ObEvent *e, const ObHRTime now)
 {
+  UNUSED(now);
   if (OB_ISNULL(e)) {
     PROXY_EVENT_LOG(WARN, "event NULL, it should not happened");
   } else if (OB_UNLIKELY(e->in_the_priority_queue_) || OB_UNLIKELY(e->in_the_prot_queue_)) {
     PROXY_EVENT_LOG(WARN, "event has already in queue, it should not happened", K(*e));
   } else {
-    ObHRTime t = e->timeout_at_ - now;
-    uint32_t i = 0;
-
-    // equivalent but faster
-    if (t <= PQ_BUCKET_TIME(3)) {
-      if (t <= PQ_BUCKET_TIME(1)) {
-        if (t <= PQ_BUCKET_TIME(0)) {
-          i = 0;
-        } else {
-          i = 1;
-        }
-      } else {
-        if (t <= PQ_BUCKET_TIME(2)) {
-          i = 2;
-        } else {
-          i = 3;
-        }
-      }
-    } else {
-      if (t <= PQ_BUCKET_TIME(7)) {
-        if (t <= PQ_BUCKET_TIME(5)) {
-          if (t <= PQ_BUCKET_TIME(4)) {
-            i = 4;
-          } else {
-            i = 5;
-          }
-        } else {
-          if (t <= PQ_BUCKET_TIME(6)) {
-            i = 6;
-          } else {
-            i = 7;
-          }
-        }
-      } else {
-        if (t <= PQ_BUCKET_TIME(8)) {
-          i = 8;
-        } else {
-          i = 9;
-        }
-      }
-    }
+    // events already due go to the due slot and come out on the next check_ready()
     e->in_the_priority_queue_ = 1;
-    e->in_heap_ = i & 0x0F;
-    after_queue_[i].enqueue(e);
+    wheel_.schedule(e, wheel_.to_tick(e->timeout_at_));
     ++after_queue_size_;
   }
 }
@@ -142,14 +108,18 @@ inline void ObPriorityEventQueue::remove(ObEvent *e)
     PROXY_EVENT_LOG(WARN, "event has already in in_the_prot_queue_, it should not happened", K(*e));
   } else {
     e->in_the_priority_queue_ = 0;
-    after_queue_[e->in_heap_].remove(e);
+    if (e->wheel_entry_.is_scheduled()) {
+      wheel_.remove(e);
+    } else {
+      ready_queue_.remove(e);
+    }
     --after_queue_size_;
   }
 }
 
 inline ObEvent *ObPriorityEventQueue::dequeue_ready()
 {
-  ObEvent *event_ret = after_queue_[0].dequeue();
+  ObEvent *event_ret = ready_queue_.dequeue();
   if (NULL != event_ret) {
     if (OB_UNLIKELY(!event_ret->in_the_priority_queue_)) {
       PROXY_EVENT_LOG(WARN, "event is not in_the_priority_queue, it should not happened", K(*event_ret));
@@ -163,51 +133,44 @@ inline ObEvent *ObPriorityEventQueue::dequeue_ready()
   return event_ret;
 }
 
+// cancel() only marks an event, it can not take it out of the owner's wheel,
+// so free the cancelled events of one upper level slot per tick instead of
+// keeping them until they expire
+inline void ObPriorityEventQueue::purge_cancelled()
+{
+  Que(ObEvent, link_) q;
+  ObEvent *e = NULL;
+  wheel_.detach_upper_slot(q);
+  while (NULL != (e = q.dequeue())) {
+    if (e->cancelled_) {
+      e->in_the_priority_queue_ = 0;
+      e->free();
+      --after_queue_size_;
+    } else {
+      wheel_.schedule(e, e->wheel_entry_.expire_tick_);
+    }
+  }
+}
+
 inline void ObPriorityEventQueue::check_ready(const ObHRTime now)
 {
-  const uint64_t check_buckets = static_cast<uint64_t>(now / PQ_BUCKET_TIME(0));
-  uint64_t todo_buckets = check_buckets ^ last_check_buckets_;//pass N times of 5ms
+  const int64_t last_tick = wheel_.get_cur_tick();
   last_check_time_ = now;
-  last_check_buckets_ = check_buckets;
-  todo_buckets &= ((1 << (PQ_LIST_COUNT - 1)) - 1);//limit to 0x1FF times, 2^0~2^9
-
-  int64_t k = 0;
-  while (0 != todo_buckets) {
-    ++k;
-    todo_buckets >>= 1;//get the highest bit, 0~9
+  wheel_.advance(now, ready_queue_);
+  if (wheel_.get_cur_tick() != last_tick) {
+    purge_cancelled();
   }
-
-  ObEvent *e = NULL;
-  ObHRTime offset = 0;
-  int64_t j = 0;
-  for (int64_t i = 1; i <= k; ++i) {
-    Que(ObEvent, link_) q = after_queue_[i];
-    after_queue_[i].reset();
-    while (NULL != (e = q.dequeue())) {
-      if (e->cancelled_) {
-        e->in_the_priority_queue_ = 0;
-        e->free();
-        --after_queue_size_;
-      } else {
-        offset = e->timeout_at_ - now;
-        for (j = i; j > 0 && offset <= PQ_BUCKET_TIME(j - 1);) {
-          --j;
-        }
-        e->in_heap_ = j & 0x0F;
-        after_queue_[j].enqueue(e);
-      }
-    }//end of while
-  }//end of for
 }
 
 inline ObHRTime ObPriorityEventQueue::earliest_timeout()
 {
   ObHRTime ret = last_check_time_ + HRTIME_FOREVER;
-  bool find_head = false;
-  for (int64_t i = 0; i < PQ_LIST_COUNT && !find_head; ++i) {
-    if (NULL != after_queue_[i].head_) {
-      ret = last_check_time_ + (PQ_BUCKET_TIME(i) / 2);
-      find_head = true;
+  if (!ready_queue_.empty()) {
+    ret = last_check_time_;
+  } else {
+    const int64_t tick = wheel_.next_expire_tick();
+    if (INT64_MAX != tick) {
+      ret = std::max(last_check_time_, wheel_.to_time(tick));
     }
   }
   return ret;
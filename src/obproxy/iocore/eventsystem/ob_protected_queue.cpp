@@ -46,10 +46,26 @@ namespace event
 // until some amount of work has been completed on the current thread
 // in order to prevent excess context switches.
 //
-// Defining EAGER_SIGNALLING disables this behavior and causes
-// threads to be made runnable immediately.
-//
-// #define EAGER_SIGNALLING
+// A thread is only signalled when it has parked itself (see park()),
+// a running thread will find the new events in its next loop anyway.
+// So an enqueue onto a busy thread costs one CAS, and a burst of enqueues
+// onto a parked thread costs one wakeup.
+
+int ObProtectedQueue::wakeup(ObEThread &ethread)
+{
+  int ret = OB_SUCCESS;
+  const int64_t state = ATOMIC_LOAD(&park_state_);
+  if ((PARK_STATE_COND_WAIT == state || PARK_STATE_POLL_WAIT == state)
+      && ATOMIC_BCAS(&park_state_, state, PARK_STATE_NOTIFIED)) {
+    if (PARK_STATE_COND_WAIT == state && OB_FAIL(signal())) {
+      LOG_WARN("fail to do signal, it should not happened", K(ret));
+    }
+    if (NULL != ethread.signal_hook_) {
+      ethread.signal_hook_(ethread);
+    }
+  }
+  return ret;
+}
 
 void ObProtectedQueue::enqueue(ObEvent *e, const bool fast_signal)
 {
@@ -58,7 +74,6 @@ void ObProtectedQueue::enqueue(ObEvent *e, const bool fast_signal)
   } else if (OB_UNLIKELY(e->in_the_prot_queue_) || OB_UNLIKELY(e->in_the_priority_queue_)) {
     LOG_WARN("event has already in queue, it should not happened", K(*e));
   } else {
-    int ret = OB_SUCCESS;
     ObEThread *e_ethread = e->ethread_;
     e->in_the_prot_queue_ = 1;
     bool was_empty = (NULL == atomic_list_.push(e));
@@ -69,69 +84,42 @@ void ObProtectedQueue::enqueue(ObEvent *e, const bool fast_signal)
       // queue e->ethread in the list of threads to be signalled
       // inserting_thread == NULL means it is not a regular ObEThread
       if (NULL == inserting_thread || NULL == inserting_thread->ethreads_to_be_signalled_) {
-        if (OB_FAIL(signal())) {
-          LOG_WARN("fail to do signal, it should not happened", K(ret));
-        }
-        if (NULL != e_ethread->net_poll_) {
-          e_ethread->get_net_poll().timerfd_settime();
-        }
-        if (fast_signal) {
-          if (NULL != e_ethread->signal_hook_) {
-            e_ethread->signal_hook_(*e_ethread);
-          }
-        }
+        wakeup(*e_ethread);
       } else {
-        bool need_break = false;
-#ifdef EAGER_SIGNALLING
-        // Try to signal now and avoid deferred posting.
-        if (OB_SUCC(e_ethread->event_queue_external_.try_signal())) {
-          if (NULL != e_ethread->net_poll_) {
-            if (OB_SUCC(e_ethread->get_net_poll().timerfd_settime())) {
-              need_break = true;
-            }
-          } else {
-            need_break = true;
-          }
+        if (fast_signal) {
+          wakeup(*e_ethread);
         }
-#endif
-        if (!need_break) {
-          if (fast_signal) {
-            if (NULL != e_ethread->signal_hook_) {
-              e_ethread->signal_hook_(*e_ethread);
-            }
-          }
 
-          int64_t &count = inserting_thread->ethreads_to_be_signalled_count_;
-          ObEThread **sig_e = inserting_thread->ethreads_to_be_signalled_;
-
-          if ((count + 1) >= g_event_processor.event_thread_count_) {
-            // we have run out of room
-            if ((count + 1) == g_event_processor.event_thread_count_) {
-              // convert to direct map, put each ethread (sig_e[i]) into
-              // the direct map location: sig_e[sig_e[i]->id]
-              ObEThread *cur = NULL;
-              ObEThread *next = NULL;
-              for (int64_t i = 0; i < count; ++i) {
-                cur = sig_e[i];  // put this ethread
-                while (NULL != cur && cur != (next = sig_e[cur->id_])) { // into this location
-                  sig_e[cur->id_] = cur;
-                  cur = next;
-                }
-
-                // if not overwritten
-                if (NULL != sig_e[i] && sig_e[i]->id_ != i) {
-                  sig_e[i] = NULL;
-                }
+        int64_t &count = inserting_thread->ethreads_to_be_signalled_count_;
+        ObEThread **sig_e = inserting_thread->ethreads_to_be_signalled_;
+
+        if ((count + 1) >= g_event_processor.event_thread_count_) {
+          // we have run out of room
+          if ((count + 1) == g_event_processor.event_thread_count_) {
+            // convert to direct map, put each ethread (sig_e[i]) into
+            // the direct map location: sig_e[sig_e[i]->id]
+            ObEThread *cur = NULL;
+            ObEThread *next = NULL;
+            for (int64_t i = 0; i < count; ++i) {
+              cur = sig_e[i];  // put this ethread
+              while (NULL != cur && cur != (next = sig_e[cur->id_])) { // into this location
+                sig_e[cur->id_] = cur;
+                cur = next;
+              }
+
+              // if not overwritten
+              if (NULL != sig_e[i] && sig_e[i]->id_ != i) {
+                sig_e[i] = NULL;
               }
-              ++count;
             }
-            // we have a direct map, insert this ObEThread
-            sig_e[e_ethread->id_] = e_ethread;
-          } else {
-            // insert into vector
-            sig_e[count++] = e_ethread;
+            ++count;
           }
-        }//else need break
+          // we have a direct map, insert this ObEThread
+          sig_e[e_ethread->id_] = e_ethread;
+        } else {
+          // insert into vector
+          sig_e[count++] = e_ethread;
+        }
       }//end of else
     }//!was_empty || inserting_thread == e_ethread
   }//end of else
@@ -142,42 +130,14 @@ void flush_signals(ObEThread *thr)
   if (OB_ISNULL(thr) || OB_UNLIKELY(this_ethread() != thr)) {
     LOG_WARN("argument is error", K(thr), "this_ethread", this_ethread());
   } else {
-    int ret = OB_SUCCESS;
     int64_t count = thr->ethreads_to_be_signalled_count_;
     if (count > g_event_processor.event_thread_count_) {
       count = g_event_processor.event_thread_count_;      // MAX
     }
 
-    // Since the lock is only there to prevent a race in cond_timedwait
-    // the lock is taken only for a short time, thus it is unlikely that
-    // this code has any effect.
-#ifdef EAGER_SIGNALLING
-    for (int64_t i = 0; i < count; ++i) {
-      // Try to signal as many threads as possible without blocking.
-      if (NULL != thr->ethreads_to_be_signalled_[i]) {
-        if (thr->ethreads_to_be_signalled_[i]->event_queue_external_.try_signal()) {
-          if (NULL != thr->ethreads_to_be_signalled_[i]->net_poll_) {
-            if (OB_SUCC(thr->ethreads_to_be_signalled_[i]->get_net_poll().timerfd_settime())) {
-              thr->ethreads_to_be_signalled_[i] = 0;
-            }
-          } else {
-            thr->ethreads_to_be_signalled_[i] = 0;
-          }
-        }
-      }
-    }
-#endif
     for (int64_t i = 0; i < count; ++i) {
       if (NULL != thr->ethreads_to_be_signalled_[i]) {
-        if (OB_FAIL(thr->ethreads_to_be_signalled_[i]->event_queue_external_.signal())) {
-          LOG_WARN("failed to do signal, it should not happened", K(ret));
-        }
-        if (NULL != thr->ethreads_to_be_signalled_[i]->net_poll_) {
-          thr->ethreads_to_be_signalled_[i]->get_net_poll().timerfd_settime();
-        }
-        if (NULL != thr->ethreads_to_be_signalled_[i]->signal_hook_) {
-          thr->ethreads_to_be_signalled_[i]->signal_hook_(*(thr->ethreads_to_be_signalled_[i]));
-        }
+        thr->ethreads_to_be_signalled_[i]->event_queue_external_.wakeup(*(thr->ethreads_to_be_signalled_[i]));
         thr->ethreads_to_be_signalled_[i] = NULL;
       }
     }
@@ -193,9 +153,10 @@ int ObProtectedQueue::dequeue_timed(const ObHRTime timeout, const bool need_slee
     if (OB_FAIL(mutex_acquire(&lock_))) {
       LOG_ERROR("failed to acquire mutex", K(ret));
     } else {
-      if (atomic_list_.empty()) {
+      if (park(PARK_STATE_COND_WAIT)) {
         timespec ts = hrtime_to_timespec(timeout);
         cond_timedwait(&might_have_data_, &lock_, &ts);
+        unpark();
       }
       int tmp_ret = OB_SUCCESS;
       if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = mutex_release(&lock_)))) {
@@ -30,11 +30,16 @@
  * **************************************************************
  *
  * Protected Queue, a FIFO queue with the following functionality:
- * (1). Multiple threads could be simultaneously trying to enqueue
- *      and dequeue. Hence the queue needs to be protected with mutex.
+ * (1). Multiple threads could be simultaneously trying to enqueue,
+ *      only the owner thread dequeues. Enqueue is a lock free push
+ *      onto atomic_list_.
  * (2). In case the queue is empty, dequeue() sleeps for a specified
  *      amount of time, or until a new element is inserted, whichever
  *      is earlier
+ * (3). The owner thread publishes in park_state_ that it is going to
+ *      block (in dequeue_timed() or in the net poll). Producers only
+ *      pay for a wakeup (cond signal or eventfd write) when the owner
+ *      is parked, and only the first one of them does it.
  */
 
 #ifndef OBPROXY_PROTECTED_QUEUE_H
@@ -49,10 +54,22 @@ namespace obproxy
 namespace event
 {
 
+class ObEThread;
+
 class ObProtectedQueue
 {
 public:
-  ObProtectedQueue() : is_inited_(false), atomic_list_size_(0), local_queue_size_(0) {}
+  enum ObParkState
+  {
+    PARK_STATE_RUNNING = 0,
+    PARK_STATE_COND_WAIT,  // blocked in dequeue_timed()
+    PARK_STATE_POLL_WAIT,  // blocked in the net poll, woken up by signal_hook_
+    PARK_STATE_NOTIFIED,   // parked, and some producer has already woken it up
+  };
+
+  ObProtectedQueue()
+      : is_inited_(false), park_state_(PARK_STATE_RUNNING),
+        atomic_list_size_(0), local_queue_size_(0) {}
   ~ObProtectedQueue() { }
 
   int init();
@@ -63,6 +80,14 @@ public:
   int dequeue_timed(const ObHRTime timeout, const bool need_sleep);
   int signal();
   int try_signal();             // Use non blocking lock and if acquired, signal
+
+  // Called by the owner thread right before it blocks. Returns false if
+  // events have arrived meanwhile, in which case it must not block.
+  bool park(const ObParkState state);
+  void unpark() { ATOMIC_STORE(&park_state_, PARK_STATE_RUNNING); }
+  bool is_parked() const;
+  // Wake up the owner thread if it is parked, cheap if it is not
+  int wakeup(ObEThread &ethread);
   int64_t get_atomic_list_size() const { return atomic_list_size_; };
   int64_t get_local_queue_size() const { return local_queue_size_; };
 
@@ -72,6 +97,7 @@ public:
   ObMutex lock_;
   ObProxyThreadCond might_have_data_;
   Que(ObEvent, link_) local_queue_;
+  volatile int64_t park_state_;
 
   int64_t atomic_list_size_;
   int64_t local_queue_size_;
@@ -133,6 +159,24 @@ inline int ObProtectedQueue::try_signal()
   return ret;
 }
 
+inline bool ObProtectedQueue::park(const ObParkState state)
+{
+  // the full barrier in ATOMIC_STORE pairs with the CAS of atomic_list_.push()
+  // in enqueue(), either we see the new event or the producer sees us parked
+  ATOMIC_STORE(&park_state_, state);
+  bool bret = atomic_list_.empty();
+  if (!bret) {
+    unpark();
+  }
+  return bret;
+}
+
+inline bool ObProtectedQueue::is_parked() const
+{
+  const int64_t state = ATOMIC_LOAD(&park_state_);
+  return PARK_STATE_COND_WAIT == state || PARK_STATE_POLL_WAIT == state;
+}
+
 // Called from the same thread (don't need to signal)
 inline void ObProtectedQueue::enqueue_local(ObEvent *e)
 {
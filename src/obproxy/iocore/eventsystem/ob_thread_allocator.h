@@ -41,18 +41,39 @@ namespace obproxy
 namespace event
 {
 
+// The size classes of the io buffers live here rather than in
+// ob_buf_allocator.h, so that every class gets a thread freelist.
+/**
+ * These are defines so that code that used 2
+ * for buffer size index when 2 was 2K will
+ * still work if it uses BUFFER_SIZE_INDEX_2K
+ * instead.
+ */
+#define BUFFER_SIZE_INDEX_128           0
+#define BUFFER_SIZE_INDEX_256           1
+#define BUFFER_SIZE_INDEX_512           2
+#define BUFFER_SIZE_INDEX_1K            3
+#define BUFFER_SIZE_INDEX_2K            4
+#define BUFFER_SIZE_INDEX_4K            5
+#define BUFFER_SIZE_INDEX_8K            6
+#define MAX_BUFFER_SIZE_INDEX           6
+#define BUFFER_SIZE_INDEX_COUNT         (MAX_BUFFER_SIZE_INDEX + 1)
+
 static const int64_t g_thread_freelist_high_watermark       = 512;
 static const int64_t g_thread_freelist_low_watermark        = 32;
-static const int64_t g_thread_freelist_low_watermark_for_8k = 0;
-static const int64_t size_8k                                = 8 * 1024;
+// one freelist for every buffer size class
+static const int64_t g_thread_buf_freelist_count            = BUFFER_SIZE_INDEX_COUNT;
 
 struct ObProxyThreadAllocator
 {
-  ObProxyThreadAllocator() : allocated_(0), freelist_(NULL) { }
+  ObProxyThreadAllocator() : allocated_(0), freelist_(NULL), hit_count_(0), miss_count_(0) { }
   ~ObProxyThreadAllocator() { }
 
   int64_t allocated_;
   void *freelist_;
+  // only touched by the owner thread
+  int64_t hit_count_;
+  int64_t miss_count_;
 };
 
 template<class T>
@@ -67,9 +88,11 @@ inline T *thread_alloc(ObProxyThreadAllocator &l,
     ret = reinterpret_cast<T *>(l.freelist_);
     l.freelist_ = *reinterpret_cast<T **>(l.freelist_);
     --(l.allocated_);
+    ++(l.hit_count_);
     *reinterpret_cast<void **>(ret) = *reinterpret_cast<void **>(&(allocator->proto_.type_object_));
   }
   if (OB_ISNULL(ret) && OB_LIKELY(NULL != allocator)) {
+    ++(l.miss_count_);
     ret = allocator->alloc();
   }
   return ret;
@@ -87,6 +110,7 @@ inline T *thread_alloc_init(ObProxyThreadAllocator &l,
     ret = reinterpret_cast<T *>(l.freelist_);
     l.freelist_ = *reinterpret_cast<T **>(l.freelist_);
     --(l.allocated_);
+    ++(l.hit_count_);
     if (NULL == init_func) {
       memcpy(ret, &allocator->proto_.type_object_, sizeof(T));
     } else {
@@ -94,6 +118,7 @@ inline T *thread_alloc_init(ObProxyThreadAllocator &l,
     }
   }
   if (OB_ISNULL(ret) && OB_LIKELY(NULL != allocator)) {
+    ++(l.miss_count_);
     ret = allocator->alloc();
   }
   return ret;
@@ -106,8 +131,10 @@ inline void *thread_alloc_void(common::ObFixedMemAllocator &a, ObProxyThreadAllo
     ret = reinterpret_cast<void *>(l.freelist_);
     l.freelist_ = *reinterpret_cast<void **>(l.freelist_);
     --(l.allocated_);
+    ++(l.hit_count_);
   }
   if (OB_ISNULL(ret)) {
+    ++(l.miss_count_);
     ret = a.alloc_void();
   }
   return ret;
@@ -130,14 +157,10 @@ inline void thread_freeup(ObProxyThreadAllocator &l)
   }
 }
 
-inline void thread_freeup_void(common::ObFixedMemAllocator &a, ObProxyThreadAllocator &l)
+inline void thread_freeup_void(common::ObFixedMemAllocator &a, ObProxyThreadAllocator &l,
+                               const int64_t low_watermark)
 {
   void *v = NULL;
-  int64_t low_watermark = g_thread_freelist_low_watermark;
-  if (a.get_obj_size() == size_8k) {
-    low_watermark = g_thread_freelist_low_watermark_for_8k;
-  }
-
   while (NULL != l.freelist_ && l.allocated_ > low_watermark) {
     v = reinterpret_cast<void *>(l.freelist_);
     l.freelist_ = *reinterpret_cast<void **>(l.freelist_);
@@ -160,23 +183,35 @@ inline void thread_freeup_void(common::ObFixedMemAllocator &a, ObProxyThreadAllo
 } while (0)
 
 #define op_thread_fixed_mem_alloc(a, freelist) event::thread_alloc_void(a, freelist)
-#define op_thread_fixed_mem_free(a, p, freelist) do {                 \
+// io buffer memory is handed back to the global allocator in batches of
+// half the high watermark, so that a thread which mostly frees the buffers
+// allocated by other threads does not hit the global allocator per free
+#define op_thread_fixed_mem_free(a, p, freelist, high_watermark) do {     \
   *reinterpret_cast<void **>(p) = reinterpret_cast<void *>(freelist.freelist_); \
   freelist.freelist_ = p;                                      \
   ++(freelist.allocated_);                                     \
-  if (freelist.allocated_ > g_thread_freelist_high_watermark)  \
+  if (freelist.allocated_ > (high_watermark))                  \
   {                                                            \
-    event::thread_freeup_void(a, freelist);                    \
+    event::thread_freeup_void(a, freelist, (high_watermark) / 2); \
   }                                                            \
 } while (0)
 
 struct ObThreadAllocator
 {
+  ObThreadAllocator()
+      : reported_iobuf_hit_count_(0), reported_iobuf_miss_count_(0), reported_iobuf_cached_bytes_(0) { }
+  ~ObThreadAllocator() { }
+
   ObProxyThreadAllocator mio_allocator_;
   ObProxyThreadAllocator io_block_allocator_;
   ObProxyThreadAllocator io_data_allocator_;
-  ObProxyThreadAllocator block_8k_allocator_;
+  ObProxyThreadAllocator buf_allocator_[g_thread_buf_freelist_count];
   ObProxyThreadAllocator sm_allocator_;
+
+  // what has been reported to the stat processor, see ObInactivityCop
+  int64_t reported_iobuf_hit_count_;
+  int64_t reported_iobuf_miss_count_;
+  int64_t reported_iobuf_cached_bytes_;
 };
 
 inline ObThreadAllocator &get_thread_allocator()
@@ -204,9 +239,10 @@ inline ObProxyThreadAllocator &get_io_data_allocator()
   return get_thread_allocator().io_data_allocator_;
 }
 
-inline ObProxyThreadAllocator &get_8k_block_allocator()
+// per thread cache of the io buffer memory of size class idx
+inline ObProxyThreadAllocator &get_buf_freelist(const int64_t idx)
 {
-  return get_thread_allocator().block_8k_allocator_;
+  return get_thread_allocator().buf_allocator_[idx];
 }
 
 inline ObProxyThreadAllocator &get_sm_allocator()
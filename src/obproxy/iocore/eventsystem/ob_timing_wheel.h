@@ -0,0 +1,274 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * **************************************************************
+ *
+ * Hierarchical timing wheel, a timer container with the following functionality:
+ * (1). LEVEL_COUNT levels of SLOT_COUNT slots, level N covers
+ *      SLOT_COUNT^(N+1) ticks, entries beyond the last level are parked
+ *      at its far end and placed again when they cascade down.
+ * (2). schedule() and remove() are O(1), an entry only knows its slot.
+ * (3). advance() only visits the slots whose tick has passed, plus one
+ *      upper level slot cascading down every SLOT_COUNT^N ticks.
+ * (4). It is not thread safe, all the calls must come from the owner thread.
+ */
+
+#ifndef OBPROXY_TIMING_WHEEL_H
+#define OBPROXY_TIMING_WHEEL_H
+
+#include "utils/ob_proxy_lib.h"
+#include "lib/list/ob_intrusive_list.h"
+#include "lib/time/ob_hrtime.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace event
+{
+
+struct ObTimingWheelEntry
+{
+  ObTimingWheelEntry() : expire_tick_(0), slot_(-1) {}
+  ~ObTimingWheelEntry() {}
+
+  bool is_scheduled() const { return slot_ >= 0; }
+  void reset() { expire_tick_ = 0; slot_ = -1; }
+
+  int64_t expire_tick_;
+  int64_t slot_;  // -1 if not in the wheel
+};
+
+// C is linked into the slots through L, and keeps its wheel state in C::*E
+template <class C, class L, ObTimingWheelEntry C::*E>
+class ObTimingWheel
+{
+public:
+  static const int64_t LEVEL_BITS = 6;
+  static const int64_t SLOT_COUNT = (1LL << LEVEL_BITS);
+  static const int64_t SLOT_MASK = SLOT_COUNT - 1;
+  static const int64_t LEVEL_COUNT = 4;
+  static const int64_t MAX_DELTA_TICK = (1LL << (LEVEL_BITS * LEVEL_COUNT)) - 1;
+  // entries already expired when scheduled
+  static const int64_t DUE_SLOT = LEVEL_COUNT * SLOT_COUNT;
+
+  ObTimingWheel();
+  ~ObTimingWheel() { }
+
+  void init(const ObHRTime tick, const ObHRTime now);
+
+  // round up, an entry never expires before its time
+  int64_t to_tick(const ObHRTime time) const { return (time + tick_ - 1) / tick_; }
+  ObHRTime to_time(const int64_t tick) const { return tick * tick_; }
+  ObHRTime get_tick() const { return tick_; }
+  int64_t get_cur_tick() const { return cur_tick_; }
+  int64_t get_count() const { return count_; }
+
+  // insert c, or move it if it is already in the wheel
+  void schedule(C *c, const int64_t expire_tick);
+  void remove(C *c);
+
+  // move all the entries expired at now into expired, in tick order
+  void advance(const ObHRTime now, common::Queue<C, L> &expired);
+
+  // lower bound of the tick at which advance() may expire something,
+  // INT64_MAX if the wheel is empty
+  int64_t next_expire_tick() const;
+
+  // detach the entries of one upper level slot, round robin, so that the
+  // caller can reclaim dead entries long before they cascade down; what it
+  // schedules again goes back to the same slot
+  void detach_upper_slot(common::Queue<C, L> &q);
+
+private:
+  void link(C *c);
+  void detach_slot(const int64_t slot, common::Queue<C, L> &q);
+  int64_t get_level(const int64_t slot) const { return slot / SLOT_COUNT; }
+
+private:
+  ObHRTime tick_;
+  int64_t cur_tick_;
+  int64_t count_;
+  int64_t purge_slot_;
+  int64_t level_count_[LEVEL_COUNT + 1];
+  common::Queue<C, L> slots_[DUE_SLOT + 1];
+
+  DISALLOW_COPY_AND_ASSIGN(ObTimingWheel);
+};
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline ObTimingWheel<C, L, E>::ObTimingWheel()
+    : tick_(1), cur_tick_(0), count_(0), purge_slot_(SLOT_COUNT)
+{
+  for (int64_t i = 0; i <= LEVEL_COUNT; ++i) {
+    level_count_[i] = 0;
+  }
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::init(const ObHRTime tick, const ObHRTime now)
+{
+  if (OB_UNLIKELY(tick <= 0) || OB_UNLIKELY(count_ > 0)) {
+    PROXY_EVENT_LOG(WARN, "invalid timing wheel init, it should not happened", K(tick), K_(count));
+  } else {
+    tick_ = tick;
+    cur_tick_ = now / tick_;
+  }
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::link(C *c)
+{
+  ObTimingWheelEntry &entry = c->*E;
+  int64_t delta = entry.expire_tick_ - cur_tick_;
+  if (delta <= 0) {
+    entry.slot_ = DUE_SLOT;
+  } else {
+    if (delta > MAX_DELTA_TICK) {
+      delta = MAX_DELTA_TICK;
+    }
+    const int64_t placed_tick = cur_tick_ + delta;
+    int64_t level = 0;
+    while (level < LEVEL_COUNT - 1 && delta >= (1LL << (LEVEL_BITS * (level + 1)))) {
+      ++level;
+    }
+    entry.slot_ = level * SLOT_COUNT + ((placed_tick >> (LEVEL_BITS * level)) & SLOT_MASK);
+  }
+  slots_[entry.slot_].enqueue(c);
+  ++level_count_[get_level(entry.slot_)];
+  ++count_;
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::schedule(C *c, const int64_t expire_tick)
+{
+  if (OB_ISNULL(c)) {
+    PROXY_EVENT_LOG(WARN, "entry NULL, it should not happened");
+  } else {
+    ObTimingWheelEntry &entry = c->*E;
+    if (!entry.is_scheduled() || entry.expire_tick_ != expire_tick) {
+      if (entry.is_scheduled()) {
+        remove(c);
+      }
+      entry.expire_tick_ = expire_tick;
+      link(c);
+    }
+  }
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::remove(C *c)
+{
+  if (OB_ISNULL(c)) {
+    PROXY_EVENT_LOG(WARN, "entry NULL, it should not happened");
+  } else {
+    ObTimingWheelEntry &entry = c->*E;
+    if (entry.is_scheduled()) {
+      slots_[entry.slot_].remove(c);
+      --level_count_[get_level(entry.slot_)];
+      --count_;
+      entry.slot_ = -1;
+    }
+  }
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::detach_slot(const int64_t slot, common::Queue<C, L> &q)
+{
+  C *c = NULL;
+  const int64_t level = get_level(slot);
+  while (NULL != (c = slots_[slot].dequeue())) {
+    (c->*E).slot_ = -1;
+    --level_count_[level];
+    --count_;
+    q.enqueue(c);
+  }
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::advance(const ObHRTime now, common::Queue<C, L> &expired)
+{
+  const int64_t now_tick = now / tick_;
+  common::Queue<C, L> cascade_queue;
+  C *c = NULL;
+
+  while (cur_tick_ < now_tick) {
+    if (0 == count_) {
+      cur_tick_ = now_tick;
+    } else if (0 == level_count_[0] && (cur_tick_ & SLOT_MASK) != SLOT_MASK) {
+      // nothing can expire before the next cascade
+      cur_tick_ = std::min(now_tick, cur_tick_ | SLOT_MASK);
+    } else {
+      ++cur_tick_;
+      const int64_t index = cur_tick_ & SLOT_MASK;
+      if (0 == index) {
+        int64_t level_index = 0;
+        for (int64_t level = 1; level < LEVEL_COUNT; ++level) {
+          level_index = (cur_tick_ >> (LEVEL_BITS * level)) & SLOT_MASK;
+          detach_slot(level * SLOT_COUNT + level_index, cascade_queue);
+          if (0 != level_index) {
+            break;
+          }
+        }
+        while (NULL != (c = cascade_queue.dequeue())) {
+          link(c);
+        }
+      }
+      detach_slot(index, expired);
+    }
+  }
+  detach_slot(DUE_SLOT, expired);
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline int64_t ObTimingWheel<C, L, E>::next_expire_tick() const
+{
+  int64_t ret = INT64_MAX;
+  if (0 == count_) {
+    // empty
+  } else if (level_count_[LEVEL_COUNT] > 0) {
+    ret = cur_tick_;
+  } else {
+    if (level_count_[0] > 0) {
+      for (int64_t i = 1; i <= SLOT_COUNT && INT64_MAX == ret; ++i) {
+        if (!slots_[(cur_tick_ + i) & SLOT_MASK].empty()) {
+          ret = cur_tick_ + i;
+        }
+      }
+    }
+    // the upper level entries only come down when their level cascades, and the
+    // lowest non-empty level cascades first; it may be before the level 0 slot
+    for (int64_t level = 1; level < LEVEL_COUNT; ++level) {
+      if (level_count_[level] > 0) {
+        ret = std::min(ret, ((cur_tick_ >> (LEVEL_BITS * level)) + 1) << (LEVEL_BITS * level));
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+template <class C, class L, ObTimingWheelEntry C::*E>
+inline void ObTimingWheel<C, L, E>::detach_upper_slot(common::Queue<C, L> &q)
+{
+  if (count_ > level_count_[0] + level_count_[LEVEL_COUNT]) {
+    detach_slot(purge_slot_, q);
+  }
+  if (++purge_slot_ >= DUE_SLOT) {
+    purge_slot_ = SLOT_COUNT;
+  }
+}
+
+} // end of namespace event
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_TIMING_WHEEL_H
@@ -444,6 +444,25 @@ public:
 
   void reenable_in(const ObHRTime atimeout_in);
 
+  // Index hints for the owner tables which look this vio up by address,
+  // see get_slot_hint(). Any value is safe, a wrong hint only costs a scan.
+  enum ObVIOSlotOwner
+  {
+    SLOT_OWNER_VC_TABLE = 0,
+    SLOT_OWNER_TUNNEL,
+    SLOT_OWNER_MAX
+  };
+
+  // slot_count must be a power of 2, the result is always in [0, slot_count)
+  int64_t get_slot_hint(const ObVIOSlotOwner owner, const int64_t slot_count) const
+  {
+    return slot_hint_[owner] & (slot_count - 1);
+  }
+  void set_slot_hint(const ObVIOSlotOwner owner, const int64_t slot)
+  {
+    slot_hint_[owner] = static_cast<uint8_t>(slot);
+  }
+
 public:
   enum
   {
@@ -514,6 +533,8 @@ public:
    * has closed the ObVConnection and deallocated itself.
    */
   common::ObPtr<ObProxyMutex> mutex_;
+
+  uint8_t slot_hint_[SLOT_OWNER_MAX];
 };
 
 inline ObVIO::ObVIO(int aop)
@@ -525,6 +546,7 @@ inline ObVIO::ObVIO(int aop)
       vc_server_(NULL),
       mutex_(NULL)
 {
+  memset(slot_hint_, 0, sizeof(slot_hint_));
 }
 
 inline ObVIO::ObVIO()
@@ -536,6 +558,7 @@ inline ObVIO::ObVIO()
       vc_server_(NULL),
       mutex_(NULL)
 {
+  memset(slot_hint_, 0, sizeof(slot_hint_));
 }
 
 inline void ObVIO::done()
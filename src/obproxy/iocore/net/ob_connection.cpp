@@ -471,6 +471,12 @@ int ObServerConnection::setup_fd_for_listen_proxy_mode(
     PROXY_SOCK_LOG(WARN, "fail to set sockopt SO_REUSEADDR", K(fd_), K(ret));
   }
 
+  if (OB_SUCC(ret) && reuseport_
+      && OB_FAIL(ObSocketManager::setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT,
+      reinterpret_cast<const void *>(&SOCKOPT_ON), sizeof(SOCKOPT_ON)))) {
+    PROXY_SOCK_LOG(WARN, "fail to set sockopt SO_REUSEPORT", K(fd_), K(ret));
+  }
+
 #ifdef SET_TCP_NO_DELAY
   if (OB_SUCC(ret) && OB_FAIL(ObSocketManager::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY,
       reinterpret_cast<const void *>(&SOCKOPT_ON), sizeof(SOCKOPT_ON)))) {
@@ -586,6 +592,11 @@ int ObServerConnection::listen_proxy_mode(const bool non_blocking, const int32_t
     int64_t namelen = sizeof(addr_);
     if (OB_FAIL(ObSocketManager::getsockname(fd_, &addr_.sa_, &namelen))) {
       PROXY_SOCK_LOG(WARN, "failed to getsockname", K(addr_), KERRMSGS, K(ret));
+    } else if (reuseport_ && (addr_.is_ip4() ? info.ipv4_fd_ : info.ipv6_fd_) >= 0) {
+      // one more socket of the SO_REUSEPORT group, the first one is passed as before
+      if (OB_FAIL(info.add_reuseport_fd(addr_.is_ip6(), fd_))) {
+        PROXY_SOCK_LOG(WARN, "fail to add reuseport fd", K(addr_), K(fd_), K(ret));
+      }
     } else if (addr_.is_ip4()) {
       info.ipv4_fd_ = fd_;
     } else if (addr_.is_ip6()) {
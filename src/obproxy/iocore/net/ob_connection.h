@@ -127,7 +127,7 @@ class ObServerConnection : public ObConnection
 {
 public:
   ObServerConnection()
-      : ObConnection()
+      : ObConnection(), reuseport_(false)
   {
     ob_zero(accept_addr_);
   }
@@ -158,6 +158,8 @@ public:
 public:
   // Client side (inbound) local IP address.
   ObIpEndpoint accept_addr_;
+  // listen with SO_REUSEPORT, one of the per net thread listen sockets
+  bool reuseport_;
 
 private:
   int setup_fd_for_listen_proxy_mode(
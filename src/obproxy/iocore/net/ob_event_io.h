@@ -78,9 +78,7 @@ public:
     data_.c_ = NULL,
     fd_ = NO_FD;
     event_loop_ = NULL;
-#if !defined(USE_EDGE_TRIGGER)
     events_ = 0;
-#endif
   }
   ~ObEventIO() { }
 
@@ -96,6 +94,9 @@ public:
   int stop();
   int close();
 
+  // re-register the same events, used when the poll backend dropped the registration
+  int rearm();
+
 public:
   int type_;
   union
@@ -107,9 +108,7 @@ public:
 
 private:
   int fd_;
-#if !defined(USE_EDGE_TRIGGER)
   int events_;
-#endif
   ObPollDescriptor *event_loop_;
 
   DISALLOW_COPY_AND_ASSIGN(ObEventIO);
@@ -126,15 +125,9 @@ inline int ObEventIO::start(ObPollDescriptor &loop, int fd, event::ObContinuatio
     fd_ = fd;
     data_.c_ = &c;
 
-    struct epoll_event ev;
-    memset(&ev, 0, sizeof(ev));
-    ev.events = events;
-    ev.data.ptr = this;
-#if !defined(USE_EDGE_TRIGGER)
     events_ = events;
-#endif
-    if (OB_FAIL(ObSocketManager::epoll_ctl(event_loop_->epoll_fd_, EPOLL_CTL_ADD, fd_, &ev))) {
-      PROXY_NET_LOG(WARN, "fail to epoll_ctl, op is EPOLL_CTL_ADD", K(fd), K(ret));
+    if (OB_FAIL(event_loop_->add(fd_, events, this))) {
+      PROXY_NET_LOG(WARN, "fail to add fd to poll descriptor", K(fd), K(ret));
     }
   }
   return ret;
@@ -171,15 +164,9 @@ inline int ObEventIO::start(ObPollDescriptor &loop, int fd, const int events)
     fd_ = fd;
     data_.c_ = NULL;
 
-    struct epoll_event ev;
-    memset(&ev, 0, sizeof(ev));
-    ev.events = events;
-    ev.data.ptr = this;
-#if !defined(USE_EDGE_TRIGGER)
     events_ = events;
-#endif
-    if (OB_FAIL(ObSocketManager::epoll_ctl(event_loop_->epoll_fd_, EPOLL_CTL_ADD, fd_, &ev))) {
-      PROXY_NET_LOG(WARN, "fail to epoll_ctl, op is EPOLL_CTL_ADD", K(fd), K(ret));
+    if (OB_FAIL(event_loop_->add(fd_, events, this))) {
+      PROXY_NET_LOG(WARN, "fail to add fd to poll descriptor", K(fd), K(ret));
     }
   }
   return ret;
@@ -220,17 +207,25 @@ inline int ObEventIO::stop()
 {
   int ret = common::OB_SUCCESS;
   if (NULL != event_loop_) {
-    struct epoll_event ev;
-    memset(&ev, 0, sizeof(struct epoll_event));
-    ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
-    if (OB_FAIL(ObSocketManager::epoll_ctl(event_loop_->epoll_fd_, EPOLL_CTL_DEL, fd_, &ev))) {
-      PROXY_NET_LOG(WARN, "fail to epoll_ctl, op is EPOLL_CTL_DEL", K(event_loop_->epoll_fd_),
-                    K(fd_), K(ret));
+    if (OB_FAIL(event_loop_->del(fd_, this))) {
+      PROXY_NET_LOG(WARN, "fail to delete fd from poll descriptor", K(fd_), K(ret));
     }
   }
   return ret;
 }
 
+inline int ObEventIO::rearm()
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_ISNULL(event_loop_) || OB_UNLIKELY(NO_FD == fd_)) {
+    ret = common::OB_NOT_INIT;
+    PROXY_NET_LOG(WARN, "event io is not started", K(fd_), K(ret));
+  } else if (OB_FAIL(event_loop_->add(fd_, events_, this))) {
+    PROXY_NET_LOG(WARN, "fail to rearm fd in poll descriptor", K(fd_), K(ret));
+  }
+  return ret;
+}
+
 inline int ObEventIO::close()
 {
   int ret = common::OB_SUCCESS;
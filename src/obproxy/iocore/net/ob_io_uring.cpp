@@ -0,0 +1,246 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <sys/syscall.h>
+#include "iocore/net/ob_io_uring.h"
+#include "iocore/net/ob_net.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+ObIOUring::ObIOUring()
+    : ring_fd_(-1), features_(0), ring_ptr_(NULL), ring_size_(0),
+      sqes_(NULL), sqes_size_(0), sq_head_(NULL), sq_tail_(NULL),
+      sq_ring_mask_(NULL), sq_array_(NULL), sq_local_tail_(0), sq_pending_(0),
+      cq_head_(NULL), cq_tail_(NULL), cq_ring_mask_(NULL), cqes_(NULL)
+{
+}
+
+int ObIOUring::init(const uint32_t sq_entries, const uint32_t cq_entries)
+{
+  int ret = OB_SUCCESS;
+  ObIOUringParams params;
+  memset(&params, 0, sizeof(params));
+  params.flags_ = SETUP_CQSIZE;
+  params.cq_entries_ = cq_entries;
+
+  if (OB_UNLIKELY(is_inited())) {
+    ret = OB_INIT_TWICE;
+    PROXY_NET_LOG(WARN, "io_uring init twice", K_(ring_fd), K(ret));
+  } else if (OB_UNLIKELY(0 == sq_entries) || OB_UNLIKELY(cq_entries < sq_entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    PROXY_NET_LOG(WARN, "invalid argument", K(sq_entries), K(cq_entries), K(ret));
+  } else if (OB_UNLIKELY((ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, sq_entries, &params))) < 0)) {
+    ret = OB_NOT_SUPPORTED;
+    PROXY_NET_LOG(INFO, "io_uring is not available", K(sq_entries), K(cq_entries), KERRMSGS, K(ret));
+  } else if (REQUIRED_FEATURES != (params.features_ & REQUIRED_FEATURES)) {
+    ret = OB_NOT_SUPPORTED;
+    PROXY_NET_LOG(INFO, "io_uring lacks multishot poll support", "features", params.features_, K(ret));
+  } else {
+    features_ = params.features_;
+    const size_t sq_ring_size = params.sq_off_.array_ + params.sq_entries_ * sizeof(uint32_t);
+    const size_t cq_ring_size = params.cq_off_.cqes_ + params.cq_entries_ * sizeof(ObIOUringCqe);
+    ring_size_ = std::max(sq_ring_size, cq_ring_size);
+    sqes_size_ = params.sq_entries_ * sizeof(ObIOUringSqe);
+
+    ring_ptr_ = ::mmap(NULL, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd_, OFF_SQ_RING);
+    if (OB_UNLIKELY(MAP_FAILED == ring_ptr_)) {
+      ring_ptr_ = NULL;
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      PROXY_NET_LOG(WARN, "fail to mmap io_uring ring", K_(ring_size), KERRMSGS, K(ret));
+    } else {
+      void *sqes = ::mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ring_fd_, OFF_SQES);
+      if (OB_UNLIKELY(MAP_FAILED == sqes)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        PROXY_NET_LOG(WARN, "fail to mmap io_uring sqes", K_(sqes_size), KERRMSGS, K(ret));
+      } else {
+        char *ring = static_cast<char *>(ring_ptr_);
+        sqes_ = static_cast<ObIOUringSqe *>(sqes);
+        sq_head_ = reinterpret_cast<uint32_t *>(ring + params.sq_off_.head_);
+        sq_tail_ = reinterpret_cast<uint32_t *>(ring + params.sq_off_.tail_);
+        sq_ring_mask_ = reinterpret_cast<uint32_t *>(ring + params.sq_off_.ring_mask_);
+        sq_array_ = reinterpret_cast<uint32_t *>(ring + params.sq_off_.array_);
+        sq_local_tail_ = *sq_tail_;
+        cq_head_ = reinterpret_cast<uint32_t *>(ring + params.cq_off_.head_);
+        cq_tail_ = reinterpret_cast<uint32_t *>(ring + params.cq_off_.tail_);
+        cq_ring_mask_ = reinterpret_cast<uint32_t *>(ring + params.cq_off_.ring_mask_);
+        cqes_ = reinterpret_cast<ObIOUringCqe *>(ring + params.cq_off_.cqes_);
+        PROXY_NET_LOG(INFO, "succ to init io_uring", K_(ring_fd), "sq_entries", params.sq_entries_,
+                      "cq_entries", params.cq_entries_, K_(features));
+      }
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (NULL != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+    sqes_ = NULL;
+  }
+  if (NULL != ring_ptr_) {
+    ::munmap(ring_ptr_, ring_size_);
+    ring_ptr_ = NULL;
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  sq_head_ = NULL;
+  sq_tail_ = NULL;
+  sq_ring_mask_ = NULL;
+  sq_array_ = NULL;
+  cq_head_ = NULL;
+  cq_tail_ = NULL;
+  cq_ring_mask_ = NULL;
+  cqes_ = NULL;
+  sq_pending_ = 0;
+}
+
+ObIOUringSqe *ObIOUring::get_sqe()
+{
+  ObIOUringSqe *sqe = NULL;
+  const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sq_local_tail_ - head > *sq_ring_mask_) {
+    // submission ring is full, flush it without waiting and retry once
+    if (OB_SUCCESS == submit_and_wait(0)) {
+      if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) <= *sq_ring_mask_) {
+        sqe = &sqes_[sq_local_tail_ & *sq_ring_mask_];
+      }
+    }
+  } else {
+    sqe = &sqes_[sq_local_tail_ & *sq_ring_mask_];
+  }
+  if (NULL != sqe) {
+    memset(sqe, 0, sizeof(ObIOUringSqe));
+    sq_array_[sq_local_tail_ & *sq_ring_mask_] = sq_local_tail_ & *sq_ring_mask_;
+    ++sq_local_tail_;
+    ++sq_pending_;
+    __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+  }
+  return sqe;
+}
+
+int ObIOUring::poll_add(const int fd, const uint32_t events, const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+  ObIOUringSqe *sqe = NULL;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(fd < 0) || OB_UNLIKELY(IGNORED_USER_DATA == user_data)) {
+    ret = OB_INVALID_ARGUMENT;
+    PROXY_NET_LOG(WARN, "invalid argument", K(fd), K(user_data), K(ret));
+  } else if (OB_ISNULL(sqe = get_sqe())) {
+    ret = OB_SIZE_OVERFLOW;
+    PROXY_NET_LOG(WARN, "io_uring submission ring is full", K(fd), K(ret));
+  } else {
+    sqe->opcode_ = OP_POLL_ADD;
+    sqe->fd_ = fd;
+    sqe->len_ = POLL_ADD_MULTI;
+    sqe->poll32_events_ = events;
+    sqe->user_data_ = user_data;
+  }
+  return ret;
+}
+
+int ObIOUring::poll_remove(const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+  ObIOUringSqe *sqe = NULL;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(sqe = get_sqe())) {
+    ret = OB_SIZE_OVERFLOW;
+    PROXY_NET_LOG(WARN, "io_uring submission ring is full", K(user_data), K(ret));
+  } else {
+    sqe->opcode_ = OP_POLL_REMOVE;
+    sqe->addr_ = user_data;
+    sqe->user_data_ = IGNORED_USER_DATA;
+    // the caller may free the object behind user_data as soon as we return,
+    // so cancel the poll now and neutralize the completions already queued for it
+    if (OB_FAIL(submit_and_wait(0))) {
+      PROXY_NET_LOG(WARN, "fail to submit io_uring poll remove", K(user_data), K(ret));
+    } else {
+      const uint32_t ready = cq_ready();
+      for (uint32_t i = 0; i < ready; ++i) {
+        ObIOUringCqe &cqe = cq_peek(i);
+        if (user_data == cqe.user_data_) {
+          cqe.user_data_ = IGNORED_USER_DATA;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObIOUring::enter(const uint32_t to_submit, const uint32_t min_complete,
+                     const uint32_t flags, void *arg, const size_t arg_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  do {
+    count = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, arg, arg_size);
+  } while (count < 0 && EINTR == errno);
+
+  if (OB_UNLIKELY(count < 0)) {
+    if (ETIME == errno || EBUSY == errno || EAGAIN == errno) {
+      // timed out, or the completion ring is backlogged and the caller must reap first
+    } else {
+      ret = ob_get_sys_errno();
+      PROXY_NET_LOG(WARN, "fail to io_uring_enter", K_(ring_fd), K(to_submit), K(min_complete),
+                    K(flags), KERRMSGS, K(ret));
+    }
+  }
+  sq_pending_ = sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  return ret;
+}
+
+int ObIOUring::submit_and_wait(const int64_t timeout_ms)
+{
+  int ret = OB_SUCCESS;
+  const uint32_t to_submit = static_cast<uint32_t>(sq_pending_);
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+  } else if (0 == timeout_ms || cq_ready() > 0) {
+    if (to_submit > 0) {
+      ret = enter(to_submit, 0, 0, NULL, 0);
+    }
+  } else if (timeout_ms < 0) {
+    ret = enter(to_submit, 1, ENTER_GETEVENTS, NULL, 0);
+  } else {
+    ObIOUringTimespec ts;
+    ts.tv_sec_ = timeout_ms / 1000;
+    ts.tv_nsec_ = (timeout_ms % 1000) * 1000000;
+    ObIOUringGeteventsArg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.ts_ = reinterpret_cast<uint64_t>(&ts);
+    ret = enter(to_submit, 1, ENTER_GETEVENTS | ENTER_EXT_ARG, &arg, sizeof(arg));
+  }
+  return ret;
+}
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_IO_URING_H
+#define OBPROXY_IO_URING_H
+
+#include "utils/ob_proxy_lib.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+// The kernel headers of our build environments (el7) do not ship linux/io_uring.h,
+// so we declare the small stable subset of the io_uring ABI we use here and talk
+// to the kernel through raw syscalls. Nothing here depends on liburing.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+struct ObIOUringSqe
+{
+  uint8_t opcode_;
+  uint8_t flags_;
+  uint16_t ioprio_;
+  int32_t fd_;
+  uint64_t off_;
+  uint64_t addr_;
+  uint32_t len_;
+  uint32_t poll32_events_;
+  uint64_t user_data_;
+  uint16_t buf_index_;
+  uint16_t personality_;
+  int32_t splice_fd_in_;
+  uint64_t pad_[2];
+};
+
+struct ObIOUringCqe
+{
+  uint64_t user_data_;
+  int32_t res_;
+  uint32_t flags_;
+};
+
+struct ObIOUringSqRingOffsets
+{
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t flags_;
+  uint32_t dropped_;
+  uint32_t array_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct ObIOUringCqRingOffsets
+{
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t overflow_;
+  uint32_t cqes_;
+  uint32_t flags_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct ObIOUringParams
+{
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  uint32_t flags_;
+  uint32_t sq_thread_cpu_;
+  uint32_t sq_thread_idle_;
+  uint32_t features_;
+  uint32_t wq_fd_;
+  uint32_t resv_[3];
+  ObIOUringSqRingOffsets sq_off_;
+  ObIOUringCqRingOffsets cq_off_;
+};
+
+struct ObIOUringGeteventsArg
+{
+  uint64_t sigmask_;
+  uint32_t sigmask_sz_;
+  uint32_t pad_;
+  uint64_t ts_;
+};
+
+struct ObIOUringTimespec
+{
+  int64_t tv_sec_;
+  int64_t tv_nsec_;
+};
+
+// ObIOUring is a minimal, single threaded io_uring instance used by the net
+// threads as a readiness notifier. Every registered fd gets one multishot
+// POLL_ADD whose completions carry the same event mask epoll would report,
+// so the rest of the net layer keeps its edge triggered readv/writev model.
+// Registrations are batched in the submission ring and flushed together with
+// the wait, i.e. one io_uring_enter per event loop iteration.
+class ObIOUring
+{
+public:
+  static const uint8_t OP_POLL_ADD = 6;
+  static const uint8_t OP_POLL_REMOVE = 7;
+  static const uint32_t SETUP_CQSIZE = (1U << 3);
+  static const uint32_t ENTER_GETEVENTS = (1U << 0);
+  static const uint32_t ENTER_EXT_ARG = (1U << 3);
+  static const uint32_t POLL_ADD_MULTI = (1U << 0);
+  static const uint32_t CQE_F_MORE = (1U << 1);
+  static const uint32_t FEAT_SINGLE_MMAP = (1U << 0);
+  static const uint32_t FEAT_NODROP = (1U << 1);
+  static const uint32_t FEAT_EXT_ARG = (1U << 8);
+  // multishot poll appeared in 5.13 together with this feature bit
+  static const uint32_t FEAT_RSRC_TAGS = (1U << 10);
+  static const uint32_t REQUIRED_FEATURES = FEAT_SINGLE_MMAP | FEAT_NODROP | FEAT_EXT_ARG | FEAT_RSRC_TAGS;
+  static const uint64_t OFF_SQ_RING = 0ULL;
+  static const uint64_t OFF_SQES = 0x10000000ULL;
+  // user data of the POLL_REMOVE requests themselves, their completions are dropped
+  static const uint64_t IGNORED_USER_DATA = 0;
+
+  ObIOUring();
+  ~ObIOUring() { destroy(); }
+
+  int init(const uint32_t sq_entries, const uint32_t cq_entries);
+  void destroy();
+  bool is_inited() const { return ring_fd_ >= 0; }
+
+  int poll_add(const int fd, const uint32_t events, const uint64_t user_data);
+  int poll_remove(const uint64_t user_data);
+
+  // submit all pending sqes and wait up to timeout_ms for at least one cqe,
+  // timeout_ms == 0 means do not wait, timeout_ms < 0 means wait forever
+  int submit_and_wait(const int64_t timeout_ms);
+
+  uint32_t cq_ready() const
+  {
+    return __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) - *cq_head_;
+  }
+  ObIOUringCqe &cq_peek(const uint32_t idx) { return cqes_[(*cq_head_ + idx) & *cq_ring_mask_]; }
+  void cq_advance(const uint32_t count) { __atomic_store_n(cq_head_, *cq_head_ + count, __ATOMIC_RELEASE); }
+
+  int64_t get_sq_pending() const { return sq_pending_; }
+
+private:
+  ObIOUringSqe *get_sqe();
+  int enter(const uint32_t to_submit, const uint32_t min_complete,
+            const uint32_t flags, void *arg, const size_t arg_size);
+
+private:
+  int ring_fd_;
+  uint32_t features_;
+  void *ring_ptr_;
+  size_t ring_size_;
+  ObIOUringSqe *sqes_;
+  size_t sqes_size_;
+
+  uint32_t *sq_head_;
+  uint32_t *sq_tail_;
+  uint32_t *sq_ring_mask_;
+  uint32_t *sq_array_;
+  uint32_t sq_local_tail_;
+  int64_t sq_pending_;
+
+  uint32_t *cq_head_;
+  uint32_t *cq_tail_;
+  uint32_t *cq_ring_mask_;
+  ObIOUringCqe *cqes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_IO_URING_H
@@ -71,6 +71,13 @@ int update_net_options(const ObNetOptions &net_options)
     PROXY_NET_LOG(WARN, "fail to update_cop_config",
                   K(net_options.default_inactivity_timeout_),
                   K(net_options.max_client_connections_), K(ret));
+  } else if (OB_FAIL(update_busy_poll_config(HRTIME_USECONDS(net_options.busy_poll_time_),
+                                             net_options.busy_poll_thread_num_))) {
+    PROXY_NET_LOG(WARN, "fail to update_busy_poll_config",
+                  K(net_options.busy_poll_time_),
+                  K(net_options.busy_poll_thread_num_), K(ret));
+  } else {
+    event::ObBufAllocator::get_buf_allocator().set_thread_cache_size(net_options.iobuffer_thread_cache_size_);
   }
   return ret;
 }
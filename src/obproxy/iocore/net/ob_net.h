@@ -82,6 +82,9 @@ struct ObNetOptions
   int64_t max_connections_;
   int64_t default_inactivity_timeout_;
   int64_t max_client_connections_;
+  int64_t busy_poll_time_;         // us, 0 means never spin
+  int64_t busy_poll_thread_num_;   // 0 means all net threads
+  int64_t iobuffer_thread_cache_size_;
 };
 
 int init_net(ObModuleVersion version, const ObNetOptions &net_options);
@@ -29,6 +29,7 @@
  *
  */
 
+#include <linux/filter.h>
 #include "iocore/net/ob_net_accept.h"
 #include "iocore/net/ob_net.h"
 #include "iocore/net/ob_event_io.h"
@@ -58,6 +59,18 @@ namespace net
 
 static const bool accept_till_done = true;
 
+#ifndef SO_ATTACH_REUSEPORT_CBPF
+#define SO_ATTACH_REUSEPORT_CBPF 51
+#endif
+
+static bool is_reuseport_socket(const int fd)
+{
+  int32_t optval = 0;
+  int optlen = static_cast<int>(sizeof(optval));
+  return OB_SUCCESS == ObSocketManager::getsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &optval, &optlen)
+         && 0 != optval;
+}
+
 inline int do_net_accept(ObNetAccept *na, void *ep, const bool blockable)
 {
   int ret = OB_SUCCESS;
@@ -219,6 +232,13 @@ int ObNetAccept::init_accept_per_thread()
   if (OB_FAIL(do_listen(NON_BLOCKING))) {
     PROXY_NET_LOG(ERROR, "fail to listen", K(ret));
   } else {
+    if (server_.reuseport_ && !is_reuseport_socket(server_.fd_)) {
+      // inherited from a parent process which did not listen with SO_REUSEPORT,
+      // no more socket can join it, so all the net threads still share it
+      PROXY_NET_LOG(WARN, "listen socket is not SO_REUSEPORT, disable reuseport accept",
+                    K(server_.fd_), K(server_.addr_));
+      server_.reuseport_ = false;
+    }
     if (accept_fn_ == net_accept) {
       SET_HANDLER((NetAcceptHandler)&ObNetAccept::accept_fast_event);
     } else {
@@ -227,23 +247,33 @@ int ObNetAccept::init_accept_per_thread()
     period_ = ACCEPT_PERIOD;
     ObNetAccept *na = NULL;
     int64_t n = g_event_processor.thread_count_for_type_[ET_NET];
-    NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, n);
+    int64_t acceptor_count = n;
+    if (server_.reuseport_) {
+      // a sub process with less net threads still needs to accept on all the
+      // inherited sockets, closing them would reset their queued connections
+      acceptor_count = std::max(n, get_global_hot_upgrade_info().get_reuseport_fd_count(server_.addr_.is_ip6()) + 1);
+    }
+    NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, acceptor_count);
 
-    for (int64_t i = 0; i < n && OB_SUCC(ret); ++i) {
-      if (i < n - 1) {
+    for (int64_t i = 0; i < acceptor_count && OB_SUCC(ret); ++i) {
+      if (i < acceptor_count - 1) {
         if (OB_ISNULL(na = new (std::nothrow) ObNetAccept())) {
           ret = OB_ALLOCATE_MEMORY_FAILED;
           PROXY_NET_LOG(ERROR, "fail to new ObNetAccept");
         } else if (OB_FAIL(na->deep_copy(*this))) {
           NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, -1);
           PROXY_NET_LOG(ERROR, "fail to deep_copy", K(i), K(ret));
+        } else if (server_.reuseport_ && OB_FAIL(na->do_listen_reuseport(i))) {
+          NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, -1);
+          PROXY_NET_LOG(ERROR, "fail to do_listen_reuseport", K(i), K(ret));
         }
       } else {
         na = this;
       }
 
       if (OB_SUCC(ret)) {
-        t = g_event_processor.event_thread_[ET_NET][i];
+        // socket k of the SO_REUSEPORT group is served by net thread k % n
+        t = g_event_processor.event_thread_[ET_NET][get_reuseport_group_idx(i, acceptor_count) % n];
         if (OB_ISNULL(t)) {
           ret = OB_ERR_UNEXPECTED;
           PROXY_NET_LOG(ERROR, "g_event_processor fail to get ET_NET ObEThread", K(ret));
@@ -259,6 +289,63 @@ int ObNetAccept::init_accept_per_thread()
         }
       }
     }
+
+    if (OB_SUCC(ret) && server_.reuseport_) {
+      PROXY_NET_LOG(INFO, "succ to init reuseport accept", K(server_.addr_), K(n), K(acceptor_count),
+                    K_(reuseport_cpu_steering));
+      if (reuseport_cpu_steering_ && OB_FAIL(attach_reuseport_cpu_steering(acceptor_count))) {
+        // the kernel still balances by hash
+        PROXY_NET_LOG(WARN, "fail to attach reuseport cpu steering", K(acceptor_count), K(ret));
+        ret = OB_SUCCESS;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNetAccept::do_listen_reuseport(const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  const int inherited_fd = get_global_hot_upgrade_info().get_reuseport_fd(server_.addr_.is_ip6(), idx);
+  if (inherited_fd >= 0) {
+    // the parent process has listened on it, and it is still in the SO_REUSEPORT group
+    server_.fd_ = inherited_fd;
+    PROXY_NET_LOG(INFO, "succ to inherit reuseport listen socket", K(idx), K(server_.fd_), K(server_.addr_));
+  } else {
+    // deep_copy() has copied the fd of the first listen socket
+    server_.fd_ = NO_FD;
+    if (OB_FAIL(server_.listen(NON_BLOCKING, recv_bufsize_, send_bufsize_))) {
+      PROXY_NET_LOG(ERROR, "fail to listen reuseport socket", K(idx), K(server_.accept_addr_), KERRMSGS, K(ret));
+    } else {
+      PROXY_NET_LOG(DEBUG, "succ to listen reuseport socket", K(idx), K(server_.fd_), K(server_.addr_));
+    }
+  }
+  return ret;
+}
+
+// The kernel hands a new connection to the socket at index (cpu % group_size)
+// of the SO_REUSEPORT group, the index is the order in which the sockets were
+// listened, it is the same on all of them, so attaching to one is enough.
+// Sockets are served in net thread id order, see get_reuseport_group_idx().
+int ObNetAccept::attach_reuseport_cpu_steering(const int64_t group_size)
+{
+  int ret = OB_SUCCESS;
+  struct sock_filter code[] = {
+    { static_cast<uint16_t>(BPF_LD | BPF_W | BPF_ABS), 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+    { static_cast<uint16_t>(BPF_ALU | BPF_MOD | BPF_K), 0, 0, static_cast<uint32_t>(group_size) },
+    { static_cast<uint16_t>(BPF_RET | BPF_A), 0, 0, 0 },
+  };
+  struct sock_fprog prog;
+  prog.len = static_cast<uint16_t>(sizeof(code) / sizeof(code[0]));
+  prog.filter = code;
+  if (OB_UNLIKELY(group_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    PROXY_NET_LOG(WARN, "invalid argument", K(group_size), K(ret));
+  } else if (OB_FAIL(ObSocketManager::setsockopt(server_.fd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                                                 &prog, static_cast<int>(sizeof(prog))))) {
+    PROXY_NET_LOG(WARN, "fail to set sockopt SO_ATTACH_REUSEPORT_CBPF", K(server_.fd_), KERRMSGS, K(ret));
+  } else {
+    PROXY_NET_LOG(INFO, "succ to attach reuseport cpu steering", K(server_.fd_), K(group_size));
   }
   return ret;
 }
@@ -725,7 +812,7 @@ int ObNetAccept::accept_fast_event(int event, void *ep)
       PROXY_NET_LOG(ERROR, "fail to get ethread", K(ret));
     } else {
       while (loop && OB_SUCC(ret)) {
-        if (!accept_balance(e->ethread_)) { // for balance
+        if (!server_.reuseport_ && !accept_balance(e->ethread_)) { // for balance
           ret = OB_SYS_EAGAIN;
           net_ret = ret;
           con.fd_ = NO_FD;
@@ -756,7 +843,7 @@ int ObNetAccept::accept_fast_event(int event, void *ep)
                                      *vc, EVENTIO_READ | EVENTIO_WRITE))) {
             PROXY_NET_LOG(ERROR, "fail to start ObEventIO", K(con.addr_), K(con.fd_), K(ret));
           } else {
-            vc->nh_->open_list_.enqueue(vc);
+            vc->nh_->add_to_open_list(*vc);
 #ifdef USE_EDGE_TRIGGER
             // Set the vc as triggered and place it in the read ready queue in case
             // there is already data on the socket.
@@ -912,6 +999,7 @@ ObNetAccept::ObNetAccept()
       accept_fn_(NULL),
       callback_on_open_(false),
       backdoor_(false),
+      reuseport_cpu_steering_(false),
       recv_bufsize_(0),
       send_bufsize_(0),
       sockopt_flags_(0),
@@ -98,6 +98,16 @@ public:
   virtual ~ObNetAccept();
 
   int do_listen(const bool non_blocking);
+  // listen on the idx-th extra socket of the SO_REUSEPORT group, or adopt
+  // the one inherited from parent process
+  int do_listen_reuseport(const int64_t idx);
+  // the i-th acceptor of init_accept_per_thread() owns the socket at this
+  // index of the SO_REUSEPORT group, the last acceptor is this one, whose
+  // socket is listened first
+  static int64_t get_reuseport_group_idx(const int64_t acceptor_idx, const int64_t acceptor_count)
+  {
+    return (acceptor_idx + 1) % acceptor_count;
+  }
   int deep_copy(const ObNetAccept &na);
   int init_accept_loop(const char *thread_name, const int64_t stacksize);
   int init_accept_per_thread();
@@ -127,6 +137,8 @@ private:
   // only the ethread which has minimal client connections will do accept
   bool accept_balance(event::ObEThread *ethread);
 
+  int attach_reuseport_cpu_steering(const int64_t group_size);
+
   int fetch_vip_tenant(ObUnixNetVConnection* vc, obutils::ObVipTenant& vip_tenant, bool& lookup_success);
   int fetch_tenant_cpu(obutils::ObVipTenant& vip_tenant, omt::ObTenantCpu*& tenant_cpu, bool& lookup_success);
   int handle_tenant_cpu_isolated(omt::ObTenantCpu* tenant_cpu, event::ObEThread*& ethread);
@@ -137,6 +149,7 @@ public:
   AcceptFunctionPtr accept_fn_;
   bool callback_on_open_;
   bool backdoor_;
+  bool reuseport_cpu_steering_;
   common::ObPtr<ObNetAcceptAction> action_;
   int32_t recv_bufsize_;
   int32_t send_bufsize_;
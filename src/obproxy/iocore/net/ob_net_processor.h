@@ -102,6 +102,16 @@ public:
     bool frequent_accept_;
     bool backdoor_;
 
+    // Every ET_NET thread accepts on its own SO_REUSEPORT listen socket,
+    // the kernel balances new connections among them. accept_threads_ is
+    // ignored if set.
+    // Default: false.
+    bool reuseport_;
+    // Attach a CBPF program to the SO_REUSEPORT group which picks the
+    // listen socket by the cpu receiving the connection.
+    // Default: false.
+    bool reuseport_cpu_steering_;
+
     // tcp defer accept timeout, if it set, accept until there is
     // data on the socket ready to be read. unit second.
     int64_t defer_accept_timeout_;
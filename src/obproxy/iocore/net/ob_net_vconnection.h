@@ -415,6 +415,18 @@ public:
   // Set the TCP initial congestion window
   virtual int set_tcp_init_cwnd(const int32_t init_cwnd) = 0;
 
+  // Send writes no less than min_size with MSG_ZEROCOPY, 0 == min_size disables it.
+  // The caller must not rewrite the written buffer blocks in place while enabled.
+  virtual int set_zero_copy_send(const int64_t min_size)
+  {
+    UNUSED(min_size);
+    return common::OB_NOT_SUPPORTED;
+  }
+
+  // Let writes smaller than max_size wait one net loop, so that the data
+  // arriving meanwhile goes out with the same writev, 0 == max_size disables it.
+  virtual void set_write_coalesce_size(const int64_t max_size) { UNUSED(max_size); }
+
 protected:
   virtual int get_socket() = 0;
 
@@ -449,7 +461,7 @@ public:
 
   // for OBAPI
   bool get_is_force_timeout() const { return is_force_timeout_; }
-  void set_is_force_timeout(const bool force_timeout) { is_force_timeout_ = force_timeout;}
+  virtual void set_is_force_timeout(const bool force_timeout) { is_force_timeout_ = force_timeout;}
 
 public:
   // Structure holding user options
@@ -34,6 +34,7 @@
 
 #include "utils/ob_proxy_lib.h"
 #include "iocore/net/ob_socket_manager.h"
+#include "iocore/net/ob_io_uring.h"
 
 namespace oceanbase
 {
@@ -44,24 +45,44 @@ namespace net
 
 typedef struct pollfd ObPollfd;
 
+enum ObPollBackend
+{
+  POLL_BACKEND_EPOLL = 0,
+  POLL_BACKEND_IO_URING,
+};
+
 class ObPollDescriptor
 {
 
 public:
   ObPollDescriptor()
     : result_(0),
-      epoll_fd_(common::OB_INVALID_INDEX)
+      epoll_fd_(common::OB_INVALID_INDEX),
+      backend_(POLL_BACKEND_EPOLL),
+      io_uring_()
   {
     memset(epoll_triggered_events_, 0, sizeof(epoll_triggered_events_));
+    memset(need_rearm_, 0, sizeof(need_rearm_));
     memset(pfd_, 0, sizeof(pfd_));
   }
   ~ObPollDescriptor() { }
 
-  int init()
+  // if use_io_uring is true and the kernel supports multishot poll, socket
+  // readiness is collected through io_uring, otherwise fall back to epoll
+  int init(const bool use_io_uring = false)
   {
     int ret = common::OB_SUCCESS;
     int result = -1;
-    if (OB_FAIL(ObSocketManager::epoll_create(POLL_DESCRIPTOR_SIZE, epoll_fd_))) {
+    if (use_io_uring) {
+      if (common::OB_SUCCESS == io_uring_.init(IO_URING_SQ_ENTRIES, IO_URING_CQ_ENTRIES)) {
+        backend_ = POLL_BACKEND_IO_URING;
+      } else {
+        PROXY_SOCK_LOG(WARN, "io_uring is not supported by kernel, fall back to epoll");
+      }
+    }
+    if (POLL_BACKEND_IO_URING == backend_) {
+      // no epoll fd needed
+    } else if (OB_FAIL(ObSocketManager::epoll_create(POLL_DESCRIPTOR_SIZE, epoll_fd_))) {
       PROXY_SOCK_LOG(WARN, "fail to epoll_create epoll",
                      K(epoll_fd_), KERRMSGS, K(ret));
     } else if (OB_FAIL(ObSocketManager::fcntl(epoll_fd_, F_SETFD, FD_CLOEXEC, result))) {
@@ -74,6 +95,90 @@ public:
     return ret;
   }
 
+  // register fd, events are epoll events, data is reported back by wait()
+  int add(const int fd, const uint32_t events, void *data)
+  {
+    int ret = common::OB_SUCCESS;
+    if (POLL_BACKEND_IO_URING == backend_) {
+      if (OB_FAIL(io_uring_.poll_add(fd, events, reinterpret_cast<uint64_t>(data)))) {
+        PROXY_SOCK_LOG(WARN, "fail to add io_uring poll", K(fd), K(events), K(ret));
+      }
+    } else {
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = events;
+      ev.data.ptr = data;
+      if (OB_FAIL(ObSocketManager::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev))) {
+        PROXY_SOCK_LOG(WARN, "fail to epoll_ctl, op is EPOLL_CTL_ADD", K_(epoll_fd), K(fd), K(ret));
+      }
+    }
+    return ret;
+  }
+
+  // unregister fd, no event carrying data will be reported after it returns
+  int del(const int fd, void *data)
+  {
+    int ret = common::OB_SUCCESS;
+    if (POLL_BACKEND_IO_URING == backend_) {
+      if (OB_FAIL(io_uring_.poll_remove(reinterpret_cast<uint64_t>(data)))) {
+        PROXY_SOCK_LOG(WARN, "fail to remove io_uring poll", K(fd), K(ret));
+      }
+    } else {
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(struct epoll_event));
+      ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+      if (OB_FAIL(ObSocketManager::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, &ev))) {
+        PROXY_SOCK_LOG(WARN, "fail to epoll_ctl, op is EPOLL_CTL_DEL", K_(epoll_fd), K(fd), K(ret));
+      }
+    }
+    return ret;
+  }
+
+  // wait for events, result_ is set to the count of triggered events
+  int wait(const int32_t timeout_ms)
+  {
+    int ret = common::OB_SUCCESS;
+    if (POLL_BACKEND_IO_URING == backend_) {
+      result_ = 0;
+      if (OB_FAIL(io_uring_.submit_and_wait(timeout_ms))) {
+        PROXY_SOCK_LOG(WARN, "fail to wait io_uring", K(timeout_ms), K(ret));
+      } else {
+        const uint32_t ready = std::min(io_uring_.cq_ready(), static_cast<uint32_t>(POLL_DESCRIPTOR_SIZE));
+        for (uint32_t i = 0; i < ready; ++i) {
+          const ObIOUringCqe &cqe = io_uring_.cq_peek(i);
+          if (ObIOUring::IGNORED_USER_DATA == cqe.user_data_ || -ECANCELED == cqe.res_) {
+            // poll removed or completion of a poll remove request
+          } else {
+            if (cqe.res_ < 0) {
+              // poll failed, report it as an error on the fd and let the owner close it
+              epoll_triggered_events_[result_].events = EPOLLERR;
+              need_rearm_[result_] = false;
+            } else {
+              epoll_triggered_events_[result_].events = static_cast<uint32_t>(cqe.res_);
+              // multishot poll terminated by kernel (e.g. cq overflow), must be re-armed
+              need_rearm_[result_] = (0 == (cqe.flags_ & ObIOUring::CQE_F_MORE));
+            }
+            epoll_triggered_events_[result_].data.ptr = reinterpret_cast<void *>(cqe.user_data_);
+            ++result_;
+          }
+        }
+        io_uring_.cq_advance(ready);
+      }
+    } else if (OB_FAIL(ObSocketManager::epoll_wait(epoll_fd_, epoll_triggered_events_,
+                                                   POLL_DESCRIPTOR_SIZE, timeout_ms, result_))) {
+      PROXY_SOCK_LOG(WARN, "fail to epoll_wait", K_(epoll_fd), K(timeout_ms), K(ret));
+    }
+    return ret;
+  }
+
+  bool need_rearm(const int64_t index) const
+  {
+    return POLL_BACKEND_IO_URING == backend_ && index >= 0 && index < result_ && need_rearm_[index];
+  }
+
+  ObPollBackend get_backend() const { return backend_; }
+  bool is_io_uring() const { return POLL_BACKEND_IO_URING == backend_; }
+
   int get_ev_events(const int64_t index, uint32_t &events) const
   {
     int ret = common::OB_SUCCESS;
@@ -100,6 +205,8 @@ public:
 
 public:
   static const int64_t POLL_DESCRIPTOR_SIZE = 4096;
+  static const uint32_t IO_URING_SQ_ENTRIES = 4096;
+  static const uint32_t IO_URING_CQ_ENTRIES = 65536;
   // result of poll
   int64_t result_;
   int epoll_fd_;
@@ -107,6 +214,9 @@ public:
   struct epoll_event epoll_triggered_events_[POLL_DESCRIPTOR_SIZE];
 
 private:
+  ObPollBackend backend_;
+  ObIOUring io_uring_;
+  bool need_rearm_[POLL_DESCRIPTOR_SIZE];
   ObPollfd pfd_[POLL_DESCRIPTOR_SIZE];
 
   DISALLOW_COPY_AND_ASSIGN(ObPollDescriptor);
@@ -72,6 +72,8 @@ class ObSocketManager
   static int write(int sockfd, const void *buf, const int64_t size, int64_t &count);
   static int writev(int sockfd, const struct iovec *vector, const int size, int64_t &count);
 
+  static int sendmsg(int sockfd, const struct msghdr *msg, const int flags, int64_t &count);
+  static int recvmsg(int sockfd, struct msghdr *msg, const int flags, int64_t &count);
 
   static int fcntl(int sockfd, const int cmd, const int arg, int &result);
   static int set_fl(int sockfd, const int arg, int &result);
@@ -323,6 +325,34 @@ inline int ObSocketManager::writev(int sockfd, const struct iovec *vector, const
   return ret;
 }
 
+inline int ObSocketManager::sendmsg(int sockfd, const struct msghdr *msg, const int flags, int64_t &count)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_UNLIKELY(sockfd < 3) || OB_ISNULL(msg)) {
+    ret = common::OB_INVALID_ARGUMENT;
+  } else {
+    count = ::sendmsg(sockfd, msg, flags);
+    if (OB_UNLIKELY(count < 0)) {
+      ret = ob_get_sys_errno();
+    }
+  }
+  return ret;
+}
+
+inline int ObSocketManager::recvmsg(int sockfd, struct msghdr *msg, const int flags, int64_t &count)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_UNLIKELY(sockfd < 3) || OB_ISNULL(msg)) {
+    ret = common::OB_INVALID_ARGUMENT;
+  } else {
+    count = ::recvmsg(sockfd, msg, flags);
+    if (OB_UNLIKELY(count < 0)) {
+      ret = ob_get_sys_errno();
+    }
+  }
+  return ret;
+}
+
 inline int ObSocketManager::fcntl(int sockfd, const int cmd, const int arg, int &result)
 {
   int ret = common::OB_SUCCESS;
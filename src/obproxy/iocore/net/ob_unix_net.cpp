@@ -151,6 +151,32 @@ int update_cop_config(const int64_t default_inactivity_timeout, const int64_t ma
   return ret;
 }
 
+int update_busy_poll_config(const ObHRTime busy_poll_time, const int64_t busy_poll_thread_num)
+{
+  int ret = OB_SUCCESS;
+  int64_t net_thread_count = g_event_processor.thread_count_for_type_[ET_NET];
+  ObEThread **netthreads = g_event_processor.event_thread_[ET_NET];
+
+  if (OB_ISNULL(netthreads) || OB_UNLIKELY(net_thread_count < 0)
+      || OB_UNLIKELY(busy_poll_time < 0) || OB_UNLIKELY(busy_poll_thread_num < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    PROXY_NET_LOG(WARN, "invalid argument", K(netthreads), K(net_thread_count),
+                  K(busy_poll_time), K(busy_poll_thread_num), K(ret));
+  } else {
+    const int64_t spin_thread_count = (0 == busy_poll_thread_num) ? net_thread_count : busy_poll_thread_num;
+    for (int64_t i = 0; i < net_thread_count && OB_SUCC(ret); ++i) {
+      if (OB_ISNULL(netthreads[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        PROXY_NET_LOG(WARN, "get netthread from netthreads is null",
+                      K(netthreads[i]), K(i), K(ret));
+      } else {
+        netthreads[i]->get_net_handler().set_busy_poll_max_time(i < spin_thread_count ? busy_poll_time : 0);
+      }
+    }
+  }
+  return ret;
+}
+
 int initialize_thread_for_net(ObEThread *thread)
 {
   int ret = OB_SUCCESS;
@@ -248,7 +274,7 @@ int ObNetPoll::init()
     if (OB_ISNULL(poll_descriptor_)) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       PROXY_NET_LOG(WARN, "fail to new ObPollDescriptor", K(ret));
-    } else if (OB_FAIL(poll_descriptor_->init())) {
+    } else if (OB_FAIL(poll_descriptor_->init(get_global_proxy_config().enable_io_uring))) {
       PROXY_NET_LOG(WARN, "fail to init poll_descriptor");
       delete poll_descriptor_;
       poll_descriptor_ = NULL;
@@ -260,28 +286,15 @@ int ObNetPoll::init()
       ret = OB_ALLOCATE_MEMORY_FAILED;
       PROXY_NET_LOG(ERROR, "fail to new ObEventIO", K(ret));
     } else {
-      struct epoll_event ev;
-      memset(&ev, 0, sizeof(ev));
-      ev.events = EVENTIO_READ;
-      ev.data.ptr = ep_;
       ep_->type_ = EVENTIO_TIMER;
-      if (OB_FAIL(ObSocketManager::epoll_ctl(poll_descriptor_->epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev))) {
-        PROXY_NET_LOG(WARN, "fail to epoll_ctl, op is EPOLL_CTL_ADD", K(poll_descriptor_->epoll_fd_), K_(timer_fd), K(ret));
+      if (OB_FAIL(ep_->start(*poll_descriptor_, timer_fd_, EVENTIO_READ))) {
+        PROXY_NET_LOG(WARN, "fail to start timer event io", K_(timer_fd), K(ret));
       }
     }
   }
   return ret;
 }
 
-int ObNetPoll::timerfd_settime()
-{
-  int ret = OB_SUCCESS;
-  if (timer_fd_ > 0 && OB_FAIL(ObTimerFdManager::timerfd_settime(timer_fd_, 0, 0, 1))) {
-    PROXY_NET_LOG(WARN, "fail to set timer time, it should not happened", K(timer_fd_), K(ret));
-  }
-  return ret;
-}
-
 ObInactivityCop::ObInactivityCop(ObProxyMutex *m)
     : ObContinuation(m), default_inactivity_timeout_(1800),
       total_connections_in_(0), max_connections_in_(0), connections_per_thread_in_(0)
@@ -338,76 +351,32 @@ int ObInactivityCop::check_inactivity(int event, ObEvent *e)
       info.graceful_exit_end_time_ = 0;
     }
 
-    // Copy the list and use pop() to catch any closes caused by callbacks.
-    forl_LL(ObUnixNetVConnection, vc, nh.open_list_) {
-      if (vc->thread_ == ethread) {
-        if (ObUnixNetVConnection::VC_ACCEPT == vc->source_type_) {
-          ++total_connections_in_;
-        }
-        nh.cop_list_.push(vc);
-      }
+    const bool is_graceful_timeout = info.graceful_exit_end_time_ >= info.graceful_exit_start_time_
+                                     && info.graceful_exit_end_time_ > 0
+                                     && info.graceful_exit_end_time_ < now;
+    if (is_graceful_timeout
+        || (0 < get_global_proxy_config().server_detect_mode
+            && get_global_resource_pool_processor().ip_set_.size() > 0)) {
+      sweep_open_list(nh, is_graceful_timeout, e);
     }
 
+    // inactivity checks requested by other threads
     ObUnixNetVConnection *vc = NULL;
-    ObHRTime diff = 0;
-
-    int close_ret = OB_SUCCESS;
-    while ((NULL != (vc = nh.cop_list_.pop())) && OB_SUCC(ret)) {
-      // If we cannot get the lock don't stop just keep cleaning
-      MUTEX_TRY_LOCK(lock, vc->mutex_, ethread);
-      if (!lock.is_locked()) {
-        NET_INCREMENT_DYN_STAT(INACTIVITY_COP_LOCK_ACQUIRE_FAILURE);
-      } else if (vc->closed_) {
-        if (OB_UNLIKELY(OB_SUCCESS != (close_ret = vc->close()))) {
-          PROXY_NET_LOG(WARN, "fail to close unix net vconnection", K(vc), K(close_ret));
-        }
-      } else {
-        int32_t event = EVENT_NONE;
-        if (vc->get_is_force_timeout()
-            || (info.graceful_exit_end_time_ >= info.graceful_exit_start_time_
-                && info.graceful_exit_end_time_ > 0
-                && info.graceful_exit_end_time_ < now)) {
-          vc->next_inactivity_timeout_at_ = now; // force the connection timeout
-        }
-
-        if (now != vc->next_inactivity_timeout_at_) {
-          ObIpEndpoint ip(vc->get_remote_addr());
-          if (0 < get_global_proxy_config().server_detect_mode
-              && vc->source_type_ == ObUnixNetVConnection::VC_CONNECT
-              && OB_HASH_EXIST == get_global_resource_pool_processor().ip_set_.exist_refactored(ip)) {
-            PROXY_NET_LOG(WARN, "detect server dead, close connection", K(ip));
-            event = EVENT_ERROR;
-          }
-        }
-
-        // set a default inactivity timeout if one is not set
-        if (0 == vc->next_inactivity_timeout_at_ && default_inactivity_timeout_ > 0) {
-          PROXY_NET_LOG(DEBUG, "inactivity timeout not set, setting a default",
-                        K(vc), K(vc->source_type_), K(default_inactivity_timeout_));
-          vc->set_inactivity_timeout(HRTIME_SECONDS(default_inactivity_timeout_));
-          NET_INCREMENT_DYN_STAT(DEFAULT_INACTIVITY_TIMEOUT);
-        } else {
-          PROXY_NET_LOG(DEBUG, "inactivity timeout state", K(vc), K(vc->source_type_),
-                        "next_inactivity_timeout_at", hrtime_to_sec(vc->next_inactivity_timeout_at_),
-                        "inactivity_timeout_in", hrtime_to_sec(vc->inactivity_timeout_in_));
-        }
+    SList(ObUnixNetVConnection, timeout_enable_link_) eq(nh.inactivity_enable_list_.popall());
+    while (NULL != (vc = eq.pop())) {
+      vc->in_timeout_enable_list_ = false;
+      nh.schedule_inactivity_check(*vc, 0);
+    }
 
-        if (vc->next_inactivity_timeout_at_ > 0 && vc->next_inactivity_timeout_at_ <= now) {
-          if (nh.keep_alive_list_.in(vc)) {
-            // only stat if the connection is in keep-alive, there can be other inactivity timeouts
-            diff = (now - (vc->next_inactivity_timeout_at_ - vc->inactivity_timeout_in_)) / HRTIME_SECOND;
-            NET_SUM_DYN_STAT(KEEP_ALIVE_LRU_TIMEOUT_TOTAL, diff);
-            NET_INCREMENT_DYN_STAT(KEEP_ALIVE_LRU_TIMEOUT_COUNT);
-          }
-          PROXY_NET_LOG(DEBUG, "inactivity timeout state", K(vc), K(vc->source_type_), K(now),
-                        "next_inactivity_timeout_at", hrtime_to_sec(vc->next_inactivity_timeout_at_),
-                        "inactivity_timeout_in", hrtime_to_sec(vc->inactivity_timeout_in_));
-          vc->handle_event(EVENT_IMMEDIATE, e);
-        } else if (EVENT_NONE != event) {
-          vc->handle_event(event, e);
-        }
-      }
+    // Use dequeue() to catch any closes caused by callbacks.
+    nh.inactivity_wheel_.advance(now, nh.inactivity_expired_list_);
+    while (NULL != (vc = nh.inactivity_expired_list_.dequeue())) {
+      check_vc_inactivity(nh, *vc, now, is_graceful_timeout, e);
     }
+    total_connections_in_ = nh.accept_connections_count_;
+
+    nh.free_zero_copy_orphans(now);
+    report_iobuffer_cache_stat();
 
     // Keep-alive LRU for incoming connections
     if (OB_SUCC(ret) && OB_FAIL(keep_alive_lru(nh, now, e))) {
@@ -417,6 +386,105 @@ int ObInactivityCop::check_inactivity(int event, ObEvent *e)
   return (OB_SUCCESS == ret) ? EVENT_DONE : EVENT_ERROR;
 }
 
+void ObInactivityCop::check_vc_inactivity(ObNetHandler &nh, ObUnixNetVConnection &vc, const ObHRTime now,
+                                          const bool is_graceful_timeout, ObEvent *e)
+{
+  int ret = OB_SUCCESS;
+  ObHRTime diff = 0;
+  ObEThread *ethread = &self_ethread();
+
+  // If we cannot get the lock don't stop, just try it again next round
+  MUTEX_TRY_LOCK(lock, vc.mutex_, ethread);
+  if (!lock.is_locked()) {
+    NET_INCREMENT_DYN_STAT(INACTIVITY_COP_LOCK_ACQUIRE_FAILURE);
+    nh.schedule_inactivity_check(vc, now);
+  } else if (vc.closed_) {
+    if (OB_FAIL(vc.close())) {
+      PROXY_NET_LOG(WARN, "fail to close unix net vconnection", K(&vc), K(ret));
+    }
+  } else {
+    if (vc.get_is_force_timeout() || is_graceful_timeout) {
+      vc.next_inactivity_timeout_at_ = now; // force the connection timeout
+    }
+
+    if (0 == vc.next_inactivity_timeout_at_) {
+      // set a default inactivity timeout if one is not set
+      if (default_inactivity_timeout_ > 0) {
+        PROXY_NET_LOG(DEBUG, "inactivity timeout not set, setting a default",
+                      K(&vc), K(vc.source_type_), K(default_inactivity_timeout_));
+        vc.set_inactivity_timeout(HRTIME_SECONDS(default_inactivity_timeout_));
+        NET_INCREMENT_DYN_STAT(DEFAULT_INACTIVITY_TIMEOUT);
+      }
+    } else if (vc.next_inactivity_timeout_at_ > now) {
+      // there was activity since it was scheduled
+      nh.schedule_inactivity_check(vc, vc.next_inactivity_timeout_at_);
+    } else {
+      if (nh.keep_alive_list_.in(&vc)) {
+        // only stat if the connection is in keep-alive, there can be other inactivity timeouts
+        diff = (now - (vc.next_inactivity_timeout_at_ - vc.inactivity_timeout_in_)) / HRTIME_SECOND;
+        NET_SUM_DYN_STAT(KEEP_ALIVE_LRU_TIMEOUT_TOTAL, diff);
+        NET_INCREMENT_DYN_STAT(KEEP_ALIVE_LRU_TIMEOUT_COUNT);
+      }
+      PROXY_NET_LOG(DEBUG, "inactivity timeout state", K(&vc), K(vc.source_type_), K(now),
+                    "next_inactivity_timeout_at", hrtime_to_sec(vc.next_inactivity_timeout_at_),
+                    "inactivity_timeout_in", hrtime_to_sec(vc.inactivity_timeout_in_));
+      // look at it again next round in case the handler neither closes it
+      // nor sets a new timeout, close() takes it out of the wheel
+      nh.schedule_inactivity_check(vc, now);
+      vc.handle_event(EVENT_IMMEDIATE, e);
+    }
+  }
+}
+
+// Only needed while exiting gracefully or while some servers are detected
+// dead, all the other checks are driven by nh.inactivity_wheel_
+void ObInactivityCop::sweep_open_list(ObNetHandler &nh, const bool is_graceful_timeout, ObEvent *e)
+{
+  ObEThread *ethread = &self_ethread();
+
+  // Copy the list and use pop() to catch any closes caused by callbacks.
+  forl_LL(ObUnixNetVConnection, vc, nh.open_list_) {
+    if (vc->thread_ == ethread) {
+      nh.cop_list_.push(vc);
+    }
+  }
+
+  ObUnixNetVConnection *vc = NULL;
+  while (NULL != (vc = nh.cop_list_.pop())) {
+    if (is_graceful_timeout) {
+      nh.schedule_inactivity_check(*vc, 0);
+    } else if (ObUnixNetVConnection::VC_CONNECT == vc->source_type_) {
+      MUTEX_TRY_LOCK(lock, vc->mutex_, ethread);
+      if (!lock.is_locked()) {
+        NET_INCREMENT_DYN_STAT(INACTIVITY_COP_LOCK_ACQUIRE_FAILURE);
+      } else if (!vc->closed_) {
+        ObIpEndpoint ip(vc->get_remote_addr());
+        if (OB_HASH_EXIST == get_global_resource_pool_processor().ip_set_.exist_refactored(ip)) {
+          PROXY_NET_LOG(WARN, "detect server dead, close connection", K(ip));
+          vc->handle_event(EVENT_ERROR, e);
+        }
+      }
+    }
+  }
+}
+
+// the io buffer freelists are thread local and lock free, they are only
+// counted in place and folded into the stats here, once per second
+void ObInactivityCop::report_iobuffer_cache_stat()
+{
+  int64_t hit_count = 0;
+  int64_t miss_count = 0;
+  int64_t cached_bytes = 0;
+  ObThreadAllocator &allocator = get_thread_allocator();
+  get_thread_iobuffer_cache_stat(hit_count, miss_count, cached_bytes);
+  NET_SUM_DYN_STAT(NET_IOBUFFER_CACHE_HIT, hit_count - allocator.reported_iobuf_hit_count_);
+  NET_SUM_DYN_STAT(NET_IOBUFFER_CACHE_MISS, miss_count - allocator.reported_iobuf_miss_count_);
+  NET_SUM_DYN_STAT(NET_IOBUFFER_CACHED_BYTES, cached_bytes - allocator.reported_iobuf_cached_bytes_);
+  allocator.reported_iobuf_hit_count_ = hit_count;
+  allocator.reported_iobuf_miss_count_ = miss_count;
+  allocator.reported_iobuf_cached_bytes_ = cached_bytes;
+}
+
 int ObInactivityCop::keep_alive_lru(ObNetHandler &nh, const ObHRTime now, ObEvent *e)
 {
   int ret = OB_SUCCESS;
@@ -505,9 +573,75 @@ int ObInactivityCop::keep_alive_lru(ObNetHandler &nh, const ObHRTime now, ObEven
 ObNetHandler::ObNetHandler()
     : ObContinuation(NULL),
       trigger_event_(NULL),
-      keep_alive_lru_size_(0)
+      keep_alive_lru_size_(0),
+      accept_connections_count_(0),
+      busy_poll_hit_count_(0),
+      busy_poll_miss_count_(0),
+      poll_sleep_count_(0),
+      busy_poll_max_time_(0),
+      busy_poll_time_(0)
 {
   SET_HANDLER(reinterpret_cast<NetContHandler>(&ObNetHandler::start_net_event));
+  inactivity_wheel_.init(INACTIVITY_TICK_TIME, get_hrtime_internal());
+}
+
+void ObNetHandler::add_to_open_list(ObUnixNetVConnection &vc)
+{
+  open_list_.enqueue(&vc);
+  if (ObUnixNetVConnection::VC_ACCEPT == vc.source_type_) {
+    ++accept_connections_count_;
+  }
+#ifdef SO_BUSY_POLL
+  const ObHRTime busy_poll_max_time = get_busy_poll_max_time();
+  if (busy_poll_max_time > 0) {
+    // raising it above net.core.busy_read needs CAP_NET_ADMIN, best effort
+    const int busy_poll_us = static_cast<int>(hrtime_to_usec(busy_poll_max_time));
+    if (OB_UNLIKELY(0 != ::setsockopt(vc.con_.fd_, SOL_SOCKET, SO_BUSY_POLL,
+                                      &busy_poll_us, sizeof(busy_poll_us)))) {
+      PROXY_NET_LOG(DEBUG, "fail to set socket opt SO_BUSY_POLL", K(vc.con_.fd_), K(busy_poll_us), KERRMSGS);
+    }
+  }
+#endif
+  // without a timeout, the cop gives it the default one next round
+  schedule_inactivity_check(vc, vc.next_inactivity_timeout_at_ > 0 ? vc.next_inactivity_timeout_at_ : get_hrtime());
+}
+
+void ObNetHandler::remove_from_open_list(ObUnixNetVConnection &vc)
+{
+  if (open_list_.in(&vc)) {
+    open_list_.remove(&vc);
+    if (ObUnixNetVConnection::VC_ACCEPT == vc.source_type_) {
+      --accept_connections_count_;
+    }
+  }
+  if (vc.timeout_entry_.is_scheduled()) {
+    inactivity_wheel_.remove(&vc);
+  } else if (inactivity_expired_list_.in(&vc)) {
+    inactivity_expired_list_.remove(&vc);
+  }
+}
+
+void ObNetHandler::schedule_inactivity_check(ObUnixNetVConnection &vc, const ObHRTime at)
+{
+  const int64_t tick = (0 == at) ? inactivity_wheel_.get_cur_tick() : inactivity_wheel_.to_tick(at);
+  if (!vc.timeout_entry_.is_scheduled()) {
+    if (inactivity_expired_list_.in(&vc)) {
+      inactivity_expired_list_.remove(&vc);
+    }
+    inactivity_wheel_.schedule(&vc, tick);
+  } else if (tick < vc.timeout_entry_.expire_tick_) {
+    inactivity_wheel_.schedule(&vc, tick);
+  }
+}
+
+void ObNetHandler::free_zero_copy_orphans(const ObHRTime now)
+{
+  ObZeroCopySendRecord *record = NULL;
+  while (NULL != (record = zero_copy_orphan_list_.head_) && record->expire_time_ <= now) {
+    zero_copy_orphan_list_.dequeue();
+    record->reset();
+    op_reclaim_free(record);
+  }
 }
 
 // Initialization here
@@ -527,6 +661,54 @@ int ObNetHandler::start_net_event(int event, ObEvent *e)
   return (OB_SUCCESS == ret) ? EVENT_CONT : EVENT_ERROR;
 }
 
+// Spin on the poll descriptor and on what other threads hand over to this one,
+// for at most the current budget and never beyond the next timed event.
+// Returns true if something turned up, false if the caller must block.
+bool ObNetHandler::busy_poll(ObPollDescriptor &pd, ObProtectedQueue &external_queue,
+                             const ObHRTime max_time, const ObHRTime sleep_time)
+{
+  bool bret = false;
+  if (busy_poll_time_ > max_time) {
+    busy_poll_time_ = max_time;
+  }
+  if (busy_poll_time_ > 0) {
+    const ObHRTime end_time = get_hrtime_internal() + std::min(busy_poll_time_, sleep_time);
+    do {
+      if (!external_queue.atomic_list_.empty() || has_enabled_vc()) {
+        pd.result_ = 0;
+        bret = true;
+      } else if (OB_SUCCESS == pd.wait(0) && pd.result_ > 0) {
+        bret = true;
+      } else {
+        PAUSE();
+      }
+    } while (!bret && get_hrtime_internal() < end_time);
+
+    if (bret) {
+      ++busy_poll_hit_count_;
+    } else {
+      ++busy_poll_miss_count_;
+      adapt_busy_poll(max_time, false);
+    }
+  }
+  return bret;
+}
+
+// double the budget when a blocked poll was woken up within max_time,
+// halve it when a spin ran out, so that idle threads stop burning cpu
+void ObNetHandler::adapt_busy_poll(const ObHRTime max_time, const bool grow)
+{
+  const ObHRTime min_time = max_time / BUSY_POLL_MIN_FRACTION;
+  if (grow) {
+    busy_poll_time_ = std::min(max_time, std::max(min_time, busy_poll_time_ * 2));
+  } else {
+    busy_poll_time_ /= 2;
+    if (busy_poll_time_ < min_time) {
+      busy_poll_time_ = 0;
+    }
+  }
+}
+
 // Move VC's enabled on a different thread to the ready list
 inline void ObNetHandler::process_enabled_list()
 {
@@ -578,20 +760,48 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
       PROXY_NET_LOG(WARN, "fail to get trigger_event_'s ethread", K(trigger_event_), K(ret));
     } else {
       if (OB_LIKELY(!read_ready_list_.empty() || !write_ready_list_.empty()
-            || !read_enable_list_.empty() || !write_enable_list_.empty())) {
+            || !read_enable_list_.empty() || !write_enable_list_.empty()
+            || !write_coalesce_list_.empty())) {
         poll_timeout = 0; // poll immediately returns -- we have triggered stuff to process right now
       } else {
         poll_timeout = (int32_t)(hrtime_to_msec(ethread->sleep_time_));
       }
 
       ObPollDescriptor &pd = ethread->get_net_poll().get_poll_descriptor();
-      if (OB_FAIL(ObSocketManager::epoll_wait(pd.epoll_fd_,
-          pd.epoll_triggered_events_,
-          ObPollDescriptor::POLL_DESCRIPTOR_SIZE,
-          poll_timeout, pd.result_))) {
-      PROXY_NET_LOG(WARN, "fail to epoll_wait", K(pd.epoll_fd_),
-                    K(pd.epoll_triggered_events_),
-                    K(poll_timeout), K(ret));
+      // other threads only write our eventfd when we are parked in the poll,
+      // recheck what they may have handed over before we published it
+      ObProtectedQueue &external_queue = ethread->event_queue_external_;
+      const ObHRTime busy_poll_max_time = get_busy_poll_max_time();
+      int wait_ret = OB_SUCCESS;
+      if (poll_timeout > 0
+          && busy_poll(pd, external_queue, busy_poll_max_time, ethread->sleep_time_)) {
+        // found work while spinning, pd holds what the last poll got
+      } else {
+        bool is_parked = false;
+        if (poll_timeout > 0) {
+          if (!external_queue.park(ObProtectedQueue::PARK_STATE_POLL_WAIT)) {
+            poll_timeout = 0;
+          } else if (has_enabled_vc()) {
+            external_queue.unpark();
+            poll_timeout = 0;
+          } else {
+            is_parked = true;
+          }
+        }
+        const ObHRTime wait_start = (is_parked && busy_poll_max_time > 0) ? get_hrtime_internal() : 0;
+        wait_ret = pd.wait(poll_timeout);
+        if (is_parked) {
+          external_queue.unpark();
+          ++poll_sleep_count_;
+          if (busy_poll_max_time > 0) {
+            // woken up within the budget, spinning would have saved this sleep
+            adapt_busy_poll(busy_poll_max_time, OB_SUCCESS == wait_ret && pd.result_ > 0
+                            && get_hrtime_internal() - wait_start <= busy_poll_max_time);
+          }
+        }
+      }
+      if (OB_FAIL(wait_ret)) {
+        PROXY_NET_LOG(WARN, "fail to wait poll descriptor", K(poll_timeout), K(ret));
       } else {
         bool in_list = false;
         for (int64_t i = 0; (i < pd.result_) && OB_SUCC(ret); ++i) {
@@ -600,11 +810,19 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
           } else if (OB_FAIL(pd.get_ev_data(i, reinterpret_cast<void *&>(epd)))) {
             PROXY_NET_LOG(WARN, "fail to get_ev_data", K(pd.result_), K(i), K(ret));
           } else {
+            if (OB_UNLIKELY(pd.need_rearm(i)) && OB_UNLIKELY(OB_SUCCESS != epd->rearm())) {
+              PROXY_NET_LOG(WARN, "fail to rearm event io", K(epd->type_), K(epoll_events));
+            }
             if (EVENTIO_READWRITE_VC == epd->type_) {
               if (OB_ISNULL(vc = epd->data_.vc_)) {
                 ret = OB_ERR_UNEXPECTED;
                 PROXY_NET_LOG(WARN, "fail to get ObUnixNetVConnection from epd->data_", K(ret));
               } else {
+                if ((epoll_events & EVENTIO_ERROR) && vc->has_zero_copy_send_pending()) {
+                  // MSG_ZEROCOPY completions are queued on the socket error queue,
+                  // fetch them now, the connection may not write again for long
+                  vc->reap_zero_copy_send();
+                }
                 if (epoll_events & (EVENTIO_READ | EVENTIO_ERROR)) {
                   vc->read_.triggered_ = true;
                   if (!read_ready_list_.in(vc)) {
@@ -643,6 +861,11 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
 
     if (OB_SUCC(ret)) {
       int close_ret = OB_SUCCESS;
+      // writes deferred by the last loop go out after the read pass below,
+      // together with what it appends to their buffers
+      while (NULL != (vc = write_coalesce_list_.dequeue())) {
+        write_ready_list_.in_or_enqueue(vc);
+      }
 #if defined(USE_EDGE_TRIGGER)
       // ObUnixNetVConnection *
       while (NULL != (vc = read_ready_list_.dequeue())) {
@@ -32,6 +32,7 @@
 #ifndef OBPROXY_UNIX_NET_H
 #define OBPROXY_UNIX_NET_H
 
+#include <limits.h>
 #include "iocore/net/ob_poll_descriptor.h"
 #include "iocore/net/ob_unix_net_processor.h"
 #include "iocore/net/ob_unix_net_vconnection.h"
@@ -60,7 +61,6 @@ public:
   ~ObNetPoll();
   int init();
   ObPollDescriptor &get_poll_descriptor() { return *poll_descriptor_; }
-  int timerfd_settime();
   int get_timer_fd() { return timer_fd_; }
 
 public:
@@ -75,7 +75,8 @@ private:
 };
 
 // One Inactivity cop runs on each thread once every second and
-// loops through the list of NetVCs and calls the timeouts
+// calls the timeouts of the NetVCs whose inactivity check is due
+// in ObNetHandler::inactivity_wheel_
 class ObInactivityCop : public event::ObContinuation
 {
 public:
@@ -90,6 +91,10 @@ public:
 
 private:
   int keep_alive_lru(ObNetHandler &nh, ObHRTime now, event::ObEvent *e);
+  void check_vc_inactivity(ObNetHandler &nh, ObUnixNetVConnection &vc, const ObHRTime now,
+                           const bool is_graceful_timeout, event::ObEvent *e);
+  void sweep_open_list(ObNetHandler &nh, const bool is_graceful_timeout, event::ObEvent *e);
+  void report_iobuffer_cache_stat();
 
 private:
   int64_t default_inactivity_timeout_;  // only used when one is not set for some bad reason
@@ -105,14 +110,37 @@ private:
 class ObNetHandler : public event::ObContinuation
 {
 public:
+  typedef event::ObTimingWheel<ObUnixNetVConnection, ObUnixNetVConnection::Link_timeout_link_,
+                               &ObUnixNetVConnection::timeout_entry_> ObInactivityTimingWheel;
+  static const ObHRTime INACTIVITY_TICK_TIME = HRTIME_SECONDS(1);
+  static const int64_t MAX_WRITE_IOV = IOV_MAX;
+  // a busy poll budget shrunk below max / BUSY_POLL_MIN_FRACTION turns spinning off,
+  // and the first poll woken up in time turns it on again with that much
+  static const int64_t BUSY_POLL_MIN_FRACTION = 8;
+
   ObNetHandler();
   virtual ~ObNetHandler() {}
 
   int start_net_event(int event, event::ObEvent *data);
+  void free_zero_copy_orphans(const ObHRTime now);
+
+  void add_to_open_list(ObUnixNetVConnection &vc);
+  void remove_from_open_list(ObUnixNetVConnection &vc);
+  // check vc no later than at, 0 means in the next cop round, never delays
+  // an earlier check; only called by the thread of this handler
+  void schedule_inactivity_check(ObUnixNetVConnection &vc, const ObHRTime at);
+
+  // called by the config thread, 0 disables busy poll of this handler
+  void set_busy_poll_max_time(const ObHRTime max_time) { ATOMIC_STORE(&busy_poll_max_time_, max_time); }
+  ObHRTime get_busy_poll_max_time() const { return ATOMIC_LOAD(&busy_poll_max_time_); }
 
 private:
   int main_net_event(int event, event::ObEvent *data);
   void process_enabled_list();
+  bool has_enabled_vc() { return !read_enable_list_.empty() || !write_enable_list_.empty(); }
+  bool busy_poll(ObPollDescriptor &pd, event::ObProtectedQueue &external_queue,
+                 const ObHRTime max_time, const ObHRTime sleep_time);
+  void adapt_busy_poll(const ObHRTime max_time, const bool grow);
 
 public:
   event::ObEvent *trigger_event_;
@@ -123,14 +151,38 @@ public:
   ASLLM(ObUnixNetVConnection, ObNetState, read_, enable_link_) read_enable_list_;
   ASLLM(ObUnixNetVConnection, ObNetState, write_, enable_link_) write_enable_list_;
   Que(ObUnixNetVConnection, keep_alive_link_) keep_alive_list_;
+  // small writes deferred by this loop, written after the next poll
+  Que(ObUnixNetVConnection, write_coalesce_link_) write_coalesce_list_;
+  // MSG_ZEROCOPY buffers of closed connections, in order of expire time
+  Que(ObZeroCopySendRecord, link_) zero_copy_orphan_list_;
+  // each open vc is scheduled at the time it may become inactive, moving
+  // its timeout later costs nothing until the check comes due
+  ObInactivityTimingWheel inactivity_wheel_;
+  Que(ObUnixNetVConnection, timeout_link_) inactivity_expired_list_;
+  ASLL(ObUnixNetVConnection, timeout_enable_link_) inactivity_enable_list_;
 
   int64_t keep_alive_lru_size_;
+  int64_t accept_connections_count_;
+
+  // scratch space of write_to_net(), one writev takes as many blocks as the kernel allows
+  struct iovec write_iov_[MAX_WRITE_IOV];
+  event::ObIOBufferData *write_iov_data_[MAX_WRITE_IOV];
+
+  // polls which found work while spinning, spins which ran out of budget,
+  // and polls which blocked; read by the thread prometheus of this thread
+  int64_t busy_poll_hit_count_;
+  int64_t busy_poll_miss_count_;
+  int64_t poll_sleep_count_;
 
 private:
+  ObHRTime busy_poll_max_time_;
+  ObHRTime busy_poll_time_;   // current budget, in [0, busy_poll_max_time_]
+
   DISALLOW_COPY_AND_ASSIGN(ObNetHandler);
 };
 
 int update_cop_config(const int64_t default_inactivity_timeout, const int64_t max_client_connections);
+int update_busy_poll_config(const ObHRTime busy_poll_time, const int64_t busy_poll_thread_num);
 
 // 1  - transient
 // 0  - report as warning
@@ -74,6 +74,8 @@ void ObNetProcessor::ObAcceptOptions::reset()
   localhost_only_ = false;
   frequent_accept_ = true;
   backdoor_ = false;
+  reuseport_ = false;
+  reuseport_cpu_steering_ = false;
   defer_accept_timeout_ = 0;
   recv_bufsize_ = 0;
   send_bufsize_ = 0;
@@ -152,14 +154,19 @@ inline ObAction *ObUnixNetProcessor::accept_internal(ObContinuation &cont, int f
     na->packet_tos_ = opt.packet_tos_;
     na->etype_ = upgraded_etype;
     na->backdoor_ = opt.backdoor_;
+    // inherited SO_REUSEPORT listen sockets must keep being accepted, or the
+    // connections the kernel hashes to them would never be served
+    na->server_.reuseport_ = (RUN_MODE_PROXY == g_run_mode)
+        && (opt.reuseport_ || get_global_hot_upgrade_info().get_reuseport_fd_count(AF_INET6 == opt.ip_family_) > 0);
+    na->reuseport_cpu_steering_ = opt.reuseport_cpu_steering_;
     if (na->callback_on_open_) {
       na->mutex_ = cont.mutex_;
     }
 
     ObNetAccept *net_accept = NULL;
     int64_t ret_len = 0;
-    if (opt.frequent_accept_) {
-      if (accept_threads_ > 0) {
+    if (opt.frequent_accept_ || na->server_.reuseport_) {
+      if (accept_threads_ > 0 && !na->server_.reuseport_) {
         if (OB_FAIL(na->do_listen(BLOCKING))) {
           PROXY_NET_LOG(ERROR, "fail to do_listen BLOCKING", K(ret));
         } else {
@@ -209,7 +216,7 @@ inline ObAction *ObUnixNetProcessor::accept_internal(ObContinuation &cont, int f
             }
           }
         } // end na->do_listen(BLOCKING)
-      } else { // true == opt.frequent_accept_ && 0 == accept_threads_
+      } else { // 0 == accept_threads_ or reuseport
         if(OB_FAIL(na->init_accept_per_thread())) {
           PROXY_NET_LOG(ERROR, "fail to init_accept_per_thread", K(ret));
         }
@@ -29,6 +29,8 @@
  *
  */
 
+#include <time.h>
+#include <linux/errqueue.h>
 #include "lib/profile/ob_trace_id.h"
 #include "iocore/net/ob_net.h"
 #include "iocore/net/ob_event_io.h"
@@ -50,6 +52,27 @@ namespace net
 
 static const int64_t NET_MAX_IOV = 16;
 
+// MSG_ZEROCOPY appeared in linux 4.14, older glibc headers lack these
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+// bytes a connection may have in flight by MSG_ZEROCOPY, beyond it we copy as usual
+static const int64_t ZERO_COPY_MAX_PENDING_BYTES = 4 * 1024 * 1024;
+// the kernel can no longer report completions once the fd is closed,
+// so the buffers of a closed connection are held for this long instead
+static const ObHRTime ZERO_COPY_ORPHAN_HOLD_TIME = HRTIME_SECONDS(10);
+static const int64_t ZERO_COPY_CONTROL_BUF_SIZE = 128;
+
 static inline ObNetState &get_net_state_by_vio(ObVIO &vio)
 {
   return *(reinterpret_cast<ObNetState *>(
@@ -57,6 +80,18 @@ static inline ObNetState &get_net_state_by_vio(ObVIO &vio)
     - reinterpret_cast<int64_t>(&(reinterpret_cast<ObNetState *>(0)->vio_))));
 }
 
+void ObZeroCopySendRecord::reset()
+{
+  for (int64_t i = 0; i < data_count_; ++i) {
+    data_[i].release();
+  }
+  seq_ = 0;
+  bytes_ = 0;
+  data_count_ = 0;
+  is_done_ = false;
+  expire_time_ = 0;
+}
+
 // Disable a ObUnixNetVConnection
 inline void ObUnixNetVConnection::read_disable()
 {
@@ -79,6 +114,9 @@ inline void ObUnixNetVConnection::write_disable()
   }
   write_.enabled_ = false;
   nh_->write_ready_list_.remove(this);
+  if (nh_->write_coalesce_list_.in(this)) {
+    nh_->write_coalesce_list_.remove(this);
+  }
   get_event_io().modify(-EVENTIO_WRITE);
 }
 
@@ -207,7 +245,11 @@ inline int ObUnixNetVConnection::write_signal_error(const int lerrno)
 inline void ObUnixNetVConnection::net_activity()
 {
   if (inactivity_timeout_in_ > 0) {
+    const bool need_check = (0 == next_inactivity_timeout_at_);
     next_inactivity_timeout_at_ = get_hrtime() + inactivity_timeout_in_;
+    if (need_check) {
+      update_inactivity_check(next_inactivity_timeout_at_);
+    }
   } else {
     next_inactivity_timeout_at_ = 0;
   }
@@ -468,6 +510,8 @@ inline int ObUnixNetVConnection::close()
     PROXY_NET_LOG(WARN, "fail to stop event io", "vc: ", this, K(ret));
   }
 
+  release_zero_copy_send();
+
   if (OB_FAIL(con_.close())) {
     PROXY_NET_LOG(WARN, "fail to close connection", "vc: ", this, K(ret));
   }
@@ -484,10 +528,15 @@ inline int ObUnixNetVConnection::close()
   }
 
   active_timeout_in_ = 0;
-  nh_->open_list_.remove(this);
+  nh_->remove_from_open_list(*this);
   nh_->cop_list_.remove(this);
   nh_->read_ready_list_.remove(this);
   nh_->write_ready_list_.remove(this);
+  if (nh_->write_coalesce_list_.in(this)) {
+    nh_->write_coalesce_list_.remove(this);
+  }
+  write_coalesce_size_ = 0;
+  write_coalesced_ = false;
 
   if (read_.in_enabled_list_) {
     nh_->read_enable_list_.remove(this);
@@ -499,6 +548,11 @@ inline int ObUnixNetVConnection::close()
     write_.in_enabled_list_ = false;
   }
 
+  if (in_timeout_enable_list_) {
+    nh_->inactivity_enable_list_.remove(this);
+    in_timeout_enable_list_ = false;
+  }
+
   remove_from_keep_alive_lru();
 
   free();
@@ -652,6 +706,140 @@ inline void ObUnixNetVConnection::read_from_net(ObEThread &thread)
   }
 }
 
+bool ObUnixNetVConnection::need_zero_copy_send(const int64_t towrite) const
+{
+  return zero_copy_send_min_size_ > 0 && towrite >= zero_copy_send_min_size_
+         && zero_copy_pending_bytes_ < ZERO_COPY_MAX_PENDING_BYTES;
+}
+
+inline int ObUnixNetVConnection::zero_copy_send(const struct iovec *iov, ObIOBufferData **data,
+                                                 const int32_t niov, int64_t &count)
+{
+  int ret = OB_SUCCESS;
+  ObZeroCopySendRecord *record = NULL;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = const_cast<struct iovec *>(iov);
+  msg.msg_iovlen = niov;
+
+  if (OB_UNLIKELY(niov <= 0) || OB_UNLIKELY(niov > ObZeroCopySendRecord::MAX_DATA_COUNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    PROXY_NET_LOG(WARN, "invalid argument", K(niov), K(ret));
+  } else if (OB_ISNULL(record = op_reclaim_alloc(ObZeroCopySendRecord))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PROXY_NET_LOG(WARN, "fail to alloc zero copy send record", K(ret));
+  } else if (OB_FAIL(ObSocketManager::sendmsg(con_.fd_, &msg, MSG_ZEROCOPY, count)) || count <= 0) {
+    // nothing is queued, the kernel does not consume a notification id either
+    op_reclaim_free(record);
+    record = NULL;
+  } else {
+    record->seq_ = zero_copy_next_seq_++;
+    record->bytes_ = count;
+    for (int32_t i = 0; i < niov; ++i) {
+      record->data_[i] = data[i];
+    }
+    record->data_count_ = niov;
+    zero_copy_pending_list_.enqueue(record);
+    zero_copy_pending_bytes_ += count;
+    NET_INCREMENT_DYN_STAT(NET_ZERO_COPY_SEND_CALLS);
+    NET_SUM_DYN_STAT(NET_ZERO_COPY_SEND_BYTES, count);
+  }
+
+  // out of optmem for the notifications, just copy this time
+  if (OB_SYS_ENOBUFS == ret || OB_ALLOCATE_MEMORY_FAILED == ret) {
+    ret = ObSocketManager::writev(con_.fd_, iov, niov, count);
+  }
+  return ret;
+}
+
+void ObUnixNetVConnection::complete_zero_copy_send(const uint32_t lo, const uint32_t hi,
+                                                    const bool is_copied)
+{
+  for (ObZeroCopySendRecord *record = zero_copy_pending_list_.head_; NULL != record;
+       record = record->link_.next_) {
+    if (is_zero_copy_send_done(record->seq_, lo, hi)) {
+      record->is_done_ = true;
+    }
+  }
+  if (is_copied) {
+    // the device can not send from user pages (e.g. loopback),
+    // the kernel copied anyway and we only paid for the notification
+    NET_INCREMENT_DYN_STAT(NET_ZERO_COPY_SEND_COPIED);
+    zero_copy_send_min_size_ = 0;
+    zero_copy_unavailable_ = true;
+  }
+}
+
+// completions may come out of order, the buffers are released in send order
+void ObUnixNetVConnection::free_done_zero_copy_send()
+{
+  ObZeroCopySendRecord *record = NULL;
+  while (NULL != (record = zero_copy_pending_list_.head_) && record->is_done_) {
+    zero_copy_pending_list_.dequeue();
+    zero_copy_pending_bytes_ -= record->bytes_;
+    record->reset();
+    op_reclaim_free(record);
+  }
+}
+
+// Fetch the completion notifications from the socket error queue and
+// release the buffers of the finished sends.
+void ObUnixNetVConnection::reap_zero_copy_send()
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  char control[ZERO_COPY_CONTROL_BUF_SIZE];
+  struct msghdr msg;
+  struct cmsghdr *cm = NULL;
+  struct sock_extended_err *serr = NULL;
+
+  while (OB_SUCC(ret) && !zero_copy_pending_list_.empty()) {
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (OB_FAIL(ObSocketManager::recvmsg(con_.fd_, &msg, MSG_ERRQUEUE, count))) {
+      if (OB_UNLIKELY(OB_SYS_EAGAIN != ret)) {
+        PROXY_NET_LOG(WARN, "fail to recv zero copy notification", K(con_.fd_), K(ret));
+      }
+    } else {
+      for (cm = CMSG_FIRSTHDR(&msg); NULL != cm; cm = CMSG_NXTHDR(&msg, cm)) {
+        if ((SOL_IP == cm->cmsg_level && IP_RECVERR == cm->cmsg_type)
+            || (SOL_IPV6 == cm->cmsg_level && IPV6_RECVERR == cm->cmsg_type)) {
+          serr = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cm));
+          if (SO_EE_ORIGIN_ZEROCOPY == serr->ee_origin && 0 == serr->ee_errno) {
+            // [ee_info, ee_data] is the range of completed sends
+            complete_zero_copy_send(serr->ee_info, serr->ee_data,
+                                    0 != (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED));
+          }
+        }
+      }
+    }
+  }
+
+  free_done_zero_copy_send();
+}
+
+inline void ObUnixNetVConnection::release_zero_copy_send()
+{
+  ObZeroCopySendRecord *record = NULL;
+  if (!zero_copy_pending_list_.empty()) {
+    reap_zero_copy_send();
+    if (!zero_copy_pending_list_.empty()) {
+      const ObHRTime expire_time = get_hrtime() + ZERO_COPY_ORPHAN_HOLD_TIME;
+      for (record = zero_copy_pending_list_.head_; NULL != record; record = record->link_.next_) {
+        record->expire_time_ = expire_time;
+      }
+      nh_->zero_copy_orphan_list_.append(zero_copy_pending_list_);
+      zero_copy_pending_list_.reset();
+    }
+  }
+  zero_copy_pending_bytes_ = 0;
+  zero_copy_send_min_size_ = 0;
+  zero_copy_sockopt_set_ = false;
+  zero_copy_unavailable_ = false;
+  zero_copy_next_seq_ = 0;
+}
+
 inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
                        const int64_t towrite, int64_t &total_write, int &tmp_code)
 {
@@ -660,7 +848,11 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
   int64_t count = 0;
   int64_t wattempted = 0;
   int32_t niov = 0;
-  struct iovec tiovec[NET_MAX_IOV];
+  struct iovec *tiovec = nh_->write_iov_;
+  ObIOBufferData **tdata = nh_->write_iov_data_;
+  // a MSG_ZEROCOPY record holds a limited number of blocks
+  const int64_t max_iov = zero_copy_send_min_size_ > 0
+                          ? ObZeroCopySendRecord::MAX_DATA_COUNT : ObNetHandler::MAX_WRITE_IOV;
 
   int64_t len = -1;
   int64_t remain = 0;
@@ -699,6 +891,7 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
           tiovec[niov].iov_base = block->start() + offset;
           offset = 0;
           tiovec[niov].iov_len = len;
+          tdata[niov] = block->data_.ptr_;
           wattempted += len;
           ++niov;
 
@@ -711,7 +904,7 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
             }
             break;
           }
-        } while (NULL != block && (0 < (len = block->read_avail())) && niov < NET_MAX_IOV);
+        } while (NULL != block && (0 < (len = block->read_avail())) && niov < max_iov);
 
         if (using_ssl_) {
           if (OB_FAIL(ObSocketManager::ssl_write(ssl_, tiovec[0].iov_base, tiovec[0].iov_len, count, tmp_code))) {
@@ -721,6 +914,10 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
           } else {
             break;
           }
+        } else if (need_zero_copy_send(wattempted)) {
+          if (OB_SUCC(zero_copy_send(tiovec, tdata, niov, count))) {
+            total_write += count;
+          }
         } else if (1 == niov) {
           if (OB_SUCC(ObSocketManager::write(con_.fd_, tiovec[0].iov_base, tiovec[0].iov_len, count))) {
             total_write += count;
@@ -743,6 +940,31 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
   return ret;
 }
 
+// A small write of a response still on its way waits for one net loop,
+// at most once in a row, the next poll does not block while anyone waits.
+// The read pass of that loop appends what the servers have sent meanwhile,
+// and it all goes out with one writev. A full buffer can take nothing more,
+// so it is flushed at once.
+bool ObUnixNetVConnection::need_coalesce_write(ObEThread &thread, ObIOBufferReader &reader,
+                                               const int64_t towrite)
+{
+  bool bret = false;
+  ObProxyMutex *mutex_ = thread.mutex_;
+  if (write_coalesced_) {
+    write_coalesced_ = false;
+    if (towrite > write_coalesce_bytes_) {
+      NET_INCREMENT_DYN_STAT(NET_WRITE_COALESCE_SAVED_CALLS);
+    }
+  } else if (towrite > 0 && towrite < write_coalesce_size_ && !using_ssl_
+             && write_.vio_.ntodo() > towrite && reader.mbuf_->current_write_avail() > 0) {
+    NET_INCREMENT_DYN_STAT(NET_WRITE_COALESCE_DEFERRED);
+    write_coalesced_ = true;
+    write_coalesce_bytes_ = towrite;
+    bret = true;
+  }
+  return bret;
+}
+
 // Write the data for a ObUnixNetVConnection.
 // Rescheduling the ObUnixNetVConnection when necessary.
 inline void ObUnixNetVConnection::write_to_net(ObEThread &thread)
@@ -763,10 +985,17 @@ inline void ObUnixNetVConnection::write_to_net(ObEThread &thread)
   } else {
     ObIOBufferReader &reader = *(write_.vio_.buffer_.reader());
     ObIOBufferReader *old_reader = write_.vio_.buffer_.reader();
+    if (!zero_copy_pending_list_.empty()) {
+      reap_zero_copy_send();
+    }
     is_done = calculate_towrite_size(towrite, signalled);
 
     if (OB_LIKELY(!is_done)) {
-      if (OB_LIKELY(towrite > 0)) {
+      if (need_coalesce_write(thread, reader, towrite)) {
+        // wait for the next loop, still enabled and triggered
+        nh_->write_coalesce_list_.enqueue(this);
+        is_done = true;
+      } else if (OB_LIKELY(towrite > 0)) {
         int tmp_code = 0;
         if (OB_FAIL(write_to_net_internal(reader, towrite, total_write, tmp_code)) || OB_UNLIKELY((0 == total_write))) {
           is_done = handle_write_to_net_error(thread, total_write, ret, tmp_code);
@@ -823,6 +1052,16 @@ ObUnixNetVConnection::ObUnixNetVConnection()
       ssl_(NULL),
       can_shutdown_ssl_(true),
       io_type_(IO_NONE),
+      zero_copy_send_min_size_(0),
+      zero_copy_sockopt_set_(false),
+      zero_copy_unavailable_(false),
+      zero_copy_next_seq_(0),
+      zero_copy_pending_bytes_(0),
+      zero_copy_pending_list_(),
+      write_coalesce_size_(0),
+      write_coalesce_bytes_(0),
+      write_coalesced_(false),
+      in_timeout_enable_list_(false),
       is_inited_(false)
 {
   memset(&server_addr_, 0, sizeof(server_addr_));
@@ -847,6 +1086,7 @@ inline void ObUnixNetVConnection::reenable(ObVIO *vio)
         ns.enabled_ = true;
         if (0 == next_inactivity_timeout_at_ && inactivity_timeout_in_ > 0) {
           next_inactivity_timeout_at_ = get_hrtime() + inactivity_timeout_in_;
+          update_inactivity_check(next_inactivity_timeout_at_);
         }
 
         if (nh_->mutex_->thread_holding_ == &ethread) {
@@ -886,8 +1126,9 @@ inline void ObUnixNetVConnection::reenable(ObVIO *vio)
               }
             }
 
-            if (NULL != nh_->trigger_event_ && NULL != nh_->trigger_event_->get_ethread().signal_hook_) {
-              nh_->trigger_event_->get_ethread().signal_hook_(nh_->trigger_event_->get_ethread());
+            if (NULL != nh_->trigger_event_) {
+              ObEThread &nh_ethread = nh_->trigger_event_->get_ethread();
+              nh_ethread.event_queue_external_.wakeup(nh_ethread);
             }
           /*
           } else {
@@ -929,6 +1170,7 @@ void ObUnixNetVConnection::reenable_re(ObVIO *vio)
         get_net_state_by_vio(*vio).enabled_ = true;
         if (0 == next_inactivity_timeout_at_ && inactivity_timeout_in_ > 0) {
           next_inactivity_timeout_at_ = get_hrtime() + inactivity_timeout_in_;
+          update_inactivity_check(next_inactivity_timeout_at_);
         }
 
         if (using_ssl_) {
@@ -1175,6 +1417,41 @@ inline int ObUnixNetVConnection::set_active_timeout(const ObHRTime timeout)
   return ret;
 }
 
+void ObUnixNetVConnection::set_inactivity_timeout(const ObHRTime timeout)
+{
+  PROXY_NET_LOG(DEBUG, "set inactive timeout", K(timeout), K(this));
+  inactivity_timeout_in_ = timeout;
+  next_inactivity_timeout_at_ = get_hrtime() + timeout;
+  update_inactivity_check(next_inactivity_timeout_at_);
+}
+
+// the cop finds out at the scheduled check, and gives it the default timeout
+void ObUnixNetVConnection::cancel_inactivity_timeout()
+{
+  PROXY_NET_LOG(DEBUG, "cancel inactive timeout", K(this));
+  inactivity_timeout_in_ = 0;
+  next_inactivity_timeout_at_ = 0;
+}
+
+void ObUnixNetVConnection::set_is_force_timeout(const bool force_timeout)
+{
+  is_force_timeout_ = force_timeout;
+  if (force_timeout) {
+    update_inactivity_check(0);
+  }
+}
+
+void ObUnixNetVConnection::update_inactivity_check(const ObHRTime at)
+{
+  if (NULL != nh_ && NULL != thread_) {
+    if (this_ethread() == thread_) {
+      nh_->schedule_inactivity_check(*this, at);
+    } else if (ATOMIC_BCAS(&in_timeout_enable_list_, false, true)) {
+      nh_->inactivity_enable_list_.push(this);
+    }
+  }
+}
+
 void ObUnixNetVConnection::add_to_keep_alive_lru()
 {
   if (nh_->keep_alive_list_.in(this)) {
@@ -1291,6 +1568,32 @@ int ObUnixNetVConnection::set_tcp_init_cwnd(const int32_t init_cwnd)
   return ret;
 }
 
+int ObUnixNetVConnection::set_zero_copy_send(const int64_t min_size)
+{
+  int ret = OB_SUCCESS;
+  int val = 1;
+  if (OB_UNLIKELY(min_size < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    PROXY_NET_LOG(WARN, "invalid argument", K(min_size), K(ret));
+  } else if (0 == min_size) {
+    zero_copy_send_min_size_ = 0;
+    if (!zero_copy_pending_list_.empty()) {
+      reap_zero_copy_send();
+    }
+  } else if (using_ssl_ || zero_copy_unavailable_) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (!zero_copy_sockopt_set_
+             && OB_FAIL(ObSocketManager::setsockopt(con_.fd_, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val)))) {
+    // kernel older than 4.14 or not a tcp socket, do not try again on this connection
+    zero_copy_unavailable_ = true;
+    PROXY_NET_LOG(DEBUG, "fail to set SO_ZEROCOPY", K(con_.fd_), K(ret));
+  } else {
+    zero_copy_sockopt_set_ = true;
+    zero_copy_send_min_size_ = min_size;
+  }
+  return ret;
+}
+
 int ObUnixNetVConnection::init()
 {
   int ret = OB_SUCCESS;
@@ -1323,6 +1626,10 @@ inline void ObUnixNetVConnection::free()
   }
 
   if (NO_FD != con_.fd_) {
+    // the kernel may still read the pinned buffers after the fd is closed
+    if (!zero_copy_pending_list_.empty() && NULL != nh_) {
+      release_zero_copy_send();
+    }
     if (OB_FAIL(con_.close())) {
       PROXY_NET_LOG(WARN, "fail to close fd", K(con_.fd_), K(this), K(ret));
     }
@@ -1434,7 +1741,7 @@ int ObUnixNetVConnection::accept_event(int event, ObEvent *e)
       }
 
       if (EVENT_DONE != event_ret) {
-        nh_->open_list_.enqueue(this);
+        nh_->add_to_open_list(*this);
 
         if (inactivity_timeout_in_ > 0) {
           set_inactivity_timeout(inactivity_timeout_in_);
@@ -1582,7 +1889,7 @@ int ObUnixNetVConnection::connect_up(ObEThread &ethread, int fd)
     } else {
       SET_HANDLER(&ObUnixNetVConnection::main_event);
       nh_ = &(thread_->get_net_handler());
-      nh_->open_list_.enqueue(this);
+      nh_->add_to_open_list(*this);
       action_.continuation_->handle_event(NET_EVENT_OPEN, this);
     }
   }
@@ -48,6 +48,26 @@ namespace net
 class ObNetHandler;
 struct ObEventIO;
 
+// Buffers handed to the kernel by one MSG_ZEROCOPY send. The kernel reads
+// them while transmitting, so they are referenced here until the send is
+// reported complete on the socket error queue.
+struct ObZeroCopySendRecord
+{
+  static const int64_t MAX_DATA_COUNT = 16;
+
+  ObZeroCopySendRecord() : seq_(0), bytes_(0), data_count_(0), is_done_(false), expire_time_(0) { }
+  ~ObZeroCopySendRecord() { reset(); }
+  void reset();
+
+  uint32_t seq_;
+  int64_t bytes_;
+  int64_t data_count_;
+  bool is_done_;
+  ObHRTime expire_time_; // only used after the connection is closed
+  common::ObPtr<event::ObIOBufferData> data_[MAX_DATA_COUNT];
+  LINK(ObZeroCopySendRecord, link_);
+};
+
 class ObUnixNetVConnection : public ObNetVConnection
 {
 public:
@@ -105,6 +125,25 @@ public:
 
   virtual int get_conn_fd() { return con_.fd_; }
 
+  // writes no less than min_size are sent with MSG_ZEROCOPY, 0 disables it
+  virtual int set_zero_copy_send(const int64_t min_size);
+  bool has_zero_copy_send_pending() const { return !zero_copy_pending_list_.empty(); }
+  // the net handler calls it on EPOLLERR, so completions are fetched while idle too
+  void reap_zero_copy_send();
+  // true if seq is in the completed range [lo, hi], which may wrap around
+  static bool is_zero_copy_send_done(const uint32_t seq, const uint32_t lo, const uint32_t hi)
+  {
+    return static_cast<uint32_t>(seq - lo) <= static_cast<uint32_t>(hi - lo);
+  }
+
+  // writes smaller than max_size may wait one net loop for more data, 0 disables it
+  virtual void set_write_coalesce_size(const int64_t max_size) { write_coalesce_size_ = max_size; }
+
+  virtual void set_is_force_timeout(const bool force_timeout);
+
+  // Make the inactivity cop look at this vc no later than at, 0 means as
+  // soon as possible. Can be called from any thread.
+  void update_inactivity_check(const ObHRTime at);
 
 private:
   virtual bool get_data(const int32_t id, void *data); // unused !!!
@@ -161,6 +200,14 @@ private:
   int read_from_net_internal(event::ObMIOBuffer &iobuf, const int64_t toread, int64_t &total_read, int &tmp_code);
   int write_to_net_internal(event::ObIOBufferReader &reader, const int64_t towrite, int64_t &total_write, int &tmp_code);
 
+  bool need_coalesce_write(event::ObEThread &thread, event::ObIOBufferReader &reader, const int64_t towrite);
+
+  bool need_zero_copy_send(const int64_t towrite) const;
+  int zero_copy_send(const struct iovec *iov, event::ObIOBufferData **data, const int32_t niov, int64_t &count);
+  void complete_zero_copy_send(const uint32_t lo, const uint32_t hi, const bool is_copied);
+  void free_done_zero_copy_send();
+  void release_zero_copy_send();
+
 public:
   enum ObVCSourceType {
     VC_ACCEPT = 0,
@@ -186,6 +233,14 @@ public:
 
   LINK(ObUnixNetVConnection, cop_link_);
   LINK(ObUnixNetVConnection, keep_alive_link_);
+  // inactivity timing wheel of nh_, only touched by thread_
+  LINK(ObUnixNetVConnection, timeout_link_);
+  event::ObTimingWheelEntry timeout_entry_;
+  // inactivity checks requested by other threads
+  SLINK(ObUnixNetVConnection, timeout_enable_link_);
+  volatile bool in_timeout_enable_list_;
+  // small writes waiting for the next net loop, see need_coalesce_write()
+  LINK(ObUnixNetVConnection, write_coalesce_link_);
 
   ObHRTime active_timeout_in_;
   event::ObEvent *active_timeout_action_;
@@ -256,6 +311,18 @@ private:
   bool can_shutdown_ssl_;
   IOType io_type_;
 
+private:
+  int64_t zero_copy_send_min_size_;
+  bool zero_copy_sockopt_set_;
+  bool zero_copy_unavailable_;
+  uint32_t zero_copy_next_seq_;
+  int64_t zero_copy_pending_bytes_;
+  Que(ObZeroCopySendRecord, link_) zero_copy_pending_list_;
+
+  int64_t write_coalesce_size_;
+  int64_t write_coalesce_bytes_; // bytes pending when the write was deferred
+  bool write_coalesced_;
+
 private:
   bool is_inited_;
   DISALLOW_COPY_AND_ASSIGN(ObUnixNetVConnection);
@@ -285,20 +352,6 @@ inline ObHRTime ObUnixNetVConnection::get_inactivity_timeout() const
   return inactivity_timeout_in_;
 }
 
-inline void ObUnixNetVConnection::set_inactivity_timeout(const ObHRTime timeout)
-{
-  PROXY_NET_LOG(DEBUG, "set inactive timeout", K(timeout), K(this));
-  inactivity_timeout_in_ = timeout;
-  next_inactivity_timeout_at_ = event::get_hrtime() + timeout;
-}
-
-inline void ObUnixNetVConnection::cancel_inactivity_timeout()
-{
-  PROXY_NET_LOG(DEBUG, "cancel inactive timeout", K(this));
-  inactivity_timeout_in_ = 0;
-  next_inactivity_timeout_at_ = 0;
-}
-
 inline int ObUnixNetVConnection::set_local_addr()
 {
   int ret = common::OB_SUCCESS;
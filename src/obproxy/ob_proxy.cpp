@@ -48,6 +48,7 @@
 #include "proxy/route/ob_sql_table_cache.h"
 #include "proxy/route/ob_cache_cleaner.h"
 #include "proxy/route/ob_route_utils.h"
+#include "proxy/route/ob_route_snapshot.h"
 #include "proxy/mysqllib/ob_proxy_auth_parser.h"
 
 #include "cmd/ob_show_net_handler.h"
@@ -176,6 +177,8 @@ int ObProxy::init(ObProxyOptions &opts, ObAppVersionInfo &proxy_version)
       LOG_ERROR("fail to init config", K(ret));
     } else if (OB_FAIL(get_global_config_processor().init())) {
       LOG_ERROR("fail to init config processor", K(ret));
+    } else if (OB_FAIL(init_route_snapshot())) {
+      LOG_ERROR("fail to init route snapshot", K(ret));
     } else if (OB_FAIL(config_->enable_sharding
                        && dbconfig_processor.init(config_->grpc_client_num, ObProxyMain::get_instance()->get_startup_time()))) {
       LOG_ERROR("fail to init dbconfig processor", K(ret));
@@ -208,6 +211,9 @@ int ObProxy::init(ObProxyOptions &opts, ObAppVersionInfo &proxy_version)
         ObNetOptions net_options;
         net_options.default_inactivity_timeout_ = usec_to_sec(config_->default_inactivity_timeout);
         net_options.max_client_connections_ = config_->client_max_connections;
+        net_options.busy_poll_time_ = config_->net_busy_poll_time;
+        net_options.busy_poll_thread_num_ = config_->net_busy_poll_thread_num;
+        net_options.iobuffer_thread_cache_size_ = config_->iobuffer_thread_cache_size;
 
         if (OB_FAIL(init_net(NET_SYSTEM_MODULE_VERSION, net_options))) {
           LOG_WARN("fail to init net", K(NET_SYSTEM_MODULE_VERSION), K(ret));
@@ -362,6 +368,8 @@ int ObProxy::start()
       LOG_WARN("fail to start refresh config server task", K(ret));
     } else if (config_->is_metadb_used() && OB_FAIL(g_stat_processor.start_stat_task())) {
       LOG_ERROR("fail to start stat task", K(ret));
+    } else if (OB_FAIL(get_global_route_snapshot().start_dump_task())) {
+      LOG_ERROR("fail to start route snapshot dump task", K(ret));
     } else if (OB_FAIL(tenant_stat_mgr_->start_tenant_stat_dump_task())) {
       LOG_ERROR("fail to start_tenant_stat_dump_task", K(ret));
     } else if (OB_FAIL(g_ob_qos_stat_processor.start_qos_stat_clean_task())) {
@@ -772,6 +780,20 @@ int ObProxy::init_resource_pool()
   return ret;
 }
 
+int ObProxy::init_route_snapshot()
+{
+  int ret = OB_SUCCESS;
+  if (config_->enable_route_snapshot) {
+    // a missing or broken snapshot only means a cold start, do not stop the startup of obproxy
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = get_global_route_snapshot().load())
+        && OB_ENTRY_NOT_EXIST != tmp_ret) {
+      LOG_WARN("fail to load route snapshot, start with empty route cache", K(tmp_ret));
+    }
+  }
+  return ret;
+}
+
 int ObProxy::init_inner_request_env()
 {
   int ret = OB_SUCCESS;
@@ -942,6 +964,9 @@ int ObProxy::do_reload_config(obutils::ObProxyConfig &config)
     ObNetOptions net_options;
     net_options.default_inactivity_timeout_ = usec_to_sec(config.default_inactivity_timeout);
     net_options.max_client_connections_ = config.client_max_connections;
+    net_options.busy_poll_time_ = config.net_busy_poll_time;
+    net_options.busy_poll_thread_num_ = config.net_busy_poll_thread_num;
+    net_options.iobuffer_thread_cache_size_ = config.iobuffer_thread_cache_size;
     update_net_options(net_options);
     ObMysqlConfigProcessor &mysql_config_processor = get_global_mysql_config_processor();
     if (OB_FAIL(mysql_config_processor.reconfigure(*config_))) {
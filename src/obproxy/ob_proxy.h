@@ -103,6 +103,7 @@ private:
   int dump_config();
   int init_config();
   int init_resource_pool();
+  int init_route_snapshot();
   int init_inner_request_env();
   int get_meta_table_server(common::ObIArray<proxy::ObProxyReplicaLocation> &replicas,
                             obutils::ObProxyConfigString &username);
@@ -534,12 +534,26 @@ int ObProxyMain::handle_inherited_sockets(const int argc, char *const argv[])
         info.ipv6_fd_ = atoi(inherited_ipv6);
       }
 
+      // the SO_REUSEPORT listen sockets of the per net thread acceptors
+      char *inherited_reuseport_ipv4 = getenv(OBPROXY_INHERITED_REUSEPORT_IPV4_FDS);
+      char *inherited_reuseport_ipv6 = getenv(OBPROXY_INHERITED_REUSEPORT_IPV6_FDS);
+
       info.update_state(HU_STATE_WAIT_HU_CMD);
       info.is_parent_ = false;
-      if (OB_FAIL(unsetenv(OBPROXY_INHERITED_IPV4_FD))) {
+      if (NULL != inherited_reuseport_ipv4
+          && OB_FAIL(info.parse_reuseport_fds(false, inherited_reuseport_ipv4))) {
+        MPRINT("fail to parse inherited reuseport ipv4 fds, fds=%s, ret=%d", inherited_reuseport_ipv4, ret);
+      } else if (NULL != inherited_reuseport_ipv6
+                 && OB_FAIL(info.parse_reuseport_fds(true, inherited_reuseport_ipv6))) {
+        MPRINT("fail to parse inherited reuseport ipv6 fds, fds=%s, ret=%d", inherited_reuseport_ipv6, ret);
+      } else if (OB_FAIL(unsetenv(OBPROXY_INHERITED_IPV4_FD))) {
         MPRINT("fail to unsetenv OBPROXY_INHERITED_IPV4_FD, ret=%d", ret);
       } else if (OB_FAIL(unsetenv(OBPROXY_INHERITED_IPV6_FD))) {
         MPRINT("fail to unsetenv OBPROXY_INHERITED_IPV6_FD, ret=%d", ret);
+      } else if (OB_FAIL(unsetenv(OBPROXY_INHERITED_REUSEPORT_IPV4_FDS))) {
+        MPRINT("fail to unsetenv OBPROXY_INHERITED_REUSEPORT_IPV4_FDS, ret=%d", ret);
+      } else if (OB_FAIL(unsetenv(OBPROXY_INHERITED_REUSEPORT_IPV6_FDS))) {
+        MPRINT("fail to unsetenv OBPROXY_INHERITED_REUSEPORT_IPV6_FDS, ret=%d", ret);
       }
     }
   }
@@ -1104,7 +1118,8 @@ int ObProxyMain::close_all_fd(const int32_t listen_ipv4_fd, const int32_t listen
             if (fd < 0) {
               continue;
             } else if (fd < 3 || fd == dirfd(fd_dir) || fd == listen_ipv4_fd
-                       || fd == listen_ipv6_fd) {
+                       || fd == listen_ipv6_fd
+                       || get_global_hot_upgrade_info().is_reuseport_fd(fd)) {
               continue;
             } else {
               if (OB_UNLIKELY(0 != close(fd))) {
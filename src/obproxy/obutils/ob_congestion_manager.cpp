@@ -422,8 +422,11 @@ int ObCongestionManager::add_record(const ObIpEndpoint &ip, ObCongestionEntry *e
         LOG_WARN("failed to run todo list", K(ret));
       } else {
         entry->inc_ref();
-        ObCongestionEntry *tmp = insert_entry(hash, ip, entry);
-        if (NULL != tmp) {
+        ObCongestionEntry *tmp = NULL;
+        if (OB_FAIL(insert_entry(hash, ip, entry, tmp))) {
+          LOG_WARN("fail to insert congestion entry", K(ip), K(ret));
+          entry->dec_ref();
+        } else if (NULL != tmp) {
           tmp->set_entry_deleted_state();
           tmp->dec_ref();
           tmp = NULL;
@@ -541,8 +544,11 @@ int ObCongestionManager::process(const int64_t buck_id, ObCongestRequestParam *p
   } else {
     switch (param->op_) {
       case ObCongestRequestParam::ADD_RECORD:
-        entry = insert_entry(param->hash_, param->key_, param->entry_);
-        if (NULL != entry) {
+        if (OB_FAIL(insert_entry(param->hash_, param->key_, param->entry_, entry))) {
+          LOG_WARN("fail to insert congestion entry", K(ret));
+          // the cache does not hold the entry handed to it
+          param->entry_->dec_ref();
+        } else if (NULL != entry) {
           entry->set_entry_deleted_state();
           entry->dec_ref();
           entry = NULL;
@@ -118,6 +118,13 @@ int ObProxyHotUpgrader::get_envp(char **&envp)
     is_obproxy_root_set = true;
     LOG_DEBUG("get env", K(obproxy_root));
   }
+  const ObHotUpgraderInfo &hu_info = get_global_hot_upgrade_info();
+  const int64_t reuseport_envp_start = count;
+  for (int64_t i = 0; i < 2; ++i) {
+    if (hu_info.get_reuseport_fd_count(1 == i) > 0) {
+      ++count;
+    }
+  }
   int64_t size = (count + 1) * sizeof(char *);
   char *var = NULL;
   var = reinterpret_cast<char *>(malloc(size));
@@ -170,6 +177,20 @@ int ObProxyHotUpgrader::get_envp(char **&envp)
         }
       }
     }
+    //set the extra SO_REUSEPORT listen fds
+    for (int64_t i = 0, idx = reuseport_envp_start; OB_SUCC(ret) && i < 2; ++i) {
+      if (hu_info.get_reuseport_fd_count(1 == i) > 0) {
+        if (OB_ISNULL(envp[idx] = reinterpret_cast<char *>(malloc(ObHotUpgraderInfo::MAX_REUSEPORT_ENVP_SIZE)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_ERROR("fail to malloc", "size", ObHotUpgraderInfo::MAX_REUSEPORT_ENVP_SIZE, K(ret));
+        } else if (OB_FAIL(hu_info.get_reuseport_envp(1 == i, envp[idx], ObHotUpgraderInfo::MAX_REUSEPORT_ENVP_SIZE))) {
+          LOG_WARN("fail to get reuseport envp", K(idx), K(ret));
+        } else {
+          LOG_INFO("pass reuseport listen fds to sub process", K(idx), K(envp[idx]));
+          ++idx;
+        }
+      }
+    }
     //attention:do not forget to set this
     if (OB_SUCC(ret)) {
       envp[count] = NULL;
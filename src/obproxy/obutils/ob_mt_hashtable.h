@@ -18,6 +18,7 @@
 #include "iocore/eventsystem/ob_buf_allocator.h"
 #include "iocore/eventsystem/ob_event_system.h"
 #include "lib/lock/ob_drw_lock.h"
+#include "lib/allocator/ob_retire_station.h"
 
 namespace oceanbase
 {
@@ -49,6 +50,9 @@ struct ObHashTableEntry
   Key key_;
   Value data_;
   ObHashTableEntry *next_;
+  // set once the entry is unlinked, see ObIMTHashTable::retire_entry()
+  uint64_t retire_clock_;
+  ObHashTableEntry *retire_next_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObHashTableEntry);
@@ -65,6 +69,13 @@ public:
   ObHashTableEntry<Key, Value> **ppcur_;
 };
 
+// Writers must hold the partition lock. Readers may call lookup_entry() without it inside
+// a common::QClockGuard critical section: entries are published with a single atomic
+// store, and an unlinked entry is retired with one more reference of its value instead
+// of being freed, so the value stays valid until the reader has inc_ref()'d it. Writers
+// never wait for the readers, the retired entries are reclaimed by the later writers
+// once the readers which may see them have gone. An unlinked entry's next_ is never
+// changed, readers walking through it still reach the rest of the chain.
 template <class Key, class Value>
 class ObIMTHashTable
 {
@@ -80,6 +91,12 @@ public:
     buckets_ = NULL;
     cur_size_ = 0;
     bucket_num_ = 0;
+    resize_version_ = 0;
+    retire_head_ = NULL;
+    retire_tail_ = NULL;
+    retired_buckets_ = NULL;
+    retired_bucket_num_ = 0;
+    retired_buckets_clock_ = 0;
   }
 
   ~ObIMTHashTable() { destroy(); }
@@ -125,23 +142,15 @@ public:
 
   void destroy()
   {
-    HashTableEntry *tmp = NULL;
+    reclaim_retired(true);
     if (NULL != buckets_) {
-      for (int64_t i = 0; i < bucket_num_; ++i) {
-        tmp = buckets_[i];
-        while (NULL != tmp) {
-          buckets_[i] = tmp->next_;
-          HashTableEntry::free(tmp);
-          tmp = buckets_[i];
-        }
-      }
-
-      op_fixed_mem_free(buckets_, bucket_num_ * sizeof(HashTableEntry *));
+      free_buckets(buckets_, bucket_num_);
       buckets_ = NULL;
     }
   }
 
-  Value insert_entry(const uint64_t hash, const Key &key, Value data);
+  // the replaced value is returned by old_data, it must be released by the caller
+  int insert_entry(const uint64_t hash, const Key &key, Value data, Value &old_data);
   Value remove_entry(const uint64_t hash, const Key &key);
   Value lookup_entry(const uint64_t hash, const Key &key);
 
@@ -152,6 +161,7 @@ public:
 
   void gc(void)
   {
+    reclaim_retired(false);
     if (NULL != gc_func) {
       if ( NULL != pre_gc_func) {
         pre_gc_func();
@@ -166,16 +176,21 @@ public:
         next = NULL;
         while (NULL != cur) {
           next = cur->next_;
+          // gc_func releases the reference of the hash table, hold one more
+          // until the readers which may have got this value have gone
+          cur->data_->inc_ref();
           if (gc_func(cur->data_)) {
             if (NULL != prev) {
-              prev->next_ = next;
+              ATOMIC_STORE(&prev->next_, next);
             } else {
-              buckets_[i] = next;
+              ATOMIC_STORE(&buckets_[i], next);
             }
 
-            HashTableEntry::free(cur);
+            // the reference held above goes with the retired entry
+            retire_entry(cur);
             --cur_size_;
           } else {
+            cur->data_->dec_ref();
             prev = cur;
           }
 
@@ -185,6 +200,7 @@ public:
     } // end if (NULL != gc_func)
   }
 
+  // entries are copied into the new buckets, so that readers always walk a complete chain
   int resize(const int64_t size)
   {
     int ret = common::OB_SUCCESS;
@@ -198,32 +214,116 @@ public:
       memset(new_buckets, 0, new_bucket_num * sizeof(HashTableEntry *));
 
       HashTableEntry *cur = NULL;
-      HashTableEntry *next = NULL;
+      HashTableEntry *new_entry = NULL;
       int64_t new_id = 0;
-      for (int64_t i = 0; i < bucket_num_; ++i) {
+      for (int64_t i = 0; OB_SUCC(ret) && i < bucket_num_; ++i) {
         cur = buckets_[i];
-        next = NULL;
-        while (NULL != cur) {
-          next = cur->next_;
-          new_id = bucket_id(cur->hash_, new_bucket_num);
-          cur->next_ = new_buckets[new_id];
-          new_buckets[new_id] = cur;
-          cur = next;
+        while (OB_SUCC(ret) && NULL != cur) {
+          if (OB_ISNULL(new_entry = HashTableEntry::alloc())) {
+            ret = common::OB_ALLOCATE_MEMORY_FAILED;
+            PROXY_LOG(ERROR, "fail to alloc memory for HashTableEntry", K(ret));
+          } else {
+            new_id = bucket_id(cur->hash_, new_bucket_num);
+            new_entry->hash_ = cur->hash_;
+            new_entry->key_ = cur->key_;
+            new_entry->data_ = cur->data_;
+            new_entry->next_ = new_buckets[new_id];
+            new_buckets[new_id] = new_entry;
+            cur = cur->next_;
+          }
         }
-
-        buckets_[i] = NULL;
       }
 
-      op_fixed_mem_free(buckets_, bucket_num_ * sizeof(HashTableEntry *));
-      buckets_ = new_buckets;
-      bucket_num_ = new_bucket_num;
+      if (OB_FAIL(ret)) {
+        free_buckets(new_buckets, new_bucket_num);
+      } else {
+        HashTableEntry **old_buckets = buckets_;
+        int64_t old_bucket_num = bucket_num_;
+        // buckets_ is stored before bucket_num_ and lookup_entry() loads them in the
+        // reverse order, so a reader never indexes the old buckets with the new bucket_num_
+        ATOMIC_INC(&resize_version_);
+        ATOMIC_STORE(&buckets_, new_buckets);
+        ATOMIC_STORE(&bucket_num_, new_bucket_num);
+        ATOMIC_INC(&resize_version_);
+        retire_buckets(old_buckets, old_bucket_num);
+      }
     }
     return ret;
   }
 
+  // free the retired entries and buckets which no reader can see any more, with need_wait
+  // wait for the readers and free all of them
+  void reclaim_retired(const bool need_wait)
+  {
+    common::QClock &qclock = common::get_global_qclock();
+    if (need_wait) {
+      qclock.wait_quiescent(qclock.inc_clock() - 1);
+    }
+    HashTableEntry *entry = NULL;
+    while (NULL != (entry = retire_head_) && (need_wait || qclock.is_quiescent(entry->retire_clock_))) {
+      retire_head_ = entry->retire_next_;
+      entry->data_->dec_ref();
+      HashTableEntry::free(entry);
+    }
+    if (NULL == retire_head_) {
+      retire_tail_ = NULL;
+    }
+    if (NULL != retired_buckets_ && (need_wait || qclock.is_quiescent(retired_buckets_clock_))) {
+      free_buckets(retired_buckets_, retired_bucket_num_);
+      retired_buckets_ = NULL;
+      retired_bucket_num_ = 0;
+    }
+  }
+
 private:
   ObIMTHashTable();
 
+  // the readers in a critical section entered before now may still see what is retired
+  static uint64_t get_retire_clock()
+  {
+    common::QClock &qclock = common::get_global_qclock();
+    return qclock.inc_clock() - 1;
+  }
+
+  // the caller has unlinked the entry and holds one reference of its value for it
+  void retire_entry(HashTableEntry *entry)
+  {
+    entry->retire_clock_ = get_retire_clock();
+    entry->retire_next_ = NULL;
+    if (NULL == retire_tail_) {
+      retire_head_ = entry;
+    } else {
+      retire_tail_->retire_next_ = entry;
+    }
+    retire_tail_ = entry;
+  }
+
+  void retire_buckets(HashTableEntry **buckets, const int64_t bucket_num)
+  {
+    if (NULL != retired_buckets_) {
+      // resized again before the last old buckets are reclaimed, rare enough to wait here
+      common::get_global_qclock().wait_quiescent(retired_buckets_clock_);
+      free_buckets(retired_buckets_, retired_bucket_num_);
+    }
+    retired_buckets_ = buckets;
+    retired_bucket_num_ = bucket_num;
+    retired_buckets_clock_ = get_retire_clock();
+  }
+
+  static void free_buckets(HashTableEntry **buckets, const int64_t bucket_num)
+  {
+    HashTableEntry *tmp = NULL;
+    for (int64_t i = 0; i < bucket_num; ++i) {
+      tmp = buckets[i];
+      while (NULL != tmp) {
+        buckets[i] = tmp->next_;
+        HashTableEntry::free(tmp);
+        tmp = buckets[i];
+      }
+    }
+    op_fixed_mem_free(buckets, bucket_num * sizeof(HashTableEntry *));
+  }
+
   bool (*gc_func)(Value);
   void (*pre_gc_func)(void);
 
@@ -231,43 +331,67 @@ private:
   HashTableEntry **buckets_;
   int64_t cur_size_;
   int64_t bucket_num_;
+  // odd while resize() is publishing the new buckets
+  int64_t resize_version_;
+  // unlinked entries in the order of retire_clock_
+  HashTableEntry *retire_head_;
+  HashTableEntry *retire_tail_;
+  // the buckets replaced by the last resize()
+  HashTableEntry **retired_buckets_;
+  int64_t retired_bucket_num_;
+  uint64_t retired_buckets_clock_;
   DISALLOW_COPY_AND_ASSIGN(ObIMTHashTable);
 };
 
 template <class Key, class Value>
-inline Value ObIMTHashTable<Key, Value>::insert_entry(const uint64_t hash, const Key &key, Value data)
+inline int ObIMTHashTable<Key, Value>::insert_entry(const uint64_t hash, const Key &key,
+                                                    Value data, Value &old_data)
 {
-  Value ret = static_cast<Value>(0);
+  int ret = common::OB_SUCCESS;
+  old_data = static_cast<Value>(0);
+  reclaim_retired(false);
   int64_t id = bucket_id(hash);
   HashTableEntry *cur = buckets_[id];
+  HashTableEntry *prev = NULL;
 
   while (NULL != cur && (hash != cur->hash_ || cur->key_ != key)) {
+    prev = cur;
     cur = cur->next_;
   }
 
-  if (NULL != cur) {
-    if (data == cur->data_) {
-      // return NULL;
-    } else {
-      ret = cur->data_;
-      cur->data_ = data;
-      cur->key_ = key;
-      // potential memory leak, need to check the return value by the caller
-    }
+  if (NULL != cur && data == cur->data_) {
+    // return NULL;
   } else {
     HashTableEntry *new_entry = HashTableEntry::alloc();
-    if (OB_LIKELY(NULL != new_entry)) {
+    if (OB_ISNULL(new_entry)) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      PROXY_LOG(WARN, "fail to alloc memory for HashTableEntry", K(ret));
+    } else {
       new_entry->hash_ = hash;
       new_entry->key_ = key;
       new_entry->data_ = data;
-      new_entry->next_ = buckets_[id];
-      buckets_[id] = new_entry;
-      ++cur_size_;
-      if (cur_size_ / bucket_num_ > MT_HASHTABLE_MAX_CHAIN_AVG_LEN) {
-        gc();
+      if (NULL != cur) {
+        // readers may be comparing the old key, replace the whole entry
+        new_entry->next_ = cur->next_;
+        if (NULL != prev) {
+          ATOMIC_STORE(&prev->next_, new_entry);
+        } else {
+          ATOMIC_STORE(&buckets_[id], new_entry);
+        }
+        old_data = cur->data_;
+        old_data->inc_ref();
+        retire_entry(cur);
+        cur = NULL;
+      } else {
+        new_entry->next_ = buckets_[id];
+        ATOMIC_STORE(&buckets_[id], new_entry);
+        ++cur_size_;
         if (cur_size_ / bucket_num_ > MT_HASHTABLE_MAX_CHAIN_AVG_LEN) {
-          if (OB_UNLIKELY(common::OB_SUCCESS != resize(bucket_num_ * 2))) {
-            PROXY_LOG(WARN, "fail to resize buckets");
+          gc();
+          if (cur_size_ / bucket_num_ > MT_HASHTABLE_MAX_CHAIN_AVG_LEN) {
+            if (OB_UNLIKELY(common::OB_SUCCESS != resize(bucket_num_ * 2))) {
+              PROXY_LOG(WARN, "fail to resize buckets");
+            }
           }
         }
       }
@@ -280,6 +404,7 @@ inline Value ObIMTHashTable<Key, Value>::insert_entry(const uint64_t hash, const
 template <class Key, class Value>
 inline Value ObIMTHashTable<Key, Value>::remove_entry(const uint64_t hash, const Key &key)
 {
+  reclaim_retired(false);
   int64_t id = bucket_id(hash);
   Value ret = static_cast<Value>(0);
   HashTableEntry *cur = buckets_[id];
@@ -292,13 +417,14 @@ inline Value ObIMTHashTable<Key, Value>::remove_entry(const uint64_t hash, const
 
   if (NULL != cur) {
     if (NULL != prev) {
-      prev->next_ = cur->next_;
+      ATOMIC_STORE(&prev->next_, cur->next_);
     } else {
-      buckets_[id] = cur->next_;
+      ATOMIC_STORE(&buckets_[id], cur->next_);
     }
 
     ret = cur->data_;
-    HashTableEntry::free(cur);
+    ret->inc_ref();
+    retire_entry(cur);
     cur = NULL;
     --cur_size_;
   }
@@ -309,13 +435,23 @@ inline Value ObIMTHashTable<Key, Value>::remove_entry(const uint64_t hash, const
 template <class Key, class Value>
 inline Value ObIMTHashTable<Key, Value>::lookup_entry(const uint64_t hash, const Key &key)
 {
-  int64_t id = bucket_id(hash);
   Value ret = static_cast<Value>(0);
-  HashTableEntry *cur = buckets_[id];
-
-  while (NULL != cur && (hash != cur->hash_ || cur->key_ != key)) {
-    cur = cur->next_;
-  }
+  HashTableEntry **buckets = NULL;
+  HashTableEntry *cur = NULL;
+  int64_t version = 0;
+  int64_t bucket_num = 0;
+
+  do {
+    version = ATOMIC_LOAD(&resize_version_);
+    bucket_num = ATOMIC_LOAD(&bucket_num_);
+    buckets = ATOMIC_LOAD(&buckets_);
+    cur = ATOMIC_LOAD(&buckets[bucket_id(hash, bucket_num)]);
+
+    while (NULL != cur && (hash != cur->hash_ || cur->key_ != key)) {
+      cur = ATOMIC_LOAD(&cur->next_);
+    }
+    // a miss during resize may have walked a chain of the other bucket_num, retry
+  } while (NULL == cur && (0 != (version & 1) || version != ATOMIC_LOAD(&resize_version_)));
 
   if (NULL != cur) {
     ret = cur->data_;
@@ -367,9 +503,10 @@ inline Value ObIMTHashTable<Key, Value>::remove_entry(IteratorState &s)
   Value ret = static_cast<Value>(0);
   HashTableEntry *entry = *(s.ppcur_);
   if (NULL != entry) {
+    ATOMIC_STORE(s.ppcur_, entry->next_);
     ret = entry->data_;
-    *(s.ppcur_) = entry->next_;
-    HashTableEntry::free(entry);
+    ret->inc_ref();
+    retire_entry(entry);
     entry = NULL;
     --cur_size_;
   }
@@ -477,10 +614,10 @@ public:
 
   void gc(const uint64_t hash) { hash_tables_[part_num(hash)]->gc(); }
 
-  //return old entry if existed
-  Value insert_entry(const uint64_t hash, const Key &key, Value data)
+  // return old entry by old_data if existed
+  int insert_entry(const uint64_t hash, const Key &key, Value data, Value &old_data)
   {
-    return hash_tables_[part_num(hash)]->insert_entry(hash, key, data);
+    return hash_tables_[part_num(hash)]->insert_entry(hash, key, data, old_data);
   }
 
   Value remove_entry(const uint64_t hash, const Key &key)
@@ -493,6 +630,20 @@ public:
     return hash_tables_[part_num(hash)]->lookup_entry(hash, key);
   }
 
+  // lookup without the partition lock, the returned value has been inc_ref()'d
+  Value acquire_entry(const uint64_t hash, const Key &key)
+  {
+    common::QClockGuard guard;
+    // the clock must be visible before the buckets are loaded, otherwise a writer may
+    // miss this reader and reclaim the entry it is reading
+    MEM_BARRIER();
+    Value ret = hash_tables_[part_num(hash)]->lookup_entry(hash, key);
+    if (static_cast<Value>(0) != ret) {
+      ret->inc_ref();
+    }
+    return ret;
+  }
+
   Value first_entry(const int64_t part_id, IteratorState &s)
   {
     Value ret = static_cast<Value>(0);
@@ -145,8 +145,7 @@ int ObProxyCreateServerConnCont::main_handler(int event, void *data)
       server_type = schema_key.get_db_server_type();
       if (DB_MYSQL == server_type) {
         //mysql no need create cluster
-        if (OB_ISNULL(pending_action_ = self_ethread().schedule_imm(this,
-            CONN_ENTRY_CREATE_SERVER_SESSION_EVENT))) {
+        if (OB_ISNULL(pending_action_ = schedule_create_server_session())) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("fail to schedule create session", K(schema_key));
         }
@@ -195,7 +194,7 @@ int ObProxyCreateServerConnCont::main_handler(int event, void *data)
     } else {
       get_global_session_manager().reset_fail_count(schema_key.dbkey_.config_string_, schema_key_conn_info_->addr_);
       if (create_count_ < conn_count_) {
-        if (OB_ISNULL(pending_action_ = self_ethread().schedule_imm(this, CONN_ENTRY_CREATE_SERVER_SESSION_EVENT, NULL))) {
+        if (OB_ISNULL(pending_action_ = schedule_create_server_session())) {
           LOG_WARN("fail to schedule create conn", K(ret));
         } else {
           LOG_DEBUG("continue create server conn", K(create_count_), K(conn_count_),
@@ -237,6 +236,14 @@ int ObProxyCreateServerConnCont::main_handler(int event, void *data)
   return ret;
 }
 
+// A server session lives on the thread which created it, and client sessions
+// prefer pooled sessions of their own thread, so spread the creation over
+// all the work threads instead of piling them up on this one.
+ObEvent *ObProxyCreateServerConnCont::schedule_create_server_session()
+{
+  return g_event_processor.schedule_imm(this, ET_CALL, CONN_ENTRY_CREATE_SERVER_SESSION_EVENT);
+}
+
 int ObProxyCreateServerConnCont::handle_create_session() {
   int ret = OB_SUCCESS;
   char sql[OB_SHORT_SQL_LENGTH];
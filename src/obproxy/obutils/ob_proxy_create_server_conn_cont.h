@@ -50,6 +50,7 @@ public:
   int handle_client_resp(void *data);
   int handle_select_value_resp(ObResultSetFetcher &rs_fetcher);
   int handle_create_session();
+  event::ObEvent *schedule_create_server_session();
   const char *get_event_name(const int64_t event);
 
 public:
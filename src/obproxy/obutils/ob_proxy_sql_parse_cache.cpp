@@ -0,0 +1,871 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include "obutils/ob_proxy_sql_parse_cache.h"
+#include "lib/utility/utility.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/allocator/ob_malloc.h"
+#include "iocore/eventsystem/ob_thread_impl.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace obutils
+{
+
+// same as identifer of the lexer, plus every byte of a multi byte char
+static inline bool is_ident_char(const char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+         || '$' == c || '_' == c || '#' == c || static_cast<uint8_t>(c) >= 0x80;
+}
+
+static inline bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static inline bool is_quote(const char c)
+{
+  return '\'' == c || '"' == c || '`' == c;
+}
+
+static inline bool is_word(const char *str, const int64_t len, const char *word, const int64_t word_len)
+{
+  return len == word_len && 0 == strncasecmp(str, word, word_len);
+}
+
+// the statement keywords after which comments are ignored by the lexer
+static inline bool is_dml_word(const char *str, const int64_t len)
+{
+  return is_word(str, len, "select", 6) || is_word(str, len, "insert", 6)
+         || is_word(str, len, "update", 6) || is_word(str, len, "delete", 6)
+         || is_word(str, len, "replace", 7) || is_word(str, len, "merge", 5);
+}
+
+// space of the lexer
+static inline bool is_space(const char c)
+{
+  return ' ' == c || '\t' == c || '\n' == c || '\r' == c || '\f' == c;
+}
+
+// chars of a trace value, all of them are taken by the lexer as one value
+static inline bool is_comment_value_char(const char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || is_digit(c)
+         || '_' == c || '.' == c || ':' == c || '-' == c;
+}
+
+static inline bool is_comment_value_sep(const char c)
+{
+  return '.' == c || ':' == c || '-' == c;
+}
+
+ObSqlParseCacheEntry::ObSqlParseCacheEntry()
+  : hash_(0), parse_mode_(NORMAL_PARSE_MODE), alloc_size_(0), key_(NULL), key_len_(0),
+    hash_next_(NULL), stmt_type_(OBPROXY_T_INVALID), sub_stmt_type_(OBPROXY_T_SUB_INVALID),
+    text_ps_inner_stmt_type_(OBPROXY_T_INVALID),
+    read_consistency_type_(OBPROXY_READ_CONSISTENCY_INVALID), query_timeout_(0),
+    is_dual_request_(false), has_last_insert_id_(false), has_found_rows_(false),
+    has_row_count_(false), has_explain_(false), has_simple_route_info_(false),
+    has_shard_comment_(false), end_offset_(-1), route_table_start_offset_(-1),
+    route_part_key_start_offset_(-1)
+{
+}
+
+__thread ObSqlParseCache *ObSqlParseCache::thread_cache_ = NULL;
+
+struct ObSqlParseCache::ObThreadCacheKey
+{
+  ObThreadCacheKey() : ret_(event::thread_key_create(&key_, destroy_thread_cache)) { }
+
+  int ret_;
+  ObThreadKey key_;
+};
+
+void ObSqlParseCache::destroy_thread_cache(void *ptr)
+{
+  if (NULL != ptr) {
+    delete static_cast<ObSqlParseCache *>(ptr);
+    thread_cache_ = NULL;
+  }
+}
+
+ObSqlParseCache::ObSqlParseCache()
+  : hit_count_(0), miss_count_(0), evict_count_(0), mem_limit_(0), mem_used_(0),
+    entry_count_(0), is_fingerprint_valid_(false), lru_list_()
+{
+  fingerprint_.reset();
+  MEMSET(buckets_, 0, sizeof(buckets_));
+}
+
+void ObSqlParseCache::destroy()
+{
+  evict(0);
+  is_fingerprint_valid_ = false;
+}
+
+int ObSqlParseCache::get_or_create_thread_cache(ObSqlParseCache *&cache)
+{
+  int ret = OB_SUCCESS;
+  // the key only frees the cache of an exiting thread
+  static ObThreadCacheKey cache_key;
+  ObSqlParseCache *new_cache = NULL;
+  if (OB_LIKELY(NULL != thread_cache_)) {
+  } else if (OB_FAIL(cache_key.ret_)) {
+    LOG_WARN("fail to create sql parse cache key", K(ret));
+  } else if (OB_ISNULL(new_cache = new (std::nothrow) ObSqlParseCache())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc sql parse cache", K(ret));
+  } else if (OB_FAIL(event::thread_setspecific(cache_key.key_, new_cache))) {
+    LOG_WARN("fail to set sql parse cache of thread", K(ret));
+    delete new_cache;
+    new_cache = NULL;
+  } else {
+    thread_cache_ = new_cache;
+  }
+  cache = thread_cache_;
+  return ret;
+}
+
+void ObSqlParseCache::set_mem_limit(const int64_t mem_limit)
+{
+  if (mem_limit != mem_limit_) {
+    mem_limit_ = mem_limit < 0 ? 0 : mem_limit;
+    if (mem_used_ > mem_limit_) {
+      evict(mem_limit_);
+    }
+  }
+}
+
+void ObSqlParseCache::remove_entry(ObSqlParseCacheEntry *entry)
+{
+  ObSqlParseCacheEntry **prev = &get_bucket(entry->hash_);
+  while (NULL != *prev && entry != *prev) {
+    prev = &(*prev)->hash_next_;
+  }
+  if (OB_LIKELY(NULL != *prev)) {
+    *prev = entry->hash_next_;
+  }
+  lru_list_.remove(entry);
+  mem_used_ -= entry->alloc_size_;
+  --entry_count_;
+  entry->~ObSqlParseCacheEntry();
+  ob_free(entry);
+}
+
+void ObSqlParseCache::evict(const int64_t mem_limit)
+{
+  ObSqlParseCacheEntry *entry = NULL;
+  while (mem_used_ > mem_limit && NULL != (entry = lru_list_.head_)) {
+    remove_entry(entry);
+    ++evict_count_;
+  }
+}
+
+int ObSqlParseCache::get(const ObString &sql, const ObProxyParseMode parse_mode,
+                         const ObCollationType collation, ObProxyParseResult &parse_result)
+{
+  int ret = OB_SUCCESS;
+  is_fingerprint_valid_ = false;
+  if (OB_UNLIKELY(mem_limit_ <= 0)
+      || OB_UNLIKELY(CS_TYPE_GB18030_CHINESE_CI == collation)
+      || OB_UNLIKELY(CS_TYPE_GB18030_BIN == collation)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (OB_FAIL(make_fingerprint(sql, parse_mode))) {
+    // not cacheable
+  } else {
+    ObSqlParseCacheEntry *entry = get_bucket(fingerprint_.hash_);
+    while (NULL != entry && !entry->is_equal(fingerprint_.hash_, parse_mode,
+                                             fingerprint_.buf_, fingerprint_.len_)) {
+      entry = entry->hash_next_;
+    }
+    if (NULL == entry) {
+      ++miss_count_;
+      is_fingerprint_valid_ = true;
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      ++hit_count_;
+      lru_list_.remove(entry);
+      lru_list_.enqueue(entry);
+      fill_result(*entry, parse_result);
+    }
+  }
+  return ret;
+}
+
+int ObSqlParseCache::put(const ObProxyParseResult &parse_result)
+{
+  int ret = OB_SUCCESS;
+  const int64_t alloc_size = static_cast<int64_t>(sizeof(ObSqlParseCacheEntry)) + fingerprint_.len_;
+  char *buf = NULL;
+  if (OB_UNLIKELY(!is_fingerprint_valid_)
+      || OB_UNLIKELY(parse_result.start_pos_ != fingerprint_.sql_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("parse result is not of the last missed sql", K(is_fingerprint_valid_), K(ret));
+  } else if (!is_cacheable(parse_result)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (OB_UNLIKELY(alloc_size > mem_limit_)) {
+    ret = OB_SIZE_OVERFLOW;
+  } else if (FALSE_IT(evict(mem_limit_ - alloc_size))) {
+  } else if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(alloc_size, ObModIds::OB_PROXY_SQL_PARSE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc sql parse cache entry", K(alloc_size), K(ret));
+  } else {
+    ObSqlParseCacheEntry *entry = new (buf) ObSqlParseCacheEntry();
+    entry->hash_ = fingerprint_.hash_;
+    entry->parse_mode_ = fingerprint_.parse_mode_;
+    entry->alloc_size_ = alloc_size;
+    entry->key_ = buf + sizeof(ObSqlParseCacheEntry);
+    entry->key_len_ = fingerprint_.len_;
+    MEMCPY(entry->key_, fingerprint_.buf_, fingerprint_.len_);
+    fill_entry(parse_result, *entry);
+
+    ObSqlParseCacheEntry *&bucket = get_bucket(entry->hash_);
+    entry->hash_next_ = bucket;
+    bucket = entry;
+    lru_list_.enqueue(entry);
+    mem_used_ += alloc_size;
+    ++entry_count_;
+  }
+  is_fingerprint_valid_ = false;
+  return ret;
+}
+
+int ObSqlParseCache::make_fingerprint(const ObString &sql, const ObProxyParseMode parse_mode)
+{
+  int ret = OB_SUCCESS;
+  const char *str = sql.ptr();
+  const int64_t len = sql.length();
+  int64_t pos = 0;
+  int64_t end = 0;
+  char marker = 0;
+  // nothing but spaces and comments so far, the lexer takes comments here as route info
+  bool is_leading = true;
+  // comments after the statement keyword are ignored by the lexer
+  bool is_after_dml = false;
+  fingerprint_.reset();
+  fingerprint_.sql_ = str;
+  fingerprint_.sql_len_ = len;
+  fingerprint_.parse_mode_ = parse_mode;
+  if (OB_UNLIKELY(NULL == str) || OB_UNLIKELY(len <= 0) || OB_UNLIKELY(len > MAX_SQL_LENGTH)) {
+    ret = OB_NOT_SUPPORTED;
+  }
+  while (OB_SUCC(ret) && pos < len) {
+    const char c = str[pos];
+    const bool is_word_start = (0 == pos || !is_ident_char(str[pos - 1]));
+    if (c > 0 && c <= MARKER_MAX) {
+      ret = OB_NOT_SUPPORTED;
+    } else if ('\'' == c) {
+      // x'', n'' and _charset'' are lexed by the prefix
+      if (!is_word_start) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (OB_SUCC(scan_string(pos, end, marker))) {
+        ret = add_literal(pos, end, marker);
+      }
+    } else if ('"' == c || '`' == c) {
+      if (OB_SUCC(scan_quoted_name(pos, end))) {
+        append(pos, end);
+      }
+    } else if ('/' == c && pos + 1 < len && '*' == str[pos + 1]) {
+      if (OB_SUCC(scan_comment(pos, end))) {
+        ret = add_comment(pos, end, is_leading, is_after_dml);
+      }
+    } else if (('-' == c && pos + 1 < len && '-' == str[pos + 1])
+               || ('#' == c && is_word_start)) {
+      if (OB_SUCC(scan_comment(pos, end))) {
+        append(pos, end);
+      }
+    } else if (is_digit(c) && is_word_start) {
+      scan_number(pos, end, marker);
+      if (0 != marker) {
+        ret = add_literal(pos, end, marker);
+      } else {
+        append(pos, end);
+      }
+    } else if (is_ident_char(c)) {
+      end = pos + 1;
+      while (end < len && is_ident_char(str[end])) {
+        ++end;
+      }
+      // WHEN of insert all and DECLARE leave the lexer in states which skip
+      // quotes, literals there are lexed differently
+      if (is_word(str + pos, end - pos, "when", 4) || is_word(str + pos, end - pos, "declare", 7)) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        is_after_dml = is_after_dml || is_dml_word(str + pos, end - pos);
+        append(pos, end);
+      }
+    } else {
+      end = pos + 1;
+      append(pos, end);
+    }
+    is_leading = is_leading && (is_space(c) || ('/' == c && end - pos > 1));
+    pos = end;
+  }
+  if (OB_SUCC(ret)) {
+    fingerprint_.hash_ = murmurhash(fingerprint_.buf_, static_cast<int32_t>(fingerprint_.len_), 0);
+  }
+  return ret;
+}
+
+int ObSqlParseCache::add_literal(const int64_t start, const int64_t end, const char marker)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(fingerprint_.literal_count_ >= MAX_LITERAL_COUNT)) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    fingerprint_.literal_start_[fingerprint_.literal_count_] = static_cast<int32_t>(start);
+    fingerprint_.literal_len_[fingerprint_.literal_count_] = static_cast<int32_t>(end - start);
+    fingerprint_.literal_marker_[fingerprint_.literal_count_] = marker;
+    ++fingerprint_.literal_count_;
+    fingerprint_.buf_[fingerprint_.len_++] = marker;
+  }
+  return ret;
+}
+
+void ObSqlParseCache::append(const int64_t start, const int64_t end)
+{
+  // the fingerprint is never longer than the sql
+  MEMCPY(fingerprint_.buf_ + fingerprint_.len_, fingerprint_.sql_ + start, end - start);
+  fingerprint_.len_ += end - start;
+}
+
+// kept verbatim, hint and route info live here, only quotes in them may
+// make the lexer disagree with us on where the comment ends
+int ObSqlParseCache::scan_comment(const int64_t pos, int64_t &end) const
+{
+  int ret = OB_SUCCESS;
+  const char *str = fingerprint_.sql_;
+  const int64_t len = fingerprint_.sql_len_;
+  if ('/' == str[pos]) {
+    end = pos + 2;
+    while (end + 1 < len && !('*' == str[end] && '/' == str[end + 1])) {
+      ++end;
+    }
+    if (end + 1 >= len) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      end += 2;
+    }
+  } else {
+    end = pos + 1;
+    while (end < len && '\n' != str[end] && '\r' != str[end]) {
+      ++end;
+    }
+  }
+  for (int64_t i = pos; OB_SUCC(ret) && i < end; ++i) {
+    if (is_quote(str[i])) {
+      ret = OB_NOT_SUPPORTED;
+    }
+  }
+  return ret;
+}
+
+// hints keep their values, and so do the comments the lexer may take as
+// tokens, they are kept verbatim
+int ObSqlParseCache::add_comment(const int64_t pos, const int64_t end,
+                                 const bool is_leading, const bool is_after_dml)
+{
+  int ret = OB_SUCCESS;
+  bool is_added = false;
+  if (is_leading) {
+    ret = add_trace_comment(pos, end, is_added);
+  } else if (is_after_dml && '+' != fingerprint_.sql_[pos + 2]) {
+    if (OB_SUCC(add_comment_values(pos, end))) {
+      is_added = true;
+    }
+  }
+  if (OB_SUCC(ret) && !is_added) {
+    append(pos, end);
+  }
+  return ret;
+}
+
+// /* trace_id=xxx, rpc_id=yyy */ before the statement, values are referred
+// to by the result as a whole, other leading comments are route info
+int ObSqlParseCache::add_trace_comment(const int64_t pos, const int64_t end, bool &is_added)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t MAX_TRACE_VALUE_COUNT = 4;
+  const char *str = fingerprint_.sql_;
+  const int64_t comment_end = end - 2;
+  int64_t value_start[MAX_TRACE_VALUE_COUNT];
+  int64_t value_end[MAX_TRACE_VALUE_COUNT];
+  int64_t value_count = 0;
+  int64_t i = pos + 2;
+  bool is_valid = true;
+  bool is_end = false;
+  is_added = false;
+  while (is_valid && !is_end) {
+    int64_t key_len = 0;
+    while (i < comment_end && is_space(str[i])) {
+      ++i;
+    }
+    if (i + 8 <= comment_end && 0 == strncasecmp(str + i, "trace_id", 8)) {
+      key_len = 8;
+    } else if (i + 6 <= comment_end && 0 == strncasecmp(str + i, "rpc_id", 6)) {
+      key_len = 6;
+    }
+    i += key_len;
+    if (0 == key_len || value_count >= MAX_TRACE_VALUE_COUNT
+        || i >= comment_end || !('=' == str[i] || is_space(str[i]))) {
+      is_valid = false;
+    } else {
+      while (i < comment_end && is_space(str[i])) {
+        ++i;
+      }
+      if (i >= comment_end || '=' != str[i]) {
+        is_valid = false;
+      } else {
+        ++i;
+        while (i < comment_end && is_space(str[i])) {
+          ++i;
+        }
+        value_start[value_count] = i;
+        while (i < comment_end && is_comment_value_char(str[i])) {
+          ++i;
+        }
+        value_end[value_count] = i;
+        while (i < comment_end && is_space(str[i])) {
+          ++i;
+        }
+        if (value_end[value_count] == value_start[value_count]) {
+          is_valid = false;
+        } else if (i == comment_end) {
+          is_end = true;
+        } else if (',' != str[i]) {
+          is_valid = false;
+        } else {
+          ++i;
+        }
+        ++value_count;
+      }
+    }
+  }
+  if (is_valid) {
+    int64_t last = pos;
+    for (int64_t j = 0; OB_SUCC(ret) && j < value_count; ++j) {
+      append(last, value_start[j]);
+      if (OB_SUCC(add_literal(value_start[j], value_end[j], MARKER_COMMENT_VALUE))) {
+        last = value_end[j];
+      }
+    }
+    if (OB_SUCC(ret)) {
+      append(last, end);
+      is_added = true;
+    }
+  }
+  return ret;
+}
+
+// the lexer may take words of a comment after the statement keyword as
+// tokens, but a word with a digit is never a keyword, so every run of
+// comment value chars whose parts all hold a digit is a literal
+int ObSqlParseCache::add_comment_values(const int64_t pos, const int64_t end)
+{
+  int ret = OB_SUCCESS;
+  const char *str = fingerprint_.sql_;
+  const int64_t comment_end = end - 2;
+  int64_t last = pos;
+  int64_t i = pos + 2;
+  while (OB_SUCC(ret) && i < comment_end) {
+    if (!is_comment_value_char(str[i])) {
+      ++i;
+    } else {
+      const int64_t run_start = i;
+      bool is_value = true;
+      bool has_digit = false;
+      while (i < comment_end && is_comment_value_char(str[i])) {
+        if (is_comment_value_sep(str[i])) {
+          // every part is not empty and holds a digit
+          is_value = is_value && has_digit && i + 1 < comment_end && !is_comment_value_sep(str[i + 1]);
+          has_digit = false;
+        } else if (is_digit(str[i])) {
+          has_digit = true;
+        }
+        ++i;
+      }
+      if (is_value && has_digit) {
+        append(last, run_start);
+        if (OB_SUCC(add_literal(run_start, i, MARKER_COMMENT_VALUE))) {
+          last = i;
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    append(last, end);
+  }
+  return ret;
+}
+
+// "name" and `name` are kept verbatim
+int ObSqlParseCache::scan_quoted_name(const int64_t pos, int64_t &end) const
+{
+  int ret = OB_SUCCESS;
+  const char *str = fingerprint_.sql_;
+  const int64_t len = fingerprint_.sql_len_;
+  const char quote = str[pos];
+  bool found = false;
+  end = pos + 1;
+  while (OB_SUCC(ret) && !found && end < len) {
+    const char c = str[end];
+    if (quote == c) {
+      if (end + 1 < len && quote == str[end + 1]) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        found = true;
+      }
+    } else if (is_quote(c) || '\\' == c || '\n' == c || '\r' == c || '#' == c
+               || ('/' == c && end + 1 < len && '*' == str[end + 1])
+               || ('-' == c && end + 1 < len && '-' == str[end + 1])) {
+      ret = OB_NOT_SUPPORTED;
+    }
+    ++end;
+  }
+  if (OB_SUCC(ret) && !found) {
+    ret = OB_NOT_SUPPORTED;
+  }
+  return ret;
+}
+
+// 'str' is lexed as NAME_OB if it matches identifer, otherwise as a plain string
+int ObSqlParseCache::scan_string(const int64_t pos, int64_t &end, char &marker) const
+{
+  int ret = OB_SUCCESS;
+  const char *str = fingerprint_.sql_;
+  const int64_t len = fingerprint_.sql_len_;
+  bool found = false;
+  bool is_name = true;
+  int64_t char_len = 0;
+  end = pos + 1;
+  while (OB_SUCC(ret) && !found && end < len) {
+    const char c = str[end];
+    if ('\'' == c) {
+      if (end + 1 < len && '\'' == str[end + 1]) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        found = true;
+        ++end;
+      }
+    } else if ('\\' == c || '\0' == c || (c > 0 && c <= MARKER_MAX)) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (static_cast<uint8_t>(c) >= 0x80) {
+      if (0 == (char_len = get_connect_char_len(end, len))) {
+        is_name = false;
+        ++end;
+      } else {
+        end += char_len;
+      }
+    } else {
+      if (!is_ident_char(c)) {
+        is_name = false;
+      }
+      ++end;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (!found) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      marker = is_name ? MARKER_NAME_STRING : MARKER_STRING;
+    }
+  }
+  return ret;
+}
+
+// [0-9]+ or [0-9]+.[0-9]*, neither followed by an identifer char nor a '.',
+// the lexer tells int_num from number by the digits before the point
+void ObSqlParseCache::scan_number(const int64_t pos, int64_t &end, char &marker) const
+{
+  const char *str = fingerprint_.sql_;
+  const int64_t len = fingerprint_.sql_len_;
+  int64_t int_len = 0;
+  bool is_decimal = false;
+  end = pos;
+  marker = 0;
+  while (end < len && is_digit(str[end])) {
+    ++end;
+  }
+  int_len = end - pos;
+  if (end < len && '.' == str[end]) {
+    is_decimal = true;
+    ++end;
+    while (end < len && is_digit(str[end])) {
+      ++end;
+    }
+  }
+  if (end < len && (is_ident_char(str[end]) || '.' == str[end])) {
+    // 1e5, 0x1f, 1abc, 1.2.3
+  } else if (is_decimal) {
+    marker = int_len <= 17 ? MARKER_DECIMAL : MARKER_BIG_DECIMAL;
+  } else {
+    marker = int_len <= 17 ? MARKER_INT : MARKER_BIG_INT;
+  }
+}
+
+// length of the multi byte char at pos if it is a connect char of the utf8
+// lexer, 0 if not
+int64_t ObSqlParseCache::get_connect_char_len(const int64_t pos, const int64_t end) const
+{
+  const uint8_t *str = reinterpret_cast<const uint8_t *>(fingerprint_.sql_) + pos;
+  const int64_t remain = end - pos;
+  const uint8_t c = str[0];
+  int64_t char_len = 0;
+  if (c >= 0xc2 && c <= 0xdf) {
+    char_len = 2;
+  } else if (c >= 0xe0 && c <= 0xef) {
+    char_len = 3;
+  } else if (c >= 0xf0 && c <= 0xf4) {
+    char_len = 4;
+  }
+  if (char_len > remain) {
+    char_len = 0;
+  }
+  for (int64_t i = 1; i < char_len; ++i) {
+    if (str[i] < 0x80 || str[i] > 0xbf) {
+      char_len = 0;
+    }
+  }
+  if (3 == char_len) {
+    // multi byte space, comma and parenthesis
+    if ((0xe3 == c && 0x80 == str[1] && 0x80 == str[2])
+        || (0xef == c && 0xbc == str[1] && (0x8c == str[2] || 0x88 == str[2] || 0x89 == str[2]))) {
+      char_len = 0;
+    }
+  }
+  return char_len;
+}
+
+bool ObSqlParseCache::to_key_offset(const char *ptr, int32_t &offset) const
+{
+  bool bret = false;
+  const int64_t pos = ptr - fingerprint_.sql_;
+  if (NULL != ptr && pos >= 0 && pos <= fingerprint_.sql_len_) {
+    int64_t delta = 0;
+    bret = true;
+    for (int64_t i = 0; bret && i < fingerprint_.literal_count_; ++i) {
+      const int64_t start = fingerprint_.literal_start_[i];
+      const int64_t len = fingerprint_.literal_len_[i];
+      if (start + len <= pos) {
+        delta += len - 1;
+      } else {
+        if (start < pos) {
+          bret = false;
+        }
+        break;
+      }
+    }
+    if (bret) {
+      offset = static_cast<int32_t>(pos - delta);
+    }
+  }
+  return bret;
+}
+
+bool ObSqlParseCache::to_key_string(const ObProxyParseString &str, ObSqlParseCacheString &cache_str) const
+{
+  bool bret = true;
+  cache_str.reset();
+  if (NULL != str.str_) {
+    const char *sql_begin = fingerprint_.sql_;
+    const char *sql_end = fingerprint_.sql_ + fingerprint_.sql_len_;
+    const char *start = str.str_;
+    if (str.str_len_ < 0) {
+      bret = false;
+    } else if ((start < sql_begin || start > sql_end)
+               && OBPROXY_QUOTE_T_BACK == str.quote_type_
+               && NULL != str.end_ptr_
+               && str.end_ptr_ - str.str_len_ - 1 > sql_begin
+               && str.end_ptr_ <= sql_end
+               && 0 == MEMCMP(str.end_ptr_ - str.str_len_ - 1, str.str_, str.str_len_)) {
+      // `name` out of expr is copied by the lexer, and it is still the same as the sql
+      start = str.end_ptr_ - str.str_len_ - 1;
+    }
+    if (bret && !to_key_offset(start, cache_str.offset_)) {
+      bret = false;
+    } else if (bret && NULL != str.end_ptr_ && !to_key_offset(str.end_ptr_, cache_str.end_offset_)) {
+      bret = false;
+    }
+    for (int64_t i = 0; bret && i < fingerprint_.literal_count_; ++i) {
+      const char *literal_start = sql_begin + fingerprint_.literal_start_[i];
+      if (literal_start < start + str.str_len_ && start < literal_start + fingerprint_.literal_len_[i]) {
+        if (MARKER_COMMENT_VALUE == fingerprint_.literal_marker_[i]
+            && literal_start == start && fingerprint_.literal_len_[i] == str.str_len_) {
+          // trace_id and rpc_id, rebuilt from the literal on hit
+          cache_str.literal_idx_ = static_cast<int32_t>(i);
+        } else {
+          bret = false;
+        }
+      }
+    }
+    if (bret) {
+      cache_str.len_ = str.str_len_;
+      cache_str.quote_type_ = str.quote_type_;
+    }
+  }
+  return bret;
+}
+
+char *ObSqlParseCache::to_sql_ptr(const int32_t offset) const
+{
+  char *ptr = NULL;
+  if (offset >= 0) {
+    int64_t delta = 0;
+    for (int64_t i = 0; i < fingerprint_.literal_count_; ++i) {
+      if (fingerprint_.literal_start_[i] - delta < offset) {
+        delta += fingerprint_.literal_len_[i] - 1;
+      } else {
+        break;
+      }
+    }
+    ptr = const_cast<char *>(fingerprint_.sql_) + offset + delta;
+  }
+  return ptr;
+}
+
+void ObSqlParseCache::to_sql_string(const ObSqlParseCacheString &cache_str, ObProxyParseString &str) const
+{
+  str.str_ = to_sql_ptr(cache_str.offset_);
+  str.end_ptr_ = to_sql_ptr(cache_str.end_offset_);
+  str.str_len_ = cache_str.literal_idx_ >= 0 ? fingerprint_.literal_len_[cache_str.literal_idx_] : cache_str.len_;
+  str.quote_type_ = cache_str.quote_type_;
+}
+
+bool ObSqlParseCache::is_cacheable(const ObProxyParseResult &parse_result) const
+{
+  bool bret = false;
+  switch (parse_result.stmt_type_) {
+    case OBPROXY_T_SELECT:
+    case OBPROXY_T_INSERT:
+    case OBPROXY_T_UPDATE:
+    case OBPROXY_T_DELETE:
+    case OBPROXY_T_REPLACE:
+    case OBPROXY_T_MERGE:
+      bret = !parse_result.has_anonymous_block_;
+      break;
+    default:
+      break;
+  }
+  if (bret) {
+    int32_t offset = 0;
+    ObSqlParseCacheString cache_str;
+    const ObProxyTableInfo &table_info = parse_result.table_info_;
+    const ObProxySimpleRouteParseInfo &route_info = parse_result.simple_route_info_;
+    bret = to_key_offset(parse_result.end_pos_, offset)
+           && to_key_string(table_info.database_name_, cache_str)
+           && to_key_string(table_info.package_name_, cache_str)
+           && to_key_string(table_info.table_name_, cache_str)
+           && to_key_string(table_info.alias_name_, cache_str)
+           && to_key_string(parse_result.part_name_, cache_str)
+           && to_key_string(parse_result.trace_id_, cache_str)
+           && to_key_string(parse_result.rpc_id_, cache_str)
+           && to_key_string(parse_result.target_db_server_, cache_str);
+    if (bret && parse_result.has_simple_route_info_) {
+      bret = (NULL == route_info.table_start_ptr_ || to_key_offset(route_info.table_start_ptr_, offset))
+             && (NULL == route_info.part_key_start_ptr_ || to_key_offset(route_info.part_key_start_ptr_, offset))
+             && to_key_string(route_info.table_name_, cache_str)
+             && to_key_string(route_info.part_key_, cache_str);
+    }
+  }
+  return bret;
+}
+
+void ObSqlParseCache::fill_entry(const ObProxyParseResult &parse_result, ObSqlParseCacheEntry &entry) const
+{
+  const ObProxyTableInfo &table_info = parse_result.table_info_;
+  const ObProxySimpleRouteParseInfo &route_info = parse_result.simple_route_info_;
+  entry.stmt_type_ = parse_result.stmt_type_;
+  entry.sub_stmt_type_ = parse_result.sub_stmt_type_;
+  entry.text_ps_inner_stmt_type_ = parse_result.text_ps_inner_stmt_type_;
+  entry.read_consistency_type_ = parse_result.read_consistency_type_;
+  entry.query_timeout_ = parse_result.query_timeout_;
+  entry.is_dual_request_ = parse_result.is_dual_request_;
+  entry.has_last_insert_id_ = parse_result.has_last_insert_id_;
+  entry.has_found_rows_ = parse_result.has_found_rows_;
+  entry.has_row_count_ = parse_result.has_row_count_;
+  entry.has_explain_ = parse_result.has_explain_;
+  entry.has_simple_route_info_ = parse_result.has_simple_route_info_;
+  entry.has_shard_comment_ = parse_result.has_shard_comment_;
+  // all checked by is_cacheable()
+  to_key_offset(parse_result.end_pos_, entry.end_offset_);
+  to_key_string(table_info.database_name_, entry.strings_[ObSqlParseCacheEntry::DATABASE_NAME_IDX]);
+  to_key_string(table_info.package_name_, entry.strings_[ObSqlParseCacheEntry::PACKAGE_NAME_IDX]);
+  to_key_string(table_info.table_name_, entry.strings_[ObSqlParseCacheEntry::TABLE_NAME_IDX]);
+  to_key_string(table_info.alias_name_, entry.strings_[ObSqlParseCacheEntry::ALIAS_NAME_IDX]);
+  to_key_string(parse_result.part_name_, entry.strings_[ObSqlParseCacheEntry::PART_NAME_IDX]);
+  to_key_string(parse_result.trace_id_, entry.strings_[ObSqlParseCacheEntry::TRACE_ID_IDX]);
+  to_key_string(parse_result.rpc_id_, entry.strings_[ObSqlParseCacheEntry::RPC_ID_IDX]);
+  to_key_string(parse_result.target_db_server_, entry.strings_[ObSqlParseCacheEntry::TARGET_DB_SERVER_IDX]);
+  if (parse_result.has_simple_route_info_) {
+    if (NULL != route_info.table_start_ptr_) {
+      to_key_offset(route_info.table_start_ptr_, entry.route_table_start_offset_);
+    }
+    if (NULL != route_info.part_key_start_ptr_) {
+      to_key_offset(route_info.part_key_start_ptr_, entry.route_part_key_start_offset_);
+    }
+    to_key_string(route_info.table_name_, entry.strings_[ObSqlParseCacheEntry::ROUTE_TABLE_NAME_IDX]);
+    to_key_string(route_info.part_key_, entry.strings_[ObSqlParseCacheEntry::ROUTE_PART_KEY_IDX]);
+  }
+}
+
+void ObSqlParseCache::fill_result(const ObSqlParseCacheEntry &entry, ObProxyParseResult &parse_result) const
+{
+  ObProxyTableInfo &table_info = parse_result.table_info_;
+  ObProxySimpleRouteParseInfo &route_info = parse_result.simple_route_info_;
+  MEMSET(&parse_result, 0, sizeof(parse_result));
+  parse_result.parse_mode_ = fingerprint_.parse_mode_;
+  parse_result.start_pos_ = fingerprint_.sql_;
+  parse_result.end_pos_ = to_sql_ptr(entry.end_offset_);
+  parse_result.stmt_type_ = entry.stmt_type_;
+  parse_result.sub_stmt_type_ = entry.sub_stmt_type_;
+  parse_result.text_ps_inner_stmt_type_ = entry.text_ps_inner_stmt_type_;
+  parse_result.read_consistency_type_ = entry.read_consistency_type_;
+  parse_result.query_timeout_ = entry.query_timeout_;
+  parse_result.is_dual_request_ = entry.is_dual_request_;
+  parse_result.has_last_insert_id_ = entry.has_last_insert_id_;
+  parse_result.has_found_rows_ = entry.has_found_rows_;
+  parse_result.has_row_count_ = entry.has_row_count_;
+  parse_result.has_explain_ = entry.has_explain_;
+  parse_result.has_simple_route_info_ = entry.has_simple_route_info_;
+  parse_result.has_shard_comment_ = entry.has_shard_comment_;
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::DATABASE_NAME_IDX], table_info.database_name_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::PACKAGE_NAME_IDX], table_info.package_name_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::TABLE_NAME_IDX], table_info.table_name_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::ALIAS_NAME_IDX], table_info.alias_name_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::PART_NAME_IDX], parse_result.part_name_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::TRACE_ID_IDX], parse_result.trace_id_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::RPC_ID_IDX], parse_result.rpc_id_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::TARGET_DB_SERVER_IDX], parse_result.target_db_server_);
+  route_info.table_start_ptr_ = to_sql_ptr(entry.route_table_start_offset_);
+  route_info.part_key_start_ptr_ = to_sql_ptr(entry.route_part_key_start_offset_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::ROUTE_TABLE_NAME_IDX], route_info.table_name_);
+  to_sql_string(entry.strings_[ObSqlParseCacheEntry::ROUTE_PART_KEY_IDX], route_info.part_key_);
+}
+
+int64_t ObSqlParseCache::to_string(char *buf, const int64_t buf_len) const
+{
+  int64_t pos = 0;
+  J_OBJ_START();
+  J_KV(K_(mem_limit), K_(mem_used), K_(entry_count), K_(hit_count), K_(miss_count), K_(evict_count));
+  J_OBJ_END();
+  return pos;
+}
+
+} // end of namespace obutils
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * **************************************************************
+ *
+ * Per thread cache of the proxy parser result, with the following functionality:
+ * (1). The key is the fingerprint of the sql plus the parse mode, every number
+ *      and single quoted string out of comments is replaced by a marker of its
+ *      lexical class, so that statements of the same shape share one entry.
+ *      So are the values of a leading trace_id/rpc_id comment, and the digit
+ *      runs of the comments after the statement keyword, other comments are kept.
+ *      All the collations but gb18030 share the utf8 lexer, gb18030 is not cached.
+ * (2). Only dml whose proxy parse result can not depend on the value of a
+ *      literal is cached, every string of the result must lie outside the
+ *      literals, and is kept as an offset in the fingerprint.
+ * (3). A hit rebuilds the ObProxyParseResult on the new sql, the caller loads
+ *      it like a fresh one, so bison is skipped entirely.
+ * (4). Entries are evicted in LRU order once the memory limit is reached.
+ * (5). It is not thread safe, every thread uses its own one.
+ */
+
+#ifndef OBPROXY_SQL_PARSE_CACHE_H
+#define OBPROXY_SQL_PARSE_CACHE_H
+
+#include "lib/ob_define.h"
+#include "lib/string/ob_string.h"
+#include "lib/charset/ob_charset.h"
+#include "lib/list/ob_intrusive_list.h"
+#include "lib/utility/ob_print_utils.h"
+#include "opsql/parser/ob_proxy_parse_result.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace obutils
+{
+
+struct ObSqlParseCacheString
+{
+  ObSqlParseCacheString() { reset(); }
+  ~ObSqlParseCacheString() { }
+  void reset()
+  {
+    offset_ = -1;
+    end_offset_ = -1;
+    len_ = 0;
+    quote_type_ = OBPROXY_QUOTE_T_INVALID;
+    literal_idx_ = -1;
+  }
+
+  int32_t offset_;      // in the fingerprint, -1 if NULL
+  int32_t end_offset_;  // -1 if NULL
+  int32_t len_;
+  ObProxyParseQuoteType quote_type_;
+  int32_t literal_idx_; // >= 0 if it is a whole comment value, whose length varies
+};
+
+struct ObSqlParseCacheEntry
+{
+  enum ObStringIndex
+  {
+    DATABASE_NAME_IDX = 0,
+    PACKAGE_NAME_IDX,
+    TABLE_NAME_IDX,
+    ALIAS_NAME_IDX,
+    PART_NAME_IDX,
+    TRACE_ID_IDX,
+    RPC_ID_IDX,
+    TARGET_DB_SERVER_IDX,
+    ROUTE_TABLE_NAME_IDX,
+    ROUTE_PART_KEY_IDX,
+    MAX_STRING_IDX
+  };
+
+  ObSqlParseCacheEntry();
+  ~ObSqlParseCacheEntry() { }
+
+  bool is_equal(const uint64_t hash, const ObProxyParseMode parse_mode,
+                const char *key, const int64_t key_len) const
+  {
+    return hash == hash_ && parse_mode == parse_mode_
+           && key_len == key_len_ && 0 == MEMCMP(key, key_, key_len);
+  }
+
+  uint64_t hash_;
+  ObProxyParseMode parse_mode_;
+  int64_t alloc_size_;
+  char *key_;  // right behind the entry
+  int64_t key_len_;
+  ObSqlParseCacheEntry *hash_next_;
+  LINK(ObSqlParseCacheEntry, lru_link_);
+
+  // skeleton of ObProxyParseResult
+  ObProxyBasicStmtType stmt_type_;
+  ObProxyBasicStmtSubType sub_stmt_type_;
+  ObProxyBasicStmtType text_ps_inner_stmt_type_;
+  ObProxyReadConsistencyType read_consistency_type_;
+  int64_t query_timeout_;
+  bool is_dual_request_;
+  bool has_last_insert_id_;
+  bool has_found_rows_;
+  bool has_row_count_;
+  bool has_explain_;
+  bool has_simple_route_info_;
+  bool has_shard_comment_;
+  int32_t end_offset_;
+  int32_t route_table_start_offset_;
+  int32_t route_part_key_start_offset_;
+  ObSqlParseCacheString strings_[MAX_STRING_IDX];
+};
+
+class ObSqlParseCache
+{
+public:
+  static const int64_t MAX_SQL_LENGTH = 4096;
+  static const int64_t MAX_LITERAL_COUNT = 512;
+  static const int64_t BUCKET_COUNT = 1024;
+
+  // markers of the literal classes in the fingerprint, the flex lexer turns
+  // every literal of one class into the same kind of token
+  static const char MARKER_INT = '\x01';              // 1-17 digits
+  static const char MARKER_BIG_INT = '\x02';          // 18 or more digits
+  static const char MARKER_DECIMAL = '\x03';          // 1-17 digits before the point
+  static const char MARKER_BIG_DECIMAL = '\x04';      // 18 or more digits before the point
+  static const char MARKER_NAME_STRING = '\x05';      // matches identifer of the lexer
+  static const char MARKER_STRING = '\x06';
+  static const char MARKER_COMMENT_VALUE = '\x07';   // trace value or digit run in comments
+  static const char MARKER_MAX = MARKER_COMMENT_VALUE;
+
+  ObSqlParseCache();
+  ~ObSqlParseCache() { destroy(); }
+  void destroy();
+
+  // NULL if the calling thread has not used it yet, freed when the thread exits
+  static ObSqlParseCache *get_thread_cache() { return thread_cache_; }
+  static int get_or_create_thread_cache(ObSqlParseCache *&cache);
+
+  // evict at once when the limit is lowered, 0 drops all
+  void set_mem_limit(const int64_t mem_limit);
+  int64_t get_mem_limit() const { return mem_limit_; }
+  int64_t get_mem_used() const { return mem_used_; }
+  int64_t get_entry_count() const { return entry_count_; }
+
+  // OB_SUCCESS and parse_result rebuilt on sql if hit,
+  // OB_ENTRY_NOT_EXIST if missed, then put() may add the result of this sql,
+  // OB_NOT_SUPPORTED if the sql can not be cached
+  int get(const common::ObString &sql, const ObProxyParseMode parse_mode,
+          const common::ObCollationType collation, ObProxyParseResult &parse_result);
+  // parse_result must be parsed from the sql of the last missed get()
+  int put(const ObProxyParseResult &parse_result);
+
+  int64_t to_string(char *buf, const int64_t buf_len) const;
+
+private:
+  struct ObSqlFingerprint
+  {
+    void reset()
+    {
+      sql_ = NULL;
+      sql_len_ = 0;
+      len_ = 0;
+      hash_ = 0;
+      literal_count_ = 0;
+    }
+
+    const char *sql_;
+    int64_t sql_len_;
+    int64_t len_;
+    uint64_t hash_;
+    ObProxyParseMode parse_mode_;
+    int64_t literal_count_;
+    int32_t literal_start_[MAX_LITERAL_COUNT];  // in the sql
+    int32_t literal_len_[MAX_LITERAL_COUNT];
+    char literal_marker_[MAX_LITERAL_COUNT];
+    char buf_[MAX_SQL_LENGTH];
+  };
+
+  // OB_NOT_SUPPORTED if the lexer may split it in a way the fingerprint can not tell
+  int make_fingerprint(const common::ObString &sql, const ObProxyParseMode parse_mode);
+  int add_literal(const int64_t start, const int64_t end, const char marker);
+  void append(const int64_t start, const int64_t end);
+  int scan_comment(const int64_t pos, int64_t &end) const;
+  int add_comment(const int64_t pos, const int64_t end, const bool is_leading, const bool is_after_dml);
+  int add_trace_comment(const int64_t pos, const int64_t end, bool &is_added);
+  int add_comment_values(const int64_t pos, const int64_t end);
+  int scan_quoted_name(const int64_t pos, int64_t &end) const;
+  int scan_string(const int64_t pos, int64_t &end, char &marker) const;
+  void scan_number(const int64_t pos, int64_t &end, char &marker) const;
+  int64_t get_connect_char_len(const int64_t pos, const int64_t end) const;
+
+  bool is_cacheable(const ObProxyParseResult &parse_result) const;
+  // sql pointers <-> fingerprint offsets, false if it lies within a literal
+  bool to_key_offset(const char *ptr, int32_t &offset) const;
+  bool to_key_string(const ObProxyParseString &str, ObSqlParseCacheString &cache_str) const;
+  char *to_sql_ptr(const int32_t offset) const;
+  void to_sql_string(const ObSqlParseCacheString &cache_str, ObProxyParseString &str) const;
+  void fill_entry(const ObProxyParseResult &parse_result, ObSqlParseCacheEntry &entry) const;
+  void fill_result(const ObSqlParseCacheEntry &entry, ObProxyParseResult &parse_result) const;
+
+  ObSqlParseCacheEntry *&get_bucket(const uint64_t hash) { return buckets_[hash & (BUCKET_COUNT - 1)]; }
+  void remove_entry(ObSqlParseCacheEntry *entry);
+  void evict(const int64_t mem_limit);
+
+public:
+  int64_t hit_count_;
+  int64_t miss_count_;
+  int64_t evict_count_;
+
+private:
+  struct ObThreadCacheKey;
+  static void destroy_thread_cache(void *ptr);
+
+  static __thread ObSqlParseCache *thread_cache_;
+
+  int64_t mem_limit_;
+  int64_t mem_used_;
+  int64_t entry_count_;
+  bool is_fingerprint_valid_;
+  ObSqlFingerprint fingerprint_;
+  ObSqlParseCacheEntry *buckets_[BUCKET_COUNT];
+  common::Queue<ObSqlParseCacheEntry, ObSqlParseCacheEntry::Link_lru_link_> lru_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSqlParseCache);
+};
+
+} // end of namespace obutils
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_SQL_PARSE_CACHE_H
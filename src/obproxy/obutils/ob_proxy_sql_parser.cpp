@@ -13,8 +13,11 @@
 #define USING_LOG_PREFIX PROXY
 #include "utils/ob_proxy_utils.h"
 #include "obutils/ob_proxy_sql_parser.h"
+#include "obutils/ob_proxy_sql_parse_cache.h"
+#include "obutils/ob_proxy_config.h"
 #include "obutils/ob_proxy_stmt.h"
 #include "opsql/parser/ob_proxy_parser.h"
+#include "opsql/parser/ob_proxy_fast_parser.h"
 #include "dbconfig/ob_proxy_db_config_info.h"
 #include "proxy/shard/obproxy_shard_utils.h"
 #include "obproxy/utils/ob_proxy_utils.h"
@@ -616,6 +619,9 @@ int ObSqlParseResult::load_result(const ObProxyParseResult &parse_result,
   hint_consistency_level_ = static_cast<ObConsistencyLevel>(parse_result.read_consistency_type_);
   parsed_length_ = static_cast<int64_t>(parse_result.end_pos_ - parse_result.start_pos_);
   text_ps_inner_stmt_type_ = parse_result.text_ps_inner_stmt_type_;
+  where_cond_info_.cond_count_ = parse_result.where_cond_info_.cond_count_;
+  MEMCPY(where_cond_info_.conds_, parse_result.where_cond_info_.conds_,
+         where_cond_info_.cond_count_ * sizeof(ObProxyWhereCondNode));
 
   if (OB_UNLIKELY(is_sharding_request && NULL != parse_result.table_info_.table_name_.str_
                   && parse_result.table_info_.table_name_.str_len_ > 0)) {
@@ -1058,10 +1064,49 @@ int ObProxySqlParser::parse_sql(const ObString &sql,
   } else {
     ObProxyParser obproxy_parser(*allocator, parse_mode);
     ObProxyParseResult obproxy_parse_result;
+    // set var nodes of the result live in the fast parser
+    ObProxyFastParser fast_parser;
+    const int64_t cache_mem_limit = get_global_proxy_config().sql_parse_cache_mem_limited;
+    ObSqlParseCache *parse_cache = ObSqlParseCache::get_thread_cache();
+    int cache_ret = OB_NOT_SUPPORTED;
+    int fast_ret = OB_NOT_SUPPORTED;
 
     int tmp_ret = OB_SUCCESS;
-    if (OB_SUCCESS != (tmp_ret = obproxy_parser.parse(sql, obproxy_parse_result, connection_collation))) {
+    // sharding request needs the dbmesh info, which is kept by neither the fast parser nor the cache
+    if (get_global_proxy_config().enable_sql_fast_parse && !is_sharding_request) {
+      fast_ret = fast_parser.parse(sql, parse_mode, connection_collation, obproxy_parse_result);
+    }
+
+    if (OB_SUCCESS == fast_ret) {
+      // the scanner is cheaper than the cache lookup
+    } else if (cache_mem_limit > 0 && !is_sharding_request) {
+      if (OB_SUCCESS != (tmp_ret = ObSqlParseCache::get_or_create_thread_cache(parse_cache))) {
+        LOG_WARN("fail to get sql parse cache, will go on anyway", K(tmp_ret));
+        tmp_ret = OB_SUCCESS;
+      } else {
+        parse_cache->set_mem_limit(cache_mem_limit);
+        cache_ret = parse_cache->get(sql, parse_mode, connection_collation, obproxy_parse_result);
+      }
+    } else if (NULL != parse_cache) {
+      // skipped, but a changed limit still applies, the cache is dropped only when it is turned off
+      parse_cache->set_mem_limit(cache_mem_limit);
+    }
+
+    if (OB_SUCCESS == fast_ret) {
+      LOG_DEBUG("succ to get proxy parse result by fast parser", K(sql));
+    } else if (OB_SUCCESS == cache_ret) {
+      LOG_DEBUG("succ to get proxy parse result from cache", K(sql));
+    } else if (OB_SUCCESS != (tmp_ret = obproxy_parser.parse(sql, obproxy_parse_result, connection_collation))) {
       LOG_INFO("fail to parse sql, will go on anyway", K(sql), K(tmp_ret));
+    } else if (OB_ENTRY_NOT_EXIST == cache_ret) {
+      int put_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (put_ret = parse_cache->put(obproxy_parse_result))) {
+        LOG_DEBUG("proxy parse result is not cached", K(sql), K(put_ret));
+      }
+    }
+
+    if (OB_SUCCESS != tmp_ret) {
+      // go on anyway
     } else if (OB_SUCCESS != (tmp_ret = sql_parse_result.load_result(obproxy_parse_result,
                                                                      use_lower_case_name,
                                                                      drop_origin_db_table_name, is_sharding_request))) {
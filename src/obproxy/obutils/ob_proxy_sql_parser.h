@@ -647,6 +647,7 @@ struct ObSqlParseResult
   bool has_for_update() const { return has_for_update_; }
 
   bool is_simple_route_info_valid() const { return route_info_.is_valid(); }
+  const ObProxyWhereCondParseInfo &get_where_cond_info() const { return where_cond_info_; }
 
   bool has_show_errors() const { return is_show_errors_stmt(); }
   bool has_show_warnings() const { return is_show_warnings_stmt(); }
@@ -743,6 +744,7 @@ struct ObSqlParseResult
       cmd_info_ = other.cmd_info_;
       call_info_ = other.call_info_;
       route_info_ = other.route_info_;
+      where_cond_info_ = other.where_cond_info_;
       text_ps_info_ = other.text_ps_info_;
       has_last_insert_id_ = other.has_last_insert_id_;
       has_found_rows_ = other.has_found_rows_;
@@ -820,6 +822,8 @@ struct ObSqlParseResult
     cmd_info_ = other.cmd_info_;
     call_info_ = other.call_info_;
     route_info_ = other.route_info_;
+    // the escaped inner sql is parsed again by the expr parser
+    where_cond_info_.cond_count_ = 0;
     has_simple_route_info_ = other.has_simple_route_info_;
     hint_query_timeout_ = other.hint_query_timeout_;
     parsed_length_ = other.parsed_length_;
@@ -870,6 +874,7 @@ struct ObSqlParseResult
   ObProxyCmdInfo cmd_info_;
   ObProxyCallInfo call_info_;
   ObProxySimpleRouteInfo route_info_;
+  ObProxyWhereCondParseInfo where_cond_info_;
   ObProxyTextPsInfo text_ps_info_;
   oceanbase::common::ObArenaAllocator allocator_;
 private:
@@ -1005,6 +1010,7 @@ inline void ObSqlParseResult::reset(bool is_reset_origin_db_table /* true */)
   hint_consistency_level_ = common::INVALID_CONSISTENCY;
   hint_query_timeout_ = 0;
   parsed_length_ = 0;
+  where_cond_info_.cond_count_ = 0;
   table_name_.reset();
   package_name_.reset();
   database_name_.reset();
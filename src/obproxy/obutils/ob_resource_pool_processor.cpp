@@ -20,6 +20,8 @@
 #include "obutils/ob_metadb_create_cont.h"
 #include "proxy/route/ob_table_cache.h"
 #include "proxy/route/ob_route_utils.h"
+#include "proxy/route/ob_route_snapshot.h"
+#include "proxy/route/ob_partition_cache.h"
 #include "proxy/route/ob_cache_cleaner.h"
 #include "proxy/mysqllib/ob_session_field_mgr.h"
 #include "proxy/mysqllib/ob_proxy_auth_parser.h"
@@ -1262,9 +1264,20 @@ int ObClusterResourceCreateCont::handle_async_task_succ()
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("created_cr_ can not be null here", K(ret));
   } else {
-    CWLockGuard guard(rp_processor_.cr_map_rwlock_); // write lock need
-    created_cr_->set_avail_state();
-    created_cr_->renew_last_access_time(); // renew last access time when cr is successfully created
+    {
+      CWLockGuard guard(rp_processor_.cr_map_rwlock_); // write lock need
+      created_cr_->set_avail_state();
+      created_cr_->renew_last_access_time(); // renew last access time when cr is successfully created
+    }
+    // warm up the route caches before the waiting conts are informed
+    if (get_global_proxy_config().enable_route_snapshot) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = get_global_route_snapshot().restore(
+          cluster_name_, cluster_id_, created_cr_->version_,
+          get_global_table_cache(), get_global_partition_cache()))) {
+        LOG_WARN("fail to restore route cache from snapshot", K_(cluster_name), K_(cluster_id), K(tmp_ret));
+      }
+    }
   }
 
   if (OB_FAIL(handle_chain_inform_cont())) {
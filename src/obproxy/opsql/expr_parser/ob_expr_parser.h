@@ -18,9 +18,16 @@
 #include "opsql/expr_parser/ob_expr_parser_utils.h"
 #include "proxy/mysqllib/ob_proxy_mysql_request.h"
 #include "lib/string/ob_string.h"
+#include "opsql/ob_proxy_parse_scanner.h"
 
 extern "C" int ob_expr_parse_utf8_sql(ObExprParseResult *p, const char *pszSql, size_t iLen);
 extern "C" int ob_expr_parse_gbk_sql(ObExprParseResult *p, const char *pszSql, size_t iLen);
+extern "C" int ob_expr_parse_utf8_sql_init_scanner(void *malloc_pool, void **yyscanner);
+extern "C" int ob_expr_parse_gbk_sql_init_scanner(void *malloc_pool, void **yyscanner);
+extern "C" int ob_expr_parse_utf8_sql_with_scanner(ObExprParseResult *p, const char *pszSql, size_t iLen,
+                                                   void *yyscanner);
+extern "C" int ob_expr_parse_gbk_sql_with_scanner(ObExprParseResult *p, const char *pszSql, size_t iLen,
+                                                  void *yyscanner);
 
 namespace oceanbase
 {
@@ -48,9 +55,23 @@ public:
                    ObExprParseResult &parse_result, ObProxyBasicStmtType stmt_type,
                    common::ObCollationType connection_collation);
 
+  // the same result as parse_reqsql() of a select or delete, built from the where
+  // conditions kept by the first parse, OB_NOT_SUPPORTED if there is none
+  int parse_where_cond(const common::ObString &req_sql, const ObProxyWhereCondParseInfo &cond_info,
+                       ObExprParseResult &parse_result);
+
   void free_result(ObExprParseResult &parse_result);
 private:
   int init_result(ObExprParseResult &parse_result, const char *start_pos);
+  int add_where_cond(const common::ObString &req_sql, const ObProxyWhereCondNode &cond,
+                     ObExprParseResult &parse_result);
+  int alloc_token_list(const ObProxyTokenType type, ObProxyTokenList *&list);
+  static bool get_where_str(const common::ObString &req_sql, const int32_t offset,
+                            const int32_t len, ObProxyParseString &str);
+  static int64_t get_part_key_idx(const ObProxyParseString *db_name, const ObProxyParseString *table_name,
+                                  const ObProxyParseString &column_name, const ObExprParseResult &parse_result);
+  static void set_relation_level(const ObProxyParseString &column_name, const ObExprParseResult &parse_result,
+                                 ObProxyRelationExpr &relation);
   // data members
   common::ObIAllocator &allocator_;
   ObExprParseMode parse_mode_;
@@ -118,9 +139,12 @@ inline int ObExprParser::parse(const common::ObString &sql_string,
       //case 87/*CS_TYPE_GBK_BIN*/:
       case 248/*CS_TYPE_GB18030_CHINESE_CI*/:
       case 249/*CS_TYPE_GB18030_BIN*/:
-        if (common::OB_SUCCESS != ob_expr_parse_gbk_sql(&parse_result,
-                                                        sql_string.ptr(),
-                                                        static_cast<size_t>(sql_string.length()))) {
+        if (common::OB_SUCCESS != ob_expr_parse_gbk_sql_with_scanner(&parse_result,
+                                                                     sql_string.ptr(),
+                                                                     static_cast<size_t>(sql_string.length()),
+                                                                     ObProxyParseScanner::get_thread_scanner(
+                                                                         OBEXPR_GBK_SCANNER,
+                                                                         ob_expr_parse_gbk_sql_init_scanner))) {
           ret = common::OB_ERR_PARSE_SQL;
           PROXY_LOG(WARN, "failed to parser gbk sql", KERRMSGS, K(connection_collation), K(ret));
         }
@@ -128,9 +152,12 @@ inline int ObExprParser::parse(const common::ObString &sql_string,
       case 45/*CS_TYPE_UTF8MB4_GENERAL_CI*/:
       case 46/*CS_TYPE_UTF8MB4_BIN*/:
       default:
-        if (common::OB_SUCCESS != ob_expr_parse_utf8_sql(&parse_result,
-                                                         sql_string.ptr(),
-                                                         static_cast<size_t>(sql_string.length()))) {
+        if (common::OB_SUCCESS != ob_expr_parse_utf8_sql_with_scanner(&parse_result,
+                                                                      sql_string.ptr(),
+                                                                      static_cast<size_t>(sql_string.length()),
+                                                                      ObProxyParseScanner::get_thread_scanner(
+                                                                          OBEXPR_UTF8_SCANNER,
+                                                                          ob_expr_parse_utf8_sql_init_scanner))) {
           ret = common::OB_ERR_PARSE_SQL;
           PROXY_LOG(WARN, "failed to parser utf8 sql", KERRMSGS, K(connection_collation), K(ret));
         }
@@ -217,6 +244,236 @@ inline int ObExprParser::parse_reqsql(const common::ObString &req_sql, int64_t p
   return ret;
 }
 
+inline int ObExprParser::parse_where_cond(const common::ObString &req_sql,
+                                          const ObProxyWhereCondParseInfo &cond_info,
+                                          ObExprParseResult &expr_result)
+{
+  int ret = common::OB_SUCCESS;
+  if (SELECT_STMT_PARSE_MODE != parse_mode_
+      || cond_info.cond_count_ <= 0
+      || cond_info.cond_count_ > OBPROXY_MAX_WHERE_COND_NUM) {
+    ret = common::OB_NOT_SUPPORTED;
+  } else if (OB_FAIL(init_result(expr_result, req_sql.ptr()))) {
+    PROXY_LOG(WARN, "failed to initialized parser", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < cond_info.cond_count_; ++i) {
+      ret = add_where_cond(req_sql, cond_info.conds_[i], expr_result);
+    }
+    if (OB_SUCC(ret)) {
+      PROXY_LOG(DEBUG, "succ to build expr result from where cond",
+                "expr_result", ObExprParseResultPrintWrapper(expr_result));
+    }
+  }
+  return ret;
+}
+
+// bool_pri: expr comp expr, and check_and_add_relation() of cond_expr
+inline int ObExprParser::add_where_cond(const common::ObString &req_sql,
+                                        const ObProxyWhereCondNode &cond,
+                                        ObExprParseResult &expr_result)
+{
+  int ret = common::OB_SUCCESS;
+  ObProxyParseString db_name;
+  ObProxyParseString table_name;
+  ObProxyParseString column_name;
+  ObProxyTokenList *left_value = NULL;
+  ObProxyTokenList *right_value = NULL;
+  ObProxyFunctionType type = F_NONE;
+  switch (cond.comp_type_) {
+    case WHERE_COMP_EQ:
+      type = F_COMP_EQ;
+      break;
+    case WHERE_COMP_NSEQ:
+      type = F_COMP_NSEQ;
+      break;
+    case WHERE_COMP_GE:
+      type = F_COMP_GE;
+      break;
+    case WHERE_COMP_GT:
+      type = F_COMP_GT;
+      break;
+    case WHERE_COMP_LE:
+      type = F_COMP_LE;
+      break;
+    case WHERE_COMP_LT:
+      type = F_COMP_LT;
+      break;
+    case WHERE_COMP_NE:
+      type = F_COMP_NE;
+      break;
+    default:
+      break;
+  }
+
+  if (F_NONE == type
+      || !get_where_str(req_sql, cond.db_offset_, cond.db_len_, db_name)
+      || !get_where_str(req_sql, cond.table_offset_, cond.table_len_, table_name)
+      || !get_where_str(req_sql, cond.column_offset_, cond.column_len_, column_name)
+      || 0 == column_name.str_len_) {
+    ret = common::OB_NOT_SUPPORTED;
+  } else if (OB_FAIL(alloc_token_list(TOKEN_COLUMN, left_value))) {
+    PROXY_LOG(WARN, "fail to alloc column token", K(ret));
+  } else {
+    ObProxyTokenNode *column_node = left_value->head_;
+    column_node->column_name_ = column_name;
+    column_node->part_key_idx_ = get_part_key_idx(0 == db_name.str_len_ ? NULL : &db_name,
+                                                  0 == table_name.str_len_ ? NULL : &table_name,
+                                                  column_name, expr_result);
+    if (WHERE_VALUE_TYPE_INT == cond.value_type_) {
+      if (OB_SUCC(alloc_token_list(TOKEN_INT_VAL, right_value))) {
+        right_value->head_->int_value_ = cond.int_value_;
+      }
+    } else if (WHERE_VALUE_TYPE_STR == cond.value_type_) {
+      ObProxyParseString str_value;
+      if (!get_where_str(req_sql, cond.str_offset_, cond.str_len_, str_value)) {
+        ret = common::OB_NOT_SUPPORTED;
+      } else if (OB_SUCC(alloc_token_list(TOKEN_STR_VAL, right_value))) {
+        // the close quote is included, as the lexer does
+        str_value.end_ptr_ = str_value.str_ + str_value.str_len_ + 1;
+        right_value->head_->str_value_ = str_value;
+      }
+    } else if (WHERE_VALUE_TYPE_PLACE_HOLDER == cond.value_type_) {
+      if (OB_SUCC(alloc_token_list(TOKEN_PLACE_HOLDER, right_value))) {
+        right_value->head_->placeholder_idx_ = expr_result.placeholder_list_idx_++;
+      }
+    } else {
+      ret = common::OB_NOT_SUPPORTED;
+    }
+  }
+
+  if (OB_SUCC(ret) && F_COMP_NE != type) {
+    ObProxyRelationExpr *relation = NULL;
+    // add_relation()
+    if (expr_result.all_relation_info_.relation_num_ < OBPROXY_MAX_RELATION_NUM) {
+      if (OB_ISNULL(relation = static_cast<ObProxyRelationExpr *>(allocator_.alloc(sizeof(ObProxyRelationExpr))))) {
+        ret = common::OB_ALLOCATE_MEMORY_FAILED;
+        PROXY_LOG(WARN, "fail to alloc relation", K(ret));
+      } else {
+        relation = new (relation) ObProxyRelationExpr();
+        relation->left_value_ = left_value;
+        relation->right_value_ = right_value;
+        relation->type_ = type;
+        relation->level_ = PART_KEY_LEVEL_ZERO;
+        expr_result.all_relation_info_.relations_[expr_result.all_relation_info_.relation_num_++] = relation;
+      }
+    }
+    // get_relation() and check_and_add_relation()
+    if (OB_SUCC(ret) && left_value->column_node_->part_key_idx_ >= 0) {
+      if (OB_ISNULL(relation = static_cast<ObProxyRelationExpr *>(allocator_.alloc(sizeof(ObProxyRelationExpr))))) {
+        ret = common::OB_ALLOCATE_MEMORY_FAILED;
+        PROXY_LOG(WARN, "fail to alloc relation", K(ret));
+      } else {
+        relation = new (relation) ObProxyRelationExpr();
+        relation->column_idx_ = left_value->column_node_->part_key_idx_;
+        relation->left_value_ = left_value;
+        relation->right_value_ = right_value;
+        relation->type_ = type;
+        set_relation_level(column_name, expr_result, *relation);
+        if (PART_KEY_LEVEL_ZERO != relation->level_
+            && expr_result.relation_info_.relation_num_ < OBPROXY_MAX_RELATION_NUM) {
+          expr_result.relation_info_.relations_[expr_result.relation_info_.relation_num_++] = relation;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+inline int ObExprParser::alloc_token_list(const ObProxyTokenType type, ObProxyTokenList *&list)
+{
+  int ret = common::OB_SUCCESS;
+  ObProxyTokenNode *node = NULL;
+  if (OB_ISNULL(node = static_cast<ObProxyTokenNode *>(allocator_.alloc(sizeof(ObProxyTokenNode))))
+      || OB_ISNULL(list = static_cast<ObProxyTokenList *>(allocator_.alloc(sizeof(ObProxyTokenList))))) {
+    ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    PROXY_LOG(WARN, "fail to alloc token", K(ret));
+  } else {
+    node = new (node) ObProxyTokenNode();
+    node->type_ = type;
+    list = new (list) ObProxyTokenList();
+    list->column_node_ = (TOKEN_COLUMN == type ? node : NULL);
+    list->head_ = node;
+    list->tail_ = node;
+  }
+  return ret;
+}
+
+inline bool ObExprParser::get_where_str(const common::ObString &req_sql, const int32_t offset,
+                                        const int32_t len, ObProxyParseString &str)
+{
+  bool bret = false;
+  MEMSET(&str, 0, sizeof(str));
+  if (offset >= 0 && len >= 0 && offset + len <= req_sql.length()) {
+    str.str_ = const_cast<char *>(req_sql.ptr()) + offset;
+    str.str_len_ = len;
+    str.end_ptr_ = str.str_ + len;
+    bret = true;
+  }
+  return bret;
+}
+
+inline bool is_equal_where_str(const ObProxyParseString &l, const ObProxyParseString &r)
+{
+  return l.str_len_ == r.str_len_ && 0 == strncasecmp(l.str_, r.str_, l.str_len_);
+}
+
+// get_part_key_idx() of the grammar
+inline int64_t ObExprParser::get_part_key_idx(const ObProxyParseString *db_name,
+                                              const ObProxyParseString *table_name,
+                                              const ObProxyParseString &column_name,
+                                              const ObExprParseResult &expr_result)
+{
+  int64_t part_key_idx = IDX_NO_PART_KEY_COLUMN;
+  const ObProxyTableInfo &table_info = expr_result.table_info_;
+  if (expr_result.part_key_info_.key_num_ <= 0) {
+    // no part key
+  } else if (NULL != db_name && !is_equal_where_str(*db_name, table_info.database_name_)) {
+    // other db
+  } else if (NULL != table_name
+             && !is_equal_where_str(*table_name, table_info.table_name_)
+             && !is_equal_where_str(*table_name, table_info.alias_name_)) {
+    // other table
+  } else {
+    for (int64_t i = 0; i < expr_result.part_key_info_.key_num_ && part_key_idx < 0; ++i) {
+      if (is_equal_where_str(column_name, expr_result.part_key_info_.part_keys_[i].name_)) {
+        part_key_idx = i;
+      }
+    }
+  }
+  return part_key_idx;
+}
+
+// set_relation_part_with_column_name() of the grammar, rowid is never kept by the first parse
+inline void ObExprParser::set_relation_level(const ObProxyParseString &column_name,
+                                             const ObExprParseResult &expr_result,
+                                             ObProxyRelationExpr &relation)
+{
+  bool is_level_one = false;
+  bool is_level_two = false;
+  relation.level_ = PART_KEY_LEVEL_ZERO;
+  relation.first_part_column_idx_ = 0;
+  relation.second_part_column_idx_ = 0;
+  for (int64_t i = 0; i < expr_result.part_key_info_.key_num_; ++i) {
+    const ObProxyPartKey &part_key = expr_result.part_key_info_.part_keys_[i];
+    if (is_equal_where_str(part_key.name_, column_name)) {
+      if (PART_KEY_LEVEL_ONE == part_key.level_) {
+        is_level_one = true;
+        relation.first_part_column_idx_ = part_key.idx_in_part_columns_;
+      } else if (PART_KEY_LEVEL_TWO == part_key.level_) {
+        is_level_two = true;
+        relation.second_part_column_idx_ = part_key.idx_in_part_columns_;
+      }
+    }
+  }
+  if (is_level_one && is_level_two) {
+    relation.level_ = PART_KEY_LEVEL_BOTH;
+  } else if (is_level_one) {
+    relation.level_ = PART_KEY_LEVEL_ONE;
+  } else if (is_level_two) {
+    relation.level_ = PART_KEY_LEVEL_TWO;
+  }
+}
+
 } // end of namespace opsql
 } // end of namespace obproxy
 } // end of namespace oceanbase
@@ -16,8 +16,12 @@
 #include "common/ob_sql_mode.h"
 #include "lib/string/ob_string.h"
 #include "opsql/func_expr_parser/ob_func_expr_parse_result.h"
+#include "opsql/ob_proxy_parse_scanner.h"
 
 extern "C" int ob_func_expr_parse_sql(ObFuncExprParseResult *p, const char *pszSql, size_t iLen);
+extern "C" int ob_func_expr_parse_sql_init_scanner(void *malloc_pool, void **yyscanner);
+extern "C" int ob_func_expr_parse_sql_with_scanner(ObFuncExprParseResult *p, const char *pszSql, size_t iLen,
+                                                   void *yyscanner);
 
 namespace oceanbase
 {
@@ -85,9 +89,12 @@ inline int ObFuncExprParser::parse(const common::ObString &sql_string,
   if (common::OB_SUCCESS != init_result(parse_result, sql_string.ptr())) {
     ret = common::OB_ERR_PARSER_INIT;
     PROXY_LOG(WARN, "fail to initialized parser", KERRMSGS, K(ret));
-  } else if (common::OB_SUCCESS != ob_func_expr_parse_sql(&parse_result,
-                                                          sql_string.ptr(),
-                                                          static_cast<size_t>(sql_string.length()))) {
+  } else if (common::OB_SUCCESS != ob_func_expr_parse_sql_with_scanner(&parse_result,
+                                                                       sql_string.ptr(),
+                                                                       static_cast<size_t>(sql_string.length()),
+                                                                       ObProxyParseScanner::get_thread_scanner(
+                                                                           OBFUNCEXPR_SCANNER,
+                                                                           ob_func_expr_parse_sql_init_scanner))) {
     ret = common::OB_ERR_PARSE_SQL;
     PROXY_LOG(INFO, "ob_func_expr_parse_sql failed", K(ret), K(sql_string));
   }
@@ -2536,6 +2536,42 @@ inline void obfuncexprfree(void *ptr,void *yyscanner)
   obproxy_parse_free(ptr);
 }
 
+/* point the scanner made by ob_func_expr_parse_sql_init_scanner() to a copy of a new statement,
+ * so that it needs not be created again */
+int obfuncexpr_reset_bytes(const char *bytes, size_t len, ObFuncExprParseResult *p, void *yyscanner)
+{
+  int ret = OB_SUCCESS;
+  char *buf = NULL;
+  struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+  if (OB_ISNULL(yyg) || OB_ISNULL(bytes) || OB_ISNULL(p) || OB_ISNULL(YY_CURRENT_BUFFER)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_ISNULL(buf = (char *)obproxy_parse_malloc(len + 2, p->malloc_pool_))) {
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+    memcpy(buf, bytes, len);
+    buf[len] = buf[len + 1] = YY_END_OF_BUFFER_CHAR;
+    b->yy_buf_size = len;
+    b->yy_buf_pos = b->yy_ch_buf = buf;
+    b->yy_is_our_buffer = 0;
+    b->yy_input_file = 0;
+    b->yy_n_chars = b->yy_buf_size;
+    b->yy_is_interactive = 0;
+    b->yy_at_bol = 1;
+    b->yy_fill_buffer = 0;
+    b->yy_buffer_status = YY_BUFFER_NEW;
+    obfuncexprset_extra(p, yyscanner);
+    // the start condition stack of the last statement was allocated from its malloc pool
+    yyg->yy_start_stack_ptr = 0;
+    yyg->yy_start_stack_depth = 0;
+    yyg->yy_start_stack = NULL;
+    BEGIN(INITIAL);
+    obfuncexpr_load_buffer_state(yyscanner);
+    yyg->yy_did_buffer_switch_on_eof = 1;
+  }
+  return ret;
+}
+
 inline void store_func_expr_str(char* str, int64_t str_len, char*end_ptr, void *yyscanner)
 {
   YYSTYPE *lval = obfuncexprget_lval(yyscanner);
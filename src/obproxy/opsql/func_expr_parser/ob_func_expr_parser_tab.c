@@ -198,6 +198,7 @@ typedef struct OBFUNCEXPRLTYPE
 #define YYLEX_PARAM result->yyscan_info_
 extern void yyerror(YYLTYPE* yylloc, ObFuncExprParseResult* p, char* s,...);
 extern void *obproxy_parse_malloc(const size_t nbyte, void *malloc_pool);
+extern int obfuncexpr_reset_bytes(const char *bytes, size_t size, ObFuncExprParseResult *p, void *yyscanner);
 
 static inline void add_param_node(ObProxyParamNodeList *list, ObFuncExprParseResult *result,
                                   ObProxyParamNode *node)
@@ -1928,3 +1929,61 @@ int ob_func_expr_parse_sql(ObFuncExprParseResult* p, const char* buf, size_t len
   return ret;
 }
 
+/* the scanner is allocated from malloc_pool, which must live as long as it,
+ * and is reused by ob_func_expr_parse_sql_with_scanner() for every statement */
+int ob_func_expr_parse_sql_init_scanner(void *malloc_pool, void **yyscanner)
+{
+  int ret = OB_SUCCESS;
+  ObFuncExprParseResult p;
+  char empty_buf[2] = {'\0', '\0'};
+  if (OB_ISNULL(malloc_pool) || OB_ISNULL(yyscanner)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    memset(&p, 0, sizeof(p));
+    p.malloc_pool_ = malloc_pool;
+    if (OB_FAIL(obfuncexprlex_init_extra(&p, yyscanner))) {
+      // print err msg later
+    } else {
+      int val = setjmp(p.jmp_buf_);
+      if (val) {
+        ret = OB_PARSER_ERR_PARSE_SQL;
+      } else if (OB_ISNULL(obfuncexpr_scan_buffer(empty_buf, 2, *yyscanner))) {
+        ret = OB_INVALID_ARGUMENT;
+      } else {
+        // the parse result of each statement is set as the extra later
+        obfuncexprset_extra(NULL, *yyscanner);
+      }
+    }
+    if (OB_SUCCESS != ret) {
+      *yyscanner = NULL;
+    }
+  }
+
+  return ret;
+}
+
+int ob_func_expr_parse_sql_with_scanner(ObFuncExprParseResult* p, const char* buf, size_t len, void *yyscanner)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(yyscanner)) {
+    ret = ob_func_expr_parse_sql(p, buf, len);
+  } else if (OB_ISNULL(p) || OB_ISNULL(buf) || OB_UNLIKELY(len <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    // print err msg later
+  } else if (OB_FAIL(obfuncexpr_reset_bytes(buf, len, p, yyscanner))) {
+    // print err msg later
+  } else {
+    p->yyscan_info_ = yyscanner;
+    int val = setjmp(p->jmp_buf_);
+    if (val) {
+      ret = OB_PARSER_ERR_PARSE_SQL;
+    } else if (OB_FAIL(obfuncexprparse(p))) {
+      // print err msg later
+    } else {
+      // do nothing
+    }
+  }
+
+  return ret;
+}
+
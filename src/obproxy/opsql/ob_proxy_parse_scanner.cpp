@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include "opsql/ob_proxy_parse_scanner.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace opsql
+{
+__thread ObProxyParseScanner *ObProxyParseScanner::thread_scanner_ = NULL;
+
+ObProxyParseScanner::ObProxyParseScanner()
+  : allocator_(ObModIds::OB_PROXY_SQL_PARSE)
+{
+  MEMSET(scanners_, 0, sizeof(scanners_));
+}
+
+void *ObProxyParseScanner::get_thread_scanner(const ObProxyScannerType type,
+                                              ObProxyScannerInitFunc init_func)
+{
+  int ret = OB_SUCCESS;
+  void *scanner = NULL;
+  if (OB_UNLIKELY(type < OBPROXY_UTF8_SCANNER || type >= OBPROXY_MAX_SCANNER) || OB_ISNULL(init_func)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(type), K(ret));
+  } else if (OB_UNLIKELY(NULL == thread_scanner_)
+             && OB_ISNULL(thread_scanner_ = new (std::nothrow) ObProxyParseScanner())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc parse scanner", K(ret));
+  } else if (OB_LIKELY(NULL != (scanner = thread_scanner_->scanners_[type]))) {
+    // reuse it
+  } else if (OB_FAIL(init_func(static_cast<void *>(&thread_scanner_->allocator_), &scanner))) {
+    LOG_WARN("fail to init parse scanner", K(type), K(ret));
+    scanner = NULL;
+  } else {
+    thread_scanner_->scanners_[type] = scanner;
+  }
+  return scanner;
+}
+
+} // end of namespace opsql
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * **************************************************************
+ *
+ * Per thread flex scanners of the proxy, expr and func expr parsers:
+ * (1). A scanner is created by xxx_parse_sql_init_scanner() of its parser at
+ *      the first statement of the thread, from the allocator of this object.
+ * (2). Later statements only point the scanner to the new sql in
+ *      xxx_parse_sql_with_scanner(), yylex_init_extra() and yy_scan_buffer()
+ *      are not called and nothing is allocated from the parse allocator for it.
+ * (3). The bison parsers are pure, their stacks live on the C stack already.
+ * (4). It is not thread safe, every thread uses its own one.
+ */
+
+#ifndef OBPROXY_PARSE_SCANNER_H
+#define OBPROXY_PARSE_SCANNER_H
+
+#include "lib/ob_define.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace opsql
+{
+enum ObProxyScannerType
+{
+  OBPROXY_UTF8_SCANNER = 0,
+  OBPROXY_GBK_SCANNER,
+  OBEXPR_UTF8_SCANNER,
+  OBEXPR_GBK_SCANNER,
+  OBFUNCEXPR_SCANNER,
+  OBPROXY_MAX_SCANNER
+};
+
+// xxx_parse_sql_init_scanner() of the parser
+typedef int (*ObProxyScannerInitFunc)(void *malloc_pool, void **yyscanner);
+
+class ObProxyParseScanner
+{
+public:
+  // NULL if the scanner can not be created, the parser creates a new one
+  // for this statement then, as it did before
+  static void *get_thread_scanner(const ObProxyScannerType type, ObProxyScannerInitFunc init_func);
+
+private:
+  ObProxyParseScanner();
+  ~ObProxyParseScanner() {}
+
+  static __thread ObProxyParseScanner *thread_scanner_;
+
+  common::ObArenaAllocator allocator_; // memory of the scanners, never reused
+  void *scanners_[OBPROXY_MAX_SCANNER];
+
+  DISALLOW_COPY_AND_ASSIGN(ObProxyParseScanner);
+};
+
+} // end of namespace opsql
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_PARSE_SCANNER_H
@@ -0,0 +1,1236 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include "opsql/parser/ob_proxy_fast_parser.h"
+#include <strings.h>
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace opsql
+{
+
+static inline bool is_space(const char c)
+{
+  return ' ' == c || '\t' == c || '\n' == c || '\r' == c || '\f' == c;
+}
+
+static inline bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static inline bool is_ident_char(const char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || is_digit(c) || '$' == c || '_' == c;
+}
+
+// '#' is an identifier char of the lexer as well as a comment begin, and
+// multi byte chars depend on the connection charset, both are left to bison
+static inline bool is_unsupported_char(const char c)
+{
+  return '#' == c || '\0' == c || static_cast<unsigned char>(c) >= 0x80;
+}
+
+static inline bool is_word(const char *str, const int64_t len, const char *word, const int64_t word_len)
+{
+  return len == word_len && 0 == strncasecmp(str, word, word_len);
+}
+
+static inline bool has_prefix(const char *str, const char *end, const char *prefix, const int64_t prefix_len)
+{
+  return end - str >= prefix_len && 0 == strncasecmp(str, prefix, prefix_len);
+}
+
+// the first position of c1 or c2 in [pos, end), end if none,
+// literals and comments are skipped 16 bytes a time
+static inline const char *find_char(const char *pos, const char *end, const char c1, const char c2)
+{
+#if defined(__x86_64__)
+  const __m128i v1 = _mm_set1_epi8(c1);
+  const __m128i v2 = _mm_set1_epi8(c2);
+  while (pos + 16 <= end) {
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+    const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, v1), _mm_cmpeq_epi8(data, v2)));
+    if (0 != mask) {
+      return pos + __builtin_ctz(mask);
+    }
+    pos += 16;
+  }
+#elif defined(__aarch64__)
+  const uint8x16_t v1 = vdupq_n_u8(static_cast<uint8_t>(c1));
+  const uint8x16_t v2 = vdupq_n_u8(static_cast<uint8_t>(c2));
+  while (pos + 16 <= end) {
+    const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(pos));
+    if (0 != vmaxvq_u8(vorrq_u8(vceqq_u8(data, v1), vceqq_u8(data, v2)))) {
+      break;
+    }
+    pos += 16;
+  }
+#endif
+  while (pos < end && c1 != *pos && c2 != *pos) {
+    ++pos;
+  }
+  return pos;
+}
+
+int ObProxyFastParser::parse(const ObString &sql, const ObProxyParseMode parse_mode,
+                             const ObCollationType connection_collation,
+                             ObProxyParseResult &parse_result)
+{
+  int ret = OB_SUCCESS;
+  // gb18030 has its own lexer, and ignored words are errors in trans parse mode
+  if (OB_UNLIKELY(NORMAL_PARSE_MODE != parse_mode)
+      || OB_UNLIKELY(CS_TYPE_GB18030_CHINESE_CI == connection_collation)
+      || OB_UNLIKELY(CS_TYPE_GB18030_BIN == connection_collation)
+      || OB_UNLIKELY(sql.length() <= PARSE_EXTRA_CHAR_NUM)
+      || OB_UNLIKELY('\0' != sql.ptr()[sql.length() - 1])
+      || OB_UNLIKELY('\0' != sql.ptr()[sql.length() - 2])) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    sql_ = sql.ptr();
+    end_ = sql_ + sql.length() - PARSE_EXTRA_CHAR_NUM;
+    pos_ = sql_;
+    result_ = &parse_result;
+    set_var_count_ = 0;
+    init_result(parse_result);
+    ret = parse_stmt();
+  }
+  return ret;
+}
+
+// the same as ObProxyParser::init_result(), but without malloc pool, nothing is allocated
+void ObProxyFastParser::init_result(ObProxyParseResult &parse_result) const
+{
+  memset(&parse_result, 0, sizeof(parse_result));
+  parse_result.parse_mode_ = NORMAL_PARSE_MODE;
+  parse_result.start_pos_ = sql_;
+  parse_result.read_consistency_type_ = OBPROXY_READ_CONSISTENCY_INVALID;
+  parse_result.cmd_info_.sub_type_ = OBPROXY_T_SUB_INVALID;
+  parse_result.cmd_info_.err_type_ = OBPROXY_T_ERR_INVALID;
+  for (int64_t i = 0; i < OBPROXY_ICMD_MAX_VALUE_COUNT; ++i) {
+    parse_result.cmd_info_.integer_[i] = -1;
+  }
+}
+
+int ObProxyFastParser::parse_stmt()
+{
+  int ret = OB_SUCCESS;
+  const char *word_end = NULL;
+  // a leading c comment begins the comment grammar
+  if (OB_FAIL(skip_space(false))) {
+  } else if (OB_FAIL(scan_word(word_end))) {
+  } else {
+    const char *word = pos_;
+    const int64_t len = word_end - word;
+    pos_ = word_end;
+    if (is_word(word, len, "select", 6)) {
+      ret = parse_expr_stmt(OBPROXY_T_SELECT);
+    } else if (is_word(word, len, "delete", 6)) {
+      ret = parse_expr_stmt(OBPROXY_T_DELETE);
+    } else if (is_word(word, len, "update", 6)) {
+      ret = parse_table_stmt(OBPROXY_T_UPDATE);
+    } else if (is_word(word, len, "insert", 6)) {
+      ret = parse_table_stmt(OBPROXY_T_INSERT);
+    } else if (is_word(word, len, "replace", 7)) {
+      ret = parse_table_stmt(OBPROXY_T_REPLACE);
+    } else if (is_word(word, len, "begin", 5)) {
+      ret = parse_trans_stmt(OBPROXY_T_BEGIN);
+    } else if (is_word(word, len, "start", 5)) {
+      if (OB_FAIL(skip_space(false))) {
+      } else if (OB_FAIL(scan_word(word_end))) {
+      } else if (!is_word(pos_, word_end - pos_, "transaction", 11)) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        pos_ = word_end;
+        ret = parse_trans_stmt(OBPROXY_T_BEGIN);
+      }
+    } else if (is_word(word, len, "commit", 6)) {
+      ret = parse_trans_stmt(OBPROXY_T_COMMIT);
+    } else if (is_word(word, len, "rollback", 8)) {
+      ret = parse_trans_stmt(OBPROXY_T_ROLLBACK);
+    } else if (is_word(word, len, "set", 3)) {
+      ret = parse_set_stmt();
+    } else {
+      ret = OB_NOT_SUPPORTED;
+    }
+  }
+  return ret;
+}
+
+// select and delete push in_expr, the select list is skipped till FROM
+int ObProxyFastParser::parse_expr_stmt(const ObProxyBasicStmtType stmt_type)
+{
+  int ret = OB_SUCCESS;
+  bool has_from = false;
+  result_->cur_stmt_type_ = stmt_type;
+  if (OB_FAIL(check_head(stmt_type))) {
+  } else if (OB_FAIL(skip_expr(OBPROXY_T_SELECT == stmt_type, has_from))) {
+  } else if (has_from) {
+    ret = parse_table_stmt(stmt_type);
+  } else if (OBPROXY_T_SELECT != stmt_type) {
+    // delete without from
+    ret = OB_NOT_SUPPORTED;
+  } else if (OB_FAIL(parse_stmt_end(true))) {
+  } else {
+    handle_stmt_end(stmt_type, end_);
+  }
+  return ret;
+}
+
+// table_factor partition_factor, the same lookahead as bison is lexed
+int ObProxyFastParser::parse_table_stmt(const ObProxyBasicStmtType stmt_type)
+{
+  int ret = OB_SUCCESS;
+  ObFastToken token;
+  ObProxyTableInfo &table_info = result_->table_info_;
+  if (OBPROXY_T_SELECT != stmt_type && OBPROXY_T_DELETE != stmt_type) {
+    result_->cur_stmt_type_ = stmt_type;
+    ret = check_head(stmt_type);
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(next_token(token))) {
+  } else if (FAST_T_NAME != token.type_) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    table_info.table_name_ = token.str_;
+    if (OB_FAIL(next_token(token))) {
+    } else if (FAST_T_DOT == token.type_) {
+      table_info.database_name_ = table_info.table_name_;
+      if (OB_FAIL(next_token(token))) {
+      } else if (FAST_T_NAME != token.type_) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        table_info.table_name_ = token.str_;
+        ret = next_token(token);
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    bool has_alias = false;
+    if (FAST_T_AS == token.type_) {
+      if (OB_FAIL(next_token(token))) {
+      } else if (FAST_T_NAME != token.type_) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        has_alias = true;
+      }
+    } else if (FAST_T_NAME == token.type_) {
+      has_alias = true;
+    }
+    if (OB_SUCC(ret) && has_alias) {
+      // the same as UPDATE_ALIAS_NAME of the grammar
+      if (OBPROXY_T_SELECT == stmt_type || OBPROXY_T_UPDATE == stmt_type
+          || OBPROXY_T_INSERT == stmt_type) {
+        table_info.alias_name_ = token.str_;
+      }
+      ret = next_token(token);
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (FAST_T_PARTITION == token.type_) {
+    // brackets are ignored words but for insert, and nothing is lexed after it
+    if (OBPROXY_T_INSERT == stmt_type) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (OB_FAIL(next_token(token))) {
+    } else if (FAST_T_NAME != token.type_) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      result_->part_name_ = token.str_;
+    }
+  } else if (OBPROXY_T_INSERT == stmt_type && FAST_T_LEFT_BRACKET == token.type_) {
+    // '(' column_list ')' must be followed by a select, any other token is
+    // a syntax error, which is accepted with what has been parsed
+    bool is_end = false;
+    while (OB_SUCC(ret) && !is_end) {
+      if (OB_FAIL(next_token(token))) {
+      } else if (FAST_T_NAME != token.type_) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (OB_FAIL(next_token(token))) {
+      } else if (FAST_T_RIGHT_BRACKET == token.type_) {
+        is_end = true;
+      } else if (FAST_T_COMMA != token.type_) {
+        ret = OB_NOT_SUPPORTED;
+      }
+    }
+    if (OB_SUCC(ret) && OB_SUCC(next_token(token))) {
+      result_->has_ignored_word_ = true;
+    }
+  } else if (OBPROXY_T_INSERT == stmt_type
+             && FAST_T_END != token.type_ && FAST_T_SEMICOLON != token.type_) {
+    // insert_stmt is reduced only before the end, others are syntax errors
+    result_->has_ignored_word_ = true;
+  }
+
+  if (OB_SUCC(ret)) {
+    const char *end_pos = NULL;
+    if (result_->part_name_.str_len_ > 0) {
+      end_pos = result_->part_name_.end_ptr_;
+    } else if (table_info.alias_name_.str_len_ > 0) {
+      end_pos = table_info.alias_name_.end_ptr_;
+    } else {
+      end_pos = table_info.table_name_.end_ptr_;
+    }
+    handle_stmt_end(stmt_type, end_pos);
+    if ((OBPROXY_T_SELECT == stmt_type || OBPROXY_T_DELETE == stmt_type)
+        && 0 == result_->part_name_.str_len_
+        && OB_SUCCESS != parse_where_cond(end_pos)) {
+      // left to the expr parser
+      result_->where_cond_info_.cond_count_ = 0;
+    }
+  }
+  return ret;
+}
+
+// begin and start transaction are lexed before the stmt type is known,
+// so a c comment after them is the comment grammar, commit and rollback
+// are ignored words, which make a syntax error accepted as the stmt
+int ObProxyFastParser::parse_trans_stmt(const ObProxyBasicStmtType stmt_type)
+{
+  int ret = OB_SUCCESS;
+  const bool is_begin = (OBPROXY_T_BEGIN == stmt_type);
+  if (!is_begin) {
+    result_->cur_stmt_type_ = stmt_type;
+    result_->has_ignored_word_ = true;
+  }
+  if (OB_SUCC(parse_stmt_end(!is_begin))) {
+    handle_stmt_end(stmt_type, end_);
+  }
+  return ret;
+}
+
+int ObProxyFastParser::parse_set_stmt()
+{
+  int ret = OB_SUCCESS;
+  ObFastToken token;
+  bool is_end = false;
+  result_->cur_stmt_type_ = OBPROXY_T_SET;
+  ret = check_head(OBPROXY_T_SET);
+  while (OB_SUCC(ret) && !is_end) {
+    ObProxySetVarType var_type = SET_VAR_SYS;
+    if (OB_FAIL(next_set_token(token))) {
+    } else if (FAST_T_AT == token.type_) {
+      if (OB_FAIL(next_set_token(token))) {
+      } else if (FAST_T_AT != token.type_) {
+        var_type = SET_VAR_USER;
+      } else if (OB_FAIL(next_set_token(token))) {
+      } else if (FAST_T_GLOBAL == token.type_ || FAST_T_SESSION == token.type_) {
+        ret = next_set_token(token);
+      }
+    } else if (FAST_T_GLOBAL == token.type_ || FAST_T_SESSION == token.type_) {
+      ret = next_set_token(token);
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (FAST_T_NAME != token.type_ || set_var_count_ >= MAX_SET_VAR_COUNT) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      ObProxySetVarNode &node = set_var_nodes_[set_var_count_];
+      memset(&node, 0, sizeof(node));
+      node.name_ = token.str_;
+      node.type_ = var_type;
+      if (OB_FAIL(next_set_token(token))) {
+      } else if (FAST_T_EQUAL != token.type_) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (OB_FAIL(next_set_token(token))) {
+      } else if (FAST_T_NAME == token.type_) {
+        node.value_type_ = SET_VALUE_TYPE_STR;
+        node.str_value_ = token.str_;
+      } else if (FAST_T_INT == token.type_) {
+        node.value_type_ = SET_VALUE_TYPE_INT;
+        node.int_value_ = token.int_value_;
+      } else {
+        ret = OB_NOT_SUPPORTED;
+      }
+
+      if (OB_SUCC(ret)) {
+        ObProxySetParseInfo &set_info = result_->set_parse_info_;
+        if (NULL != set_info.tail_) {
+          set_info.tail_->next_ = &node;
+        } else {
+          set_info.head_ = &node;
+        }
+        set_info.tail_ = &node;
+        ++set_info.node_count_;
+        ++set_var_count_;
+
+        // a c comment is an error in set_expr, but not after ';'
+        if (OB_FAIL(skip_space(false))) {
+        } else if (pos_ < end_ && ',' == *pos_) {
+          ++pos_;
+        } else if (pos_ < end_ && ';' != *pos_) {
+          ret = OB_NOT_SUPPORTED;
+        } else if (OB_SUCC(parse_stmt_end(true))) {
+          is_end = true;
+        }
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    handle_stmt_end(OBPROXY_T_SET, end_);
+  }
+  return ret;
+}
+
+// [';'] END_P, the end pos is where the lexer meets the end
+int ObProxyFastParser::parse_stmt_end(const bool allow_c_comment)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(skip_space(allow_c_comment))) {
+  } else if (pos_ < end_ && ';' == *pos_) {
+    ++pos_;
+    ret = skip_space(allow_c_comment);
+  }
+  if (OB_SUCC(ret) && pos_ < end_) {
+    // multi stmts
+    ret = OB_NOT_SUPPORTED;
+  }
+  return ret;
+}
+
+// handle_stmt_end() and HANDLE_ACCEPT() of the grammar
+void ObProxyFastParser::handle_stmt_end(const ObProxyBasicStmtType stmt_type, const char *end_pos)
+{
+  result_->stmt_type_ = stmt_type;
+  result_->cur_stmt_type_ = OBPROXY_T_INVALID;
+  result_->stmt_count_ = 1;
+  result_->end_pos_ = end_pos;
+}
+
+// select_root of the expr parser, which begins at the first JOIN or WHERE
+// after end_pos: WHERE cond_expr end_flag, with bool_pri of one column on
+// the left and one int, string or '?' on the right, joined by AND only
+int ObProxyFastParser::parse_where_cond(const char *end_pos)
+{
+  int ret = OB_SUCCESS;
+  ObProxyWhereCondParseInfo &cond_info = result_->where_cond_info_;
+  const char *word_end = NULL;
+  bool is_end = false;
+  pos_ = end_pos;
+  skip_where_space();
+  if (OB_FAIL(scan_word(word_end))) {
+  } else if (!is_word(pos_, word_end - pos_, "where", 5)) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    pos_ = word_end;
+  }
+  while (OB_SUCC(ret) && !is_end) {
+    if (cond_info.cond_count_ >= OBPROXY_MAX_WHERE_COND_NUM) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      ObProxyWhereCondNode &cond = cond_info.conds_[cond_info.cond_count_];
+      if (OB_FAIL(scan_where_column(cond))) {
+      } else if (OB_FAIL(scan_where_comp(cond))) {
+      } else if (OB_FAIL(scan_where_value(cond))) {
+      } else {
+        ++cond_info.cond_count_;
+        skip_where_space();
+        if (pos_ >= end_ || ';' == *pos_) {
+          is_end = true;
+        } else if (OB_FAIL(scan_word(word_end))) {
+        } else {
+          const int64_t len = word_end - pos_;
+          if (is_word(pos_, len, "and", 3)) {
+            pos_ = word_end;
+          } else if (is_word(pos_, len, "for", 3) || is_word(pos_, len, "limit", 5)
+                     || is_word(pos_, len, "group", 5) || is_word(pos_, len, "having", 6)) {
+            // END_WHERE
+            is_end = true;
+          } else {
+            ret = OB_NOT_SUPPORTED;
+          }
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret) && has_join_word(end_pos)) {
+    ret = OB_NOT_SUPPORTED;
+  }
+  return ret;
+}
+
+// NAME_OB, NAME_OB '.' NAME_OB or NAME_OB '.' NAME_OB '.' NAME_OB
+int ObProxyFastParser::scan_where_column(ObProxyWhereCondNode &cond)
+{
+  int ret = OB_SUCCESS;
+  int32_t offsets[3] = {0, 0, 0};
+  int32_t lens[3] = {0, 0, 0};
+  int64_t count = 0;
+  bool is_end = false;
+  skip_where_space();
+  while (OB_SUCC(ret) && !is_end) {
+    if (count >= 3) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (OB_FAIL(scan_where_name(offsets[count], lens[count]))) {
+    } else {
+      ++count;
+      skip_where_space();
+      if (pos_ < end_ && '.' == *pos_) {
+        ++pos_;
+        skip_where_space();
+      } else {
+        is_end = true;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    cond.db_offset_ = (3 == count ? offsets[0] : 0);
+    cond.db_len_ = (3 == count ? lens[0] : 0);
+    cond.table_offset_ = (count >= 2 ? offsets[count - 2] : 0);
+    cond.table_len_ = (count >= 2 ? lens[count - 2] : 0);
+    cond.column_offset_ = offsets[count - 1];
+    cond.column_len_ = lens[count - 1];
+  }
+  return ret;
+}
+
+// {identifer} not beginning with a digit, or a back quoted one,
+// double quotes depend on the oracle mode and are left to the expr parser
+int ObProxyFastParser::scan_where_name(int32_t &offset, int32_t &len)
+{
+  int ret = OB_SUCCESS;
+  const char *word_end = NULL;
+  if (pos_ >= end_ || is_digit(*pos_)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if ('`' == *pos_) {
+    const char *pos = pos_ + 1;
+    while (pos < end_ && is_ident_char(*pos)) {
+      ++pos;
+    }
+    if (pos == pos_ + 1 || pos >= end_ || '`' != *pos || pos - pos_ - 1 >= OBPROXY_MAX_NAME_LENGTH) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      offset = static_cast<int32_t>(pos_ + 1 - sql_);
+      len = static_cast<int32_t>(pos - pos_ - 1);
+      pos_ = pos + 1;
+    }
+  } else if (OB_FAIL(scan_word(word_end))) {
+  } else if (is_expr_keyword(pos_, word_end - pos_)) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    offset = static_cast<int32_t>(pos_ - sql_);
+    len = static_cast<int32_t>(word_end - pos_);
+    pos_ = word_end;
+  }
+  return ret;
+}
+
+// comp, the longest operator is taken as the lexer does
+int ObProxyFastParser::scan_where_comp(ObProxyWhereCondNode &cond)
+{
+  int ret = OB_SUCCESS;
+  if (has_prefix(pos_, end_, "<=>", 3)) {
+    cond.comp_type_ = WHERE_COMP_NSEQ;
+    pos_ += 3;
+  } else if (has_prefix(pos_, end_, ">=", 2)) {
+    cond.comp_type_ = WHERE_COMP_GE;
+    pos_ += 2;
+  } else if (has_prefix(pos_, end_, "<=", 2)) {
+    cond.comp_type_ = WHERE_COMP_LE;
+    pos_ += 2;
+  } else if (has_prefix(pos_, end_, "!=", 2) || has_prefix(pos_, end_, "<>", 2)) {
+    cond.comp_type_ = WHERE_COMP_NE;
+    pos_ += 2;
+  } else if (has_prefix(pos_, end_, ">", 1)) {
+    cond.comp_type_ = WHERE_COMP_GT;
+    ++pos_;
+  } else if (has_prefix(pos_, end_, "<", 1)) {
+    cond.comp_type_ = WHERE_COMP_LT;
+    ++pos_;
+  } else if (has_prefix(pos_, end_, "=", 1)) {
+    cond.comp_type_ = WHERE_COMP_EQ;
+    ++pos_;
+  } else {
+    ret = OB_NOT_SUPPORTED;
+  }
+  return ret;
+}
+
+// {int_num}, a single quoted string without escape or doubled quote, or '?',
+// anything lexed right after it makes a token list and is not supported
+int ObProxyFastParser::scan_where_value(ObProxyWhereCondNode &cond)
+{
+  int ret = OB_SUCCESS;
+  skip_where_space();
+  if (pos_ >= end_) {
+    ret = OB_NOT_SUPPORTED;
+  } else if ('?' == *pos_) {
+    cond.value_type_ = WHERE_VALUE_TYPE_PLACE_HOLDER;
+    cond.int_value_ = 0;
+    ++pos_;
+  } else if ('\'' == *pos_) {
+    const char *pos = find_char(pos_ + 1, end_, '\'', '\\');
+    if (pos >= end_ || '\\' == *pos || NULL != memchr(pos_ + 1, '\0', pos - pos_ - 1)) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      cond.value_type_ = WHERE_VALUE_TYPE_STR;
+      cond.str_offset_ = static_cast<int32_t>(pos_ + 1 - sql_);
+      cond.str_len_ = static_cast<int32_t>(pos - pos_ - 1);
+      pos_ = pos + 1;
+    }
+  } else {
+    const char *pos = pos_;
+    bool is_negative = false;
+    if ('-' == *pos || '+' == *pos) {
+      is_negative = ('-' == *pos);
+      ++pos;
+    }
+    const char *digit_start = pos;
+    while (pos < end_ && is_digit(*pos)) {
+      ++pos;
+    }
+    if (pos == digit_start || pos - digit_start > 17
+        || (pos < end_ && ('.' == *pos || is_ident_char(*pos)))) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      int64_t value = 0;
+      for (const char *p = digit_start; p < pos; ++p) {
+        value = value * 10 + (*p - '0');
+      }
+      cond.value_type_ = WHERE_VALUE_TYPE_INT;
+      cond.int_value_ = (is_negative ? -value : value);
+      pos_ = pos;
+    }
+  }
+  return ret;
+}
+
+// the expr parser begins at JOIN instead if it is found anywhere after end_pos
+bool ObProxyFastParser::has_join_word(const char *pos) const
+{
+  bool bret = false;
+  while (!bret && pos < end_) {
+    pos = find_char(pos, end_, 'j', 'J');
+    if (has_prefix(pos, end_, "join", 4)) {
+      bret = true;
+    } else {
+      ++pos;
+    }
+  }
+  return bret;
+}
+
+// the longer lexer patterns beginning with the same keyword
+int ObProxyFastParser::check_head(const ObProxyBasicStmtType stmt_type) const
+{
+  int ret = OB_SUCCESS;
+  const char *pos = pos_;
+  while (pos < end_ && is_space(*pos)) {
+    ++pos;
+  }
+  if (has_prefix(pos, end_, "/*", 2)) {
+    // maybe a hint
+    ret = OB_NOT_SUPPORTED;
+  } else if (OBPROXY_T_SELECT == stmt_type) {
+    if ('@' == *pos
+        || has_prefix(pos, end_, "database", 8)
+        || has_prefix(pos, end_, "proxy_version", 13)) {
+      ret = OB_NOT_SUPPORTED;
+    }
+  } else if (OBPROXY_T_SET == stmt_type) {
+    if (has_prefix(pos, end_, "names", 5)
+        || has_prefix(pos, end_, "charset", 7)
+        || has_prefix(pos, end_, "character", 9)
+        || has_prefix(pos, end_, "password", 8)
+        || has_prefix(pos, end_, "default", 7)
+        || has_prefix(pos, end_, "ob_read_consistency", 19)
+        || has_prefix(pos, end_, "tx_read_only", 12)
+        || has_prefix(pos, end_, "@@ob_read_consistency", 21)
+        || has_prefix(pos, end_, "@@tx_read_only", 14)
+        || has_prefix(pos, end_, "@@session", 9)
+        || has_prefix(pos, end_, "@obproxy_route_addr", 19)) {
+      ret = OB_NOT_SUPPORTED;
+    }
+  }
+  return ret;
+}
+
+// in_expr, and the in_subquery/in_no_select_query it pushes on '(',
+// only FROM, '(', ')', ';' and the end are tokens there
+int ObProxyFastParser::skip_expr(const bool allow_bracket, bool &has_from)
+{
+  int ret = OB_SUCCESS;
+  int64_t depth = 0;
+  bool is_end = false;
+  has_from = false;
+  while (OB_SUCC(ret) && !is_end) {
+    if (OB_FAIL(skip_space(false))) {
+    } else if (pos_ >= end_) {
+      if (depth > 0) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        is_end = true;
+      }
+    } else {
+      const char c = *pos_;
+      const char *word_end = NULL;
+      if ('\'' == c || '"' == c) {
+        bool is_simple = false;
+        if (OB_SUCC(skip_quoted(is_simple))) {
+          result_->has_ignored_word_ = true;
+        }
+      } else if ('(' == c) {
+        if (!allow_bracket || depth >= MAX_BRACKET_DEPTH) {
+          ret = OB_NOT_SUPPORTED;
+        } else {
+          expr_states_[depth++] = FAST_S_SUBQUERY;
+          ++pos_;
+        }
+      } else if (is_unsupported_char(c)) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (0 == depth) {
+        if (';' == c) {
+          is_end = true;
+        } else if ('`' == c) {
+          if (OB_SUCC(skip_back_quoted())) {
+            result_->has_ignored_word_ = true;
+          }
+        } else if ('@' == c && pos_ + 1 < end_ && '@' == pos_[1]) {
+          // maybe @@tx_read_only
+          ret = OB_NOT_SUPPORTED;
+        } else if (!is_ident_char(c)) {
+          result_->has_ignored_word_ = true;
+          ++pos_;
+        } else if (OB_SUCC(scan_word(word_end))) {
+          const int64_t len = word_end - pos_;
+          if (is_word(pos_, len, "from", 4)) {
+            const char *pos = word_end;
+            while (pos < end_ && is_space(*pos)) {
+              ++pos;
+            }
+            if ('#' == *pos || has_prefix(pos, end_, "--", 2)) {
+              ret = OB_NOT_SUPPORTED;
+            } else if (pos > word_end && has_prefix(pos, end_, "dual", 4)) {
+              // "FROM"{whitespace}+"DUAL" is an ignored word
+              result_->is_dual_request_ = true;
+              result_->has_ignored_word_ = true;
+              word_end = pos + 4;
+            } else {
+              has_from = true;
+              is_end = true;
+            }
+          } else {
+            if (is_word(pos_, len, "found_rows", 10)) {
+              result_->has_found_rows_ = true;
+            } else if (is_word(pos_, len, "row_count", 9)) {
+              result_->has_row_count_ = true;
+            } else if (is_word(pos_, len, "last_insert_id", 14)) {
+              result_->has_last_insert_id_ = true;
+            }
+            result_->has_ignored_word_ = true;
+          }
+          pos_ = word_end;
+        }
+      } else if (FAST_S_SUBQUERY == expr_states_[depth - 1]) {
+        if (')' == c) {
+          --depth;
+          ++pos_;
+        } else if (has_prefix(pos_, end_, "select", 6)) {
+          ret = OB_NOT_SUPPORTED;
+        } else if (depth >= MAX_BRACKET_DEPTH) {
+          ret = OB_NOT_SUPPORTED;
+        } else {
+          // any other char
+          expr_states_[depth++] = FAST_S_NO_SELECT_QUERY;
+          result_->has_ignored_word_ = true;
+          ++pos_;
+        }
+      } else {
+        if (')' == c) {
+          // pops in_no_select_query and the in_subquery below it
+          depth -= 2;
+          ++pos_;
+        } else if (!is_ident_char(c)) {
+          result_->has_ignored_word_ = true;
+          ++pos_;
+        } else if (OB_SUCC(scan_word(word_end))) {
+          const int64_t len = word_end - pos_;
+          if (is_word(pos_, len, "found_rows", 10)) {
+            result_->has_found_rows_ = true;
+          } else if (is_word(pos_, len, "row_count", 9)) {
+            result_->has_row_count_ = true;
+          } else if (is_word(pos_, len, "last_insert_id", 14)) {
+            result_->has_last_insert_id_ = true;
+          }
+          result_->has_ignored_word_ = true;
+          pos_ = word_end;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObProxyFastParser::next_token(ObFastToken &token)
+{
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+  while (OB_SUCC(ret) && !is_done) {
+    is_done = true;
+    if (OB_FAIL(skip_space(true))) {
+    } else if (pos_ >= end_) {
+      token.type_ = FAST_T_END;
+    } else {
+      const char c = *pos_;
+      const char *start = pos_;
+      if (is_digit(c)) {
+        // int_num or number
+        ret = OB_NOT_SUPPORTED;
+      } else if (is_ident_char(c)) {
+        const char *word_end = NULL;
+        if (OB_SUCC(scan_word(word_end))) {
+          const int64_t len = word_end - start;
+          pos_ = word_end;
+          token.type_ = get_keyword_type(start, len);
+          if (FAST_T_NAME == token.type_) {
+            set_token_str(token, start, len, word_end, OBPROXY_QUOTE_T_INVALID);
+          } else if (FAST_T_IGNORED == token.type_) {
+            result_->has_ignored_word_ = true;
+            is_done = false;
+          } else if (FAST_T_UNSUPPORTED == token.type_) {
+            ret = OB_NOT_SUPPORTED;
+          }
+        }
+      } else if ('`' == c || '"' == c || '\'' == c) {
+        // only {quote}{identifer}{quote} is a name, others are strings
+        const char *pos = pos_ + 1;
+        while (pos < end_ && is_ident_char(*pos)) {
+          ++pos;
+        }
+        if (pos == pos_ + 1 || pos >= end_ || c != *pos) {
+          ret = OB_NOT_SUPPORTED;
+        } else {
+          const ObProxyParseQuoteType quote_type = ('`' == c ? OBPROXY_QUOTE_T_BACK
+              : ('"' == c ? OBPROXY_QUOTE_T_DOUBLE : OBPROXY_QUOTE_T_SINGLE));
+          token.type_ = FAST_T_NAME;
+          set_token_str(token, start + 1, pos - start - 1, pos + 1, quote_type);
+          pos_ = pos + 1;
+        }
+      } else if ('(' == c || ')' == c) {
+        ++pos_;
+        if (OBPROXY_T_INSERT == result_->cur_stmt_type_) {
+          token.type_ = ('(' == c ? FAST_T_LEFT_BRACKET : FAST_T_RIGHT_BRACKET);
+        } else {
+          result_->has_ignored_word_ = true;
+          is_done = false;
+        }
+      } else if ('.' == c) {
+        if (pos_ + 1 < end_ && is_digit(pos_[1])) {
+          ret = OB_NOT_SUPPORTED;
+        } else {
+          token.type_ = FAST_T_DOT;
+          ++pos_;
+        }
+      } else if (',' == c) {
+        token.type_ = FAST_T_COMMA;
+        ++pos_;
+      } else if (';' == c) {
+        token.type_ = FAST_T_SEMICOLON;
+        ++pos_;
+      } else if ('+' == c && pos_ + 1 < end_ && is_digit(pos_[1])) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (NULL != strchr("?*+&~|^/%:!@=", c)) {
+        token.type_ = FAST_T_OTHER;
+        ++pos_;
+      } else {
+        ret = OB_NOT_SUPPORTED;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObProxyFastParser::next_set_token(ObFastToken &token)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(skip_space(false))) {
+  } else if (pos_ >= end_) {
+    token.type_ = FAST_T_END;
+  } else {
+    const char c = *pos_;
+    const char *start = pos_;
+    if (is_digit(c) || (('-' == c || '+' == c) && pos_ + 1 < end_ && is_digit(pos_[1]))) {
+      ret = scan_number(token);
+    } else if (is_ident_char(c)) {
+      const char *word_end = NULL;
+      if (OB_SUCC(scan_word(word_end))) {
+        const int64_t len = word_end - start;
+        pos_ = word_end;
+        if (is_word(start, len, "global", 6)) {
+          token.type_ = FAST_T_GLOBAL;
+        } else if (is_word(start, len, "session", 7)) {
+          token.type_ = FAST_T_SESSION;
+        } else {
+          token.type_ = FAST_T_NAME;
+          set_token_str(token, start, len, word_end, OBPROXY_QUOTE_T_INVALID);
+        }
+      }
+    } else if ('\'' == c || '"' == c) {
+      // the string is kept in place only if nothing is escaped
+      bool is_simple = false;
+      if (OB_FAIL(skip_quoted(is_simple))) {
+      } else if (!is_simple) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        token.type_ = FAST_T_NAME;
+        set_token_str(token, start + 1, pos_ - start - 2, pos_,
+                      '"' == c ? OBPROXY_QUOTE_T_DOUBLE : OBPROXY_QUOTE_T_SINGLE);
+      }
+    } else if (',' == c) {
+      token.type_ = FAST_T_COMMA;
+      ++pos_;
+    } else if ('@' == c) {
+      token.type_ = FAST_T_AT;
+      ++pos_;
+    } else if ('=' == c) {
+      token.type_ = FAST_T_EQUAL;
+      ++pos_;
+    } else if (';' == c) {
+      token.type_ = FAST_T_SEMICOLON;
+      ++pos_;
+    } else {
+      ret = OB_NOT_SUPPORTED;
+    }
+  }
+  return ret;
+}
+
+// {int_num} of at most 17 digits, or an identifier beginning with digits,
+// decimals and exponents are left to bison
+int ObProxyFastParser::scan_number(ObFastToken &token)
+{
+  int ret = OB_SUCCESS;
+  const char *start = pos_;
+  const char *pos = pos_;
+  bool is_negative = false;
+  bool has_sign = false;
+  if ('-' == *pos || '+' == *pos) {
+    is_negative = ('-' == *pos);
+    has_sign = true;
+    ++pos;
+  }
+  const char *digit_start = pos;
+  while (pos < end_ && is_digit(*pos)) {
+    ++pos;
+  }
+  const char next = (pos < end_ ? *pos : ' ');
+  if ('.' == next || 'e' == next || 'E' == next || is_unsupported_char(next)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (is_ident_char(next) || pos - digit_start > 17) {
+    // the identifier is longer, or as long as the number
+    const char *word_end = NULL;
+    if (has_sign) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (OB_SUCC(scan_word(word_end))) {
+      token.type_ = FAST_T_NAME;
+      set_token_str(token, start, word_end - start, word_end, OBPROXY_QUOTE_T_INVALID);
+      pos_ = word_end;
+    }
+  } else {
+    int64_t value = 0;
+    for (const char *p = digit_start; p < pos; ++p) {
+      value = value * 10 + (*p - '0');
+    }
+    token.type_ = FAST_T_INT;
+    token.int_value_ = (is_negative ? -value : value);
+    pos_ = pos;
+  }
+  return ret;
+}
+
+// {whitespace}, and c comments if allowed
+int ObProxyFastParser::skip_space(const bool allow_c_comment)
+{
+  int ret = OB_SUCCESS;
+  bool is_end = false;
+  while (OB_SUCC(ret) && !is_end && pos_ < end_) {
+    const char c = *pos_;
+    if (is_space(c)) {
+      ++pos_;
+    } else if ('-' == c && pos_ + 2 < end_ && '-' == pos_[1] && is_space(pos_[2])) {
+      // "--"{space}+{non_newline}*
+      pos_ += 2;
+      while (pos_ < end_ && is_space(*pos_)) {
+        ++pos_;
+      }
+      while (pos_ < end_ && '\n' != *pos_ && '\r' != *pos_) {
+        ++pos_;
+      }
+    } else if ('#' == c) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (allow_c_comment && '/' == c && pos_ + 1 < end_ && '*' == pos_[1]) {
+      const char *pos = pos_ + 2;
+      bool is_closed = false;
+      while (!is_closed && pos < end_) {
+        pos = find_char(pos, end_, '*', '*');
+        if (pos + 1 < end_ && '/' == pos[1]) {
+          is_closed = true;
+          pos_ = pos + 2;
+        } else {
+          ++pos;
+        }
+      }
+      if (!is_closed) {
+        ret = OB_NOT_SUPPORTED;
+      }
+    } else {
+      is_end = true;
+    }
+  }
+  return ret;
+}
+
+// comments of the where clause are left to the expr parser
+void ObProxyFastParser::skip_where_space()
+{
+  while (pos_ < end_ && is_space(*pos_)) {
+    ++pos_;
+  }
+}
+
+// sq and dq states, pos_ is on the open quote, and right after the close quote
+// on success, is_simple tells no escape, doubled quote or joined literal
+int ObProxyFastParser::skip_quoted(bool &is_simple)
+{
+  int ret = OB_SUCCESS;
+  const char quote = *pos_;
+  const char *pos = pos_ + 1;
+  bool is_closed = false;
+  is_simple = true;
+  while (OB_SUCC(ret) && !is_closed) {
+    pos = find_char(pos, end_, quote, '\\');
+    if (pos >= end_) {
+      ret = OB_NOT_SUPPORTED;
+    } else if ('\\' == *pos) {
+      // {qescape}
+      if (pos + 1 >= end_) {
+        ret = OB_NOT_SUPPORTED;
+      } else {
+        pos += 2;
+        is_simple = false;
+      }
+    } else if (pos + 1 < end_ && quote == pos[1]) {
+      // {sqdouble}
+      pos += 2;
+      is_simple = false;
+    } else if (pos + 1 < end_ && ('#' == pos[1] || '-' == pos[1])) {
+      // maybe {sqnewline} with a comment
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      const char *next = pos + 1;
+      while (next < end_ && is_space(*next)) {
+        ++next;
+      }
+      if (next > pos + 1 && next < end_ && quote == *next) {
+        // {sqnewline}
+        pos = next + 1;
+        is_simple = false;
+      } else {
+        is_closed = true;
+        pos_ = pos + 1;
+      }
+    }
+  }
+  return ret;
+}
+
+// bt_in_expr state, pos_ is on the open back quote
+int ObProxyFastParser::skip_back_quoted()
+{
+  int ret = OB_SUCCESS;
+  const char *pos = pos_ + 1;
+  bool is_closed = false;
+  while (OB_SUCC(ret) && !is_closed) {
+    pos = find_char(pos, end_, '`', '`');
+    if (pos >= end_) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (pos + 1 < end_ && '`' == pos[1]) {
+      pos += 2;
+    } else {
+      is_closed = true;
+      pos_ = pos + 1;
+    }
+  }
+  return ret;
+}
+
+// {identifer} beginning at pos_
+int ObProxyFastParser::scan_word(const char *&word_end) const
+{
+  int ret = OB_SUCCESS;
+  const char *pos = pos_;
+  while (pos < end_ && is_ident_char(*pos)) {
+    ++pos;
+  }
+  if (pos == pos_ || (pos < end_ && is_unsupported_char(*pos))) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    word_end = pos;
+  }
+  return ret;
+}
+
+// keywords of the INITIAL state of the lexer
+ObProxyFastParser::ObFastTokenType ObProxyFastParser::get_keyword_type(const char *word, const int64_t len) const
+{
+  struct ObFastKeyword
+  {
+    const char *word_;
+    int64_t len_;
+    ObFastTokenType type_;
+  };
+#define FAST_KEYWORD(word, type) { word, sizeof(word) - 1, type }
+  static const ObFastKeyword keywords[] = {
+    FAST_KEYWORD("as", FAST_T_AS),
+    FAST_KEYWORD("partition", FAST_T_PARTITION),
+    FAST_KEYWORD("from", FAST_T_FROM),
+    FAST_KEYWORD("set", FAST_T_KEYWORD),
+    FAST_KEYWORD("where", FAST_T_KEYWORD),
+    FAST_KEYWORD("values", FAST_T_KEYWORD),
+    FAST_KEYWORD("value", FAST_T_KEYWORD),
+    FAST_KEYWORD("group", FAST_T_KEYWORD),
+    FAST_KEYWORD("having", FAST_T_KEYWORD),
+    FAST_KEYWORD("order", FAST_T_KEYWORD),
+    FAST_KEYWORD("for", FAST_T_KEYWORD),
+    FAST_KEYWORD("union", FAST_T_KEYWORD),
+    FAST_KEYWORD("limit", FAST_T_KEYWORD),
+    FAST_KEYWORD("use", FAST_T_KEYWORD),
+    FAST_KEYWORD("all", FAST_T_KEYWORD),
+    FAST_KEYWORD("like", FAST_T_KEYWORD),
+    FAST_KEYWORD("ignore", FAST_T_IGNORED),
+    FAST_KEYWORD("into", FAST_T_IGNORED),
+    FAST_KEYWORD("low_priority", FAST_T_IGNORED),
+    FAST_KEYWORD("delayed", FAST_T_IGNORED),
+    FAST_KEYWORD("high_priority", FAST_T_IGNORED),
+    // keywords with side effect, or beginning a longer pattern
+    FAST_KEYWORD("select", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("delete", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("insert", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("update", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("replace", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("merge", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("show", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("xa", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("begin", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("start", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("commit", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("rollback", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("call", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("declare", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("when", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("create", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("drop", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("alter", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("truncate", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("rename", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("index", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("table", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("status", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("unique", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("using", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("prepare", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("execute", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("deallocate", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("grant", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("revoke", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("analyze", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("purge", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("comment", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("flashback", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("audit", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("noaudit", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("explain", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("desc", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("describe", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("read", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("with", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("binary", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("group_name", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("quick", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("count", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("warnings", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("errors", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("trace", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("transaction", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("only", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("consistent", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("snapshot", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("help", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("thread", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("connection", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("offset", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("attribute", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("variables", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("stat", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("routine", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("objpool", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("refresh", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("upgrade", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("idc", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("kill", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("query", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("found_rows", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("row_count", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("last_insert_id", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("ping", FAST_T_UNSUPPORTED),
+    FAST_KEYWORD("reset", FAST_T_UNSUPPORTED),
+  };
+#undef FAST_KEYWORD
+  ObFastTokenType type = FAST_T_NAME;
+  for (int64_t i = 0; FAST_T_NAME == type && i < static_cast<int64_t>(ARRAYSIZEOF(keywords)); ++i) {
+    if (is_word(word, len, keywords[i].word_, keywords[i].len_)) {
+      type = keywords[i].type_;
+    }
+  }
+  return type;
+}
+
+// keywords of the expr parser lexer, which are never a column
+bool ObProxyFastParser::is_expr_keyword(const char *word, const int64_t len) const
+{
+  static const char *keywords[] = {
+    "where", "as", "values", "value", "set", "for", "limit", "group", "having", "rowid",
+    "join", "on", "between", "and", "or", "in", "is", "null", "not", "sysdate",
+  };
+  bool bret = false;
+  for (int64_t i = 0; !bret && i < static_cast<int64_t>(ARRAYSIZEOF(keywords)); ++i) {
+    bret = is_word(word, len, keywords[i], static_cast<int64_t>(strlen(keywords[i])));
+  }
+  return bret;
+}
+
+void ObProxyFastParser::set_token_str(ObFastToken &token, const char *start, const int64_t len,
+                                      const char *end, const ObProxyParseQuoteType quote_type) const
+{
+  token.str_.str_ = const_cast<char *>(start);
+  token.str_.str_len_ = static_cast<int32_t>(len);
+  token.str_.end_ptr_ = const_cast<char *>(end);
+  token.str_.quote_type_ = quote_type;
+}
+
+} // end of namespace opsql
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * **************************************************************
+ *
+ * Hand-written scanner of the most common statement shapes, with the following functionality:
+ * (1). select ... from [db.]tb [[as] alias] [partition(p)] ...,
+ *      update/delete/insert/replace on one table,
+ *      begin, start transaction, commit, rollback,
+ *      set [@|@@|global|session]var = value, ...
+ * (2). The result is exactly what ObProxyParser::parse() gives, the scanner
+ *      follows the flex rules and bison reductions of these shapes step by step.
+ * (3). Anything it does not fully understand (hint, leading comment, subquery,
+ *      multi statements, '#', multi byte chars out of literals, unhandled
+ *      keywords ...) returns OB_NOT_SUPPORTED, the caller falls back to bison.
+ * (4). Nothing is allocated, all strings point into the sql and the set var
+ *      nodes live in this object, so it must outlive the parse result.
+ * (5). For select and delete, `where [[db.]tb.]col comp int|'str'|? [and ...]`
+ *      is kept in where_cond_info_ of the result, so that the expr parser
+ *      needs not lex the sql again for the partition key.
+ */
+
+#ifndef OBPROXY_FAST_PARSER_H
+#define OBPROXY_FAST_PARSER_H
+#include "lib/ob_define.h"
+#include "lib/string/ob_string.h"
+#include "lib/charset/ob_charset.h"
+#include "opsql/parser/ob_proxy_parse_result.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace opsql
+{
+class ObProxyFastParser
+{
+public:
+  static const int64_t PARSE_EXTRA_CHAR_NUM = 2;
+  static const int64_t MAX_SET_VAR_COUNT = 16;
+  static const int64_t MAX_BRACKET_DEPTH = 64;
+
+  ObProxyFastParser() : sql_(NULL), end_(NULL), pos_(NULL), result_(NULL), set_var_count_(0) {}
+  ~ObProxyFastParser() {}
+
+  // sql must end with two '\0' as ObProxyParser::parse() requires,
+  // OB_SUCCESS and parse_result filled if recognized,
+  // OB_NOT_SUPPORTED if the proxy parser is needed, parse_result is garbage then
+  int parse(const common::ObString &sql, const ObProxyParseMode parse_mode,
+            const common::ObCollationType connection_collation,
+            ObProxyParseResult &parse_result);
+
+private:
+  enum ObFastTokenType
+  {
+    FAST_T_END = 0,
+    FAST_T_NAME,
+    FAST_T_INT,
+    FAST_T_AS,
+    FAST_T_PARTITION,
+    FAST_T_FROM,
+    FAST_T_GLOBAL,
+    FAST_T_SESSION,
+    FAST_T_KEYWORD,       // keyword without side effect
+    FAST_T_IGNORED,       // keyword returned as ignored word
+    FAST_T_UNSUPPORTED,   // keyword that may change the result
+    FAST_T_LEFT_BRACKET,
+    FAST_T_RIGHT_BRACKET,
+    FAST_T_DOT,
+    FAST_T_COMMA,
+    FAST_T_SEMICOLON,
+    FAST_T_AT,
+    FAST_T_EQUAL,
+    FAST_T_OTHER,
+  };
+
+  struct ObFastToken
+  {
+    ObFastTokenType type_;
+    ObProxyParseString str_;
+    int64_t int_value_;
+  };
+
+  // the lexer states of the select list
+  enum ObFastExprState
+  {
+    FAST_S_SUBQUERY = 0,
+    FAST_S_NO_SELECT_QUERY,
+  };
+
+  void init_result(ObProxyParseResult &parse_result) const;
+  int parse_stmt();
+  int parse_expr_stmt(const ObProxyBasicStmtType stmt_type);
+  int parse_table_stmt(const ObProxyBasicStmtType stmt_type);
+  int parse_trans_stmt(const ObProxyBasicStmtType stmt_type);
+  int parse_set_stmt();
+  int parse_stmt_end(const bool allow_c_comment);
+  void handle_stmt_end(const ObProxyBasicStmtType stmt_type, const char *end_pos);
+
+  // what ObExprParser reduces from the sql after end_pos, OB_NOT_SUPPORTED
+  // if it is not a simple where clause, the stmt itself is parsed anyway
+  int parse_where_cond(const char *end_pos);
+  int scan_where_column(ObProxyWhereCondNode &cond);
+  int scan_where_name(int32_t &offset, int32_t &len);
+  int scan_where_comp(ObProxyWhereCondNode &cond);
+  int scan_where_value(ObProxyWhereCondNode &cond);
+  bool has_join_word(const char *pos) const;
+
+  // INITIAL state of the lexer, for the table factor
+  int next_token(ObFastToken &token);
+  // set_expr state of the lexer
+  int next_set_token(ObFastToken &token);
+  // in_expr state and the states it pushes, till FROM, ';' or the end
+  int skip_expr(const bool allow_bracket, bool &has_from);
+  int check_head(const ObProxyBasicStmtType stmt_type) const;
+
+  int skip_space(const bool allow_c_comment);
+  int skip_quoted(bool &is_simple);
+  int skip_back_quoted();
+  int scan_number(ObFastToken &token);
+  int scan_word(const char *&word_end) const;
+  ObFastTokenType get_keyword_type(const char *word, const int64_t len) const;
+  bool is_expr_keyword(const char *word, const int64_t len) const;
+  void skip_where_space();
+  void set_token_str(ObFastToken &token, const char *start, const int64_t len,
+                     const char *end, const ObProxyParseQuoteType quote_type) const;
+
+private:
+  const char *sql_;
+  const char *end_;  // the first '\0' of the two
+  const char *pos_;
+  ObProxyParseResult *result_;
+  int64_t set_var_count_;
+  ObFastExprState expr_states_[MAX_BRACKET_DEPTH];
+  ObProxySetVarNode set_var_nodes_[MAX_SET_VAR_COUNT];
+
+  DISALLOW_COPY_AND_ASSIGN(ObProxyFastParser);
+};
+
+} // end of namespace opsql
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_FAST_PARSER_H
@@ -28,6 +28,8 @@
 
 #define OBPROXY_MAX_DBP_SHARD_KEY_NUM 64
 
+#define OBPROXY_MAX_WHERE_COND_NUM 8
+
 typedef enum ObProxyBasicStmtType
 {
   OBPROXY_T_INVALID = 0,
@@ -305,6 +307,50 @@ typedef struct _ObProxySimpleRouteParseInfo
   ObProxyParseString part_key_;
 } ObProxySimpleRouteParseInfo;
 
+typedef enum _ObProxyWhereCompType
+{
+  WHERE_COMP_NONE = 0,
+  WHERE_COMP_EQ,
+  WHERE_COMP_NSEQ,
+  WHERE_COMP_GE,
+  WHERE_COMP_GT,
+  WHERE_COMP_LE,
+  WHERE_COMP_LT,
+  WHERE_COMP_NE,
+} ObProxyWhereCompType;
+
+typedef enum _ObProxyWhereValueType
+{
+  WHERE_VALUE_TYPE_NONE = 0,
+  WHERE_VALUE_TYPE_INT,
+  WHERE_VALUE_TYPE_STR,
+  WHERE_VALUE_TYPE_PLACE_HOLDER,
+} ObProxyWhereValueType;
+
+// [[db.]tb.]column comp value, positions are offsets from start_pos_,
+// so that they are still valid after the result is copied
+typedef struct _ObProxyWhereCondNode
+{
+  int32_t db_offset_;
+  int32_t db_len_;
+  int32_t table_offset_;
+  int32_t table_len_;
+  int32_t column_offset_;
+  int32_t column_len_;
+  int32_t str_offset_; // without quotes
+  int32_t str_len_;
+  int64_t int_value_;
+  ObProxyWhereCompType comp_type_;
+  ObProxyWhereValueType value_type_;
+} ObProxyWhereCondNode;
+
+// conditions joined by AND in the where clause, in the order of the sql
+typedef struct _ObProxyWhereCondParseInfo
+{
+  ObProxyWhereCondNode conds_[OBPROXY_MAX_WHERE_COND_NUM];
+  int64_t cond_count_;
+} ObProxyWhereCondParseInfo;
+
 typedef enum ObDbMeshTokenType
 {
   DBMESH_TOKEN_NONE = 0,
@@ -448,6 +494,8 @@ typedef struct _ObProxyParseResult
   ObProxyCallParseInfo call_parse_info_;
   //simple route info
   ObProxySimpleRouteParseInfo simple_route_info_;
+  // where clause of point queries, only filled by the fast parser
+  ObProxyWhereCondParseInfo where_cond_info_;
   // partiton(p1)
   ObProxyParseString part_name_;
   // text ps user variables
@@ -18,6 +18,7 @@
 #include "lib/string/ob_string.h"
 #include "utils/ob_proxy_lib.h"
 #include "lib/charset/ob_charset.h"
+#include "opsql/ob_proxy_parse_scanner.h"
 
 #include <ob_sql_parser.h>
 #include <parse_malloc.h>
@@ -25,6 +26,12 @@
 
 extern "C" int obproxy_parse_utf8_sql(ObProxyParseResult *p, const char *pszSql, size_t iLen);
 extern "C" int obproxy_parse_gbk_sql(ObProxyParseResult *p, const char *pszSql, size_t iLen);
+extern "C" int obproxy_parse_utf8_sql_init_scanner(void *malloc_pool, void **yyscanner);
+extern "C" int obproxy_parse_gbk_sql_init_scanner(void *malloc_pool, void **yyscanner);
+extern "C" int obproxy_parse_utf8_sql_with_scanner(ObProxyParseResult *p, const char *pszSql, size_t iLen,
+                                                   void *yyscanner);
+extern "C" int obproxy_parse_gbk_sql_with_scanner(ObProxyParseResult *p, const char *pszSql, size_t iLen,
+                                                  void *yyscanner);
 
 namespace oceanbase
 {
@@ -190,18 +197,24 @@ inline int ObProxyParser::parse(const common::ObString &sql_string,
       //case 87/*CS_TYPE_GBK_BIN*/:
       case 248/*CS_TYPE_GB18030_CHINESE_CI*/:
       case 249/*CS_TYPE_GB18030_BIN*/:
-        if (common::OB_SUCCESS != obproxy_parse_gbk_sql(&parse_result,
-                                                        sql_string.ptr(),
-                                                        static_cast<size_t>(sql_string.length()))) {
+        if (common::OB_SUCCESS != obproxy_parse_gbk_sql_with_scanner(&parse_result,
+                                                                     sql_string.ptr(),
+                                                                     static_cast<size_t>(sql_string.length()),
+                                                                     ObProxyParseScanner::get_thread_scanner(
+                                                                         OBPROXY_GBK_SCANNER,
+                                                                         obproxy_parse_gbk_sql_init_scanner))) {
           ret = common::OB_ERR_PARSE_SQL;
         }
         break;
       case 45/*CS_TYPE_UTF8MB4_GENERAL_CI*/:
       case 46/*CS_TYPE_UTF8MB4_BIN*/:
       default:
-        if (common::OB_SUCCESS != obproxy_parse_utf8_sql(&parse_result,
-                                                         sql_string.ptr(),
-                                                         static_cast<size_t>(sql_string.length()))) {
+        if (common::OB_SUCCESS != obproxy_parse_utf8_sql_with_scanner(&parse_result,
+                                                                      sql_string.ptr(),
+                                                                      static_cast<size_t>(sql_string.length()),
+                                                                      ObProxyParseScanner::get_thread_scanner(
+                                                                          OBPROXY_UTF8_SCANNER,
+                                                                          obproxy_parse_utf8_sql_init_scanner))) {
           ret = common::OB_ERR_PARSE_SQL;
         }
         break;
@@ -8821,6 +8821,40 @@ inline void ob_proxy_parser_gbk_yyfree(void *ptr,void *yyscanner)
   obproxy_parse_free(ptr);
 }
 
+/* point the scanner made by the parser init_scanner() to a new statement, so that it
+ * needs not be created again, base must end with two YY_END_OF_BUFFER_CHAR
+ * as yy_scan_buffer() requires */
+int ob_proxy_parser_gbk_yyreset_buffer(char *base, size_t size, ObProxyParseResult *p, void *yyscanner)
+{
+  int ret = OB_SUCCESS;
+  struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+  if (OB_ISNULL(yyg) || OB_ISNULL(base) || OB_ISNULL(YY_CURRENT_BUFFER)
+      || OB_UNLIKELY(size < 2)
+      || OB_UNLIKELY(YY_END_OF_BUFFER_CHAR != base[size - 2] || YY_END_OF_BUFFER_CHAR != base[size - 1])) {
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+    b->yy_buf_size = size - 2;
+    b->yy_buf_pos = b->yy_ch_buf = base;
+    b->yy_is_our_buffer = 0;
+    b->yy_input_file = 0;
+    b->yy_n_chars = b->yy_buf_size;
+    b->yy_is_interactive = 0;
+    b->yy_at_bol = 1;
+    b->yy_fill_buffer = 0;
+    b->yy_buffer_status = YY_BUFFER_NEW;
+    ob_proxy_parser_gbk_yyset_extra(p, yyscanner);
+    // the start condition stack of the last statement was allocated from its malloc pool
+    yyg->yy_start_stack_ptr = 0;
+    yyg->yy_start_stack_depth = 0;
+    yyg->yy_start_stack = NULL;
+    BEGIN(INITIAL);
+    ob_proxy_parser_gbk_yy_load_buffer_state(yyscanner);
+    yyg->yy_did_buffer_switch_on_eof = 1;
+  }
+  return ret;
+}
+
 inline void update_stmt_type(ObProxyBasicStmtType type, void *yyscanner)
 {
   ObProxyParseResult *p = ob_proxy_parser_gbk_yyget_extra(yyscanner);
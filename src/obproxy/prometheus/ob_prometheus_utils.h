@@ -41,6 +41,12 @@ namespace prometheus
 #define ENTRY_TOTAL "odp_entry_total"
 #define ENTRY_TOTAL_HELP "The num of entry lookup"
 
+#define NET_POLL_TOTAL "odp_net_poll_total"
+#define NET_POLL_TOTAL_HELP "The num of net thread poll, by whether busy poll found work or it slept"
+
+#define SQL_PARSE_CACHE_TOTAL "odp_sql_parse_cache_total"
+#define SQL_PARSE_CACHE_TOTAL_HELP "The num of sql parse cache lookup and eviction"
+
 #define LABEL_LOGIC_TENANT "logicTenant"
 #define LABEL_LOGIC_SCHEMA "logicSchema"
 #define LABEL_CLUSTER "cluster"
@@ -64,6 +70,14 @@ namespace prometheus
 #define LABEL_FALSE "false"
 #define LABEL_TRUE "true"
 #define LABEL_VIP "vip"
+#define LABEL_POLL_TYPE "pollType"
+#define LABEL_POLL_SPIN_HIT "spinHit"
+#define LABEL_POLL_SPIN_MISS "spinMiss"
+#define LABEL_POLL_SLEEP "sleep"
+#define LABEL_CACHE_RESULT "cacheResult"
+#define LABEL_CACHE_HIT "hit"
+#define LABEL_CACHE_MISS "miss"
+#define LABEL_CACHE_EVICT "evict"
 
 class ObProxyPrometheusUtils
 {
@@ -34,9 +34,12 @@
 #include "obutils/ob_proxy_config.h"
 #include "utils/ob_proxy_hot_upgrader.h"
 #include "iocore/net/ob_net_def.h"
+#include "iocore/net/ob_unix_net.h"
 #include "opsql/parser/ob_proxy_parse_result.h"
+#include "obutils/ob_proxy_sql_parse_cache.h"
 #include "prometheus/ob_prometheus_info.h"
 #include "prometheus/ob_sql_prometheus.h"
+#include "prometheus/ob_prometheus_utils.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::common::hash;
@@ -143,6 +146,14 @@ int ObSQLMonitorInfoCont::main_handler(int event, void *data)
   }
   thread_prometheus_->monitor_info_hash_map_.reuse();
 
+  if (OB_FAIL(thread_prometheus_->report_net_poll_stat())) {
+    LOG_WARN("fail to report net poll stat", K(ret));
+  }
+
+  if (OB_FAIL(thread_prometheus_->report_sql_parse_cache_stat())) {
+    LOG_WARN("fail to report sql parse cache stat", K(ret));
+  }
+
   if (OB_FAIL(schedule_report_prometheus_info())) {
     LOG_WARN("schedule report prometheus info failed", K(ret));
   }
@@ -190,6 +201,67 @@ int ObThreadPrometheus::init(ObEThread *thread)
   return ret;
 }
 
+int ObThreadPrometheus::report_net_poll_stat()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(thread_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("thread prometheus not inited", K(ret));
+  } else if (get_global_proxy_config().enable_prometheus && g_ob_prometheus_processor.is_inited()) {
+    const ObNetHandler &nh = thread_->get_net_handler();
+    if (OB_FAIL(report_counter(NET_POLL_TOTAL, NET_POLL_TOTAL_HELP, LABEL_POLL_TYPE, LABEL_POLL_SPIN_HIT,
+                               nh.busy_poll_hit_count_, reported_busy_poll_hit_count_))) {
+      LOG_WARN("fail to report busy poll hit count", K(ret));
+    } else if (OB_FAIL(report_counter(NET_POLL_TOTAL, NET_POLL_TOTAL_HELP, LABEL_POLL_TYPE, LABEL_POLL_SPIN_MISS,
+                                      nh.busy_poll_miss_count_, reported_busy_poll_miss_count_))) {
+      LOG_WARN("fail to report busy poll miss count", K(ret));
+    } else if (OB_FAIL(report_counter(NET_POLL_TOTAL, NET_POLL_TOTAL_HELP, LABEL_POLL_TYPE, LABEL_POLL_SLEEP,
+                                      nh.poll_sleep_count_, reported_poll_sleep_count_))) {
+      LOG_WARN("fail to report poll sleep count", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObThreadPrometheus::report_sql_parse_cache_stat()
+{
+  int ret = OB_SUCCESS;
+  // the cache is created by the first parse of this thread
+  const ObSqlParseCache *cache = ObSqlParseCache::get_thread_cache();
+  if (NULL != cache && get_global_proxy_config().enable_prometheus && g_ob_prometheus_processor.is_inited()) {
+    if (OB_FAIL(report_counter(SQL_PARSE_CACHE_TOTAL, SQL_PARSE_CACHE_TOTAL_HELP, LABEL_CACHE_RESULT,
+                               LABEL_CACHE_HIT, cache->hit_count_, reported_parse_cache_hit_count_))) {
+      LOG_WARN("fail to report sql parse cache hit count", K(ret));
+    } else if (OB_FAIL(report_counter(SQL_PARSE_CACHE_TOTAL, SQL_PARSE_CACHE_TOTAL_HELP, LABEL_CACHE_RESULT,
+                                      LABEL_CACHE_MISS, cache->miss_count_, reported_parse_cache_miss_count_))) {
+      LOG_WARN("fail to report sql parse cache miss count", K(ret));
+    } else if (OB_FAIL(report_counter(SQL_PARSE_CACHE_TOTAL, SQL_PARSE_CACHE_TOTAL_HELP, LABEL_CACHE_RESULT,
+                                      LABEL_CACHE_EVICT, cache->evict_count_, reported_parse_cache_evict_count_))) {
+      LOG_WARN("fail to report sql parse cache evict count", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObThreadPrometheus::report_counter(const char *name, const char *help,
+                                       const char *label_key, const char *label_value,
+                                       const int64_t count, int64_t &reported_count)
+{
+  int ret = OB_SUCCESS;
+  const int64_t delta = count - reported_count;
+  if (delta > 0) {
+    ObVector<ObPrometheusLabel> &label_vector = ObProxyPrometheusUtils::get_thread_label_vector();
+    label_vector.reset();
+    ObProxyPrometheusUtils::build_label(label_vector, label_key, label_value, false);
+    if (OB_FAIL(g_ob_prometheus_processor.handle_counter(name, help, label_vector, delta))) {
+      LOG_WARN("fail to handle counter", K(name), K(label_value), K(delta), K(ret));
+    } else {
+      reported_count = count;
+    }
+  }
+  return ret;
+}
+
 int ObThreadPrometheus::set_sql_monitor_info(const ObString &tenant_name,
                                              const ObString &cluster_name,
                                              const SQLMonitorInfo &info)
@@ -92,13 +92,22 @@ class ObThreadPrometheus
 {
 public:
   int init(event::ObEThread *thread);
-  ObThreadPrometheus() : monitor_info_used_(0), monitor_info_hash_map_(), sql_monitor_info_cont_(NULL), thread_(NULL) {}
+  ObThreadPrometheus() : monitor_info_used_(0), monitor_info_hash_map_(), sql_monitor_info_cont_(NULL), thread_(NULL),
+                         reported_busy_poll_hit_count_(0), reported_busy_poll_miss_count_(0),
+                         reported_poll_sleep_count_(0), reported_parse_cache_hit_count_(0),
+                         reported_parse_cache_miss_count_(0), reported_parse_cache_evict_count_(0) {}
   ~ObThreadPrometheus() {}
   int set_sql_monitor_info(const common::ObString &tenant_name, const common::ObString &cluster_name, const SQLMonitorInfo &info);
+  // report the poll counters of the net handler since the last call
+  int report_net_poll_stat();
+  // report the counters of the sql parse cache of this thread since the last call
+  int report_sql_parse_cache_stat();
 
 private:
   bool set_sql_monitor_info_using_array(const common::ObString &tenant_name, const common::ObString &cluster_name, const SQLMonitorInfo &info);
   int set_sql_monitor_info_using_hashmap(const common::ObString &tenant_name, const common::ObString &cluster_name, const SQLMonitorInfo &info);
+  int report_counter(const char *name, const char *help, const char *label_key, const char *label_value,
+                     const int64_t count, int64_t &reported_count);
 
 public:
   // For monitoring information, it is stored in the form of array + hashmap,
@@ -112,6 +121,12 @@ public:
 private:
   ObSQLMonitorInfoCont *sql_monitor_info_cont_;
   event::ObEThread *thread_;
+  int64_t reported_busy_poll_hit_count_;
+  int64_t reported_busy_poll_miss_count_;
+  int64_t reported_poll_sleep_count_;
+  int64_t reported_parse_cache_hit_count_;
+  int64_t reported_parse_cache_miss_count_;
+  int64_t reported_parse_cache_evict_count_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObThreadPrometheus);
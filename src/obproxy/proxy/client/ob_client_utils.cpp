@@ -54,7 +54,11 @@ void ObMysqlRequestParam::reset_sql()
   if (is_deep_copy_ && !sql_.empty()) {
     op_fixed_mem_free(sql_.ptr(), sql_.length());
   }
+  if (is_deep_copy_ && !session_sql_.empty()) {
+    op_fixed_mem_free(session_sql_.ptr(), session_sql_.length());
+  }
   sql_.reset();
+  session_sql_.reset();
   is_deep_copy_ = false;
 }
 
@@ -80,9 +84,18 @@ int ObMysqlRequestParam::deep_copy_sql(const common::ObString &sql)
 int ObMysqlRequestParam::deep_copy(const ObMysqlRequestParam &other)
 {
   int ret = OB_SUCCESS;
+  char *buf = NULL;
   if (OB_FAIL(deep_copy_sql(other.sql_))) {
     LOG_WARN("fail to deep_copy_sql", K(other), K(ret));
+  } else if (!other.session_sql_.empty()
+             && OB_ISNULL(buf = static_cast<char *>(op_fixed_mem_alloc(other.session_sql_.length())))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc mem", "alloc_size", other.session_sql_.length(), K(ret));
   } else {
+    if (NULL != buf) {
+      MEMCPY(buf, other.session_sql_.ptr(), other.session_sql_.length());
+      session_sql_.assign_ptr(buf, other.session_sql_.length());
+    }
     is_user_idc_name_set_ = other.is_user_idc_name_set_;
     need_print_trace_stat_ = other.need_print_trace_stat_;
     target_addr_ = other.target_addr_;
@@ -46,16 +46,16 @@ union ObClientFlags
 class ObMysqlRequestParam
 {
 public:
-  ObMysqlRequestParam() : sql_(), is_deep_copy_(false), is_user_idc_name_set_(false),
+  ObMysqlRequestParam() : sql_(), session_sql_(), is_deep_copy_(false), is_user_idc_name_set_(false),
                           need_print_trace_stat_(false), current_idc_name_(),
                           target_addr_(), ob_client_flags_(0), mysql_client_(NULL),
                           is_detect_client_(false) {};
   explicit ObMysqlRequestParam(const char *sql)
-    : sql_(sql), is_deep_copy_(false), is_user_idc_name_set_(false),
+    : sql_(sql), session_sql_(), is_deep_copy_(false), is_user_idc_name_set_(false),
       need_print_trace_stat_(false), current_idc_name_(), target_addr_(),
       ob_client_flags_(0), mysql_client_(NULL), is_detect_client_(false) {};
   ObMysqlRequestParam(const char *sql, const ObString &idc_name)
-    : sql_(sql), is_deep_copy_(false), is_user_idc_name_set_(true),
+    : sql_(sql), session_sql_(), is_deep_copy_(false), is_user_idc_name_set_(true),
       need_print_trace_stat_(true), current_idc_name_(idc_name), target_addr_(),
       ob_client_flags_(0), mysql_client_(NULL), is_detect_client_(false) {};
   void reset();
@@ -66,10 +66,12 @@ public:
   bool is_valid() const { return !sql_.empty(); }
   int deep_copy(const ObMysqlRequestParam &other);
   int deep_copy_sql(const common::ObString &sql);
-  TO_STRING_KV(K_(sql), K_(is_deep_copy), K_(current_idc_name), K_(is_user_idc_name_set),
+  TO_STRING_KV(K_(sql), K_(session_sql), K_(is_deep_copy), K_(current_idc_name), K_(is_user_idc_name_set),
                K_(need_print_trace_stat), K_(target_addr), K(ob_client_flags_.flags_), K_(is_detect_client));
 
   common::ObString sql_;
+  // optional, sent on the same connection right before sql_
+  common::ObString session_sql_;
   bool is_deep_copy_;
   bool is_user_idc_name_set_;
   bool need_print_trace_stat_;
@@ -745,8 +745,8 @@ int ObMysqlClient::do_post_request()
       break;
     }
     case CLIENT_ACTION_READ_NORMAL_RESP: {
-     if (OB_FAIL(setup_read_normal_resp())) {
-        LOG_WARN("fail to setup read normal resp", K(ret));
+     if (OB_FAIL(setup_read_request_resp())) {
+        LOG_WARN("fail to setup read request resp", K(ret));
       } else if (OB_FAIL(schedule_active_timeout())) {
         LOG_WARN("fail to schedule_active_timeout", K(ret));
       } else if (OB_FAIL(forward_mysql_request())) {
@@ -819,8 +819,8 @@ int ObMysqlClient::do_next_action(void *data)
               LOG_WARN("fail to transfrom mysql resp", K(ret));
             }
           } else if (info_.get_request_param().ob_client_flags_.is_skip_autocommit()) {
-            if (OB_FAIL(setup_read_normal_resp())) {
-              LOG_WARN("fail to setup read normal resp", K(ret));
+            if (OB_FAIL(setup_read_request_resp())) {
+              LOG_WARN("fail to setup read request resp", K(ret));
             } else if (OB_FAIL(forward_mysql_request())) {
               LOG_WARN("fail to schedule post request", K(ret));
             }
@@ -848,6 +848,31 @@ int ObMysqlClient::do_next_action(void *data)
             if (OB_FAIL(transport_mysql_resp())) {
               LOG_WARN("fail to transfrom mysql resp", K(ret));
             }
+          } else {
+            if (OB_FAIL(setup_read_request_resp())) {
+              LOG_WARN("fail to setup read request resp", K(ret));
+            } else if (OB_FAIL(forward_mysql_request())) {
+              LOG_WARN("fail to schedule post reuqest", K(ret));
+            }
+          }
+        }
+        break;
+      }
+      case CLIENT_ACTION_SET_SESSION_VARS: {
+        if (OB_FAIL(transfer_and_analyze_response(vio, obmysql::OB_MYSQL_COM_QUERY))) {
+          LOG_WARN("fail to transfer and analyze resposne", K(ret));
+        } else if (!mysql_resp_->is_resp_completed()) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("mysql resp must be received complete", K(ret));
+        } else if (OB_FAIL(notify_transfer_completed())) {
+          LOG_WARN("fail to notify transfer completed", K(ret));
+        } else if (NULL != client_vc_) { // NULL means client_vc has closed
+          if (mysql_resp_->is_error_resp()) {
+            // the error is the resp of this request, the connection is still usable
+            next_action_ = CLIENT_ACTION_READ_NORMAL_RESP;
+            if (OB_FAIL(transport_mysql_resp())) {
+              LOG_WARN("fail to transfrom mysql resp", K(ret));
+            }
           } else {
             if (OB_FAIL(setup_read_normal_resp())) {
               LOG_WARN("fail to setup read normal resp", K(ret));
@@ -993,6 +1018,50 @@ int ObMysqlClient::setup_read_autocommit_resp()
   return ret;
 }
 
+// the session sql of the request, if any, is sent first on this connection
+int ObMysqlClient::setup_read_request_resp()
+{
+  int ret = OB_SUCCESS;
+  if (info_.get_request_param().session_sql_.empty()) {
+    ret = setup_read_normal_resp();
+  } else {
+    ret = setup_read_session_vars_resp();
+  }
+  return ret;
+}
+
+int ObMysqlClient::setup_read_session_vars_resp()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(request_buf_) || OB_ISNULL(request_reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("request_buf or request_reader is null", K_(request_buf), K_(request_reader), K(ret));
+  } else if (OB_UNLIKELY(request_reader_->read_avail() > 0)) {
+    LOG_WARN("request buf has remain data, unnormal state", K_(request_reader), K_(request_buf),
+             "read_avail", request_reader_->read_avail());
+    if (OB_FAIL(request_reader_->consume_all())) {
+      LOG_WARN("fail to consume all", K(ret));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    const ObString &sql = info_.get_request_param().session_sql_;
+    const bool use_compress = false;
+    const bool is_checksum_on = false;
+    if (OB_FAIL(ObMysqlRequestBuilder::build_mysql_request(*request_buf_, obmysql::OB_MYSQL_COM_QUERY, sql,
+        use_compress, is_checksum_on))) {
+      LOG_WARN("fail to write buffer", K(sql), K_(request_buf), K(ret));
+    } else {
+      mysql_resp_->consume_resp_buf();
+      next_action_ = CLIENT_ACTION_SET_SESSION_VARS;
+      LOG_DEBUG("ObMysqlClient::will send session vars request", K(sql),
+                "read_avail", request_reader_->read_avail());
+    }
+  }
+
+  return ret;
+}
+
 int ObMysqlClient::setup_read_normal_resp()
 {
   int ret = OB_SUCCESS;
@@ -1260,6 +1329,9 @@ const char *ObMysqlClient::get_client_action_name(const ObClientActionType type)
     case CLIENT_ACTION_READ_NORMAL_RESP:
       name = "CLIENT_ACTION_READ_NORMAL_RESP";
       break;
+    case CLIENT_ACTION_SET_SESSION_VARS:
+      name = "CLIENT_ACTION_SET_SESSION_VARS";
+      break;
     default:
       name = "CLIENT_ACTION_UNKNOWN";
       break;
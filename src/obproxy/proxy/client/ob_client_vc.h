@@ -129,6 +129,7 @@ public:
     CLIENT_ACTION_SET_AUTOCOMMIT,
     CLIENT_ACTION_READ_LOGIN_RESP,
     CLIENT_ACTION_READ_NORMAL_RESP,
+    CLIENT_ACTION_SET_SESSION_VARS,
   };
 
   ObMysqlClient();
@@ -187,6 +188,8 @@ private:
   int setup_read_handshake();
   int setup_read_login_resp();
   int setup_read_autocommit_resp();
+  int setup_read_request_resp();
+  int setup_read_session_vars_resp();
   int setup_read_normal_resp();
   bool is_in_auth() const;
   int transport_mysql_resp();
@@ -628,6 +628,9 @@ ObVIO *ObMysqlClientSession::do_io_write(
     tcp_init_cwnd_set_ = true;
     set_tcp_init_cwnd();
   }
+  if (NULL != mysql_sm_ && NULL != mysql_sm_->trans_state_.mysql_config_params_) {
+    client_vc_->set_write_coalesce_size(mysql_sm_->trans_state_.mysql_config_params_->client_write_coalesce_size_);
+  }
   return client_vc_->do_io_write(c, nbytes, buf);
 }
 
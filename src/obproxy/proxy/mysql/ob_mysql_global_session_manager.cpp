@@ -43,6 +43,8 @@ void ObMysqlServerSessionList::reset()
   create_count_ = 0;
   destroy_count_ = 0;
   last_log_time_ = 0;
+  local_acquire_count_ = 0;
+  remote_acquire_count_ = 0;
 }
 ObMysqlServerSessionList::~ObMysqlServerSessionList() {
   local_ip_pool_.reset();
@@ -50,9 +52,11 @@ ObMysqlServerSessionList::~ObMysqlServerSessionList() {
 int ObMysqlServerSessionList::init()
 {
   int ret = OB_SUCCESS;
-  if (OB_FAIL(server_session_list_.init("ObMysqlServerSessionList list",
-                                        reinterpret_cast<int64_t>(&(reinterpret_cast<ObMysqlServerSession*>(0))->ip_list_link_)))) {
-    LOG_WARN("fail to init server_session_list_", K(ret));
+  for (int64_t i = 0; OB_SUCC(ret) && i < SESSION_LIST_SLOT_COUNT; ++i) {
+    if (OB_FAIL(server_session_list_[i].init("ObMysqlServerSessionList list",
+                                             reinterpret_cast<int64_t>(&(reinterpret_cast<ObMysqlServerSession*>(0))->ip_list_link_)))) {
+      LOG_WARN("fail to init server_session_list_", K(i), K(ret));
+    }
   }
   ObProxyMutex *mutex = NULL;
   if (OB_ISNULL(mutex = new_proxy_mutex(CLIENT_VC_LOCK))) {
@@ -137,14 +141,16 @@ int ObMysqlServerSessionList::main_handler(int event, void *data)
 void ObMysqlServerSessionList::purge_session_list()
 {
   DRWLock::WRLockGuard guard(rwlock_);
-  while (!server_session_list_.empty()) {
-    ObMysqlServerSession* session = (ObMysqlServerSession*)server_session_list_.pop();
-    if (OB_ISNULL(session)) {
-      LOG_WARN("unexpected session is NULL");
-    } else {
-      // will remove from local_ip_pool when close
-      session->has_global_session_lock_ = true;
-      session->do_io_close();
+  for (int64_t i = 0; i < SESSION_LIST_SLOT_COUNT; ++i) {
+    while (!server_session_list_[i].empty()) {
+      ObMysqlServerSession* session = (ObMysqlServerSession*)server_session_list_[i].pop();
+      if (OB_ISNULL(session)) {
+        LOG_WARN("unexpected session is NULL");
+      } else {
+        // will remove from local_ip_pool when close
+        session->has_global_session_lock_ = true;
+        session->do_io_close();
+      }
     }
   }
   local_ip_pool_.reset();
@@ -229,11 +235,27 @@ int ObMysqlServerSessionList::remove_server_session_internal(const ObMysqlServer
   return ret;
 }
 
+int64_t ObMysqlServerSessionList::get_session_slot(ObMysqlServerSession &server_session) const
+{
+  ObNetVConnection *vc = server_session.get_netvc();
+  return (NULL == vc || NULL == vc->thread_) ? 0 : (vc->thread_->id_ % SESSION_LIST_SLOT_COUNT);
+}
+
 ObMysqlServerSession* ObMysqlServerSessionList::acquire_from_list()
 {
   DRWLock::RDLockGuard guard(rwlock_);
-  ObMysqlServerSession* ss = (ObMysqlServerSession*)server_session_list_.pop();
+  ObEThread *ethread = this_ethread();
+  const int64_t local_slot = (NULL == ethread) ? 0 : (ethread->id_ % SESSION_LIST_SLOT_COUNT);
+  ObMysqlServerSession* ss = NULL;
+  for (int64_t i = 0; NULL == ss && i < SESSION_LIST_SLOT_COUNT; ++i) {
+    ss = (ObMysqlServerSession*)server_session_list_[(local_slot + i) % SESSION_LIST_SLOT_COUNT].pop();
+  }
   if (ss != NULL) {
+    if (NULL != ss->get_netvc() && ethread == ss->get_netvc()->thread_) {
+      ATOMIC_INC(&local_acquire_count_);
+    } else {
+      ATOMIC_INC(&remote_acquire_count_);
+    }
     ATOMIC_DEC(&free_count_);
     using_count_ = total_count_ - free_count_;
     if (using_count_ > max_used_) {
@@ -279,7 +301,7 @@ int ObMysqlServerSessionList::release_to_list(ObMysqlServerSession& server_sessi
       server_vc->set_inactivity_timeout(ObMysqlSessionUtils::get_session_idle_timeout_ms(server_session.schema_key_));
       server_vc->set_active_timeout(server_vc->get_active_timeout());
       server_session.clear_client_session();
-      server_session_list_.push(&server_session);
+      server_session_list_[get_session_slot(server_session)].push(&server_session);
       int64_t old_count = free_count_;
       int64_t new_count = ATOMIC_AAF(&free_count_, 1);
       LOG_DEBUG("release_to_list succ", K(server_session.ss_id_), K(server_session.auth_user_),
@@ -294,7 +316,14 @@ int ObMysqlServerSessionList::remove_from_list(ObMysqlServerSession* server_sess
   int ret = OB_SUCCESS;
   // is locked in main_handler
   ObMysqlServerSession* ss_to_remove = NULL;
-  if (OB_ISNULL(ss_to_remove = (ObMysqlServerSession*)server_session_list_.remove(server_session))) {
+  const int64_t slot = get_session_slot(*server_session);
+  ss_to_remove = (ObMysqlServerSession*)server_session_list_[slot].remove(server_session);
+  for (int64_t i = 0; NULL == ss_to_remove && i < SESSION_LIST_SLOT_COUNT; ++i) {
+    if (i != slot) {
+      ss_to_remove = (ObMysqlServerSession*)server_session_list_[i].remove(server_session);
+    }
+  }
+  if (OB_ISNULL(ss_to_remove)) {
     LOG_WARN("should not null here", K(server_session->ss_id_), K(server_session->auth_user_),
              K(server_session->server_ip_));
   } else {
@@ -320,18 +349,22 @@ int ObMysqlServerSessionList::do_pool_log(const ObProxySchemaKey& schema_key, bo
   int64_t max_used = max_used_;
   int64_t create_count = create_count_;
   int64_t destroy_count = destroy_count_;
+  int64_t local_acquire_count = local_acquire_count_;
+  int64_t remote_acquire_count = remote_acquire_count_;
   if (force_log) {
     int64_t now_time = event::get_hrtime();
     last_log_time_ = now_time;
     OBPROXY_POOL_STAT_LOG(INFO, "session_pool_stat:", K(dbkey), K(max_conn), K(min_conn), K(total_count), K(free_count),
-        K(using_count), K(max_used), K(create_count),K(destroy_count), K(common_addr_), K(force_log));
+        K(using_count), K(max_used), K(create_count),K(destroy_count), K(local_acquire_count), K(remote_acquire_count),
+        K(common_addr_), K(force_log));
   } else if (used_conn >= max_conn * ratio / 10000) {
     int64_t now_time = event::get_hrtime();
     int64_t interval_time = HRTIME_USECONDS(get_global_proxy_config().session_pool_stat_log_interval);
     if (now_time - last_log_time_ >= interval_time) {
       last_log_time_ = now_time;
       OBPROXY_POOL_STAT_LOG(INFO, "session_pool_stat:", K(dbkey), K(max_conn), K(min_conn), K(total_count), K(free_count),
-        K(using_count), K(max_used), K(create_count),K(destroy_count), K(common_addr_), K(force_log));
+        K(using_count), K(max_used), K(create_count),K(destroy_count), K(local_acquire_count), K(remote_acquire_count),
+        K(common_addr_), K(force_log));
     } else {
       LOG_DEBUG("reach ratio and no need log", K(interval_time), K(last_log_time_),
         K(now_time), K(used_conn), K(max_conn), K(min_conn), K(schema_key));
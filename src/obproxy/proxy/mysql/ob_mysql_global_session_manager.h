@@ -61,8 +61,14 @@ public:
   ObMysqlServerSession* acquire_from_list();
   int release_to_list(ObMysqlServerSession& server_session);
   int do_pool_log(const ObProxySchemaKey& schema_key, bool force_log = false);
+private:
+  int64_t get_session_slot(ObMysqlServerSession &server_session) const;
+
 public:
   static const int64_t HASH_BUCKET_SIZE = 16;
+  // free sessions are kept apart by the net thread which owns them, so that
+  // a client session first takes one which lives on its own thread
+  static const int64_t SESSION_LIST_SLOT_COUNT = 16;
   struct ObLocalIPHashing
   {
     typedef const ObMysqlServerSessionHashKey Key;
@@ -86,9 +92,11 @@ public:
   net::ObIpEndpoint local_ip_;
   oceanbase::obproxy::obutils::ObProxyConfigString auth_user_;
   ObCommonAddr common_addr_;
-  common::ObAtomicList server_session_list_;
+  common::ObAtomicList server_session_list_[SESSION_LIST_SLOT_COUNT];
   LocalIPHashTable local_ip_pool_;
   int64_t free_count_; // free_count is server_session_list_ elem count
+  int64_t local_acquire_count_;  // acquired by a client session on the same thread
+  int64_t remote_acquire_count_; // acquired from another thread
   int64_t total_count_; // live_count is all count, include now is being used
   int64_t using_count_;
   int64_t max_used_;
@@ -61,6 +61,8 @@ int ObMysqlProxyServerMain::make_net_accept_options(
 
     net_opt.accept_threads_ = config_params.net_accept_threads_;
     net_opt.frequent_accept_ = config_params.frequent_accept_;
+    net_opt.reuseport_ = config_params.enable_reuseport_accept_;
+    net_opt.reuseport_cpu_steering_ = config_params.enable_reuseport_cpu_steering_;
     net_opt.ip_family_ = port.family_;
     net_opt.local_port_ = port.port_;
     net_opt.stacksize_ = config_params.stack_size_;
@@ -971,6 +971,91 @@ int ObMysqlSM::process_shard_ddl_result(ObShardDDLStatus *ddl_status)
   return ret;
 }
 
+int ObMysqlSM::setup_handle_shard_multi_stmt(ObAction *action)
+{
+  int ret = OB_SUCCESS;
+
+  LOG_DEBUG("setup handle shard multi stmt");
+  MYSQL_SM_SET_DEFAULT_HANDLER(&ObMysqlSM::state_handle_shard_multi_stmt);
+
+  int64_t total_len = client_buffer_reader_->read_avail();
+  if (total_len > trans_state_.trans_info_.client_request_.get_packet_meta().pkt_len_) {
+    total_len = trans_state_.trans_info_.client_request_.get_packet_meta().pkt_len_;
+  }
+
+  // consume data in client buffer reader
+  if (OB_FAIL(client_buffer_reader_->consume(total_len))) {
+    LOG_WARN("fail to consume all", K_(sm_id), K(ret));
+  } else if (OB_NOT_NULL(pending_action_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("pending_action must be NULL here", K_(pending_action), K_(sm_id), K(ret));
+  } else {
+    pending_action_ = action;
+  }
+
+  return ret;
+}
+
+int ObMysqlSM::state_handle_shard_multi_stmt(int event, void *data)
+{
+  int ret = OB_SUCCESS;
+
+  STATE_ENTER(ObMysqlSM::state_handle_shard_multi_stmt, event);
+
+  switch (event) {
+    case ASYNC_PROCESS_DONE_EVENT:
+      pending_action_ = NULL;
+      if (OB_ISNULL(data)) {
+        ret = OB_ERR_NULL_VALUE;
+        LOG_WARN("data is NULL", K_(sm_id), K(ret));
+      } else if (OB_FAIL(process_executor_result(reinterpret_cast<ObIOBufferReader*>(data)))) {
+        LOG_WARN("fail to process executor result, will disconnect", K_(sm_id), K(ret));
+      } else {
+        trans_state_.next_action_ = ObMysqlTransact::SM_ACTION_INTERNAL_NOOP;
+        callout_api_and_start_next_action(ObMysqlTransact::SM_ACTION_API_SEND_RESPONSE);
+      }
+      break;
+    case VC_EVENT_EOS:
+    case VC_EVENT_ACTIVE_TIMEOUT:
+    case VC_EVENT_INACTIVITY_TIMEOUT:
+    case VC_EVENT_DETECT_SERVER_DEAD:
+      LOG_WARN("handle shard multi stmt meet error, will disconnect", K_(sm_id),
+               "event", ObMysqlDebugNames::get_event_name(event), K(ret));
+      ret = OB_CONNECT_ERROR;
+      break;
+    case VC_EVENT_ERROR:
+      LOG_WARN("handle shard multi stmt meet error, will disconnect", K_(sm_id),
+               "event", ObMysqlDebugNames::get_event_name(event), K(ret));
+      ret = OB_ERR_UNEXPECTED;
+      break;
+    default: {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("Unexpected event", K_(sm_id), K(event), K(ret));
+      break;
+    }
+  }
+
+  if (OB_NOT_NULL(pending_action_)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = pending_action_->cancel())) {
+      LOG_WARN("failed to cancel pending action", K_(pending_action), K_(sm_id), K(tmp_ret));
+    }
+
+    if (OB_SUCC(ret)) {
+      ret = tmp_ret;
+    }
+    pending_action_ = NULL;
+  }
+
+  if (OB_FAIL(ret)) {
+    trans_state_.free_internal_buffer();
+    trans_state_.inner_errcode_ = ret;
+    call_transact_and_set_next_state(ObMysqlTransact::handle_error_jump);
+  }
+
+  return VC_EVENT_NONE;
+}
+
 int ObMysqlSM::setup_handle_execute_plan()
 {
   int ret = OB_SUCCESS;
@@ -1210,8 +1295,8 @@ int ObMysqlSM::handle_shard_request(bool &need_response_for_stmt, bool &need_wai
                         trans_state_, *client_buffer_reader_, *db_info))) {
           LOG_WARN("fail to handle single shard request", K(ret));
         }
-      } else if (OB_FAIL(ObProxyShardUtils::handle_shard_request(*client_session_,
-                      trans_state_, *client_buffer_reader_, *db_info))) {
+      } else if (OB_FAIL(ObProxyShardUtils::handle_shard_request(this, *client_session_,
+                      trans_state_, *client_buffer_reader_, *db_info, need_wait_callback))) {
           LOG_WARN("fail to handle shard request", K(ret));
       }
     }
@@ -5084,6 +5169,8 @@ int ObMysqlSM::tunnel_handler_response_transfered(int event, void *data)
   STATE_ENTER(ObMysqlSM::tunnel_handler_response_transfered, event);
   int ret = OB_SUCCESS;
 
+  set_client_zero_copy_send(false);
+
   if (OB_UNLIKELY(MYSQL_TUNNEL_EVENT_DONE != event) || OB_UNLIKELY(data != &tunnel_)) {
     terminate_sm_ = true;
     LOG_ERROR("unexpected event type", K(event), K_(sm_id));
@@ -5207,6 +5294,7 @@ int ObMysqlSM::tunnel_handler_server(int event, ObMysqlTunnelProducer &p)
         }
 
         MYSQL_INCREMENT_TRANS_STAT(BROKEN_SERVER_CONNECTIONS);
+        set_client_zero_copy_send(false);
 
         LOG_WARN("[ObMysqlSM::tunnel_handler_server] finishing mysql tunnel", K_(sm_id),
                  "event", ObMysqlTransact::get_server_state_name(trans_state_.current_.state_));
@@ -5665,6 +5753,8 @@ int ObMysqlSM::tunnel_handler_client(int event, ObMysqlTunnelConsumer &c)
     milestones_.client_.client_end_ = get_based_hrtime();
     cmd_time_stats_.client_response_write_time_ += c.cost_time_;
     client_entry_->in_tunnel_ = false;
+    // the tunnel is over for the client vc whether it completed or aborted
+    set_client_zero_copy_send(false);
 
     switch (event) {
       case VC_EVENT_EOS:
@@ -8776,6 +8866,8 @@ int ObMysqlSM::setup_server_transfer()
       analyzer = is_resultset ? &analyzer_ : NULL;
     }
 
+    set_client_zero_copy_send(is_resultset);
+
     if (OB_FAIL(p->set_response_packet_analyzer(0, MYSQL_RESPONSE, analyzer, &server_response))) {
       LOG_WARN("failed to set_producer_packet_analyzer", K(p), K_(sm_id), K(ret));
     } else if (OB_FAIL(tunnel_.tunnel_run(p))) {
@@ -8786,6 +8878,25 @@ int ObMysqlSM::setup_server_transfer()
   return ret;
 }
 
+// MSG_ZEROCOPY only pays off when big resultset packets are forwarded to the
+// client byte for byte, so it is limited to plain mysql protocol on both sides
+void ObMysqlSM::set_client_zero_copy_send(const bool enable)
+{
+  int ret = OB_SUCCESS;
+  int64_t min_size = 0;
+  ObNetVConnection *netvc = NULL;
+  if (enable
+      && ObProxyProtocol::PROTOCOL_NORMAL == get_server_session_protocol()
+      && ObProxyProtocol::PROTOCOL_NORMAL == get_client_session_protocol()) {
+    min_size = trans_state_.mysql_config_params_->tunnel_zero_copy_send_threshold_;
+  }
+  if (NULL != client_session_ && NULL != (netvc = client_session_->get_netvc())
+      && OB_FAIL(netvc->set_zero_copy_send(min_size))
+      && min_size > 0) {
+    LOG_DEBUG("zero copy send is not available on client vc", K(min_size), K_(sm_id), K(ret));
+  }
+}
+
 int ObMysqlSM::setup_cmd_complete()
 {
   int ret = OB_SUCCESS;
@@ -9083,6 +9194,9 @@ void ObMysqlSM::kill_this()
       pending_action_ = NULL;
     }
 
+    // the client session may outlive this sm, do not leave MSG_ZEROCOPY on
+    set_client_zero_copy_send(false);
+
     // before close client_entry, must close server_entry_ firstly;
     if (NULL != server_entry_) {
       if (OB_FAIL(vc_table_.cleanup_entry(server_entry_))) {
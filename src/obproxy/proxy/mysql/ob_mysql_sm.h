@@ -156,6 +156,8 @@ public:
   int setup_handle_shard_ddl(event::ObAction *action);
   int state_handle_shard_ddl(int event, void *data);
   int process_shard_ddl_result(ObShardDDLStatus *ddl_status);
+  int setup_handle_shard_multi_stmt(event::ObAction *action);
+  int state_handle_shard_multi_stmt(int event, void *data);
   int setup_handle_execute_plan();
   int state_handle_execute_plan(int event, void *data);
   int process_executor_result(event::ObIOBufferReader *resp_reader);
@@ -368,6 +370,7 @@ public:
   int setup_server_response_read();
   int setup_server_request_send();
   int setup_server_transfer();
+  void set_client_zero_copy_send(const bool enable);
   int setup_internal_transfer(MysqlSMHandler handler);
   void setup_error_transfer();
   int setup_cmd_complete();
@@ -848,7 +848,7 @@ void ObMysqlTunnel::consumer_reenable(ObMysqlTunnelConsumer &c)
           // before the actual socket write. So we trap for the buffer becoming empty to
           // make sure we get an event to unthrottle after the write.
           if (MT_MYSQL_CLIENT == c.vc_type_) {
-            ObNetVConnection *netvc = dynamic_cast<ObNetVConnection *>(c.write_vio_->vc_server_);
+            ObNetVConnection *netvc = static_cast<ObMysqlClientSession *>(c.vc_)->get_netvc();
             if (OB_LIKELY(NULL != netvc)) {// really, this should always be true.
               netvc->trap_write_buffer_empty();
             }
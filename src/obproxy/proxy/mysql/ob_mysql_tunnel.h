@@ -259,8 +259,13 @@ private:
   int64_t get_local_thread_queue_size() const;
 
 private:
+  // must be powers of 2, see ObVIO::get_slot_hint()
   static const int64_t MAX_PRODUCERS = 2;
   static const int64_t MAX_CONSUMERS = 4;
+  STATIC_ASSERT(MAX_PRODUCERS > 0 && 0 == (MAX_PRODUCERS & (MAX_PRODUCERS - 1)),
+                "tunnel producer count must be a power of 2");
+  STATIC_ASSERT(MAX_CONSUMERS > 0 && 0 == (MAX_CONSUMERS & (MAX_CONSUMERS - 1)),
+                "tunnel consumer count must be a power of 2");
   static const ObHRTime CONSUMER_REENABLE_RETRY_TIME = HRTIME_MSECONDS(1);
 
   ObMysqlTunnelConsumer consumers_[MAX_CONSUMERS];
@@ -348,12 +353,16 @@ inline ObMysqlTunnelConsumer *ObMysqlTunnel::get_consumer(event::ObVConnection *
 inline ObMysqlTunnelProducer *ObMysqlTunnel::get_producer(event::ObVIO *vio)
 {
   ObMysqlTunnelProducer *ret = NULL;
-  if (OB_LIKELY(producers_[0].read_vio_ == vio)) {
-    ret = producers_;
-  } else {
-    for (int64_t i = 1; i < MAX_PRODUCERS && NULL == ret; ++i) {
-      if (producers_[i].read_vio_ == vio) {
-        ret = producers_ + i;
+  if (OB_LIKELY(NULL != vio)) {
+    const int64_t hint = vio->get_slot_hint(event::ObVIO::SLOT_OWNER_TUNNEL, MAX_PRODUCERS);
+    if (OB_LIKELY(producers_[hint].read_vio_ == vio)) {
+      ret = producers_ + hint;
+    } else {
+      for (int64_t i = 0; i < MAX_PRODUCERS && NULL == ret; ++i) {
+        if (producers_[i].read_vio_ == vio) {
+          ret = producers_ + i;
+          vio->set_slot_hint(event::ObVIO::SLOT_OWNER_TUNNEL, i);
+        }
       }
     }
   }
@@ -363,12 +372,16 @@ inline ObMysqlTunnelProducer *ObMysqlTunnel::get_producer(event::ObVIO *vio)
 inline ObMysqlTunnelConsumer *ObMysqlTunnel::get_consumer(event::ObVIO *vio)
 {
   ObMysqlTunnelConsumer *ret = NULL;
-  if (OB_LIKELY(consumers_[0].write_vio_ == vio)) {
-    ret = consumers_;
-  } else {
-    for (int64_t i = 1; i < MAX_CONSUMERS && NULL == ret; ++i) {
-      if (consumers_[i].write_vio_ == vio) {
-        ret = consumers_ + i;
+  if (OB_LIKELY(NULL != vio)) {
+    const int64_t hint = vio->get_slot_hint(event::ObVIO::SLOT_OWNER_TUNNEL, MAX_CONSUMERS);
+    if (OB_LIKELY(consumers_[hint].write_vio_ == vio)) {
+      ret = consumers_ + hint;
+    } else {
+      for (int64_t i = 0; i < MAX_CONSUMERS && NULL == ret; ++i) {
+        if (consumers_[i].write_vio_ == vio) {
+          ret = consumers_ + i;
+          vio->set_slot_hint(event::ObVIO::SLOT_OWNER_TUNNEL, i);
+        }
       }
     }
   }
@@ -56,10 +56,16 @@ ObMysqlVCTableEntry *ObMysqlVCTable::find_entry(ObVIO *vio)
 {
   ObMysqlVCTableEntry *ret = NULL;
   if (OB_LIKELY(NULL != vio)) {
-    for (int64_t i = 0; NULL == ret && i < VC_TABLE_MAX_ENTRIES; ++i) {
-      if (vc_table_[i].read_vio_ == vio || vc_table_[i].write_vio_ == vio) {
-        if (OB_LIKELY(NULL != vc_table_[i].vc_)) {
+    // the vio remembers its slot, only the first lookup after it is
+    // handed to a new entry needs the scan
+    ObMysqlVCTableEntry *e = vc_table_ + vio->get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, VC_TABLE_MAX_ENTRIES);
+    if (OB_LIKELY(is_entry_of(*e, vio))) {
+      ret = e;
+    } else {
+      for (int64_t i = 0; NULL == ret && i < VC_TABLE_MAX_ENTRIES; ++i) {
+        if (is_entry_of(vc_table_[i], vio)) {
           ret = vc_table_ + i;
+          vio->set_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, i);
         }
       }
     }
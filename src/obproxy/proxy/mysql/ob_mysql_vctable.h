@@ -58,8 +58,16 @@ struct ObMysqlVCTable
   int cleanup_all();
   bool is_table_clear() const;
 
+  // must be a power of 2, see ObVIO::get_slot_hint()
   static const int VC_TABLE_MAX_ENTRIES = 4;
+  STATIC_ASSERT(VC_TABLE_MAX_ENTRIES > 0 && 0 == (VC_TABLE_MAX_ENTRIES & (VC_TABLE_MAX_ENTRIES - 1)),
+                "vc table entry count must be a power of 2");
 private:
+  static bool is_entry_of(const ObMysqlVCTableEntry &e, const event::ObVIO *vio)
+  {
+    return NULL != e.vc_ && (e.read_vio_ == vio || e.write_vio_ == vio);
+  }
+
   ObMysqlVCTableEntry vc_table_[VC_TABLE_MAX_ENTRIES];
   DISALLOW_COPY_AND_ASSIGN(ObMysqlVCTable);
 };
@@ -47,6 +47,8 @@ ObMysqlConfigParams::ObMysqlConfigParams()
     default_buffer_water_mark_(0),
     tunnel_request_size_threshold_(0),
     request_buffer_length_(4096),
+    tunnel_zero_copy_send_threshold_(0),
+    client_write_coalesce_size_(0),
 
     sock_recv_buffer_size_out_(0),
     sock_send_buffer_size_out_(0),
@@ -61,6 +63,8 @@ ObMysqlConfigParams::ObMysqlConfigParams()
 
     frequent_accept_(false),
     net_accept_threads_(0),
+    enable_reuseport_accept_(false),
+    enable_reuseport_cpu_steering_(false),
     default_inactivity_timeout_(0),
     observer_query_timeout_delta_(0),
     short_async_task_timeout_(0),
@@ -141,6 +145,8 @@ int ObMysqlConfigParams::assign_config(const ObProxyConfig &proxy_config)
   CONFIG_ITEM_ASSIGN(default_buffer_water_mark);
   CONFIG_ITEM_ASSIGN(tunnel_request_size_threshold);
   CONFIG_ITEM_ASSIGN(request_buffer_length);
+  CONFIG_ITEM_ASSIGN(tunnel_zero_copy_send_threshold);
+  CONFIG_ITEM_ASSIGN(client_write_coalesce_size);
 
   CONFIG_ITEM_ASSIGN(sock_recv_buffer_size_out);
   CONFIG_ITEM_ASSIGN(sock_send_buffer_size_out);
@@ -161,6 +167,8 @@ int ObMysqlConfigParams::assign_config(const ObProxyConfig &proxy_config)
 
   CONFIG_ITEM_ASSIGN(frequent_accept);
   CONFIG_ITEM_ASSIGN(net_accept_threads);
+  CONFIG_ITEM_ASSIGN(enable_reuseport_accept);
+  CONFIG_ITEM_ASSIGN(enable_reuseport_cpu_steering);
   CONFIG_TIME_ASSIGN(default_inactivity_timeout);
   CONFIG_TIME_ASSIGN(observer_query_timeout_delta);
   CONFIG_TIME_ASSIGN(short_async_task_timeout);
@@ -310,11 +318,14 @@ DEF_TO_STRING(ObMysqlConfigParams)
        K_(flow_low_water_mark), K_(flow_consumer_reenable_threshold),
        K_(flow_event_queue_threshold), K_(default_buffer_water_mark),
        K_(tunnel_request_size_threshold), K_(request_buffer_length),
+       K_(tunnel_zero_copy_send_threshold),
+       K_(client_write_coalesce_size),
        K_(sock_recv_buffer_size_out), K_(sock_send_buffer_size_out),
        K_(server_tcp_keepidle), K_(server_tcp_keepintvl),
        K_(server_tcp_keepcnt), K_(server_tcp_user_timeout),
        K_(sock_option_flag_out), K_(sock_packet_mark_out), K_(sock_packet_tos_out),
-       K_(server_tcp_init_cwnd), K_(frequent_accept), K_(net_accept_threads));
+       K_(server_tcp_init_cwnd), K_(frequent_accept), K_(net_accept_threads),
+       K_(enable_reuseport_accept), K_(enable_reuseport_cpu_steering));
   J_COMMA();
   J_KV(K_(short_async_task_timeout), K_(short_async_task_timeout), K_(min_congested_connect_timeout),
        K_(tenant_location_valid_time), K_(local_bound_ip), K_(listen_port), K_(stack_size), K_(work_thread_num),
@@ -69,6 +69,8 @@ public:
   CfgInt default_buffer_water_mark_;
   CfgInt tunnel_request_size_threshold_;
   CfgInt request_buffer_length_;
+  CfgInt tunnel_zero_copy_send_threshold_;
+  CfgInt client_write_coalesce_size_;
 
   CfgInt sock_recv_buffer_size_out_;
   CfgInt sock_send_buffer_size_out_;
@@ -89,6 +91,8 @@ public:
 
   CfgBool frequent_accept_;
   CfgInt net_accept_threads_;
+  CfgBool enable_reuseport_accept_;
+  CfgBool enable_reuseport_cpu_steering_;
   CfgTime default_inactivity_timeout_;
   CfgTime observer_query_timeout_delta_;
   CfgTime short_async_task_timeout_;
@@ -937,6 +937,60 @@ void ObMysqlRespAnalyzer::handle_last_eof(uint32_t pkt_len)
   }
 }
 
+inline bool ObMysqlRespAnalyzer::can_walk_row_pkts(const ObRespResult &result) const
+{
+  // in the row phase of text protocol, and of binary protocol before the resultset is
+  // received, update_cur_type() gives no ending type to a packet which does not begin
+  // with 0xFE or 0xFF, and such a packet changes nothing but all_pkt_cnt
+  return enable_row_walk_
+         && !is_in_multi_pkt_
+         && meta_analyzer_.empty()
+         && RESULT_SET_RESP_TYPE == result.get_resp_type()
+         && 1 == result.get_pkt_cnt(EOF_PACKET_ENDING_TYPE)
+         && 0 == result.get_pkt_cnt(ERROR_PACKET_ENDING_TYPE)
+         && (OB_MYSQL_COM_QUERY == result.get_cmd()
+             || (OB_MYSQL_COM_STMT_EXECUTE == result.get_cmd() && !result.is_recv_resultset()));
+}
+
+inline void ObMysqlRespAnalyzer::walk_row_pkts(
+    ObBufferReader &buf_reader,
+    ObRespResult &result,
+    ObMysqlResp *resp)
+{
+  const char *start = buf_reader.get_ptr();
+  const char *end = start + buf_reader.get_remain_len();
+  const char *pos = start;
+  int64_t pkt_len = 0;
+  int64_t first_byte = 0;
+  int32_t row_cnt = 0;
+
+  // the packet header and the first byte of the payload must be in the buffer
+  while (end - pos > MYSQL_NET_HEADER_LENGTH) {
+    pkt_len = uint3korr(pos);
+    first_byte = static_cast<uint8_t>(pos[MYSQL_NET_HEADER_LENGTH]);
+    if (OB_UNLIKELY(MYSQL_EOF_PACKET_TYPE == first_byte)
+        || OB_UNLIKELY(MYSQL_ERR_PACKET_TYPE == first_byte)
+        || OB_UNLIKELY(0 == pkt_len)
+        || OB_UNLIKELY(MYSQL_PACKET_MAX_LENGTH == pkt_len)
+        || end - pos < MYSQL_NET_HEADER_LENGTH + pkt_len) {
+      break;
+    } else {
+      pos += MYSQL_NET_HEADER_LENGTH + pkt_len;
+      ++row_cnt;
+    }
+  }
+
+  if (row_cnt > 0) {
+    buf_reader.pos_ += pos - start;
+    // row packet needn't reserve
+    reserved_len_ = 0;
+    result.add_all_pkt_cnt(row_cnt);
+    if (OB_LIKELY(NULL != resp)) {
+      resp->get_analyze_result().ok_packet_action_type_ = OK_PACKET_ACTION_SEND;
+    }
+  }
+}
+
 int ObMysqlRespAnalyzer::analyze_mysql_resp(
     ObBufferReader &buf_reader,
     ObRespResult &result,
@@ -951,7 +1005,10 @@ int ObMysqlRespAnalyzer::analyze_mysql_resp(
     while ((OB_SUCC(ret)) && !buf_reader.empty()) {
       switch (state_) {
         case READ_HEADER:
-          if (OB_FAIL(read_pkt_hdr(buf_reader))) {
+          if (can_walk_row_pkts(result)) {
+            walk_row_pkts(buf_reader, result, resp);
+          }
+          if (!buf_reader.empty() && OB_FAIL(read_pkt_hdr(buf_reader))) {
             LOG_WARN("fail to read packet header", K(ret));
           }
           break;
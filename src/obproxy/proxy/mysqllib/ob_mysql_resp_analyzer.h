@@ -84,6 +84,7 @@ public:
 
   int32_t get_all_pkt_cnt() const { return all_pkt_cnt_; }
   void inc_all_pkt_cnt() { ++all_pkt_cnt_; }
+  void add_all_pkt_cnt(const int32_t cnt) { all_pkt_cnt_ += cnt; }
 
   int32_t get_expect_pkt_cnt() const { return expect_pkt_cnt_; }
   void set_expect_pkt_cnt(const int32_t expect_pkt_cnt) { expect_pkt_cnt_ = expect_pkt_cnt; }
@@ -199,7 +200,7 @@ class ObMysqlResp;
 class ObMysqlRespAnalyzer
 {
 public:
-  ObMysqlRespAnalyzer()  { reset(); }
+  ObMysqlRespAnalyzer() : enable_row_walk_(true) { reset(); }
   ~ObMysqlRespAnalyzer() { reset(); }
   void reset();
 
@@ -211,6 +212,9 @@ public:
   bool is_oceanbase_mode() const { return OCEANBASE_MYSQL_PROTOCOL_MODE == mysql_mode_ || OCEANBASE_ORACLE_PROTOCOL_MODE == mysql_mode_; }
   bool is_mysql_mode() const { return STANDARD_MYSQL_PROTOCOL_MODE == mysql_mode_; }
   bool need_wait_more_data() const { return (next_read_len_ > 0); }
+  // walk the row packets of a resultset by their headers only, on by default
+  void set_enable_row_walk(const bool enable_row_walk) { enable_row_walk_ = enable_row_walk; }
+  bool is_row_walk_enabled() const { return enable_row_walk_; }
 
 private:
   int analyze_prepare_ok_pkt(ObRespResult &result);
@@ -225,10 +229,18 @@ private:
   int analyze_resp_pkt(ObRespResult &result, ObMysqlResp *resp);
   void handle_last_eof(uint32_t pkt_len);
 
+  // after the column definitions, a row packet only needs its length to be skipped.
+  // hop over the rows which are entirely in buf_reader, and stop at the first packet
+  // beginning with 0xFE or 0xFF (maybe EOF/ERR), or with an incomplete or
+  // multi packet, which is left to the state machine above.
+  bool can_walk_row_pkts(const ObRespResult &result) const;
+  void walk_row_pkts(ObBufferReader &buf_reader, ObRespResult &result, ObMysqlResp *resp);
+
   int build_packet_content(obutils::ObVariableLenBuffer<FIXED_MEMORY_BUFFER_SIZE> &content_buf);
 
 private:
   static const int64_t OK_PACKET_MAX_COPY_LEN = 20; // 9 + 9 + 2;
+  bool enable_row_walk_;
   bool is_in_multi_pkt_;
   bool cur_stmt_has_more_result_;
   ObMysqlResponseAnalyzerState state_;
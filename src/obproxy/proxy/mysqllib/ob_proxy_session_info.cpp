@@ -187,7 +187,7 @@ ObClientSessionInfo::ObClientSessionInfo()
       enable_shard_authority_(false), enable_reset_db_(true), client_cap_(0), server_cap_(0),
       safe_read_snapshot_(0),
       syncing_safe_read_snapshot_(0), route_policy_(1), proxy_route_policy_(MAX_PROXY_ROUTE_POLICY),
-      user_identity_(USER_TYPE_NONE), cached_variables_(),
+      user_identity_(USER_TYPE_NONE), same_value_sys_var_set_count_(0), cached_variables_(),
       global_vars_version_(OB_INVALID_VERSION), obproxy_route_addr_(0),
       var_set_processor_(NULL), cluster_id_(OB_INVALID_CLUSTER_ID),
       real_meta_cluster_name_(), real_meta_cluster_name_str_(NULL),
@@ -525,6 +525,21 @@ int ObClientSessionInfo::update_cached_variable(const ObString &var_name,
   return ret;
 }
 
+void ObClientSessionInfo::inc_sys_var_version(ObSessionSysField &field, int64_t &version)
+{
+  if (0 != field.version_) {
+    // the same value is set again, server sessions which have synced it need not sync again
+    ++same_value_sys_var_set_count_;
+  } else if (field.is_readonly() || !field.is_session_scope()) {
+    // it is never set to server sessions, only session pool clients compare its value
+    if (is_session_pool_client_) {
+      ++version;
+    }
+  } else {
+    field.version_ = ++version;
+  }
+}
+
 int ObClientSessionInfo::update_common_sys_variable(const ObString &var_name, const ObObj &value,
                                                     const bool is_need_insert, const bool is_oceanbase)
 {
@@ -546,12 +561,12 @@ int ObClientSessionInfo::update_common_sys_variable(const ObString &var_name, co
   } else {
     switch (field->modify_mod_) {
       case OB_FIELD_HOT_MODIFY_MOD: {
-        version_.inc_common_hot_sys_var_version();
+        inc_sys_var_version(*field, version_.common_hot_sys_var_version_);
         break;
       }
       case OB_FIELD_COLD_MODIFY_MOD: {
         if (!field->is_readonly() && field->is_session_scope()) {
-          version_.inc_common_sys_var_version();
+          inc_sys_var_version(*field, version_.common_sys_var_version_);
         }
         break;
       }
@@ -602,11 +617,11 @@ int ObClientSessionInfo::update_mysql_sys_variable(const ObString &var_name, con
       } else {
         switch (field->modify_mod_) {
           case OB_FIELD_HOT_MODIFY_MOD:
-            version_.inc_mysql_hot_sys_var_version();
+            inc_sys_var_version(*field, version_.mysql_hot_sys_var_version_);
             break;
           case OB_FIELD_COLD_MODIFY_MOD:
             if (!field->is_readonly() && field->is_session_scope()) {
-              version_.inc_mysql_sys_var_version();
+              inc_sys_var_version(*field, version_.mysql_sys_var_version_);
             }
             break;
           default: {
@@ -662,11 +677,11 @@ int ObClientSessionInfo::update_sys_variable(const ObString &var_name, const ObO
             version_.inc_last_insert_id_version();
             break;
           case OB_FIELD_HOT_MODIFY_MOD:
-            version_.inc_hot_sys_var_version();
+            inc_sys_var_version(*field, version_.hot_sys_var_version_);
             break;
           case OB_FIELD_COLD_MODIFY_MOD:
             if (!field->is_readonly() && field->is_session_scope()) {
-              version_.inc_sys_var_version();
+              inc_sys_var_version(*field, version_.sys_var_version_);
             }
             break;
           default: {
@@ -895,6 +910,53 @@ int ObClientSessionInfo::extract_all_variable_reset_sql(ObSqlString &sql)
   return ret;
 }
 
+int ObClientSessionInfo::extract_client_variable_sql(ObSqlString &sql)
+{
+  int ret = OB_SUCCESS;
+  sql.reset();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("client session is not inited", K(ret));
+  } else if (OB_FAIL(sql.append_fmt("SET"))) {
+    LOG_WARN("fail to append_fmt 'SET'", K(ret));
+  } else {
+    const int64_t prefix_len = sql.length();
+    // same order as extract_variable_reset_sql, the common vars are the newest
+    if (is_oceanbase_server()) {
+      if (OB_FAIL(field_mgr_.format_sys_var(sql))) {
+        LOG_WARN("fail to format_sys_var", K(sql), K(ret));
+      } else if (OB_FAIL(field_mgr_.format_hot_sys_var(sql))) {
+        LOG_WARN("fail to format_hot_sys_var", K(sql), K(ret));
+      }
+    } else {
+      if (OB_FAIL(field_mgr_.format_mysql_sys_var(sql))) {
+        LOG_WARN("fail to format_mysql_sys_var", K(sql), K(ret));
+      } else if (OB_FAIL(field_mgr_.format_mysql_hot_sys_var(sql))) {
+        LOG_WARN("fail to format_mysql_hot_sys_var", K(sql), K(ret));
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+      // do nothing
+    } else if (OB_FAIL(field_mgr_.format_common_sys_var(sql))) {
+      LOG_WARN("fail to format_common_sys_var", K(sql), K(ret));
+    } else if (OB_FAIL(field_mgr_.format_common_hot_sys_var(sql))) {
+      LOG_WARN("fail to format_common_hot_sys_var", K(sql), K(ret));
+    } else if (OB_FAIL(field_mgr_.format_user_var(sql))) {
+      LOG_WARN("fail to format_user_var", K(sql), K(ret));
+    } else if (sql.length() > prefix_len) {
+      *(sql.ptr() + sql.length() - 1) = ';'; //replace ',' with ';'
+    } else {
+      sql.reset();
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    sql.reset();
+  }
+  return ret;
+}
+
 int ObClientSessionInfo::extract_user_variable_reset_sql(ObServerSessionInfo &server_info,
                                                          ObSqlString &sql)
 {
@@ -964,11 +1026,16 @@ int ObClientSessionInfo::extract_variable_reset_sql(ObServerSessionInfo &server_
 
     // Attention!! need first set OB or MySQL var, then set common var
     // because OB or MySQL var set maybe have same var with common var set. But common var set is neweset
+    // so all the common vars are set again if any OB or MySQL var is set, otherwise only the
+    // common vars changed after the server session synced are set
+    const bool need_reset_all_common = need_reset;
     //reset cold common sys variable
     if (OB_SUCC(ret)) {
-      if (need_reset || need_reset_common_cold_session_vars(server_info)) {
+      if (need_reset_all_common || need_reset_common_cold_session_vars(server_info)) {
         need_reset = true;
-        if (OB_FAIL(field_mgr_.format_common_sys_var(sql))) {
+        const int64_t synced_version = need_reset_all_common ? OB_INVALID_VERSION
+            : get_synced_version(server_info.get_common_sys_var_version());
+        if (OB_FAIL(field_mgr_.format_common_sys_var(sql, synced_version))) {
           LOG_WARN("fail to format_common_sys_var.", K(sql), K(*this),
                    K(server_info), K(ret));
         }
@@ -977,9 +1044,11 @@ int ObClientSessionInfo::extract_variable_reset_sql(ObServerSessionInfo &server_
 
     //reset hot common sys variable
     if (OB_SUCC(ret)) {
-      if (need_reset || need_reset_common_hot_session_vars(server_info)) {
+      if (need_reset_all_common || need_reset_common_hot_session_vars(server_info)) {
         need_reset = true;
-        if (OB_FAIL(field_mgr_.format_common_hot_sys_var(sql))) {
+        const int64_t synced_version = need_reset_all_common ? OB_INVALID_VERSION
+            : get_synced_version(server_info.get_common_hot_sys_var_version());
+        if (OB_FAIL(field_mgr_.format_common_hot_sys_var(sql, synced_version))) {
           LOG_WARN("fail to format_common_hot_sys_var.", K(sql), K(*this),
                    K(server_info), K(ret));
         }
@@ -1018,7 +1087,8 @@ int ObClientSessionInfo::extract_mysql_variable_reset_sql(ObServerSessionInfo &s
   if (OB_SUCC(ret)) {
     if (need_reset_mysql_cold_session_vars(server_info)) {
       need_reset = true;
-      if (OB_FAIL(field_mgr_.format_mysql_sys_var(sql))) {
+      const int64_t synced_version = get_synced_version(server_info.get_mysql_sys_var_version());
+      if (OB_FAIL(field_mgr_.format_mysql_sys_var(sql, synced_version))) {
         LOG_WARN("fail to format_mysql_sys_var.", K(sql), K(*this),
                  K(server_info), K(ret));
       }
@@ -1029,7 +1099,8 @@ int ObClientSessionInfo::extract_mysql_variable_reset_sql(ObServerSessionInfo &s
   if (OB_SUCC(ret)) {
     if (need_reset_mysql_hot_session_vars(server_info)) {
       need_reset = true;
-      if (OB_FAIL(field_mgr_.format_mysql_hot_sys_var(sql))) {
+      const int64_t synced_version = get_synced_version(server_info.get_mysql_hot_sys_var_version());
+      if (OB_FAIL(field_mgr_.format_mysql_hot_sys_var(sql, synced_version))) {
         LOG_WARN("fail to format_mysql_hot_sys_var.", K(sql), K(*this),
                  K(server_info), K(ret));
       }
@@ -1060,7 +1131,8 @@ int ObClientSessionInfo::extract_oceanbase_variable_reset_sql(ObServerSessionInf
   if (OB_SUCC(ret)) {
     if (need_reset_cold_session_vars(server_info)) {
       need_reset = true;
-      if (OB_FAIL(field_mgr_.format_sys_var(sql))) {
+      const int64_t synced_version = get_synced_version(server_info.get_sys_var_version());
+      if (OB_FAIL(field_mgr_.format_sys_var(sql, synced_version))) {
         LOG_WARN("fail to format_sys_var.", K(sql), K(*this),
                  K(server_info), K(ret));
       }
@@ -1071,7 +1143,8 @@ int ObClientSessionInfo::extract_oceanbase_variable_reset_sql(ObServerSessionInf
   if (OB_SUCC(ret)) {
     if (need_reset_hot_session_vars(server_info)) {
       need_reset = true;
-      if (OB_FAIL(field_mgr_.format_hot_sys_var(sql))) {
+      const int64_t synced_version = get_synced_version(server_info.get_hot_sys_var_version());
+      if (OB_FAIL(field_mgr_.format_hot_sys_var(sql, synced_version))) {
         LOG_WARN("fail to format_hot_sys_var.", K(sql), K(*this),
                  K(server_info), K(ret));
       }
@@ -1306,6 +1379,7 @@ void ObClientSessionInfo::destroy()
   obproxy_route_addr_ = 0;
   safe_read_snapshot_ = 0;
   syncing_safe_read_snapshot_ = 0;
+  same_value_sys_var_set_count_ = 0;
   route_policy_ = 1;
   proxy_route_policy_ = MAX_PROXY_ROUTE_POLICY;
   client_cap_ = 0;
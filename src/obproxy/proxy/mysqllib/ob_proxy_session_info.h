@@ -534,6 +534,7 @@ public:
   int64_t get_sess_info_version() const { return version_.sess_info_version_; }
   SessFieldVersionHashMap& get_sess_field_version() { return version_.sess_field_version_; }
   int inc_sess_field_version(int16_t type) { return version_.inc_sess_field_version(type); }
+  int64_t get_same_value_sys_var_set_count() const { return same_value_sys_var_set_count_; }
 
 
   void set_db_name_version(const int64_t version) { version_.db_name_version_ = version; }
@@ -619,12 +620,23 @@ public:
   int get_all_user_vars(common::ObIArray<ObSessionBaseField> &fileds);
 
   int extract_all_variable_reset_sql(common::ObSqlString &sql);
+  // every variable set by the client, whatever version it has, for a server session
+  // which has synced nothing, empty if the client has set nothing
+  int extract_client_variable_sql(common::ObSqlString &sql);
   int extract_variable_reset_sql(ObServerSessionInfo &server_info, common::ObSqlString &sql);
   int extract_user_variable_reset_sql(ObServerSessionInfo &server_info, ObSqlString &sql);
   int extract_oceanbase_variable_reset_sql(ObServerSessionInfo &server_info,
                                            common::ObSqlString &sql, bool &need_reset);
   int extract_mysql_variable_reset_sql(ObServerSessionInfo &server_info,
                                        common::ObSqlString &sql, bool &need_reset);
+  // the version of a modify mod synced by the server session, session pool clients compare
+  // values instead of versions, so all the fields are formatted for them
+  int64_t get_synced_version(const int64_t server_version) const
+  {
+    return is_session_pool_client_ ? common::OB_INVALID_VERSION : server_version;
+  }
+  // bump the version of the modify mod only if the field got a new value, and stamp it
+  void inc_sys_var_version(ObSessionSysField &field, int64_t &version);
   int extract_changed_schema(ObServerSessionInfo &server_info, common::ObString &db_name);
   int extract_last_insert_id_reset_sql(ObServerSessionInfo &server_info, common::ObSqlString &sql);
 
@@ -1011,6 +1023,9 @@ private:
 
   ObProxyLoginUserType user_identity_;
   ObSessionVarVersion version_;
+  // count of sys variable updates which set the value a field already had, so the version
+  // was not bumped for them. it does not tell how many sync round trips were saved
+  int64_t same_value_sys_var_set_count_;
   // cached variables
   obutils::ObCachedVariables cached_variables_;
   // global variables version, will be set at the first time get login responce(OK packet)
@@ -36,6 +36,143 @@ static const ObString hot_var_names[] = { ObString(OB_SV_AUTOCOMMIT),
                                         };
 static const int64_t MAX_HOT_MODIFY_VARIABLES_NUM = ARRAYSIZEOF(hot_var_names);
 
+// the id of a known system variable is its index in this table
+static const ObString sys_var_id_names[] = { ObString(OB_SV_AUTO_INCREMENT_INCREMENT),
+                                             ObString(OB_SV_AUTO_INCREMENT_OFFSET),
+                                             ObString(OB_SV_AUTOCOMMIT),
+                                             ObString(OB_SV_CHARACTER_SET_CLIENT),
+                                             ObString(OB_SV_CHARACTER_SET_CONNECTION),
+                                             ObString(OB_SV_CHARACTER_SET_DATABASE),
+                                             ObString(OB_SV_CHARACTER_SET_RESULTS),
+                                             ObString(OB_SV_CHARACTER_SET_SERVER),
+                                             ObString(OB_SV_CHARACTER_SET_SYSTEM),
+                                             ObString(OB_SV_COLLATION_CONNECTION),
+                                             ObString(OB_SV_COLLATION_DATABASE),
+                                             ObString(OB_SV_COLLATION_SERVER),
+                                             ObString(OB_SV_INTERACTIVE_TIMEOUT),
+                                             ObString(OB_SV_LAST_INSERT_ID),
+                                             ObString(OB_SV_MAX_ALLOWED_PACKET),
+                                             ObString(OB_SV_SQL_MODE),
+                                             ObString(OB_SV_TIME_ZONE),
+                                             ObString(OB_SV_TX_ISOLATION),
+                                             ObString(OB_SV_VERSION_COMMENT),
+                                             ObString(OB_SV_WAIT_TIMEOUT),
+                                             ObString(OB_SV_BINLOG_ROW_IMAGE),
+                                             ObString(OB_SV_CHARACTER_SET_FILESYSTEM),
+                                             ObString(OB_SV_CONNECT_TIMEOUT),
+                                             ObString(OB_SV_DATADIR),
+                                             ObString(OB_SV_DEBUG_SYNC),
+                                             ObString(OB_SV_DIV_PRECISION_INCREMENT),
+                                             ObString(OB_SV_EXPLICIT_DEFAULTS_FOR_TIMESTAMP),
+                                             ObString(OB_SV_GROUP_CONCAT_MAX_LEN),
+                                             ObString(OB_SV_IDENTITY),
+                                             ObString(OB_SV_LOWER_CASE_TABLE_NAMES),
+                                             ObString(OB_SV_NET_READ_TIMEOUT),
+                                             ObString(OB_SV_NET_WRITE_TIMEOUT),
+                                             ObString(OB_SV_READ_ONLY),
+                                             ObString(OB_SV_SQL_AUTO_IS_NULL),
+                                             ObString(OB_SV_SQL_SELECT_LIMIT),
+                                             ObString(OB_SV_TIMESTAMP),
+                                             ObString(OB_SV_TX_READ_ONLY),
+                                             ObString(OB_SV_VERSION),
+                                             ObString(OB_SV_SQL_WARNINGS),
+                                             ObString(OB_SV_MAX_USER_CONNECTIONS),
+                                             ObString(OB_SV_INIT_CONNECT),
+                                             ObString(OB_SV_LICENSE),
+                                             ObString(OB_SV_NET_BUFFER_LENGTH),
+                                             ObString(OB_SV_SYSTEM_TIME_ZONE),
+                                             ObString(OB_SV_QUERY_CACHE_SIZE),
+                                             ObString(OB_SV_QUERY_CACHE_TYPE),
+                                             ObString(OB_SV_DEFAULT_REPLICA_NUM),
+                                             ObString(OB_SV_INTERM_RESULT_MEM_LIMIT),
+                                             ObString(OB_SV_PROXY_PARTITION_HIT),
+                                             ObString(OB_SV_LOG_LEVEL),
+                                             ObString(OB_SV_MAX_PARALLEL_DEGREE),
+                                             ObString(OB_SV_QUERY_TIMEOUT),
+                                             ObString(OB_SV_READ_CONSISTENCY),
+                                             ObString(OB_SV_ENABLE_TRANSFORMATION),
+                                             ObString(OB_SV_TRX_TIMEOUT),
+                                             ObString(OB_SV_ENABLE_PLAN_CACHE),
+                                             ObString(OB_SV_ENABLE_INDEX_DIRECT_SELECT),
+                                             ObString(OB_SV_PROXY_SET_TRX_EXECUTED),
+                                             ObString(OB_SV_PROXY_SESSION_TEMPORARY_TABLE_USED),
+                                             ObString(OB_SV_ENABLE_AGGREGATION_PUSHDOWN),
+                                             ObString(OB_SV_LAST_SCHEMA_VERSION),
+                                             ObString(OB_SV_GLOBAL_DEBUG_SYNC),
+                                             ObString(OB_SV_PROXY_GLOBAL_VARIABLES_VERSION),
+                                             ObString(OB_SV_ENABLE_TRACE_LOG),
+                                             ObString(OB_SV_ENABLE_HASH_GROUP_BY),
+                                             ObString(OB_SV_ENABLE_BLK_NESTEDLOOP_JOIN),
+                                             ObString(OB_SV_BNL_JOIN_CACHE_SIZE),
+                                             ObString(OB_SV_PROXY_USER_PRIVILEGE),
+                                             ObString(OB_SV_ORG_CLUSTER_ID),
+                                             ObString(OB_SV_PLAN_CACHE_PERCENTAGE),
+                                             ObString(OB_SV_PLAN_CACHE_EVICT_HIGH_PERCENTAGE),
+                                             ObString(OB_SV_PLAN_CACHE_EVICT_LOW_PERCENTAGE),
+                                             ObString(OB_SV_CAPABILITY_FLAG),
+                                             ObString(OB_SV_SAFE_WEAK_READ_SNAPSHOT),
+                                             ObString(OB_SV_ROUTE_POLICY),
+                                             ObString(OB_SV_ENABLE_TRANSMISSION_CHECKSUM),
+                                             ObString(OB_SV_STATEMENT_TRACE_ID),
+                                             ObString(OB_SV_CLIENT_REROUTE_INFO),
+                                             ObString(OB_SV_NLS_DATE_FORMAT),
+                                             ObString(OB_SV_NLS_TIMESTAMP_FORMAT),
+                                             ObString(OB_SV_NLS_TIMESTAMP_TZ_FORMAT)
+                                           };
+static const int64_t SYS_VAR_ID_NUM = ARRAYSIZEOF(sys_var_id_names);
+STATIC_ASSERT(SYS_VAR_ID_NUM <= ObSysVarIdMap::MAX_SYS_VAR_ID_NUM, "too many sys var ids");
+
+// open addressing name hash table of the sys var ids, built once on first use
+class ObSysVarIdHashTable
+{
+public:
+  ObSysVarIdHashTable()
+  {
+    MEMSET(ids_, -1, sizeof(ids_));
+    for (int64_t id = 0; id < SYS_VAR_ID_NUM; ++id) {
+      uint64_t pos = sys_var_id_names[id].hash() & SLOT_MASK;
+      while (ids_[pos] >= 0) {
+        pos = (pos + 1) & SLOT_MASK;
+      }
+      ids_[pos] = static_cast<int16_t>(id);
+    }
+  }
+
+  int64_t get_id(const ObString &name) const
+  {
+    int64_t ret_id = ObSysVarIdMap::INVALID_SYS_VAR_ID;
+    uint64_t pos = name.hash() & SLOT_MASK;
+    for (; ids_[pos] >= 0; pos = (pos + 1) & SLOT_MASK) {
+      if (sys_var_id_names[ids_[pos]] == name) {
+        ret_id = ids_[pos];
+        break;
+      }
+    }
+    return ret_id;
+  }
+
+private:
+  static const int64_t SLOT_NUM = 256; // keep the load factor below 0.4
+  static const uint64_t SLOT_MASK = SLOT_NUM - 1;
+  int16_t ids_[SLOT_NUM];
+};
+
+int64_t ObSysVarIdMap::get_sys_var_id(const ObString &name)
+{
+  static const ObSysVarIdHashTable id_table;
+  return name.empty() ? INVALID_SYS_VAR_ID : id_table.get_id(name);
+}
+
+ObString ObSysVarIdMap::get_sys_var_name(const int64_t id)
+{
+  return (id >= 0 && id < SYS_VAR_ID_NUM) ? sys_var_id_names[id] : ObString();
+}
+
+int64_t ObSysVarIdMap::get_sys_var_id_count()
+{
+  return SYS_VAR_ID_NUM;
+}
+
 inline int ObDefaultSysVarSet::load_sysvar_int(const ObString &var_name,
                                                const int64_t var_value,
                                                const int64_t flags,
@@ -147,6 +284,7 @@ void ObSessionBaseField::reset()
   name_len_ = 0;
   stat_ = OB_FIELD_EMPTY;
   value_.reset();
+  version_ = 0;
 }
 
 int ObSessionBaseField::move_strings(ObFieldStrHeap &new_heap)
@@ -245,7 +383,7 @@ DEF_TO_STRING(ObSessionBaseField)
   int64_t pos = 0;
   ObString name(name_len_, name_);
   J_OBJ_START();
-  J_KV(K_(stat), K(name), K_(name_len), K_(value), K_(modify_mod));
+  J_KV(K_(stat), K(name), K_(name_len), K_(value), K_(modify_mod), K_(version));
   J_OBJ_END();
   return pos;
 }
@@ -383,6 +521,9 @@ int ObSessionFieldMgr::init()
     str_block_list_tail_ = str_first_block_;
     common_sys_block_list_tail_ = common_sys_first_block_;
     mysql_sys_block_list_tail_ = mysql_sys_first_block_;
+    sys_field_idx_.reset();
+    common_sys_field_idx_.reset();
+    mysql_sys_field_idx_.reset();
     is_inited_ = true;
   }
   return ret;
@@ -398,6 +539,9 @@ void ObSessionFieldMgr::destroy()
   common_sys_first_block_ = NULL;
   mysql_sys_block_list_tail_ = NULL;
   mysql_sys_first_block_ = NULL;
+  sys_field_idx_.reset();
+  common_sys_field_idx_.reset();
+  mysql_sys_field_idx_.reset();
   if (NULL != default_sys_var_set_) {
     default_sys_var_set_->dec_ref();
     default_sys_var_set_ = NULL;
@@ -742,6 +886,7 @@ int ObSessionFieldMgr::insert_common_sys_variable(const ObString &name, const Ob
       } else {
         new_field->stat_ = OB_FIELD_USED;
         field = new_field;
+        common_sys_field_idx_.set_field(name, new_field);
         if (is_reused) {
           block_out->dec_removed_count();
         }
@@ -765,7 +910,7 @@ int ObSessionFieldMgr::update_common_sys_variable(const ObObj &value, ObSessionS
   } else if (OB_ISNULL(res_cell)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("res_cell is null , which is unexpected", K(ret));
-  } else if (OB_FAIL(update_field_value(*res_cell, field->value_))) {
+  } else if (OB_FAIL(update_sys_field_value(*res_cell, *field))) {
     LOG_WARN("fail to update field value", K(*res_cell), K(field->value_), K(ret));
   }
 
@@ -845,6 +990,7 @@ int ObSessionFieldMgr::insert_mysql_system_variable(const ObString &name, const
     } else {
       new_field->stat_ = OB_FIELD_USED;
       field = new_field;
+      mysql_sys_field_idx_.set_field(name, new_field);
       if (is_reused) {
         block_out->dec_removed_count();
       }
@@ -865,7 +1011,7 @@ int ObSessionFieldMgr::update_mysql_system_variable(const ObString &name, const
         LOG_WARN("fail to insert mysql system variable", K(name), K(value), K(ret));
       }
     }
-  } else if (OB_FAIL(update_field_value(value, field->value_))) {
+  } else if (OB_FAIL(update_sys_field_value(value, *field))) {
     LOG_WARN("fail to update field value", K(name), K(value), K(ret));
   }
   return ret;
@@ -911,6 +1057,7 @@ int ObSessionFieldMgr::update_system_variable(const ObString &name, const ObObj
           } else {
             new_field->stat_ = OB_FIELD_USED;
             field = new_field;
+            sys_field_idx_.set_field(name, new_field);
             if (is_reused) {
               block_out->dec_removed_count();
             }
@@ -928,7 +1075,7 @@ int ObSessionFieldMgr::update_system_variable(const ObString &name, const ObObj
       } else if (OB_ISNULL(res_cell)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("res_call is null , which is unexpected", K(ret));
-      } else if (OB_FAIL(update_field_value(*res_cell, field->value_))) {
+      } else if (OB_FAIL(update_sys_field_value(*res_cell, *field))) {
         LOG_WARN("fail to update field value", K(*res_cell), K(field->value_), K(ret));
       }
     } else if (OB_FAIL(ret)) {
@@ -1211,6 +1358,11 @@ int ObSessionFieldMgr::remove_variable_common(const common::ObString &name, ObSe
         field_ptr->reset();
         block->inc_removed_count();
       } else {
+        if (OB_SESSION_COMMON_SYS_VAR == var_type) {
+          common_sys_field_idx_.set_field(sys_field_ptr->get_variable_name_str(), NULL);
+        } else {
+          mysql_sys_field_idx_.set_field(sys_field_ptr->get_variable_name_str(), NULL);
+        }
         field_heap_->free_obj(sys_field_ptr->value_);
         field_heap_->free_string(sys_field_ptr->name_, sys_field_ptr->name_len_);
         sys_field_ptr->reset();
@@ -1439,34 +1591,34 @@ int ObSessionFieldMgr::format_all_var(ObSqlString &sql) const
   return ret;
 }
 
-int ObSessionFieldMgr::format_common_sys_var(ObSqlString &sql) const
+int ObSessionFieldMgr::format_common_sys_var(ObSqlString &sql, const int64_t synced_version) const
 {
-  return format_var(common_sys_first_block_, sql, OB_FIELD_COLD_MODIFY_MOD);
+  return format_var(common_sys_first_block_, sql, OB_FIELD_COLD_MODIFY_MOD, synced_version);
 }
 
-int ObSessionFieldMgr::format_common_hot_sys_var(ObSqlString &sql) const
+int ObSessionFieldMgr::format_common_hot_sys_var(ObSqlString &sql, const int64_t synced_version) const
 {
-  return format_var(common_sys_first_block_, sql, OB_FIELD_HOT_MODIFY_MOD);
+  return format_var(common_sys_first_block_, sql, OB_FIELD_HOT_MODIFY_MOD, synced_version);
 }
 
-int ObSessionFieldMgr::format_mysql_sys_var(ObSqlString &sql) const
+int ObSessionFieldMgr::format_mysql_sys_var(ObSqlString &sql, const int64_t synced_version) const
 {
-  return format_var(mysql_sys_first_block_, sql, OB_FIELD_COLD_MODIFY_MOD);
+  return format_var(mysql_sys_first_block_, sql, OB_FIELD_COLD_MODIFY_MOD, synced_version);
 }
 
-int ObSessionFieldMgr::format_mysql_hot_sys_var(ObSqlString &sql) const
+int ObSessionFieldMgr::format_mysql_hot_sys_var(ObSqlString &sql, const int64_t synced_version) const
 {
-  return format_var(mysql_sys_first_block_, sql, OB_FIELD_HOT_MODIFY_MOD);
+  return format_var(mysql_sys_first_block_, sql, OB_FIELD_HOT_MODIFY_MOD, synced_version);
 }
 
-int ObSessionFieldMgr::format_sys_var(ObSqlString &sql) const
+int ObSessionFieldMgr::format_sys_var(ObSqlString &sql, const int64_t synced_version) const
 {
-  return format_var(sys_first_block_, sql, OB_FIELD_COLD_MODIFY_MOD);
+  return format_var(sys_first_block_, sql, OB_FIELD_COLD_MODIFY_MOD, synced_version);
 }
 
-int ObSessionFieldMgr::format_hot_sys_var(ObSqlString &sql) const
+int ObSessionFieldMgr::format_hot_sys_var(ObSqlString &sql, const int64_t synced_version) const
 {
-  return format_var(sys_first_block_, sql, OB_FIELD_HOT_MODIFY_MOD);
+  return format_var(sys_first_block_, sql, OB_FIELD_HOT_MODIFY_MOD, synced_version);
 }
 
 int ObSessionFieldMgr::format_last_insert_id(ObSqlString &sql) const
@@ -1647,6 +1799,20 @@ int ObSessionFieldMgr::update_field_value(const ObObj &src_obj, ObObj &dest_obj)
   return ret;
 }
 
+int ObSessionFieldMgr::update_sys_field_value(const ObObj &value, ObSessionSysField &field)
+{
+  int ret = OB_SUCCESS;
+  if (value.get_type() == field.value_.get_type()
+      && value.is_equal(field.value_, CS_TYPE_BINARY)) {
+    // same value, the server sessions synced this field need not sync it again
+  } else if (OB_FAIL(update_field_value(value, field.value_))) {
+    LOG_WARN("fail to update field value", K(value), K(field), K(ret));
+  } else {
+    field.version_ = 0;
+  }
+  return ret;
+}
+
 int ObSessionFieldMgr::remove_str_field(const ObVFieldType type)
 {
   int ret = OB_SUCCESS;
@@ -2001,43 +2167,47 @@ int ObSessionFieldMgr::get_sys_variable_from_block(const ObString &name, ObSessi
   return ret;
 }
 
+int ObSessionFieldMgr::get_sys_variable_from_idx(const ObString &name, ObSessionSysField *&value,
+                                                 const ObSysVarFieldIdx &field_idx,
+                                                 const ObSysVarFieldBlock *block) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t id = ObSysVarIdMap::get_sys_var_id(name);
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not inited", K(ret));
+  } else if (ObSysVarIdMap::INVALID_SYS_VAR_ID == id) {
+    ret = get_sys_variable_from_block(name, value, block);
+  } else {
+    ObSessionSysField *field = field_idx.get_field(id);
+    if (NULL == field) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      value = field;
+    }
+  }
+  return ret;
+}
+
 int ObSessionFieldMgr::get_common_sys_variable(const ObString &name, ObSessionSysField *&value) const
 {
-  return get_sys_variable_from_block(name, value, common_sys_first_block_);
+  return get_sys_variable_from_idx(name, value, common_sys_field_idx_, common_sys_first_block_);
 }
 
 int ObSessionFieldMgr::get_mysql_sys_variable(const ObString &name, ObSessionSysField *&value) const
 {
-  return get_sys_variable_from_block(name, value, mysql_sys_first_block_);
+  return get_sys_variable_from_idx(name, value, mysql_sys_field_idx_, mysql_sys_first_block_);
 }
 
 int ObSessionFieldMgr::get_sys_variable_local(const ObString &name, ObSessionSysField *&value) const
 {
-  return get_sys_variable_from_block(name, value, sys_first_block_);
+  return get_sys_variable_from_idx(name, value, sys_field_idx_, sys_first_block_);
 }
 
 bool ObSessionFieldMgr::sys_variable_exists_local(const ObString &var)
 {
-  bool is_exist = false;
   ObSessionSysField *field = NULL;
-  ObString var_name;
-  const ObSysVarFieldBlock *block = sys_first_block_;
-  if (OB_UNLIKELY(!is_inited_)) {
-    is_exist = false;
-  } else {
-    for (; !is_exist && NULL != block; block = block->next_) {
-      for (int64_t i = 0; !is_exist && i < block->free_idx_; ++i) {
-        field = const_cast<ObSessionSysField *>(block->field_slots_ + i);
-        if (OB_FIELD_USED == field->stat_) {
-          var_name.assign(const_cast<char *>(field->name_), field->name_len_);
-          if (var_name == var) {
-            is_exist = true;
-          }
-        }
-      }
-    }
-  }
-  return is_exist;
+  return is_inited_ && OB_SUCCESS == get_sys_variable_local(var, field);
 }
 
 bool ObSessionFieldMgr::is_hot_modified_variable(const ObString &var_name)
@@ -2154,6 +2324,7 @@ int ObSessionFieldMgr::remove_sys_variable(const common::ObString &name)
     if (OB_ENTRY_NOT_EXIST == (ret = get_sys_variable(name, field_ptr, block))) {
       LOG_DEBUG("sys_variable is not exist", K(name), K(ret));
     } else if (OB_SUCCESS == ret && NULL != field_ptr) {
+      sys_field_idx_.set_field(field_ptr->get_variable_name_str(), NULL);
       field_heap_->free_obj(field_ptr->value_);
       field_heap_->free_string(field_ptr->name_, field_ptr->name_len_);
       field_ptr->reset();
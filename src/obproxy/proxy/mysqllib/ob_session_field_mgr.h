@@ -131,7 +131,7 @@ enum ObSessionFieldModifyMod
 struct ObSessionBaseField
 {
   ObSessionBaseField() : stat_(OB_FIELD_EMPTY), name_len_(0),
-                         name_(NULL), value_(), modify_mod_(OB_FIELD_COLD_MODIFY_MOD) {}
+                         name_(NULL), value_(), modify_mod_(OB_FIELD_COLD_MODIFY_MOD), version_(0) {}
   virtual ~ObSessionBaseField() {}
   virtual void reset();
   bool is_empty() const { return OB_FIELD_EMPTY == stat_; }
@@ -151,6 +151,10 @@ struct ObSessionBaseField
   const char *name_;
   common::ObObj value_;
   ObSessionFieldModifyMod modify_mod_;
+  // the version of its modify mod when the value was last changed, stamped by the client
+  // session info. it is 0 when the field is inserted or set to another value, and not
+  // changed when the same value is set again. a field left 0 is synced to every server session
+  int64_t version_;
 };
 
 struct ObSessionSysField : public ObSessionBaseField
@@ -186,7 +190,9 @@ struct ObFieldBlock : public ObFieldHeader
 
   int move_strings(ObFieldStrHeap *new_heap);
   int64_t strings_length();
-  int format(common::ObSqlString &sql, const ObSessionFieldModifyMod modify_mod) const;
+  // only format the fields changed after synced_version and the ones never stamped
+  int format(common::ObSqlString &sql, const ObSessionFieldModifyMod modify_mod,
+             const int64_t synced_version = common::OB_INVALID_VERSION) const;
   DECLARE_TO_STRING;
 
   const static int64_t FIELD_BLOCK_SLOTS_NUM = 16; //maybe a better value
@@ -232,12 +238,15 @@ int64_t ObFieldBlock<T, TYPE>::strings_length()
 
 template <class T, HeapObjType TYPE>
 int ObFieldBlock<T, TYPE>::format(common::ObSqlString &sql,
-                                  const ObSessionFieldModifyMod modify_mod) const
+                                  const ObSessionFieldModifyMod modify_mod,
+                                  const int64_t synced_version) const
 {
   int ret = common::OB_SUCCESS;
   for (int64_t i = 0; common::OB_SUCCESS == ret && i < free_idx_; ++i) {
     const T &field = field_slots_[i];
-    if (OB_FAIL(field.format(sql, modify_mod))) {
+    if (0 != field.version_ && field.version_ <= synced_version) {
+      // synced already, a field never stamped is always formatted
+    } else if (OB_FAIL(field.format(sql, modify_mod))) {
       PROXY_LOG(WARN, "fail to construct reset sql", K(field), K(ret));
     }
   }
@@ -264,6 +273,46 @@ typedef ObFieldBlock<ObSessionSysField, HEAP_OBJ_SYS_VAR_BLOCK>  ObSysVarFieldBl
 typedef ObFieldBlock<ObSessionUserField, HEAP_OBJ_USER_VAR_BLOCK>  ObUserVarFieldBlock;
 typedef ObFieldBlock<ObSessionVField, HEAP_OBJ_STR_BLOCK>  ObStrFieldBlock;
 
+// the known system variable names (sql::OB_SV_*) are interned to dense ids, so that
+// a session can index the fields of these variables by id instead of walking the
+// field blocks and comparing names. other names have no id and still walk the blocks.
+class ObSysVarIdMap
+{
+public:
+  static const int64_t INVALID_SYS_VAR_ID = -1;
+  static const int64_t MAX_SYS_VAR_ID_NUM = 96;
+
+  static int64_t get_sys_var_id(const common::ObString &name);
+  static common::ObString get_sys_var_name(const int64_t id);
+  static int64_t get_sys_var_id_count();
+};
+
+// fields of the known system variables in one field block list, indexed by sys var id
+class ObSysVarFieldIdx
+{
+public:
+  ObSysVarFieldIdx() { reset(); }
+  ~ObSysVarFieldIdx() {}
+  void reset() { MEMSET(fields_, 0, sizeof(fields_)); }
+
+  // return NULL if no field of this id is set or it has been removed
+  ObSessionSysField *get_field(const int64_t id) const
+  {
+    ObSessionSysField *field = fields_[id];
+    return (NULL != field && OB_FIELD_USED == field->stat_) ? field : NULL;
+  }
+  void set_field(const common::ObString &name, ObSessionSysField *field)
+  {
+    const int64_t id = ObSysVarIdMap::get_sys_var_id(name);
+    if (ObSysVarIdMap::INVALID_SYS_VAR_ID != id) {
+      fields_[id] = field;
+    }
+  }
+
+private:
+  ObSessionSysField *fields_[ObSysVarIdMap::MAX_SYS_VAR_ID_NUM];
+};
+
 class ObFieldBaseMgr
 {
 public:
@@ -456,13 +505,20 @@ public:
   int user_variable_exists(const common::ObString &name, bool &is_exist);
   int get_all_user_var_names(common::ObIArray<common::ObString> &names);
 
-  int format_common_sys_var(common::ObSqlString &sql) const;
-  int format_common_hot_sys_var(common::ObSqlString &sql) const;
-  int format_mysql_sys_var(common::ObSqlString &sql) const;
-  int format_mysql_hot_sys_var(common::ObSqlString &sql) const;
+  // the sys variables changed after synced_version are formatted, all of them by default
+  int format_common_sys_var(common::ObSqlString &sql,
+                            const int64_t synced_version = common::OB_INVALID_VERSION) const;
+  int format_common_hot_sys_var(common::ObSqlString &sql,
+                                const int64_t synced_version = common::OB_INVALID_VERSION) const;
+  int format_mysql_sys_var(common::ObSqlString &sql,
+                           const int64_t synced_version = common::OB_INVALID_VERSION) const;
+  int format_mysql_hot_sys_var(common::ObSqlString &sql,
+                               const int64_t synced_version = common::OB_INVALID_VERSION) const;
   int format_all_var(common::ObSqlString &sql) const;
-  int format_sys_var(common::ObSqlString &sql) const;
-  int format_hot_sys_var(common::ObSqlString &sql) const;
+  int format_sys_var(common::ObSqlString &sql,
+                     const int64_t synced_version = common::OB_INVALID_VERSION) const;
+  int format_hot_sys_var(common::ObSqlString &sql,
+                         const int64_t synced_version = common::OB_INVALID_VERSION) const;
   int format_user_var(common::ObSqlString &sql) const;
   int format_last_insert_id(common::ObSqlString &sql) const;
 
@@ -544,6 +600,8 @@ private:
   int insert_common_sys_variable(const common::ObString &name, const common::ObObj &value, bool is_oceanbase);
 
   int update_field_value(const common::ObObj &src, common::ObObj &dest_obj);
+  // keep the field and its version untouched if the value is the same
+  int update_sys_field_value(const common::ObObj &value, ObSessionSysField &field);
   int replace_str_field(const ObVFieldType type, const common::ObString &value);
   int remove_str_field(const ObVFieldType type);
   int insert_str_field(const ObVFieldType type, const common::ObString &value);
@@ -551,6 +609,9 @@ private:
   bool str_field_exists(const ObVFieldType type) const;
   int get_sys_variable_from_block(const common::ObString &name, ObSessionSysField *&value,
                                   const ObSysVarFieldBlock *block) const;
+  int get_sys_variable_from_idx(const common::ObString &name, ObSessionSysField *&value,
+                                const ObSysVarFieldIdx &field_idx,
+                                const ObSysVarFieldBlock *block) const;
   int get_common_sys_variable(const common::ObString &name, ObSessionSysField *&value) const;
   int get_mysql_sys_variable(const common::ObString &name, ObSessionSysField *&value) const;
   int get_sys_variable_local(const common::ObString &name, ObSessionSysField *&value) const;
@@ -558,7 +619,8 @@ private:
 
   template<typename T>
   int format_var(T *head, common::ObSqlString &sql,
-                 ObSessionFieldModifyMod modify_mod) const
+                 ObSessionFieldModifyMod modify_mod,
+                 const int64_t synced_version = common::OB_INVALID_VERSION) const
   {
     int ret = common::OB_SUCCESS;
     if (OB_UNLIKELY(!is_inited_)) {
@@ -567,7 +629,7 @@ private:
     } else {
       const T *block = head;
       for (; common::OB_SUCCESS == ret && NULL != block; block = block->next_) {
-        if (OB_FAIL(block->format(sql, modify_mod))) {
+        if (OB_FAIL(block->format(sql, modify_mod, synced_version))) {
           PROXY_LOG(WARN, "construct reset sql failed", K(ret));
         }
       }
@@ -670,6 +732,10 @@ private:
   ObSysVarFieldBlock *common_sys_first_block_;
   ObSysVarFieldBlock *mysql_sys_block_list_tail_; // mysql sys var
   ObSysVarFieldBlock *mysql_sys_first_block_;
+  // id indexed fields of the three sys var block lists above
+  ObSysVarFieldIdx sys_field_idx_;
+  ObSysVarFieldIdx common_sys_field_idx_;
+  ObSysVarFieldIdx mysql_sys_field_idx_;
   ObDefaultSysVarSet *default_sys_var_set_;
   bool allow_var_not_found_; //control log level when not find var
 };
@@ -124,9 +124,9 @@ int ObSysVarSetProcessor::init()
 void ObSysVarSetProcessor::destroy()
 {
   if (is_inited_) {
-    DRWLock::WRLockGuard lock(set_lock_);
-    release(sys_var_set_);
-    sys_var_set_ = NULL;
+    ObDefaultSysVarSet *old_set = ATOMIC_TAS(&sys_var_set_, NULL);
+    WaitQuiescent(qsync_);
+    release(old_set);
     is_inited_ = false;
   }
 }
@@ -194,12 +194,10 @@ int ObSysVarSetProcessor::swap(ObDefaultSysVarSet *sys_var_set)
     // processor holds it's own refcount. We should be the only
     // refcount holder at this point.
     sys_var_set->inc_ref();
-    ObDefaultSysVarSet *old_set = NULL;
-    {
-      DRWLock::WRLockGuard lock(set_lock_);
-      old_set = sys_var_set_;
-      sys_var_set_ = sys_var_set;
-    }
+    ObDefaultSysVarSet *old_set = ATOMIC_TAS(&sys_var_set_, sys_var_set);
+    // readers which loaded old_set may not have inc_ref it yet,
+    // wait them out before dropping our own refcount
+    WaitQuiescent(qsync_);
     if (OB_LIKELY(NULL != old_set)) {
       release(old_set);
     }
@@ -213,8 +211,8 @@ ObDefaultSysVarSet *ObSysVarSetProcessor::acquire()
   // own refcount, so it should be at least 2.
   ObDefaultSysVarSet *var_set = NULL;
   if (OB_LIKELY(is_inited_)) {
-    DRWLock::RDLockGuard lock(set_lock_);
-    if (OB_ISNULL(var_set = sys_var_set_)) {
+    CriticalGuard(qsync_);
+    if (OB_ISNULL(var_set = ATOMIC_LOAD(&sys_var_set_))) {
       LOG_ERROR("current system variable set is NULL");
     } else {
       var_set->inc_ref();
@@ -14,7 +14,7 @@
 #define OBPROXY_SYS_VAR_SET_PROCESSOR
 #include "lib/ob_define.h"
 #include "lib/ptr/ob_ptr.h"
-#include "lib/lock/ob_drw_lock.h"
+#include "lib/allocator/ob_qsync.h"
 #include "obutils/ob_async_common_task.h"
 
 namespace oceanbase
@@ -62,7 +62,9 @@ public:
   int add_sys_var_renew_task(obutils::ObClusterResource &cr);
   int renew_sys_var_set(obproxy::ObDefaultSysVarSet *set);
 
-  // acquire and release must be used in pairs
+  // acquire and release must be used in pairs.
+  // acquire takes no lock, it loads the current set inside a qsync critical
+  // section and swap waits the readers out before dropping the replaced set
   ObDefaultSysVarSet *acquire();
   void release(obproxy::ObDefaultSysVarSet *set);
   int swap(obproxy::ObDefaultSysVarSet *sys_var_set);
@@ -70,7 +72,7 @@ public:
 
 private:
   bool is_inited_;
-  common::DRWLock set_lock_;
+  common::ObQSync qsync_;
   ObDefaultSysVarSet *sys_var_set_;
   DISALLOW_COPY_AND_ASSIGN(ObSysVarSetProcessor);
 };
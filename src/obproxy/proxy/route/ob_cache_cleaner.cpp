@@ -207,6 +207,9 @@ int ObCacheCleaner::do_clean_job()
     switch (next_action_) {
       case IDLE_CLEAN_ACTION: {
         // begin to work
+        if (need_update_route_cache_stat()) {
+          update_route_cache_stat();
+        }
         next_action_ =  CLEAN_THREAD_CACHE_CONGESTION_ENTRY_ACTION;
         break;
       }
@@ -375,6 +378,27 @@ void ObCacheCleaner::clean_cluster_resource()
   }
 }
 
+static void set_route_cache_stat(const ObRouteCachePolicy &policy, const ObProcessorStats hit_stat_id)
+{
+  // the stats of one cache are in the order of hit, miss, evicted and hit ratio
+  (void)PROCESSOR_SET_GLOBAL_DYN_STAT(hit_stat_id, policy.get_hit_count());
+  (void)PROCESSOR_SET_GLOBAL_DYN_STAT(hit_stat_id + 1, policy.get_miss_count());
+  (void)PROCESSOR_SET_GLOBAL_DYN_STAT(hit_stat_id + 2, policy.get_eviction_count());
+  (void)PROCESSOR_SET_GLOBAL_DYN_STAT(hit_stat_id + 3, policy.get_hit_ratio_permille());
+}
+
+void ObCacheCleaner::update_route_cache_stat()
+{
+  set_route_cache_stat(table_cache_->get_policy(), TABLE_CACHE_LOOKUP_HIT);
+  set_route_cache_stat(partition_cache_->get_policy(), PARTITION_CACHE_LOOKUP_HIT);
+  set_route_cache_stat(routine_cache_->get_policy(), ROUTINE_CACHE_LOOKUP_HIT);
+  set_route_cache_stat(sql_table_cache_->get_policy(), SQL_TABLE_CACHE_LOOKUP_HIT);
+  LOG_DEBUG("route cache stat", "table_cache", table_cache_->get_policy(),
+            "partition_cache", partition_cache_->get_policy(),
+            "routine_cache", routine_cache_->get_policy(),
+            "sql_table_cache", sql_table_cache_->get_policy());
+}
+
 int64_t ObCacheCleaner::calc_table_entry_clean_count()
 {
   int64_t clean_count = 0; // the count of entry every mt partition should clean;
@@ -452,6 +476,74 @@ int ObCacheCleaner::clean_table_cache(bool &need_try_lock)
   return ret;
 }
 
+template <typename Elem>
+struct ObNewerEntryCmp
+{
+  bool operator() (const Elem &lhs, const Elem &rhs) const
+  {
+    return lhs.entry_->get_last_access_time_us() > rhs.entry_->get_last_access_time_us();
+  }
+};
+
+// keep the newest probation entries of the partition as the admission candidates,
+// the oldest of them on the top of the heap
+template <typename Elem, typename Entry>
+static void add_admission_candidate(Elem *candidates, int64_t &candidate_count,
+                                    const int64_t max_count, Entry *entry)
+{
+  ObNewerEntryCmp<Elem> cmp;
+  if (!ObRouteCachePolicy::is_protected(entry->get_frequency())) {
+    if (candidate_count < max_count) {
+      candidates[candidate_count++].entry_ = entry;
+      std::push_heap(candidates, candidates + candidate_count, cmp);
+    } else if (entry->get_last_access_time_us() > candidates[0].entry_->get_last_access_time_us()) {
+      std::pop_heap(candidates, candidates + max_count, cmp);
+      candidates[max_count - 1].entry_ = entry;
+      std::push_heap(candidates, candidates + max_count, cmp);
+    }
+  }
+}
+
+template <typename Elem, typename Entry>
+static bool is_victim(const Elem *victims, const int64_t victim_count, const Entry *entry)
+{
+  bool bret = false;
+  for (int64_t i = 0; !bret && i < victim_count; ++i) {
+    bret = (victims[i].entry_ == entry);
+  }
+  return bret;
+}
+
+// TinyLFU admission. The victims picked by the heap are the least recently accessed
+// probation entries, the candidates are the probation entries which came in last.
+// Each candidate competes with one victim and is evicted in place of it unless it is
+// more frequent, so a burst of one-off keys does not push out the reused entries.
+// Return the count of the rejected candidates.
+template <typename Elem>
+static int64_t admit_candidates(Elem *victims, const int64_t victim_count,
+                                const Elem *candidates, const int64_t candidate_count)
+{
+  int64_t rejected_count = 0;
+  int64_t j = 0;
+  for (int64_t i = 0; i < victim_count && j < candidate_count; ++i) {
+    if (NULL != victims[i].entry_ && !ObRouteCachePolicy::is_protected(victims[i].entry_->get_frequency())) {
+      // a candidate which is a victim itself does not compete
+      while (j < candidate_count && is_victim(victims, victim_count, candidates[j].entry_)) {
+        ++j;
+      }
+      if (j < candidate_count) {
+        if (!ObRouteCachePolicy::is_admitted(candidates[j].entry_->get_frequency(),
+                                             victims[i].entry_->get_frequency())) {
+          victims[i].entry_ = candidates[j].entry_;
+          ++rejected_count;
+        }
+        ++j;
+      }
+    }
+  }
+  return rejected_count;
+}
+
 struct ObTableEntryElem
 {
   ObTableEntryElem() : entry_(NULL) {}
@@ -466,7 +558,8 @@ struct ObTableEntryCmp
   {
     bool bret = false;
     if ((NULL != lhs.entry_) && (NULL != rhs.entry_)) {
-      bret = (lhs.entry_->get_last_access_time_us() <= rhs.entry_->get_last_access_time_us());
+      bret = ObRouteCachePolicy::is_colder(lhs.entry_->get_frequency(), lhs.entry_->get_last_access_time_us(),
+                                           rhs.entry_->get_frequency(), rhs.entry_->get_last_access_time_us());
     } else if (NULL != lhs.entry_) {
       bret = (lhs.entry_->get_last_access_time_us() <= 0);
     } else if (NULL != rhs.entry_) {
@@ -494,7 +587,8 @@ int ObCacheCleaner::clean_one_part_table_cache(const int64_t part_idx)
     MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
     if (lock.is_locked()) {
       int64_t tmp_clean_count = std::max(tc_part_clean_count_, 2L);
-      int64_t buf_len = sizeof(ObTableEntryElem) * tmp_clean_count;
+      // the victims and the admission candidates
+      int64_t buf_len = sizeof(ObTableEntryElem) * tmp_clean_count * 2;
       char *buf = static_cast<char *>(op_fixed_mem_alloc(buf_len));
       if (OB_ISNULL(buf)) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -504,10 +598,15 @@ int ObCacheCleaner::clean_one_part_table_cache(const int64_t part_idx)
       } else {
         // 1.make a smallest heap
         ObTableEntryElem *eles = new (buf) ObTableEntryElem[tmp_clean_count];
+        ObTableEntryElem *candidates = new (buf + sizeof(ObTableEntryElem) * tmp_clean_count)
+                                       ObTableEntryElem[tmp_clean_count];
+        int64_t candidate_count = 0;
         ObTableEntryElem tmp_ele;
         int64_t i = 0;
         entry = table_cache_->first_entry(part_idx, it);
         while (NULL != entry) {
+          // halve the frequency on every scan, so that protected entries which go cold are demoted
+          entry->age_frequency();
           if (entry->is_non_partition_table()) { // only non-partition table affect
             if (i < tmp_clean_count) {
               eles[i].entry_ = entry;
@@ -525,6 +624,9 @@ int ObCacheCleaner::clean_one_part_table_cache(const int64_t part_idx)
                 std::make_heap(eles, eles + tmp_clean_count, cmp);
               }
             }
+            if (!entry->is_dummy_entry() && entry->is_avail_state()) {
+              add_admission_candidate(candidates, candidate_count, tmp_clean_count, entry);
+            }
           }
 
           entry = table_cache_->next_entry(part_idx, it);
@@ -539,11 +641,12 @@ int ObCacheCleaner::clean_one_part_table_cache(const int64_t part_idx)
           int64_t dcount = part_entry_count - PART_TABLE_ENTRY_MIN_COUNT;
           tmp_clean_count = ((dcount >= 0) ? dcount : 0);
         }
+        const int64_t rejected_count = admit_candidates(eles, tmp_clean_count, candidates, candidate_count);
         LOG_INFO("begin to wash table entry partition", "wash_count",
-                 tmp_clean_count, K(part_entry_count), K(orig_clean_count), K(part_idx),
+                 tmp_clean_count, K(rejected_count), K(part_entry_count), K(orig_clean_count), K(part_idx),
                  LITERAL_K(PART_TABLE_ENTRY_MIN_COUNT));
 
-        // 3. remove the LRU entry
+        // 3. remove the coldest entry, probation segment first
         ObTableEntryKey key;
         for (int64_t i = 0; i < tmp_clean_count; ++i) {
           entry = eles[i].entry_;
@@ -553,8 +656,13 @@ int ObCacheCleaner::clean_one_part_table_cache(const int64_t part_idx)
             LOG_INFO("this table entry will be washed", KPC(entry));
             key.reset();
             entry->get_key(key);
+            // the entry may be freed once removed
+            const uint64_t hash = key.hash();
+            const int64_t frequency = entry->get_frequency();
             if (OB_FAIL(table_cache_->remove_table_entry(key))) {
               LOG_WARN("fail to remote table entry", KPC(entry));
+            } else {
+              table_cache_->get_policy().record_eviction(hash, frequency);
             }
           }
         }
@@ -621,7 +729,8 @@ struct ObPartitionEntryCmp
   {
     bool bret = false;
     if ((NULL != lhs.entry_) && (NULL != rhs.entry_)) {
-      bret = (lhs.entry_->get_last_access_time_us() <= rhs.entry_->get_last_access_time_us());
+      bret = ObRouteCachePolicy::is_colder(lhs.entry_->get_frequency(), lhs.entry_->get_last_access_time_us(),
+                                           rhs.entry_->get_frequency(), rhs.entry_->get_last_access_time_us());
     } else if (NULL != lhs.entry_) {
       bret = (lhs.entry_->get_last_access_time_us() <= 0);
     } else if (NULL != rhs.entry_) {
@@ -649,7 +758,8 @@ int ObCacheCleaner::clean_one_sub_bucket_partition_cache(const int64_t bucket_id
     MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
     if (lock.is_locked()) {
       int64_t tmp_clean_count = std::max(clean_count, 2L);
-      int64_t buf_len = sizeof(ObPartitionEntryElem) * tmp_clean_count;
+      // the victims and the admission candidates
+      int64_t buf_len = sizeof(ObPartitionEntryElem) * tmp_clean_count * 2;
       char *buf = static_cast<char *>(op_fixed_mem_alloc(buf_len));
       if (OB_ISNULL(buf)) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -659,10 +769,15 @@ int ObCacheCleaner::clean_one_sub_bucket_partition_cache(const int64_t bucket_id
       } else {
         // 1.make a smallest heap
         ObPartitionEntryElem *eles = new (buf) ObPartitionEntryElem[tmp_clean_count];
+        ObPartitionEntryElem *candidates = new (buf + sizeof(ObPartitionEntryElem) * tmp_clean_count)
+                                           ObPartitionEntryElem[tmp_clean_count];
+        int64_t candidate_count = 0;
         ObPartitionEntryElem tmp_ele;
         int64_t i = 0;
         entry = partition_cache_->first_entry(bucket_idx, it);
         while (NULL != entry) {
+          // halve the frequency on every scan, so that protected entries which go cold are demoted
+          entry->age_frequency();
           if (i < tmp_clean_count) {
             eles[i].entry_ = entry;
             ++i;
@@ -679,6 +794,9 @@ int ObCacheCleaner::clean_one_sub_bucket_partition_cache(const int64_t bucket_id
               std::make_heap(eles, eles + tmp_clean_count, cmp);
             }
           }
+          if (entry->is_avail_state()) {
+            add_admission_candidate(candidates, candidate_count, tmp_clean_count, entry);
+          }
 
           entry = partition_cache_->next_entry(bucket_idx, it);
         }
@@ -692,11 +810,12 @@ int ObCacheCleaner::clean_one_sub_bucket_partition_cache(const int64_t bucket_id
           int64_t dcount = part_entry_count - PART_PARTITION_ENTRY_MIN_COUNT;
           tmp_clean_count = ((dcount >= 0) ? dcount : 0);
         }
+        const int64_t rejected_count = admit_candidates(eles, tmp_clean_count, candidates, candidate_count);
         LOG_INFO("begin to wash partition entry", "wash_count",
-                 tmp_clean_count, K(part_entry_count), K(orig_clean_count), K(bucket_idx),
+                 tmp_clean_count, K(rejected_count), K(part_entry_count), K(orig_clean_count), K(bucket_idx),
                  LITERAL_K(PART_PARTITION_ENTRY_MIN_COUNT));
 
-        // 3. remove the LRU entry
+        // 3. remove the coldest entry, probation segment first
         ObPartitionEntryKey key;
         for (int64_t i = 0; (i < tmp_clean_count) && OB_SUCC(ret); ++i) {
           entry = eles[i].entry_;
@@ -706,8 +825,13 @@ int ObCacheCleaner::clean_one_sub_bucket_partition_cache(const int64_t bucket_id
             LOG_INFO("this partition entry will be washed", KPC(entry));
             key.reset();
             key = entry->get_key();
+            // the entry may be freed once removed
+            const uint64_t hash = key.hash();
+            const int64_t frequency = entry->get_frequency();
             if (OB_FAIL(partition_cache_->remove_partition_entry(key))) {
               LOG_WARN("fail to remove partition entry", KPC(entry), K(ret));
+            } else {
+              partition_cache_->get_policy().record_eviction(hash, frequency);
             }
           }
         }
@@ -1362,7 +1486,8 @@ struct ObRoutineEntryCmp
   {
     bool bret = false;
     if ((NULL != lhs.entry_) && (NULL != rhs.entry_)) {
-      bret = (lhs.entry_->get_last_access_time_us() <= rhs.entry_->get_last_access_time_us());
+      bret = ObRouteCachePolicy::is_colder(lhs.entry_->get_frequency(), lhs.entry_->get_last_access_time_us(),
+                                           rhs.entry_->get_frequency(), rhs.entry_->get_last_access_time_us());
     } else if (NULL != lhs.entry_) {
       bret = (lhs.entry_->get_last_access_time_us() <= 0);
     } else if (NULL != rhs.entry_) {
@@ -1390,7 +1515,8 @@ int ObCacheCleaner::clean_one_sub_bucket_routine_cache(const int64_t bucket_idx,
     MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
     if (lock.is_locked()) {
       int64_t tmp_clean_count = std::max(clean_count, 2L);
-      int64_t buf_len = sizeof(ObRoutineEntryElem) * tmp_clean_count;
+      // the victims and the admission candidates
+      int64_t buf_len = sizeof(ObRoutineEntryElem) * tmp_clean_count * 2;
       char *buf = static_cast<char *>(op_fixed_mem_alloc(buf_len));
       if (OB_ISNULL(buf)) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -1400,10 +1526,15 @@ int ObCacheCleaner::clean_one_sub_bucket_routine_cache(const int64_t bucket_idx,
       } else {
         // 1.make a smallest heap
         ObRoutineEntryElem *eles = new (buf) ObRoutineEntryElem[tmp_clean_count];
+        ObRoutineEntryElem *candidates = new (buf + sizeof(ObRoutineEntryElem) * tmp_clean_count)
+                                         ObRoutineEntryElem[tmp_clean_count];
+        int64_t candidate_count = 0;
         ObRoutineEntryElem tmp_ele;
         int64_t i = 0;
         entry = routine_cache_->first_entry(bucket_idx, it);
         while (NULL != entry) {
+          // halve the frequency on every scan, so that protected entries which go cold are demoted
+          entry->age_frequency();
           if (i < tmp_clean_count) {
             eles[i].entry_ = entry;
             ++i;
@@ -1420,6 +1551,9 @@ int ObCacheCleaner::clean_one_sub_bucket_routine_cache(const int64_t bucket_idx,
               std::make_heap(eles, eles + tmp_clean_count, cmp);
             }
           }
+          if (entry->is_avail_state()) {
+            add_admission_candidate(candidates, candidate_count, tmp_clean_count, entry);
+          }
 
           entry = routine_cache_->next_entry(bucket_idx, it);
         }
@@ -1433,11 +1567,12 @@ int ObCacheCleaner::clean_one_sub_bucket_routine_cache(const int64_t bucket_idx,
           int64_t dcount = part_entry_count - PART_ROUTINE_ENTRY_MIN_COUNT;
           tmp_clean_count = ((dcount >= 0) ? dcount : 0);
         }
+        const int64_t rejected_count = admit_candidates(eles, tmp_clean_count, candidates, candidate_count);
         LOG_INFO("begin to wash routine entry", "wash_count",
-                 tmp_clean_count, K(part_entry_count), K(orig_clean_count), K(bucket_idx),
+                 tmp_clean_count, K(rejected_count), K(part_entry_count), K(orig_clean_count), K(bucket_idx),
                  LITERAL_K(PART_ROUTINE_ENTRY_MIN_COUNT));
 
-        // 3. remove the LRU entry
+        // 3. remove the coldest entry, probation segment first
         ObRoutineEntryKey key;
         for (int64_t i = 0; (i < tmp_clean_count) && OB_SUCC(ret); ++i) {
           entry = eles[i].entry_;
@@ -1447,8 +1582,13 @@ int ObCacheCleaner::clean_one_sub_bucket_routine_cache(const int64_t bucket_idx,
             LOG_INFO("this routine entry will be washed", KPC(entry));
             key.reset();
             entry->get_key(key);
+            // the entry may be freed once removed
+            const uint64_t hash = key.hash();
+            const int64_t frequency = entry->get_frequency();
             if (OB_FAIL(routine_cache_->remove_routine_entry(key))) {
               LOG_WARN("fail to remove routine entry", KPC(entry), K(ret));
+            } else {
+              routine_cache_->get_policy().record_eviction(hash, frequency);
             }
           }
         }
@@ -1535,7 +1675,8 @@ struct ObSqlTableEntryCmp
   {
     bool bret = false;
     if ((NULL != lhs.entry_) && (NULL != rhs.entry_)) {
-      bret = (lhs.entry_->get_last_access_time_us() <= rhs.entry_->get_last_access_time_us());
+      bret = ObRouteCachePolicy::is_colder(lhs.entry_->get_frequency(), lhs.entry_->get_last_access_time_us(),
+                                           rhs.entry_->get_frequency(), rhs.entry_->get_last_access_time_us());
     } else if (NULL != lhs.entry_) {
       bret = (lhs.entry_->get_last_access_time_us() <= 0);
     } else if (NULL != rhs.entry_) {
@@ -1560,7 +1701,8 @@ int ObCacheCleaner::clean_one_sub_bucket_sql_table_cache(const int64_t bucket_id
     ObSqlTableEntry *entry = NULL;
     SqlTableIter it;
     int64_t tmp_clean_count = std::max(clean_count, 2L);
-    int64_t buf_len = sizeof(ObSqlTableEntryElem) * tmp_clean_count;
+    // the victims and the admission candidates
+    int64_t buf_len = sizeof(ObSqlTableEntryElem) * tmp_clean_count * 2;
     char *buf = static_cast<char *>(op_fixed_mem_alloc(buf_len));
     if (OB_ISNULL(buf)) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -1568,6 +1710,9 @@ int ObCacheCleaner::clean_one_sub_bucket_sql_table_cache(const int64_t bucket_id
     } else {
       // 1.make a smallest heap
       ObSqlTableEntryElem *eles = new (buf) ObSqlTableEntryElem[tmp_clean_count];
+      ObSqlTableEntryElem *candidates = new (buf + sizeof(ObSqlTableEntryElem) * tmp_clean_count)
+                                        ObSqlTableEntryElem[tmp_clean_count];
+      int64_t candidate_count = 0;
       ObSqlTableEntryElem tmp_ele;
       int64_t i = 0;
       DRWLock &rw_lock = sql_table_cache_->rw_lock_for_key(bucket_idx);
@@ -1575,6 +1720,8 @@ int ObCacheCleaner::clean_one_sub_bucket_sql_table_cache(const int64_t bucket_id
         DRWLock::RDLockGuard lock(rw_lock);
         entry = sql_table_cache_->first_entry(bucket_idx, it);
         while (NULL != entry) {
+          // halve the frequency on every scan, so that protected entries which go cold are demoted
+          entry->age_frequency();
           if (i < tmp_clean_count) {
             eles[i].entry_ = entry;
             ++i;
@@ -1591,6 +1738,9 @@ int ObCacheCleaner::clean_one_sub_bucket_sql_table_cache(const int64_t bucket_id
               std::make_heap(eles, eles + tmp_clean_count, cmp);
             }
           }
+          if (entry->is_avail_state()) {
+            add_admission_candidate(candidates, candidate_count, tmp_clean_count, entry);
+          }
 
           entry = sql_table_cache_->next_entry(bucket_idx, it);
         }
@@ -1605,11 +1755,12 @@ int ObCacheCleaner::clean_one_sub_bucket_sql_table_cache(const int64_t bucket_id
         int64_t dcount = part_entry_count - PART_SQL_TABLE_ENTRY_MIN_COUNT;
         tmp_clean_count = ((dcount >= 0) ? dcount : 0);
       }
+      const int64_t rejected_count = admit_candidates(eles, tmp_clean_count, candidates, candidate_count);
       LOG_INFO("begin to wash sql table entry", "wash_count",
-               tmp_clean_count, K(part_entry_count), K(orig_clean_count), K(bucket_idx),
+               tmp_clean_count, K(rejected_count), K(part_entry_count), K(orig_clean_count), K(bucket_idx),
                LITERAL_K(PART_SQL_TABLE_ENTRY_MIN_COUNT));
 
-      // 3. remove the LRU entry
+      // 3. remove the coldest entry, probation segment first
       ObSqlTableEntryKey key;
       for (int64_t i = 0; (i < tmp_clean_count) && OB_SUCC(ret); ++i) {
         entry = eles[i].entry_;
@@ -1618,8 +1769,13 @@ int ObCacheCleaner::clean_one_sub_bucket_sql_table_cache(const int64_t bucket_id
           LOG_INFO("this sql table entry will be washed", KPC(entry));
           key.reset();
           key = entry->get_key();
+          // the entry may be freed once removed
+          const uint64_t hash = key.hash();
+          const int64_t frequency = entry->get_frequency();
           if (OB_FAIL(sql_table_cache_->remove_sql_table_entry(key))) {
             LOG_WARN("fail to remove sql table entry", KPC(entry), K(ret));
+          } else {
+            sql_table_cache_->get_policy().record_eviction(hash, frequency);
           }
         }
       }
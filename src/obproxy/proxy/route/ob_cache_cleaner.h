@@ -138,6 +138,9 @@ private:
   int do_expire_table_entry();
   // the first cleaner is responsible to do expire cluster resourece job
   bool need_expire_cluster_resource() { return (0 == this_cleaner_idx_); }
+  // the first cleaner is responsible to publish the stats of the global route caches
+  bool need_update_route_cache_stat() { return (0 == this_cleaner_idx_); }
+  void update_route_cache_stat();
   bool is_table_cache_expire_time_changed();
   bool is_partition_cache_expire_time_changed();
   bool is_routine_cache_expire_time_changed();
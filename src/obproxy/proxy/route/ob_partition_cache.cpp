@@ -39,8 +39,12 @@ public:
                                        const ObPartitionEntryKey &key,
                                        const uint64_t hash,
                                        const bool is_add_building_entry,
-                                       bool &is_locked,
+                                       bool &is_finished,
                                        ObPartitionEntry *&partition);
+  static int check_partition_entry(ObPartitionCache &partition_cache,
+                                   const ObPartitionEntryKey &key,
+                                   ObPartitionEntry *acquired_entry,
+                                   ObPartitionEntry *&entry);
 
 
    static int add_building_part_entry(ObPartitionCache &partition_cache,
@@ -75,10 +79,10 @@ int ObPartitionCacheCont::get_partition_entry(const int event, ObEvent *e)
     LOG_INFO("cont::action has been cancelled", K_(key), K(this));
     destroy();
   } else {
-    bool is_locked = false;
+    bool is_finished = false;
     ObPartitionEntry *tmp_entry = NULL;
     if (OB_FAIL(get_partition_entry_local(partition_cache_, key_, hash_,
-            is_add_building_entry_, is_locked, tmp_entry))) {
+            is_add_building_entry_, is_finished, tmp_entry))) {
       if (NULL != tmp_entry) {
         tmp_entry->dec_ref();
         tmp_entry = NULL;
@@ -86,7 +90,7 @@ int ObPartitionCacheCont::get_partition_entry(const int event, ObEvent *e)
       LOG_WARN("fail to get partition entry", K_(key), K(ret));
     }
 
-    if (OB_SUCC(ret) && !is_locked) {
+    if (OB_SUCC(ret) && !is_finished) {
       LOG_DEBUG("cont::get_partition_entry MUTEX_TRY_LOCK failed, and will schedule in interval(ns)",
                 LITERAL_K(ObPartitionCacheParam::SCHEDULE_PARTITION_CACHE_CONT_INTERVAL));
       if (OB_ISNULL(self_ethread().schedule_in(this, ObPartitionCacheParam::SCHEDULE_PARTITION_CACHE_CONT_INTERVAL))) {
@@ -102,7 +106,7 @@ int ObPartitionCacheCont::get_partition_entry(const int event, ObEvent *e)
 
       *ppentry_ = tmp_entry;
       tmp_entry = NULL;
-      // failed or locked
+      // failed or finished
       action_.continuation_->handle_event(PARTITION_ENTRY_LOOKUP_CACHE_DONE, NULL);
       destroy();
     }
@@ -116,59 +120,86 @@ int ObPartitionCacheCont::get_partition_entry_local(
     const ObPartitionEntryKey &key,
     const uint64_t hash,
     const bool is_add_building_entry,
-    bool &is_locked,
+    bool &is_finished,
     ObPartitionEntry *&entry)
 {
   int ret = OB_SUCCESS;
-  is_locked = false;
+  is_finished = false;
   entry = NULL;
 
-  ObProxyMutex *bucket_mutex = partition_cache.lock_for_key(hash);
-  MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
-  if (lock_bucket.is_locked()) {
-    is_locked = true;
-    if (OB_FAIL(partition_cache.run_todo_list(partition_cache.part_num(hash)))) {
-      LOG_WARN("fail to run todo list", K(key), K(hash), K(ret));
-    } else {
-      entry = partition_cache.lookup_entry(hash, key);
-      if (NULL != entry) {
-        if (partition_cache.is_partition_entry_expired_in_time_mode(*entry)
-            && entry->is_avail_state()) {
-          entry->set_dirty_state();
-        }
-        if (partition_cache.is_partition_entry_expired_in_qa_mode(*entry)
-            || (!get_global_proxy_config().enable_async_pull_location_cache
-                && partition_cache.is_partition_entry_expired_in_time_mode(*entry))) {
-          LOG_INFO("the partition entry is expired", "expire_time_us",
-                   partition_cache.get_cache_expire_time_us(), KPC(entry));
-          entry = NULL;
-          // remove the expired partition entry in locked
-          if (OB_FAIL(partition_cache.remove_partition_entry(key))) {
-            LOG_WARN("fail to remove partition entry", K(key), K(ret));
-          }
-        } else {
-          entry->inc_ref();
-          LOG_DEBUG("cont::get_partition_entry_local, entry found succ", KPC(entry));
-        }
+  // a hit needs no bucket lock, only a miss goes through the todo list
+  if (OB_FAIL(partition_cache.try_run_todo_list(hash))) {
+    LOG_WARN("fail to run todo list", K(key), K(hash), K(ret));
+  } else if (OB_FAIL(check_partition_entry(partition_cache, key, partition_cache.acquire_entry(hash, key), entry))) {
+    LOG_WARN("fail to check partition entry", K(key), K(ret));
+  } else if (NULL != entry) {
+    is_finished = true;
+    LOG_DEBUG("cont::get_partition_entry_local, entry found succ", KPC(entry));
+  } else {
+    ObProxyMutex *bucket_mutex = partition_cache.lock_for_key(hash);
+    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
+    if (lock_bucket.is_locked()) {
+      is_finished = true;
+      if (OB_FAIL(partition_cache.run_todo_list(partition_cache.part_num(hash)))) {
+        LOG_WARN("fail to run todo list", K(key), K(hash), K(ret));
+      } else if (OB_FAIL(check_partition_entry(partition_cache, key, partition_cache.acquire_entry(hash, key), entry))) {
+        LOG_WARN("fail to check partition entry", K(key), K(ret));
+      } else if (NULL != entry) {
+        LOG_DEBUG("cont::get_partition_entry_local, entry found succ", KPC(entry));
       } else {
         // non-existent, return NULL
       }
-    }
 
-    if (NULL == entry) {
-      if (is_add_building_entry) {
-        if (OB_FAIL(add_building_part_entry(partition_cache, key))) {
-          LOG_WARN("fail to building part entry", K(key), K(ret));
+      if (NULL == entry) {
+        if (is_add_building_entry) {
+          if (OB_FAIL(add_building_part_entry(partition_cache, key))) {
+            LOG_WARN("fail to building part entry", K(key), K(ret));
+          } else {
+            // nothing
+          }
         } else {
-          // nothing
+          LOG_DEBUG("cont::get_partition_entry_local, entry not found", K(key));
         }
-      } else {
-        LOG_DEBUG("cont::get_partition_entry_local, entry not found", K(key));
       }
+      lock_bucket.release();
     }
-    lock_bucket.release();
   }
 
+  if (is_finished) {
+    if (NULL != entry) {
+      partition_cache.get_policy().record_hit();
+    } else {
+      partition_cache.get_policy().record_miss(hash);
+    }
+  }
+  return ret;
+}
+
+// release the expired entry and remove it from the cache
+int ObPartitionCacheCont::check_partition_entry(ObPartitionCache &partition_cache,
+                                                const ObPartitionEntryKey &key,
+                                                ObPartitionEntry *acquired_entry,
+                                                ObPartitionEntry *&entry)
+{
+  int ret = OB_SUCCESS;
+  entry = acquired_entry;
+  if (NULL != entry) {
+    if (partition_cache.is_partition_entry_expired_in_time_mode(*entry)
+        && entry->is_avail_state()) {
+      entry->set_dirty_state();
+    }
+    if (partition_cache.is_partition_entry_expired_in_qa_mode(*entry)
+        || (!get_global_proxy_config().enable_async_pull_location_cache
+            && partition_cache.is_partition_entry_expired_in_time_mode(*entry))) {
+      LOG_INFO("the partition entry is expired", "expire_time_us",
+               partition_cache.get_cache_expire_time_us(), KPC(entry));
+      entry->dec_ref();
+      entry = NULL;
+      if (OB_FAIL(partition_cache.remove_partition_entry(key))) {
+        LOG_WARN("fail to remove partition entry", K(key), K(ret));
+      }
+    }
+  }
   return ret;
 }
 
@@ -307,17 +338,17 @@ int ObPartitionCache::get_partition_entry(
     uint64_t hash = key.hash();
     LOG_DEBUG("begin to get partition location entry", K(ppentry), K(key), K(cont), K(hash));
 
-    bool is_locked = false;
+    bool is_finished = false;
     ObPartitionEntry *tmp_entry = NULL;
     if (OB_FAIL(ObPartitionCacheCont::get_partition_entry_local(*this, key, hash,
-            is_add_building_entry, is_locked, tmp_entry))) {
+            is_add_building_entry, is_finished, tmp_entry))) {
       if (NULL != tmp_entry) {
         tmp_entry->dec_ref();
         tmp_entry = NULL;
       }
       LOG_WARN("fail to get partition entry", K(key), K(ret));
     } else {
-      if (is_locked) {
+      if (is_finished) {
         *ppentry = tmp_entry;
         tmp_entry = NULL;
       } else {
@@ -368,6 +399,8 @@ int ObPartitionCache::add_partition_entry(ObPartitionEntry &entry, bool direct_a
     ObPartitionEntryKey key = entry.get_key();
     uint64_t hash = key.hash();
     LOG_DEBUG("add partition location", K(part_num(hash)), K(entry), K(direct_add), K(hash));
+    // admit the key with the frequency it had before it missed or was evicted
+    entry.merge_frequency(policy_.estimate(hash));
     if (!direct_add) {
       ObProxyMutex *bucket_mutex = lock_for_key(hash);
       MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
@@ -375,8 +408,11 @@ int ObPartitionCache::add_partition_entry(ObPartitionEntry &entry, bool direct_a
         if (OB_FAIL(run_todo_list(part_num(hash)))) {
           LOG_WARN("fail to run todo list", K(ret));
         } else {
-          ObPartitionEntry *tmp_entry = insert_entry(hash, key, &entry);
-          if (NULL != tmp_entry) {
+          ObPartitionEntry *tmp_entry = NULL;
+          if (OB_FAIL(insert_entry(hash, key, &entry, tmp_entry))) {
+            LOG_WARN("fail to insert partition entry", K(entry), K(ret));
+          } else if (NULL != tmp_entry) {
+            entry.merge_frequency(tmp_entry->get_frequency()); // the new entry inherits the frequency
             tmp_entry->set_deleted_state(); // used to update tc_partition_map
             tmp_entry->dec_ref();
             tmp_entry = NULL;
@@ -449,6 +485,20 @@ int ObPartitionCache::remove_partition_entry(const ObPartitionEntryKey &key)
   return ret;
 }
 
+int ObPartitionCache::try_run_todo_list(const uint64_t hash)
+{
+  int ret = OB_SUCCESS;
+  // lookup never waits for the bucket lock, pending ops are applied only if it is free
+  if (!todo_lists_[part_num(hash)].empty()) {
+    ObProxyMutex *bucket_mutex = lock_for_key(hash);
+    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
+    if (lock_bucket.is_locked() && OB_FAIL(run_todo_list(part_num(hash)))) {
+      LOG_WARN("fail to run todo list", K(hash), K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObPartitionCache::run_todo_list(const int64_t buck_id)
 {
   int ret = OB_SUCCESS;
@@ -498,8 +548,12 @@ int ObPartitionCache::process(const int64_t buck_id, ObPartitionCacheParam *para
     ObPartitionEntry *entry = NULL;
     switch (param->op_) {
       case ObPartitionCacheParam::ADD_PARTITION_OP: {
-        entry = insert_entry(param->hash_, param->key_, param->entry_);
-        if (NULL != entry) {
+        if (OB_FAIL(insert_entry(param->hash_, param->key_, param->entry_, entry))) {
+          LOG_WARN("fail to insert partition entry", KPC(param), K(ret));
+          // the cache does not hold the entry handed to it
+          param->entry_->dec_ref();
+        } else if (NULL != entry) {
+          param->entry_->merge_frequency(entry->get_frequency()); // the new entry inherits the frequency
           entry->set_deleted_state(); // used to update tc_partition_map
           entry->dec_ref(); // free old entry
           entry = NULL;
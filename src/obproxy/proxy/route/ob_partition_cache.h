@@ -57,7 +57,7 @@ class ObPartitionCache : public PartitionEntryHashMap
 public:
   static const int64_t PARTITION_CACHE_MAP_SIZE = 10240;
 
-  ObPartitionCache() : is_inited_(false), expire_time_us_(0) {}
+  ObPartitionCache() : is_inited_(false), expire_time_us_(0), policy_() {}
   virtual ~ObPartitionCache() { destroy(); }
   int init(const int64_t bucket_size);
 
@@ -71,13 +71,16 @@ public:
   int remove_partition_entry(const ObPartitionEntryKey &key);
 
   int run_todo_list(const int64_t buck_id);
+  // apply the pending ops of the bucket of hash only if its lock is free
+  int try_run_todo_list(const uint64_t hash);
 
   void set_cache_expire_time(const int64_t relative_time_s);
   int64_t get_cache_expire_time_us() const { return expire_time_us_; }
+  ObRouteCachePolicy &get_policy() { return policy_; }
   bool is_partition_entry_expired(const ObPartitionEntry &entry);
   bool is_partition_entry_expired_in_qa_mode(const ObPartitionEntry &entry);
   bool is_partition_entry_expired_in_time_mode(const ObPartitionEntry &entry);
-  TO_STRING_KV(K_(is_inited), K_(expire_time_us));
+  TO_STRING_KV(K_(is_inited), K_(expire_time_us), K_(policy));
 
   static bool gc_partition_entry(ObPartitionEntry *entry);
 
@@ -88,6 +91,7 @@ private:
 private:
   bool is_inited_;
   int64_t expire_time_us_;
+  ObRouteCachePolicy policy_;
   common::ObAtomicList todo_lists_[obutils::MT_HASHTABLE_PARTITIONS];
   DISALLOW_COPY_AND_ASSIGN(ObPartitionCache);
 };
@@ -695,6 +695,7 @@ int ObPartitionProcessor::get_partition_entry_from_thread_cache(
         tmp_entry->dec_ref();
         tmp_entry = NULL;
       } else {
+        get_global_partition_cache().get_policy().record_hit();
         LOG_DEBUG("get partition entry from thread cache succ", KPC(tmp_entry));
       }
     }
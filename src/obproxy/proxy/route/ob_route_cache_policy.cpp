@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include "proxy/route/ob_route_cache_policy.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+
+ObRouteCachePolicy::ObRouteCachePolicy()
+  : eviction_count_(0), sketch_add_count_(0)
+{
+  MEMSET(sketch_, 0, sizeof(sketch_));
+}
+
+int64_t ObRouteCachePolicy::get_stat_slot()
+{
+  static int64_t next_slot = 0;
+  static __thread int64_t slot = -1;
+  if (OB_UNLIKELY(slot < 0)) {
+    slot = ATOMIC_FAA(&next_slot, 1) % STAT_SLOT_COUNT;
+  }
+  return slot;
+}
+
+void ObRouteCachePolicy::record_miss(const uint64_t hash)
+{
+  ATOMIC_INC(&slots_[get_stat_slot()].miss_count_);
+  add_to_sketch(hash, 1);
+}
+
+void ObRouteCachePolicy::record_eviction(const uint64_t hash, const int64_t frequency)
+{
+  ATOMIC_INC(&eviction_count_);
+  if (frequency > 0) {
+    add_to_sketch(hash, frequency);
+  }
+}
+
+int64_t ObRouteCachePolicy::get_sketch_idx(const uint64_t hash, const int64_t row) const
+{
+  // double hashing, the high half is made odd to visit different counters in every row
+  const uint64_t h1 = hash & 0xFFFFFFFF;
+  const uint64_t h2 = (hash >> 32) | 1;
+  return static_cast<int64_t>((h1 + row * h2) & (SKETCH_WIDTH - 1));
+}
+
+int64_t ObRouteCachePolicy::estimate(const uint64_t hash) const
+{
+  int64_t frequency = MAX_FREQUENCY;
+  for (int64_t row = 0; row < SKETCH_DEPTH; ++row) {
+    const int64_t count = ATOMIC_LOAD(&sketch_[row][get_sketch_idx(hash, row)]);
+    if (count < frequency) {
+      frequency = count;
+    }
+  }
+  return frequency;
+}
+
+void ObRouteCachePolicy::add_to_sketch(const uint64_t hash, const int64_t count)
+{
+  for (int64_t row = 0; row < SKETCH_DEPTH; ++row) {
+    uint8_t &counter = sketch_[row][get_sketch_idx(hash, row)];
+    const int64_t cur = ATOMIC_LOAD(&counter);
+    if (cur < MAX_FREQUENCY) {
+      ATOMIC_STORE(&counter, static_cast<uint8_t>((cur + count < MAX_FREQUENCY) ? (cur + count) : MAX_FREQUENCY));
+    }
+  }
+  // halve the sketch regularly, so that it follows the recent workload
+  if (ATOMIC_AAF(&sketch_add_count_, count) >= SKETCH_RESET_COUNT) {
+    const int64_t add_count = ATOMIC_LOAD(&sketch_add_count_);
+    if (add_count >= SKETCH_RESET_COUNT && ATOMIC_BCAS(&sketch_add_count_, add_count, 0)) {
+      reset_sketch();
+    }
+  }
+}
+
+void ObRouteCachePolicy::reset_sketch()
+{
+  for (int64_t row = 0; row < SKETCH_DEPTH; ++row) {
+    for (int64_t i = 0; i < SKETCH_WIDTH; ++i) {
+      ATOMIC_STORE(&sketch_[row][i], static_cast<uint8_t>(ATOMIC_LOAD(&sketch_[row][i]) >> 1));
+    }
+  }
+}
+
+int64_t ObRouteCachePolicy::get_hit_count() const
+{
+  int64_t count = 0;
+  for (int64_t i = 0; i < STAT_SLOT_COUNT; ++i) {
+    count += ATOMIC_LOAD(&slots_[i].hit_count_);
+  }
+  return count;
+}
+
+int64_t ObRouteCachePolicy::get_miss_count() const
+{
+  int64_t count = 0;
+  for (int64_t i = 0; i < STAT_SLOT_COUNT; ++i) {
+    count += ATOMIC_LOAD(&slots_[i].miss_count_);
+  }
+  return count;
+}
+
+int64_t ObRouteCachePolicy::get_hit_ratio_permille() const
+{
+  const int64_t hit_count = get_hit_count();
+  const int64_t total_count = hit_count + get_miss_count();
+  return (total_count > 0) ? (hit_count * 1000 / total_count) : 0;
+}
+
+int64_t ObRouteCachePolicy::to_string(char *buf, const int64_t buf_len) const
+{
+  int64_t pos = 0;
+  J_OBJ_START();
+  J_KV("hit_count", get_hit_count(),
+       "miss_count", get_miss_count(),
+       "hit_ratio_permille", get_hit_ratio_permille(),
+       K_(eviction_count));
+  J_OBJ_END();
+  return pos;
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_ROUTE_CACHE_POLICY_H
+#define OBPROXY_ROUTE_CACHE_POLICY_H
+#include "lib/ob_define.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+// Frequency aware eviction shared by the table, partition, routine and sql table caches.
+//
+// Every entry keeps a small access frequency, bumped on one of every ACCESS_SAMPLE_RATE
+// accesses of a thread and halved each time the cache cleaner scans it. As in a segmented
+// LRU, entries below PROTECTED_FREQUENCY are in the probation segment and the others in
+// the protected segment; the cleaner evicts probation entries first, and the least
+// recently accessed ones within a segment.
+//
+// The policy of a cache also keeps a count-min sketch (TinyLFU) of the keys that missed
+// the cache or were evicted from it. A new entry starts with the frequency the sketch
+// remembers for its key, so a hot key which comes back is in the protected segment at once.
+//
+// Entries are added through the todo lists and a rejected one would be fetched again at
+// once, so admission is applied by the cleaner: the newest probation entries of a partition
+// are the candidates, each one competes with a victim, and the less frequent one of the two
+// is evicted (see is_admitted). Hits of the thread caches and of the global cache are both
+// counted in the hit ratio.
+class ObRouteCachePolicy
+{
+public:
+  static const int64_t MAX_FREQUENCY = 15;
+  static const int64_t PROTECTED_FREQUENCY = 2;
+  static const int64_t ACCESS_SAMPLE_RATE = 4; // must be power of 2
+  static const int64_t SKETCH_DEPTH = 4;
+  static const int64_t SKETCH_WIDTH = 16 * 1024; // must be power of 2
+  static const int64_t SKETCH_RESET_COUNT = 8 * SKETCH_WIDTH;
+  static const int64_t STAT_SLOT_COUNT = 32;
+
+  ObRouteCachePolicy();
+  ~ObRouteCachePolicy() {}
+
+  // lookup of the thread cache or the global cache
+  void record_hit() { ATOMIC_INC(&slots_[get_stat_slot()].hit_count_); }
+  void record_miss(const uint64_t hash);
+  // the entry of hash is evicted by the cleaner with its frequency
+  void record_eviction(const uint64_t hash, const int64_t frequency);
+  int64_t estimate(const uint64_t hash) const;
+
+  int64_t get_hit_count() const;
+  int64_t get_miss_count() const;
+  int64_t get_eviction_count() const { return ATOMIC_LOAD(&eviction_count_); }
+  int64_t get_hit_ratio_permille() const;
+
+  // per thread sampling of the accesses, only the sampled ones bump the frequency
+  static bool need_sample_access();
+  static void inc_frequency(int64_t &frequency);
+  static void age_frequency(int64_t &frequency);
+  static void merge_frequency(int64_t &frequency, const int64_t other);
+  static bool is_protected(const int64_t frequency) { return frequency >= PROTECTED_FREQUENCY; }
+  // a candidate stays in place of the victim only when it is more frequent, a tie keeps the victim
+  static bool is_admitted(const int64_t candidate_frequency, const int64_t victim_frequency)
+  {
+    return candidate_frequency > victim_frequency;
+  }
+  // whether lhs should be evicted before rhs
+  static bool is_colder(const int64_t lhs_frequency, const int64_t lhs_access_time_us,
+                        const int64_t rhs_frequency, const int64_t rhs_access_time_us);
+
+  int64_t to_string(char *buf, const int64_t buf_len) const;
+
+private:
+  struct ObRouteCacheStatSlot
+  {
+    ObRouteCacheStatSlot() : hit_count_(0), miss_count_(0) {}
+
+    int64_t hit_count_;
+    int64_t miss_count_;
+  } CACHE_ALIGNED;
+
+  static int64_t get_stat_slot();
+  int64_t get_sketch_idx(const uint64_t hash, const int64_t row) const;
+  void add_to_sketch(const uint64_t hash, const int64_t count);
+  void reset_sketch();
+
+private:
+  ObRouteCacheStatSlot slots_[STAT_SLOT_COUNT];
+  int64_t eviction_count_;
+  int64_t sketch_add_count_;
+  uint8_t sketch_[SKETCH_DEPTH][SKETCH_WIDTH];
+  DISALLOW_COPY_AND_ASSIGN(ObRouteCachePolicy);
+};
+
+inline bool ObRouteCachePolicy::need_sample_access()
+{
+  static __thread int64_t access_count = 0;
+  return 0 == ((++access_count) & (ACCESS_SAMPLE_RATE - 1));
+}
+
+inline void ObRouteCachePolicy::inc_frequency(int64_t &frequency)
+{
+  // racing bumps may be lost, which is harmless for an estimate
+  const int64_t cur = ATOMIC_LOAD(&frequency);
+  if (cur < MAX_FREQUENCY) {
+    ATOMIC_STORE(&frequency, cur + 1);
+  }
+}
+
+inline void ObRouteCachePolicy::age_frequency(int64_t &frequency)
+{
+  ATOMIC_STORE(&frequency, ATOMIC_LOAD(&frequency) >> 1);
+}
+
+inline void ObRouteCachePolicy::merge_frequency(int64_t &frequency, const int64_t other)
+{
+  if (ATOMIC_LOAD(&frequency) < other) {
+    ATOMIC_STORE(&frequency, (other < MAX_FREQUENCY) ? other : MAX_FREQUENCY);
+  }
+}
+
+inline bool ObRouteCachePolicy::is_colder(const int64_t lhs_frequency, const int64_t lhs_access_time_us,
+                                          const int64_t rhs_frequency, const int64_t rhs_access_time_us)
+{
+  bool bret = false;
+  if (is_protected(lhs_frequency) != is_protected(rhs_frequency)) {
+    bret = is_protected(rhs_frequency);
+  } else {
+    bret = (lhs_access_time_us <= rhs_access_time_us);
+  }
+  return bret;
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+#endif // OBPROXY_ROUTE_CACHE_POLICY_H
@@ -0,0 +1,839 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include "proxy/route/ob_route_snapshot.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lib/checksum/ob_crc64.h"
+#include "lib/utility/serialization.h"
+#include "utils/ob_layout.h"
+#include "obutils/ob_proxy_config_utils.h"
+#include "obutils/ob_async_common_task.h"
+#include "proxy/route/ob_table_cache.h"
+#include "proxy/route/ob_table_entry.h"
+#include "proxy/route/ob_partition_cache.h"
+#include "proxy/route/ob_partition_entry.h"
+#include "proxy/route/ob_tenant_server.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obproxy::event;
+using namespace oceanbase::obproxy::obutils;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+
+void ObRouteSnapshotRecord::reset()
+{
+  type_ = INVALID_RECORD;
+  cr_version_ = -1;
+  name_.reset();
+  table_id_ = OB_INVALID_ID;
+  partition_id_ = OB_INVALID_ID;
+  table_type_ = 0;
+  part_num_ = 0;
+  replica_num_ = 0;
+  schema_version_ = 0;
+  frequency_ = 0;
+  has_dup_replica_ = false;
+  tenant_replica_count_ = 0;
+  replicas_.reset();
+}
+
+bool ObRouteSnapshotRecord::is_valid() const
+{
+  return ((TABLE_RECORD == type_ && name_.is_valid())
+          || (PARTITION_RECORD == type_ && OB_INVALID_ID != partition_id_))
+         && cr_version_ >= 0
+         && OB_INVALID_ID != table_id_
+         && !replicas_.empty();
+}
+
+int ObRouteSnapshotRecord::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid snapshot record", KPC(this), K(ret));
+  } else if (OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, static_cast<int32_t>(type_)))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, cr_version_))) {
+  } else if (TABLE_RECORD == type_
+             && (OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, name_.cluster_name_.ptr(), name_.cluster_name_.length()))
+                 || OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, name_.tenant_name_.ptr(), name_.tenant_name_.length()))
+                 || OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, name_.database_name_.ptr(), name_.database_name_.length()))
+                 || OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, name_.package_name_.ptr(), name_.package_name_.length()))
+                 || OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, name_.table_name_.ptr(), name_.table_name_.length())))) {
+  } else if (OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, static_cast<int64_t>(table_id_)))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, static_cast<int64_t>(partition_id_)))
+             || OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, table_type_))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, part_num_))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, replica_num_))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, schema_version_))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, frequency_))
+             || OB_FAIL(serialization::encode_bool(buf, buf_len, pos, has_dup_replica_))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, tenant_replica_count_))
+             || OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, replicas_.count()))) {
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < replicas_.count(); ++i) {
+      const ObProxyReplicaLocation &replica = replicas_.at(i);
+      if (OB_FAIL(replica.server_.serialize(buf, buf_len, pos))
+          || OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, static_cast<int32_t>(replica.role_)))
+          || OB_FAIL(serialization::encode_vi32(buf, buf_len, pos, static_cast<int32_t>(replica.replica_type_)))
+          || OB_FAIL(serialization::encode_bool(buf, buf_len, pos, replica.is_dup_replica_))) {
+      }
+    }
+  }
+  return ret;
+}
+
+static int decode_snapshot_str(const char *buf, const int64_t data_len, int64_t &pos, ObString &str)
+{
+  int ret = OB_SUCCESS;
+  int64_t len = 0;
+  const char *ptr = serialization::decode_vstr(buf, data_len, pos, &len);
+  if (OB_ISNULL(ptr) || OB_UNLIKELY(len < 0)) {
+    ret = OB_DESERIALIZE_ERROR;
+    LOG_WARN("fail to decode string", K(pos), K(data_len), K(ret));
+  } else {
+    str.assign_ptr(ptr, static_cast<ObString::obstr_size_t>(len));
+  }
+  return ret;
+}
+
+int ObRouteSnapshotRecord::deserialize(const char *buf, const int64_t data_len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  int32_t type = 0;
+  int64_t table_id = 0;
+  int64_t partition_id = 0;
+  int64_t replica_count = 0;
+  reset();
+  if (OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &type))
+      || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &cr_version_))) {
+  } else if (FALSE_IT(type_ = static_cast<ObRecordType>(type))) {
+  } else if (TABLE_RECORD == type_
+             && (OB_FAIL(decode_snapshot_str(buf, data_len, pos, name_.cluster_name_))
+                 || OB_FAIL(decode_snapshot_str(buf, data_len, pos, name_.tenant_name_))
+                 || OB_FAIL(decode_snapshot_str(buf, data_len, pos, name_.database_name_))
+                 || OB_FAIL(decode_snapshot_str(buf, data_len, pos, name_.package_name_))
+                 || OB_FAIL(decode_snapshot_str(buf, data_len, pos, name_.table_name_)))) {
+  } else if (OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &table_id))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &partition_id))
+             || OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &table_type_))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &part_num_))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &replica_num_))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &schema_version_))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &frequency_))
+             || OB_FAIL(serialization::decode_bool(buf, data_len, pos, &has_dup_replica_))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &tenant_replica_count_))
+             || OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &replica_count))) {
+  } else if (OB_UNLIKELY(replica_count <= 0)) {
+    ret = OB_DESERIALIZE_ERROR;
+    LOG_WARN("invalid replica count", K(replica_count), K(ret));
+  } else {
+    table_id_ = static_cast<uint64_t>(table_id);
+    partition_id_ = static_cast<uint64_t>(partition_id);
+    ObProxyReplicaLocation replica;
+    int32_t role = 0;
+    int32_t replica_type = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < replica_count; ++i) {
+      replica.reset();
+      if (OB_FAIL(replica.server_.deserialize(buf, data_len, pos))
+          || OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &role))
+          || OB_FAIL(serialization::decode_vi32(buf, data_len, pos, &replica_type))
+          || OB_FAIL(serialization::decode_bool(buf, data_len, pos, &replica.is_dup_replica_))) {
+      } else {
+        replica.role_ = static_cast<ObRole>(role);
+        replica.replica_type_ = static_cast<ObReplicaType>(replica_type);
+        if (OB_FAIL(replicas_.push_back(replica))) {
+          LOG_WARN("fail to push back replica", K(replica), K(ret));
+        }
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_UNLIKELY(!is_valid())) {
+    ret = OB_DESERIALIZE_ERROR;
+    LOG_WARN("invalid snapshot record", KPC(this), K(ret));
+  }
+  return ret;
+}
+
+int64_t ObRouteSnapshotRecord::to_string(char *buf, const int64_t buf_len) const
+{
+  int64_t pos = 0;
+  J_OBJ_START();
+  J_KV(K_(type), K_(cr_version), K_(name), K_(table_id), K_(partition_id), K_(table_type),
+       K_(part_num), K_(replica_num), K_(schema_version), K_(frequency), K_(has_dup_replica),
+       K_(tenant_replica_count), K_(replicas));
+  J_OBJ_END();
+  return pos;
+}
+
+int ObRouteSnapshotCluster::set_cluster_name(const ObString &cluster_name)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(cluster_name.empty())
+      || OB_UNLIKELY(cluster_name.length() > OB_PROXY_MAX_CLUSTER_NAME_LENGTH)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid cluster name", K(cluster_name), K(ret));
+  } else {
+    MEMCPY(cluster_name_buf_, cluster_name.ptr(), cluster_name.length());
+    cluster_name_len_ = cluster_name.length();
+  }
+  return ret;
+}
+
+int ObRouteSnapshotWriter::init(char *buf, const int64_t buf_len)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len <= ObRouteSnapshot::HEADER_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid input value", KP(buf), K(buf_len), K(ret));
+  } else {
+    buf_ = buf;
+    buf_len_ = buf_len;
+    pos_ = ObRouteSnapshot::HEADER_SIZE; // header is written at last
+    record_count_ = 0;
+    clusters_.reset();
+  }
+  return ret;
+}
+
+int ObRouteSnapshotWriter::append(const ObRouteSnapshotRecord &record)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = pos_;
+  // leave room for the clusters, including the one of this record
+  const int64_t limit = buf_len_ - (clusters_.count() + 2) * MAX_CLUSTER_ENCODE_LEN;
+  if (OB_ISNULL(buf_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("writer not init", K(ret));
+  } else if (limit <= pos_) {
+    ret = OB_SIZE_OVERFLOW;
+  } else if (OB_FAIL(record.serialize(buf_, limit, pos))) {
+    if (OB_SIZE_OVERFLOW != ret) {
+      LOG_WARN("fail to serialize snapshot record", K(record), K(ret));
+    }
+  } else {
+    pos_ = pos;
+    ++record_count_;
+  }
+  return ret;
+}
+
+int ObRouteSnapshotWriter::add_cluster(const ObString &cluster_name, const int64_t cr_id,
+                                       const int64_t cr_version)
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  for (int64_t i = 0; !found && i < clusters_.count(); ++i) {
+    found = (cr_version == clusters_.at(i).cr_version_);
+  }
+  if (!found) {
+    ObRouteSnapshotCluster cluster;
+    cluster.cr_id_ = cr_id;
+    cluster.cr_version_ = cr_version;
+    if (OB_FAIL(cluster.set_cluster_name(cluster_name))) {
+      LOG_WARN("fail to set cluster name", K(cluster_name), K(ret));
+    } else if (OB_FAIL(clusters_.push_back(cluster))) {
+      LOG_WARN("fail to push back cluster", K(cluster), K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObRouteSnapshotWriter::finish(int64_t &data_len)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cluster_pos = pos_;
+  int64_t header_pos = 0;
+  data_len = 0;
+  if (OB_ISNULL(buf_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("writer not init", K(ret));
+  } else if (OB_FAIL(serialization::encode_vi64(buf_, buf_len_, pos_, clusters_.count()))) {
+    LOG_WARN("fail to encode cluster count", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < clusters_.count(); ++i) {
+      const ObRouteSnapshotCluster &cluster = clusters_.at(i);
+      if (OB_FAIL(serialization::encode_vstr(buf_, buf_len_, pos_, cluster.cluster_name_buf_, cluster.cluster_name_len_))
+          || OB_FAIL(serialization::encode_vi64(buf_, buf_len_, pos_, cluster.cr_id_))
+          || OB_FAIL(serialization::encode_vi64(buf_, buf_len_, pos_, cluster.cr_version_))) {
+        LOG_WARN("fail to encode cluster", K(cluster), K(ret));
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    const int64_t checksum = static_cast<int64_t>(ob_crc64(buf_ + ObRouteSnapshot::HEADER_SIZE,
+                                                           pos_ - ObRouteSnapshot::HEADER_SIZE));
+    if (OB_FAIL(serialization::encode_i64(buf_, buf_len_, header_pos, ObRouteSnapshot::SNAPSHOT_MAGIC))
+        || OB_FAIL(serialization::encode_i64(buf_, buf_len_, header_pos, ObRouteSnapshot::SNAPSHOT_VERSION))
+        || OB_FAIL(serialization::encode_i64(buf_, buf_len_, header_pos, pos_))
+        || OB_FAIL(serialization::encode_i64(buf_, buf_len_, header_pos, checksum))
+        || OB_FAIL(serialization::encode_i64(buf_, buf_len_, header_pos, cluster_pos))
+        || OB_FAIL(serialization::encode_i64(buf_, buf_len_, header_pos, record_count_))) {
+      LOG_WARN("fail to encode snapshot header", K(ret));
+    } else {
+      data_len = pos_;
+    }
+  }
+  return ret;
+}
+
+void ObRouteSnapshot::destroy()
+{
+  DRWLock::WRLockGuard guard(rwlock_);
+  inner_destroy();
+}
+
+void ObRouteSnapshot::inner_destroy()
+{
+  if (NULL != buf_) {
+    LOG_INFO("release route snapshot", KPC(this));
+    if (OB_UNLIKELY(0 != ::munmap(buf_, buf_len_))) {
+      LOG_WARN("fail to munmap route snapshot", KERRMSGS);
+    }
+    buf_ = NULL;
+  }
+  buf_len_ = 0;
+  data_len_ = 0;
+  cluster_pos_ = 0;
+  restored_cr_versions_.reset();
+}
+
+int ObRouteSnapshot::check_snapshot(const char *buf, const int64_t buf_len,
+                                    int64_t &data_len, int64_t &cluster_pos)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  int64_t magic = 0;
+  int64_t version = 0;
+  int64_t checksum = 0;
+  int64_t record_count = 0;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < HEADER_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid input value", KP(buf), K(buf_len), K(ret));
+  } else if (OB_FAIL(serialization::decode_i64(buf, buf_len, pos, &magic))
+             || OB_FAIL(serialization::decode_i64(buf, buf_len, pos, &version))
+             || OB_FAIL(serialization::decode_i64(buf, buf_len, pos, &data_len))
+             || OB_FAIL(serialization::decode_i64(buf, buf_len, pos, &checksum))
+             || OB_FAIL(serialization::decode_i64(buf, buf_len, pos, &cluster_pos))
+             || OB_FAIL(serialization::decode_i64(buf, buf_len, pos, &record_count))) {
+    LOG_WARN("fail to decode snapshot header", K(buf_len), K(ret));
+  } else if (OB_UNLIKELY(SNAPSHOT_MAGIC != magic) || OB_UNLIKELY(SNAPSHOT_VERSION != version)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unknown route snapshot", K(magic), K(version), K(ret));
+  } else if (OB_UNLIKELY(data_len > buf_len)
+             || OB_UNLIKELY(cluster_pos < HEADER_SIZE)
+             || OB_UNLIKELY(cluster_pos >= data_len)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("route snapshot is truncated", K(data_len), K(cluster_pos), K(buf_len), K(ret));
+  } else if (OB_UNLIKELY(checksum != static_cast<int64_t>(ob_crc64(buf + HEADER_SIZE, data_len - HEADER_SIZE)))) {
+    ret = OB_CHECKSUM_ERROR;
+    LOG_WARN("route snapshot checksum mismatch", K(checksum), K(data_len), K(ret));
+  } else {
+    LOG_DEBUG("succ to check route snapshot", K(data_len), K(cluster_pos), K(record_count));
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::load()
+{
+  int ret = OB_SUCCESS;
+  char *path = NULL;
+  ObFixedArenaAllocator<ObLayout::MAX_PATH_LENGTH> allocator;
+  if (OB_FAIL(ObLayout::merge_file_path(get_global_layout().get_etc_dir(),
+                                        ROUTE_SNAPSHOT_FILE_NAME, allocator, path))) {
+    LOG_WARN("fail to merge file path", K(ROUTE_SNAPSHOT_FILE_NAME), K(ret));
+  } else if (OB_FAIL(load(path))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail to load route snapshot", K(path), K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::load(const char *path)
+{
+  DRWLock::WRLockGuard guard(rwlock_);
+  inner_destroy();
+  return inner_load(path);
+}
+
+int ObRouteSnapshot::inner_load(const char *path)
+{
+  int ret = OB_SUCCESS;
+  int fd = -1;
+  struct stat st;
+  const int64_t start_us = ObTimeUtility::current_time();
+  if (OB_ISNULL(path)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid path", K(ret));
+  } else if ((fd = ::open(path, O_RDONLY)) < 0) {
+    if (ENOENT == errno) {
+      ret = OB_ENTRY_NOT_EXIST;
+      LOG_INFO("route snapshot does not exist", K(path));
+    } else {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to open route snapshot", K(path), KERRMSGS, K(ret));
+    }
+  } else if (OB_UNLIKELY(0 != ::fstat(fd, &st))) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to stat route snapshot", K(path), KERRMSGS, K(ret));
+  } else if (OB_UNLIKELY(st.st_size < HEADER_SIZE) || OB_UNLIKELY(st.st_size > MAX_SNAPSHOT_SIZE)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid route snapshot size", K(path), "size", st.st_size, K(ret));
+  } else {
+    void *addr = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (OB_UNLIKELY(MAP_FAILED == addr)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to mmap route snapshot", K(path), KERRMSGS, K(ret));
+    } else {
+      buf_ = static_cast<char *>(addr);
+      buf_len_ = st.st_size;
+      if (OB_FAIL(check_snapshot(buf_, buf_len_, data_len_, cluster_pos_))) {
+        LOG_WARN("invalid route snapshot, ignore it", K(path), K(ret));
+        inner_destroy();
+      } else {
+        LOG_INFO("succ to load route snapshot", K(path), KPC(this),
+                 "cost_us", ObTimeUtility::current_time() - start_us);
+      }
+    }
+  }
+  if (fd >= 0) {
+    ::close(fd); // the mapping is still valid
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::get_cluster_version(const ObString &cluster_name, const int64_t cr_id,
+                                         int64_t &cr_version) const
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = cluster_pos_;
+  int64_t cluster_count = 0;
+  cr_version = -1;
+  if (OB_ISNULL(buf_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("route snapshot is not loaded", K(ret));
+  } else if (OB_FAIL(serialization::decode_vi64(buf_, data_len_, pos, &cluster_count))) {
+    LOG_WARN("fail to decode cluster count", K(ret));
+  } else {
+    ObString name;
+    int64_t id = OB_INVALID_CLUSTER_ID;
+    int64_t version = -1;
+    for (int64_t i = 0; OB_SUCC(ret) && i < cluster_count; ++i) {
+      if (OB_FAIL(decode_snapshot_str(buf_, data_len_, pos, name))
+          || OB_FAIL(serialization::decode_vi64(buf_, data_len_, pos, &id))
+          || OB_FAIL(serialization::decode_vi64(buf_, data_len_, pos, &version))) {
+        LOG_WARN("fail to decode cluster", K(i), K(ret));
+      } else if (name == cluster_name && id == cr_id && version > cr_version) {
+        // the entries of a rebuilt cluster resource are stale
+        cr_version = version;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && cr_version < 0) {
+    ret = OB_ENTRY_NOT_EXIST;
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::get_next_record(int64_t &pos, ObRouteSnapshotRecord &record) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("route snapshot is not loaded", K(ret));
+  } else if (pos < HEADER_SIZE) {
+    pos = HEADER_SIZE;
+  }
+  if (OB_FAIL(ret)) {
+  } else if (pos >= cluster_pos_) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(record.deserialize(buf_, cluster_pos_, pos))) {
+    LOG_WARN("fail to deserialize snapshot record", K(pos), K(ret));
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::build_table_entry(const ObRouteSnapshotRecord &record, const int64_t cr_id,
+                                       const int64_t cr_version, ObTableEntry *&entry)
+{
+  int ret = OB_SUCCESS;
+  ObTenantServer *tenant_servers = NULL;
+  ObProxyPartitionLocation *pl = NULL;
+  entry = NULL;
+  if (OB_FAIL(ObTableEntry::alloc_and_init_table_entry(record.name_, cr_version, cr_id, entry))) {
+    LOG_WARN("fail to alloc and init table entry", K(record), K(ret));
+  } else {
+    entry->set_part_num(record.part_num_);
+    entry->set_replica_num(record.replica_num_);
+    entry->set_schema_version(record.schema_version_);
+    entry->set_table_id(record.table_id_);
+    entry->set_table_type(record.table_type_);
+    if (record.has_dup_replica_) {
+      entry->set_has_dup_replica();
+    }
+
+    if (entry->is_dummy_entry()) {
+      // tenant servers take the first replica of every partition as the leader, see ObTenantServer::init
+      ObSEArray<ObProxyReplicaLocation, 8> replicas;
+      const int64_t replica_count = record.tenant_replica_count_;
+      if (OB_FAIL(replicas.assign(record.replicas_))) {
+        LOG_WARN("fail to assign replicas", K(ret));
+      } else if (replica_count > 0 && replica_count < replicas.count()) {
+        for (int64_t i = 0; i < replicas.count(); i += replica_count) {
+          replicas.at(i).role_ = LEADER;
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_ISNULL(tenant_servers = op_alloc(ObTenantServer))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to allocate memory for ObTenantServer", K(ret));
+      } else if (OB_FAIL(tenant_servers->init(replicas))) {
+        LOG_WARN("fail to init tenant servers", K(replicas), K(ret));
+      } else if (OB_FAIL(entry->set_tenant_servers(tenant_servers))) {
+        LOG_WARN("fail to set tenant servers", KPC(tenant_servers), K(ret));
+      } else {
+        tenant_servers = NULL;
+      }
+    } else if (OB_ISNULL(pl = op_alloc(ObProxyPartitionLocation))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate memory for ObProxyPartitionLocation", K(ret));
+    } else if (OB_FAIL(pl->set_replicas(record.replicas_))) {
+      LOG_WARN("fail to set replicas", K(record), K(ret));
+    } else if (OB_FAIL(entry->set_first_partition_location(pl))) {
+      LOG_WARN("fail to set first partition location", K(record), K(ret));
+    } else {
+      pl = NULL;
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    if (OB_UNLIKELY(!entry->is_valid())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid table entry from route snapshot", KPC(entry), K(record), K(ret));
+    } else {
+      entry->set_create_time();
+      entry->merge_frequency(record.frequency_);
+      entry->set_dirty_state();
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    if (NULL != tenant_servers) {
+      op_free(tenant_servers);
+      tenant_servers = NULL;
+    }
+    if (NULL != pl) {
+      op_free(pl);
+      pl = NULL;
+    }
+    if (NULL != entry) {
+      entry->dec_ref();
+      entry = NULL;
+    }
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::restore(const ObString &cluster_name, const int64_t cr_id, const int64_t cr_version,
+                             ObTableCache &table_cache, ObPartitionCache &partition_cache)
+{
+  int ret = OB_SUCCESS;
+  DRWLock::WRLockGuard guard(rwlock_);
+  int64_t old_cr_version = -1;
+  if (NULL == buf_) {
+    // no snapshot, or it has been released
+  } else if (OB_FAIL(get_cluster_version(cluster_name, cr_id, old_cr_version))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail to get cluster version", K(cluster_name), K(cr_id), K(ret));
+    }
+  } else if (has_exist_in_array(restored_cr_versions_, old_cr_version)) {
+    LOG_DEBUG("cluster has been restored from route snapshot", K(cluster_name), K(cr_id), K(old_cr_version));
+  } else if (OB_FAIL(restored_cr_versions_.push_back(old_cr_version))) {
+    LOG_WARN("fail to push back cr version", K(old_cr_version), K(ret));
+  } else {
+    const int64_t start_us = ObTimeUtility::current_time();
+    int64_t table_entry_count = 0;
+    int64_t partition_entry_count = 0;
+    int64_t pos = 0;
+    ObRouteSnapshotRecord record;
+    ObTableEntry *table_entry = NULL;
+    ObPartitionEntry *partition_entry = NULL;
+    while (OB_SUCC(ret) && OB_SUCC(get_next_record(pos, record))) {
+      if (record.cr_version_ != old_cr_version) {
+        // other cluster
+      } else if (ObRouteSnapshotRecord::TABLE_RECORD == record.type_) {
+        // an entry of the snapshot which fails to restore is just fetched from remote
+        if (OB_SUCCESS != build_table_entry(record, cr_id, cr_version, table_entry)) {
+        } else if (OB_SUCCESS != table_cache.add_table_entry(*table_entry, false)) {
+          LOG_WARN("fail to add table entry", KPC(table_entry));
+          table_entry->dec_ref();
+        } else {
+          ++table_entry_count;
+        }
+        table_entry = NULL;
+      } else if (OB_SUCCESS != ObPartitionEntry::alloc_and_init_partition_entry(
+          record.table_id_, record.partition_id_, cr_version, cr_id, record.replicas_, partition_entry)) {
+        LOG_WARN("fail to alloc and init partition entry", K(record));
+      } else {
+        partition_entry->set_schema_version(record.schema_version_);
+        if (record.has_dup_replica_) {
+          partition_entry->set_has_dup_replica();
+        }
+        partition_entry->merge_frequency(record.frequency_);
+        partition_entry->set_dirty_state();
+        if (OB_SUCCESS != partition_cache.add_partition_entry(*partition_entry, false)) {
+          LOG_WARN("fail to add partition entry", KPC(partition_entry));
+          partition_entry->dec_ref();
+        } else {
+          ++partition_entry_count;
+        }
+        partition_entry = NULL;
+      }
+    }
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+    LOG_INFO("restore route cache from snapshot", K(cluster_name), K(cr_id), K(cr_version),
+             K(old_cr_version), K(table_entry_count), K(partition_entry_count),
+             "cost_us", ObTimeUtility::current_time() - start_us, K(ret));
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::dump_table_cache(ObTableCache &table_cache, ObRouteSnapshotWriter &writer, bool &is_full)
+{
+  int ret = OB_SUCCESS;
+  ObRouteSnapshotRecord record;
+  record.type_ = ObRouteSnapshotRecord::TABLE_RECORD;
+  for (int64_t part_idx = 0; OB_SUCC(ret) && !is_full && part_idx < table_cache.get_sub_part_count(); ++part_idx) {
+    TableIter it;
+    ObProxyMutex *bucket_mutex = table_cache.lock_for_key(part_idx);
+    MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
+    if (lock.is_locked()) {
+      ObTableEntry *entry = table_cache.first_entry(part_idx, it);
+      while (OB_SUCC(ret) && !is_full && NULL != entry) {
+        // sys tenant's dummy entry is built from rslist, and partition tables need part info,
+        // which is not dumped, so only dummy entries and non-partitioned tables are kept
+        if ((entry->is_avail_state() || entry->is_dirty_state() || entry->is_updating_state())
+            && !entry->is_sys_dummy_entry()
+            && !entry->is_entry_from_rslist()
+            && !entry->is_empty_entry_allowed()
+            && !entry->get_names().is_binlog_table()
+            && entry->is_valid()
+            && (entry->is_dummy_entry() || entry->is_location_entry())) {
+          record.cr_version_ = entry->get_cr_version();
+          record.name_.shallow_copy(entry->get_names());
+          record.table_id_ = entry->get_table_id();
+          record.table_type_ = static_cast<int32_t>(entry->get_table_type());
+          record.part_num_ = entry->get_part_num();
+          record.replica_num_ = entry->get_replica_num();
+          record.schema_version_ = entry->get_schema_version();
+          record.frequency_ = entry->get_frequency();
+          record.has_dup_replica_ = entry->has_dup_replica();
+          record.tenant_replica_count_ = 0;
+          record.replicas_.reuse();
+          if (entry->is_dummy_entry()) {
+            const ObTenantServer *tenant_servers = entry->get_tenant_servers();
+            record.tenant_replica_count_ = tenant_servers->replica_count_;
+            for (int64_t i = 0; OB_SUCC(ret) && i < tenant_servers->count(); ++i) {
+              ret = record.replicas_.push_back(*tenant_servers->get_replica_location(i));
+            }
+          } else {
+            const ObProxyPartitionLocation *pl = entry->get_first_pl();
+            for (int64_t i = 0; OB_SUCC(ret) && i < pl->replica_count(); ++i) {
+              ret = record.replicas_.push_back(*pl->get_replica(i));
+            }
+          }
+
+          if (OB_FAIL(ret)) {
+            LOG_WARN("fail to push back replica", KPC(entry), K(ret));
+          } else if (OB_FAIL(writer.append(record))) {
+            if (OB_SIZE_OVERFLOW == ret) {
+              is_full = true;
+              ret = OB_SUCCESS;
+            }
+          } else if (OB_FAIL(writer.add_cluster(entry->get_cluster_name(), entry->get_cr_id(),
+                                                entry->get_cr_version()))) {
+            LOG_WARN("fail to add cluster", KPC(entry), K(ret));
+          }
+        }
+        entry = table_cache.next_entry(part_idx, it);
+      }
+    } else {
+      LOG_INFO("fail to lock table cache, skip it in route snapshot", K(part_idx));
+    }
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::dump_partition_cache(ObPartitionCache &partition_cache, ObRouteSnapshotWriter &writer, bool &is_full)
+{
+  int ret = OB_SUCCESS;
+  ObRouteSnapshotRecord record;
+  record.type_ = ObRouteSnapshotRecord::PARTITION_RECORD;
+  for (int64_t part_idx = 0; OB_SUCC(ret) && !is_full && part_idx < partition_cache.get_sub_part_count(); ++part_idx) {
+    PartitionIter it;
+    ObProxyMutex *bucket_mutex = partition_cache.lock_for_key(part_idx);
+    MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
+    if (lock.is_locked()) {
+      ObPartitionEntry *entry = partition_cache.first_entry(part_idx, it);
+      while (OB_SUCC(ret) && !is_full && NULL != entry) {
+        if ((entry->is_avail_state() || entry->is_dirty_state() || entry->is_updating_state())
+            && entry->is_valid()) {
+          const ObProxyPartitionLocation &pl = entry->get_pl();
+          record.cr_version_ = entry->get_cr_version();
+          record.table_id_ = entry->get_table_id();
+          record.partition_id_ = entry->get_partition_id();
+          record.schema_version_ = entry->get_schema_version();
+          record.frequency_ = entry->get_frequency();
+          record.has_dup_replica_ = entry->has_dup_replica();
+          record.replicas_.reuse();
+          for (int64_t i = 0; OB_SUCC(ret) && i < pl.replica_count(); ++i) {
+            ret = record.replicas_.push_back(*pl.get_replica(i));
+          }
+
+          if (OB_FAIL(ret)) {
+            LOG_WARN("fail to push back replica", KPC(entry), K(ret));
+          } else if (OB_FAIL(writer.append(record))) {
+            if (OB_SIZE_OVERFLOW == ret) {
+              is_full = true;
+              ret = OB_SUCCESS;
+            }
+          }
+        }
+        entry = partition_cache.next_entry(part_idx, it);
+      }
+    } else {
+      LOG_INFO("fail to lock partition cache, skip it in route snapshot", K(part_idx));
+    }
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::dump(ObTableCache &table_cache, ObPartitionCache &partition_cache)
+{
+  int ret = OB_SUCCESS;
+  const int64_t start_us = ObTimeUtility::current_time();
+  int64_t entry_count = 0;
+  for (int64_t i = 0; i < table_cache.get_sub_part_count(); ++i) {
+    entry_count += table_cache.get_part_cur_size(i);
+  }
+  for (int64_t i = 0; i < partition_cache.get_sub_part_count(); ++i) {
+    entry_count += partition_cache.get_part_cur_size(i);
+  }
+  const int64_t buf_len = std::min(MAX_SNAPSHOT_SIZE, HEADER_SIZE + OB_MALLOC_NORMAL_BLOCK_SIZE
+                                                      + entry_count * AVG_RECORD_SIZE);
+  char *buf = NULL;
+  int64_t data_len = 0;
+  bool is_full = false;
+  ObRouteSnapshotWriter writer;
+  ObMemAttr mem_attr;
+  mem_attr.mod_id_ = ObModIds::OB_PROXY_FILE;
+
+  if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(buf_len, mem_attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc route snapshot buf", K(buf_len), K(ret));
+  } else if (OB_FAIL(writer.init(buf, buf_len))) {
+    LOG_WARN("fail to init snapshot writer", K(ret));
+  } else if (OB_FAIL(dump_table_cache(table_cache, writer, is_full))) {
+    LOG_WARN("fail to dump table cache", K(ret));
+  } else if (OB_FAIL(dump_partition_cache(partition_cache, writer, is_full))) {
+    LOG_WARN("fail to dump partition cache", K(ret));
+  } else if (OB_FAIL(writer.finish(data_len))) {
+    LOG_WARN("fail to finish route snapshot", K(ret));
+  } else if (OB_FAIL(ObProxyFileUtils::write_to_file(get_global_layout().get_etc_dir(),
+                     ROUTE_SNAPSHOT_FILE_NAME, buf, data_len, false))) {
+    LOG_WARN("fail to write route snapshot", K(ROUTE_SNAPSHOT_FILE_NAME), K(data_len), K(ret));
+  } else {
+    LOG_INFO("succ to dump route snapshot", K(entry_count), "record_count", writer.get_record_count(),
+             K(data_len), K(is_full), "cost_us", ObTimeUtility::current_time() - start_us);
+  }
+
+  if (NULL != buf) {
+    ob_free(buf);
+    buf = NULL;
+  }
+  return ret;
+}
+
+int ObRouteSnapshot::do_dump_task()
+{
+  int ret = OB_SUCCESS;
+  if (get_global_proxy_config().enable_route_snapshot) {
+    if (OB_FAIL(dump(get_global_table_cache(), get_global_partition_cache()))) {
+      LOG_WARN("fail to dump route snapshot", K(ret));
+    }
+    // the snapshot loaded at start is stale now, release its mapping
+    get_global_route_snapshot().destroy();
+  }
+  update_dump_interval();
+  return ret;
+}
+
+void ObRouteSnapshot::update_dump_interval()
+{
+  ObAsyncCommonTask *cont = get_global_route_snapshot().get_dump_cont();
+  if (OB_LIKELY(NULL != cont)) {
+    cont->set_interval(get_global_proxy_config().route_snapshot_dump_interval);
+  }
+}
+
+int ObRouteSnapshot::start_dump_task()
+{
+  int ret = OB_SUCCESS;
+  const int64_t interval_us = get_global_proxy_config().route_snapshot_dump_interval;
+  if (OB_UNLIKELY(NULL != dump_cont_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("dump_cont should be null here", K_(dump_cont), K(ret));
+  } else if (OB_ISNULL(dump_cont_ = ObAsyncCommonTask::create_and_start_repeat_task(interval_us,
+                                    "route_snapshot_dump_task",
+                                    ObRouteSnapshot::do_dump_task,
+                                    ObRouteSnapshot::update_dump_interval, false, event::ET_TASK))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("fail to create and start route_snapshot_dump_task task", K(ret));
+  } else {
+    LOG_INFO("succ to start route snapshot dump task", K(interval_us));
+  }
+  return ret;
+}
+
+int64_t ObRouteSnapshot::to_string(char *buf, const int64_t buf_len) const
+{
+  int64_t pos = 0;
+  J_OBJ_START();
+  J_KV(KP_(buf), K_(buf_len), K_(data_len), K_(cluster_pos), K_(restored_cr_versions));
+  J_OBJ_END();
+  return pos;
+}
+
+ObRouteSnapshot &get_global_route_snapshot()
+{
+  static ObRouteSnapshot route_snapshot;
+  return route_snapshot;
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_ROUTE_SNAPSHOT_H
+#define OBPROXY_ROUTE_SNAPSHOT_H
+#include "lib/container/ob_se_array.h"
+#include "lib/lock/ob_drw_lock.h"
+#include "proxy/route/ob_route_struct.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace obutils
+{
+class ObAsyncCommonTask;
+}
+namespace proxy
+{
+class ObTableCache;
+class ObPartitionCache;
+class ObTableEntry;
+class ObPartitionEntry;
+
+static const char *const ROUTE_SNAPSHOT_FILE_NAME = "obproxy_route_snapshot.bin";
+
+// one table entry or partition entry in the route snapshot,
+// the strings point into the snapshot buffer
+struct ObRouteSnapshotRecord
+{
+public:
+  enum ObRecordType
+  {
+    INVALID_RECORD = 0,
+    TABLE_RECORD,
+    PARTITION_RECORD,
+  };
+
+  ObRouteSnapshotRecord() { reset(); }
+  ~ObRouteSnapshotRecord() {}
+  void reset();
+  bool is_valid() const;
+  int serialize(char *buf, const int64_t buf_len, int64_t &pos) const;
+  int deserialize(const char *buf, const int64_t data_len, int64_t &pos);
+  int64_t to_string(char *buf, const int64_t buf_len) const;
+
+  ObRecordType type_;
+  int64_t cr_version_;
+  ObTableEntryName name_; // table record only
+  uint64_t table_id_;
+  uint64_t partition_id_; // partition record only
+  int32_t table_type_;
+  int64_t part_num_;
+  int64_t replica_num_;
+  int64_t schema_version_;
+  int64_t frequency_;
+  bool has_dup_replica_;
+  int64_t tenant_replica_count_; // replica count of every partition of tenant servers, dummy entry only
+  common::ObSEArray<ObProxyReplicaLocation, 8> replicas_;
+};
+
+// the cluster which the records with cr_version_ belong to
+struct ObRouteSnapshotCluster
+{
+public:
+  ObRouteSnapshotCluster() : cr_id_(common::OB_INVALID_CLUSTER_ID), cr_version_(-1), cluster_name_len_(0) {}
+  ~ObRouteSnapshotCluster() {}
+  int set_cluster_name(const common::ObString &cluster_name);
+  // the name is kept in the struct, so that it can be copied
+  common::ObString get_cluster_name() const
+  {
+    return common::ObString(cluster_name_len_, cluster_name_buf_);
+  }
+  TO_STRING_KV("cluster_name", get_cluster_name(), K_(cr_id), K_(cr_version));
+
+  int64_t cr_id_;
+  int64_t cr_version_;
+  int32_t cluster_name_len_;
+  char cluster_name_buf_[OB_PROXY_MAX_CLUSTER_NAME_LENGTH];
+};
+
+// Build a route snapshot into buf, the layout is:
+//   header | records | clusters
+// every record is serialized by ObRouteSnapshotRecord, the header keeps the magic, the version,
+// the checksum of what follows it, and where the clusters begin.
+class ObRouteSnapshotWriter
+{
+public:
+  static const int64_t MAX_CLUSTER_ENCODE_LEN = OB_PROXY_MAX_CLUSTER_NAME_LENGTH + 32;
+
+  ObRouteSnapshotWriter() : buf_(NULL), buf_len_(0), pos_(0), record_count_(0), clusters_() {}
+  ~ObRouteSnapshotWriter() {}
+
+  int init(char *buf, const int64_t buf_len);
+  // OB_SIZE_OVERFLOW if buf is full, and buf is left as it was
+  int append(const ObRouteSnapshotRecord &record);
+  int add_cluster(const common::ObString &cluster_name, const int64_t cr_id, const int64_t cr_version);
+  int finish(int64_t &data_len);
+  int64_t get_record_count() const { return record_count_; }
+
+private:
+  char *buf_;
+  int64_t buf_len_;
+  int64_t pos_;
+  int64_t record_count_;
+  common::ObSEArray<ObRouteSnapshotCluster, 4> clusters_;
+  DISALLOW_COPY_AND_ASSIGN(ObRouteSnapshotWriter);
+};
+
+// Warm start of the table cache and the partition cache.
+//
+// A repeat task on a task thread dumps the table entries and partition entries of the latest cluster
+// resources into ROUTE_SNAPSHOT_FILE_NAME every route_snapshot_dump_interval, the dump walks the
+// global caches and writes the file, so it is kept off the net threads. When obproxy starts,
+// the file is mapped into memory. Once a cluster resource is created, the entries of the cluster
+// in the snapshot are added to the caches with the new cr_version as dirty entries, they are used
+// at once and refreshed from remote at the first access. The mapping is released by the next dump.
+//
+// Only non-partitioned tables and tenant dummy entries are warm started. Partition tables need
+// their part info to route, which is not in the snapshot, so their table entries are fetched from
+// remote as before, their partition entries are in the snapshot and are used once the table entry
+// is back. The routine cache is not in the snapshot at all.
+class ObRouteSnapshot
+{
+public:
+  static const int64_t SNAPSHOT_MAGIC = 0x4F42525453484F54; // "OBRTSHOT"
+  static const int64_t SNAPSHOT_VERSION = 1;
+  static const int64_t HEADER_SIZE = 6 * static_cast<int64_t>(sizeof(int64_t));
+  static const int64_t AVG_RECORD_SIZE = 256;
+  static const int64_t MAX_SNAPSHOT_SIZE = 64 * 1024 * 1024; // 64MB
+
+  ObRouteSnapshot() : rwlock_(), buf_(NULL), buf_len_(0), data_len_(0),
+                      cluster_pos_(0), restored_cr_versions_(), dump_cont_(NULL) {}
+  ~ObRouteSnapshot() { destroy(); }
+  void destroy();
+
+  // map the snapshot file into memory
+  int load(const char *path);
+  int load();
+  bool is_loaded() const { return NULL != buf_; }
+  // add the entries of the cluster to the caches with cr_version, at most once for every cluster
+  int restore(const common::ObString &cluster_name, const int64_t cr_id, const int64_t cr_version,
+              ObTableCache &table_cache, ObPartitionCache &partition_cache);
+
+  // the cr_version of the cluster when the snapshot was dumped
+  int get_cluster_version(const common::ObString &cluster_name, const int64_t cr_id, int64_t &cr_version) const;
+  // pos starts from 0, OB_ITER_END if no more records
+  int get_next_record(int64_t &pos, ObRouteSnapshotRecord &record) const;
+
+  static int dump(ObTableCache &table_cache, ObPartitionCache &partition_cache);
+  static int do_dump_task();
+  static void update_dump_interval();
+  int start_dump_task();
+  obutils::ObAsyncCommonTask *get_dump_cont() { return dump_cont_; }
+  static int check_snapshot(const char *buf, const int64_t buf_len, int64_t &data_len, int64_t &cluster_pos);
+
+  int64_t to_string(char *buf, const int64_t buf_len) const;
+
+private:
+  int inner_load(const char *path);
+  void inner_destroy();
+  static int dump_table_cache(ObTableCache &table_cache, ObRouteSnapshotWriter &writer, bool &is_full);
+  static int dump_partition_cache(ObPartitionCache &partition_cache, ObRouteSnapshotWriter &writer, bool &is_full);
+  static int build_table_entry(const ObRouteSnapshotRecord &record, const int64_t cr_id,
+                               const int64_t cr_version, ObTableEntry *&entry);
+
+private:
+  common::DRWLock rwlock_;
+  char *buf_; // mapped snapshot file
+  int64_t buf_len_;
+  int64_t data_len_;
+  int64_t cluster_pos_;
+  common::ObSEArray<int64_t, 4> restored_cr_versions_;
+  obutils::ObAsyncCommonTask *dump_cont_;
+  DISALLOW_COPY_AND_ASSIGN(ObRouteSnapshot);
+};
+
+ObRouteSnapshot &get_global_route_snapshot();
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+#endif // OBPROXY_ROUTE_SNAPSHOT_H
@@ -234,6 +234,7 @@ int64_t ObRouteEntry::to_string(char *buf, const int64_t buf_len) const
        K_(last_valid_time_us),
        K_(last_access_time_us),
        K_(last_update_time_us),
+       K_(frequency),
        K_(schema_version),
        K_(tenant_version),
        K_(time_for_expired),
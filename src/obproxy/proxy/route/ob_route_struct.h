@@ -23,6 +23,7 @@
 #include "iocore/eventsystem/ob_thread.h"
 #include "obutils/ob_proxy_config.h"
 #include "stat/ob_processor_stats.h"
+#include "proxy/route/ob_route_cache_policy.h"
 #include "rpc/obmysql/ob_mysql_util.h"
 
 namespace oceanbase
@@ -380,7 +381,7 @@ public:
 
   ObRouteEntry()
     : common::ObSharedRefCount(), cr_version_(-1), cr_id_(common::OB_INVALID_CLUSTER_ID), schema_version_(0), create_time_us_(0),
-      last_valid_time_us_(0), last_access_time_us_(0), last_update_time_us_(0),
+      last_valid_time_us_(0), last_access_time_us_(0), last_update_time_us_(0), frequency_(0),
       state_(BORN), tenant_version_(0), time_for_expired_(0), current_expire_time_config_(0) {}
   virtual ~ObRouteEntry() {}
   virtual void free() = 0;
@@ -402,9 +403,13 @@ public:
 
   void set_create_time() { create_time_us_ = common::hrtime_to_usec(event::get_hrtime()); }
   void renew_last_valid_time() { last_valid_time_us_ = common::hrtime_to_usec(event::get_hrtime()); }
-  void renew_last_access_time() { last_access_time_us_ = common::hrtime_to_usec(event::get_hrtime()); }
+  void renew_last_access_time();
   void renew_last_update_time();
   int64_t get_last_access_time_us() const { return last_access_time_us_; }
+  // sampled access frequency, see ObRouteCachePolicy
+  int64_t get_frequency() const { return frequency_; }
+  void age_frequency() { ObRouteCachePolicy::age_frequency(frequency_); }
+  void merge_frequency(const int64_t frequency) { ObRouteCachePolicy::merge_frequency(frequency_, frequency); }
   int64_t get_create_time_us() const { return create_time_us_; }
   int64_t get_last_valid_time_us() const { return last_valid_time_us_; }
   int64_t get_last_update_time_us() const { return last_update_time_us_; }
@@ -439,6 +444,7 @@ protected:
   int64_t last_valid_time_us_;//used for leader
   int64_t last_access_time_us_;
   int64_t last_update_time_us_;
+  int64_t frequency_;
 
   ObRouteEntryState state_;
   uint64_t tenant_version_;
@@ -446,6 +452,14 @@ protected:
   int64_t current_expire_time_config_;
 };
 
+inline void ObRouteEntry::renew_last_access_time()
+{
+  last_access_time_us_ = common::hrtime_to_usec(event::get_hrtime());
+  if (ObRouteCachePolicy::need_sample_access()) {
+    ObRouteCachePolicy::inc_frequency(frequency_);
+  }
+}
+
 inline bool ObRouteEntry::is_need_update() const
 {
   // default is 5s
@@ -63,6 +63,16 @@ static const char *PROXY_TENANT_SCHEMA_SQL               =
     "WHERE tenant_name = '%.*s' AND database_name = '%.*s' AND table_name = '%.*s' AND sql_port > 0 "
     "ORDER BY %s ASC, role ASC LIMIT %ld";
 
+// the rows of every table are together, see ObRouteUtils::fetch_batch_table_entry,
+// ('database_name', 'table_name') of every table is printed between the two parts
+static const char *PROXY_BATCH_PLAIN_SCHEMA_SQL_HEAD     =
+    "SELECT /*+READ_CONSISTENCY(WEAK)%s*/ * "
+    "FROM oceanbase.%s "
+    "WHERE tenant_name = '%.*s' AND (database_name, table_name) IN (";
+static const char *PROXY_BATCH_PLAIN_SCHEMA_SQL_TAIL     =
+    ") AND %s = %ld "
+    "ORDER BY database_name ASC, table_name ASC, role ASC LIMIT %ld";
+
 static const char *PROXY_PART_INFO_SQL                   =
     "SELECT /*+READ_CONSISTENCY(WEAK)*/ * "
     "FROM oceanbase.%s "
@@ -147,6 +157,11 @@ static void get_tenant_name(const ObString &origin_tenant_name, char *new_tenant
   }
 }
 
+static bool is_same_table(const ObTableEntryName &name, const ObTableEntryName &other)
+{
+  return name.database_name_ == other.database_name_ && name.table_name_ == other.table_name_;
+}
+
 int ObRouteUtils::get_table_entry_sql(char *sql_buf, const int64_t buf_len,
                                       ObTableEntryName &name,
                                       bool is_need_force_flush, /*false*/
@@ -190,6 +205,58 @@ int ObRouteUtils::get_table_entry_sql(char *sql_buf, const int64_t buf_len,
   return ret;
 }
 
+int ObRouteUtils::get_batch_table_entry_sql(char *sql_buf, const int64_t buf_len,
+                                            const ObIArray<ObTableEntry *> &entries,
+                                            const bool is_need_force_flush,
+                                            const int64_t cluster_version)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(sql_buf) || OB_UNLIKELY(buf_len <= 0) || OB_UNLIKELY(entries.empty())
+      || OB_ISNULL(entries.at(0))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid input value", LITERAL_K(sql_buf), K(buf_len), "count", entries.count(), K(ret));
+  } else {
+    int64_t pos = 0;
+    const int64_t FIRST_PARTITION_ID = 0;
+    char new_tenant_name_buf[OB_MAX_TENANT_NAME_LENGTH * 2 + 1];
+    ObString new_tenant_name;
+    get_tenant_name(entries.at(0)->get_names().tenant_name_, new_tenant_name_buf, new_tenant_name);
+    if (OB_FAIL(databuff_printf(sql_buf, buf_len, pos, PROXY_BATCH_PLAIN_SCHEMA_SQL_HEAD,
+                                is_need_force_flush ? ", FORCE_REFRESH_LOCATION_CACHE" : "",
+                                OB_ALL_VIRTUAL_PROXY_SCHEMA_TNAME,
+                                new_tenant_name.length(), new_tenant_name.ptr()))) {
+      LOG_WARN("fail to fill sql", K(buf_len), K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < entries.count(); ++i) {
+      if (OB_ISNULL(entries.at(i))) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("table entry should not be NULL", K(i), K(ret));
+      } else {
+        const ObTableEntryName &name = entries.at(i)->get_names();
+        bool is_dup = false;
+        for (int64_t j = 0; !is_dup && j < i; ++j) {
+          is_dup = is_same_table(name, entries.at(j)->get_names());
+        }
+        if (is_dup) {
+          // the rows are for all the entries with the same names
+        } else if (OB_FAIL(databuff_printf(sql_buf, buf_len, pos, "%s('%.*s', '%.*s')",
+                                           (0 == i) ? "" : ", ",
+                                           name.database_name_.length(), name.database_name_.ptr(),
+                                           name.table_name_.length(), name.table_name_.ptr()))) {
+          LOG_WARN("fail to fill sql", K(name), K(buf_len), K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(databuff_printf(sql_buf, buf_len, pos, PROXY_BATCH_PLAIN_SCHEMA_SQL_TAIL,
+                                                IS_CLUSTER_VERSION_LESS_THAN_V4(cluster_version) ? "partition_id" : "tablet_id",
+                                                FIRST_PARTITION_ID, INT64_MAX))) {
+      LOG_WARN("fail to fill sql", K(buf_len), K(ret));
+    }
+  }
+
+  return ret;
+}
+
 int ObRouteUtils::get_part_info_sql(char *sql_buf,
                                     const int64_t buf_len,
                                     const uint64_t table_id,
@@ -343,8 +410,33 @@ bool is_fake_ip_port(const char *ip_str, const int64_t port)
   return (NULL != ip_str && 0 == fake_ip.compare(ip_str) && fake_port == port);
 }
 
-int ObRouteUtils::fetch_table_entry(ObResultSetFetcher &rs_fetcher,
-                                    ObTableEntry &entry,
+// the replicas of a table collected from its rows of __all_virtual_proxy_schema
+struct ObTableLocationRows
+{
+  ObTableLocationRows() { reset(); }
+  void reset()
+  {
+    table_id_ = OB_INVALID_ID;
+    part_num_ = 0;
+    replica_num_ = 0;
+    schema_version_ = 0;
+    table_type_ = -1;
+    use_fake_addrs_ = false;
+    has_dup_replica_ = false;
+    server_list_.reuse();
+  }
+
+  uint64_t table_id_;
+  int64_t part_num_;
+  int64_t replica_num_;
+  int64_t schema_version_;
+  int32_t table_type_;
+  bool use_fake_addrs_;
+  bool has_dup_replica_;
+  ObSEArray<ObProxyReplicaLocation, 32> server_list_;
+};
+
+static int fetch_table_location_row(ObResultSetFetcher &rs_fetcher, ObTableLocationRows &rows,
                                     const int64_t cluster_version)
 {
   int ret = OB_SUCCESS;
@@ -352,116 +444,102 @@ int ObRouteUtils::fetch_table_entry(ObResultSetFetcher &rs_fetcher,
   char ip_str[MAX_IP_ADDR_LENGTH];
   ip_str[0] = '\0';
   int64_t port = 0;
-  uint64_t table_id = OB_INVALID_ID;
-  int64_t part_num = 0;
-  int64_t replica_num = 0;
-  int64_t schema_version = 0;
   int64_t role = -1;
   int32_t replica_type = -1;
   int32_t dup_replica_type = 0;
-  int32_t table_type = -1;
   ObProxyReplicaLocation prl;
-  ObProxyPartitionLocation *ppl = NULL;
-  ObTenantServer *pts = NULL;
-  ObSEArray<ObProxyReplicaLocation, 32> server_list;
-  const bool is_dummy_entry = entry.is_dummy_entry();
-  bool use_fake_addrs = false;
-  bool has_dup_replica = false;
-
-  while ((OB_SUCC(ret)) && (OB_SUCC(rs_fetcher.next()))) {
-    ip_str[0] = '\0';
-    port = 0;
-    prl.reset();
-    role = -1;
-    replica_type = -1;
-    table_type = -1;
 
-    PROXY_EXTRACT_STRBUF_FIELD_MYSQL(rs_fetcher, "svr_ip", ip_str, MAX_IP_ADDR_LENGTH, tmp_real_str_len);
-    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "sql_port", port, int64_t);
-    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "table_id", table_id, uint64_t);
-    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "role", role, int64_t);
-    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "part_num", part_num, int64_t);
-    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "replica_num", replica_num, int64_t);
+  PROXY_EXTRACT_STRBUF_FIELD_MYSQL(rs_fetcher, "svr_ip", ip_str, MAX_IP_ADDR_LENGTH, tmp_real_str_len);
+  PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "sql_port", port, int64_t);
+  PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "table_id", rows.table_id_, uint64_t);
+  PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "role", role, int64_t);
+  PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "part_num", rows.part_num_, int64_t);
+  PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "replica_num", rows.replica_num_, int64_t);
 
-    if (OB_SUCC(ret)) {
-      PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "schema_version", schema_version, int64_t);
-      if (OB_ERR_COLUMN_NOT_FOUND == ret) {
-        LOG_DEBUG("can not found schema_version, maybe is old server, ignore", K(ret));
-        ret = OB_SUCCESS;
-        schema_version = 0;
-      }
+  if (OB_SUCC(ret)) {
+    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "schema_version", rows.schema_version_, int64_t);
+    if (OB_ERR_COLUMN_NOT_FOUND == ret) {
+      LOG_DEBUG("can not found schema_version, maybe is old server, ignore", K(ret));
+      ret = OB_SUCCESS;
+      rows.schema_version_ = 0;
     }
+  }
 
-    if (OB_SUCC(ret)) {
-      if (IS_CLUSTER_VERSION_LESS_THAN_V4(cluster_version)) {
-        PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "spare1", replica_type, int32_t);
-      } else {
-        PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "replica_type", replica_type, int32_t);
-      }
-      if (OB_ERR_COLUMN_NOT_FOUND == ret) {
-        LOG_DEBUG("can not find spare1, maybe is old server, ignore", K(replica_type), K(ret));
-        ret = OB_SUCCESS;
-        replica_type = 0;
-      }
+  if (OB_SUCC(ret)) {
+    if (IS_CLUSTER_VERSION_LESS_THAN_V4(cluster_version)) {
+      PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "spare1", replica_type, int32_t);
+    } else {
+      PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "replica_type", replica_type, int32_t);
+    }
+    if (OB_ERR_COLUMN_NOT_FOUND == ret) {
+      LOG_DEBUG("can not find spare1, maybe is old server, ignore", K(replica_type), K(ret));
+      ret = OB_SUCCESS;
+      replica_type = 0;
     }
+  }
 
-    if (OB_SUCC(ret)) {
-      if (IS_CLUSTER_VERSION_LESS_THAN_V4(cluster_version)) {
-        PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "spare2", dup_replica_type, int32_t);
-      } else {
-        PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "dup_replica_type", dup_replica_type, int32_t);
-      }
-      if (OB_ERR_COLUMN_NOT_FOUND == ret) {
-        LOG_DEBUG("can not find spare2, maybe is old server, ignore", K(dup_replica_type), K(ret));
-        ret = OB_SUCCESS;
-        dup_replica_type = 0;
-      }
+  if (OB_SUCC(ret)) {
+    if (IS_CLUSTER_VERSION_LESS_THAN_V4(cluster_version)) {
+      PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "spare2", dup_replica_type, int32_t);
+    } else {
+      PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "dup_replica_type", dup_replica_type, int32_t);
+    }
+    if (OB_ERR_COLUMN_NOT_FOUND == ret) {
+      LOG_DEBUG("can not find spare2, maybe is old server, ignore", K(dup_replica_type), K(ret));
+      ret = OB_SUCCESS;
+      dup_replica_type = 0;
     }
+  }
 
-    if (OB_SUCC(ret)) {
-      PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "table_type", table_type, int32_t);
-      if (OB_ERR_COLUMN_NOT_FOUND == ret) {
-        LOG_DEBUG("can not found table_type, maybe is old server, ignore", K(ret));
-        ret = OB_SUCCESS;
-        table_type = -1;
-      }
+  if (OB_SUCC(ret)) {
+    rows.table_type_ = -1;
+    PROXY_EXTRACT_INT_FIELD_MYSQL(rs_fetcher, "table_type", rows.table_type_, int32_t);
+    if (OB_ERR_COLUMN_NOT_FOUND == ret) {
+      LOG_DEBUG("can not found table_type, maybe is old server, ignore", K(ret));
+      ret = OB_SUCCESS;
+      rows.table_type_ = -1;
     }
+  }
 
-    if (OB_SUCC(ret)) {
-      prl.role_ = static_cast<ObRole>(role);
-      if (OB_FAIL(prl.add_addr(ip_str, port))) {
-        if (is_fake_ip_port(ip_str, port)) {
-          use_fake_addrs = true;
-        } else {
-          LOG_WARN("invalid ip, port in fetching table entry, just skip it,"
-                   " do not return err", K(ip_str), K(port), K(ret));
-        }
-        ret = OB_SUCCESS;
-      } else if (OB_UNLIKELY(LEADER != prl.role_) && OB_UNLIKELY(FOLLOWER != prl.role_)) {
-        LOG_WARN("invalid role in fetching table entry, just skip it,"
-                 " do not return err", "role", prl.role_);
-        ret = OB_SUCCESS;
-      } else if (OB_FAIL(prl.set_replica_type(replica_type))) {
-        LOG_WARN("invalid replica_type in fetching table entry, just skip it,"
-                 " do not return err", "replica_type", replica_type);
-        ret = OB_SUCCESS;
-      } else if (FALSE_IT(prl.set_dup_replica_type(dup_replica_type))) {
-        // can not happen
-      } else if (OB_FAIL(server_list.push_back(prl))) {
-        LOG_WARN("fail to add server", K(prl), K(ret));
+  if (OB_SUCC(ret)) {
+    prl.role_ = static_cast<ObRole>(role);
+    if (OB_FAIL(prl.add_addr(ip_str, port))) {
+      if (is_fake_ip_port(ip_str, port)) {
+        rows.use_fake_addrs_ = true;
       } else {
-        if (prl.is_dup_replica() && !has_dup_replica) {
-          has_dup_replica = true;
-        }
-      }//end of else
-    }//end of OB_SUCC(ret)
-  }
+        LOG_WARN("invalid ip, port in fetching table entry, just skip it,"
+                 " do not return err", K(ip_str), K(port), K(ret));
+      }
+      ret = OB_SUCCESS;
+    } else if (OB_UNLIKELY(LEADER != prl.role_) && OB_UNLIKELY(FOLLOWER != prl.role_)) {
+      LOG_WARN("invalid role in fetching table entry, just skip it,"
+               " do not return err", "role", prl.role_);
+      ret = OB_SUCCESS;
+    } else if (OB_FAIL(prl.set_replica_type(replica_type))) {
+      LOG_WARN("invalid replica_type in fetching table entry, just skip it,"
+               " do not return err", "replica_type", replica_type);
+      ret = OB_SUCCESS;
+    } else if (FALSE_IT(prl.set_dup_replica_type(dup_replica_type))) {
+      // can not happen
+    } else if (OB_FAIL(rows.server_list_.push_back(prl))) {
+      LOG_WARN("fail to add server", K(prl), K(ret));
+    } else {
+      if (prl.is_dup_replica() && !rows.has_dup_replica_) {
+        rows.has_dup_replica_ = true;
+      }
+    }//end of else
+  }//end of OB_SUCC(ret)
+  return ret;
+}
 
-  if (OB_ITER_END == ret) {
-    ret = OB_SUCCESS;
-  }
+static int fill_table_entry(const ObTableLocationRows &rows, ObTableEntry &entry)
+{
+  int ret = OB_SUCCESS;
+  ObProxyPartitionLocation *ppl = NULL;
+  ObTenantServer *pts = NULL;
+  const ObIArray<ObProxyReplicaLocation> &server_list = rows.server_list_;
 
-  if (OB_SUCC(ret) && is_dummy_entry) {
+  if (entry.is_dummy_entry()) {
     if (!server_list.empty()) {
       if (OB_ISNULL(pts = op_alloc(ObTenantServer))) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -478,17 +556,15 @@ int ObRouteUtils::fetch_table_entry(ObResultSetFetcher &rs_fetcher,
         pts = NULL;
         entry.set_part_num(1);
         entry.set_replica_num(entry.get_tenant_servers()->replica_count());
-        entry.set_table_id(table_id);
-        entry.set_schema_version(schema_version);
+        entry.set_table_id(rows.table_id_);
+        entry.set_schema_version(rows.schema_version_);
         LOG_INFO("this is all_dummy table, use tenant servers", K(entry), K(server_list));
       }
     } else {
       LOG_INFO("can not find tenant servers, empty resultset", K(server_list));
     }
-  }
-
-  if (OB_SUCC(ret) && !is_dummy_entry) {
-    if (!server_list.empty() || use_fake_addrs) {
+  } else {
+    if (!server_list.empty() || rows.use_fake_addrs_) {
       if (OB_ISNULL(ppl = op_alloc(ObProxyPartitionLocation))) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
         LOG_WARN("fail to allocate memory for ObProxyPartitionLocation", K(ret));
@@ -498,14 +574,14 @@ int ObRouteUtils::fetch_table_entry(ObResultSetFetcher &rs_fetcher,
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("ppl should not unavailable", KPC(ppl), K(ret));
       } else {
-        const bool is_empty_entry_allowed = (use_fake_addrs && server_list.empty());
+        const bool is_empty_entry_allowed = (rows.use_fake_addrs_ && server_list.empty());
         entry.set_allow_empty_entry(is_empty_entry_allowed);
-        entry.set_part_num(part_num);
-        entry.set_replica_num(replica_num);
-        entry.set_schema_version(schema_version);
-        entry.set_table_id(table_id);
-        entry.set_table_type(table_type);
-        if (has_dup_replica) {
+        entry.set_part_num(rows.part_num_);
+        entry.set_replica_num(rows.replica_num_);
+        entry.set_schema_version(rows.schema_version_);
+        entry.set_table_id(rows.table_id_);
+        entry.set_table_type(rows.table_type_);
+        if (rows.has_dup_replica_) {
           entry.set_has_dup_replica();
         }
         if (entry.is_non_partition_table() && ppl->is_valid()) {
@@ -536,6 +612,134 @@ int ObRouteUtils::fetch_table_entry(ObResultSetFetcher &rs_fetcher,
   return ret;
 }
 
+int ObRouteUtils::fetch_table_entry(ObResultSetFetcher &rs_fetcher,
+                                    ObTableEntry &entry,
+                                    const int64_t cluster_version)
+{
+  int ret = OB_SUCCESS;
+  ObTableLocationRows rows;
+
+  while ((OB_SUCC(ret)) && (OB_SUCC(rs_fetcher.next()))) {
+    if (OB_FAIL(fetch_table_location_row(rs_fetcher, rows, cluster_version))) {
+      LOG_WARN("fail to fetch table location row", K(ret));
+    }
+  }
+
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+
+  if (OB_SUCC(ret) && OB_FAIL(fill_table_entry(rows, entry))) {
+    LOG_WARN("fail to fill table entry", K(entry), K(ret));
+  }
+  return ret;
+}
+
+// the rows of a table are of the first entry with the same names, or if there is none
+// (the names of the rows are in different case), the first one with the same names ignoring case
+static int64_t get_batch_entry_idx(const ObIArray<ObTableEntry *> &entries,
+                                   const ObString &database_name, const ObString &table_name)
+{
+  int64_t idx = -1;
+  for (int64_t i = 0; i < entries.count() && idx < 0; ++i) {
+    const ObTableEntryName &name = entries.at(i)->get_names();
+    if (name.database_name_ == database_name && name.table_name_ == table_name) {
+      idx = i;
+    }
+  }
+  for (int64_t i = 0; i < entries.count() && idx < 0; ++i) {
+    const ObTableEntryName &name = entries.at(i)->get_names();
+    if (0 == name.database_name_.case_compare(database_name)
+        && 0 == name.table_name_.case_compare(table_name)) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+// fill the entry of idx and the following ones with the same names
+static int fill_batch_table_entry(const ObTableLocationRows &rows, ObIArray<ObTableEntry *> &entries,
+                                  const int64_t idx, ObIArray<bool> &is_filled)
+{
+  int ret = OB_SUCCESS;
+  const ObTableEntryName &name = entries.at(idx)->get_names();
+  for (int64_t i = idx; OB_SUCC(ret) && i < entries.count(); ++i) {
+    if (is_same_table(name, entries.at(i)->get_names())) {
+      if (OB_FAIL(fill_table_entry(rows, *entries.at(i)))) {
+        LOG_WARN("fail to fill table entry", KPC(entries.at(i)), K(ret));
+      } else {
+        is_filled.at(i) = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRouteUtils::fetch_batch_table_entry(ObResultSetFetcher &rs_fetcher,
+                                          ObIArray<ObTableEntry *> &entries,
+                                          const int64_t cluster_version)
+{
+  int ret = OB_SUCCESS;
+  ObString database_name;
+  ObString table_name;
+  ObTableLocationRows rows;
+  ObSEArray<bool, 32> is_filled;
+  int64_t cur_idx = -1;
+  int64_t idx = -1;
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < entries.count(); ++i) {
+    if (OB_ISNULL(entries.at(i))) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("table entry should not be NULL", K(i), K(ret));
+    } else if (OB_FAIL(is_filled.push_back(false))) {
+      LOG_WARN("fail to push back", K(ret));
+    }
+  }
+
+  // the rows are ordered by table, fill an entry once all its rows are fetched
+  while ((OB_SUCC(ret)) && (OB_SUCC(rs_fetcher.next()))) {
+    PROXY_EXTRACT_VARCHAR_FIELD_MYSQL(rs_fetcher, "database_name", database_name);
+    PROXY_EXTRACT_VARCHAR_FIELD_MYSQL(rs_fetcher, "table_name", table_name);
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fail to get table name of row", K(ret));
+    } else if ((idx = get_batch_entry_idx(entries, database_name, table_name)) < 0) {
+      LOG_WARN("row of unexpected table in fetching table entries, just skip it,"
+               " do not return err", K(database_name), K(table_name));
+    } else {
+      if (idx != cur_idx) {
+        if (OB_UNLIKELY(is_filled.at(idx))) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("rows of a table are not together", K(database_name), K(table_name), K(ret));
+        } else if (cur_idx >= 0 && OB_FAIL(fill_batch_table_entry(rows, entries, cur_idx, is_filled))) {
+          LOG_WARN("fail to fill batch table entry", K(cur_idx), K(ret));
+        } else {
+          rows.reset();
+          cur_idx = idx;
+        }
+      }
+      if (OB_SUCC(ret) && OB_FAIL(fetch_table_location_row(rs_fetcher, rows, cluster_version))) {
+        LOG_WARN("fail to fetch table location row", K(ret));
+      }
+    }
+  }
+
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+
+  if (OB_SUCC(ret) && cur_idx >= 0
+      && OB_FAIL(fill_batch_table_entry(rows, entries, cur_idx, is_filled))) {
+    LOG_WARN("fail to fill batch table entry", K(cur_idx), K(ret));
+  }
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < entries.count(); ++i) {
+    if (!is_filled.at(i)) {
+      LOG_INFO("can not find table location, empty resultset", "name", entries.at(i)->get_names());
+    }
+  }
+  return ret;
+}
+
 int ObRouteUtils::split_part_expr(ObString expr, ObIArray<ObString> &arr)
 {
   int ret = OB_SUCCESS;
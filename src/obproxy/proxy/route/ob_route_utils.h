@@ -43,6 +43,10 @@ class ObRouteUtils
 public:
   static int get_table_entry_sql(char *sql_buf, const int64_t buf_len, ObTableEntryName &name,
                                  bool is_need_force_flush, const int64_t cluster_version);
+  // one query for the table entries of one tenant, see ObTableEntryBatchCont
+  static int get_batch_table_entry_sql(char *sql_buf, const int64_t buf_len,
+                                       const common::ObIArray<ObTableEntry *> &entries,
+                                       const bool is_need_force_flush, const int64_t cluster_version);
   static int get_part_info_sql(char *sql_buf, const int64_t buf_len, const uint64_t table_id,
                                ObTableEntryName &name, const int64_t cluster_version);
   static int get_first_part_sql(char *sql_buf, const int64_t buf_len, const uint64_t table_id,
@@ -52,6 +56,9 @@ public:
 
   static int fetch_table_entry(obproxy::ObResultSetFetcher &rs_fetcher, ObTableEntry &entry,
                                const int64_t cluster_version);
+  static int fetch_batch_table_entry(obproxy::ObResultSetFetcher &rs_fetcher,
+                                     common::ObIArray<ObTableEntry *> &entries,
+                                     const int64_t cluster_version);
   static int fetch_part_info(obproxy::ObResultSetFetcher &rs_fetcher, ObProxyPartInfo &part_info,
                              const int64_t cluster_version);
   static int fetch_first_part(obproxy::ObResultSetFetcher &rs_fetcher, ObProxyPartInfo &part_info,
@@ -41,8 +41,12 @@ public:
                                      const ObRoutineEntryKey &key,
                                      const uint64_t hash,
                                      const bool is_add_building_entry,
-                                     bool &is_locked,
+                                     bool &is_finished,
                                      ObRoutineEntry *&routine);
+  static int check_routine_entry(ObRoutineCache &routine_cache,
+                                 const ObRoutineEntryKey &key,
+                                 ObRoutineEntry *acquired_entry,
+                                 ObRoutineEntry *&entry);
 
 
    static int add_building_routine_entry(ObRoutineCache &routine_cache,
@@ -121,10 +125,10 @@ int ObRoutineCacheCont::get_routine_entry(const int event, ObEvent *e)
     LOG_INFO("cont::action has been cancelled", K_(key), K(this));
     destroy();
   } else {
-    bool is_locked = false;
+    bool is_finished = false;
     ObRoutineEntry *tmp_entry = NULL;
     if (OB_FAIL(get_routine_entry_local(routine_cache_, key_, hash_,
-            is_add_building_entry_, is_locked, tmp_entry))) {
+            is_add_building_entry_, is_finished, tmp_entry))) {
       if (NULL != tmp_entry) {
         tmp_entry->dec_ref();
         tmp_entry = NULL;
@@ -132,7 +136,7 @@ int ObRoutineCacheCont::get_routine_entry(const int event, ObEvent *e)
       LOG_WARN("fail to get routine entry", K_(key), K(ret));
     }
 
-    if (OB_SUCC(ret) && !is_locked) {
+    if (OB_SUCC(ret) && !is_finished) {
       LOG_DEBUG("cont::get_routine_entry MUTEX_TRY_LOCK failed, and will schedule in interval(ns)",
                 LITERAL_K(ObRoutineCacheParam::SCHEDULE_ROUTINE_CACHE_CONT_INTERVAL));
       if (OB_ISNULL(self_ethread().schedule_in(this, ObRoutineCacheParam::SCHEDULE_ROUTINE_CACHE_CONT_INTERVAL))) {
@@ -148,7 +152,7 @@ int ObRoutineCacheCont::get_routine_entry(const int event, ObEvent *e)
 
       *ppentry_ = tmp_entry;
       tmp_entry = NULL;
-      // failed or locked
+      // failed or finished
       action_.continuation_->handle_event(ROUTINE_ENTRY_LOOKUP_CACHE_DONE, NULL);
       destroy();
     }
@@ -162,53 +166,80 @@ int ObRoutineCacheCont::get_routine_entry_local(
     const ObRoutineEntryKey &key,
     const uint64_t hash,
     const bool is_add_building_entry,
-    bool &is_locked,
+    bool &is_finished,
     ObRoutineEntry *&entry)
 {
   int ret = OB_SUCCESS;
-  is_locked = false;
+  is_finished = false;
   entry = NULL;
 
-  ObProxyMutex *bucket_mutex = routine_cache.lock_for_key(hash);
-  MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
-  if (lock_bucket.is_locked()) {
-    is_locked = true;
-    if (OB_FAIL(routine_cache.run_todo_list(routine_cache.part_num(hash)))) {
-      LOG_WARN("fail to run todo list", K(key), K(hash), K(ret));
-    } else {
-      entry = routine_cache.lookup_entry(hash, key);
-      if (NULL != entry) {
-        if (routine_cache.is_routine_entry_expired(*entry)) {
-          LOG_INFO("the routine entry is expired", "expire_time_us",
-                   routine_cache.get_cache_expire_time_us(), KPC(entry));
-          entry = NULL;
-          // remove the expired routine entry in locked
-          if (OB_FAIL(routine_cache.remove_routine_entry(key))) {
-            LOG_WARN("fail to remove routine entry", K(key), K(ret));
-          }
-        } else {
-          entry->inc_ref();
-          LOG_DEBUG("cont::get_routine_entry_local, entry found succ", KPC(entry));
-        }
+  // a hit needs no bucket lock, only a miss goes through the todo list
+  if (OB_FAIL(routine_cache.try_run_todo_list(hash))) {
+    LOG_WARN("fail to run todo list", K(key), K(hash), K(ret));
+  } else if (OB_FAIL(check_routine_entry(routine_cache, key, routine_cache.acquire_entry(hash, key), entry))) {
+    LOG_WARN("fail to check routine entry", K(key), K(ret));
+  } else if (NULL != entry) {
+    is_finished = true;
+    LOG_DEBUG("cont::get_routine_entry_local, entry found succ", KPC(entry));
+  } else {
+    ObProxyMutex *bucket_mutex = routine_cache.lock_for_key(hash);
+    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
+    if (lock_bucket.is_locked()) {
+      is_finished = true;
+      if (OB_FAIL(routine_cache.run_todo_list(routine_cache.part_num(hash)))) {
+        LOG_WARN("fail to run todo list", K(key), K(hash), K(ret));
+      } else if (OB_FAIL(check_routine_entry(routine_cache, key, routine_cache.acquire_entry(hash, key), entry))) {
+        LOG_WARN("fail to check routine entry", K(key), K(ret));
+      } else if (NULL != entry) {
+        LOG_DEBUG("cont::get_routine_entry_local, entry found succ", KPC(entry));
       } else {
         // non-existent, return NULL
       }
-    }
 
-    if (NULL == entry) {
-      if (is_add_building_entry) {
-        if (OB_FAIL(add_building_routine_entry(routine_cache, key))) {
-          LOG_WARN("fail to building routine entry", K(key), K(ret));
+      if (NULL == entry) {
+        if (is_add_building_entry) {
+          if (OB_FAIL(add_building_routine_entry(routine_cache, key))) {
+            LOG_WARN("fail to building routine entry", K(key), K(ret));
+          } else {
+            // nothing
+          }
         } else {
-          // nothing
+          LOG_DEBUG("cont::get_routine_entry_local, entry not found", K(key));
         }
-      } else {
-        LOG_DEBUG("cont::get_routine_entry_local, entry not found", K(key));
       }
+      lock_bucket.release();
     }
-    lock_bucket.release();
   }
 
+  if (is_finished) {
+    if (NULL != entry) {
+      routine_cache.get_policy().record_hit();
+    } else {
+      routine_cache.get_policy().record_miss(hash);
+    }
+  }
+  return ret;
+}
+
+// release the expired entry and remove it from the cache
+int ObRoutineCacheCont::check_routine_entry(ObRoutineCache &routine_cache,
+                                            const ObRoutineEntryKey &key,
+                                            ObRoutineEntry *acquired_entry,
+                                            ObRoutineEntry *&entry)
+{
+  int ret = OB_SUCCESS;
+  entry = acquired_entry;
+  if (NULL != entry) {
+    if (routine_cache.is_routine_entry_expired(*entry)) {
+      LOG_INFO("the routine entry is expired", "expire_time_us",
+               routine_cache.get_cache_expire_time_us(), KPC(entry));
+      entry->dec_ref();
+      entry = NULL;
+      if (OB_FAIL(routine_cache.remove_routine_entry(key))) {
+        LOG_WARN("fail to remove routine entry", K(key), K(ret));
+      }
+    }
+  }
   return ret;
 }
 
@@ -376,17 +407,17 @@ int ObRoutineCache::get_routine_entry(
     uint64_t hash = key.hash();
     LOG_DEBUG("begin to get routine location entry", K(ppentry), K(key), K(cont), K(hash));
 
-    bool is_locked = false;
+    bool is_finished = false;
     ObRoutineEntry *tmp_entry = NULL;
     if (OB_FAIL(ObRoutineCacheCont::get_routine_entry_local(*this, key, hash,
-            is_add_building_entry, is_locked, tmp_entry))) {
+            is_add_building_entry, is_finished, tmp_entry))) {
       if (NULL != tmp_entry) {
         tmp_entry->dec_ref();
         tmp_entry = NULL;
       }
       LOG_WARN("fail to get routine entry", K(key), K(ret));
     } else {
-      if (is_locked) {
+      if (is_finished) {
         *ppentry = tmp_entry;
         tmp_entry = NULL;
       } else {
@@ -439,6 +470,8 @@ int ObRoutineCache::add_routine_entry(ObRoutineEntry &entry, bool direct_add)
     entry.get_key(key);
     uint64_t hash = key.hash();
     LOG_DEBUG("add routine location", K(part_num(hash)), K(entry), K(direct_add), K(hash));
+    // admit the key with the frequency it had before it missed or was evicted
+    entry.merge_frequency(policy_.estimate(hash));
     if (!direct_add) {
       ObProxyMutex *bucket_mutex = lock_for_key(hash);
       MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
@@ -446,8 +479,11 @@ int ObRoutineCache::add_routine_entry(ObRoutineEntry &entry, bool direct_add)
         if (OB_FAIL(run_todo_list(part_num(hash)))) {
           LOG_WARN("fail to run todo list", K(ret));
         } else {
-          ObRoutineEntry *tmp_entry = insert_entry(hash, key, &entry);
-          if (NULL != tmp_entry) {
+          ObRoutineEntry *tmp_entry = NULL;
+          if (OB_FAIL(insert_entry(hash, key, &entry, tmp_entry))) {
+            LOG_WARN("fail to insert routine entry", K(entry), K(ret));
+          } else if (NULL != tmp_entry) {
+            entry.merge_frequency(tmp_entry->get_frequency()); // the new entry inherits the frequency
             tmp_entry->set_deleted_state(); // used to update tc_routine_map
             tmp_entry->dec_ref();
             tmp_entry = NULL;
@@ -521,6 +557,20 @@ int ObRoutineCache::remove_routine_entry(const ObRoutineEntryKey &key)
   return ret;
 }
 
+int ObRoutineCache::try_run_todo_list(const uint64_t hash)
+{
+  int ret = OB_SUCCESS;
+  // lookup never waits for the bucket lock, pending ops are applied only if it is free
+  if (!todo_lists_[part_num(hash)].empty()) {
+    ObProxyMutex *bucket_mutex = lock_for_key(hash);
+    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
+    if (lock_bucket.is_locked() && OB_FAIL(run_todo_list(part_num(hash)))) {
+      LOG_WARN("fail to run todo list", K(hash), K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObRoutineCache::run_todo_list(const int64_t buck_id)
 {
   int ret = OB_SUCCESS;
@@ -570,8 +620,12 @@ int ObRoutineCache::process(const int64_t buck_id, ObRoutineCacheParam *param)
     ObRoutineEntry *entry = NULL;
     switch (param->op_) {
       case ObRoutineCacheParam::ADD_ROUTINE_OP: {
-        entry = insert_entry(param->hash_, param->key_, param->entry_);
-        if (NULL != entry) {
+        if (OB_FAIL(insert_entry(param->hash_, param->key_, param->entry_, entry))) {
+          LOG_WARN("fail to insert routine entry", KPC(param), K(ret));
+          // the cache does not hold the entry handed to it
+          param->entry_->dec_ref();
+        } else if (NULL != entry) {
+          param->entry_->merge_frequency(entry->get_frequency()); // the new entry inherits the frequency
           entry->set_deleted_state(); // used to update tc_routine_map
           entry->dec_ref(); // free old entry
           entry = NULL;
@@ -75,7 +75,7 @@ class ObRoutineCache : public RoutineEntryHashMap
 public:
   static const int64_t ROUTINE_CACHE_MAP_SIZE = 10240;
 
-  ObRoutineCache() : is_inited_(false), expire_time_us_(0) {}
+  ObRoutineCache() : is_inited_(false), expire_time_us_(0), policy_() {}
   virtual ~ObRoutineCache() { destroy(); }
   int init(const int64_t bucket_size);
 
@@ -89,11 +89,14 @@ public:
   int remove_routine_entry(const ObRoutineEntryKey &key);
 
   int run_todo_list(const int64_t buck_id);
+  // apply the pending ops of the bucket of hash only if its lock is free
+  int try_run_todo_list(const uint64_t hash);
 
   void set_cache_expire_time(const int64_t relative_time_s);
   int64_t get_cache_expire_time_us() const { return expire_time_us_; }
+  ObRouteCachePolicy &get_policy() { return policy_; }
   bool is_routine_entry_expired(const ObRoutineEntry &entry);
-  TO_STRING_KV(K_(is_inited), K_(expire_time_us));
+  TO_STRING_KV(K_(is_inited), K_(expire_time_us), K_(policy));
 
   static bool gc_routine_entry(ObRoutineEntry *entry);
 
@@ -104,6 +107,7 @@ private:
 private:
   bool is_inited_;
   int64_t expire_time_us_;
+  ObRouteCachePolicy policy_;
   common::ObAtomicList todo_lists_[obutils::MT_HASHTABLE_PARTITIONS];
   DISALLOW_COPY_AND_ASSIGN(ObRoutineCache);
 };
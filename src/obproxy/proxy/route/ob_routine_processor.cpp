@@ -663,6 +663,7 @@ int ObRoutineProcessor::get_routine_entry_from_thread_cache(
         tmp_entry->dec_ref();
         tmp_entry = NULL;
       } else {
+        get_global_routine_cache().get_policy().record_hit();
         LOG_DEBUG("get routine entry from thread cache succ", KPC(tmp_entry));
       }
     }
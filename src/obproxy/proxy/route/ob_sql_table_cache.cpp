@@ -67,6 +67,7 @@ void ObSqlTableCache::get_sql_table_entry_from_thread_cache(const ObSqlTableEntr
     entry = NULL;
   }
   if (NULL != entry) {
+    policy_.record_hit();
     LOG_DEBUG("succ to get ObSqlTableEntry from thread cache", KPC(entry));
   }
 }
@@ -82,20 +83,24 @@ int ObSqlTableCache::get_table_name(const ObSqlTableEntryKey &key, char *buf, co
     ObSqlTableEntry *entry;
     get_sql_table_entry_from_thread_cache(key, entry);
     if (NULL == entry) {
-      uint64_t hash = key.hash();
-      DRWLock &rw_lock = rw_lock_for_key(hash);
-      DRWLock::RDLockGuard lock(rw_lock);
-      entry = lookup_entry(hash, key);
+      // no need read lock, the entry got has been inc_ref'd
+      const uint64_t hash = key.hash();
+      entry = acquire_entry(hash, key);
+      if (NULL != entry) {
+        policy_.record_hit();
+      } else {
+        policy_.record_miss(hash);
+      }
       if (NULL != entry && entry->is_avail_state()) {
         LOG_DEBUG("succ to get ObSqlTableEntry from global cache", KPC(entry));
-        entry->inc_ref();
         // add into thread cache, will add inc_ref
         ObSqlTableRefHashMap &sql_table_map = self_ethread().get_sql_table_map();
         if (OB_FAIL(sql_table_map.set(entry))) {
           LOG_WARN("fail to set thread sql table map", KPC(entry), K(ret));
           ret = OB_SUCCESS; // ignore ret
         }
-      } else {
+      } else if (NULL != entry) {
+        entry->dec_ref();
         entry = NULL;
       }
     }
@@ -144,16 +149,14 @@ int ObSqlTableCache::update_sql_table_entry(ObSqlTableEntry &entry)
   ObSqlTableEntry *tmp_entry = NULL;
   ObSqlTableEntry *old_entry = NULL;
   bool need_update_cache = true;
-  {
-    DRWLock::RDLockGuard lock(rw_lock);
-    if (NULL != (old_entry = lookup_entry(hash, key))) {
-      if (entry.get_table_name() == old_entry->get_table_name()
-          || !entry.is_table_from_reroute()) {
-        LOG_DEBUG("the same table name or table name from parse result, no need update", K(key), KPC(old_entry), K(entry));
-        need_update_cache = false;
-      } 
-      old_entry = NULL;
+  if (NULL != (old_entry = acquire_entry(hash, key))) {
+    if (entry.get_table_name() == old_entry->get_table_name()
+        || !entry.is_table_from_reroute()) {
+      LOG_DEBUG("the same table name or table name from parse result, no need update", K(key), KPC(old_entry), K(entry));
+      need_update_cache = false;
     }
+    old_entry->dec_ref();
+    old_entry = NULL;
   }
   if (need_update_cache) {
     DRWLock::WRLockGuard lock(rw_lock);
@@ -168,10 +171,20 @@ int ObSqlTableCache::update_sql_table_entry(ObSqlTableEntry &entry)
     }
     if (need_update_cache) {
       entry.inc_ref();
-      tmp_entry = insert_entry(hash, key, &entry);
-      entry.renew_last_update_time_us();
-      entry.renew_last_access_time_us();
-      LOG_INFO("succ to update sql table entry", K(hash), KPC(tmp_entry), K(entry));
+      // admit the key with the frequency it had before it was evicted or replaced
+      entry.merge_frequency(policy_.estimate(hash));
+      if (OB_FAIL(insert_entry(hash, key, &entry, tmp_entry))) {
+        LOG_WARN("fail to insert sql table entry", K(hash), K(entry), K(ret));
+        entry.dec_ref();
+        need_update_cache = false;
+      } else {
+        if (NULL != tmp_entry) {
+          entry.merge_frequency(tmp_entry->get_frequency());
+        }
+        entry.renew_last_update_time_us();
+        entry.renew_last_access_time_us();
+        LOG_INFO("succ to update sql table entry", K(hash), KPC(tmp_entry), K(entry));
+      }
     }
   }
   // no need write lock, direct update thread cache
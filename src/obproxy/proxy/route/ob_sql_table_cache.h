@@ -39,7 +39,7 @@ class ObSqlTableCache : public SqlTableEntryHashMap
 public:
   static const int64_t SQL_TABLE_CACHE_MAP_SIZE = 1024;
 
-  ObSqlTableCache() : is_inited_(false), expire_time_us_(0) {}
+  ObSqlTableCache() : is_inited_(false), expire_time_us_(0), policy_() {}
   virtual ~ObSqlTableCache() { destroy(); }
 
   int init(const int64_t bucket_size);
@@ -50,6 +50,7 @@ public:
 
   void set_cache_expire_time(const int64_t relative_time_s);
   int64_t get_cache_expire_time_us() const { return expire_time_us_; }
+  ObRouteCachePolicy &get_policy() { return policy_; }
   bool is_sql_table_entry_expired(const ObSqlTableEntry &entry);
   int remove_sql_table_entry(const ObSqlTableEntryKey &key);
   
@@ -64,6 +65,7 @@ private:
 private:
   bool is_inited_;
   int64_t expire_time_us_;
+  ObRouteCachePolicy policy_;
   DISALLOW_COPY_AND_ASSIGN(ObSqlTableCache);
 };
 
@@ -18,6 +18,7 @@
 #include "iocore/eventsystem/ob_thread.h"
 #include "lib/time/ob_hrtime.h"
 #include "lib/list/ob_intrusive_list.h"
+#include "proxy/route/ob_route_cache_policy.h"
 
 namespace oceanbase
 {
@@ -110,7 +111,7 @@ public:
   ObSqlTableEntry()
     : common::ObSharedRefCount(), state_(BORN), is_table_from_reroute_(false), table_name_(), key_(),
       buf_len_(0), buf_start_(NULL), create_time_us_(0),
-      last_access_time_us_(0), last_update_time_us_(0) {}
+      last_access_time_us_(0), last_update_time_us_(0), frequency_(0) {}
 
   virtual ~ObSqlTableEntry() {}
 
@@ -134,15 +135,19 @@ public:
 
   int64_t get_cr_version() const { return key_.cr_version_; }
   void set_create_time() { create_time_us_ = common::hrtime_to_usec(event::get_hrtime()); }
-  void renew_last_access_time_us() { last_access_time_us_ = common::hrtime_to_usec(event::get_hrtime()); }
+  void renew_last_access_time_us();
   void renew_last_update_time_us() { last_update_time_us_ = common::hrtime_to_usec(event::get_hrtime()); }
   int64_t get_last_access_time_us() const { return last_access_time_us_; }
   int64_t get_create_time_us() const { return create_time_us_; }
   int64_t get_last_update_time_us() const { return last_update_time_us_; }
+  // sampled access frequency, see ObRouteCachePolicy
+  int64_t get_frequency() const { return frequency_; }
+  void age_frequency() { ObRouteCachePolicy::age_frequency(frequency_); }
+  void merge_frequency(const int64_t frequency) { ObRouteCachePolicy::merge_frequency(frequency_, frequency); }
 
   TO_STRING_KV(KP(this), K_(state), K_(is_table_from_reroute), K_(key), K_(table_name),
                K_(create_time_us), K_(last_access_time_us),
-               K_(last_update_time_us),
+               K_(last_update_time_us), K_(frequency),
                KP_(buf_start), K_(buf_len));
 
 public:
@@ -162,10 +167,19 @@ private:
   int64_t create_time_us_;
   int64_t last_access_time_us_;
   int64_t last_update_time_us_;
+  int64_t frequency_;
 
   DISALLOW_COPY_AND_ASSIGN(ObSqlTableEntry);
 };
 
+inline void ObSqlTableEntry::renew_last_access_time_us()
+{
+  last_access_time_us_ = common::hrtime_to_usec(event::get_hrtime());
+  if (ObRouteCachePolicy::need_sample_access()) {
+    ObRouteCachePolicy::inc_frequency(frequency_);
+  }
+}
+
 inline bool ObSqlTableEntry::is_valid() const
 {
   return key_.is_valid() && !table_name_.empty();
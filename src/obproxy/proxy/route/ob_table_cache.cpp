@@ -25,95 +25,6 @@ namespace obproxy
 {
 namespace proxy
 {
-//---------------------------ObTableCacheCont----------------------//
-class ObTableCacheCont : public event::ObContinuation
-{
-public:
-  explicit ObTableCacheCont(ObTableCache &table_cache)
-    : ObContinuation(NULL), table_cache_(&table_cache), buf_entry_(NULL), ppentry_(NULL),
-      hash_(0), key_() {}
-  virtual ~ObTableCacheCont() {}
-
-  void destroy();
-  int get_table_entry(const int event, event::ObEvent *e);
-
-  event::ObAction action_;
-  ObTableCache *table_cache_;
-
-  // here just use ObTableEntry to store the key_'s buffer
-  ObTableEntry *buf_entry_;
-  ObTableEntry **ppentry_;
-
-  uint64_t hash_;
-  ObTableEntryKey key_;
-};
-
-inline void ObTableCacheCont::ObTableCacheCont::destroy()
-{
-  action_.set_continuation(NULL);
-  mutex_.release();
-  if (NULL != buf_entry_) {
-    buf_entry_->dec_ref();
-    buf_entry_ = NULL;
-  }
-  op_free(this);
-}
-
-int ObTableCacheCont::get_table_entry(const int event, ObEvent *e)
-{
-  UNUSED(event);
-  UNUSED(e);
-  int he_ret = EVENT_DONE;
-  int ret = OB_SUCCESS;
-  LOG_DEBUG("cont::get_table_entry started");
-
-  if (action_.cancelled_) {
-    LOG_DEBUG("cont::action has been cancelled", K(this));
-    destroy();
-  } else {
-    ObProxyMutex *bucket_mutex = table_cache_->lock_for_key(hash_);
-    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
-    if (lock_bucket.is_locked()) {
-      if (OB_FAIL(table_cache_->run_todo_list(table_cache_->part_num(hash_)))) {
-        LOG_WARN("fail to run todo list", K(ret));
-      } else {
-        *ppentry_ = table_cache_->lookup_entry(hash_, key_);
-        if (NULL != *ppentry_) {
-          if (table_cache_->is_table_entry_expired(**ppentry_)) {
-            // expire time mismatch
-            LOG_INFO("the table entry is expired", "expire_time_us",
-                     table_cache_->get_cache_expire_time_us(), KPC(*ppentry_));
-            *ppentry_ = NULL;
-            // remove the expired table entry in locked
-            if (OB_FAIL(table_cache_->remove_table_entry(key_))) {
-              LOG_WARN("fail to remove table entry", K_(key), K(ret));
-            }
-          } else {
-            (*ppentry_)->inc_ref();
-            LOG_DEBUG("cont::get_table_entry, entry found succ", KPC(*ppentry_));
-          }
-        } else {
-          // non-existent, return NULL
-          LOG_DEBUG("cont::get_table_entry, entry not found", K_(key));
-        }
-        lock_bucket.release();
-        action_.continuation_->handle_event(TABLE_ENTRY_EVENT_LOOKUP_DONE, NULL);
-        destroy();
-      }
-    } else {
-      LOG_DEBUG("cont::get_table_entry MUTEX_TRY_LOCK failed, and will schedule in interval(ns)",
-                LITERAL_K(ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL));
-      if (OB_ISNULL(self_ethread().schedule_in(this, ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL))) {
-        ret = OB_ERR_UNEXPECTED;
-        LOG_WARN("fail to schedule in", K(ret));
-      }
-      he_ret = EVENT_CONT;
-    }
-  }
-
-  return he_ret;
-}
-
 //---------------------------ObTableParam-------------------------//
 const char *ObTableParam::get_op_name(const Op op)
 {
@@ -274,62 +185,31 @@ int ObTableCache::get_table_entry(
     uint64_t hash = key.hash();
     LOG_DEBUG("begin to get table location entry", K(ppentry), K(key), K(cont), K(hash));
 
-    ObProxyMutex *bucket_mutex = lock_for_key(hash);
-    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
-    if (lock_bucket.is_locked()) {
-      if (OB_FAIL(run_todo_list(part_num(hash)))) {
-        LOG_WARN("fail to run todo list", K(ret));
-      } else {
-        *ppentry = lookup_entry(hash, key);
-        if (NULL != *ppentry) {
-          if (is_table_entry_expired(**ppentry)) {
-            // expire time mismatch
-            LOG_DEBUG("the table entry is expired", "expire_time_us",
-                      get_cache_expire_time_us(), KPC(*ppentry));
-            *ppentry = NULL;
-            // remove the expired table entry in locked
-            if (OB_FAIL(remove_table_entry(key))) {
-              LOG_WARN("fail to remove table entry", K(key), K(ret));
-            }
-          } else {
-            (*ppentry)->inc_ref();
-            LOG_DEBUG("get_table_entry, entry found succ", KPC(*ppentry));
+    if (OB_FAIL(try_run_todo_list(hash))) {
+      LOG_WARN("fail to run todo list", K(hash), K(ret));
+    } else {
+      *ppentry = acquire_entry(hash, key);
+      if (NULL != *ppentry) {
+        if (is_table_entry_expired(**ppentry)) {
+          // expire time mismatch
+          LOG_DEBUG("the table entry is expired", "expire_time_us",
+                    get_cache_expire_time_us(), KPC(*ppentry));
+          (*ppentry)->dec_ref();
+          *ppentry = NULL;
+          if (OB_FAIL(remove_table_entry(key))) {
+            LOG_WARN("fail to remove table entry", K(key), K(ret));
           }
         } else {
-          // non-existent, return NULL
-          LOG_DEBUG("get_table_entry, entry not found", K(key));
+          LOG_DEBUG("get_table_entry, entry found succ", KPC(*ppentry));
         }
-      }
-    } else {
-      LOG_DEBUG("get_table_entry, trylock failed, reschedule cont interval(ns)",
-                LITERAL_K(ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL));
-      ObTableCacheCont *table_cont = NULL;
-      if (OB_ISNULL(table_cont = op_alloc_args(ObTableCacheCont, *this))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_ERROR("fail to allocate memory for table cache continuation", K(ret));
-      } else if (OB_FAIL(ObTableEntry::alloc_and_init_table_entry(*key.name_, key.cr_version_,
-          key.cr_id_, table_cont->buf_entry_))) { // use to save name buf
-        LOG_WARN("fail to alloc and init pl entry", K(key), K(ret));
       } else {
-        table_cont->buf_entry_->get_key(table_cont->key_);
-        table_cont->action_.set_continuation(cont);
-        table_cont->mutex_ = cont->mutex_;
-        table_cont->hash_ = hash;
-        table_cont->ppentry_ = ppentry;
-
-        SET_CONTINUATION_HANDLER(table_cont, &ObTableCacheCont::get_table_entry);
-        if (OB_ISNULL(cont->mutex_->thread_holding_)
-            || OB_ISNULL(cont->mutex_->thread_holding_->schedule_in(table_cont,
-                ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL))) {
-          ret = OB_ERR_UNEXPECTED;
-          LOG_WARN("fail to schedule imm", K(table_cont), K(ret));
-        } else {
-          action = &table_cont->action_;
-        }
+        // non-existent, return NULL
+        LOG_DEBUG("get_table_entry, entry not found", K(key));
       }
-      if (OB_FAIL(ret) && OB_LIKELY(NULL != table_cont)) {
-        table_cont->destroy();
-        table_cont = NULL;
+      if (NULL != *ppentry) {
+        policy_.record_hit();
+      } else {
+        policy_.record_miss(hash);
       }
     }
     if (OB_FAIL(ret)) {
@@ -347,8 +227,11 @@ int ObTableCache::update_entry(ObTableEntry &entry, const ObTableEntryKey &key,
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K_(is_inited), K(ret));
   } else {
-    ObTableEntry *tmp_entry = insert_entry(hash, key, &entry);
-    if (NULL != tmp_entry) {
+    ObTableEntry *tmp_entry = NULL;
+    if (OB_FAIL(insert_entry(hash, key, &entry, tmp_entry))) {
+      LOG_WARN("fail to insert table entry", K(entry), K(ret));
+    } else if (NULL != tmp_entry) {
+      entry.merge_frequency(tmp_entry->get_frequency()); // the new entry inherits the frequency
       tmp_entry->set_deleted_state(); // used to update tc_table_map
       tmp_entry->dec_ref(); // paired inc_ref in alloc_and_init_pl_entry()
       tmp_entry = NULL;
@@ -369,6 +252,8 @@ int ObTableCache::add_table_entry(ObTableEntry &entry, bool direct_add)
 
     uint64_t hash = key.hash();
     LOG_DEBUG("add table location", K(part_num(hash)), K(entry), K(direct_add), K(hash), K(key));
+    // admit the key with the frequency it had before it missed or was evicted
+    entry.merge_frequency(policy_.estimate(hash));
     if (!direct_add) {
       ObProxyMutex *bucket_mutex = lock_for_key(hash);
       MUTEX_TRY_LOCK(lock, bucket_mutex, this_ethread());
@@ -509,6 +394,20 @@ int ObTableCache::remove_all_table_entry()
   return ret;
 }
 
+int ObTableCache::try_run_todo_list(const uint64_t hash)
+{
+  int ret = OB_SUCCESS;
+  // lookup never waits for the bucket lock, pending ops are applied only if it is free
+  if (!todo_lists_[part_num(hash)].empty()) {
+    ObProxyMutex *bucket_mutex = lock_for_key(hash);
+    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
+    if (lock_bucket.is_locked() && OB_FAIL(run_todo_list(part_num(hash)))) {
+      LOG_WARN("fail to run todo list", K(hash), K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObTableCache::run_todo_list(const int64_t buck_id)
 {
   int ret = OB_SUCCESS;
@@ -560,6 +459,8 @@ int ObTableCache::process(const int64_t buck_id, ObTableParam *param)
       case ObTableParam::ADD_TABLE_OP: {
         if (OB_FAIL(update_entry(*param->entry_, param->key_, param->hash_))) {
           LOG_WARN("fail to update_entry", K(param), K(ret));
+          // the cache does not hold the entry handed to it
+          param->entry_->dec_ref();
         }
         if (NULL != param->entry_) {
           // dec_ref, it was inc before add param into todo list
@@ -43,7 +43,6 @@ public:
   int64_t to_string(char *buf, const int64_t buf_len) const;
   static const char *get_op_name(const Op op);
 
-  static const int64_t SCHEDULE_TABLE_CACHE_CONT_INTERVAL =  HRTIME_MSECONDS(1);
   uint64_t hash_;
   int64_t part_id_;
   ObTableEntryKey key_;
@@ -57,7 +56,7 @@ class ObTableCache : public TableEntryHashMap
 public:
   static const int64_t TABLE_CACHE_MAP_SIZE = 1024;
 
-  ObTableCache() : is_inited_(false), expire_time_us_(0) {}
+  ObTableCache() : is_inited_(false), expire_time_us_(0), policy_() {}
   virtual ~ObTableCache() { destroy(); }
 
   int init(const int64_t bucket_size);
@@ -74,15 +73,18 @@ public:
   int remove_table_entry(const ObTableEntryKey &key);
   int remove_all_table_entry();
   int run_todo_list(const int64_t buck_id);
+  // apply the pending ops of the bucket of hash only if its lock is free
+  int try_run_todo_list(const uint64_t hash);
 
   int update_entry(ObTableEntry &new_entry, const ObTableEntryKey &key, const uint64_t hash);
 
   void set_cache_expire_time(const int64_t relative_time_s);
   int64_t get_cache_expire_time_us() const { return expire_time_us_; }
+  ObRouteCachePolicy &get_policy() { return policy_; }
   bool is_table_entry_expired(const ObTableEntry &entry);
   bool is_table_entry_expired_in_qa_mode(const ObTableEntry &entry);
   bool is_table_entry_expired_in_time_mode(const ObTableEntry &entry);
-  TO_STRING_KV(K_(is_inited), K_(expire_time_us));
+  TO_STRING_KV(K_(is_inited), K_(expire_time_us), K_(policy));
 
   static bool gc_table_entry(ObTableEntry *entry);
 
@@ -92,6 +94,7 @@ private:
 private:
   bool is_inited_;
   int64_t expire_time_us_;
+  ObRouteCachePolicy policy_;
   common::ObAtomicList todo_lists_[obutils::MT_HASHTABLE_PARTITIONS];
   DISALLOW_COPY_AND_ASSIGN(ObTableCache);
 };
@@ -0,0 +1,331 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include "proxy/route/ob_table_entry_batch_cont.h"
+#include "stat/ob_processor_stats.h"
+#include "proxy/route/ob_route_utils.h"
+#include "proxy/route/ob_table_entry.h"
+#include "proxy/route/ob_table_processor.h"
+#include "proxy/client/ob_mysql_proxy.h"
+#include "proxy/client/ob_client_vc.h"
+#include "proxy/mysqllib/ob_resultset_fetcher.h"
+#include "obutils/ob_proxy_config.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obproxy::event;
+using namespace oceanbase::obproxy::obutils;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+
+ObTableEntryBatchCont::ObTableEntryBatchCont()
+    : ObContinuation(NULL), mysql_proxy_(NULL), cr_version_(0), cr_id_(OB_INVALID_CLUSTER_ID),
+      cluster_version_(0), is_need_force_flush_(false), tenant_name_(), current_idc_name_(),
+      max_cont_count_(0), cont_count_(0), entries_(), fetch_start_us_(0), pending_action_(NULL)
+{
+  SET_HANDLER(&ObTableEntryBatchCont::main_handler);
+}
+
+bool ObTableEntryBatchCont::is_batch_fetch_enabled(const ObTableRouteParam &param)
+{
+  return get_global_proxy_config().table_entry_batch_fetch_window > 0
+         && !param.name_.is_all_dummy_table()
+         && !param.name_.is_sys_dummy()
+         && !param.name_.is_binlog_table();
+}
+
+int ObTableEntryBatchCont::alloc_batch_cont(ObTableEntryCont &te_cont, ObTableEntryBatchCont *&batch_cont)
+{
+  int ret = OB_SUCCESS;
+  batch_cont = NULL;
+  if (OB_ISNULL(batch_cont = op_alloc(ObTableEntryBatchCont))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory for ObTableEntryBatchCont", K(ret));
+  } else if (OB_FAIL(batch_cont->init(te_cont.table_param_))) {
+    LOG_WARN("fail to init table entry batch cont", K(ret));
+    batch_cont->destroy();
+    batch_cont = NULL;
+  }
+  return ret;
+}
+
+int ObTableEntryBatchCont::init(const ObTableRouteParam &param)
+{
+  int ret = OB_SUCCESS;
+  ObProxyMutex *mutex = NULL;
+  if (OB_UNLIKELY(!param.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid input value", K(param), K(ret));
+  } else if (OB_UNLIKELY(param.name_.tenant_name_.length() > OB_MAX_TENANT_NAME_LENGTH)
+             || OB_UNLIKELY(param.current_idc_name_.length() > OB_PROXY_MAX_IDC_NAME_LENGTH)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("tenant name or idc name is too long", K(param), K(ret));
+  } else if (OB_ISNULL(mutex = new_proxy_mutex())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory for mutex", K(ret));
+  } else {
+    mutex_ = mutex;
+    mysql_proxy_ = param.mysql_proxy_;
+    cr_version_ = param.cr_version_;
+    cr_id_ = param.cr_id_;
+    cluster_version_ = param.cluster_version_;
+    is_need_force_flush_ = param.is_need_force_flush_;
+    MEMCPY(tenant_name_buf_, param.name_.tenant_name_.ptr(), param.name_.tenant_name_.length());
+    tenant_name_.assign_ptr(tenant_name_buf_, param.name_.tenant_name_.length());
+    if (!param.current_idc_name_.empty()) {
+      MEMCPY(current_idc_name_buf_, param.current_idc_name_.ptr(), param.current_idc_name_.length());
+      current_idc_name_.assign_ptr(current_idc_name_buf_, param.current_idc_name_.length());
+    }
+    max_cont_count_ = get_global_proxy_config().table_entry_batch_fetch_max_count;
+    if (max_cont_count_ > MAX_BATCH_CONT_COUNT) {
+      max_cont_count_ = MAX_BATCH_CONT_COUNT;
+    }
+  }
+  return ret;
+}
+
+void ObTableEntryBatchCont::destroy()
+{
+  LOG_DEBUG("ObTableEntryBatchCont will be free", KPC(this));
+  if (NULL != pending_action_) {
+    pending_action_->cancel();
+    pending_action_ = NULL;
+  }
+  for (int64_t i = 0; i < entries_.count(); ++i) {
+    entries_.at(i)->dec_ref();
+  }
+  entries_.reset();
+  cont_count_ = 0;
+  mysql_proxy_ = NULL;
+  mutex_.release();
+  op_free(this);
+}
+
+bool ObTableEntryBatchCont::is_same_batch(const ObTableRouteParam &param) const
+{
+  return mysql_proxy_ == param.mysql_proxy_
+         && cr_version_ == param.cr_version_
+         && cr_id_ == param.cr_id_
+         && cluster_version_ == param.cluster_version_
+         && is_need_force_flush_ == param.is_need_force_flush_
+         && tenant_name_ == param.name_.tenant_name_
+         && current_idc_name_ == param.current_idc_name_;
+}
+
+bool ObTableEntryBatchCont::is_full() const
+{
+  return cont_count_ >= max_cont_count_;
+}
+
+int ObTableEntryBatchCont::add_cont(ObTableEntryCont &te_cont)
+{
+  int ret = OB_SUCCESS;
+  ObTableEntry *entry = NULL;
+  if (OB_UNLIKELY(is_full()) || OB_UNLIKELY(!is_same_batch(te_cont.table_param_))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("table entry cont can not join this batch", K_(te_cont.table_param), KPC(this), K(ret));
+  } else if (OB_FAIL(ObTableEntry::alloc_and_init_table_entry(te_cont.table_param_.name_,
+                                                              cr_version_, cr_id_, entry))) {
+    LOG_WARN("fail to alloc and init table entry", "name", te_cont.table_param_.name_, K(ret));
+  } else if (OB_FAIL(entries_.push_back(entry))) {
+    LOG_WARN("fail to push back table entry", K(ret));
+    entry->dec_ref();
+    entry = NULL;
+  } else {
+    conts_[cont_count_++] = &te_cont;
+  }
+  return ret;
+}
+
+int ObTableEntryBatchCont::schedule_fetch(const bool is_immediate)
+{
+  int ret = OB_SUCCESS;
+  const int64_t window_us = get_global_proxy_config().table_entry_batch_fetch_window;
+  if (OB_UNLIKELY(NULL != pending_action_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("pending_action_ must be NULL here", K_(pending_action), K(ret));
+  } else if (is_immediate) {
+    if (OB_ISNULL(pending_action_ = self_ethread().schedule_imm(this, TABLE_ENTRY_BATCH_FETCH_EVENT))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("fail to schedule imm", K(ret));
+    }
+  } else if (OB_ISNULL(pending_action_ = self_ethread().schedule_in(this, HRTIME_USECONDS(window_us),
+                                                                   TABLE_ENTRY_BATCH_FETCH_EVENT))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("fail to schedule in", K(window_us), K(ret));
+  }
+  return ret;
+}
+
+void ObTableEntryBatchCont::flush_fetch()
+{
+  // the window event can only be cancelled with the lock held, if the lock is held
+  // by the window event called back, this batch is being fetched already
+  MUTEX_TRY_LOCK(lock, mutex_, this_ethread());
+  if (lock.is_locked() && NULL != pending_action_) {
+    ObAction *window_action = pending_action_;
+    if (OB_ISNULL(pending_action_ = self_ethread().schedule_imm(this, TABLE_ENTRY_BATCH_FETCH_EVENT))) {
+      // still fetch at the end of the window
+      LOG_WARN("fail to schedule imm, batch will be fetched at the end of window", KPC(this));
+      pending_action_ = window_action;
+    } else {
+      window_action->cancel();
+    }
+  }
+}
+
+int ObTableEntryBatchCont::main_handler(int event, void *data)
+{
+  int he_ret = EVENT_CONT;
+  int ret = OB_SUCCESS;
+  bool need_destroy = false;
+  LOG_DEBUG("ObTableEntryBatchCont::main_handler, received event", K(event), K(data));
+  pending_action_ = NULL;
+  switch (event) {
+    case TABLE_ENTRY_BATCH_FETCH_EVENT: {
+      // no more conts join this batch from now on
+      get_global_table_processor().close_batch(*this);
+      if (OB_FAIL(fetch_table_entry())) {
+        LOG_WARN("fail to fetch table entries, every table entry will be fetched alone",
+                 KPC(this), K(ret));
+        notify_conts(false);
+        need_destroy = true;
+      }
+      break;
+    }
+    case CLIENT_TRANSPORT_MYSQL_RESP_EVENT: {
+      notify_conts(OB_SUCCESS == handle_client_resp(data));
+      need_destroy = true;
+      break;
+    }
+    default: {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unknow event", K(event), K(data), K(ret));
+      break;
+    }
+  }
+
+  if (need_destroy) {
+    get_global_table_processor().finish_batch();
+    destroy();
+    he_ret = EVENT_DONE;
+  }
+  return he_ret;
+}
+
+int ObTableEntryBatchCont::fetch_table_entry()
+{
+  int ret = OB_SUCCESS;
+  char *sql = NULL;
+  int64_t sql_len = OB_SHORT_SQL_LENGTH;
+  for (int64_t i = 0; i < entries_.count(); ++i) {
+    const ObTableEntryName &name = entries_.at(i)->get_names();
+    sql_len += name.database_name_.length() + name.table_name_.length() + 8; // ('', ''),
+  }
+
+  if (OB_ISNULL(mysql_proxy_) || OB_UNLIKELY(entries_.empty())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid batch", KPC(this), K(ret));
+  } else if (OB_ISNULL(sql = static_cast<char *>(op_fixed_mem_alloc(sql_len)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc mem", K(sql_len), K(ret));
+  } else if (OB_FAIL(ObRouteUtils::get_batch_table_entry_sql(sql, sql_len, entries_,
+                                                             is_need_force_flush_, cluster_version_))) {
+    LOG_WARN("fail to get batch table entry sql", K(sql_len), K(ret));
+  } else {
+    const ObMysqlRequestParam request_param(sql, current_idc_name_);
+    fetch_start_us_ = ObTimeUtility::current_time();
+    if (OB_FAIL(mysql_proxy_->async_read(this, request_param, pending_action_))) {
+      LOG_WARN("fail to nonblock read", K(sql), KPC(this), K(ret));
+    } else {
+      PROCESSOR_INCREMENT_DYN_STAT(BATCH_FETCH_TABLE_ENTRY_COUNT);
+      PROCESSOR_SUM_DYN_STAT(BATCH_FETCH_TABLE_ENTRY_SIZE, cont_count_);
+      LOG_DEBUG("succ to fetch table entries in batch", K(sql), KPC(this));
+    }
+  }
+
+  if (NULL != sql) {
+    op_fixed_mem_free(sql, sql_len);
+    sql = NULL;
+  }
+  return ret;
+}
+
+int ObTableEntryBatchCont::handle_client_resp(void *data)
+{
+  int ret = OB_SUCCESS;
+  PROCESSOR_SUM_DYN_STAT(BATCH_FETCH_TABLE_ENTRY_TIME, ObTimeUtility::current_time() - fetch_start_us_);
+  if (NULL != data) {
+    ObClientMysqlResp *resp = reinterpret_cast<ObClientMysqlResp *>(data);
+    ObResultSetFetcher *rs_fetcher = NULL;
+    if (resp->is_resultset_resp()) {
+      if (OB_FAIL(resp->get_resultset_fetcher(rs_fetcher))) {
+        LOG_WARN("fail to get resultset fetcher", K(ret));
+      } else if (OB_ISNULL(rs_fetcher)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("rs_fetcher is NULL", K(ret));
+      } else if (OB_FAIL(ObRouteUtils::fetch_batch_table_entry(*rs_fetcher, entries_, cluster_version_))) {
+        LOG_WARN("fail to fetch batch table entry", K(ret));
+      }
+    } else {
+      const int64_t error_code = resp->get_err_code();
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("fail to get table entries from remote", KPC(this), K(error_code), K(ret));
+    }
+    op_free(resp); // free the resp come from ObMysqlProxy
+    resp = NULL;
+  } else {
+    // no resp, maybe client_vc disconnect
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("fail to get table entries from remote", KPC(this), K(ret));
+  }
+
+  if (OB_FAIL(ret)) {
+    PROCESSOR_INCREMENT_DYN_STAT(BATCH_FETCH_TABLE_ENTRY_FAIL);
+  }
+  return ret;
+}
+
+void ObTableEntryBatchCont::notify_conts(const bool is_succ)
+{
+  int event = is_succ ? TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT : TABLE_ENTRY_LOOKUP_REMOTE_EVENT;
+  ObTableEntryCont *te_cont = NULL;
+  for (int64_t i = 0; i < cont_count_; ++i) {
+    te_cont = conts_[i];
+    if (is_succ) {
+      // the cont takes over the ref of the batch
+      te_cont->newest_table_entry_ = entries_.at(i);
+      entries_.at(i) = NULL;
+    } else {
+      te_cont->is_batch_fetch_failed_ = true;
+    }
+    if (OB_ISNULL(te_cont->submit_thread_->schedule_imm(te_cont, event))) {
+      // the cont waits for this event only, call it back here instead
+      LOG_WARN("fail to schedule imm, call back table entry cont directly", K(te_cont), K(event));
+      MUTEX_LOCK(lock, te_cont->mutex_, this_ethread());
+      te_cont->handle_event(event, NULL);
+    }
+  }
+  if (is_succ) {
+    entries_.reset();
+  }
+  cont_count_ = 0;
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
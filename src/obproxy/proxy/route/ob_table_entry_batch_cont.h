@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_TABLE_ENTRY_BATCH_CONT_H
+#define OBPROXY_TABLE_ENTRY_BATCH_CONT_H
+
+#include "lib/container/ob_se_array.h"
+#include "iocore/eventsystem/ob_continuation.h"
+#include "proxy/route/ob_table_entry_cont.h"
+
+#define TABLE_ENTRY_BATCH_FETCH_EVENT (ROUTE_EVENT_EVENTS_START + 7)
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+class ObMysqlProxy;
+
+// Fetch the table entries of one tenant which miss the table cache within
+// table_entry_batch_fetch_window with one query of __all_virtual_proxy_schema.
+//
+// The first ObTableEntryCont which goes to fetch remote opens a batch, the following ones
+// with the same tenant, cluster resource, idc and force flush hint join it, until it is full
+// or its window ends. A full batch and a batch opened when no other one is alive do not wait
+// for the window. The rows of the query are split into the entries of the batch by table
+// name, and every cont is called back with its entry by TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT.
+// If the query fails, every cont is called back by TABLE_ENTRY_LOOKUP_REMOTE_EVENT and
+// fetches its entry alone. The part info of partition tables is still fetched by every cont.
+class ObTableEntryBatchCont : public event::ObContinuation
+{
+public:
+  static const int64_t MAX_BATCH_CONT_COUNT = 64;
+
+  ObTableEntryBatchCont();
+  virtual ~ObTableEntryBatchCont() {}
+  void destroy();
+
+  static bool is_batch_fetch_enabled(const ObTableRouteParam &param);
+  static int alloc_batch_cont(ObTableEntryCont &te_cont, ObTableEntryBatchCont *&batch_cont);
+
+  bool is_same_batch(const ObTableRouteParam &param) const;
+  bool is_full() const;
+  int add_cont(ObTableEntryCont &te_cont);
+  // fetch at once if is_immediate, or at the end of the window
+  int schedule_fetch(const bool is_immediate);
+  // fetch at once instead of at the end of the window
+  void flush_fetch();
+
+  TO_STRING_KV(KP_(mysql_proxy), K_(cr_version), K_(cr_id), K_(cluster_version),
+               K_(tenant_name), K_(current_idc_name), K_(is_need_force_flush),
+               K_(cont_count));
+
+private:
+  int init(const ObTableRouteParam &param);
+  int main_handler(int event, void *data);
+  int fetch_table_entry();
+  int handle_client_resp(void *data);
+  void notify_conts(const bool is_succ);
+
+private:
+  ObMysqlProxy *mysql_proxy_;
+  int64_t cr_version_;
+  int64_t cr_id_;
+  int64_t cluster_version_;
+  bool is_need_force_flush_;
+  common::ObString tenant_name_;
+  char tenant_name_buf_[common::OB_MAX_TENANT_NAME_LENGTH];
+  common::ObString current_idc_name_;
+  char current_idc_name_buf_[OB_PROXY_MAX_IDC_NAME_LENGTH];
+
+  int64_t max_cont_count_;
+  int64_t cont_count_;
+  ObTableEntryCont *conts_[MAX_BATCH_CONT_COUNT];
+  common::ObSEArray<ObTableEntry *, 16> entries_; // the entry of every cont
+  int64_t fetch_start_us_;
+  event::ObAction *pending_action_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObTableEntryBatchCont);
+};
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+#endif // OBPROXY_TABLE_ENTRY_BATCH_CONT_H
@@ -21,6 +21,7 @@
 #include "proxy/route/ob_table_entry.h"
 #include "proxy/route/ob_table_cache.h"
 #include "proxy/route/ob_table_processor.h"
+#include "proxy/route/ob_table_entry_batch_cont.h"
 #include "obutils/ob_task_flow_controller.h"
 #include "obutils/ob_async_common_task.h"
 #include "obutils/ob_config_server_processor.h"
@@ -112,7 +113,8 @@ ObTableEntryCont::ObTableEntryCont()
     : ObAsyncCommonTask(NULL, "table_entry_build_task"), magic_(OB_TABLE_ENTRY_CONT_MAGIC_ALIVE),
       table_param_(),
       name_buf_(NULL), name_buf_len_(0), te_op_(LOOKUP_MIN_OP), state_(LOOKUP_TABLE_ENTRY_STATE),
-      newest_table_entry_(NULL), table_entry_(NULL), table_cache_(NULL), need_notify_(true)
+      newest_table_entry_(NULL), table_entry_(NULL), table_cache_(NULL), need_notify_(true),
+      is_batch_fetch_failed_(false)
 {
   SET_HANDLER(&ObTableEntryCont::main_handler);
 }
@@ -213,6 +215,10 @@ const char *ObTableEntryCont::get_event_name(const int64_t event)
       name = "TABLE_ENTRY_NOTIFY_CALLER_EVENT";
       break;
     }
+    case TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT: {
+      name = "TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT";
+      break;
+    }
     default: {
       name = "unknown event name";
       break;
@@ -285,9 +291,15 @@ inline int ObTableEntryCont::main_handler(int event, void *data)
         // fail through, do not break
       }
       __attribute__ ((fallthrough));
-      case CLIENT_TRANSPORT_MYSQL_RESP_EVENT: {
-        if (OB_FAIL(handle_client_resp(data))) {
-          LOG_WARN("fail to handle client resp", K(ret));
+      case CLIENT_TRANSPORT_MYSQL_RESP_EVENT:
+      case TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT: {
+        if (TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT == event) {
+          ret = handle_batch_lookup_resp();
+        } else {
+          ret = handle_client_resp(data);
+        }
+        if (OB_FAIL(ret)) {
+          LOG_WARN("fail to handle client resp", "event", get_event_name(event), K(ret));
         } else if (OB_FAIL(handle_lookup_remote())) {
           LOG_WARN("fail to handle lookup remote done", K(ret));
         }
@@ -522,6 +534,25 @@ inline int ObTableEntryCont::handle_client_resp(void *data)
   return ret;
 }
 
+// newest_table_entry_ has been fetched by ObTableEntryBatchCont
+inline int ObTableEntryCont::handle_batch_lookup_resp()
+{
+  int ret = OB_SUCCESS;
+  if (NULL != newest_table_entry_) {
+    newest_table_entry_->set_tenant_version(table_param_.tenant_version_);
+    LOG_DEBUG("succ to get batch lookup resp", "state", get_state_name(state_));
+  } else {
+    PROCESSOR_INCREMENT_DYN_STAT(GET_PL_FROM_REMOTE_FAIL);
+    ROUTE_PROMETHEUS_STAT(table_param_.name_, PROMETHEUS_ENTRY_LOOKUP_COUNT, TBALE_ENTRY, false, false);
+    LOG_WARN("fail to get table entry from batch", "name", table_param_.name_);
+  }
+
+  if (OB_FAIL(set_next_state())) {
+    LOG_WARN("fail to set next state", "state", get_state_name(state_));
+  }
+  return ret;
+}
+
 inline int ObTableEntryCont::handle_table_entry_resp(ObResultSetFetcher &rs_fetcher)
 {
   int ret = OB_SUCCESS;
@@ -924,8 +955,19 @@ inline int ObTableEntryCont::lookup_entry_remote()
       }
     }
   } else {
-    if (OB_FAIL(ObRouteUtils::get_table_entry_sql(sql, OB_SHORT_SQL_LENGTH, table_param_.name_,
-                                                  table_param_.is_need_force_flush_, table_param_.cluster_version_))) {
+    bool is_batched = false;
+    if (!is_batch_fetch_failed_
+        && OB_FAIL(get_global_table_processor().add_to_batch(*this, is_batched))) {
+      LOG_WARN("fail to add to batch, will fetch table entry alone", K_(table_param), K(ret));
+      ret = OB_SUCCESS;
+    }
+
+    if (is_batched) {
+      // ObTableEntryBatchCont will call back with TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT
+      LOG_DEBUG("table entry will be fetched in batch", K_(table_param_.name));
+    } else if (OB_FAIL(ObRouteUtils::get_table_entry_sql(sql, OB_SHORT_SQL_LENGTH, table_param_.name_,
+                                                         table_param_.is_need_force_flush_,
+                                                         table_param_.cluster_version_))) {
       LOG_WARN("fail to get table entry sql", K(sql), K(ret));
     } else {
       const ObMysqlRequestParam request_param(sql, table_param_.current_idc_name_);
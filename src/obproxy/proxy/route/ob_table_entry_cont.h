@@ -23,6 +23,7 @@
 #define TABLE_ENTRY_CHAIN_NOTIFY_CALLER_EVENT (ROUTE_EVENT_EVENTS_START + 3)
 #define TABLE_ENTRY_NOTIFY_CALLER_EVENT (ROUTE_EVENT_EVENTS_START + 4)
 #define TABLE_ENTRY_FAIL_SCHEDULE_LOOKUP_REMOTE_EVENT (ROUTE_EVENT_EVENTS_START + 5)
+#define TABLE_ENTRY_BATCH_LOOKUP_DONE_EVENT (ROUTE_EVENT_EVENTS_START + 6)
 
 namespace oceanbase
 {
@@ -107,6 +108,7 @@ private:
 
 class ObTableEntryCont : public obutils::ObAsyncCommonTask
 {
+  friend class ObTableEntryBatchCont;
 public:
   ObTableEntryCont();
   virtual ~ObTableEntryCont() {}
@@ -116,6 +118,7 @@ public:
   int init(ObTableCache &table_cache, ObTableRouteParam &table_param, ObTableEntry *table_entry);
   void set_table_entry_op(const ObTableEntryLookupOp op) { te_op_ = op; }
   void set_need_notify(const bool need_notify) { need_notify_ = need_notify; }
+  const ObTableRouteParam &get_table_param() const { return table_param_; }
 
 private:
   int main_handler(int event, void *data);
@@ -137,6 +140,7 @@ private:
   int set_next_state();
 
   int handle_client_resp(void *data);
+  int handle_batch_lookup_resp();
   int handle_table_entry_resp(ObResultSetFetcher &rs_fetcher);
   int handle_part_info_resp(ObResultSetFetcher &rs_fetcher);
   int handle_first_part_resp(ObResultSetFetcher &rs_fetcher);
@@ -166,6 +170,7 @@ private:
   ObTableEntry *table_entry_; // the entry get from global cache
   ObTableCache *table_cache_;
   bool need_notify_;
+  bool is_batch_fetch_failed_; // fetch alone if the batch fails
 
   DISALLOW_COPY_AND_ASSIGN(ObTableEntryCont);
 };
@@ -66,6 +66,82 @@ DEF_TO_STRING(ObTableProcessor)
   return pos;
 }
 
+int ObTableProcessor::add_to_batch(ObTableEntryCont &te_cont, bool &is_batched)
+{
+  int ret = OB_SUCCESS;
+  is_batched = false;
+  const ObTableRouteParam &table_param = te_cont.get_table_param();
+  if (ObTableEntryBatchCont::is_batch_fetch_enabled(table_param)) {
+    ObSpinLockGuard guard(batch_lock_);
+    ObTableEntryBatchCont *batch_cont = NULL;
+    bool is_fetch_at_once = false;
+    int64_t idx = 0;
+    for (; NULL == batch_cont && idx < open_batch_conts_.count(); ++idx) {
+      if (open_batch_conts_.at(idx)->is_same_batch(table_param)) {
+        batch_cont = open_batch_conts_.at(idx);
+      }
+    }
+
+    if (NULL != batch_cont) {
+      if (OB_FAIL(batch_cont->add_cont(te_cont))) {
+        LOG_WARN("fail to add cont to batch", KPC(batch_cont), K(ret));
+      } else {
+        is_batched = true;
+        if (batch_cont->is_full()) {
+          // idx is one past the batch found
+          if (OB_FAIL(open_batch_conts_.remove(idx - 1))) {
+            LOG_WARN("fail to remove full batch", KPC(batch_cont), K(ret));
+            ret = OB_SUCCESS;
+          }
+          batch_cont->flush_fetch();
+        }
+      }
+    } else if (OB_FAIL(ObTableEntryBatchCont::alloc_batch_cont(te_cont, batch_cont))) {
+      LOG_WARN("fail to alloc batch cont", K(ret));
+    } else if (OB_FAIL(batch_cont->add_cont(te_cont))) {
+      LOG_WARN("fail to add cont to batch", KPC(batch_cont), K(ret));
+      batch_cont->destroy();
+    } else if (FALSE_IT(is_fetch_at_once = (0 == live_batch_count_ || batch_cont->is_full()))) {
+      // impossible
+    } else if (OB_FAIL(batch_cont->schedule_fetch(is_fetch_at_once))) {
+      LOG_WARN("fail to schedule batch fetch", KPC(batch_cont), K(ret));
+      batch_cont->destroy();
+    } else {
+      is_batched = true;
+      ++live_batch_count_;
+      // the batch fetching at once is not open to others
+      if (is_fetch_at_once) {
+        // do nothing
+      } else if (OB_FAIL(open_batch_conts_.push_back(batch_cont))) {
+        // the batch still fetches after its window, only no more conts join it
+        LOG_WARN("fail to push back batch cont", KPC(batch_cont), K(ret));
+        ret = OB_SUCCESS;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObTableProcessor::finish_batch()
+{
+  ObSpinLockGuard guard(batch_lock_);
+  --live_batch_count_;
+}
+
+void ObTableProcessor::close_batch(ObTableEntryBatchCont &batch_cont)
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(batch_lock_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < open_batch_conts_.count(); ++i) {
+    if (&batch_cont == open_batch_conts_.at(i)) {
+      if (OB_FAIL(open_batch_conts_.remove(i))) {
+        LOG_WARN("fail to remove batch cont", K(batch_cont), K(ret));
+      }
+      break;
+    }
+  }
+}
+
 int ObTableProcessor::add_table_entry_with_rslist(ObTableRouteParam &table_param,
                                                   ObTableEntry *&entry,
                                                   const bool is_old_entry_from_rslist)
@@ -365,6 +441,8 @@ int ObTableProcessor::get_table_entry_from_thread_cache(
         if (!find_succ) {
           tmp_entry->dec_ref();
           tmp_entry = NULL;
+        } else {
+          table_cache.get_policy().record_hit();
         }
       }
       entry = tmp_entry;
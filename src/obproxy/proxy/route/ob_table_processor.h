@@ -13,7 +13,10 @@
 #ifndef OBPROXY_TABLE_PROCESSOR_H
 #define OBPROXY_TABLE_PROCESSOR_H
 
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/container/ob_se_array.h"
 #include "proxy/route/ob_table_entry_cont.h"
+#include "proxy/route/ob_table_entry_batch_cont.h"
 
 #define TABLE_ENTRY_LOOKUP_CACHE_EVENT (ROUTE_EVENT_EVENTS_START + 1)
 #define TABLE_ENTRY_LOOKUP_REMOTE_EVENT (ROUTE_EVENT_EVENTS_START + 2)
@@ -34,7 +37,8 @@ class ObTableCache;
 class ObTableProcessor
 {
 public:
-  ObTableProcessor() : is_inited_(false), table_cache_(NULL) {}
+  ObTableProcessor() : is_inited_(false), table_cache_(NULL), batch_lock_(), open_batch_conts_(),
+                       live_batch_count_(0) {}
   ~ObTableProcessor() {}
 
   int init(ObTableCache *table_cache);
@@ -44,6 +48,16 @@ public:
                                                ObTableCache &table_cache,
                                                ObTableEntryCont *te_cont, event::ObAction *&action,
                                                ObTableEntry *&entry, ObTableEntryLookupOp &op);
+
+  // join te_cont into the open batch of its tenant, or open a new one, see ObTableEntryBatchCont;
+  // is_batched is false if te_cont should fetch its table entry alone.
+  // A new batch fetches at once if no other batch is alive, as nothing else is missing the cache,
+  // and a full batch fetches at once, only the others wait for the window
+  int add_to_batch(ObTableEntryCont &te_cont, bool &is_batched);
+  // no more conts join the batch
+  void close_batch(ObTableEntryBatchCont &batch_cont);
+  // the batch is done and will be destroyed
+  void finish_batch();
   DECLARE_TO_STRING;
 
 private:
@@ -68,6 +82,9 @@ private:
 private:
   bool is_inited_;
   ObTableCache *table_cache_;
+  common::ObSpinLock batch_lock_;
+  common::ObSEArray<ObTableEntryBatchCont *, 8> open_batch_conts_;
+  int64_t live_batch_count_; // the batches scheduled and not finished, protected by batch_lock_
 
   DISALLOW_COPY_AND_ASSIGN(ObTableProcessor);
 };
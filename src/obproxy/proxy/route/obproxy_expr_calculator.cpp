@@ -201,8 +201,13 @@ int ObProxyExprCalculator::do_expr_parse(const common::ObString &req_sql,
     expr_result.part_key_info_.part_keys_[i] = key_info.part_keys_[i];
   }
 
-  if (OB_FAIL(expr_parser.parse_reqsql(req_sql,  parse_result.get_parsed_length(), expr_result,
-                                       parse_result.get_stmt_type(), connection_collation))) {
+  if ((parse_result.is_select_stmt() || parse_result.is_delete_stmt())
+      && parse_result.get_where_cond_info().cond_count_ > 0
+      && OB_SUCCESS == expr_parser.parse_where_cond(req_sql, parse_result.get_where_cond_info(), expr_result)) {
+    // the where clause has been lexed by the first parse
+    LOG_DEBUG("succ to do expr parse with where cond of the parse result", K(req_sql));
+  } else if (OB_FAIL(expr_parser.parse_reqsql(req_sql,  parse_result.get_parsed_length(), expr_result,
+                                              parse_result.get_stmt_type(), connection_collation))) {
     LOG_DEBUG("fail to do expr parse_reqsql", K(req_sql), K(ret));
   }
   return ret;
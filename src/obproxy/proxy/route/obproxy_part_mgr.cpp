@@ -1163,6 +1163,8 @@ int ObProxyPartMgr::build_list_part(const ObPartitionLevel part_level,
   if (OB_SUCC(ret)) {
     if (OB_FAIL(desc_list->set_part_array(part_array, part_num))) {
       LOG_WARN("fail to set_part_array, unexpected ", K(ret));
+    } else if (OB_FAIL(desc_list->build_index(allocator_))) {
+      LOG_WARN("fail to build list part index", K(ret));
     }
   }
 
@@ -1323,6 +1325,8 @@ int ObProxyPartMgr::build_sub_list_part_with_non_template(const ObPartitionFuncT
       }
       if (OB_FAIL(desc_list->set_part_array(part_array, sub_part_num_[i]))) {
         LOG_WARN("fail to set_part_array, unexpected ", K(ret));
+      } else if (OB_FAIL(desc_list->build_index(allocator_))) {
+        LOG_WARN("fail to build list part index", K(ret));
       }
     }
   } // end of for
@@ -0,0 +1,465 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include "proxy/shard/obproxy_shard_multi_stmt_cont.h"
+#include "common/ob_row.h"
+#include "common/obsm_utils.h"
+#include "rpc/obmysql/ob_mysql_field.h"
+#include "iocore/eventsystem/ob_io_buffer.h"
+#include "executor/ob_proxy_parallel_execute_cont.h"
+#include "packet/ob_mysql_packet_util.h"
+#include "packet/ob_proxy_packet_writer.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+using namespace oceanbase::obproxy::event;
+using namespace oceanbase::obproxy::obutils;
+using namespace oceanbase::obproxy::executor;
+using namespace oceanbase::obproxy::packet;
+using namespace oceanbase::obproxy::dbconfig;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+
+static void change_to_sql_field(const ObMysqlField &src_field, ObMySQLField &dst_field)
+{
+  dst_field.dname_ = src_field.db_;
+  dst_field.tname_ = src_field.table_;
+  dst_field.org_tname_ = src_field.org_table_;
+  dst_field.cname_ = src_field.name_;
+  dst_field.org_cname_ = src_field.org_name_;
+  if (OB_MYSQL_TYPE_FLOAT == src_field.type_ || OB_MYSQL_TYPE_DOUBLE == src_field.type_) {
+    if (0x1f == src_field.decimals_) {
+      ObObjType ob_type;
+      if (OB_SUCCESS != ObSMUtils::get_ob_type(ob_type, src_field.type_)) {
+        ob_type = ObDoubleType;
+      }
+      dst_field.accuracy_ = ObAccuracy::DML_DEFAULT_ACCURACY[ob_type];
+    } else {
+      dst_field.accuracy_.set_scale(static_cast<ObScale>(src_field.decimals_));
+    }
+  } else if (OB_MYSQL_TYPE_NEWDECIMAL == src_field.type_
+             || OB_MYSQL_TYPE_DECIMAL == src_field.type_
+             || OB_MYSQL_TYPE_TIMESTAMP == src_field.type_
+             || OB_MYSQL_TYPE_DATETIME == src_field.type_
+             || OB_MYSQL_TYPE_TIME == src_field.type_) {
+    if (src_field.decimals_ > number::ObNumber::MAX_SCALE) {
+      ObObjType ob_type;
+      if (OB_SUCCESS != ObSMUtils::get_ob_type(ob_type, src_field.type_)) {
+        ob_type = ObNumberType;
+      }
+      dst_field.accuracy_ = ObAccuracy::DML_DEFAULT_ACCURACY[ob_type];
+    } else {
+      dst_field.accuracy_.set_scale(static_cast<ObScale>(src_field.decimals_));
+    }
+  } else {
+    dst_field.accuracy_.set_accuracy(static_cast<int64_t>(src_field.decimals_));
+  }
+  dst_field.type_ = src_field.type_;
+  dst_field.flags_ = static_cast<uint16_t>(src_field.flags_);
+  dst_field.set_charset_number(static_cast<uint16_t>(src_field.charsetnr_));
+  dst_field.length_ = static_cast<uint32_t>(src_field.length_);
+}
+
+ObShardMultiStmtCont::ObShardMultiStmtCont(ObContinuation *cb_cont, ObEThread *cb_thread)
+  : ObAsyncCommonTask(cb_cont->mutex_, "shard multi stmt cont", cb_cont, cb_thread),
+    seq_(0), capability_(), status_flag_(0), timeout_ms_(0), allocator_(ObModIds::OB_PROXY_SHARDING_MULTI_STMT),
+    session_sql_(), stmt_params_(), stmt_resps_(), buf_(NULL), buf_reader_(NULL)
+{
+  SET_HANDLER(&ObShardMultiStmtCont::main_handler);
+}
+
+int ObShardMultiStmtCont::init(const uint8_t seq, const ObMySQLCapabilityFlags &capability,
+                               const int64_t timeout_ms, const ObString &session_sql,
+                               const uint16_t status_flag)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(NULL != buf_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected buf is not null", K(ret));
+  } else if (OB_ISNULL(buf_ = new_empty_miobuffer())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to new_empty_miobuffer for buf", K(ret));
+  } else if (OB_ISNULL(buf_reader_ = buf_->alloc_reader())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("fail to allocate buffer reader", K(ret));
+  } else if (OB_FAIL(ob_write_string(allocator_, session_sql, session_sql_))) {
+    LOG_WARN("fail to write session sql", K(session_sql), K(ret));
+  } else {
+    seq_ = seq;
+    capability_ = capability;
+    status_flag_ = status_flag;
+    timeout_ms_ = timeout_ms;
+  }
+
+  return ret;
+}
+
+int ObShardMultiStmtCont::add_stmt(ObShardConnector *shard_conn, ObShardProp *shard_prop,
+                                   const ObString &sql)
+{
+  int ret = OB_SUCCESS;
+
+  ObProxyParallelParam param;
+  ObString stmt_sql = sql;
+  // the split stmt keeps its delimiter, which is not needed when it is sent alone
+  stmt_sql = stmt_sql.trim();
+  while (!stmt_sql.empty() && ';' == stmt_sql[stmt_sql.length() - 1]) {
+    stmt_sql.assign_ptr(stmt_sql.ptr(), stmt_sql.length() - 1);
+    stmt_sql = stmt_sql.trim();
+  }
+
+  if (OB_ISNULL(shard_conn) || OB_UNLIKELY(stmt_sql.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", KP(shard_conn), K(sql), K(ret));
+  } else if (OB_FAIL(ob_write_string(allocator_, stmt_sql, param.request_sql_))) {
+    LOG_WARN("fail to write stmt sql", K(stmt_sql), K(ret));
+  } else {
+    param.shard_conn_ = shard_conn;
+    param.shard_prop_ = shard_prop;
+    param.session_sql_ = session_sql_;
+    if (OB_FAIL(stmt_params_.push_back(param))) {
+      LOG_WARN("fail to push back stmt param", K(param), K(ret));
+    } else {
+      shard_conn->inc_ref();
+      if (NULL != shard_prop) {
+        shard_prop->inc_ref();
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObShardMultiStmtCont::main_handler(int event, void *data)
+{
+  int ret = OB_SUCCESS;
+
+  switch (event) {
+    case EVENT_IMMEDIATE: {
+      pending_action_ = NULL;
+      if (OB_FAIL(handle_event_start())) {
+        LOG_WARN("fail to handle event start", K(ret));
+      }
+      break;
+    }
+    case VC_EVENT_READ_READY:
+    case VC_EVENT_READ_COMPLETE: {
+      if (VC_EVENT_READ_COMPLETE == event) {
+        pending_action_ = NULL;
+      }
+      if (OB_FAIL(handle_stmt_resp(data))) {
+        LOG_WARN("fail to handle stmt resp", K(ret));
+      } else if (VC_EVENT_READ_COMPLETE != event) {
+        // wait for other stmts
+      } else if (action_.cancelled_) {
+        terminate_ = true;
+        LOG_INFO("async task has been cancelled, will kill itself", K(ret));
+      } else if (OB_FAIL(build_multi_stmt_resp())) {
+        LOG_WARN("fail to build multi stmt resp", K(ret));
+      } else {
+        need_callback_ = true;
+      }
+      break;
+    }
+    case ASYNC_PROCESS_INFORM_OUT_EVENT: {
+      pending_action_ = NULL;
+      if (OB_FAIL(handle_event_inform_out())) {
+        LOG_WARN("fail to handle inform out event", K(ret));
+      }
+      break;
+    }
+    case VC_EVENT_ACTIVE_TIMEOUT: {
+      pending_action_ = NULL;
+      ret = OB_TIMEOUT;
+      LOG_WARN("timeout to execute multi stmt", K_(timeout_ms), K(ret));
+      break;
+    }
+    case VC_EVENT_ERROR:
+    default: {
+      pending_action_ = NULL;
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("fail to execute multi stmt", K(event), K(ret));
+      break;
+    }
+  }
+
+  if (OB_FAIL(ret) && !terminate_) {
+    // stop the stmts still running, their resps are not needed any more
+    cancel_pending_action();
+    if (action_.cancelled_) {
+      terminate_ = true;
+      LOG_INFO("async task has been cancelled, will kill itself", K(ret));
+    } else {
+      if (OB_FAIL(build_error_resp(ret))) {
+        LOG_WARN("fail to build error resp", K(ret));
+      }
+      need_callback_ = true;
+    }
+  }
+
+  if (!terminate_ && need_callback_) {
+    if (OB_FAIL(handle_callback())) {
+      LOG_WARN("fail to handle callback", K(ret));
+    }
+  }
+
+  if (terminate_) {
+    destroy();
+  }
+
+  return EVENT_DONE;
+}
+
+int ObShardMultiStmtCont::init_task()
+{
+  int ret = OB_SUCCESS;
+
+  stmt_resps_.reset();
+  for (int64_t i = 0; OB_SUCC(ret) && i < stmt_params_.count(); ++i) {
+    if (OB_FAIL(stmt_resps_.push_back(NULL))) {
+      LOG_WARN("fail to push back stmt resp", K(i), K(ret));
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_UNLIKELY(stmt_params_.count() <= 1)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("multi stmt should have more than one stmt", "stmt count", stmt_params_.count(), K(ret));
+  } else if (OB_FAIL(get_global_parallel_processor().open(*this, pending_action_, stmt_params_,
+                                                          &allocator_, timeout_ms_))) {
+    LOG_WARN("fail to open parallel processor", K_(stmt_params), K_(timeout_ms), K(ret));
+  } else if (OB_ISNULL(pending_action_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("pending action should not be null", K(ret));
+  } else {
+    LOG_DEBUG("succ to execute multi stmt in parallel", "stmt count", stmt_params_.count());
+  }
+
+  if (OB_FAIL(ret)) {
+    // the caller is told by an error packet
+    if (OB_FAIL(build_error_resp(ret))) {
+      LOG_WARN("fail to build error resp", K(ret));
+    }
+    ret = OB_SUCCESS;
+    need_callback_ = true;
+  }
+
+  return ret;
+}
+
+void *ObShardMultiStmtCont::get_callback_data()
+{
+  // nothing to send means even the error packet failed to build, the caller will disconnect
+  return (NULL != buf_reader_ && buf_reader_->read_avail() > 0) ? buf_reader_ : NULL;
+}
+
+int ObShardMultiStmtCont::handle_stmt_resp(void *data)
+{
+  int ret = OB_SUCCESS;
+
+  ObProxyParallelResp *resp = static_cast<ObProxyParallelResp *>(data);
+  if (OB_ISNULL(resp)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("stmt resp is null", K(ret));
+  } else {
+    const int64_t stmt_index = resp->get_cont_index();
+    if (OB_UNLIKELY(stmt_index < 0) || OB_UNLIKELY(stmt_index >= stmt_resps_.count())
+        || OB_UNLIKELY(NULL != stmt_resps_.at(stmt_index))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected stmt resp", K(stmt_index), "stmt count", stmt_resps_.count(), K(ret));
+      op_free(resp);
+      resp = NULL;
+    } else {
+      stmt_resps_.at(stmt_index) = resp;
+    }
+  }
+
+  return ret;
+}
+
+int ObShardMultiStmtCont::build_multi_stmt_resp()
+{
+  int ret = OB_SUCCESS;
+
+  bool is_error_resp = false;
+  uint8_t seq = seq_;
+  const int64_t stmt_count = stmt_resps_.count();
+  for (int64_t i = 0; OB_SUCC(ret) && !is_error_resp && i < stmt_count; ++i) {
+    ObProxyParallelResp *resp = stmt_resps_.at(i);
+    ObServerStatusFlags status_flag(status_flag_);
+    status_flag.status_flags_.OB_SERVER_MORE_RESULTS_EXISTS = (i < stmt_count - 1) ? 1 : 0;
+    if (OB_ISNULL(resp)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("stmt resp is null", K(i), K(ret));
+    } else if (resp->is_resultset_resp()) {
+      if (OB_FAIL(build_resultset_resp(seq, *resp, status_flag.flags_))) {
+        LOG_WARN("fail to build resultset resp", K(i), K(ret));
+      }
+    } else if (resp->is_ok_resp()) {
+      int64_t affected_rows = 0;
+      if (OB_FAIL(resp->get_affected_rows(affected_rows))) {
+        LOG_WARN("fail to get affected rows", K(i), K(ret));
+      } else if (OB_FAIL(ObMysqlPacketUtil::encode_ok_packet(*buf_, seq, affected_rows, capability_,
+                                                            status_flag.flags_))) {
+        LOG_WARN("fail to encode ok packet", K(i), K(seq), K(ret));
+      }
+    } else {
+      // as a server does, the stmts behind a failed one get no response
+      is_error_resp = true;
+      if (OB_FAIL(ObMysqlPacketUtil::encode_err_packet(*buf_, seq, resp->get_err_code(), resp->get_err_msg()))) {
+        LOG_WARN("fail to encode err packet", K(i), K(seq), "errmsg", resp->get_err_msg(),
+                 "errcode", resp->get_err_code(), K(ret));
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObShardMultiStmtCont::build_resultset_resp(uint8_t &seq, ObProxyParallelResp &resp, const uint16_t status_flag)
+{
+  int ret = OB_SUCCESS;
+
+  const int64_t column_count = resp.get_column_count();
+  ObMysqlField *fields = resp.get_field();
+  ObSEArray<ObMySQLField, 4> mysql_fields;
+  ObSEArray<ObField, 4> ob_fields;
+
+  // header, cols, first eof
+  if (OB_ISNULL(fields) || OB_UNLIKELY(column_count <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid resultset resp", KP(fields), K(column_count), K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_count; ++i) {
+    ObMySQLField mysql_field;
+    ObField ob_field;
+    change_to_sql_field(fields[i], mysql_field);
+    if (OB_FAIL(mysql_fields.push_back(mysql_field))) {
+      LOG_WARN("fail to push mysql field", K(mysql_field), K(ret));
+    } else if (OB_FAIL(ObSMUtils::to_ob_field(mysql_field, ob_field))) {
+      LOG_WARN("fail to covert to ob field", K(mysql_field), K(ret));
+    } else if (OB_FAIL(ob_fields.push_back(ob_field))) {
+      LOG_WARN("fail to push ob field", K(ob_field), K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(ObMysqlPacketUtil::encode_header(*buf_, seq, mysql_fields, status_flag))) {
+    LOG_WARN("fail to encode header", K(seq), K(ret));
+  }
+
+  // rows
+  if (OB_SUCC(ret)) {
+    ObObj *objs = NULL;
+    ObNewRow row;
+    while (OB_SUCC(ret) && OB_SUCC(resp.next(objs))) {
+      if (OB_ISNULL(objs)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("row should not be null", K(ret));
+      } else {
+        row.cells_ = objs;
+        row.count_ = column_count;
+        if (OB_FAIL(ObMysqlPacketUtil::encode_row_packet(*buf_, seq, row, &ob_fields))) {
+          LOG_WARN("fail to encode row", K(seq), K(row), K(ret));
+        } else {
+          row.reset();
+          objs = NULL;
+        }
+      }
+    }
+
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+  }
+
+  // second eof
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(ObMysqlPacketUtil::encode_eof_packet(*buf_, seq, status_flag))) {
+      LOG_WARN("fail to encode eof", K(seq), K(ret));
+    }
+  }
+
+  return ret;
+}
+
+int ObShardMultiStmtCont::build_error_resp(const int errcode)
+{
+  int ret = OB_SUCCESS;
+
+  uint8_t seq = seq_;
+  char *err_msg = NULL;
+  if (OB_ISNULL(buf_) || OB_ISNULL(buf_reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("buf is not inited", KP_(buf), KP_(buf_reader), K(ret));
+  } else if (OB_FAIL(buf_reader_->consume_all())) {
+    LOG_WARN("fail to consume all", K(ret));
+  } else if (OB_FAIL(ObProxyPacketWriter::get_err_buf(errcode, err_msg))) {
+    LOG_WARN("fail to get err buf", K(errcode), K(ret));
+  } else if (OB_FAIL(ObMysqlPacketUtil::encode_err_packet(*buf_, seq, errcode, err_msg))) {
+    LOG_WARN("fail to encode err packet", K(errcode), K(err_msg), K(ret));
+  }
+
+  return ret;
+}
+
+void ObShardMultiStmtCont::destroy()
+{
+  LOG_DEBUG("ObShardMultiStmtCont will be destroyed", KP(this));
+
+  // the parallel cont holds the resps to come, cancel it before freeing ours
+  cancel_pending_action();
+
+  for (int64_t i = 0; i < stmt_resps_.count(); ++i) {
+    if (NULL != stmt_resps_.at(i)) {
+      op_free(stmt_resps_.at(i));
+      stmt_resps_.at(i) = NULL;
+    }
+  }
+  stmt_resps_.reset();
+
+  for (int64_t i = 0; i < stmt_params_.count(); ++i) {
+    ObProxyParallelParam &param = stmt_params_.at(i);
+    if (NULL != param.shard_conn_) {
+      param.shard_conn_->dec_ref();
+      param.shard_conn_ = NULL;
+    }
+    if (NULL != param.shard_prop_) {
+      param.shard_prop_->dec_ref();
+      param.shard_prop_ = NULL;
+    }
+  }
+  stmt_params_.reset();
+
+  if (OB_LIKELY(NULL != buf_reader_)) {
+    buf_reader_->dealloc();
+    buf_reader_ = NULL;
+  }
+
+  if (OB_LIKELY(NULL != buf_)) {
+    free_miobuffer(buf_);
+    buf_ = NULL;
+  }
+
+  ObAsyncCommonTask::destroy();
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
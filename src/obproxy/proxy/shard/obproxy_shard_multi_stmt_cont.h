@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_SHARD_MULTI_STMT_CONT_H
+#define OBPROXY_SHARD_MULTI_STMT_CONT_H
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "rpc/obmysql/ob_mysql_packet.h"
+#include "obutils/ob_async_common_task.h"
+#include "executor/ob_proxy_parallel_processor.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace executor
+{
+class ObProxyParallelResp;
+}
+namespace proxy
+{
+
+// Execute the statements of a multi stmt query, which are routed to different shards,
+// on their shards in parallel. Responses are reassembled in statement order, all but
+// the last one with SERVER_MORE_RESULTS_EXISTS, and handed to cb_cont in one buffer.
+// session_sql sets the session variables of the client on each executor connection first,
+// status_flag carries the autocommit and in trans state of the client session.
+class ObShardMultiStmtCont : public obutils::ObAsyncCommonTask
+{
+public:
+  ObShardMultiStmtCont(event::ObContinuation *cb_cont, event::ObEThread *cb_thread);
+  virtual ~ObShardMultiStmtCont() {}
+
+  int main_handler(int event, void *data);
+  int init(const uint8_t seq, const obmysql::ObMySQLCapabilityFlags &capability, const int64_t timeout_ms,
+           const common::ObString &session_sql, const uint16_t status_flag);
+  int add_stmt(dbconfig::ObShardConnector *shard_conn, dbconfig::ObShardProp *shard_prop,
+               const common::ObString &sql);
+  int64_t get_stmt_count() const { return stmt_params_.count(); }
+
+  virtual int init_task();
+  virtual void *get_callback_data();
+  virtual void destroy();
+
+private:
+  int handle_stmt_resp(void *data);
+  int build_multi_stmt_resp();
+  int build_resultset_resp(uint8_t &seq, executor::ObProxyParallelResp &resp, const uint16_t status_flag);
+  int build_error_resp(const int errcode);
+
+private:
+  uint8_t seq_;
+  obmysql::ObMySQLCapabilityFlags capability_;
+  uint16_t status_flag_;
+  int64_t timeout_ms_;
+  common::ObArenaAllocator allocator_;
+  common::ObString session_sql_;
+  common::ObSEArray<executor::ObProxyParallelParam, 4> stmt_params_;
+  common::ObSEArray<executor::ObProxyParallelResp *, 4> stmt_resps_;
+  event::ObMIOBuffer *buf_;
+  event::ObIOBufferReader *buf_reader_;
+  DISALLOW_COPY_AND_ASSIGN(ObShardMultiStmtCont);
+};
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_SHARD_MULTI_STMT_CONT_H
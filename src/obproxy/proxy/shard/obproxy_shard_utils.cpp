@@ -26,6 +26,8 @@
 #include "obutils/ob_proxy_stmt.h"
 #include "optimizer/ob_proxy_optimizer_processor.h"
 #include "lib/container/ob_se_array_iterator.h"
+#include "proxy/shard/obproxy_shard_multi_stmt_cont.h"
+#include "iocore/eventsystem/ob_shard_scan_all_task.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::common::hash;
@@ -34,6 +36,7 @@ using namespace oceanbase::obproxy::dbconfig;
 using namespace oceanbase::obproxy::obutils;
 using namespace oceanbase::sql;
 using namespace oceanbase::obproxy::optimizer;
+using namespace oceanbase::obproxy::executor;
 
 
 namespace oceanbase
@@ -1441,10 +1444,12 @@ int ObProxyShardUtils::handle_single_shard_request(ObMysqlClientSession &client_
   return ret;
 }
 
-int ObProxyShardUtils::handle_shard_request(ObMysqlClientSession &client_session,
+int ObProxyShardUtils::handle_shard_request(ObMysqlSM *sm,
+                                            ObMysqlClientSession &client_session,
                                             ObMysqlTransact::ObTransState &trans_state,
                                             ObIOBufferReader &client_buffer_reader,
-                                            ObDbConfigLogicDb &logic_db_info)
+                                            ObDbConfigLogicDb &logic_db_info,
+                                            bool &need_wait_callback)
 {
   int ret = OB_SUCCESS;
 
@@ -1463,6 +1468,16 @@ int ObProxyShardUtils::handle_shard_request(ObMysqlClientSession &client_session
   int64_t last_es_index = OBPROXY_MAX_DBMESH_ID;
   int64_t last_group_index = OBPROXY_MAX_DBMESH_ID;
   bool is_scan_all = false;
+  // select stmts routed to different shards out of transaction can be executed in parallel
+  bool is_multi_shard = false;
+  bool enable_parallel_execute = false;
+  ObSEArray<ObProxyParallelParam, 4> stmt_params;
+  ObSEArray<int64_t, 4> stmt_sql_pos;
+  // each stmt changes the connector of the session to its own shard
+  ObShardConnector *orig_shard_conn = session_info.get_shard_connector();
+  if (NULL != orig_shard_conn) {
+    orig_shard_conn->inc_ref();
+  }
 
   if (OB_FAIL(ObProxySqlParser::split_multiple_stmt(origin_sql, sql_array))) {
     LOG_WARN("fail to split sql", K(ret));
@@ -1477,6 +1492,9 @@ int ObProxyShardUtils::handle_shard_request(ObMysqlClientSession &client_session
     LOG_WARN("fail to preprocess multi stmt", K(ret));
   } else {
     bool is_multi_stmt = sql_array.count() > 1;
+    enable_parallel_execute = is_multi_stmt
+                              && get_global_proxy_config().enable_multi_stmt_parallel_execute
+                              && !is_sharding_in_trans(session_info, trans_state);
     ObSqlParseResult parse_result;
     ObSqlParseResult* real_parse_result = NULL;
     ObProxySqlParser sql_parser;
@@ -1502,16 +1520,25 @@ int ObProxyShardUtils::handle_shard_request(ObMysqlClientSession &client_session
         } else if (OB_UNLIKELY(is_multi_stmt && ObProxyShardUtils::is_unsupport_type_in_multi_stmt(*real_parse_result))) {
           ret = OB_NOT_SUPPORTED;
           LOG_WARN("unsupport type in multi stmt", K(ret), K(sql));
+        } else if (OB_FAIL(stmt_sql_pos.push_back(new_sql.length()))) {
+          LOG_WARN("fail to push back stmt sql pos", K(ret));
         } else if (OB_FAIL(do_handle_shard_request(client_session, trans_state, logic_db_info, sql, new_sql, *real_parse_result, 
                                                   es_index, group_index, last_es_index, is_scan_all))) {
           LOG_WARN("fail to handle single shard request for single sql", K(ret), K(sql), K(new_sql));
-        } else if (OB_UNLIKELY((i > 0) && ((es_index != last_es_index) || (group_index != last_group_index)))) {
-          ret = OB_ERR_DISTRIBUTED_NOT_SUPPORTED;
-          LOG_WARN("different elastic index or group index for multi stmt is not supported", K(es_index), K(last_es_index), K(group_index), 
-                                                                                            K(last_group_index), K(sql), K(new_sql), K(ret));
         } else if (OB_UNLIKELY(is_multi_stmt && is_scan_all)) {
           ret = OB_ERR_DISTRIBUTED_NOT_SUPPORTED;
           LOG_WARN("scan all sql in multi stmt is not supported", K(sql), K(new_sql), K(ret));
+        } else if (enable_parallel_execute
+                   && OB_FAIL(add_multi_stmt_param(session_info, *real_parse_result,
+                                                   enable_parallel_execute, stmt_params))) {
+          LOG_WARN("fail to add multi stmt param", K(sql), K(ret));
+        } else if (OB_UNLIKELY((i > 0) && ((es_index != last_es_index) || (group_index != last_group_index)))
+                   && FALSE_IT(is_multi_shard = true)) {
+          // impossible
+        } else if (OB_UNLIKELY(is_multi_shard && !enable_parallel_execute)) {
+          ret = OB_ERR_DISTRIBUTED_NOT_SUPPORTED;
+          LOG_WARN("different elastic index or group index for multi stmt is not supported", K(es_index), K(last_es_index), K(group_index), 
+                                                                                            K(last_group_index), K(sql), K(new_sql), K(ret));
         } else {
           last_es_index = es_index;
           last_group_index = group_index;
@@ -1523,7 +1550,16 @@ int ObProxyShardUtils::handle_shard_request(ObMysqlClientSession &client_session
     }
 
     if (OB_SUCC(ret)) {
-      if (is_scan_all) {
+      if (is_multi_shard) {
+        for (int64_t i = 0; i < stmt_params.count(); ++i) {
+          const int64_t end_pos = (i < stmt_params.count() - 1) ? stmt_sql_pos.at(i + 1) : new_sql.length();
+          stmt_params.at(i).request_sql_.assign_ptr(new_sql.ptr() + stmt_sql_pos.at(i),
+                                                    static_cast<ObString::obstr_size_t>(end_pos - stmt_sql_pos.at(i)));
+        }
+        if (OB_FAIL(handle_multi_stmt_request(sm, client_session, trans_state, stmt_params, need_wait_callback))) {
+          LOG_WARN("fail to handle multi stmt request", K(new_sql), K(ret));
+        }
+      } else if (is_scan_all) {
         if (OB_FAIL(handle_scan_all_real_info(logic_db_info, client_session, trans_state, first_table_name))) {
           LOG_WARN("fail to handle scan all real info", K(first_table_name), K(ret));
         }
@@ -1539,6 +1575,66 @@ int ObProxyShardUtils::handle_shard_request(ObMysqlClientSession &client_session
     allocator.free(multi_sql_buf);
   }
 
+  // the stmts are executed on the executor connections, the session keeps the
+  // connector it has before this request
+  if (is_multi_shard && NULL != orig_shard_conn) {
+    int tmp_ret = OB_SUCCESS;
+    ObShardConnector *cur_shard_conn = session_info.get_shard_connector();
+    if (NULL != cur_shard_conn && *cur_shard_conn != *orig_shard_conn) {
+      cur_shard_conn->inc_ref();
+      if (OB_SUCCESS != (tmp_ret = change_connector(logic_db_info, client_session, trans_state,
+                                                    cur_shard_conn, orig_shard_conn))) {
+        LOG_WARN("fail to restore connector", KPC(cur_shard_conn), KPC(orig_shard_conn), K(tmp_ret));
+        ret = (OB_SUCCESS == ret) ? tmp_ret : ret;
+      }
+      cur_shard_conn->dec_ref();
+    }
+  }
+  if (NULL != orig_shard_conn) {
+    orig_shard_conn->dec_ref();
+    orig_shard_conn = NULL;
+  }
+
+  for (int64_t i = 0; i < stmt_params.count(); ++i) {
+    ObProxyParallelParam &param = stmt_params.at(i);
+    param.shard_conn_->dec_ref();
+    if (NULL != param.shard_prop_) {
+      param.shard_prop_->dec_ref();
+    }
+  }
+
+  return ret;
+}
+
+int ObProxyShardUtils::add_multi_stmt_param(ObClientSessionInfo &session_info,
+                                            ObSqlParseResult &parse_result,
+                                            bool &enable_parallel_execute,
+                                            ObIArray<ObProxyParallelParam> &stmt_params)
+{
+  int ret = OB_SUCCESS;
+
+  ObShardConnector *shard_conn = session_info.get_shard_connector();
+  ObShardProp *shard_prop = session_info.get_shard_prop();
+  // dml stmts behind a failed one must not be executed, and stmts not routed by
+  // table have no shard of their own, both have to be sent in one request
+  if (!parse_result.is_select_stmt()
+      || parse_result.get_origin_table_name().empty()
+      || OB_ISNULL(shard_conn)) {
+    enable_parallel_execute = false;
+  } else {
+    ObProxyParallelParam param;
+    param.shard_conn_ = shard_conn;
+    param.shard_prop_ = shard_prop;
+    if (OB_FAIL(stmt_params.push_back(param))) {
+      LOG_WARN("fail to push back stmt param", K(ret));
+    } else {
+      shard_conn->inc_ref();
+      if (NULL != shard_prop) {
+        shard_prop->inc_ref();
+      }
+    }
+  }
+
   return ret;
 }
 
@@ -1654,6 +1750,83 @@ int ObProxyShardUtils::handle_ddl_request(ObMysqlSM *sm,
   return ret;
 }
 
+int ObProxyShardUtils::handle_multi_stmt_request(ObMysqlSM *sm,
+                                                 ObMysqlClientSession &client_session,
+                                                 ObMysqlTransact::ObTransState &trans_state,
+                                                 const ObIArray<ObProxyParallelParam> &stmt_params,
+                                                 bool &need_wait_callback)
+{
+  int ret = OB_SUCCESS;
+
+  ObShardMultiStmtCont *cont = NULL;
+  ObSqlString session_sql;
+
+  ObClientSessionInfo &session_info = client_session.get_session_info();
+  ObProxyMysqlRequest &client_request = trans_state.trans_info_.client_request_;
+  uint8_t seq = static_cast<uint8_t>(client_request.get_packet_meta().pkt_seq_ + 1);
+  ObHRTime execute_timeout = sm->get_query_timeout();
+  ObEThread *cb_thread = &self_ethread();
+  ObServerStatusFlags status_flag;
+  if (0 != session_info.get_cached_variables().get_autocommit()) {
+    status_flag.status_flags_.OB_SERVER_STATUS_AUTOCOMMIT = 1;
+  }
+  if (ObMysqlTransact::is_in_trans(trans_state)) {
+    status_flag.status_flags_.OB_SERVER_STATUS_IN_TRANS = 1;
+  }
+  if (OB_FAIL(build_multi_stmt_session_sql(session_info, session_sql))) {
+    LOG_WARN("fail to build multi stmt session sql", K(ret));
+  } else if (OB_ISNULL(cont = new(std::nothrow) ObShardMultiStmtCont(sm, cb_thread))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory for ObShardMultiStmtCont", K(ret));
+  } else if (OB_FAIL(cont->init(seq, session_info.get_orig_capability_flags(), hrtime_to_msec(execute_timeout),
+                                session_sql.string(), status_flag.flags_))) {
+    LOG_WARN("fail to init ObShardMultiStmtCont", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < stmt_params.count(); ++i) {
+    const ObProxyParallelParam &param = stmt_params.at(i);
+    if (OB_FAIL(cont->add_stmt(param.shard_conn_, param.shard_prop_, param.request_sql_))) {
+      LOG_WARN("fail to add stmt", K(i), K(param), K(ret));
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_ISNULL(g_shard_scan_all_task_processor.schedule_imm(cont, ET_SHARD_SCAN_ALL))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("fail to schedule shard multi stmt task", K(ret));
+  } else if (OB_FAIL(sm->setup_handle_shard_multi_stmt(&cont->get_action()))) {
+    LOG_WARN("fail to setup handle shard multi stmt", K(ret));
+  } else {
+    need_wait_callback = true;
+    client_session.set_inactivity_timeout(execute_timeout);
+    LOG_DEBUG("succ to schedule shard multi stmt task", "stmt count", stmt_params.count());
+  }
+
+  if (OB_FAIL(ret)) {
+    if (NULL != cont) {
+      cont->destroy();
+      cont = NULL;
+    }
+  }
+
+  return ret;
+}
+
+int ObProxyShardUtils::build_multi_stmt_session_sql(ObClientSessionInfo &session_info,
+                                                    ObSqlString &session_sql)
+{
+  int ret = OB_SUCCESS;
+
+  // the executor connection may have synced nothing, so every variable of the client is set
+  if (OB_FAIL(session_info.extract_client_variable_sql(session_sql))) {
+    LOG_WARN("fail to extract client variable sql", K(ret));
+  } else {
+    LOG_DEBUG("succ to build multi stmt session sql", K(session_sql));
+  }
+
+  return ret;
+}
+
 int ObProxyShardUtils::handle_other_request(ObMysqlClientSession &client_session,
                                             ObMysqlTransact::ObTransState &trans_state,
                                             const ObString &table_name,
@@ -93,10 +93,25 @@ public:
                                      int64_t& group_index,
                                      const int64_t last_es_index,
                                      bool& is_scan_all);                      
-  static int handle_shard_request(ObMysqlClientSession &client_session,
+  static int handle_shard_request(ObMysqlSM *sm,
+                                  ObMysqlClientSession &client_session,
                                   ObMysqlTransact::ObTransState &trans_state,
                                   ObIOBufferReader &client_buffer_reader,
-                                  dbconfig::ObDbConfigLogicDb &db_info);
+                                  dbconfig::ObDbConfigLogicDb &db_info,
+                                  bool &need_wait_callback);
+  static int add_multi_stmt_param(ObClientSessionInfo &session_info,
+                                  obutils::ObSqlParseResult &parse_result,
+                                  bool &enable_parallel_execute,
+                                  common::ObIArray<executor::ObProxyParallelParam> &stmt_params);
+  static int handle_multi_stmt_request(ObMysqlSM *sm,
+                                       ObMysqlClientSession &client_session,
+                                       ObMysqlTransact::ObTransState &trans_state,
+                                       const common::ObIArray<executor::ObProxyParallelParam> &stmt_params,
+                                       bool &need_wait_callback);
+  // the executor connections of a multi stmt request may have synced nothing of the session,
+  // so all the variables the client has set are sent before the stmt, whatever their versions
+  static int build_multi_stmt_session_sql(ObClientSessionInfo &session_info,
+                                          common::ObSqlString &session_sql);
   static int handle_ddl_request(ObMysqlSM *sm,
                                 ObMysqlClientSession &client_session,
                                 ObMysqlTransact::ObTransState &trans_state,
@@ -74,6 +74,30 @@ int init_net_stats()
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "calls_to_write_nodata",
                           RECD_INT, NET_CALLS_TO_WRITE_NODATA, SYNC_SUM, RECP_NULL);
 
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "write_coalesce_deferred",
+                          RECD_INT, NET_WRITE_COALESCE_DEFERRED, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "write_coalesce_saved_calls",
+                          RECD_INT, NET_WRITE_COALESCE_SAVED_CALLS, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "zero_copy_send_calls",
+                          RECD_INT, NET_ZERO_COPY_SEND_CALLS, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "zero_copy_send_bytes",
+                          RECD_INT, NET_ZERO_COPY_SEND_BYTES, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "zero_copy_send_copied",
+                          RECD_INT, NET_ZERO_COPY_SEND_COPIED, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "iobuffer_cache_hit",
+                          RECD_INT, NET_IOBUFFER_CACHE_HIT, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "iobuffer_cache_miss",
+                          RECD_INT, NET_IOBUFFER_CACHE_MISS, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "iobuffer_cached_bytes",
+                          RECD_INT, NET_IOBUFFER_CACHED_BYTES, SYNC_SUM, RECP_NULL);
+
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "inactivity_cop_lock_acquire_failure",
                           RECD_INT, INACTIVITY_COP_LOCK_ACQUIRE_FAILURE, SYNC_SUM, RECP_NULL);
 
@@ -37,6 +37,14 @@ enum ObNetStats
   NET_CALLS_TO_WRITETONET,
   NET_CALLS_TO_WRITE,
   NET_CALLS_TO_WRITE_NODATA,
+  NET_WRITE_COALESCE_DEFERRED,
+  NET_WRITE_COALESCE_SAVED_CALLS,
+  NET_ZERO_COPY_SEND_CALLS,
+  NET_ZERO_COPY_SEND_BYTES,
+  NET_ZERO_COPY_SEND_COPIED,
+  NET_IOBUFFER_CACHE_HIT,
+  NET_IOBUFFER_CACHE_MISS,
+  NET_IOBUFFER_CACHED_BYTES,
   INACTIVITY_COP_LOCK_ACQUIRE_FAILURE,
   KEEP_ALIVE_LRU_TIMEOUT_TOTAL,
   KEEP_ALIVE_LRU_TIMEOUT_COUNT,
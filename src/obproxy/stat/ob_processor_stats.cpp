@@ -80,6 +80,16 @@ int init_processor_stats()
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "kick_out_table_entry_from_global_cache",
                       RECD_INT, KICK_OUT_TABLE_ENTRY_FROM_GLOBAL_CACHE, SYNC_SUM, RECP_NULL);
 
+    // batched table entry fetch related
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "batch_fetch_table_entry_count",
+                      RECD_INT, BATCH_FETCH_TABLE_ENTRY_COUNT, SYNC_SUM, RECP_NULL);
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "batch_fetch_table_entry_size",
+                      RECD_INT, BATCH_FETCH_TABLE_ENTRY_SIZE, SYNC_SUM, RECP_NULL);
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "batch_fetch_table_entry_time",
+                      RECD_INT, BATCH_FETCH_TABLE_ENTRY_TIME, SYNC_SUM, RECP_NULL);
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "batch_fetch_table_entry_fail",
+                      RECD_INT, BATCH_FETCH_TABLE_ENTRY_FAIL, SYNC_SUM, RECP_NULL);
+
     // partition info related
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "get_part_info_from_remote",
                       RECD_INT, GET_PART_INFO_FROM_REMOTE, SYNC_SUM, RECP_PERSISTENT);
@@ -167,6 +177,58 @@ int init_processor_stats()
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "kick_out_routine_entry_from_global_cache",
                       RECD_INT, KICK_OUT_ROUTINE_ENTRY_FROM_GLOBAL_CACHE, SYNC_SUM, RECP_PERSISTENT);
 
+    // table cache lookup related
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "table_cache_lookup_hit",
+                      RECD_INT, TABLE_CACHE_LOOKUP_HIT, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "table_cache_lookup_miss",
+                      RECD_INT, TABLE_CACHE_LOOKUP_MISS, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "table_cache_evicted",
+                      RECD_INT, TABLE_CACHE_EVICTED, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "table_cache_hit_ratio_permille",
+                      RECD_INT, TABLE_CACHE_HIT_RATIO_PERMILLE, SYNC_SUM, RECP_NULL);
+
+    // partition cache lookup related
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "partition_cache_lookup_hit",
+                      RECD_INT, PARTITION_CACHE_LOOKUP_HIT, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "partition_cache_lookup_miss",
+                      RECD_INT, PARTITION_CACHE_LOOKUP_MISS, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "partition_cache_evicted",
+                      RECD_INT, PARTITION_CACHE_EVICTED, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "partition_cache_hit_ratio_permille",
+                      RECD_INT, PARTITION_CACHE_HIT_RATIO_PERMILLE, SYNC_SUM, RECP_NULL);
+
+    // routine cache lookup related
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "routine_cache_lookup_hit",
+                      RECD_INT, ROUTINE_CACHE_LOOKUP_HIT, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "routine_cache_lookup_miss",
+                      RECD_INT, ROUTINE_CACHE_LOOKUP_MISS, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "routine_cache_evicted",
+                      RECD_INT, ROUTINE_CACHE_EVICTED, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "routine_cache_hit_ratio_permille",
+                      RECD_INT, ROUTINE_CACHE_HIT_RATIO_PERMILLE, SYNC_SUM, RECP_NULL);
+
+    // sql table cache lookup related
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "sql_table_cache_lookup_hit",
+                      RECD_INT, SQL_TABLE_CACHE_LOOKUP_HIT, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "sql_table_cache_lookup_miss",
+                      RECD_INT, SQL_TABLE_CACHE_LOOKUP_MISS, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "sql_table_cache_evicted",
+                      RECD_INT, SQL_TABLE_CACHE_EVICTED, SYNC_SUM, RECP_NULL);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "sql_table_cache_hit_ratio_permille",
+                      RECD_INT, SQL_TABLE_CACHE_HIT_RATIO_PERMILLE, SYNC_SUM, RECP_NULL);
+
     // congestion related
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "get_congestion_total",
                       RECD_INT, GET_CONGESTION_TOTAL, SYNC_SUM, RECP_NULL);
@@ -43,6 +43,12 @@ enum ObProcessorStats
   GC_TABLE_ENTRY_FROM_THREAD_CACHE,
   KICK_OUT_TABLE_ENTRY_FROM_GLOBAL_CACHE, // when table cache is full
 
+  // batched table entry fetch related, see ObTableEntryBatchCont
+  BATCH_FETCH_TABLE_ENTRY_COUNT,
+  BATCH_FETCH_TABLE_ENTRY_SIZE,
+  BATCH_FETCH_TABLE_ENTRY_TIME,
+  BATCH_FETCH_TABLE_ENTRY_FAIL,
+
   // partition info related
   GET_PART_INFO_FROM_REMOTE,
   GET_PART_INFO_FROM_REMOTE_SUCC,
@@ -78,6 +84,25 @@ enum ObProcessorStats
   GC_ROUTINE_ENTRY_FROM_THREAD_CACHE,
   KICK_OUT_ROUTINE_ENTRY_FROM_GLOBAL_CACHE, // when routine cache is full
 
+  // global route cache lookup related, see ObRouteCachePolicy,
+  // the four stats of every cache must be in this order
+  TABLE_CACHE_LOOKUP_HIT,
+  TABLE_CACHE_LOOKUP_MISS,
+  TABLE_CACHE_EVICTED,
+  TABLE_CACHE_HIT_RATIO_PERMILLE,
+  PARTITION_CACHE_LOOKUP_HIT,
+  PARTITION_CACHE_LOOKUP_MISS,
+  PARTITION_CACHE_EVICTED,
+  PARTITION_CACHE_HIT_RATIO_PERMILLE,
+  ROUTINE_CACHE_LOOKUP_HIT,
+  ROUTINE_CACHE_LOOKUP_MISS,
+  ROUTINE_CACHE_EVICTED,
+  ROUTINE_CACHE_HIT_RATIO_PERMILLE,
+  SQL_TABLE_CACHE_LOOKUP_HIT,
+  SQL_TABLE_CACHE_LOOKUP_MISS,
+  SQL_TABLE_CACHE_EVICTED,
+  SQL_TABLE_CACHE_HIT_RATIO_PERMILLE,
+
   // congestion related
   GET_CONGESTION_TOTAL,
   GET_CONGESTION_FROM_THREAD_CACHE_HIT,
@@ -102,6 +127,8 @@ extern ObRecRawStatBlock *processor_rsb;
   ObStatProcessor::incr_global_raw_stat_sum(processor_rsb, x, y)
 #define PROCESSOR_READ_GLOBAL_DYN_SUM(x, S) \
   ObStatProcessor::get_global_raw_stat_sum(processor_rsb, x, S)
+#define PROCESSOR_SET_GLOBAL_DYN_STAT(x, y) \
+  ObStatProcessor::set_global_raw_stat_sum(processor_rsb, x, y)
 
 int init_processor_stats();
 
@@ -25,10 +25,13 @@ ObCpuTopology::ObCpuTopology()
     : is_inited_(false),
       core_number_(0),
       cpu_number_(0),
+      numa_node_number_(0),
       cores_()
 {
   for (int64_t i = 0; i < MAX_CORE_NUMBER; i++) {
     cores_[i].cpu_number_ = 0;
+    cores_[i].node_id_ = 0;
+    numa_ordered_core_ids_[i] = i;
   }
 }
 
@@ -44,37 +47,14 @@ int ObCpuTopology::init()
     LOG_WARN("fail to get lscpu info", K(ret));
   } else {
     char buf[BUFSIZ];
-    int64_t cpu_id = 0;
-    int64_t core_id = 0;
-
-    char *p = NULL;
-    char *p_core = NULL;
 
     while ((NULL != fgets(buf, BUFSIZ, fp)) && OB_SUCC(ret)) {
       if (buf[0] == '#') {
         continue;
       }
 
-      p = strchr(buf, ',');
-      *p = '\0';
-      cpu_id = atoll(buf);
-
-      p_core = p + 1;
-      p = strchr(p_core + 1, ',');
-      *p = '\0';
-      core_id = atoll(p_core);
-
-      if (core_id + 1 > core_number_) {
-        core_number_ = core_id + 1;
-      }
-
-      ++cpu_number_;
-
-      if (OB_LIKELY(core_number_ < MAX_CORE_NUMBER)) {
-        cores_[core_id].cpues_[(cores_[core_id].cpu_number_++) % MAX_CPU_NUMBER_PER_CORE] = cpu_id;
-      } else {
-        ret = OB_SIZE_OVERFLOW;
-        LOG_ERROR("too many cores", K(core_number_), K(ret));
+      if (OB_FAIL(parse_cpu_line(buf))) {
+        LOG_WARN("fail to parse cpu line", K(ret));
       }
     }
 
@@ -82,11 +62,12 @@ int ObCpuTopology::init()
       is_inited_ = true;
       int64_t j = 0;
       int64_t n = 0;
+      build_numa_ordered_core_ids();
       for (int64_t i = 0; i < core_number_; i++) {
         j = 0;
         n = cores_[i].cpu_number_;
         for (j = 0; j < n; j++) {
-          _LOG_INFO("core_id:%3ld => cpu_id:%3ld", i, cores_[i].cpues_[j]);
+          _LOG_INFO("core_id:%3ld => cpu_id:%3ld, node_id:%3ld", i, cores_[i].cpues_[j], cores_[i].node_id_);
         }
       }
     }
@@ -100,6 +81,66 @@ int ObCpuTopology::init()
   return ret;
 }
 
+int ObCpuTopology::parse_cpu_line(char *line)
+{
+  int ret = OB_SUCCESS;
+  int64_t cpu_id = 0;
+  int64_t core_id = 0;
+  int64_t node_id = 0;
+  char *p = NULL;
+  char *p_core = NULL;
+
+  if (OB_ISNULL(p = strchr(line, ','))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid cpu line", K(line), K(ret));
+  } else {
+    *p = '\0';
+    cpu_id = atoll(line);
+    p_core = p + 1;
+    if (OB_ISNULL(p = strchr(p_core, ','))) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("invalid cpu line", K(p_core), K(ret));
+    } else {
+      *p = '\0';
+      core_id = atoll(p_core);
+      // skip the socket column, the node column is empty without NUMA
+      if (NULL != (p = strchr(p + 1, ','))) {
+        node_id = atoll(p + 1);
+      }
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_UNLIKELY(core_id < 0 || core_id >= MAX_CORE_NUMBER)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_ERROR("too many cores", K(core_id), K(ret));
+  } else {
+    if (core_id + 1 > core_number_) {
+      core_number_ = core_id + 1;
+    }
+    if (node_id + 1 > numa_node_number_) {
+      numa_node_number_ = node_id + 1;
+    }
+    ++cpu_number_;
+    cores_[core_id].node_id_ = node_id;
+    cores_[core_id].cpues_[(cores_[core_id].cpu_number_++) % MAX_CPU_NUMBER_PER_CORE] = cpu_id;
+  }
+  return ret;
+}
+
+void ObCpuTopology::build_numa_ordered_core_ids()
+{
+  int64_t n = 0;
+  for (int64_t node = 0; node < numa_node_number_; node++) {
+    for (int64_t i = 0; i < core_number_; i++) {
+      if (node == cores_[i].node_id_) {
+        numa_ordered_core_ids_[n++] = i;
+      }
+    }
+  }
+}
+
 int64_t ObCpuTopology::get_core_number() const
 {
   return core_number_;
@@ -119,6 +160,11 @@ ObCpuTopology::CoreInfo *ObCpuTopology::get_core_info(const int64_t core_id)
   return core_info;
 }
 
+int64_t ObCpuTopology::get_numa_ordered_core_id(const int64_t index) const
+{
+  return (index >= 0 && index < core_number_) ? numa_ordered_core_ids_[index] : index;
+}
+
 int ObCpuTopology::bind_cpu(const int64_t cpu_id, const pthread_t thread_id)
 {
   int ret = OB_SUCCESS;
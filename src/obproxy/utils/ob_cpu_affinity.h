@@ -65,6 +65,7 @@ public:
   struct CoreInfo
   {
     int64_t cpu_number_;
+    int64_t node_id_;
     int64_t cpues_[MAX_CPU_NUMBER_PER_CORE];
   };
 
@@ -74,14 +75,25 @@ public:
   int init();
   int64_t get_core_number() const;
   int64_t get_cpu_number() const;
+  int64_t get_numa_node_number() const { return numa_node_number_; }
   CoreInfo *get_core_info(const int64_t core_id);
+  // the index-th core when cores are ordered by NUMA node, so that
+  // consecutive threads fill up one node before going to the next
+  int64_t get_numa_ordered_core_id(const int64_t index) const;
   int bind_cpu(const int64_t cpu_id, const pthread_t thread_id);
 
+private:
+  // one line of "lscpu -p": cpu,core,socket,node,...
+  int parse_cpu_line(char *line);
+  void build_numa_ordered_core_ids();
+
 private:
   bool is_inited_;
   int64_t core_number_;
   int64_t cpu_number_;
+  int64_t numa_node_number_;
   CoreInfo cores_[MAX_CORE_NUMBER];
+  int64_t numa_ordered_core_ids_[MAX_CORE_NUMBER];
 
   DISALLOW_COPY_AND_ASSIGN(ObCpuTopology);
 };
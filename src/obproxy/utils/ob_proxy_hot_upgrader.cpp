@@ -31,6 +31,8 @@ void ObHotUpgraderInfo::reset()
 {
   ipv4_fd_ = OB_INVALID_INDEX;
   ipv6_fd_ = OB_INVALID_INDEX;
+  reuseport_fd_count_[0] = 0;
+  reuseport_fd_count_[1] = 0;
   received_sig_ = OB_INVALID_INDEX;
   sub_pid_ = OB_INVALID_INDEX;
   rc_status_ = RCS_NONE;
@@ -70,7 +72,8 @@ DEF_TO_STRING(ObHotUpgraderInfo)
   int64_t pos = 0;
   J_OBJ_START();
   J_KV(K_(is_inherited), K_(upgrade_version), K_(need_conn_accept), K_(user_rejected), K_(ipv4_fd),
-       K_(ipv6_fd), K_(received_sig), K_(sub_pid), K_(graceful_exit_end_time),
+       K_(ipv6_fd), "reuseport_ipv4_fd_count", reuseport_fd_count_[0],
+       "reuseport_ipv6_fd_count", reuseport_fd_count_[1], K_(received_sig), K_(sub_pid), K_(graceful_exit_end_time),
        K_(graceful_exit_start_time), K_(active_client_vc_count), K_(local_addr),
        "rc_status", get_rc_status_string(rc_status_),
        "hu_cmd", get_cmd_string(cmd_),
@@ -361,6 +364,84 @@ int ObHotUpgraderInfo::fill_inherited_info(const bool is_server_service_mode, co
   return ret;
 }
 
+int ObHotUpgraderInfo::add_reuseport_fd(const bool is_ipv6, const int fd)
+{
+  int ret = OB_SUCCESS;
+  int64_t &count = reuseport_fd_count_[is_ipv6 ? 1 : 0];
+  if (OB_UNLIKELY(fd < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_UNLIKELY(count >= MAX_REUSEPORT_FD_COUNT)) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    reuseport_fds_[is_ipv6 ? 1 : 0][count++] = fd;
+  }
+  return ret;
+}
+
+int ObHotUpgraderInfo::get_reuseport_fd(const bool is_ipv6, const int64_t idx) const
+{
+  int fd = OB_INVALID_INDEX;
+  if (idx >= 0 && idx < reuseport_fd_count_[is_ipv6 ? 1 : 0]) {
+    fd = reuseport_fds_[is_ipv6 ? 1 : 0][idx];
+  }
+  return fd;
+}
+
+bool ObHotUpgraderInfo::is_reuseport_fd(const int fd) const
+{
+  bool bret = false;
+  for (int64_t i = 0; !bret && i < 2; ++i) {
+    for (int64_t j = 0; !bret && j < reuseport_fd_count_[i]; ++j) {
+      bret = (fd == reuseport_fds_[i][j]);
+    }
+  }
+  return bret;
+}
+
+int ObHotUpgraderInfo::get_reuseport_envp(const bool is_ipv6, char *buf, const int64_t buf_len) const
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  const int64_t idx = is_ipv6 ? 1 : 0;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(buf), K(buf_len), K(ret));
+  } else if (OB_FAIL(databuff_printf(buf, buf_len, pos, "%s=",
+      is_ipv6 ? OBPROXY_INHERITED_REUSEPORT_IPV6_FDS : OBPROXY_INHERITED_REUSEPORT_IPV4_FDS))) {
+    LOG_WARN("fail to print reuseport envp name", K(buf_len), K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < reuseport_fd_count_[idx]; ++i) {
+      if (OB_FAIL(databuff_printf(buf, buf_len, pos, (0 == i ? "%d" : ",%d"), reuseport_fds_[idx][i]))) {
+        LOG_WARN("fail to print reuseport fd", K(i), K(buf_len), K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObHotUpgraderInfo::parse_reuseport_fds(const bool is_ipv6, const char *fds_str)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(fds_str)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    const char *pos = fds_str;
+    char *end = NULL;
+    while (OB_SUCC(ret) && '\0' != *pos) {
+      const int64_t fd = strtol(pos, &end, 10);
+      if (OB_UNLIKELY(end == pos) || OB_UNLIKELY(fd < 0) || OB_UNLIKELY(fd > INT32_MAX)
+          || OB_UNLIKELY(',' != *end && '\0' != *end)) {
+        ret = OB_INVALID_ARGUMENT;
+      } else if (OB_FAIL(add_reuseport_fd(is_ipv6, static_cast<int>(fd)))) {
+        // can't print log here
+      } else {
+        pos = (',' == *end) ? end + 1 : end;
+      }
+    }
+  }
+  return ret;
+}
+
 void ObHotUpgraderInfo::disable_net_accept()
 {
   int ret = OB_SUCCESS;
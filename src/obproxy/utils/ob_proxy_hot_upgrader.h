@@ -22,6 +22,8 @@ namespace obproxy
 {
 #define OBPROXY_INHERITED_IPV4_FD "OBPROXY_INHERITED_FD"
 #define OBPROXY_INHERITED_IPV6_FD "OBPROXY_INHERITED_IPV6_FD"
+#define OBPROXY_INHERITED_REUSEPORT_IPV4_FDS "OBPROXY_INHERITED_REUSEPORT_FDS"
+#define OBPROXY_INHERITED_REUSEPORT_IPV6_FDS "OBPROXY_INHERITED_REUSEPORT_IPV6_FDS"
 extern volatile int g_proxy_fatal_errcode;
 
 enum ObReloadConfigStatus
@@ -170,6 +172,17 @@ public:
   void reset_sub_pid() { sub_pid_ = common::OB_INVALID_INDEX; };
   int fill_inherited_info(const bool is_server_service_mode, const int64_t upgrade_version);
 
+  // the extra SO_REUSEPORT listen fds of the per net thread acceptors, the first
+  // listen fd of each family is still ipv4_fd_/ipv6_fd_
+  int add_reuseport_fd(const bool is_ipv6, const int fd);
+  int get_reuseport_fd(const bool is_ipv6, const int64_t idx) const;
+  int64_t get_reuseport_fd_count(const bool is_ipv6) const { return reuseport_fd_count_[is_ipv6 ? 1 : 0]; }
+  bool is_reuseport_fd(const int fd) const;
+  // "name=fd,fd,..." which is used to pass the fds to sub process
+  int get_reuseport_envp(const bool is_ipv6, char *buf, const int64_t buf_len) const;
+  // called before log is initialized, can't print log
+  int parse_reuseport_fds(const bool is_ipv6, const char *fds_str);
+
   bool is_auto_upgrade() const { return HUC_AUTO_UPGRADE == cmd_; };
   bool is_hot_upgrade() const { return HUC_HOT_UPGRADE == cmd_; };
   bool is_restart() const { return HUC_RESTART == cmd_ || HUC_LOCAL_RESTART == cmd_; };
@@ -196,9 +209,13 @@ public:
   static const int64_t MAX_UPGRADE_VERSION_BUF_SIZE = 64;
   static const int64_t MAX_RESTART_BUF_SIZE = 64;
   static const int64_t OB_MAX_INHERITED_ARGC = 4;
+  static const int64_t MAX_REUSEPORT_FD_COUNT = 256;
+  static const int64_t MAX_REUSEPORT_ENVP_SIZE = 4096;
 
   int ipv4_fd_;                              // listen fd, which to be passed to sub process
   int ipv6_fd_;
+  int64_t reuseport_fd_count_[2];            // [0] for ipv4, [1] for ipv6
+  int reuseport_fds_[2][MAX_REUSEPORT_FD_COUNT];
   int received_sig_;
   ObReloadConfigStatus rc_status_;      // identify the current status for reload config
   volatile pid_t sub_pid_;              // sub process pid if fork succeed
@@ -23,6 +23,9 @@ namespace common
 ObPartDescList::ObPartDescList() : part_array_ (NULL)
                                    , part_array_size_(0)
                                    , default_part_array_idx_(OB_INVALID_INDEX)
+                                   , index_nodes_(NULL)
+                                   , index_bucket_count_(0)
+                                   , index_cast_row_(NULL)
 {
 }
 
@@ -37,7 +40,8 @@ int64_t ObPartDescList::to_string(char *buf, const int64_t buf_len) const
   J_OBJ_START();
 
   J_KV("part_type", "list",
-       K_(part_array_size));
+       K_(part_array_size),
+       K_(index_bucket_count));
   J_OBJ_END();
   return pos;
 }
@@ -64,8 +68,20 @@ int ObPartDescList::get_part(ObNewRange &range,
   } else {
     bool found = false;
     bool casted = false;
+    bool index_probed = false;
+    int64_t part_array_idx = OB_INVALID_INDEX;
+    if (NULL != index_nodes_) {
+      // all the values are of one type, cast src_row once and probe the index
+      if (OB_FAIL(cast_row(src_row, *index_cast_row_, allocator, ctx))) {
+        COMMON_LOG(DEBUG, "fail to cast row for index, compare with every row", K(src_row), K(ret));
+        ret = OB_SUCCESS;
+      } else {
+        index_probed = true;
+        found = lookup_index(src_row, part_array_idx);
+      }
+    }
     // cast src_row and compare with part array
-    for (int64_t i = 0; i < part_array_size_ && !found; i++) {
+    for (int64_t i = 0; !index_probed && i < part_array_size_ && !found; i++) {
       if (i == default_part_array_idx_) {
         continue;
       }
@@ -84,17 +100,19 @@ int ObPartDescList::get_part(ObNewRange &range,
           // if casted, then compare
           if (casted && src_row == part_array_[i].rows_.at(j)) {
             found = true;
-            if (OB_FAIL(part_ids.push_back(part_array_[i].part_id_))) {
-              COMMON_LOG(WARN, "fail to push part id", K(ret));
-            } else if (NULL != tablet_id_array_ && OB_FAIL(tablet_ids.push_back(tablet_id_array_[i]))) {
-              COMMON_LOG(WARN, "fail to push tablet id", K(ret));
-            }
+            part_array_idx = i;
           } else {}
         }
       } // end for rows
     } // end for part_array
 
-    if (!found && OB_INVALID_INDEX != default_part_array_idx_) {
+    if (found) {
+      if (OB_FAIL(part_ids.push_back(part_array_[part_array_idx].part_id_))) {
+        COMMON_LOG(WARN, "fail to push part id", K(ret));
+      } else if (NULL != tablet_id_array_ && OB_FAIL(tablet_ids.push_back(tablet_id_array_[part_array_idx]))) {
+        COMMON_LOG(WARN, "fail to push tablet id", K(ret));
+      }
+    } else if (OB_INVALID_INDEX != default_part_array_idx_) {
       // if no row matches, use default partition
       COMMON_LOG(DEBUG, "will use default partition id", K(src_row), K(ret));
       if (OB_FAIL(part_ids.push_back(part_array_[default_part_array_idx_].part_id_))) {
@@ -146,5 +164,146 @@ int ObPartDescList::cast_row(ObNewRow &src_row,
   return ret;
 }
 
+bool ObPartDescList::is_indexable(const ObNewRow &row) const
+{
+  bool bret = (NULL != index_cast_row_ && row.get_count() == index_cast_row_->get_count());
+  for (int64_t i = 0; bret && i < row.get_count(); ++i) {
+    const ObObj &cell = row.get_cell(i);
+    const ObObj &cast_cell = index_cast_row_->get_cell(i);
+    if (cell.is_null()) {
+      // null is equal to null only, whatever the type
+    } else {
+      // float and double are left out, 0.0 and -0.0 are equal but hashed differently
+      switch (cell.get_type_class()) {
+        case ObIntTC:
+        case ObUIntTC:
+        case ObNumberTC:
+        case ObDateTimeTC:
+        case ObDateTC:
+        case ObTimeTC:
+        case ObYearTC:
+        case ObStringTC:
+          // the hash of one type is consistent with its comparison
+          bret = (cell.get_type() == cast_cell.get_type()
+                  && cell.get_collation_type() == cast_cell.get_collation_type());
+          break;
+        default:
+          bret = false;
+          break;
+      }
+    }
+  }
+  return bret;
+}
+
+uint64_t ObPartDescList::hash_row(const ObNewRow &row)
+{
+  uint64_t hash = 0;
+  for (int64_t i = 0; i < row.get_count(); ++i) {
+    hash = row.get_cell(i).hash(hash);
+  }
+  return hash;
+}
+
+int ObPartDescList::build_index(ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_count = 0;
+  bool indexable = true;
+  index_nodes_ = NULL;
+  index_bucket_count_ = 0;
+  index_cast_row_ = NULL;
+  if (OB_ISNULL(part_array_) || part_array_size_ <= 0) {
+    indexable = false;
+  } else {
+    // the first row without null is the type of every value
+    for (int64_t i = 0; i < part_array_size_; ++i) {
+      if (i != default_part_array_idx_) {
+        for (int64_t j = 0; j < part_array_[i].rows_.count(); ++j) {
+          ObNewRow &row = part_array_[i].rows_.at(j);
+          bool has_null = (0 == row.get_count());
+          for (int64_t k = 0; !has_null && k < row.get_count(); ++k) {
+            has_null = row.get_cell(k).is_null();
+          }
+          if (NULL == index_cast_row_ && !has_null) {
+            index_cast_row_ = &row;
+          }
+          ++row_count;
+        }
+      }
+    }
+    for (int64_t i = 0; indexable && i < part_array_size_; ++i) {
+      if (i != default_part_array_idx_) {
+        for (int64_t j = 0; indexable && j < part_array_[i].rows_.count(); ++j) {
+          indexable = is_indexable(part_array_[i].rows_.at(j));
+        }
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && indexable && row_count > 0) {
+    int64_t bucket_count = 1;
+    void *buf = NULL;
+    while (bucket_count < row_count * INDEX_BUCKET_FACTOR) {
+      bucket_count <<= 1;
+    }
+    if (OB_ISNULL(buf = allocator.alloc(sizeof(ListPartIndexNode) * bucket_count))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "fail to alloc list part index", K(bucket_count), K(ret));
+    } else {
+      ListPartIndexNode *nodes = static_cast<ListPartIndexNode *>(buf);
+      const int64_t mask = bucket_count - 1;
+      for (int64_t i = 0; i < bucket_count; ++i) {
+        nodes[i].hash_ = 0;
+        nodes[i].part_array_idx_ = OB_INVALID_INDEX;
+        nodes[i].row_ = NULL;
+      }
+      for (int64_t i = 0; i < part_array_size_; ++i) {
+        if (i != default_part_array_idx_) {
+          for (int64_t j = 0; j < part_array_[i].rows_.count(); ++j) {
+            ObNewRow &row = part_array_[i].rows_.at(j);
+            const uint64_t hash = hash_row(row);
+            bool duplicated = false;
+            int64_t pos = static_cast<int64_t>(hash & mask);
+            for (; !duplicated && OB_INVALID_INDEX != nodes[pos].part_array_idx_; pos = (pos + 1) & mask) {
+              // keep the first one, as the comparison one by one does
+              duplicated = (hash == nodes[pos].hash_ && row == *nodes[pos].row_);
+            }
+            if (!duplicated) {
+              nodes[pos].hash_ = hash;
+              nodes[pos].part_array_idx_ = i;
+              nodes[pos].row_ = &row;
+            }
+          }
+        }
+      }
+      index_nodes_ = nodes;
+      index_bucket_count_ = bucket_count;
+    }
+  }
+
+  if (NULL == index_nodes_) {
+    index_cast_row_ = NULL;
+    COMMON_LOG(DEBUG, "list part index is not built", K(indexable), K(row_count), K(ret));
+  }
+  return ret;
+}
+
+bool ObPartDescList::lookup_index(ObNewRow &row, int64_t &part_array_idx) const
+{
+  bool found = false;
+  const uint64_t hash = hash_row(row);
+  const int64_t mask = index_bucket_count_ - 1;
+  for (int64_t pos = static_cast<int64_t>(hash & mask);
+       !found && OB_INVALID_INDEX != index_nodes_[pos].part_array_idx_;
+       pos = (pos + 1) & mask) {
+    if (hash == index_nodes_[pos].hash_ && row == *index_nodes_[pos].row_) {
+      found = true;
+      part_array_idx = index_nodes_[pos].part_array_idx_;
+    }
+  }
+  return found;
+}
+
 } // end of common
 } // end of oceanbase
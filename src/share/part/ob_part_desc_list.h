@@ -34,9 +34,19 @@ struct ListPartition
                K_(rows));
 };
 
+// one list value in the index of ObPartDescList
+struct ListPartIndexNode
+{
+  uint64_t hash_;
+  int64_t part_array_idx_; // OB_INVALID_INDEX if the bucket is empty
+  ObNewRow *row_;
+};
+
 class ObPartDescList : public ObPartDesc
 {
 public:
+  static const int64_t INDEX_BUCKET_FACTOR = 2;
+
   ObPartDescList();
   virtual ~ObPartDescList();
 
@@ -60,12 +70,26 @@ public:
                ObIAllocator &allocator,
                ObPartDescCtx &ctx);
 
+  // build a hash index from the list values to the part array, after set_part_array.
+  // the index is skipped if the values are not of one type, and get_part compares
+  // with every value as before.
+  int build_index(ObIAllocator &allocator);
+  bool has_index() const { return NULL != index_nodes_; }
+
   DECLARE_VIRTUAL_TO_STRING;
 
+private:
+  bool is_indexable(const ObNewRow &row) const;
+  static uint64_t hash_row(const ObNewRow &row);
+  bool lookup_index(ObNewRow &row, int64_t &part_array_idx) const;
+
 private:
   ListPartition *part_array_;
   int64_t part_array_size_;
   int64_t default_part_array_idx_;
+  ListPartIndexNode *index_nodes_;
+  int64_t index_bucket_count_; // power of 2
+  ObNewRow *index_cast_row_; // the row src row is casted to before lookup
 };
 
 } // end common
@@ -10,8 +10,8 @@
  * See the Mulan PubL v2 for more details.
  */
 
-#ifndef OBPROXY_PARSER_UTILS_H
-#define OBPROXY_PARSER_UTILS_H
+#ifndef OBPROXY_SESSION_VARS_TEST_UTILS_H
+#define OBPROXY_SESSION_VARS_TEST_UTILS_H
 #include "lib/ob_define.h"
 
 namespace oceanbase
@@ -32,6 +32,6 @@ public:
 
 }
 }
-#endif // OBPROXY_PARSER_UTILS_H
+#endif // OBPROXY_SESSION_VARS_TEST_UTILS_H
 
 
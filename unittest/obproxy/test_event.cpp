@@ -360,7 +360,7 @@ TEST_F(TestEvent, ObEvent_null_init_free)
     ASSERT_TRUE(NULL == event->ethread_);
     ASSERT_FALSE(event->in_the_prot_queue_);
     ASSERT_FALSE(event->in_the_priority_queue_);
-    ASSERT_FALSE(event->in_heap_);
+    ASSERT_FALSE(event->wheel_entry_.is_scheduled());
     ASSERT_TRUE(EVENT_NONE == event->callback_event_);
     ASSERT_TRUE(0 == event->timeout_at_);
     ASSERT_TRUE(0 == event->period_);
@@ -678,6 +678,100 @@ TEST_F(TestIOBuffer, test_OBMIOBufferReader_replace)
   buffer_ptr_ = NULL;
 }
 
+void *free_buf_in_other_thread(void *arg)
+{
+  void **bufs = static_cast<void **>(arg);
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    op_fixed_mem_free(bufs[i], BUFFER_SIZE_FOR_INDEX(i));
+  }
+  int64_t hit_count = 0;
+  int64_t miss_count = 0;
+  int64_t cached_bytes = 0;
+  get_thread_iobuffer_cache_stat(hit_count, miss_count, cached_bytes);
+  return reinterpret_cast<void *>(cached_bytes);
+}
+
+TEST_F(TestIOBuffer, test_thread_buf_freelist)
+{
+  void *bufs[BUFFER_SIZE_INDEX_COUNT];
+  void *buf = NULL;
+  int64_t hit_count = 0;
+  int64_t miss_count = 0;
+  int64_t cached_bytes = 0;
+  int64_t last_hit_count = 0;
+
+  // every size class, including the odd sizes, is cached by the thread
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    ASSERT_TRUE(NULL != (bufs[i] = op_fixed_mem_alloc(BUFFER_SIZE_FOR_INDEX(i) - 1)));
+  }
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    const int64_t allocated = get_buf_freelist(i).allocated_;
+    op_fixed_mem_free(bufs[i], BUFFER_SIZE_FOR_INDEX(i) - 1);
+    ASSERT_EQ(allocated + 1, get_buf_freelist(i).allocated_);
+  }
+  get_thread_iobuffer_cache_stat(last_hit_count, miss_count, cached_bytes);
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    ASSERT_EQ(bufs[i], (buf = op_fixed_mem_alloc(BUFFER_SIZE_FOR_INDEX(i))));
+    bufs[i] = buf;
+  }
+  get_thread_iobuffer_cache_stat(hit_count, miss_count, cached_bytes);
+  ASSERT_EQ(last_hit_count + BUFFER_SIZE_INDEX_COUNT, hit_count);
+
+  // freed by another thread, kept by that thread
+  pthread_t tid;
+  void *other_cached_bytes = NULL;
+  int64_t expect_bytes = 0;
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    expect_bytes += BUFFER_SIZE_FOR_INDEX(i);
+  }
+  const int64_t before_bytes = cached_bytes;
+  ASSERT_EQ(0, pthread_create(&tid, NULL, free_buf_in_other_thread, bufs));
+  ASSERT_EQ(0, pthread_join(tid, &other_cached_bytes));
+  ASSERT_EQ(expect_bytes, reinterpret_cast<int64_t>(other_cached_bytes));
+  get_thread_iobuffer_cache_stat(hit_count, miss_count, cached_bytes);
+  ASSERT_EQ(before_bytes, cached_bytes);
+
+  // beyond the high watermark, go back to the global allocator in batch
+  const int64_t high_watermark = ObBufAllocator::get_buf_allocator().get_high_watermark(BUFFER_SIZE_INDEX_512);
+  const int64_t count = high_watermark + 1;
+  void **batch = new void *[count];
+  for (int64_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(NULL != (batch[i] = op_fixed_mem_alloc(DEFAULT_SMALL_BUFFER_SIZE)));
+  }
+  ObProxyThreadAllocator &freelist = get_buf_freelist(BUFFER_SIZE_INDEX_512);
+  ASSERT_EQ(0, freelist.allocated_);
+  for (int64_t i = 0; i < count; ++i) {
+    op_fixed_mem_free(batch[i], DEFAULT_SMALL_BUFFER_SIZE);
+    ASSERT_LE(freelist.allocated_, high_watermark);
+  }
+  ASSERT_EQ(high_watermark / 2, freelist.allocated_);
+  delete []batch;
+}
+
+TEST_F(TestIOBuffer, test_thread_buf_cache_size)
+{
+  ObBufAllocator &allocator = ObBufAllocator::get_buf_allocator();
+  // the same bytes of every class, the small classes are bounded by the chunk count
+  allocator.set_thread_cache_size(DEFAULT_THREAD_BUF_CACHE_SIZE);
+  ASSERT_EQ(g_thread_freelist_high_watermark, allocator.get_high_watermark(BUFFER_SIZE_INDEX_128));
+  ASSERT_EQ(g_thread_freelist_high_watermark, allocator.get_high_watermark(BUFFER_SIZE_INDEX_1K));
+  ASSERT_EQ(DEFAULT_THREAD_BUF_CACHE_SIZE / DEFAULT_LARGE_BUFFER_SIZE,
+            allocator.get_high_watermark(BUFFER_SIZE_INDEX_8K));
+
+  allocator.set_thread_cache_size(64 * 1024);
+  ASSERT_EQ(8, allocator.get_high_watermark(BUFFER_SIZE_INDEX_8K));
+  ASSERT_EQ(128, allocator.get_high_watermark(BUFFER_SIZE_INDEX_512));
+
+  // nothing is kept by the thread
+  allocator.set_thread_cache_size(0);
+  ObProxyThreadAllocator &freelist = get_buf_freelist(BUFFER_SIZE_INDEX_8K);
+  void *buf = NULL;
+  ASSERT_TRUE(NULL != (buf = op_fixed_mem_alloc(DEFAULT_LARGE_BUFFER_SIZE)));
+  op_fixed_mem_free(buf, DEFAULT_LARGE_BUFFER_SIZE);
+  ASSERT_EQ(0, freelist.allocated_);
+  allocator.set_thread_cache_size(DEFAULT_THREAD_BUF_CACHE_SIZE);
+}
+
 } // end of namespace obproxy
 } // end of namespace oceanbase
 
@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <vector>
+#define private public
+#define protected public
+#include "lib/time/ob_time_utility.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "obutils/ob_mt_hashtable.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace obutils;
+
+static const int64_t TEST_KEY_COUNT = 8192;
+static const int64_t TEST_MAX_THREAD_COUNT = 64;
+static const int64_t TEST_ALIVE_MAGIC = 0x414c495645;
+static const int64_t TEST_DEAD_MAGIC = 0x44454144;
+
+// released values are only marked dead and kept until the test ends,
+// so a reader which got a released value can see it
+struct TestValue
+{
+  TestValue(const int64_t key) : key_(key), ref_count_(1), magic_(TEST_ALIVE_MAGIC), expired_(false) {}
+
+  void inc_ref() { (void)ATOMIC_FAA(&ref_count_, 1); }
+  void dec_ref()
+  {
+    if (1 == ATOMIC_FAA(&ref_count_, -1)) {
+      ATOMIC_STORE(&magic_, TEST_DEAD_MAGIC);
+    }
+  }
+
+  int64_t key_;
+  volatile int64_t ref_count_;
+  volatile int64_t magic_;
+  bool expired_;
+};
+
+typedef ObMTHashTable<int64_t, TestValue *> TestHashTable;
+
+static bool gc_test_value(TestValue *value)
+{
+  bool expired = false;
+  if (value->expired_) {
+    expired = true;
+    value->dec_ref();
+  }
+  return expired;
+}
+
+static uint64_t hash_key(const int64_t key)
+{
+  return murmurhash(&key, sizeof(key), 0);
+}
+
+class TestMTHashTable : public ::testing::Test
+{
+public:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  TestValue *new_value(const int64_t key);
+  // replace a value, remove it or add it back, under the partition lock as the caches do
+  void update(const int64_t key, const int64_t op);
+  int64_t run(const int64_t thread_count, const bool lock_free, const bool with_writer);
+
+  static void *reader_thread(void *arg);
+  static void *writer_thread(void *arg);
+
+public:
+  TestHashTable table_;
+  ObSpinLock locks_[MT_HASHTABLE_PARTITIONS];
+  ObSpinLock values_lock_;
+  std::vector<TestValue *> values_;
+  int64_t loop_count_;
+  bool lock_free_;
+  volatile bool stop_;
+  volatile int64_t error_count_;
+};
+
+void TestMTHashTable::SetUp()
+{
+  loop_count_ = 0;
+  lock_free_ = true;
+  stop_ = false;
+  error_count_ = 0;
+  ASSERT_EQ(OB_SUCCESS, table_.init(4, event::COMMON_LOCK, gc_test_value));
+  TestValue *old_value = NULL;
+  for (int64_t key = 0; key < TEST_KEY_COUNT; ++key) {
+    ASSERT_EQ(OB_SUCCESS, table_.insert_entry(hash_key(key), key, new_value(key), old_value));
+    ASSERT_TRUE(NULL == old_value);
+  }
+}
+
+void TestMTHashTable::TearDown()
+{
+  for (int64_t i = 0; i < static_cast<int64_t>(values_.size()); ++i) {
+    delete values_[i];
+  }
+  values_.clear();
+}
+
+TestValue *TestMTHashTable::new_value(const int64_t key)
+{
+  TestValue *value = new TestValue(key);
+  ObSpinLockGuard guard(values_lock_);
+  values_.push_back(value);
+  return value;
+}
+
+void TestMTHashTable::update(const int64_t key, const int64_t op)
+{
+  const uint64_t hash = hash_key(key);
+  TestValue *old_value = NULL;
+  ObSpinLockGuard guard(locks_[table_.part_num(hash)]);
+  switch (op % 4) {
+    case 0:
+      old_value = table_.remove_entry(hash, key);
+      break;
+    case 1:
+      // expired values are removed by the gc of a later insert
+      old_value = table_.lookup_entry(hash, key);
+      if (NULL != old_value) {
+        old_value->expired_ = true;
+        old_value = NULL;
+      }
+      break;
+    default:
+      if (OB_SUCCESS != table_.insert_entry(hash, key, new_value(key), old_value)) {
+        (void)ATOMIC_FAA(&error_count_, 1);
+      }
+      break;
+  }
+  if (NULL != old_value) {
+    old_value->dec_ref();
+  }
+}
+
+void *TestMTHashTable::reader_thread(void *arg)
+{
+  TestMTHashTable *test = static_cast<TestMTHashTable *>(arg);
+  int64_t key = reinterpret_cast<int64_t>(&key) % TEST_KEY_COUNT;
+  uint64_t hash = 0;
+  TestValue *value = NULL;
+  for (int64_t i = 0; i < test->loop_count_; ++i) {
+    key = (key * 1103515245 + 12345) % TEST_KEY_COUNT;
+    hash = hash_key(key);
+    if (test->lock_free_) {
+      value = test->table_.acquire_entry(hash, key);
+    } else {
+      ObSpinLockGuard guard(test->locks_[test->table_.part_num(hash)]);
+      if (NULL != (value = test->table_.lookup_entry(hash, key))) {
+        value->inc_ref();
+      }
+    }
+    if (NULL != value) {
+      if (TEST_ALIVE_MAGIC != ATOMIC_LOAD(&value->magic_) || key != value->key_) {
+        (void)ATOMIC_FAA(&test->error_count_, 1);
+      }
+      value->dec_ref();
+    }
+  }
+  return NULL;
+}
+
+void *TestMTHashTable::writer_thread(void *arg)
+{
+  TestMTHashTable *test = static_cast<TestMTHashTable *>(arg);
+  for (int64_t op = 0; !test->stop_; ++op) {
+    test->update((op * 7919) % TEST_KEY_COUNT, op);
+    ::usleep(10);
+  }
+  return NULL;
+}
+
+// return the lookups per second
+int64_t TestMTHashTable::run(const int64_t thread_count, const bool lock_free, const bool with_writer)
+{
+  pthread_t readers[TEST_MAX_THREAD_COUNT];
+  pthread_t writer;
+  lock_free_ = lock_free;
+  stop_ = false;
+  if (with_writer) {
+    EXPECT_EQ(0, pthread_create(&writer, NULL, writer_thread, this));
+  }
+  const int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < thread_count; ++i) {
+    EXPECT_EQ(0, pthread_create(&readers[i], NULL, reader_thread, this));
+  }
+  for (int64_t i = 0; i < thread_count; ++i) {
+    pthread_join(readers[i], NULL);
+  }
+  const int64_t cost_us = std::max(ObTimeUtility::current_time() - start_time, 1L);
+  stop_ = true;
+  if (with_writer) {
+    pthread_join(writer, NULL);
+  }
+  return thread_count * loop_count_ * 1000000 / cost_us;
+}
+
+TEST_F(TestMTHashTable, test_lock_free_lookup)
+{
+  loop_count_ = 200000;
+  run(8, true, true);
+  ASSERT_EQ(0, error_count_);
+
+  // every key is still found after the updates and the resizes
+  for (int64_t key = 0; key < TEST_KEY_COUNT; ++key) {
+    update(key, 2);
+  }
+  for (int64_t key = 0; key < TEST_KEY_COUNT; ++key) {
+    TestValue *value = table_.acquire_entry(hash_key(key), key);
+    ASSERT_TRUE(NULL != value);
+    ASSERT_EQ(key, value->key_);
+    ASSERT_EQ(TEST_ALIVE_MAGIC, value->magic_);
+    value->dec_ref();
+  }
+  ASSERT_TRUE(table_.hash_tables_[0]->get_bucket_num() > 4);
+}
+
+TEST_F(TestMTHashTable, test_retire_without_waiting)
+{
+  const int64_t key = 1;
+  const uint64_t hash = hash_key(key);
+  TestValue *value = NULL;
+  TestValue *old_value = NULL;
+  {
+    // the writer must not wait for the reader in its critical section
+    QClockGuard guard;
+    value = table_.lookup_entry(hash, key);
+    ASSERT_TRUE(NULL != value);
+    old_value = table_.remove_entry(hash, key);
+    ASSERT_EQ(value, old_value);
+    old_value->dec_ref();
+    // the retired entry still holds the value
+    ASSERT_EQ(TEST_ALIVE_MAGIC, value->magic_);
+    ASSERT_TRUE(NULL == table_.lookup_entry(hash, key));
+  }
+
+  // the next writer reclaims it once the reader has gone
+  ASSERT_EQ(OB_SUCCESS, table_.insert_entry(hash, key, new_value(key), old_value));
+  ASSERT_TRUE(NULL == old_value);
+  ASSERT_EQ(TEST_DEAD_MAGIC, value->magic_);
+}
+
+TEST_F(TestMTHashTable, test_lookup_benchmark)
+{
+  loop_count_ = 200000;
+  const int64_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+  for (int64_t i = 0; i < static_cast<int64_t>(ARRAYSIZEOF(thread_counts)); ++i) {
+    const int64_t lock_free_qps = run(thread_counts[i], true, true);
+    const int64_t locked_qps = run(thread_counts[i], false, true);
+    LOG_INFO("mt hashtable lookup benchmark", "thread count", thread_counts[i],
+             "cpu count", sysconf(_SC_NPROCESSORS_ONLN), K(lock_free_qps), K(locked_qps));
+    printf("%ld threads, lock free %ld lookups/s, partition lock %ld lookups/s\n",
+           thread_counts[i], lock_free_qps, locked_qps);
+  }
+  ASSERT_EQ(0, error_count_);
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include "lib/ob_define.h"
+#include "lib/time/ob_time_utility.h"
+#include "rpc/obmysql/ob_mysql_util.h"
+#include "obproxy/proxy/mysqllib/ob_mysql_resp_analyzer.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+
+// mysql> select a, b from t2; column count, two column definitions and the first eof
+static const char *RESULTSET_HEAD_HEX = "0100000102200000020364656604746573740274320"
+                                        "27432016101610c3f000b0000000303500000002000"
+                                        "0003036465660474657374027432027432016201620"
+                                        "c3f000b00000003000000000005000004fe00002200";
+static const char EOF_PAYLOAD[] = {(char)0xfe, 0x00, 0x00, 0x22, 0x00};
+static const char OK_PAYLOAD[] = {0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00};
+static const char ERR_PAYLOAD[] = {(char)0xff, 0x2a, 0x04, 0x23, 0x48, 0x59, 0x30, 0x30, 0x30, 0x65, 0x72, 0x72};
+
+class TestMysqlRespAnalyzer : public ::testing::Test
+{
+public:
+  virtual void SetUp() { buf_ = new char[BUF_SIZE]; len_ = 0; seq_ = 0; }
+  virtual void TearDown() { delete []buf_; }
+
+  void append_pkt(const char *payload, const int64_t len);
+  void append_head();
+  // rows of row_len bytes, the first column of which is
+  // a string, NULL, empty, a string of 2 or 8 bytes length in turn
+  void append_rows(const int64_t row_cnt, const int64_t row_len);
+  void append_tail(const bool is_error, const ObMysqlProtocolMode mode);
+  void check_row_walk(const ObMysqlProtocolMode mode, const ObMySQLCmd cmd, const int64_t block_size);
+  int64_t analyze(const bool enable_row_walk, const int64_t block_size, const int64_t loop_cnt);
+
+public:
+  static const int64_t BUF_SIZE = 32 * 1024 * 1024;
+  char *buf_;
+  int64_t len_;
+  uint8_t seq_;
+};
+
+void TestMysqlRespAnalyzer::append_pkt(const char *payload, const int64_t len)
+{
+  ASSERT_TRUE(len_ + MYSQL_NET_HEADER_LENGTH + len <= BUF_SIZE);
+  int3store(buf_ + len_, len);
+  buf_[len_ + 3] = static_cast<char>(seq_++);
+  MEMCPY(buf_ + len_ + MYSQL_NET_HEADER_LENGTH, payload, len);
+  len_ += MYSQL_NET_HEADER_LENGTH + len;
+}
+
+void TestMysqlRespAnalyzer::append_head()
+{
+  const int64_t hex_len = strlen(RESULTSET_HEAD_HEX);
+  for (int64_t i = 0; i < hex_len / 2; i++) {
+    unsigned int value = 0;
+    char tmp[3] = {RESULTSET_HEAD_HEX[2 * i], RESULTSET_HEAD_HEX[2 * i + 1], '\0'};
+    sscanf(tmp, "%x", &value);
+    buf_[len_ + i] = static_cast<char>(value);
+  }
+  len_ += hex_len / 2;
+  seq_ = 5;
+}
+
+void TestMysqlRespAnalyzer::append_rows(const int64_t row_cnt, const int64_t row_len)
+{
+  char row[1024];
+  MEMSET(row, 'x', sizeof(row));
+  for (int64_t i = 0; i < row_cnt; i++) {
+    int64_t len = row_len;
+    switch (i % 5) {
+      case 0:
+        row[0] = static_cast<char>(row_len - 1);
+        break;
+      case 1:
+        row[0] = static_cast<char>(0xfb);
+        row[1] = static_cast<char>(row_len - 2);
+        break;
+      case 2:
+        row[0] = 0x00;
+        row[1] = static_cast<char>(row_len - 2);
+        break;
+      case 3:
+        row[0] = static_cast<char>(0xfc);
+        int2store(row + 1, row_len - 3);
+        break;
+      case 4:
+        len = std::max(row_len, 9L);
+        row[0] = static_cast<char>(0xfe);
+        int8store(row + 1, len - 9);
+        break;
+    }
+    append_pkt(row, len);
+  }
+}
+
+void TestMysqlRespAnalyzer::append_tail(const bool is_error, const ObMysqlProtocolMode mode)
+{
+  if (is_error) {
+    append_pkt(ERR_PAYLOAD, sizeof(ERR_PAYLOAD));
+  } else {
+    append_pkt(EOF_PAYLOAD, sizeof(EOF_PAYLOAD));
+  }
+  if (OCEANBASE_MYSQL_PROTOCOL_MODE == mode) {
+    append_pkt(OK_PAYLOAD, sizeof(OK_PAYLOAD));
+  }
+}
+
+// feed buf_ in blocks of block_size to two analyzers, the one walks the rows and the
+// other reads every packet, they must agree after every block
+void TestMysqlRespAnalyzer::check_row_walk(const ObMysqlProtocolMode mode,
+                                          const ObMySQLCmd cmd,
+                                          const int64_t block_size)
+{
+  ObMysqlRespAnalyzer analyzer[2];
+  ObRespResult result[2];
+  bool finished[2] = {false, false};
+  ObMysqlRespEndingType ending_type[2] = {MAX_PACKET_ENDING_TYPE, MAX_PACKET_ENDING_TYPE};
+  for (int64_t i = 0; i < 2; i++) {
+    analyzer[i].set_mysql_mode(mode);
+    analyzer[i].set_enable_row_walk(0 == i);
+    result[i].set_cmd(cmd);
+    result[i].set_mysql_mode(mode);
+  }
+
+  for (int64_t pos = 0; pos < len_; pos += block_size) {
+    ObRespBuffer block(std::min(block_size, len_ - pos), buf_ + pos);
+    for (int64_t i = 0; i < 2; i++) {
+      ObBufferReader buf_reader(block);
+      ASSERT_EQ(OB_SUCCESS, analyzer[i].analyze_mysql_resp(buf_reader, result[i], NULL));
+      ASSERT_TRUE(buf_reader.empty());
+      ASSERT_EQ(OB_SUCCESS, result[i].is_resp_finished(finished[i], ending_type[i]));
+    }
+    ASSERT_EQ(finished[1], finished[0]);
+    ASSERT_EQ(ending_type[1], ending_type[0]);
+    ASSERT_EQ(analyzer[1].need_wait_more_data(), analyzer[0].need_wait_more_data());
+    ASSERT_EQ(result[1].get_reserved_len(), result[0].get_reserved_len());
+    ASSERT_EQ(result[1].get_all_pkt_cnt(), result[0].get_all_pkt_cnt());
+    ASSERT_EQ(result[1].get_trans_state(), result[0].get_trans_state());
+    ASSERT_EQ(result[1].get_resp_type(), result[0].get_resp_type());
+    for (int64_t type = 0; type < OB_MYSQL_RESP_ENDING_TYPE_COUNT; type++) {
+      ASSERT_EQ(result[1].get_pkt_cnt(static_cast<ObMysqlRespEndingType>(type)),
+                result[0].get_pkt_cnt(static_cast<ObMysqlRespEndingType>(type)));
+    }
+  }
+  ASSERT_TRUE(finished[0]);
+}
+
+int64_t TestMysqlRespAnalyzer::analyze(const bool enable_row_walk,
+                                       const int64_t block_size,
+                                       const int64_t loop_cnt)
+{
+  int64_t start_time = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < loop_cnt; loop++) {
+    ObMysqlRespAnalyzer analyzer;
+    ObRespResult result;
+    analyzer.set_mysql_mode(OCEANBASE_MYSQL_PROTOCOL_MODE);
+    analyzer.set_enable_row_walk(enable_row_walk);
+    result.set_cmd(OB_MYSQL_COM_QUERY);
+    result.set_mysql_mode(OCEANBASE_MYSQL_PROTOCOL_MODE);
+    for (int64_t pos = 0; pos < len_; pos += block_size) {
+      ObBufferReader buf_reader(ObRespBuffer(std::min(block_size, len_ - pos), buf_ + pos));
+      EXPECT_EQ(OB_SUCCESS, analyzer.analyze_mysql_resp(buf_reader, result, NULL));
+    }
+  }
+  return ObTimeUtility::current_time() - start_time;
+}
+
+TEST_F(TestMysqlRespAnalyzer, test_row_walk)
+{
+  const int64_t block_sizes[] = {1, 3, 4, 5, 7, 13, 64, 333, 8192, INT32_MAX};
+  const ObMysqlProtocolMode modes[] = {STANDARD_MYSQL_PROTOCOL_MODE, OCEANBASE_MYSQL_PROTOCOL_MODE};
+  for (int64_t m = 0; m < 2; m++) {
+    for (int64_t is_error = 0; is_error < 2; is_error++) {
+      len_ = 0;
+      append_head();
+      append_rows(1000, 17);
+      append_tail(is_error, modes[m]);
+      for (int64_t i = 0; i < static_cast<int64_t>(ARRAYSIZEOF(block_sizes)); i++) {
+        check_row_walk(modes[m], OB_MYSQL_COM_QUERY, block_sizes[i]);
+        check_row_walk(modes[m], OB_MYSQL_COM_STMT_EXECUTE, block_sizes[i]);
+      }
+    }
+  }
+}
+
+TEST_F(TestMysqlRespAnalyzer, test_row_walk_empty_resultset)
+{
+  append_head();
+  append_tail(false, OCEANBASE_MYSQL_PROTOCOL_MODE);
+  check_row_walk(OCEANBASE_MYSQL_PROTOCOL_MODE, OB_MYSQL_COM_QUERY, INT32_MAX);
+  check_row_walk(OCEANBASE_MYSQL_PROTOCOL_MODE, OB_MYSQL_COM_QUERY, 1);
+}
+
+TEST_F(TestMysqlRespAnalyzer, test_row_walk_benchmark)
+{
+  const int64_t row_cnt = 1000000;
+  const int64_t block_size = 64 * 1024;
+  append_head();
+  append_rows(row_cnt, 20);
+  append_tail(false, OCEANBASE_MYSQL_PROTOCOL_MODE);
+
+  int64_t row_walk_time = analyze(true, block_size, 10);
+  int64_t state_machine_time = analyze(false, block_size, 10);
+  LOG_INFO("row walk benchmark", K(row_cnt), "resultset len", len_, K(block_size),
+           "row walk ns per row", row_walk_time * 1000 / (row_cnt * 10),
+           "state machine ns per row", state_machine_time * 1000 / (row_cnt * 10));
+  printf("%ld rows, %ld bytes, row walk: %ld ns/row, state machine: %ld ns/row\n",
+         row_cnt, len_, row_walk_time * 1000 / (row_cnt * 10),
+         state_machine_time * 1000 / (row_cnt * 10));
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "lib/allocator/page_arena.h"
+#include "lib/time/ob_time_utility.h"
+#include "share/part/ob_part_desc_list.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+
+static const int64_t VALUES_PER_PART = 2;
+
+class TestPartDescList : public ::testing::Test
+{
+public:
+  TestPartDescList() : allocator_(ObModIds::TEST) {}
+
+  // part i holds the values i * VALUES_PER_PART + [0, VALUES_PER_PART), the last part is the default one
+  void build_int_desc(ObPartDescList &desc, const int64_t part_num, const bool with_default)
+  {
+    void *buf = allocator_.alloc(sizeof(ListPartition) * part_num);
+    ASSERT_TRUE(NULL != buf);
+    ListPartition *part_array = new (buf) ListPartition[part_num];
+    for (int64_t i = 0; i < part_num; ++i) {
+      part_array[i].part_id_ = i;
+      if (with_default && i == part_num - 1) {
+        ObObj *obj = new (allocator_.alloc(sizeof(ObObj))) ObObj();
+        obj->set_max_value();
+        ObNewRow row;
+        row.assign(obj, 1);
+        ASSERT_EQ(OB_SUCCESS, part_array[i].rows_.push_back(row));
+        desc.set_default_part_array_idx(i);
+      } else {
+        for (int64_t j = 0; j < VALUES_PER_PART; ++j) {
+          ObObj *obj = new (allocator_.alloc(sizeof(ObObj))) ObObj();
+          obj->set_int(i * VALUES_PER_PART + j);
+          ObNewRow row;
+          row.assign(obj, 1);
+          ASSERT_EQ(OB_SUCCESS, part_array[i].rows_.push_back(row));
+        }
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, desc.set_part_array(part_array, part_num));
+    ASSERT_EQ(OB_SUCCESS, desc.get_accuracies().push_back(ObAccuracy()));
+  }
+
+  int get_part(ObPartDescList &desc, ObObj &value, int64_t &part_id)
+  {
+    int ret = OB_SUCCESS;
+    ObNewRange range;
+    ObSEArray<int64_t, 1> part_ids;
+    ObSEArray<int64_t, 1> tablet_ids;
+    ObPartDescCtx ctx;
+    range.start_key_.assign(&value, 1);
+    range.end_key_.assign(&value, 1);
+    part_id = -1;
+    if (OB_SUCC(desc.get_part(range, allocator_, part_ids, ctx, tablet_ids))) {
+      if (1 == part_ids.count()) {
+        part_id = part_ids.at(0);
+      } else {
+        ret = OB_ENTRY_NOT_EXIST;
+      }
+    }
+    return ret;
+  }
+
+public:
+  ObArenaAllocator allocator_;
+};
+
+TEST_F(TestPartDescList, test_index_lookup)
+{
+  const int64_t part_num = 100;
+  ObPartDescList desc;
+  build_int_desc(desc, part_num, true);
+  ASSERT_EQ(OB_SUCCESS, desc.build_index(allocator_));
+  ASSERT_TRUE(desc.has_index());
+
+  ObObj value;
+  int64_t part_id = -1;
+  for (int64_t i = 0; i < (part_num - 1) * VALUES_PER_PART; ++i) {
+    value.set_int(i);
+    ASSERT_EQ(OB_SUCCESS, get_part(desc, value, part_id));
+    ASSERT_EQ(i / VALUES_PER_PART, part_id);
+  }
+  // a value of another type is casted first
+  value.set_varchar("7");
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, get_part(desc, value, part_id));
+  ASSERT_EQ(3, part_id);
+  // the values in no part go to the default part
+  value.set_int(part_num * VALUES_PER_PART + 1);
+  ASSERT_EQ(OB_SUCCESS, get_part(desc, value, part_id));
+  ASSERT_EQ(part_num - 1, part_id);
+}
+
+TEST_F(TestPartDescList, test_same_as_scan)
+{
+  const int64_t part_num = 64;
+  ObPartDescList index_desc;
+  ObPartDescList scan_desc;
+  build_int_desc(index_desc, part_num, false);
+  build_int_desc(scan_desc, part_num, false);
+  ASSERT_EQ(OB_SUCCESS, index_desc.build_index(allocator_));
+  ASSERT_TRUE(index_desc.has_index());
+  ASSERT_FALSE(scan_desc.has_index());
+
+  ObObj value;
+  int64_t index_part_id = -1;
+  int64_t scan_part_id = -1;
+  for (int64_t i = -10; i < part_num * VALUES_PER_PART + 10; ++i) {
+    value.set_int(i);
+    const int index_ret = get_part(index_desc, value, index_part_id);
+    value.set_int(i);
+    const int scan_ret = get_part(scan_desc, value, scan_part_id);
+    ASSERT_EQ(scan_ret, index_ret);
+    ASSERT_EQ(scan_part_id, index_part_id);
+  }
+}
+
+TEST_F(TestPartDescList, test_mixed_type_not_indexed)
+{
+  ObPartDescList desc;
+  build_int_desc(desc, 10, false);
+  ListPartition *part_array = desc.get_part_array();
+  part_array[5].rows_.at(0).get_cell(0).set_double(10.0);
+  ASSERT_EQ(OB_SUCCESS, desc.build_index(allocator_));
+  ASSERT_FALSE(desc.has_index());
+
+  ObObj value;
+  int64_t part_id = -1;
+  value.set_int(3);
+  ASSERT_EQ(OB_SUCCESS, get_part(desc, value, part_id));
+  ASSERT_EQ(1, part_id);
+}
+
+TEST_F(TestPartDescList, test_lookup_performance)
+{
+  const int64_t lookup_count = 100000;
+  const int64_t part_nums[] = {10, 100, 1000, 10000, 100000};
+  for (int64_t n = 0; n < static_cast<int64_t>(sizeof(part_nums) / sizeof(part_nums[0])); ++n) {
+    const int64_t part_num = part_nums[n];
+    // the scan goes through every value, so it does fewer lookups with many parts
+    const int64_t scan_lookup_count = std::max(lookup_count * 10 / part_num, 10L);
+    ObPartDescList index_desc;
+    ObPartDescList scan_desc;
+    build_int_desc(index_desc, part_num, true);
+    build_int_desc(scan_desc, part_num, true);
+    ASSERT_EQ(OB_SUCCESS, index_desc.build_index(allocator_));
+
+    ObObj value;
+    int64_t part_id = -1;
+    const int64_t value_count = (part_num - 1) * VALUES_PER_PART;
+    int64_t start_us = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < lookup_count; ++i) {
+      value.set_int((i * 7919) % value_count);
+      ASSERT_EQ(OB_SUCCESS, get_part(index_desc, value, part_id));
+    }
+    const int64_t index_cost_us = ObTimeUtility::current_time() - start_us;
+
+    start_us = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < scan_lookup_count; ++i) {
+      value.set_int((i * 7919) % value_count);
+      ASSERT_EQ(OB_SUCCESS, get_part(scan_desc, value, part_id));
+    }
+    const int64_t scan_cost_us = ObTimeUtility::current_time() - start_us;
+    const double index_ns = static_cast<double>(index_cost_us) * 1000 / static_cast<double>(lookup_count);
+    const double scan_ns = static_cast<double>(scan_cost_us) * 1000 / static_cast<double>(scan_lookup_count);
+    printf("list parts %6ld: index %10.1fns/lookup, scan %12.1fns/lookup\n", part_num, index_ns, scan_ns);
+    allocator_.reset();
+  }
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_NET
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "iocore/net/ob_poll_descriptor.h"
+#include "iocore/net/ob_unix_net.h"
+#include "lib/time/ob_time_utility.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace event;
+using namespace net;
+
+static const int64_t BENCH_IDLE_CONN_COUNT = 10000;
+static const int64_t BENCH_HOT_CONN_COUNT = 64;
+static const int64_t BENCH_ROUND_COUNT = 20000;
+
+class TestPollDescriptor : public ::testing::Test
+{
+public:
+  virtual void SetUp();
+  virtual void TearDown();
+  int open_pairs(const int64_t count);
+  void check_basic(ObPollDescriptor &pd);
+  void run_benchmark(ObPollDescriptor &pd, const char *name);
+
+public:
+  int64_t pair_count_;
+  int (*pairs_)[2];
+};
+
+void TestPollDescriptor::SetUp()
+{
+  pair_count_ = 0;
+  pairs_ = NULL;
+}
+
+void TestPollDescriptor::TearDown()
+{
+  for (int64_t i = 0; i < pair_count_; ++i) {
+    ::close(pairs_[i][0]);
+    ::close(pairs_[i][1]);
+  }
+  delete []pairs_;
+  pairs_ = NULL;
+  pair_count_ = 0;
+}
+
+int TestPollDescriptor::open_pairs(const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  struct rlimit rl;
+  getrlimit(RLIMIT_NOFILE, &rl);
+  pair_count_ = std::min(count, static_cast<int64_t>(rl.rlim_cur - 64) / 2);
+  pairs_ = new int[pair_count_][2];
+  for (int64_t i = 0; i < pair_count_ && OB_SUCC(ret); ++i) {
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pairs_[i])) {
+      ret = OB_ERR_SYS;
+      pair_count_ = i;
+    }
+  }
+  return ret;
+}
+
+void TestPollDescriptor::check_basic(ObPollDescriptor &pd)
+{
+  char c = 'a';
+  ASSERT_EQ(OB_SUCCESS, open_pairs(2));
+  ASSERT_EQ(OB_SUCCESS, pd.add(pairs_[0][0], EPOLLIN | EPOLLET, &pairs_[0]));
+  ASSERT_EQ(OB_SUCCESS, pd.add(pairs_[1][0], EPOLLIN | EPOLLET, &pairs_[1]));
+
+  ASSERT_EQ(OB_SUCCESS, pd.wait(10));
+  ASSERT_EQ(0, pd.result_);
+
+  ASSERT_EQ(1, write(pairs_[1][1], &c, 1));
+  ASSERT_EQ(OB_SUCCESS, pd.wait(100));
+  ASSERT_EQ(1, pd.result_);
+  ASSERT_EQ(&pairs_[1], pd.epoll_triggered_events_[0].data.ptr);
+  ASSERT_TRUE(pd.epoll_triggered_events_[0].events & EPOLLIN);
+  ASSERT_FALSE(pd.need_rearm(0));
+
+  // pending event of a deleted fd must not be reported
+  ASSERT_EQ(1, write(pairs_[0][1], &c, 1));
+  ASSERT_EQ(OB_SUCCESS, pd.del(pairs_[0][0], &pairs_[0]));
+  ASSERT_EQ(OB_SUCCESS, pd.wait(10));
+  ASSERT_EQ(0, pd.result_);
+}
+
+// idle connections are registered but never fire, hot connections
+// ping-pong one byte per round, this is the typical OLTP shape
+void TestPollDescriptor::run_benchmark(ObPollDescriptor &pd, const char *name)
+{
+  char buf[16];
+  int64_t count = 0;
+  int64_t events = 0;
+  ASSERT_EQ(OB_SUCCESS, open_pairs(BENCH_IDLE_CONN_COUNT + BENCH_HOT_CONN_COUNT));
+  ASSERT_GT(pair_count_, BENCH_HOT_CONN_COUNT);
+  for (int64_t i = 0; i < pair_count_; ++i) {
+    ASSERT_EQ(OB_SUCCESS, pd.add(pairs_[i][0], EPOLLIN | EPOLLET, &pairs_[i]));
+  }
+
+  const int64_t start = ObTimeUtility::current_time();
+  for (int64_t round = 0; round < BENCH_ROUND_COUNT; ++round) {
+    for (int64_t i = 0; i < BENCH_HOT_CONN_COUNT; ++i) {
+      ASSERT_EQ(1, write(pairs_[i][1], buf, 1));
+    }
+    count = 0;
+    while (count < BENCH_HOT_CONN_COUNT) {
+      ASSERT_EQ(OB_SUCCESS, pd.wait(100));
+      ASSERT_GT(pd.result_, 0);
+      for (int64_t i = 0; i < pd.result_; ++i) {
+        int *pair = static_cast<int *>(pd.epoll_triggered_events_[i].data.ptr);
+        while (read(pair[0], buf, sizeof(buf)) > 0) {}
+      }
+      count += pd.result_;
+    }
+    events += count;
+  }
+  const int64_t cost = ObTimeUtility::current_time() - start;
+  printf("%s: idle=%ld hot=%ld rounds=%ld events=%ld cost=%ldus avg_round=%.2fus\n",
+         name, pair_count_ - BENCH_HOT_CONN_COUNT, BENCH_HOT_CONN_COUNT, BENCH_ROUND_COUNT,
+         events, cost, static_cast<double>(cost) / static_cast<double>(BENCH_ROUND_COUNT));
+}
+
+TEST_F(TestPollDescriptor, test_epoll_basic)
+{
+  ObPollDescriptor *pd = new ObPollDescriptor();
+  ASSERT_EQ(OB_SUCCESS, pd->init(false));
+  ASSERT_EQ(POLL_BACKEND_EPOLL, pd->get_backend());
+  check_basic(*pd);
+  delete pd;
+}
+
+TEST_F(TestPollDescriptor, test_io_uring_basic)
+{
+  ObPollDescriptor *pd = new ObPollDescriptor();
+  ASSERT_EQ(OB_SUCCESS, pd->init(true));
+  if (!pd->is_io_uring()) {
+    printf("io_uring not supported by kernel, fall back to epoll\n");
+  }
+  check_basic(*pd);
+  delete pd;
+}
+
+TEST_F(TestPollDescriptor, test_epoll_benchmark)
+{
+  ObPollDescriptor *pd = new ObPollDescriptor();
+  ASSERT_EQ(OB_SUCCESS, pd->init(false));
+  run_benchmark(*pd, "epoll");
+  delete pd;
+}
+
+TEST_F(TestPollDescriptor, test_io_uring_benchmark)
+{
+  ObPollDescriptor *pd = new ObPollDescriptor();
+  ASSERT_EQ(OB_SUCCESS, pd->init(true));
+  run_benchmark(*pd, pd->is_io_uring() ? "io_uring" : "epoll(fallback)");
+  delete pd;
+}
+
+TEST_F(TestPollDescriptor, test_busy_poll)
+{
+  char c = 'a';
+  const ObHRTime max_time = HRTIME_MSECONDS(2);
+  ObPollDescriptor *pd = new ObPollDescriptor();
+  ObNetHandler *nh = new ObNetHandler();
+  ObProtectedQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init());
+  ASSERT_EQ(OB_SUCCESS, pd->init(false));
+  ASSERT_EQ(OB_SUCCESS, open_pairs(1));
+  ASSERT_EQ(OB_SUCCESS, pd->add(pairs_[0][0], EPOLLIN | EPOLLET, &pairs_[0]));
+
+  // no budget, never spins
+  ASSERT_FALSE(nh->busy_poll(*pd, queue, max_time, HRTIME_SECONDS(1)));
+  ASSERT_EQ(0, nh->busy_poll_hit_count_ + nh->busy_poll_miss_count_);
+
+  // a sleep woken up in time turns it on, and doubles it up to max
+  nh->adapt_busy_poll(max_time, true);
+  ASSERT_EQ(max_time / ObNetHandler::BUSY_POLL_MIN_FRACTION, nh->busy_poll_time_);
+  for (int64_t i = 0; i < 8; ++i) {
+    nh->adapt_busy_poll(max_time, true);
+  }
+  ASSERT_EQ(max_time, nh->busy_poll_time_);
+
+  ASSERT_EQ(1, write(pairs_[0][1], &c, 1));
+  ASSERT_TRUE(nh->busy_poll(*pd, queue, max_time, HRTIME_SECONDS(1)));
+  ASSERT_EQ(1, pd->result_);
+  ASSERT_EQ(1, nh->busy_poll_hit_count_);
+  ASSERT_EQ(1, read(pairs_[0][0], &c, 1));
+
+  // nothing comes, the spin runs out and the budget halves
+  const int64_t start = ObTimeUtility::current_time();
+  ASSERT_FALSE(nh->busy_poll(*pd, queue, max_time, HRTIME_SECONDS(1)));
+  ASSERT_GE(ObTimeUtility::current_time() - start, hrtime_to_usec(max_time));
+  ASSERT_EQ(1, nh->busy_poll_miss_count_);
+  ASSERT_EQ(max_time / 2, nh->busy_poll_time_);
+
+  // a lower max takes effect at once, and keeps missing turns it off
+  ASSERT_FALSE(nh->busy_poll(*pd, queue, max_time / 4, HRTIME_SECONDS(1)));
+  ASSERT_EQ(max_time / 8, nh->busy_poll_time_);
+  for (int64_t i = 0; i < 4 && nh->busy_poll_time_ > 0; ++i) {
+    ASSERT_FALSE(nh->busy_poll(*pd, queue, max_time / 4, HRTIME_SECONDS(1)));
+  }
+  ASSERT_EQ(0, nh->busy_poll_time_);
+
+  delete nh;
+  delete pd;
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
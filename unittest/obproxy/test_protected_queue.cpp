@@ -76,6 +76,49 @@ int handle_flush_signals_continuation(ObContInternal *contp, ObEventType aevent,
     void* edata);
 void init_g_event_processor();
 
+static const int64_t BENCH_EVENT_COUNT = 256000;
+static const int64_t BENCH_MAX_PRODUCER_COUNT = 64;
+volatile int64_t g_wakeup_count = 0;
+
+int signal_hook_count(ObEThread &ethread)
+{
+  UNUSED(ethread);
+  ATOMIC_INC(&g_wakeup_count);
+  return OB_SUCCESS;
+}
+
+struct BenchParam
+{
+  ObProtectedQueue *queue_;
+  ObEvent **events_;
+  int64_t count_;
+};
+
+void *thread_bench_producer(void *data)
+{
+  BenchParam *param = static_cast<BenchParam *>(data);
+  for (int64_t i = 0; i < param->count_; ++i) {
+    param->queue_->enqueue(param->events_[i], true);
+  }
+  return NULL;
+}
+
+void *thread_bench_consumer(void *data)
+{
+  BenchParam *param = static_cast<BenchParam *>(data);
+  ObEvent *e = NULL;
+  int64_t consumed = 0;
+  while (consumed < param->count_) {
+    param->queue_->dequeue_timed(get_hrtime_internal() + HRTIME_MSECONDS(10), true);
+    while (NULL != (e = param->queue_->dequeue_local())) {
+      e->mutex_ = NULL;
+      op_reclaim_free(e);
+      ++consumed;
+    }
+  }
+  return NULL;
+}
+
 void TestProtectedQueue::SetUp()
 {
   test_param_ = NULL;
@@ -246,7 +289,7 @@ void TestProtectedQueue::check_enqueue_regular(ObEvent *event,
   ASSERT_TRUE(g_event_processor.all_event_threads_[g_event_processor.event_thread_count_ - 1]
       == inserting_thread);
   ASSERT_EQ(1, event->in_the_prot_queue_);
-  ASSERT_TRUE(g_signal_hook_success);
+  // signal_hook_ only runs when e_ethread is parked, see park_and_wakeup
 
   if (inserting_thread->ethreads_to_be_signalled_count_ < g_event_processor.event_thread_count_) {
     ASSERT_EQ(seq_no, inserting_thread->ethreads_to_be_signalled_count_);
@@ -761,6 +804,100 @@ TEST_F(TestProtectedQueue, dequeue_timed_sleep_empty_exception)
   ASSERT_TRUE(protected_queue_->local_queue_.empty());
 }
 
+TEST_F(TestProtectedQueue, park_and_wakeup)
+{
+  LOG_DEBUG("park and wakeup");
+  ObEThread owner;
+  owner.signal_hook_ = signal_hook_simple;
+  for (int64_t i = 0; i < 4; ++i) {
+    event_array_[i]->ethread_ = &owner;
+  }
+
+  // not parked, enqueue must not wake up the owner
+  g_signal_hook_success = false;
+  protected_queue_->enqueue(event_array_[0], true);
+  ASSERT_FALSE(g_signal_hook_success);
+  ASSERT_EQ(ObProtectedQueue::PARK_STATE_RUNNING, protected_queue_->park_state_);
+
+  // events pending, park must fail and leave the owner running
+  ASSERT_FALSE(protected_queue_->park(ObProtectedQueue::PARK_STATE_POLL_WAIT));
+  ASSERT_EQ(ObProtectedQueue::PARK_STATE_RUNNING, protected_queue_->park_state_);
+  protected_queue_->dequeue_timed(0, false);
+  ASSERT_TRUE(event_array_[0] == protected_queue_->dequeue_local());
+
+  // parked, only the first enqueue wakes up the owner
+  ASSERT_TRUE(protected_queue_->park(ObProtectedQueue::PARK_STATE_POLL_WAIT));
+  ASSERT_TRUE(protected_queue_->is_parked());
+  protected_queue_->enqueue(event_array_[1], true);
+  ASSERT_TRUE(g_signal_hook_success);
+  ASSERT_EQ(ObProtectedQueue::PARK_STATE_NOTIFIED, protected_queue_->park_state_);
+  ASSERT_FALSE(protected_queue_->is_parked());
+  g_signal_hook_success = false;
+  protected_queue_->enqueue(event_array_[2], true);
+  ASSERT_FALSE(g_signal_hook_success);
+
+  // drained but not unparked yet, still no wakeup needed
+  protected_queue_->dequeue_timed(0, false);
+  ASSERT_TRUE(event_array_[1] == protected_queue_->dequeue_local());
+  ASSERT_TRUE(event_array_[2] == protected_queue_->dequeue_local());
+  protected_queue_->enqueue(event_array_[3], true);
+  ASSERT_FALSE(g_signal_hook_success);
+
+  protected_queue_->unpark();
+  ASSERT_EQ(ObProtectedQueue::PARK_STATE_RUNNING, protected_queue_->park_state_);
+  protected_queue_->dequeue_timed(0, false);
+  ASSERT_TRUE(event_array_[3] == protected_queue_->dequeue_local());
+  ASSERT_TRUE(NULL == protected_queue_->dequeue_local());
+}
+
+// N producers enqueue to one consumer blocked in dequeue_timed(), the
+// wakeup count shows how many producers actually had to signal it
+TEST_F(TestProtectedQueue, enqueue_benchmark)
+{
+  ObEThread owner;
+  owner.signal_hook_ = signal_hook_count;
+  ObThreadId tids[BENCH_MAX_PRODUCER_COUNT];
+  BenchParam params[BENCH_MAX_PRODUCER_COUNT];
+  ObEvent **events = new ObEvent *[BENCH_EVENT_COUNT];
+
+  for (int64_t producer_count = 2; producer_count <= BENCH_MAX_PRODUCER_COUNT; producer_count *= 2) {
+    const int64_t per_producer = BENCH_EVENT_COUNT / producer_count;
+    const int64_t total = per_producer * producer_count;
+    for (int64_t i = 0; i < total; ++i) {
+      ASSERT_TRUE(NULL != (events[i] = op_reclaim_alloc(ObEvent)));
+      events[i]->ethread_ = &owner;
+    }
+    g_wakeup_count = 0;
+
+    BenchParam consumer_param;
+    consumer_param.queue_ = protected_queue_;
+    consumer_param.events_ = NULL;
+    consumer_param.count_ = total;
+    const ObHRTime start = get_hrtime_internal();
+    ObThreadId consumer = thread_create(thread_bench_consumer, &consumer_param, 0, 0);
+    ASSERT_GT(consumer, 0);
+    for (int64_t i = 0; i < producer_count; ++i) {
+      params[i].queue_ = protected_queue_;
+      params[i].events_ = events + i * per_producer;
+      params[i].count_ = per_producer;
+      tids[i] = thread_create(thread_bench_producer, &params[i], 0, 0);
+      ASSERT_GT(tids[i], 0);
+    }
+    for (int64_t i = 0; i < producer_count; ++i) {
+      thread_join(tids[i]);
+    }
+    thread_join(consumer);
+    const ObHRTime cost = get_hrtime_internal() - start;
+
+    ASSERT_TRUE(protected_queue_->atomic_list_.empty());
+    ASSERT_TRUE(protected_queue_->local_queue_.empty());
+    printf("producers=%ld events=%ld wakeups=%ld cost=%ldus throughput=%.0f events/s\n",
+           producer_count, total, g_wakeup_count, cost / HRTIME_USECOND,
+           static_cast<double>(total) * HRTIME_SECOND / static_cast<double>(cost));
+  }
+  delete []events;
+}
+
 } // end of namespace obproxy
 } // end of namespace oceanbase
 
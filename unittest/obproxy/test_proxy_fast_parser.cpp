@@ -0,0 +1,463 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "lib/allocator/page_arena.h"
+#include "lib/time/ob_time_utility.h"
+#include "opsql/parser/ob_proxy_parser.h"
+#include "opsql/parser/ob_proxy_fast_parser.h"
+#include "opsql/expr_parser/ob_expr_parser.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace opsql;
+
+static const int64_t TEST_SQL_BUF_SIZE = 4096;
+
+class TestProxyFastParser : public ::testing::Test
+{
+public:
+  TestProxyFastParser() : allocator_(ObModIds::TEST) {}
+  virtual void TearDown() { allocator_.reuse(); }
+  // the parser wants two trailing '\0'
+  ObString make_sql(const char *sql);
+  // the fast parser must give up, or give what the proxy parser gives
+  void check_result(const char *sql, bool &is_hit);
+  void check_hit(const char *sql);
+  void check_fallback(const char *sql);
+  void check_string(const char *sql, const char *name,
+                    const ObProxyParseString &expected, const ObProxyParseString &result);
+  void load_sql(const char *test_file, std::vector<std::string> &sql_array);
+  // where conditions kept by the fast parser, -1 if it falls back
+  int64_t get_where_cond_count(const char *sql, ObProxyParseResult &result);
+  // partition keys id(level one) and k(level two) of the table
+  void init_expr_result(const ObProxyParseResult &result, ObExprParseResult &expr_result);
+  // the expr result from the where conditions must be what the expr parser gives
+  void check_expr_result(const char *sql);
+
+public:
+  ObArenaAllocator allocator_;
+  char buf_[TEST_SQL_BUF_SIZE];
+};
+
+ObString TestProxyFastParser::make_sql(const char *sql)
+{
+  const int64_t len = strlen(sql);
+  MEMSET(buf_, 0, TEST_SQL_BUF_SIZE);
+  MEMCPY(buf_, sql, len);
+  return ObString(static_cast<int32_t>(len + 2), buf_);
+}
+
+void TestProxyFastParser::check_string(const char *sql, const char *name,
+                                       const ObProxyParseString &expected,
+                                       const ObProxyParseString &result)
+{
+  ASSERT_EQ(expected.str_len_, result.str_len_) << sql << " " << name;
+  if (expected.str_len_ > 0) {
+    ASSERT_EQ(expected.str_, result.str_) << sql << " " << name;
+    ASSERT_EQ(expected.end_ptr_, result.end_ptr_) << sql << " " << name;
+    ASSERT_EQ(expected.quote_type_, result.quote_type_) << sql << " " << name;
+  }
+}
+
+void TestProxyFastParser::check_result(const char *sql, bool &is_hit)
+{
+  ObProxyParseResult expected;
+  ObProxyParseResult result;
+  ObProxyParser parser(allocator_, NORMAL_PARSE_MODE);
+  ObProxyFastParser fast_parser;
+  const ObString sql_str = make_sql(sql);
+
+  ASSERT_EQ(OB_SUCCESS, parser.parse(sql_str, expected, CS_TYPE_UTF8MB4_GENERAL_CI)) << sql;
+  const int ret = fast_parser.parse(sql_str, NORMAL_PARSE_MODE, CS_TYPE_UTF8MB4_GENERAL_CI, result);
+  is_hit = (OB_SUCCESS == ret);
+  if (!is_hit) {
+    ASSERT_EQ(OB_NOT_SUPPORTED, ret) << sql;
+  } else {
+    ASSERT_EQ(expected.stmt_type_, result.stmt_type_) << sql;
+    ASSERT_EQ(expected.sub_stmt_type_, result.sub_stmt_type_) << sql;
+    ASSERT_EQ(expected.cur_stmt_type_, result.cur_stmt_type_) << sql;
+    ASSERT_EQ(expected.stmt_count_, result.stmt_count_) << sql;
+    ASSERT_EQ(expected.end_pos_, result.end_pos_) << sql;
+    ASSERT_EQ(expected.comment_begin_, result.comment_begin_) << sql;
+    ASSERT_EQ(expected.has_ignored_word_, result.has_ignored_word_) << sql;
+    ASSERT_EQ(expected.is_dual_request_, result.is_dual_request_) << sql;
+    ASSERT_EQ(expected.has_last_insert_id_, result.has_last_insert_id_) << sql;
+    ASSERT_EQ(expected.has_found_rows_, result.has_found_rows_) << sql;
+    ASSERT_EQ(expected.has_row_count_, result.has_row_count_) << sql;
+    ASSERT_EQ(expected.has_explain_, result.has_explain_) << sql;
+    ASSERT_EQ(expected.has_anonymous_block_, result.has_anonymous_block_) << sql;
+    ASSERT_EQ(expected.query_timeout_, result.query_timeout_) << sql;
+    ASSERT_EQ(expected.read_consistency_type_, result.read_consistency_type_) << sql;
+    ASSERT_EQ(expected.cmd_info_.err_type_, result.cmd_info_.err_type_) << sql;
+    check_string(sql, "db", expected.table_info_.database_name_, result.table_info_.database_name_);
+    check_string(sql, "table", expected.table_info_.table_name_, result.table_info_.table_name_);
+    check_string(sql, "alias", expected.table_info_.alias_name_, result.table_info_.alias_name_);
+    check_string(sql, "part", expected.part_name_, result.part_name_);
+
+    ASSERT_EQ(expected.set_parse_info_.node_count_, result.set_parse_info_.node_count_) << sql;
+    ObProxySetVarNode *expected_node = expected.set_parse_info_.head_;
+    ObProxySetVarNode *node = result.set_parse_info_.head_;
+    for (; NULL != expected_node && NULL != node; expected_node = expected_node->next_, node = node->next_) {
+      ASSERT_EQ(expected_node->type_, node->type_) << sql;
+      ASSERT_EQ(expected_node->value_type_, node->value_type_) << sql;
+      check_string(sql, "var", expected_node->name_, node->name_);
+      if (SET_VALUE_TYPE_INT == expected_node->value_type_) {
+        ASSERT_EQ(expected_node->int_value_, node->int_value_) << sql;
+      } else {
+        check_string(sql, "value", expected_node->str_value_, node->str_value_);
+      }
+    }
+    ASSERT_TRUE(NULL == expected_node && NULL == node) << sql;
+  }
+  parser.free_result(expected);
+}
+
+void TestProxyFastParser::check_hit(const char *sql)
+{
+  bool is_hit = false;
+  check_result(sql, is_hit);
+  ASSERT_TRUE(is_hit) << sql;
+}
+
+void TestProxyFastParser::check_fallback(const char *sql)
+{
+  bool is_hit = true;
+  check_result(sql, is_hit);
+  ASSERT_FALSE(is_hit) << sql;
+}
+
+// one sql a line, the same file as test_obproxy_parser
+void TestProxyFastParser::load_sql(const char *test_file, std::vector<std::string> &sql_array)
+{
+  std::ifstream if_tests(test_file);
+  std::string line;
+  while (std::getline(if_tests, line)) {
+    if (!line.empty() && line.size() < static_cast<size_t>(TEST_SQL_BUF_SIZE - 2)) {
+      sql_array.push_back(line);
+    }
+  }
+}
+
+int64_t TestProxyFastParser::get_where_cond_count(const char *sql, ObProxyParseResult &result)
+{
+  ObProxyFastParser fast_parser;
+  int64_t count = -1;
+  if (OB_SUCCESS == fast_parser.parse(make_sql(sql), NORMAL_PARSE_MODE, CS_TYPE_UTF8MB4_GENERAL_CI, result)) {
+    count = result.where_cond_info_.cond_count_;
+  }
+  return count;
+}
+
+void TestProxyFastParser::init_expr_result(const ObProxyParseResult &result, ObExprParseResult &expr_result)
+{
+  static const char *key_names[] = {"id", "k"};
+  static const ObProxyPartKeyLevel key_levels[] = {PART_KEY_LEVEL_ONE, PART_KEY_LEVEL_TWO};
+  MEMSET(&expr_result, 0, sizeof(expr_result));
+  expr_result.table_info_ = result.table_info_;
+  expr_result.part_key_info_.key_num_ = 2;
+  for (int64_t i = 0; i < 2; ++i) {
+    ObProxyPartKey &part_key = expr_result.part_key_info_.part_keys_[i];
+    part_key.name_.str_ = const_cast<char *>(key_names[i]);
+    part_key.name_.str_len_ = static_cast<int32_t>(strlen(key_names[i]));
+    part_key.level_ = key_levels[i];
+    part_key.idx_ = i;
+  }
+}
+
+void TestProxyFastParser::check_expr_result(const char *sql)
+{
+  ObProxyParseResult result;
+  ASSERT_LT(0, get_where_cond_count(sql, result)) << sql;
+  const ObString req_sql(static_cast<int32_t>(strlen(sql)), buf_);
+  ObExprParseResult expected;
+  ObExprParseResult expr_result;
+  init_expr_result(result, expected);
+  init_expr_result(result, expr_result);
+  ObExprParser parser(allocator_, SELECT_STMT_PARSE_MODE);
+  ObExprParser where_parser(allocator_, SELECT_STMT_PARSE_MODE);
+  ASSERT_EQ(OB_SUCCESS, parser.parse_reqsql(req_sql, result.end_pos_ - result.start_pos_, expected,
+                                            result.stmt_type_, CS_TYPE_UTF8MB4_GENERAL_CI)) << sql;
+  ASSERT_EQ(OB_SUCCESS, where_parser.parse_where_cond(req_sql, result.where_cond_info_, expr_result)) << sql;
+
+  ASSERT_EQ(expected.placeholder_list_idx_, expr_result.placeholder_list_idx_) << sql;
+  ASSERT_EQ(expected.all_relation_info_.relation_num_, expr_result.all_relation_info_.relation_num_) << sql;
+  ASSERT_EQ(expected.relation_info_.relation_num_, expr_result.relation_info_.relation_num_) << sql;
+  for (int64_t i = 0; i < expected.relation_info_.relation_num_; ++i) {
+    const ObProxyRelationExpr *expected_relation = expected.relation_info_.relations_[i];
+    const ObProxyRelationExpr *relation = expr_result.relation_info_.relations_[i];
+    ASSERT_EQ(expected_relation->type_, relation->type_) << sql;
+    ASSERT_EQ(expected_relation->level_, relation->level_) << sql;
+    ASSERT_EQ(expected_relation->column_idx_, relation->column_idx_) << sql;
+    ASSERT_EQ(expected_relation->first_part_column_idx_, relation->first_part_column_idx_) << sql;
+    ASSERT_EQ(expected_relation->second_part_column_idx_, relation->second_part_column_idx_) << sql;
+    const ObProxyTokenNode *expected_value = expected_relation->right_value_->head_;
+    const ObProxyTokenNode *value = relation->right_value_->head_;
+    ASSERT_EQ(expected_value->type_, value->type_) << sql;
+    if (TOKEN_INT_VAL == expected_value->type_) {
+      ASSERT_EQ(expected_value->int_value_, value->int_value_) << sql;
+    } else if (TOKEN_STR_VAL == expected_value->type_) {
+      check_string(sql, "value", expected_value->str_value_, value->str_value_);
+    } else if (TOKEN_PLACE_HOLDER == expected_value->type_) {
+      ASSERT_EQ(expected_value->placeholder_idx_, value->placeholder_idx_) << sql;
+    }
+  }
+  allocator_.reuse();
+}
+
+TEST_F(TestProxyFastParser, test_point_query)
+{
+  check_hit("select * from t1 where id = 1");
+  check_hit("SELECT c1, c2 FROM db1.t1 WHERE id = ? AND name = 'abc'");
+  check_hit("select a.c1 from t1 a where a.id = 10 limit 1");
+  check_hit("select * from t1 as a where a.id in (1, 2, 3)");
+  check_hit("select count(*) from `db1`.`t1` where c1 = 'x'");
+  check_hit("select * from t1 partition(p1) where id = 1");
+  check_hit("select * from t1 where c1 = 'a\\'b' and c2 = \"a\"\"b\"");
+  check_hit("select * from t1 where c1 = 'abc' -- tail\n");
+  check_hit("select * from t1 where c1 = '\xe4\xb8\xad'");
+  check_hit("select * from t1;");
+  check_hit("select * from t1 /* tail */");
+  check_hit("select 1");
+  check_hit("select 1 from dual");
+  check_hit("select last_insert_id()");
+  check_hit("select found_rows(), row_count()");
+  check_hit("update t1 set c1 = 1 where id = 2");
+  check_hit("UPDATE db1.t1 SET c1 = 'a' WHERE id = ?");
+  check_hit("update t1 a set a.c1 = 1 where a.id = 1");
+  check_hit("delete from t1 where id = 1");
+  check_hit("DELETE FROM db1.t1 WHERE id = ?");
+  check_hit("insert into t1 values (1, 'a')");
+  check_hit("insert into t1(c1, c2) values (1, 2)");
+  check_hit("insert ignore into db1.t1 (c1, c2) values (?, ?)");
+  check_hit("insert t1");
+  check_hit("replace into t1 values (1)");
+}
+
+TEST_F(TestProxyFastParser, test_trans_and_set)
+{
+  check_hit("begin");
+  check_hit("BEGIN;");
+  check_hit("start transaction");
+  check_hit("commit");
+  check_hit("rollback;");
+  check_hit("commit /* c */");
+  check_hit("set autocommit = 1");
+  check_hit("set autocommit=0;");
+  check_hit("set @@autocommit = 0, @@last_insert_id = 0");
+  check_hit("set @a = 1, @b = 'x', @c = -12");
+  check_hit("set global wait_timeout = 100");
+  check_hit("set session sql_mode = 'STRICT_TRANS_TABLES'");
+}
+
+TEST_F(TestProxyFastParser, test_fallback)
+{
+  // hints and leading comments
+  check_fallback("select /*+ query_timeout(100) */ * from t1");
+  check_fallback("/* comment */ select * from t1");
+  check_fallback("begin /* c */");
+  // special selects and sets
+  check_fallback("select @@version_comment limit 1");
+  check_fallback("select database()");
+  check_fallback("set names utf8");
+  check_fallback("set @@session.autocommit = 1");
+  check_fallback("set @a = 'a\\'b'");
+  check_fallback("set @a = 1.5");
+  // subquery, multi stmts and others
+  check_fallback("select (select 1) from t1");
+  check_fallback("select * from (select 1) a");
+  check_fallback("insert into t1 select * from t2");
+  check_fallback("select 1; select 2");
+  check_fallback("select * from t1 # comment");
+  check_fallback("show tables");
+  check_fallback("select * from \xe4\xb8\xad");
+  check_fallback("set @@global.x = 1");
+
+  ObProxyFastParser fast_parser;
+  ObProxyParseResult result;
+  ASSERT_EQ(OB_NOT_SUPPORTED, fast_parser.parse(make_sql("select * from t1"), NORMAL_PARSE_MODE,
+                                                CS_TYPE_GB18030_CHINESE_CI, result));
+  ASSERT_EQ(OB_NOT_SUPPORTED, fast_parser.parse(make_sql("select * from t1"), IN_TRANS_PARSE_MODE,
+                                                CS_TYPE_UTF8MB4_GENERAL_CI, result));
+  ASSERT_EQ(OB_NOT_SUPPORTED, fast_parser.parse(ObString::make_string("select * from t1"), NORMAL_PARSE_MODE,
+                                                CS_TYPE_UTF8MB4_GENERAL_CI, result));
+}
+
+TEST_F(TestProxyFastParser, test_where_cond)
+{
+  ObProxyParseResult result;
+  const char *sql = "select c from db1.t1 a where a.id = ? and db1.t1.k >= -12 and `c` != 'x y'";
+  ASSERT_EQ(3, get_where_cond_count(sql, result));
+  const ObProxyWhereCondNode *conds = result.where_cond_info_.conds_;
+  ASSERT_EQ(0, conds[0].db_len_);
+  ASSERT_EQ(1, conds[0].table_len_);
+  ASSERT_EQ(0, MEMCMP(sql + conds[0].column_offset_, "id", 2));
+  ASSERT_EQ(WHERE_COMP_EQ, conds[0].comp_type_);
+  ASSERT_EQ(WHERE_VALUE_TYPE_PLACE_HOLDER, conds[0].value_type_);
+  ASSERT_EQ(0, MEMCMP(sql + conds[1].db_offset_, "db1", 3));
+  ASSERT_EQ(WHERE_COMP_GE, conds[1].comp_type_);
+  ASSERT_EQ(WHERE_VALUE_TYPE_INT, conds[1].value_type_);
+  ASSERT_EQ(-12, conds[1].int_value_);
+  ASSERT_EQ(0, MEMCMP(sql + conds[2].column_offset_, "c", 1));
+  ASSERT_EQ(WHERE_COMP_NE, conds[2].comp_type_);
+  ASSERT_EQ(WHERE_VALUE_TYPE_STR, conds[2].value_type_);
+  ASSERT_EQ(3, conds[2].str_len_);
+  ASSERT_EQ(0, MEMCMP(sql + conds[2].str_offset_, "x y", 3));
+
+  ASSERT_EQ(1, get_where_cond_count("SELECT c FROM sbtest1 WHERE id=?", result));
+  ASSERT_EQ(1, get_where_cond_count("delete from t1 where id = 1;", result));
+  ASSERT_EQ(2, get_where_cond_count("select * from t1 where id <=> 1 and k < 'a' limit 1", result));
+  ASSERT_EQ(1, get_where_cond_count("select * from t1 where id = 1 for update", result));
+  // the stmt is fast parsed, the where clause is left to the expr parser
+  ASSERT_EQ(0, get_where_cond_count("select * from t1", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id = 1 or k = 2", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id in (1, 2)", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id = 1.5", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id = 123456789012345678", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where c = 'a\\'b'", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where c = \"a\"", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where rowid = 'x'", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id = 1 /* c */", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id = 1 order by k", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where c = 'join'", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 partition(p1) where id = 1", result));
+  ASSERT_EQ(0, get_where_cond_count("update t1 set c = 1 where id = 1", result));
+  ASSERT_EQ(0, get_where_cond_count("select * from t1 where id = 1 and k = 2 and id = 3 and k = 4 "
+                                    "and id = 5 and k = 6 and id = 7 and k = 8 and id = 9", result));
+}
+
+TEST_F(TestProxyFastParser, test_where_cond_expr_parse)
+{
+  check_expr_result("SELECT c FROM sbtest1 WHERE id=?");
+  check_expr_result("select * from t1 where id = 10 and k = 'abc' limit 1");
+  check_expr_result("select * from db1.t1 a where a.id = ? and k >= ? and c = ?");
+  check_expr_result("select * from db1.t1 a where db1.a.id = 1 and db2.t1.k = 2 and b.id = 3");
+  check_expr_result("select * from t1 where `ID` != 1 and K <=> -3 and id < 'x'");
+  check_expr_result("delete from t1 where id = 1 and c = 2;");
+}
+
+TEST_F(TestProxyFastParser, test_parser_sql)
+{
+  std::vector<std::string> sql_array;
+  int64_t hit_count = 0;
+  load_sql("./test_parser.sql", sql_array);
+  for (int64_t i = 0; i < static_cast<int64_t>(sql_array.size()); ++i) {
+    bool is_hit = false;
+    check_result(sql_array[i].c_str(), is_hit);
+    if (is_hit) {
+      ++hit_count;
+    }
+  }
+  printf("test_parser.sql: total=%ld fast_parse_hit=%ld\n", static_cast<int64_t>(sql_array.size()), hit_count);
+}
+
+TEST_F(TestProxyFastParser, test_benchmark)
+{
+  static const int64_t LOOP_COUNT = 2000;
+  std::vector<std::string> sql_array;
+  std::vector<ObString> sql_strs;
+  load_sql("./test_parser.sql", sql_array);
+  if (sql_array.empty()) {
+    sql_array.push_back("select * from t1 where id = 1");
+    sql_array.push_back("update t1 set c1 = 1 where id = 2");
+    sql_array.push_back("insert into t1 values (1, 'a')");
+    sql_array.push_back("set autocommit = 1");
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(sql_array.size()); ++i) {
+    sql_array[i].append(2, '\0');
+    sql_strs.push_back(ObString(static_cast<int32_t>(sql_array[i].size()), sql_array[i].data()));
+  }
+
+  ObProxyParseResult result;
+  int64_t start = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < LOOP_COUNT; ++loop) {
+    for (int64_t i = 0; i < static_cast<int64_t>(sql_strs.size()); ++i) {
+      ObProxyParser parser(allocator_, NORMAL_PARSE_MODE);
+      parser.parse(sql_strs[i], result, CS_TYPE_UTF8MB4_GENERAL_CI);
+      allocator_.reuse();
+    }
+  }
+  const int64_t parser_cost = ObTimeUtility::current_time() - start;
+
+  int64_t hit_count = 0;
+  start = ObTimeUtility::current_time();
+  for (int64_t loop = 0; loop < LOOP_COUNT; ++loop) {
+    for (int64_t i = 0; i < static_cast<int64_t>(sql_strs.size()); ++i) {
+      ObProxyFastParser fast_parser;
+      if (OB_SUCCESS == fast_parser.parse(sql_strs[i], NORMAL_PARSE_MODE, CS_TYPE_UTF8MB4_GENERAL_CI, result)) {
+        ++hit_count;
+      } else {
+        ObProxyParser parser(allocator_, NORMAL_PARSE_MODE);
+        parser.parse(sql_strs[i], result, CS_TYPE_UTF8MB4_GENERAL_CI);
+        allocator_.reuse();
+      }
+    }
+  }
+  const int64_t fast_cost = ObTimeUtility::current_time() - start;
+  const int64_t total = LOOP_COUNT * static_cast<int64_t>(sql_strs.size());
+  printf("proxy parser: count=%ld cost=%ldus avg=%.3fus\n",
+         total, parser_cost, static_cast<double>(parser_cost) / static_cast<double>(total));
+  printf("fast parser first: count=%ld hit=%ld cost=%ldus avg=%.3fus\n",
+         total, hit_count, fast_cost, static_cast<double>(fast_cost) / static_cast<double>(total));
+}
+
+TEST_F(TestProxyFastParser, test_where_cond_benchmark)
+{
+  static const int64_t LOOP_COUNT = 100000;
+  const char *sql = "SELECT c FROM sbtest1 WHERE id=?";
+  ObProxyParseResult result;
+  ASSERT_EQ(1, get_where_cond_count(sql, result));
+  const ObString req_sql(static_cast<int32_t>(strlen(sql)), buf_);
+  ObExprParseResult expr_result;
+
+  int64_t start = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < LOOP_COUNT; ++i) {
+    init_expr_result(result, expr_result);
+    ObExprParser parser(allocator_, SELECT_STMT_PARSE_MODE);
+    parser.parse_reqsql(req_sql, result.end_pos_ - result.start_pos_, expr_result,
+                        result.stmt_type_, CS_TYPE_UTF8MB4_GENERAL_CI);
+    allocator_.reuse();
+  }
+  const int64_t expr_cost = ObTimeUtility::current_time() - start;
+
+  start = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < LOOP_COUNT; ++i) {
+    init_expr_result(result, expr_result);
+    ObExprParser parser(allocator_, SELECT_STMT_PARSE_MODE);
+    parser.parse_where_cond(req_sql, result.where_cond_info_, expr_result);
+    allocator_.reuse();
+  }
+  const int64_t where_cond_cost = ObTimeUtility::current_time() - start;
+  printf("expr parser: count=%ld cost=%ldus avg=%.3fus\n",
+         LOOP_COUNT, expr_cost, static_cast<double>(expr_cost) / static_cast<double>(LOOP_COUNT));
+  printf("where cond of fast parser: count=%ld cost=%ldus avg=%.3fus\n",
+         LOOP_COUNT, where_cond_cost, static_cast<double>(where_cond_cost) / static_cast<double>(LOOP_COUNT));
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
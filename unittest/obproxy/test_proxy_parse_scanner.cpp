@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "lib/allocator/page_arena.h"
+#include "lib/time/ob_time_utility.h"
+#include "opsql/ob_proxy_parse_scanner.h"
+#include "opsql/parser/ob_proxy_parser.h"
+#include "opsql/expr_parser/ob_expr_parser.h"
+#include "opsql/func_expr_parser/ob_func_expr_parser.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace opsql;
+
+class TestProxyParseScanner : public ::testing::Test
+{
+public:
+  TestProxyParseScanner() : allocator_(ObModIds::TEST) {}
+  virtual void TearDown() { allocator_.reuse(); }
+  void load_sql(const char *test_file, std::vector<std::string> &sql_array);
+  // what ObProxyParser::init_result() does
+  void init_proxy_result(ObProxyParseResult &result, const char *sql);
+  // the reused scanner must give what a new scanner gives
+  void check_proxy_parse(std::string &sql, const ObCollationType collation);
+
+public:
+  ObArenaAllocator allocator_;
+};
+
+// one sql a line, the same file as test_obproxy_parser, with two trailing '\0'
+void TestProxyParseScanner::load_sql(const char *test_file, std::vector<std::string> &sql_array)
+{
+  std::ifstream in(test_file);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty()) {
+      line.append(2, '\0');
+      sql_array.push_back(line);
+    }
+  }
+  if (sql_array.empty()) {
+    sql_array.push_back(std::string("select * from t1 where id = 1", 29).append(2, '\0'));
+    sql_array.push_back(std::string("select /*+ query_timeout(100) */ 'a", 35).append(2, '\0'));
+    sql_array.push_back(std::string("insert into db1.t1 values (1, 'a')", 34).append(2, '\0'));
+  }
+}
+
+void TestProxyParseScanner::init_proxy_result(ObProxyParseResult &result, const char *sql)
+{
+  MEMSET(&result, 0, sizeof(result));
+  result.malloc_pool_ = static_cast<void *>(&allocator_);
+  result.parse_mode_ = NORMAL_PARSE_MODE;
+  result.start_pos_ = sql;
+  result.read_consistency_type_ = OBPROXY_READ_CONSISTENCY_INVALID;
+  result.cmd_info_.sub_type_ = OBPROXY_T_SUB_INVALID;
+  result.cmd_info_.err_type_ = OBPROXY_T_ERR_INVALID;
+  for (int64_t i = 0; i < OBPROXY_ICMD_MAX_VALUE_COUNT; ++i) {
+    result.cmd_info_.integer_[i] = -1;
+  }
+}
+
+void TestProxyParseScanner::check_proxy_parse(std::string &sql, const ObCollationType collation)
+{
+  const ObString sql_str(static_cast<int32_t>(sql.size()), &sql[0]);
+  const char *sql_ptr = sql_str.ptr();
+  ObProxyParseResult expected;
+  ObProxyParseResult result;
+  ObProxyParser parser(allocator_, NORMAL_PARSE_MODE);
+
+  init_proxy_result(expected, sql_ptr);
+  const int expected_ret = CS_TYPE_GB18030_CHINESE_CI == collation
+      ? obproxy_parse_gbk_sql(&expected, sql_ptr, static_cast<size_t>(sql_str.length()))
+      : obproxy_parse_utf8_sql(&expected, sql_ptr, static_cast<size_t>(sql_str.length()));
+  const int ret = parser.parse(sql_str, result, collation);
+
+  ASSERT_EQ(OB_SUCCESS == expected_ret, OB_SUCCESS == ret) << sql_ptr;
+  ASSERT_EQ(expected.stmt_type_, result.stmt_type_) << sql_ptr;
+  ASSERT_EQ(expected.sub_stmt_type_, result.sub_stmt_type_) << sql_ptr;
+  ASSERT_EQ(expected.stmt_count_, result.stmt_count_) << sql_ptr;
+  ASSERT_EQ(expected.end_pos_, result.end_pos_) << sql_ptr;
+  ASSERT_EQ(expected.comment_begin_, result.comment_begin_) << sql_ptr;
+  ASSERT_EQ(expected.has_ignored_word_, result.has_ignored_word_) << sql_ptr;
+  ASSERT_EQ(expected.query_timeout_, result.query_timeout_) << sql_ptr;
+  ASSERT_EQ(expected.table_info_.table_name_.str_len_, result.table_info_.table_name_.str_len_) << sql_ptr;
+  ASSERT_EQ(expected.table_info_.table_name_.str_, result.table_info_.table_name_.str_) << sql_ptr;
+  ASSERT_EQ(expected.table_info_.database_name_.str_, result.table_info_.database_name_.str_) << sql_ptr;
+  ASSERT_EQ(expected.set_parse_info_.node_count_, result.set_parse_info_.node_count_) << sql_ptr;
+  parser.free_result(expected);
+  parser.free_result(result);
+  allocator_.reuse();
+}
+
+void *get_scanner_func(void *arg)
+{
+  *static_cast<void **>(arg) = ObProxyParseScanner::get_thread_scanner(OBPROXY_UTF8_SCANNER,
+                                                                       obproxy_parse_utf8_sql_init_scanner);
+  return NULL;
+}
+
+TEST_F(TestProxyParseScanner, test_thread_scanner)
+{
+  void *scanner = ObProxyParseScanner::get_thread_scanner(OBPROXY_UTF8_SCANNER, obproxy_parse_utf8_sql_init_scanner);
+  ASSERT_TRUE(NULL != scanner);
+  ASSERT_EQ(scanner, ObProxyParseScanner::get_thread_scanner(OBPROXY_UTF8_SCANNER,
+                                                             obproxy_parse_utf8_sql_init_scanner));
+  void *gbk_scanner = ObProxyParseScanner::get_thread_scanner(OBPROXY_GBK_SCANNER, obproxy_parse_gbk_sql_init_scanner);
+  ASSERT_TRUE(NULL != gbk_scanner);
+  ASSERT_NE(scanner, gbk_scanner);
+  ASSERT_TRUE(NULL == ObProxyParseScanner::get_thread_scanner(OBPROXY_MAX_SCANNER, obproxy_parse_utf8_sql_init_scanner));
+  ASSERT_TRUE(NULL == ObProxyParseScanner::get_thread_scanner(OBEXPR_UTF8_SCANNER, NULL));
+
+  // the first statement of a new thread creates its own scanner
+  void *thread_scanner = NULL;
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, get_scanner_func, &thread_scanner));
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  ASSERT_TRUE(NULL != thread_scanner);
+  ASSERT_NE(scanner, thread_scanner);
+
+  // no scanner falls back to a new one for the statement
+  char sql[] = "select * from t1\0";
+  ObProxyParseResult result;
+  init_proxy_result(result, sql);
+  ASSERT_EQ(OB_SUCCESS, obproxy_parse_utf8_sql_with_scanner(&result, sql, sizeof(sql), NULL));
+  ASSERT_EQ(OBPROXY_T_SELECT, result.stmt_type_);
+}
+
+TEST_F(TestProxyParseScanner, test_reuse_proxy_scanner)
+{
+  std::vector<std::string> sql_array;
+  load_sql("./test_parser.sql", sql_array);
+  std::string bad_sql("select 'abc\0\0", 13);
+  std::string deep_sql("select * from t1 where c1 in ((((((((((((((((((((((((((((((1))))))))))))))))))))))))))))))");
+  deep_sql.append(2, '\0');
+  for (int64_t i = 0; i < static_cast<int64_t>(sql_array.size()); ++i) {
+    check_proxy_parse(sql_array[i], CS_TYPE_UTF8MB4_GENERAL_CI);
+    check_proxy_parse(sql_array[i], CS_TYPE_GB18030_CHINESE_CI);
+    // a broken statement or a deep start condition stack must not leak into the next one
+    if (0 == i % 7) {
+      check_proxy_parse(bad_sql, CS_TYPE_UTF8MB4_GENERAL_CI);
+    } else if (0 == i % 11) {
+      check_proxy_parse(deep_sql, CS_TYPE_UTF8MB4_GENERAL_CI);
+    }
+  }
+}
+
+TEST_F(TestProxyParseScanner, test_reuse_expr_scanner)
+{
+  const char *sqls[] = {
+    "select * from t1 where id = 1 and c1 = 'abc'",
+    "select * from t1 where id = ? or c1 in (1, 2, 3)",
+    "select * from t1 where id = 'abc",
+    "select * from t1 where `id` = 1 limit 1",
+  };
+  for (int64_t loop = 0; loop < 3; ++loop) {
+    for (int64_t i = 0; i < static_cast<int64_t>(ARRAYSIZEOF(sqls)); ++i) {
+      std::string sql(sqls[i]);
+      sql.append(2, '\0');
+      const ObString sql_str(static_cast<int32_t>(sql.size()), &sql[0]);
+      ObExprParseResult expected;
+      ObExprParseResult result;
+      MEMSET(&expected, 0, sizeof(expected));
+      MEMSET(&result, 0, sizeof(result));
+      expected.malloc_pool_ = static_cast<void *>(&allocator_);
+      expected.parse_mode_ = SELECT_STMT_PARSE_MODE;
+      expected.start_pos_ = sql_str.ptr();
+      const int expected_ret = ob_expr_parse_utf8_sql(&expected, sql_str.ptr(), static_cast<size_t>(sql_str.length()));
+      ObExprParser parser(allocator_, SELECT_STMT_PARSE_MODE);
+      const int ret = parser.parse(sql_str, result, CS_TYPE_UTF8MB4_GENERAL_CI);
+      ASSERT_EQ(OB_SUCCESS == expected_ret, OB_SUCCESS == ret) << sqls[i];
+      ASSERT_EQ(expected.all_relation_info_.relation_num_, result.all_relation_info_.relation_num_) << sqls[i];
+      ASSERT_EQ(expected.placeholder_list_idx_, result.placeholder_list_idx_) << sqls[i];
+      allocator_.reuse();
+    }
+  }
+
+  const char *funcs[] = {"substr(c1, 1, 2)", "to_date(c1, 'yyyy-mm-dd')", "substr(c1, 1", "concat(c1, `c2`)"};
+  for (int64_t loop = 0; loop < 3; ++loop) {
+    for (int64_t i = 0; i < static_cast<int64_t>(ARRAYSIZEOF(funcs)); ++i) {
+      const ObString func_str = ObString::make_string(funcs[i]);
+      ObFuncExprParseResult expected;
+      ObFuncExprParseResult result;
+      MEMSET(&expected, 0, sizeof(expected));
+      expected.malloc_pool_ = static_cast<void *>(&allocator_);
+      expected.parse_mode_ = GENERATE_FUNC_PARSE_MODE;
+      expected.start_pos_ = func_str.ptr();
+      const int expected_ret = ob_func_expr_parse_sql(&expected, func_str.ptr(), static_cast<size_t>(func_str.length()));
+      ObFuncExprParser parser(allocator_, GENERATE_FUNC_PARSE_MODE);
+      const int ret = parser.parse(func_str, result);
+      ASSERT_EQ(OB_SUCCESS == expected_ret, OB_SUCCESS == ret) << funcs[i];
+      ASSERT_EQ(NULL == expected.param_node_, NULL == result.param_node_) << funcs[i];
+      if (NULL != expected.param_node_) {
+        ASSERT_EQ(expected.param_node_->type_, result.param_node_->type_) << funcs[i];
+      }
+      allocator_.reuse();
+    }
+  }
+}
+
+TEST_F(TestProxyParseScanner, test_benchmark)
+{
+  static const int64_t LOOP_COUNT = 200000;
+  std::string sql("SELECT c FROM sbtest1 WHERE id=?");
+  sql.append(2, '\0');
+  const ObString sql_str(static_cast<int32_t>(sql.size()), &sql[0]);
+  ObProxyParser parser(allocator_, NORMAL_PARSE_MODE);
+  ObProxyParseResult result;
+
+  int64_t start = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < LOOP_COUNT; ++i) {
+    init_proxy_result(result, sql_str.ptr());
+    obproxy_parse_utf8_sql(&result, sql_str.ptr(), static_cast<size_t>(sql_str.length()));
+    allocator_.reuse();
+  }
+  const int64_t new_scanner_cost = ObTimeUtility::current_time() - start;
+
+  start = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < LOOP_COUNT; ++i) {
+    parser.parse(sql_str, result, CS_TYPE_UTF8MB4_GENERAL_CI);
+    allocator_.reuse();
+  }
+  const int64_t reused_scanner_cost = ObTimeUtility::current_time() - start;
+  printf("new scanner: count=%ld cost=%ldus avg=%.3fus\n", LOOP_COUNT, new_scanner_cost,
+         static_cast<double>(new_scanner_cost) / static_cast<double>(LOOP_COUNT));
+  printf("reused scanner: count=%ld cost=%ldus avg=%.3fus\n", LOOP_COUNT, reused_scanner_cost,
+         static_cast<double>(reused_scanner_cost) / static_cast<double>(LOOP_COUNT));
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_NET
+
+#include <gtest/gtest.h>
+#include <sched.h>
+#define private public
+#define protected public
+#include "iocore/net/ob_connection.h"
+#include "iocore/net/ob_net_accept.h"
+#include "iocore/net/ob_socket_manager.h"
+#include "utils/ob_proxy_hot_upgrader.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace net;
+
+static const int64_t TEST_LISTEN_SOCKET_COUNT = 4;
+
+class TestReuseportAccept : public ::testing::Test
+{
+public:
+  virtual void SetUp() { get_global_hot_upgrade_info().reset(); }
+  virtual void TearDown() { get_global_hot_upgrade_info().reset(); }
+};
+
+TEST_F(TestReuseportAccept, test_reuseport_fds_envp)
+{
+  ObHotUpgraderInfo &info = get_global_hot_upgrade_info();
+  char buf[ObHotUpgraderInfo::MAX_REUSEPORT_ENVP_SIZE];
+
+  ASSERT_EQ(OB_SUCCESS, info.get_reuseport_envp(false, buf, sizeof(buf)));
+  ASSERT_STREQ(OBPROXY_INHERITED_REUSEPORT_IPV4_FDS"=", buf);
+
+  ASSERT_EQ(OB_SUCCESS, info.add_reuseport_fd(false, 11));
+  ASSERT_EQ(OB_SUCCESS, info.add_reuseport_fd(false, 12));
+  ASSERT_EQ(OB_SUCCESS, info.add_reuseport_fd(true, 21));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, info.add_reuseport_fd(true, -1));
+  ASSERT_EQ(OB_SUCCESS, info.get_reuseport_envp(false, buf, sizeof(buf)));
+  ASSERT_STREQ(OBPROXY_INHERITED_REUSEPORT_IPV4_FDS"=11,12", buf);
+  ASSERT_NE(OB_SUCCESS, info.get_reuseport_envp(false, buf, 8));
+  ASSERT_TRUE(info.is_reuseport_fd(12));
+  ASSERT_TRUE(info.is_reuseport_fd(21));
+  ASSERT_FALSE(info.is_reuseport_fd(13));
+
+  // sub process side
+  info.reset();
+  ASSERT_EQ(OB_SUCCESS, info.parse_reuseport_fds(false, "11,12,100"));
+  ASSERT_EQ(OB_SUCCESS, info.parse_reuseport_fds(true, ""));
+  ASSERT_EQ(3, info.get_reuseport_fd_count(false));
+  ASSERT_EQ(0, info.get_reuseport_fd_count(true));
+  ASSERT_EQ(100, info.get_reuseport_fd(false, 2));
+  ASSERT_EQ(OB_INVALID_INDEX, info.get_reuseport_fd(false, 3));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, info.parse_reuseport_fds(true, "1,x"));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, info.parse_reuseport_fds(true, "-3"));
+}
+
+TEST_F(TestReuseportAccept, test_listen_reuseport_group)
+{
+  ObHotUpgraderInfo &info = get_global_hot_upgrade_info();
+  ObServerConnection servers[TEST_LISTEN_SOCKET_COUNT];
+  ObConnection con;
+  ObConnection client;
+
+  ops_ip4_set(servers[0].accept_addr_, htonl(INADDR_LOOPBACK), 0);
+  servers[0].reuseport_ = true;
+  ASSERT_EQ(OB_SUCCESS, servers[0].listen(true));
+  ASSERT_EQ(servers[0].fd_, info.ipv4_fd_);
+  for (int64_t i = 1; i < TEST_LISTEN_SOCKET_COUNT; ++i) {
+    // same port as the first one
+    ops_ip_copy(servers[i].accept_addr_, servers[0].addr_);
+    servers[i].reuseport_ = true;
+    ASSERT_EQ(OB_SUCCESS, servers[i].listen(true));
+    ASSERT_EQ(servers[i].fd_, info.get_reuseport_fd(false, i - 1));
+  }
+  ASSERT_EQ(TEST_LISTEN_SOCKET_COUNT - 1, info.get_reuseport_fd_count(false));
+
+  // a connection goes to exactly one socket of the group
+  ASSERT_EQ(OB_SUCCESS, ObSocketManager::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP, client.fd_));
+  ASSERT_EQ(0, ::connect(client.fd_, &servers[0].addr_.sa_, sizeof(struct sockaddr_in)));
+  usleep(10000);
+  int64_t accepted = 0;
+  for (int64_t i = 0; i < TEST_LISTEN_SOCKET_COUNT; ++i) {
+    if (OB_SUCCESS == servers[i].accept(&con)) {
+      ++accepted;
+      con.close();
+    }
+  }
+  ASSERT_EQ(1, accepted);
+
+  // without SO_REUSEPORT the port is busy
+  ObServerConnection other;
+  ops_ip_copy(other.accept_addr_, servers[0].addr_);
+  ASSERT_NE(OB_SUCCESS, other.listen(true));
+
+  client.close();
+  for (int64_t i = 0; i < TEST_LISTEN_SOCKET_COUNT; ++i) {
+    servers[i].close();
+  }
+}
+
+TEST_F(TestReuseportAccept, test_reuseport_group_idx)
+{
+  // the last acceptor is the one whose socket is listened first
+  ASSERT_EQ(0, ObNetAccept::get_reuseport_group_idx(TEST_LISTEN_SOCKET_COUNT - 1, TEST_LISTEN_SOCKET_COUNT));
+  for (int64_t i = 0; i < TEST_LISTEN_SOCKET_COUNT - 1; ++i) {
+    // and the others listen in order, with the i-th extra fd
+    ASSERT_EQ(i + 1, ObNetAccept::get_reuseport_group_idx(i, TEST_LISTEN_SOCKET_COUNT));
+  }
+
+  // cpu k is steered to the socket at k % group size, served by net thread k when
+  // every thread has one socket, a sub process with less threads wraps around
+  const int64_t thread_count = TEST_LISTEN_SOCKET_COUNT;
+  int64_t thread_of_socket[TEST_LISTEN_SOCKET_COUNT + 2];
+  for (int64_t acceptor_count = thread_count; acceptor_count <= thread_count + 2; ++acceptor_count) {
+    for (int64_t i = 0; i < acceptor_count; ++i) {
+      const int64_t group_idx = ObNetAccept::get_reuseport_group_idx(i, acceptor_count);
+      thread_of_socket[group_idx] = group_idx % thread_count;
+    }
+    for (int64_t cpu = 0; cpu < 3 * acceptor_count; ++cpu) {
+      ASSERT_EQ((cpu % acceptor_count) % thread_count, thread_of_socket[cpu % acceptor_count]);
+    }
+  }
+}
+
+TEST_F(TestReuseportAccept, test_reuseport_cpu_steering)
+{
+  ObServerConnection servers[TEST_LISTEN_SOCKET_COUNT];
+  ObConnection con;
+  ObConnection client;
+  ObNetAccept na;
+
+  ops_ip4_set(servers[0].accept_addr_, htonl(INADDR_LOOPBACK), 0);
+  servers[0].reuseport_ = true;
+  ASSERT_EQ(OB_SUCCESS, servers[0].listen(true));
+  for (int64_t i = 1; i < TEST_LISTEN_SOCKET_COUNT; ++i) {
+    ops_ip_copy(servers[i].accept_addr_, servers[0].addr_);
+    servers[i].reuseport_ = true;
+    ASSERT_EQ(OB_SUCCESS, servers[i].listen(true));
+  }
+
+  na.server_.fd_ = servers[0].fd_;
+  const int cpu = sched_getcpu();
+  cpu_set_t old_cpu_set;
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(old_cpu_set), &old_cpu_set));
+  if (OB_SUCCESS != na.attach_reuseport_cpu_steering(TEST_LISTEN_SOCKET_COUNT)
+      || cpu < 0 || 0 != sched_setaffinity(0, sizeof(cpu_set), &cpu_set)) {
+    LOG_WARN("reuseport cpu steering is not available, skip it", K(cpu));
+  } else {
+    // loopback handles the syn on the cpu of the connecting thread
+    ASSERT_EQ(OB_SUCCESS, ObSocketManager::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP, client.fd_));
+    ASSERT_EQ(0, ::connect(client.fd_, &servers[0].addr_.sa_, sizeof(struct sockaddr_in)));
+    usleep(10000);
+    ASSERT_EQ(OB_SUCCESS, servers[cpu % TEST_LISTEN_SOCKET_COUNT].accept(&con));
+    con.close();
+    client.close();
+    sched_setaffinity(0, sizeof(old_cpu_set), &old_cpu_set);
+  }
+  na.server_.fd_ = NO_FD;
+
+  for (int64_t i = 0; i < TEST_LISTEN_SOCKET_COUNT; ++i) {
+    servers[i].close();
+  }
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#define private public
+#define protected public
+#include "lib/hash_func/murmur_hash.h"
+#include "proxy/route/ob_route_cache_policy.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+
+static uint64_t hash_key(const int64_t key)
+{
+  return murmurhash(&key, sizeof(key), 0);
+}
+
+struct TestEntry
+{
+  TestEntry() : key_(0), frequency_(0), last_access_time_us_(0) {}
+
+  int64_t key_;
+  int64_t frequency_;
+  int64_t last_access_time_us_;
+};
+
+struct TestEntryCmp
+{
+  bool operator() (const TestEntry &lhs, const TestEntry &rhs) const
+  {
+    return ObRouteCachePolicy::is_colder(lhs.frequency_, lhs.last_access_time_us_,
+                                         rhs.frequency_, rhs.last_access_time_us_);
+  }
+};
+
+class TestRouteCachePolicy : public ::testing::Test
+{
+public:
+  // a cache cleaned to capacity at the end of every round, accessed by hot_count hot keys,
+  // hot_access_count times each in random order, and then by a burst of cold_count keys
+  // seen only once; return the hits of the hot keys
+  int64_t run(ObRouteCachePolicy &policy, const bool frequency_aware, const int64_t capacity,
+              const int64_t hot_count, const int64_t hot_access_count, const int64_t cold_count,
+              const int64_t round_count);
+  void access(ObRouteCachePolicy &policy, const bool frequency_aware, const int64_t key,
+              const int64_t now, bool &is_hit);
+  void clean(ObRouteCachePolicy &policy, const bool frequency_aware, const int64_t capacity);
+
+public:
+  std::vector<TestEntry> cache_;
+};
+
+void TestRouteCachePolicy::access(ObRouteCachePolicy &policy, const bool frequency_aware,
+                                  const int64_t key, const int64_t now, bool &is_hit)
+{
+  std::vector<TestEntry>::iterator it = cache_.begin();
+  for (; it != cache_.end() && it->key_ != key; ++it) {}
+  is_hit = (it != cache_.end());
+  if (is_hit) {
+    policy.record_hit();
+    it->last_access_time_us_ = now;
+    if (frequency_aware && ObRouteCachePolicy::need_sample_access()) {
+      ObRouteCachePolicy::inc_frequency(it->frequency_);
+    }
+  } else {
+    policy.record_miss(hash_key(key));
+    TestEntry entry;
+    entry.key_ = key;
+    entry.last_access_time_us_ = now;
+    if (frequency_aware) {
+      ObRouteCachePolicy::merge_frequency(entry.frequency_, policy.estimate(hash_key(key)));
+    }
+    cache_.push_back(entry);
+  }
+}
+
+// as the cache cleaner does, age every entry and evict the coldest ones down to 3/4 of the capacity,
+// the newest probation entries compete with the victims for admission
+void TestRouteCachePolicy::clean(ObRouteCachePolicy &policy, const bool frequency_aware,
+                                 const int64_t capacity)
+{
+  if (static_cast<int64_t>(cache_.size()) > capacity) {
+    for (std::vector<TestEntry>::iterator it = cache_.begin(); it != cache_.end(); ++it) {
+      ObRouteCachePolicy::age_frequency(it->frequency_);
+    }
+    std::sort(cache_.begin(), cache_.end(), TestEntryCmp());
+    const int64_t clean_count = cache_.size() - capacity * 3 / 4;
+    int64_t candidate_idx = cache_.size() - 1;
+    for (int64_t i = 0; frequency_aware && i < clean_count && !ObRouteCachePolicy::is_protected(cache_[i].frequency_); ++i) {
+      while (candidate_idx >= clean_count && ObRouteCachePolicy::is_protected(cache_[candidate_idx].frequency_)) {
+        --candidate_idx;
+      }
+      if (candidate_idx >= clean_count) {
+        if (!ObRouteCachePolicy::is_admitted(cache_[candidate_idx].frequency_, cache_[i].frequency_)) {
+          std::swap(cache_[i], cache_[candidate_idx]);
+        }
+        --candidate_idx;
+      }
+    }
+    for (int64_t i = 0; i < clean_count; ++i) {
+      policy.record_eviction(hash_key(cache_[i].key_), cache_[i].frequency_);
+    }
+    cache_.erase(cache_.begin(), cache_.begin() + clean_count);
+  }
+}
+
+int64_t TestRouteCachePolicy::run(ObRouteCachePolicy &policy, const bool frequency_aware,
+                                  const int64_t capacity, const int64_t hot_count,
+                                  const int64_t hot_access_count, const int64_t cold_count,
+                                  const int64_t round_count)
+{
+  int64_t now = 0;
+  int64_t hot_hit_count = 0;
+  int64_t cold_key = hot_count;
+  uint64_t seed = 1;
+  bool is_hit = false;
+  cache_.clear();
+  for (int64_t round = 0; round < round_count; ++round) {
+    for (int64_t i = 0; i < hot_count * hot_access_count; ++i) {
+      seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+      access(policy, frequency_aware, static_cast<int64_t>((seed >> 33) % hot_count), ++now, is_hit);
+      hot_hit_count += is_hit ? 1 : 0;
+    }
+    for (int64_t i = 0; i < cold_count; ++i) {
+      access(policy, frequency_aware, cold_key++, ++now, is_hit);
+    }
+    clean(policy, frequency_aware, capacity);
+  }
+  return hot_hit_count;
+}
+
+TEST_F(TestRouteCachePolicy, test_sketch)
+{
+  ObRouteCachePolicy policy;
+  const int64_t max_frequency = ObRouteCachePolicy::MAX_FREQUENCY;
+  const uint64_t hash = hash_key(1);
+  ASSERT_EQ(0, policy.estimate(hash));
+  policy.record_miss(hash);
+  policy.record_miss(hash);
+  ASSERT_EQ(2, policy.estimate(hash));
+  policy.record_eviction(hash, 5);
+  ASSERT_EQ(7, policy.estimate(hash));
+  policy.record_eviction(hash, max_frequency);
+  ASSERT_EQ(max_frequency, policy.estimate(hash));
+  ASSERT_EQ(0, policy.get_hit_count());
+  ASSERT_EQ(2, policy.get_miss_count());
+  ASSERT_EQ(2, policy.get_eviction_count());
+
+  // a key never seen is estimated low, even with many other keys in the sketch
+  for (int64_t key = 100; key < 100 + ObRouteCachePolicy::SKETCH_WIDTH / 4; ++key) {
+    policy.record_miss(hash_key(key));
+  }
+  int64_t high_estimate_count = 0;
+  for (int64_t key = 1000000; key < 1001000; ++key) {
+    if (policy.estimate(hash_key(key)) >= ObRouteCachePolicy::PROTECTED_FREQUENCY) {
+      ++high_estimate_count;
+    }
+  }
+  ASSERT_TRUE(high_estimate_count < 10);
+
+  // the sketch halves once enough is added
+  const int64_t add_count = ObRouteCachePolicy::SKETCH_RESET_COUNT - policy.sketch_add_count_;
+  for (int64_t i = 0; i < add_count; ++i) {
+    policy.record_miss(hash_key(2000000 + i));
+  }
+  ASSERT_EQ(0, policy.sketch_add_count_);
+  ASSERT_TRUE(policy.estimate(hash) <= max_frequency / 2 + 1);
+}
+
+TEST_F(TestRouteCachePolicy, test_frequency)
+{
+  const int64_t max_frequency = ObRouteCachePolicy::MAX_FREQUENCY;
+  int64_t frequency = 0;
+  ObRouteCachePolicy::inc_frequency(frequency);
+  ASSERT_EQ(1, frequency);
+  ASSERT_FALSE(ObRouteCachePolicy::is_protected(frequency));
+  for (int64_t i = 0; i < 100; ++i) {
+    ObRouteCachePolicy::inc_frequency(frequency);
+  }
+  ASSERT_EQ(max_frequency, frequency);
+  ASSERT_TRUE(ObRouteCachePolicy::is_protected(frequency));
+  ObRouteCachePolicy::age_frequency(frequency);
+  ASSERT_EQ(max_frequency / 2, frequency);
+  ObRouteCachePolicy::merge_frequency(frequency, 3);
+  ASSERT_EQ(max_frequency / 2, frequency);
+  ObRouteCachePolicy::merge_frequency(frequency, 100);
+  ASSERT_EQ(max_frequency, frequency);
+
+  // probation entries are evicted first, then the least recently accessed
+  ASSERT_TRUE(ObRouteCachePolicy::is_colder(0, 100, ObRouteCachePolicy::PROTECTED_FREQUENCY, 1));
+  ASSERT_FALSE(ObRouteCachePolicy::is_colder(ObRouteCachePolicy::PROTECTED_FREQUENCY, 1, 0, 100));
+  ASSERT_TRUE(ObRouteCachePolicy::is_colder(1, 1, 0, 100));
+  ASSERT_TRUE(ObRouteCachePolicy::is_colder(5, 1, 15, 100));
+  ASSERT_FALSE(ObRouteCachePolicy::is_colder(5, 100, 15, 1));
+
+  // a candidate replaces the victim only when it is more frequent
+  ASSERT_TRUE(ObRouteCachePolicy::is_admitted(2, 1));
+  ASSERT_FALSE(ObRouteCachePolicy::is_admitted(1, 1));
+  ASSERT_FALSE(ObRouteCachePolicy::is_admitted(0, 1));
+
+  int64_t sampled_count = 0;
+  for (int64_t i = 0; i < 1000 * ObRouteCachePolicy::ACCESS_SAMPLE_RATE; ++i) {
+    if (ObRouteCachePolicy::need_sample_access()) {
+      ++sampled_count;
+    }
+  }
+  ASSERT_EQ(1000, sampled_count);
+}
+
+TEST_F(TestRouteCachePolicy, test_hot_entry_survive_scan)
+{
+  ObRouteCachePolicy lru_policy;
+  ObRouteCachePolicy policy;
+  const int64_t capacity = 100;
+  const int64_t hot_count = 50;
+  const int64_t hot_access_count = 16;
+  const int64_t round_count = 20;
+  const int64_t lru_hit_count = run(lru_policy, false, capacity, hot_count, hot_access_count, 200, round_count);
+  const int64_t hit_count = run(policy, true, capacity, hot_count, hot_access_count, 200, round_count);
+  LOG_INFO("hot entry hit", K(lru_hit_count), K(hit_count), K(lru_policy), K(policy));
+  printf("hot key hits, lru %ld, frequency aware %ld of %ld\n",
+         lru_hit_count, hit_count, hot_count * hot_access_count * round_count);
+  printf("lru: %ld/1000 hit ratio, %ld evicted; frequency aware: %ld/1000 hit ratio, %ld evicted\n",
+         lru_policy.get_hit_ratio_permille(), lru_policy.get_eviction_count(),
+         policy.get_hit_ratio_permille(), policy.get_eviction_count());
+  // a burst of keys seen once evicts every hot key from a lru cache,
+  // but only the probation entries from the segmented one
+  ASSERT_TRUE(hit_count > lru_hit_count);
+  ASSERT_TRUE(policy.get_hit_ratio_permille() > lru_policy.get_hit_ratio_permille());
+  ASSERT_TRUE(policy.get_eviction_count() < lru_policy.get_eviction_count());
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+#define private public
+#define protected public
+#include "lib/time/ob_time_utility.h"
+#include "proxy/route/ob_route_snapshot.h"
+#include "proxy/route/ob_table_entry.h"
+#include "proxy/route/ob_partition_entry.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+
+static const char *const TEST_SNAPSHOT_PATH = "./test_route_snapshot.bin";
+static const int64_t TEST_CR_ID = 1;
+static const int64_t TEST_CR_VERSION = 3;
+
+class TestRouteSnapshot : public ::testing::Test
+{
+public:
+  TestRouteSnapshot() : buf_(NULL), buf_len_(0), data_len_(0) {}
+
+  virtual void SetUp()
+  {
+    buf_len_ = ObRouteSnapshot::MAX_SNAPSHOT_SIZE;
+    buf_ = new char[buf_len_];
+  }
+
+  virtual void TearDown()
+  {
+    delete [] buf_;
+    buf_ = NULL;
+    ::unlink(TEST_SNAPSHOT_PATH);
+  }
+
+  void build_record(const int64_t i, ObRouteSnapshotRecord &record)
+  {
+    record.reset();
+    record.cr_version_ = TEST_CR_VERSION;
+    record.table_id_ = 1000 + i;
+    record.table_type_ = 3;
+    record.replica_num_ = 3;
+    record.schema_version_ = i;
+    record.frequency_ = i % 16;
+    for (int64_t j = 0; j < 3; ++j) {
+      ObProxyReplicaLocation replica(ObAddr(ObAddr::IPV4, "127.0.0.1", static_cast<int32_t>(2881 + j)),
+                                     0 == j ? LEADER : FOLLOWER, REPLICA_TYPE_FULL);
+      ASSERT_EQ(OB_SUCCESS, record.replicas_.push_back(replica));
+    }
+    if (0 == i % 2) {
+      snprintf(table_name_buf_, sizeof(table_name_buf_), "t%ld", i);
+      record.type_ = ObRouteSnapshotRecord::TABLE_RECORD;
+      record.name_.shallow_copy(ObString::make_string("cluster"), ObString::make_string("tenant"),
+                                ObString::make_string("db"), ObString::make_string(table_name_buf_));
+    } else {
+      record.type_ = ObRouteSnapshotRecord::PARTITION_RECORD;
+      record.partition_id_ = i;
+      record.part_num_ = 16;
+    }
+  }
+
+  // write record_count records into the snapshot file
+  void write_snapshot(const int64_t record_count)
+  {
+    ObRouteSnapshotWriter writer;
+    ObRouteSnapshotRecord record;
+    ASSERT_EQ(OB_SUCCESS, writer.init(buf_, buf_len_));
+    for (int64_t i = 0; i < record_count; ++i) {
+      build_record(i, record);
+      ASSERT_EQ(OB_SUCCESS, writer.append(record));
+    }
+    ASSERT_EQ(OB_SUCCESS, writer.add_cluster(ObString::make_string("cluster"), TEST_CR_ID, TEST_CR_VERSION));
+    ASSERT_EQ(OB_SUCCESS, writer.add_cluster(ObString::make_string("cluster"), TEST_CR_ID, TEST_CR_VERSION));
+    ASSERT_EQ(OB_SUCCESS, writer.finish(data_len_));
+    ASSERT_EQ(record_count, writer.get_record_count());
+
+    FILE *fp = fopen(TEST_SNAPSHOT_PATH, "w");
+    ASSERT_TRUE(NULL != fp);
+    ASSERT_EQ(static_cast<size_t>(data_len_), fwrite(buf_, 1, data_len_, fp));
+    ASSERT_EQ(0, fclose(fp));
+  }
+
+public:
+  char *buf_;
+  int64_t buf_len_;
+  int64_t data_len_;
+  char table_name_buf_[32];
+};
+
+TEST_F(TestRouteSnapshot, test_round_trip)
+{
+  const int64_t record_count = 1000;
+  write_snapshot(record_count);
+
+  ObRouteSnapshot snapshot;
+  ASSERT_EQ(OB_SUCCESS, snapshot.load(TEST_SNAPSHOT_PATH));
+  ASSERT_TRUE(snapshot.is_loaded());
+
+  int64_t cr_version = -1;
+  ASSERT_EQ(OB_SUCCESS, snapshot.get_cluster_version(ObString::make_string("cluster"), TEST_CR_ID, cr_version));
+  ASSERT_EQ(TEST_CR_VERSION, cr_version);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, snapshot.get_cluster_version(ObString::make_string("cluster"), TEST_CR_ID + 1, cr_version));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, snapshot.get_cluster_version(ObString::make_string("other"), TEST_CR_ID, cr_version));
+
+  int64_t pos = 0;
+  int64_t count = 0;
+  ObRouteSnapshotRecord record;
+  ObRouteSnapshotRecord expected;
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(snapshot.get_next_record(pos, record))) {
+    build_record(count, expected);
+    ASSERT_EQ(expected.type_, record.type_);
+    ASSERT_EQ(expected.cr_version_, record.cr_version_);
+    ASSERT_EQ(expected.table_id_, record.table_id_);
+    ASSERT_EQ(expected.partition_id_, record.partition_id_);
+    ASSERT_EQ(expected.part_num_, record.part_num_);
+    ASSERT_EQ(expected.schema_version_, record.schema_version_);
+    ASSERT_EQ(expected.frequency_, record.frequency_);
+    ASSERT_EQ(expected.replicas_.count(), record.replicas_.count());
+    for (int64_t j = 0; j < record.replicas_.count(); ++j) {
+      ASSERT_EQ(expected.replicas_.at(j).server_, record.replicas_.at(j).server_);
+      ASSERT_EQ(expected.replicas_.at(j).role_, record.replicas_.at(j).role_);
+    }
+    if (ObRouteSnapshotRecord::TABLE_RECORD == record.type_) {
+      ASSERT_TRUE(expected.name_ == record.name_);
+    }
+    ++count;
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+  ASSERT_EQ(record_count, count);
+
+  snapshot.destroy();
+  ASSERT_FALSE(snapshot.is_loaded());
+}
+
+TEST_F(TestRouteSnapshot, test_invalid_snapshot)
+{
+  ObRouteSnapshot snapshot;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, snapshot.load(TEST_SNAPSHOT_PATH));
+  ASSERT_FALSE(snapshot.is_loaded());
+
+  write_snapshot(100);
+  int64_t data_len = 0;
+  int64_t cluster_pos = 0;
+  ASSERT_EQ(OB_SUCCESS, ObRouteSnapshot::check_snapshot(buf_, data_len_, data_len, cluster_pos));
+  ASSERT_EQ(data_len_, data_len);
+
+  // a flipped byte is caught by the checksum
+  buf_[data_len_ / 2] ^= 0x5A;
+  ASSERT_EQ(OB_CHECKSUM_ERROR, ObRouteSnapshot::check_snapshot(buf_, data_len_, data_len, cluster_pos));
+  buf_[data_len_ / 2] ^= 0x5A;
+
+  // a truncated file is refused
+  ASSERT_EQ(OB_INVALID_DATA, ObRouteSnapshot::check_snapshot(buf_, data_len_ - 1, data_len, cluster_pos));
+  ASSERT_EQ(0, ::truncate(TEST_SNAPSHOT_PATH, data_len_ - 1));
+  ASSERT_EQ(OB_INVALID_DATA, snapshot.load(TEST_SNAPSHOT_PATH));
+  ASSERT_FALSE(snapshot.is_loaded());
+}
+
+TEST_F(TestRouteSnapshot, test_snapshot_full)
+{
+  ObRouteSnapshotWriter writer;
+  ObRouteSnapshotRecord record;
+  const int64_t buf_len = 16 * 1024;
+  ASSERT_EQ(OB_SUCCESS, writer.init(buf_, buf_len));
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  while (OB_SUCC(ret)) {
+    build_record(count, record);
+    if (OB_SUCC(writer.append(record))) {
+      ++count;
+    }
+  }
+  ASSERT_EQ(OB_SIZE_OVERFLOW, ret);
+  ASSERT_EQ(count, writer.get_record_count());
+  // the room of the clusters is kept
+  ASSERT_EQ(OB_SUCCESS, writer.add_cluster(ObString::make_string("cluster"), TEST_CR_ID, TEST_CR_VERSION));
+  ASSERT_EQ(OB_SUCCESS, writer.finish(data_len_));
+  int64_t data_len = 0;
+  int64_t cluster_pos = 0;
+  ASSERT_EQ(OB_SUCCESS, ObRouteSnapshot::check_snapshot(buf_, buf_len, data_len, cluster_pos));
+}
+
+TEST_F(TestRouteSnapshot, test_load_performance)
+{
+  const int64_t record_count = 100000;
+  write_snapshot(record_count);
+
+  ObRouteSnapshot snapshot;
+  const int64_t load_start_us = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_SUCCESS, snapshot.load(TEST_SNAPSHOT_PATH));
+  const int64_t load_cost_us = ObTimeUtility::current_time() - load_start_us;
+
+  int64_t pos = 0;
+  int64_t count = 0;
+  ObRouteSnapshotRecord record;
+  int ret = OB_SUCCESS;
+  const int64_t iter_start_us = ObTimeUtility::current_time();
+  while (OB_SUCC(snapshot.get_next_record(pos, record))) {
+    ++count;
+  }
+  const int64_t iter_cost_us = ObTimeUtility::current_time() - iter_start_us;
+  ASSERT_EQ(OB_ITER_END, ret);
+  ASSERT_EQ(record_count, count);
+
+  // the entries restore builds, without the cache insert and the remote fetch they save
+  pos = 0;
+  count = 0;
+  ret = OB_SUCCESS;
+  ObTableEntry *table_entry = NULL;
+  ObPartitionEntry *partition_entry = NULL;
+  const int64_t build_start_us = ObTimeUtility::current_time();
+  while (OB_SUCC(snapshot.get_next_record(pos, record))) {
+    if (ObRouteSnapshotRecord::TABLE_RECORD == record.type_) {
+      ASSERT_EQ(OB_SUCCESS, ObRouteSnapshot::build_table_entry(record, TEST_CR_ID, TEST_CR_VERSION + 1,
+                                                               table_entry));
+      table_entry->dec_ref();
+      table_entry = NULL;
+    } else {
+      ASSERT_EQ(OB_SUCCESS, ObPartitionEntry::alloc_and_init_partition_entry(record.table_id_,
+          record.partition_id_, TEST_CR_VERSION + 1, TEST_CR_ID, record.replicas_, partition_entry));
+      partition_entry->dec_ref();
+      partition_entry = NULL;
+    }
+    ++count;
+  }
+  const int64_t build_cost_us = ObTimeUtility::current_time() - build_start_us;
+  ASSERT_EQ(OB_ITER_END, ret);
+  ASSERT_EQ(record_count, count);
+  printf("route snapshot of %ld records, %ld bytes: load %ldus, iterate %ldus, build entries %ldus\n",
+         record_count, data_len_, load_cost_us, iter_cost_us, build_cost_us);
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
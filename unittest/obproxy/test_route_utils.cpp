@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "lib/charset/ob_charset.h"
+#include "common/ob_row.h"
+#include "proxy/route/ob_route_utils.h"
+#include "proxy/route/ob_table_entry.h"
+#include "proxy/mysqllib/ob_resultset_fetcher.h"
+#include "packet/ob_mysql_packet_util.h"
+#include "iocore/eventsystem/ob_io_buffer.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+using namespace obmysql;
+using namespace event;
+
+static const int64_t TEST_CLUSTER_VERSION = 4;
+static const int64_t TEST_SQL_LEN = 4096;
+static const int64_t MYSQL_BUFFER_SIZE = BUFFER_SIZE_FOR_INDEX(BUFFER_SIZE_INDEX_8K);
+
+static const char *const STR_COLUMNS[] = {"database_name", "table_name", "svr_ip"};
+static const char *const INT_COLUMNS[] = {"sql_port", "table_id", "role", "part_num", "replica_num",
+                                          "schema_version", "replica_type", "dup_replica_type",
+                                          "table_type"};
+static const int64_t STR_COLUMN_COUNT = sizeof(STR_COLUMNS) / sizeof(STR_COLUMNS[0]);
+static const int64_t INT_COLUMN_COUNT = sizeof(INT_COLUMNS) / sizeof(INT_COLUMNS[0]);
+static const int64_t COLUMN_COUNT = STR_COLUMN_COUNT + INT_COLUMN_COUNT;
+
+class TestRouteUtils : public ::testing::Test
+{
+public:
+  TestRouteUtils() : write_buf_(NULL), reader_(NULL), seq_(0) {}
+
+  virtual void SetUp()
+  {
+    write_buf_ = new_miobuffer(MYSQL_BUFFER_SIZE);
+    ASSERT_TRUE(NULL != write_buf_);
+    reader_ = write_buf_->alloc_reader();
+    ASSERT_TRUE(NULL != reader_);
+  }
+
+  virtual void TearDown()
+  {
+    for (int64_t i = 0; i < entries_.count(); ++i) {
+      entries_.at(i)->dec_ref();
+    }
+    entries_.reset();
+    free_miobuffer(write_buf_);
+    write_buf_ = NULL;
+    reader_ = NULL;
+  }
+
+  void add_entry(const char *database_name, const char *table_name)
+  {
+    ObTableEntryName name;
+    ObTableEntry *entry = NULL;
+    name.shallow_copy(ObString::make_string("cluster"), ObString::make_string("tenant"),
+                      ObString::make_string(database_name), ObString::make_string(table_name));
+    ASSERT_EQ(OB_SUCCESS, ObTableEntry::alloc_and_init_table_entry(name, 1, 1, entry));
+    ASSERT_EQ(OB_SUCCESS, entries_.push_back(entry));
+  }
+
+  void write_header()
+  {
+    ObSEArray<ObMySQLField, COLUMN_COUNT> fields;
+    ObMySQLField field;
+    field.charsetnr_ = ObCharset::get_default_collation(ObCharset::get_default_charset());
+    for (int64_t i = 0; i < COLUMN_COUNT; ++i) {
+      const char *cname = (i < STR_COLUMN_COUNT) ? STR_COLUMNS[i] : INT_COLUMNS[i - STR_COLUMN_COUNT];
+      field.cname_ = ObString::make_string(cname);
+      field.org_cname_ = field.cname_;
+      field.type_ = (i < STR_COLUMN_COUNT) ? OB_MYSQL_TYPE_VAR_STRING : OB_MYSQL_TYPE_LONGLONG;
+      ASSERT_EQ(OB_SUCCESS, fields.push_back(field));
+    }
+    ASSERT_EQ(OB_SUCCESS, ObMysqlPacketUtil::encode_header(*write_buf_, seq_, fields));
+  }
+
+  // one replica of a non partition table
+  void write_row(const char *database_name, const char *table_name, const int64_t port,
+                 const int64_t table_id, const int64_t role)
+  {
+    ObObj cells[COLUMN_COUNT];
+    const int64_t int_values[] = {port, table_id, role, 1, 3, 100, 0, 0, 3};
+    cells[0].set_varchar(database_name);
+    cells[1].set_varchar(table_name);
+    cells[2].set_varchar("127.0.0.1");
+    for (int64_t i = 0; i < STR_COLUMN_COUNT; ++i) {
+      cells[i].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+    }
+    for (int64_t i = 0; i < INT_COLUMN_COUNT; ++i) {
+      cells[STR_COLUMN_COUNT + i].set_int(int_values[i]);
+    }
+    ObNewRow row;
+    row.assign(cells, COLUMN_COUNT);
+    ASSERT_EQ(OB_SUCCESS, ObMysqlPacketUtil::encode_row_packet(*write_buf_, seq_, row));
+  }
+
+  void write_eof()
+  {
+    ASSERT_EQ(OB_SUCCESS, ObMysqlPacketUtil::encode_eof_packet(*write_buf_, seq_));
+  }
+
+public:
+  ObMIOBuffer *write_buf_;
+  ObIOBufferReader *reader_;
+  uint8_t seq_;
+  ObSEArray<ObTableEntry *, 4> entries_;
+};
+
+TEST_F(TestRouteUtils, test_get_batch_table_entry_sql)
+{
+  char sql[TEST_SQL_LEN];
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObRouteUtils::get_batch_table_entry_sql(sql, TEST_SQL_LEN, entries_,
+                                                                        false, TEST_CLUSTER_VERSION));
+  add_entry("db1", "t1");
+  add_entry("db1", "t2");
+  add_entry("db1", "t1");
+  add_entry("db2", "t1");
+  ASSERT_EQ(OB_SUCCESS, ObRouteUtils::get_batch_table_entry_sql(sql, TEST_SQL_LEN, entries_,
+                                                                false, TEST_CLUSTER_VERSION));
+  // the same table is queried once
+  ASSERT_TRUE(NULL != strstr(sql, "tenant_name = 'tenant' AND (database_name, table_name) IN "
+                                  "(('db1', 't1'), ('db1', 't2'), ('db2', 't1'))"));
+  ASSERT_TRUE(NULL != strstr(sql, "tablet_id = 0"));
+  ASSERT_TRUE(NULL != strstr(sql, "ORDER BY database_name ASC, table_name ASC, role ASC"));
+  ASSERT_TRUE(NULL == strstr(sql, "FORCE_REFRESH_LOCATION_CACHE"));
+
+  ASSERT_EQ(OB_SUCCESS, ObRouteUtils::get_batch_table_entry_sql(sql, TEST_SQL_LEN, entries_, true, 3));
+  ASSERT_TRUE(NULL != strstr(sql, "FORCE_REFRESH_LOCATION_CACHE"));
+  ASSERT_TRUE(NULL != strstr(sql, "partition_id = 0"));
+
+  ASSERT_EQ(OB_SIZE_OVERFLOW, ObRouteUtils::get_batch_table_entry_sql(sql, 64, entries_,
+                                                                      false, TEST_CLUSTER_VERSION));
+}
+
+TEST_F(TestRouteUtils, test_fetch_batch_table_entry)
+{
+  add_entry("db1", "t1");
+  add_entry("db1", "t2");
+  add_entry("db1", "t3");
+  add_entry("db1", "t1");
+
+  // t3 has no rows, the rows of an unexpected table are skipped
+  write_header();
+  write_row("db1", "t1", 2881, 1001, 1);
+  write_row("db1", "t1", 2882, 1001, 2);
+  write_row("db1", "t2", 2883, 1002, 1);
+  write_row("db1", "tx", 2884, 1009, 1);
+  write_eof();
+
+  ObResultSetFetcher rs_fetcher;
+  ASSERT_EQ(OB_SUCCESS, rs_fetcher.init(reader_));
+  ASSERT_EQ(OB_SUCCESS, ObRouteUtils::fetch_batch_table_entry(rs_fetcher, entries_, TEST_CLUSTER_VERSION));
+
+  const ObProxyPartitionLocation *pl = NULL;
+  for (int64_t i = 0; i < entries_.count(); i += 3) {
+    // both entries of t1 are filled
+    ASSERT_EQ(1001, entries_.at(i)->get_table_id());
+    ASSERT_EQ(100, entries_.at(i)->get_schema_version());
+    ASSERT_TRUE(NULL != (pl = entries_.at(i)->get_first_pl()));
+    ASSERT_EQ(2, pl->replica_count());
+    ASSERT_EQ(2881, pl->get_leader()->server_.get_port());
+  }
+  ASSERT_EQ(1002, entries_.at(1)->get_table_id());
+  ASSERT_TRUE(NULL != (pl = entries_.at(1)->get_first_pl()));
+  ASSERT_EQ(1, pl->replica_count());
+  ASSERT_EQ(OB_INVALID_ID, entries_.at(2)->get_table_id());
+  ASSERT_TRUE(NULL == entries_.at(2)->get_first_pl());
+}
+
+TEST_F(TestRouteUtils, test_fetch_batch_table_entry_out_of_order)
+{
+  add_entry("db1", "t1");
+  add_entry("db1", "t2");
+
+  // the rows of a table must be together
+  write_header();
+  write_row("db1", "t1", 2881, 1001, 1);
+  write_row("db1", "t2", 2882, 1002, 1);
+  write_row("db1", "t1", 2883, 1001, 2);
+  write_eof();
+
+  ObResultSetFetcher rs_fetcher;
+  ASSERT_EQ(OB_SUCCESS, rs_fetcher.init(reader_));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, ObRouteUtils::fetch_batch_table_entry(rs_fetcher, entries_, TEST_CLUSTER_VERSION));
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
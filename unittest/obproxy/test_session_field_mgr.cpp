@@ -19,6 +19,8 @@
 #include "lib/string/ob_string.h"
 #include "lib/number/ob_number_v2.h"
 #include "obproxy/proxy/mysqllib/ob_session_field_mgr.h"
+#include "obproxy/proxy/mysqllib/ob_proxy_session_info.h"
+#include "obproxy/proxy/mysqllib/ob_proxy_session_info_handler.h"
 #include "ob_session_vars_test_utils.h"
 
 using namespace oceanbase::common;
@@ -315,6 +317,104 @@ TEST_F(TestSessionFieldMgr, test_move_strings)
   //ASSERT_TRUE(OB_SUCCESS == mgr_.replace_user_variable(ObString::make_string("7"), value));
 }
 
+TEST_F(TestSessionFieldMgr, test_sync_changed_sys_var)
+{
+  ObClientSessionInfo client_info;
+  ObServerSessionInfo synced_info;
+  ObServerSessionInfo fresh_info;
+  ObSqlString sql;
+  ObObj value;
+  ASSERT_EQ(OB_SUCCESS, client_info.init());
+  ASSERT_EQ(OB_SUCCESS, client_info.add_sys_var_set(g_default_sys_var_set));
+  ASSERT_EQ(OB_SUCCESS, synced_info.init());
+  ASSERT_EQ(OB_SUCCESS, fresh_info.init());
+
+  value.set_int(0);
+  ASSERT_EQ(OB_SUCCESS, client_info.update_sys_variable(ObString::make_string(sql::OB_SV_AUTOCOMMIT), value));
+  value.set_int(10000000);
+  ASSERT_EQ(OB_SUCCESS, client_info.update_sys_variable(ObString::make_string(sql::OB_SV_QUERY_TIMEOUT), value));
+  ASSERT_EQ(OB_SUCCESS, ObProxySessionInfoHandler::assign_session_vars_version(client_info, synced_info));
+  ASSERT_EQ(OB_SUCCESS, client_info.extract_variable_reset_sql(synced_info, sql));
+  ASSERT_TRUE(sql.empty());
+
+  // the same value again needs no sync
+  value.set_int(0);
+  ASSERT_EQ(OB_SUCCESS, client_info.update_sys_variable(ObString::make_string(sql::OB_SV_AUTOCOMMIT), value));
+  ASSERT_EQ(1, client_info.get_same_value_sys_var_set_count());
+  ASSERT_EQ(OB_SUCCESS, client_info.extract_variable_reset_sql(synced_info, sql));
+  ASSERT_TRUE(sql.empty());
+
+  // a new value only syncs the changed field
+  value.set_int(1);
+  ASSERT_EQ(OB_SUCCESS, client_info.update_sys_variable(ObString::make_string(sql::OB_SV_AUTOCOMMIT), value));
+  ASSERT_EQ(OB_SUCCESS, client_info.extract_variable_reset_sql(synced_info, sql));
+  LOG_INFO("changed reset sql", K(sql));
+  ASSERT_TRUE(NULL != strstr(sql.ptr(), "@@autocommit = 1"));
+  ASSERT_TRUE(NULL == strstr(sql.ptr(), "@@ob_query_timeout"));
+
+  // a new server session gets every field
+  sql.reset();
+  ASSERT_EQ(OB_SUCCESS, client_info.extract_variable_reset_sql(fresh_info, sql));
+  LOG_INFO("fresh reset sql", K(sql));
+  ASSERT_TRUE(NULL != strstr(sql.ptr(), "@@autocommit = 1"));
+  ASSERT_TRUE(NULL != strstr(sql.ptr(), "@@ob_query_timeout = 10000000"));
+
+  // a field never stamped, as one loaded without the client session info, is always synced
+  ObSessionSysField *field = NULL;
+  ASSERT_EQ(OB_SUCCESS, client_info.get_sys_variable(ObString::make_string(sql::OB_SV_QUERY_TIMEOUT), field));
+  field->version_ = 0;
+  sql.reset();
+  ASSERT_EQ(OB_SUCCESS, client_info.extract_variable_reset_sql(synced_info, sql));
+  ASSERT_TRUE(NULL != strstr(sql.ptr(), "@@autocommit = 1"));
+  ASSERT_TRUE(NULL != strstr(sql.ptr(), "@@ob_query_timeout = 10000000"));
+}
+
+TEST_F(TestSessionFieldMgr, test_sys_var_id)
+{
+  const int64_t id_count = ObSysVarIdMap::get_sys_var_id_count();
+  ASSERT_TRUE(id_count > 0);
+  ASSERT_TRUE(id_count <= ObSysVarIdMap::MAX_SYS_VAR_ID_NUM);
+  for (int64_t id = 0; id < id_count; ++id) {
+    ObString name = ObSysVarIdMap::get_sys_var_name(id);
+    ASSERT_FALSE(name.empty());
+    ASSERT_EQ(id, ObSysVarIdMap::get_sys_var_id(name));
+  }
+  ASSERT_EQ(2, ObSysVarIdMap::get_sys_var_id(ObString::make_string(sql::OB_SV_AUTOCOMMIT)));
+  ASSERT_TRUE(ObSysVarIdMap::INVALID_SYS_VAR_ID == ObSysVarIdMap::get_sys_var_id(ObString::make_string("AUTOCOMMIT")));
+  ASSERT_TRUE(ObSysVarIdMap::INVALID_SYS_VAR_ID == ObSysVarIdMap::get_sys_var_id(ObString::make_string("autocommi")));
+  ASSERT_TRUE(ObSysVarIdMap::INVALID_SYS_VAR_ID == ObSysVarIdMap::get_sys_var_id(ObString::make_empty_string()));
+  ASSERT_TRUE(ObSysVarIdMap::get_sys_var_name(id_count).empty());
+
+  // known and unknown names are both found, by id and by walking the blocks
+  ASSERT_EQ(OB_SUCCESS, mgr_.init());
+  ObObj value_in;
+  ObObj value_out;
+  char name_buf[32];
+  for (int64_t i = 0; i < id_count; ++i) {
+    value_in.set_int(i);
+    ASSERT_EQ(OB_SUCCESS, mgr_.replace_common_sys_variable(ObSysVarIdMap::get_sys_var_name(i), value_in, false));
+    snprintf(name_buf, sizeof(name_buf), "unknown_var_%ld", i);
+    ASSERT_EQ(OB_SUCCESS, mgr_.replace_common_sys_variable(ObString::make_string(name_buf), value_in, false));
+  }
+  for (int64_t i = 0; i < id_count; ++i) {
+    ASSERT_EQ(OB_SUCCESS, mgr_.get_common_sys_variable_value(ObSysVarIdMap::get_sys_var_name(i), value_out));
+    if (ObSysVarIdMap::get_sys_var_name(i) == ObString::make_string(sql::OB_SV_CHARACTER_SET_RESULTS)) {
+      // nullable, a value without length is stored as null
+      ASSERT_TRUE(value_out.is_null());
+    } else {
+      ASSERT_EQ(i, value_out.get_int());
+    }
+    snprintf(name_buf, sizeof(name_buf), "unknown_var_%ld", i);
+    ASSERT_EQ(OB_SUCCESS, mgr_.get_common_sys_variable_value(ObString::make_string(name_buf), value_out));
+    ASSERT_EQ(i, value_out.get_int());
+  }
+  value_in.set_int(100);
+  ASSERT_EQ(OB_SUCCESS, mgr_.replace_common_sys_variable(ObString::make_string(sql::OB_SV_AUTOCOMMIT), value_in, false));
+  ASSERT_EQ(OB_SUCCESS, mgr_.get_common_sys_variable_value(ObString::make_string(sql::OB_SV_AUTOCOMMIT), value_out));
+  ASSERT_EQ(100, value_out.get_int());
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, mgr_.get_mysql_sys_variable_value(ObString::make_string(sql::OB_SV_AUTOCOMMIT), value_out));
+}
+
 }//end of namespace proxy
 }//end of namespace obproxy
 }//end of namespace oceanbase
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "utils/ob_cpu_affinity.h"
+#include "iocore/net/ob_unix_net_vconnection.h"
+#include "proxy/mysql/ob_mysql_server_session.h"
+#include "proxy/mysql/ob_mysql_global_session_manager.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+using namespace event;
+using namespace net;
+
+static int parse_cpu_line(ObCpuTopology &topology, const char *line)
+{
+  char buf[BUFSIZ];
+  snprintf(buf, sizeof(buf), "%s", line);
+  return topology.parse_cpu_line(buf);
+}
+
+TEST(TestSessionPoolLocality, numa_ordered_core_id)
+{
+  // two nodes, cores of node 0 and node 1 interleaved, core 1 has two cpus
+  ObCpuTopology topology;
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "0,0,0,0,,0,0,0,0\n"));
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "1,1,1,1,,1,1,1,1\n"));
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "2,2,0,0,,2,2,2,0\n"));
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "3,3,1,1,,3,3,3,1\n"));
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "4,1,1,1,,1,1,1,1\n"));
+  topology.build_numa_ordered_core_ids();
+
+  ASSERT_EQ(4, topology.get_core_number());
+  ASSERT_EQ(5, topology.get_cpu_number());
+  ASSERT_EQ(2, topology.get_numa_node_number());
+  ASSERT_EQ(2, topology.get_core_info(1)->cpu_number_);
+  ASSERT_EQ(1, topology.get_core_info(3)->node_id_);
+
+  // node 0 first, then node 1
+  ASSERT_EQ(0, topology.get_numa_ordered_core_id(0));
+  ASSERT_EQ(2, topology.get_numa_ordered_core_id(1));
+  ASSERT_EQ(1, topology.get_numa_ordered_core_id(2));
+  ASSERT_EQ(3, topology.get_numa_ordered_core_id(3));
+  // out of range, used as it is
+  ASSERT_EQ(4, topology.get_numa_ordered_core_id(4));
+}
+
+TEST(TestSessionPoolLocality, numa_ordered_core_id_without_numa)
+{
+  // the node column is missing, every core is on node 0
+  ObCpuTopology topology;
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "0,0,0\n"));
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "1,1,0\n"));
+  ASSERT_EQ(OB_SUCCESS, parse_cpu_line(topology, "2,2,0\n"));
+  topology.build_numa_ordered_core_ids();
+
+  ASSERT_EQ(1, topology.get_numa_node_number());
+  for (int64_t i = 0; i < topology.get_core_number(); ++i) {
+    ASSERT_EQ(i, topology.get_numa_ordered_core_id(i));
+  }
+
+  ASSERT_EQ(OB_INVALID_ARGUMENT, parse_cpu_line(topology, "0\n"));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, parse_cpu_line(topology, "0,128,0,0\n"));
+}
+
+TEST(TestSessionPoolLocality, acquire_local_first)
+{
+  ObMysqlServerSessionList list;
+  ASSERT_EQ(OB_SUCCESS, list.init());
+
+  ObEThread local_thread;
+  ObEThread remote_thread;
+  local_thread.id_ = 3;
+  remote_thread.id_ = 4;
+  ObUnixNetVConnection local_vc;
+  ObUnixNetVConnection remote_vc;
+  local_vc.thread_ = &local_thread;
+  remote_vc.thread_ = &remote_thread;
+  ObMysqlServerSession local_ss;
+  ObMysqlServerSession remote_ss;
+  local_ss.server_vc_ = &local_vc;
+  remote_ss.server_vc_ = &remote_vc;
+
+  ASSERT_EQ(3, list.get_session_slot(local_ss));
+  ASSERT_EQ(4, list.get_session_slot(remote_ss));
+
+  // the remote one is released first, a plain lifo list would hand it out first
+  list.server_session_list_[list.get_session_slot(remote_ss)].push(&remote_ss);
+  list.server_session_list_[list.get_session_slot(local_ss)].push(&local_ss);
+  list.total_count_ = 2;
+  list.free_count_ = 2;
+
+  local_thread.set_specific();
+  ASSERT_EQ(&local_ss, list.acquire_from_list());
+  ASSERT_EQ(1, list.local_acquire_count_);
+  ASSERT_EQ(0, list.remote_acquire_count_);
+
+  // nothing left on this thread, steal from another one
+  ASSERT_EQ(&remote_ss, list.acquire_from_list());
+  ASSERT_EQ(1, list.local_acquire_count_);
+  ASSERT_EQ(1, list.remote_acquire_count_);
+  ASSERT_EQ(0, list.free_count_);
+  ASSERT_EQ(2, list.max_used_);
+
+  ASSERT_TRUE(NULL == list.acquire_from_list());
+  ASSERT_EQ(1, list.local_acquire_count_);
+  ASSERT_EQ(1, list.remote_acquire_count_);
+
+  // a session without vc or thread goes to the first slot
+  ObMysqlServerSession orphan_ss;
+  ASSERT_EQ(0, list.get_session_slot(orphan_ss));
+  this_thread() = NULL;
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "lib/string/ob_sql_string.h"
+#include "proxy/mysqllib/ob_proxy_session_info.h"
+#include "proxy/shard/obproxy_shard_utils.h"
+#include "ob_session_vars_test_utils.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+
+ObDefaultSysVarSet g_default_sys_var_set;
+ObArenaAllocator g_allocator(ObModIds::TEST);
+
+class TestShardMultiStmt : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    ASSERT_EQ(OB_SUCCESS, g_default_sys_var_set.init());
+    ObSessionVarsTestUtils::load_default_system_variables(g_allocator, g_default_sys_var_set, true);
+  }
+
+  static bool contains(const ObSqlString &sql, const char *str)
+  {
+    return NULL != strstr(sql.ptr(), str);
+  }
+};
+
+TEST_F(TestShardMultiStmt, test_session_sql_empty)
+{
+  ObClientSessionInfo session;
+  ObSqlString session_sql;
+  ASSERT_EQ(OB_SUCCESS, session.init());
+  ASSERT_EQ(OB_SUCCESS, session.add_sys_var_set(g_default_sys_var_set));
+  // nothing is set by the client, the executor connections need no sync
+  ASSERT_EQ(OB_SUCCESS, ObProxyShardUtils::build_multi_stmt_session_sql(session, session_sql));
+  ASSERT_TRUE(session_sql.empty());
+}
+
+TEST_F(TestShardMultiStmt, test_session_sql)
+{
+  ObClientSessionInfo session;
+  ObSqlString session_sql;
+  ASSERT_EQ(OB_SUCCESS, session.init());
+  ASSERT_EQ(OB_SUCCESS, session.add_sys_var_set(g_default_sys_var_set));
+
+  ObObj value;
+  value.set_varchar(ObString::make_string("STRICT_TRANS_TABLES"));
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, session.update_sys_variable(ObString::make_string("sql_mode"), value));
+  value.set_varchar(ObString::make_string("utf8mb4"));
+  ASSERT_EQ(OB_SUCCESS, session.update_sys_variable(ObString::make_string("character_set_results"), value));
+  value.set_int(7);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(ObString::make_string("v"), value));
+
+  ASSERT_EQ(OB_SUCCESS, ObProxyShardUtils::build_multi_stmt_session_sql(session, session_sql));
+  LOG_INFO("multi stmt session sql", K(session_sql));
+  ASSERT_TRUE(contains(session_sql, "SET"));
+  ASSERT_TRUE(contains(session_sql, "@@sql_mode = 'STRICT_TRANS_TABLES'"));
+  ASSERT_TRUE(contains(session_sql, "@@character_set_results = 'utf8mb4'"));
+  ASSERT_TRUE(contains(session_sql, "@v = 7"));
+  ASSERT_EQ(';', session_sql.ptr()[session_sql.length() - 1]);
+
+  // every executor connection is new, the same sql is built each time
+  ObSqlString again_sql;
+  ASSERT_EQ(OB_SUCCESS, ObProxyShardUtils::build_multi_stmt_session_sql(session, again_sql));
+  ASSERT_EQ(session_sql.string(), again_sql.string());
+}
+
+TEST_F(TestShardMultiStmt, test_session_sql_unversioned)
+{
+  ObClientSessionInfo session;
+  ObSqlString session_sql;
+  ASSERT_EQ(OB_SUCCESS, session.init());
+  ASSERT_EQ(OB_SUCCESS, session.add_sys_var_set(g_default_sys_var_set));
+
+  ObObj value;
+  value.set_varchar(ObString::make_string("STRICT_TRANS_TABLES"));
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, session.update_sys_variable(ObString::make_string("sql_mode"), value));
+  value.set_int(7);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(ObString::make_string("v"), value));
+
+  // variables loaded without being stamped, such as the ones of the login, are sent as well
+  session.version_.reset();
+  ObSessionSysField *field = NULL;
+  ASSERT_EQ(OB_SUCCESS, session.field_mgr_.get_sys_variable(ObString::make_string("sql_mode"), field));
+  ASSERT_TRUE(NULL != field);
+  field->version_ = 0;
+
+  ASSERT_EQ(OB_SUCCESS, ObProxyShardUtils::build_multi_stmt_session_sql(session, session_sql));
+  ASSERT_TRUE(contains(session_sql, "@@sql_mode = 'STRICT_TRANS_TABLES'"));
+  ASSERT_TRUE(contains(session_sql, "@v = 7"));
+  ASSERT_EQ(';', session_sql.ptr()[session_sql.length() - 1]);
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
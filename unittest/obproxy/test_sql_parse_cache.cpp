@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "obutils/ob_proxy_sql_parse_cache.h"
+#include "obutils/ob_proxy_sql_parser.h"
+#include "obutils/ob_proxy_config.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace obutils;
+
+static const int64_t TEST_SQL_BUF_SIZE = 1024;
+
+class TestSqlParseCache : public ::testing::Test
+{
+public:
+  virtual void SetUp();
+  virtual void TearDown();
+  // the parser wants two trailing '\0'
+  ObString make_sql(const char *sql, char *buf);
+  int make_fingerprint(const char *sql, char *buf, ObSqlParseCache &cache);
+  void parse(const char *sql, ObSqlParseResult &result, char *buf = NULL);
+  void check_same_result(const char *first, const char *second);
+
+public:
+  char buf1_[TEST_SQL_BUF_SIZE];
+  char buf2_[TEST_SQL_BUF_SIZE];
+  char buf3_[TEST_SQL_BUF_SIZE];
+};
+
+void TestSqlParseCache::SetUp()
+{
+  // the fast parser takes the simple ones before the cache
+  ASSERT_TRUE(get_global_proxy_config().enable_sql_fast_parse.set_value("false"));
+  ASSERT_TRUE(get_global_proxy_config().sql_parse_cache_mem_limited.set_value("2MB"));
+}
+
+void TestSqlParseCache::TearDown()
+{
+  ASSERT_TRUE(get_global_proxy_config().enable_sql_fast_parse.set_value("true"));
+  ASSERT_TRUE(get_global_proxy_config().sql_parse_cache_mem_limited.set_value("2MB"));
+  if (NULL != ObSqlParseCache::get_thread_cache()) {
+    ObSqlParseCache::get_thread_cache()->set_mem_limit(0);
+  }
+}
+
+ObString TestSqlParseCache::make_sql(const char *sql, char *buf)
+{
+  const int64_t len = strlen(sql);
+  MEMSET(buf, 0, TEST_SQL_BUF_SIZE);
+  MEMCPY(buf, sql, len);
+  return ObString(static_cast<int32_t>(len + 2), buf);
+}
+
+int TestSqlParseCache::make_fingerprint(const char *sql, char *buf, ObSqlParseCache &cache)
+{
+  return cache.make_fingerprint(make_sql(sql, buf), NORMAL_PARSE_MODE);
+}
+
+void TestSqlParseCache::parse(const char *sql, ObSqlParseResult &result, char *buf)
+{
+  ObProxySqlParser sql_parser;
+  ASSERT_EQ(OB_SUCCESS, sql_parser.parse_sql(make_sql(sql, NULL == buf ? buf1_ : buf), NORMAL_PARSE_MODE, result,
+                                             false, CS_TYPE_UTF8MB4_GENERAL_CI));
+}
+
+// the second sql must be the same as the uncached one, after a hit on the first
+void TestSqlParseCache::check_same_result(const char *first, const char *second)
+{
+  ObSqlParseResult expected;
+  ObSqlParseResult result;
+  ObSqlParseResult first_result;
+  ObSqlParseCache *cache = NULL;
+
+  ASSERT_TRUE(get_global_proxy_config().sql_parse_cache_mem_limited.set_value("0"));
+  parse(second, expected, buf1_);
+  ASSERT_TRUE(get_global_proxy_config().sql_parse_cache_mem_limited.set_value("2MB"));
+  parse(first, first_result, buf2_);
+  ASSERT_EQ(OB_SUCCESS, ObSqlParseCache::get_or_create_thread_cache(cache));
+  const int64_t hit_count = cache->hit_count_;
+  parse(second, result, buf3_);
+  ASSERT_EQ(hit_count + 1, cache->hit_count_) << second;
+
+  ASSERT_EQ(expected.get_stmt_type(), result.get_stmt_type());
+  ASSERT_EQ(expected.get_parsed_length(), result.get_parsed_length());
+  ASSERT_EQ(expected.get_database_name(), result.get_database_name());
+  ASSERT_EQ(expected.get_table_name(), result.get_table_name());
+  ASSERT_EQ(expected.get_alias_name(), result.get_alias_name());
+  ASSERT_EQ(expected.get_part_name(), result.get_part_name());
+  ASSERT_EQ(expected.get_table_name_quote(), result.get_table_name_quote());
+  ASSERT_EQ(expected.hint_query_timeout_, result.hint_query_timeout_);
+  ASSERT_EQ(expected.has_last_insert_id_, result.has_last_insert_id_);
+  ASSERT_EQ(expected.has_simple_route_info(), result.has_simple_route_info());
+  ASSERT_EQ(expected.route_info_.table_offset_, result.route_info_.table_offset_);
+  ASSERT_EQ(expected.route_info_.part_key_offset_, result.route_info_.part_key_offset_);
+  ASSERT_EQ(expected.trace_id_, result.trace_id_);
+}
+
+TEST_F(TestSqlParseCache, test_fingerprint)
+{
+  ObSqlParseCache *cache = new ObSqlParseCache();
+  char key_buf[TEST_SQL_BUF_SIZE];
+  ObString key;
+
+  // literals of the same class share one fingerprint
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t1 where a = 1 and b = 'x y' and c = 1.5", buf1_, *cache));
+  MEMCPY(key_buf, cache->fingerprint_.buf_, cache->fingerprint_.len_);
+  key.assign_ptr(key_buf, static_cast<int32_t>(cache->fingerprint_.len_));
+  ASSERT_EQ(3, cache->fingerprint_.literal_count_);
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t1 where a = 9999 and b = '' and c = 32.", buf2_, *cache));
+  ASSERT_NE(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t1 where a = 9999 and b = 'hi, u' and c = 32.", buf2_, *cache));
+  ASSERT_EQ(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+
+  // but not those the lexer tells apart
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t1 where a = 123456789012345678 and b = 'x y' and c = 1.5", buf2_, *cache));
+  ASSERT_NE(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t1 where a = 1 and b = 'xy' and c = 1.5", buf2_, *cache));
+  ASSERT_NE(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t2 where a = 1 and b = 'x y' and c = 1.5", buf2_, *cache));
+  ASSERT_NE(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+
+  // comments, quoted names and numbers within words are kept
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select /*+ query_timeout(100) */ `a1`, \"b2\", c3, 0x1f, 1e5 from t", buf1_, *cache));
+  ASSERT_EQ(0, cache->fingerprint_.literal_count_);
+  ASSERT_EQ(cache->fingerprint_.sql_len_, cache->fingerprint_.len_);
+
+  // values of a leading trace comment and digit runs of later comments are literals
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("/* trace_id=0a1b-2c, rpc_id=0.1 */ select * from t /* seq 12 */", buf1_, *cache));
+  MEMCPY(key_buf, cache->fingerprint_.buf_, cache->fingerprint_.len_);
+  key.assign_ptr(key_buf, static_cast<int32_t>(cache->fingerprint_.len_));
+  ASSERT_EQ(3, cache->fingerprint_.literal_count_);
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("/* trace_id=Y-0005AF51, rpc_id=0.1.2.3 */ select * from t /* seq 5-0 */", buf2_, *cache));
+  ASSERT_EQ(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("/* trace_id=Y-0005AF51, rpc_id=0.1.2.3 */ select * from t /* seq abc */", buf2_, *cache));
+  ASSERT_NE(key, ObString(static_cast<int32_t>(cache->fingerprint_.len_), cache->fingerprint_.buf_));
+
+  // but not route info, words, and comments before the statement keyword
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("/* group_id=1 */ select * from t", buf1_, *cache));
+  ASSERT_EQ(0, cache->fingerprint_.literal_count_);
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("/* trace_id=1, group_id=1 */ select * from t", buf1_, *cache));
+  ASSERT_EQ(0, cache->fingerprint_.literal_count_);
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("select * from t /* found_rows-1 a--1 */", buf1_, *cache));
+  ASSERT_EQ(0, cache->fingerprint_.literal_count_);
+  ASSERT_EQ(OB_SUCCESS, make_fingerprint("set @a = 1; /* 1 */ select 1", buf1_, *cache));
+  ASSERT_EQ(2, cache->fingerprint_.literal_count_);
+
+  // the lexer may not agree with us on these
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("select * from t where a = 'it\\'s'", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("select * from t where a = 'it''s'", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("select * from t where a = x'1f'", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("select * from t where a = 'abc", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("select /* it's */ * from t", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("select * from t -- it's\n where a = 1", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("insert all when a > 1 then into t1 values(1) select 1 from dual", buf1_, *cache));
+  ASSERT_EQ(OB_NOT_SUPPORTED, make_fingerprint("declare a int; begin select 1 from dual; end", buf1_, *cache));
+
+  delete cache;
+}
+
+TEST_F(TestSqlParseCache, test_same_result)
+{
+  check_same_result("select * from db1.t1 a where id = 1 and name = 'abc'",
+                    "select * from db1.t1 a where id = 22 and name = 'xyz12'");
+  check_same_result("update t1 set c = 'hello world' where id = 5",
+                    "update t1 set c = 'bye, now' where id = 123");
+  check_same_result("insert into t1 partition(p1) values(1, 'a b', 3.14)",
+                    "insert into t1 partition(p1) values(2222, 'c d e', 2.5)");
+  check_same_result("delete /*+ query_timeout(1000) */ from test.t where k in (1, 2, 3)",
+                    "delete /*+ query_timeout(1000) */ from test.t where k in (7, 8, 9)");
+  check_same_result("select * from `t-1` x where a = 10 and b = 'm n'",
+                    "select * from `t-1` x where a = 20000 and b = 'mm nn'");
+  check_same_result("replace into t2(a, b) values(1, 'v v')",
+                    "replace into t2(a, b) values(987654, 'w w w')");
+  check_same_result("select last_insert_id(), a from t3 where b = 1",
+                    "select last_insert_id(), a from t3 where b = 2");
+  check_same_result("/* trace_id=0a1b-2c, rpc_id=0.1 */ select * from t1 where id = 1",
+                    "/* trace_id=YB42-0005AF51B2F1, rpc_id=0.1.2.3 */ select * from t1 where id = 22");
+  check_same_result("select * from t1 /* seq 101 */ where id = 1",
+                    "select * from t1 /* seq 20002 */ where id = 5");
+}
+
+TEST_F(TestSqlParseCache, test_not_cacheable)
+{
+  ObSqlParseCache *cache = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObSqlParseCache::get_or_create_thread_cache(cache));
+  cache->set_mem_limit(0);
+
+  // not dml
+  ObSqlParseResult result1;
+  parse("set autocommit = 1", result1);
+  ASSERT_EQ(0, cache->get_entry_count());
+
+  // the table name is the literal
+  ObSqlParseResult result2;
+  parse("select * from 123456789012345678901", result2);
+  ASSERT_EQ(0, cache->get_entry_count());
+
+  // cache off, nothing is looked up
+  ASSERT_TRUE(get_global_proxy_config().sql_parse_cache_mem_limited.set_value("0"));
+  const int64_t miss_count = cache->miss_count_;
+  ObSqlParseResult result3;
+  parse("select * from t where a = 1", result3);
+  ASSERT_EQ(miss_count, cache->miss_count_);
+  ASSERT_EQ(0, cache->get_entry_count());
+  ASSERT_EQ(OBPROXY_T_SELECT, result3.get_stmt_type());
+}
+
+TEST_F(TestSqlParseCache, test_trace_id)
+{
+  ObSqlParseCache *cache = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObSqlParseCache::get_or_create_thread_cache(cache));
+  ObSqlParseResult result;
+  parse("/* trace_id=abc-123 */ select * from t where a = 1", result, buf1_);
+  ASSERT_EQ(ObString::make_string("abc-123"), result.get_trace_id());
+
+  // the value of another length is taken from the new sql
+  const int64_t hit_count = cache->hit_count_;
+  ObSqlParseResult hit_result;
+  parse("/* trace_id=x-9 */ select * from t where a = 1", hit_result, buf2_);
+  ASSERT_EQ(hit_count + 1, cache->hit_count_);
+  ASSERT_EQ(ObString::make_string("x-9"), hit_result.get_trace_id());
+  ASSERT_EQ(ObString::make_string("t"), hit_result.get_table_name());
+}
+
+TEST_F(TestSqlParseCache, test_bypass)
+{
+  ObSqlParseCache *cache = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObSqlParseCache::get_or_create_thread_cache(cache));
+  cache->set_mem_limit(0);
+
+  ObSqlParseResult result1;
+  parse("select * from t where a = 1", result1);
+  ASSERT_EQ(1, cache->get_entry_count());
+
+  // a sharding request skips the cache and leaves it as it is
+  ObProxySqlParser sql_parser;
+  ObSqlParseResult result2;
+  ASSERT_EQ(OB_SUCCESS, sql_parser.parse_sql(make_sql("select * from t2 where a = 1", buf2_), NORMAL_PARSE_MODE,
+                                             result2, false, CS_TYPE_UTF8MB4_GENERAL_CI, false, true));
+  ASSERT_EQ(1, cache->get_entry_count());
+
+  const int64_t hit_count = cache->hit_count_;
+  ObSqlParseResult result3;
+  parse("select * from t where a = 2", result3);
+  ASSERT_EQ(hit_count + 1, cache->hit_count_);
+}
+
+TEST_F(TestSqlParseCache, test_evict)
+{
+  char sql[TEST_SQL_BUF_SIZE];
+  ObSqlParseCache *cache = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObSqlParseCache::get_or_create_thread_cache(cache));
+  cache->set_mem_limit(0);
+  const int64_t evict_count = cache->evict_count_;
+
+  ASSERT_TRUE(get_global_proxy_config().sql_parse_cache_mem_limited.set_value("4KB"));
+  for (int64_t i = 0; i < 100; ++i) {
+    snprintf(sql, sizeof(sql), "select * from t_%ld where a = %ld", i, i);
+    ObSqlParseResult result;
+    parse(sql, result);
+    ASSERT_LE(cache->get_mem_used(), 4096);
+  }
+  ASSERT_GT(cache->get_entry_count(), 0);
+  ASSERT_GT(cache->evict_count_, evict_count);
+
+  // the latest one is still there
+  ObSqlParseResult result;
+  const int64_t hit_count = cache->hit_count_;
+  parse("select * from t_99 where a = 1", result);
+  ASSERT_EQ(hit_count + 1, cache->hit_count_);
+  ASSERT_EQ(ObString::make_string("t_99"), result.get_table_name());
+
+  cache->set_mem_limit(0);
+  ASSERT_EQ(0, cache->get_entry_count());
+  ASSERT_EQ(0, cache->get_mem_used());
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
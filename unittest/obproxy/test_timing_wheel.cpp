@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_EVENT
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "iocore/eventsystem/ob_timing_wheel.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace event;
+
+struct TestTimer
+{
+  TestTimer() : id_(0), wheel_entry_() {}
+
+  int64_t id_;
+  ObTimingWheelEntry wheel_entry_;
+  LINK(TestTimer, link_);
+};
+
+typedef ObTimingWheel<TestTimer, TestTimer::Link_link_, &TestTimer::wheel_entry_> TestWheel;
+
+class TestTimingWheel : public ::testing::Test
+{
+public:
+  // advance tick by tick until tick, return the tick of the first expired timer
+  int64_t run_to_first_expired(TestWheel &wheel, const int64_t end_tick, TestTimer *&timer)
+  {
+    int64_t expired_tick = -1;
+    Queue<TestTimer, TestTimer::Link_link_> expired;
+    timer = NULL;
+    for (int64_t tick = wheel.get_cur_tick() + 1; NULL == timer && tick <= end_tick; ++tick) {
+      wheel.advance(wheel.to_time(tick), expired);
+      if (NULL != (timer = expired.dequeue())) {
+        expired_tick = tick;
+      }
+    }
+    return expired_tick;
+  }
+};
+
+TEST_F(TestTimingWheel, test_next_expire_tick_empty)
+{
+  TestWheel wheel;
+  wheel.init(1, 0);
+  ASSERT_EQ(INT64_MAX, wheel.next_expire_tick());
+}
+
+TEST_F(TestTimingWheel, test_next_expire_tick_level_zero)
+{
+  TestWheel wheel;
+  TestTimer timer;
+  wheel.init(1, 0);
+  wheel.schedule(&timer, 10);
+  ASSERT_EQ(10, wheel.next_expire_tick());
+  wheel.remove(&timer);
+  ASSERT_EQ(INT64_MAX, wheel.next_expire_tick());
+}
+
+TEST_F(TestTimingWheel, test_next_expire_tick_mixed_levels)
+{
+  TestWheel wheel;
+  TestTimer near_timer;
+  TestTimer far_timer;
+  TestTimer *timer = NULL;
+  near_timer.id_ = 1;
+  far_timer.id_ = 2;
+  wheel.init(1, 0);
+
+  // at tick 5, tick 69 is 64 ticks away and goes to level 1
+  Queue<TestTimer, TestTimer::Link_link_> expired;
+  wheel.advance(wheel.to_time(5), expired);
+  wheel.schedule(&near_timer, 69);
+  ASSERT_EQ(1, wheel.get_level(near_timer.wheel_entry_.slot_));
+
+  // at tick 50, tick 104 is 54 ticks away and goes to level 0
+  wheel.advance(wheel.to_time(50), expired);
+  ASSERT_TRUE(expired.empty());
+  wheel.schedule(&far_timer, 104);
+  ASSERT_EQ(0, wheel.get_level(far_timer.wheel_entry_.slot_));
+
+  // the level 1 entry cascades down at tick 64, before the level 0 slot of tick 104
+  const int64_t next_tick = wheel.next_expire_tick();
+  ASSERT_EQ(64, next_tick);
+  ASSERT_TRUE(next_tick <= near_timer.wheel_entry_.expire_tick_);
+
+  ASSERT_EQ(69, run_to_first_expired(wheel, 200, timer));
+  ASSERT_EQ(&near_timer, timer);
+  ASSERT_EQ(104, wheel.next_expire_tick());
+  ASSERT_EQ(104, run_to_first_expired(wheel, 200, timer));
+  ASSERT_EQ(&far_timer, timer);
+  ASSERT_EQ(INT64_MAX, wheel.next_expire_tick());
+}
+
+TEST_F(TestTimingWheel, test_next_expire_tick_never_late)
+{
+  const int64_t timer_count = 64;
+  const int64_t max_delta = 5000;
+  TestWheel wheel;
+  TestTimer timers[timer_count];
+  Queue<TestTimer, TestTimer::Link_link_> expired;
+  TestTimer *timer = NULL;
+  wheel.init(1, 0);
+
+  int64_t seed = 7;
+  int64_t cur_tick = 0;
+  for (int64_t i = 0; i < timer_count; ++i) {
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF;
+    timers[i].id_ = i;
+    wheel.schedule(&timers[i], cur_tick + 1 + seed % max_delta);
+    cur_tick += seed % 97;
+    wheel.advance(wheel.to_time(cur_tick), expired);
+    while (NULL != (timer = expired.dequeue())) {
+      ASSERT_TRUE(timer->wheel_entry_.expire_tick_ <= cur_tick);
+    }
+  }
+
+  // sleeping until next_expire_tick() never misses a timer
+  while (wheel.get_count() > 0) {
+    const int64_t next_tick = wheel.next_expire_tick();
+    int64_t min_expire_tick = INT64_MAX;
+    for (int64_t i = 0; i < timer_count; ++i) {
+      if (timers[i].wheel_entry_.is_scheduled()) {
+        min_expire_tick = std::min(min_expire_tick, timers[i].wheel_entry_.expire_tick_);
+      }
+    }
+    ASSERT_TRUE(next_tick <= min_expire_tick);
+    ASSERT_TRUE(next_tick > wheel.get_cur_tick());
+    wheel.advance(wheel.to_time(next_tick), expired);
+    while (NULL != (timer = expired.dequeue())) {
+      ASSERT_EQ(next_tick, timer->wheel_entry_.expire_tick_);
+    }
+  }
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
@@ -1153,6 +1153,177 @@ TEST_F(TestUnixNetVConnection, net_read_signal_and_update)
   EXPECT_TRUE(test_passed_);
 }
 
+ObZeroCopySendRecord *add_zero_copy_record(ObUnixNetVConnection &vc, const uint32_t seq,
+                                            const int64_t bytes, ObIOBufferData *data)
+{
+  ObZeroCopySendRecord *record = op_reclaim_alloc(ObZeroCopySendRecord);
+  if (NULL != record) {
+    record->seq_ = seq;
+    record->bytes_ = bytes;
+    record->data_[0] = data;
+    record->data_count_ = 1;
+    vc.zero_copy_pending_list_.enqueue(record);
+    vc.zero_copy_pending_bytes_ += bytes;
+  }
+  return record;
+}
+
+TEST(TestZeroCopySend, completion_range)
+{
+  INFO_NET("TEST", "completion_range");
+  EXPECT_TRUE(ObUnixNetVConnection::is_zero_copy_send_done(5, 5, 5));
+  EXPECT_TRUE(ObUnixNetVConnection::is_zero_copy_send_done(6, 5, 7));
+  EXPECT_FALSE(ObUnixNetVConnection::is_zero_copy_send_done(4, 5, 7));
+  EXPECT_FALSE(ObUnixNetVConnection::is_zero_copy_send_done(8, 5, 7));
+  // the notification ids wrap around
+  EXPECT_TRUE(ObUnixNetVConnection::is_zero_copy_send_done(UINT32_MAX, UINT32_MAX - 1, 1));
+  EXPECT_TRUE(ObUnixNetVConnection::is_zero_copy_send_done(0, UINT32_MAX - 1, 1));
+  EXPECT_TRUE(ObUnixNetVConnection::is_zero_copy_send_done(1, UINT32_MAX - 1, 1));
+  EXPECT_FALSE(ObUnixNetVConnection::is_zero_copy_send_done(2, UINT32_MAX - 1, 1));
+  EXPECT_FALSE(ObUnixNetVConnection::is_zero_copy_send_done(UINT32_MAX - 2, UINT32_MAX - 1, 1));
+}
+
+TEST(TestZeroCopySend, threshold)
+{
+  INFO_NET("TEST", "threshold");
+  ObUnixNetVConnection vc;
+  EXPECT_FALSE(vc.need_zero_copy_send(1024 * 1024));
+
+  vc.zero_copy_send_min_size_ = 16 * 1024;
+  EXPECT_FALSE(vc.need_zero_copy_send(16 * 1024 - 1));
+  EXPECT_TRUE(vc.need_zero_copy_send(16 * 1024));
+
+  // too much in flight, fall back to copying
+  vc.zero_copy_pending_bytes_ = 4 * 1024 * 1024;
+  EXPECT_FALSE(vc.need_zero_copy_send(1024 * 1024));
+  vc.zero_copy_pending_bytes_ = 4 * 1024 * 1024 - 1;
+  EXPECT_TRUE(vc.need_zero_copy_send(1024 * 1024));
+
+  EXPECT_EQ(OB_INVALID_ARGUMENT, vc.set_zero_copy_send(-1));
+  EXPECT_EQ(OB_SUCCESS, vc.set_zero_copy_send(0));
+  EXPECT_FALSE(vc.need_zero_copy_send(1024 * 1024));
+}
+
+TEST(TestZeroCopySend, completion)
+{
+  INFO_NET("TEST", "completion");
+  ObUnixNetVConnection vc;
+  vc.mutex_ = new_proxy_mutex();
+  vc.zero_copy_send_min_size_ = 1024;
+  ObPtr<ObIOBufferData> data(new_iobufferdata(1024));
+  ASSERT_TRUE(NULL != data.ptr_);
+  ASSERT_EQ(1, data->refcount());
+
+  ASSERT_TRUE(NULL != add_zero_copy_record(vc, 0, 100, data.ptr_));
+  ASSERT_TRUE(NULL != add_zero_copy_record(vc, 1, 200, data.ptr_));
+  ASSERT_TRUE(NULL != add_zero_copy_record(vc, 2, 300, data.ptr_));
+  EXPECT_EQ(4, data->refcount());
+  EXPECT_EQ(600, vc.zero_copy_pending_bytes_);
+
+  // out of order, the buffers are held until the first send completes
+  vc.complete_zero_copy_send(1, 2, false);
+  vc.free_done_zero_copy_send();
+  EXPECT_TRUE(vc.has_zero_copy_send_pending());
+  EXPECT_EQ(600, vc.zero_copy_pending_bytes_);
+  EXPECT_EQ(4, data->refcount());
+
+  vc.complete_zero_copy_send(0, 0, false);
+  vc.free_done_zero_copy_send();
+  EXPECT_FALSE(vc.has_zero_copy_send_pending());
+  EXPECT_EQ(0, vc.zero_copy_pending_bytes_);
+  EXPECT_EQ(1, data->refcount());
+  EXPECT_EQ(1024, vc.zero_copy_send_min_size_);
+
+  // the kernel copied, it is not worth it on this connection
+  ASSERT_TRUE(NULL != add_zero_copy_record(vc, 3, 100, data.ptr_));
+  vc.complete_zero_copy_send(3, 3, true);
+  vc.free_done_zero_copy_send();
+  EXPECT_FALSE(vc.has_zero_copy_send_pending());
+  EXPECT_EQ(1, data->refcount());
+  EXPECT_TRUE(vc.zero_copy_unavailable_);
+  EXPECT_EQ(0, vc.zero_copy_send_min_size_);
+  EXPECT_FALSE(vc.need_zero_copy_send(1024 * 1024));
+  EXPECT_EQ(OB_NOT_SUPPORTED, vc.set_zero_copy_send(1024));
+  vc.mutex_.release();
+}
+
+TEST(TestZeroCopySend, reset_pinned_buffer)
+{
+  INFO_NET("TEST", "reset_pinned_buffer");
+  int64_t written = 0;
+  ObMIOBuffer *buf = new_miobuffer(TEST_G_BUFF_SIZE);
+  ASSERT_TRUE(NULL != buf);
+  ObIOBufferReader *reader = buf->alloc_reader();
+  ASSERT_EQ(OB_SUCCESS, buf->write("abc", 3, written));
+
+  // not referenced elsewhere, rewound in place
+  ObIOBufferData *old_data = buf->writer_->data_.ptr_;
+  buf->reset();
+  EXPECT_EQ(old_data, buf->writer_->data_.ptr_);
+  EXPECT_EQ(0, reader->read_avail());
+
+  // pinned as by a MSG_ZEROCOPY send in flight, the data must stay intact
+  ASSERT_EQ(OB_SUCCESS, buf->write("abc", 3, written));
+  ObPtr<ObIOBufferData> pinned(buf->writer_->data_.ptr_);
+  buf->reset();
+  EXPECT_NE(pinned.ptr_, buf->writer_->data_.ptr_);
+  EXPECT_EQ(0, reader->read_avail());
+  ASSERT_EQ(OB_SUCCESS, buf->write("xyz", 3, written));
+  EXPECT_EQ(0, MEMCMP(pinned->data(), "abc", 3));
+  EXPECT_EQ(3, reader->read_avail());
+  free_miobuffer(buf);
+}
+
+TEST(TestWriteCoalesce, need_coalesce_write)
+{
+  INFO_NET("TEST", "need_coalesce_write");
+  int64_t written = 0;
+  char data[1024];
+  memset(data, 'a', sizeof(data));
+  ObEThread thread;
+  ObPtr<ObProxyMutex> mutex(new_proxy_mutex());
+  thread.mutex_ = mutex.ptr_;
+  ObUnixNetVConnection vc;
+  ObMIOBuffer *buf = new_miobuffer(TEST_G_BUFF_SIZE);
+  ASSERT_TRUE(NULL != buf);
+  ObIOBufferReader *reader = buf->alloc_reader();
+  ASSERT_EQ(OB_SUCCESS, buf->write(data, 100, written));
+  vc.write_.vio_.nbytes_ = 10000;
+  vc.write_.vio_.ndone_ = 0;
+
+  // off by default
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 100));
+
+  // a small write waits once, the next loop always writes
+  vc.set_write_coalesce_size(4096);
+  EXPECT_TRUE(vc.need_coalesce_write(thread, *reader, 100));
+  EXPECT_TRUE(vc.write_coalesced_);
+  EXPECT_EQ(100, vc.write_coalesce_bytes_);
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 100));
+  EXPECT_FALSE(vc.write_coalesced_);
+
+  // no less than the threshold
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 4096));
+  EXPECT_TRUE(vc.need_coalesce_write(thread, *reader, 4095));
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 4095));
+
+  // the last part of the response, nothing more to wait for
+  vc.write_.vio_.ndone_ = 10000 - 100;
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 100));
+  vc.write_.vio_.ndone_ = 0;
+
+  // a full buffer is flushed at once
+  while (buf->current_write_avail() > 0) {
+    ASSERT_EQ(OB_SUCCESS, buf->write(data, std::min(buf->current_write_avail(),
+                                                    static_cast<int64_t>(sizeof(data))), written));
+  }
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 100));
+
+  vc.set_write_coalesce_size(0);
+  EXPECT_FALSE(vc.need_coalesce_write(thread, *reader, 100));
+  free_miobuffer(buf);
+}
+
 } // end of namespace obproxy
 } // end of namespace oceanbase
 
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "proxy/mysql/ob_mysql_vctable.h"
+#include "proxy/mysql/ob_mysql_tunnel.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+using namespace event;
+
+// find_entry() only compares the address, it never touches the vc
+static ObVConnection *fake_vc(const int64_t i)
+{
+  return reinterpret_cast<ObVConnection *>(0x1000 + i);
+}
+
+TEST(TestVIOSlotHint, mask)
+{
+  ObVIO vio;
+  ASSERT_EQ(0, vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 4));
+  ASSERT_EQ(0, vio.get_slot_hint(ObVIO::SLOT_OWNER_TUNNEL, 4));
+
+  vio.set_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 3);
+  ASSERT_EQ(3, vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 4));
+  ASSERT_EQ(1, vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 2));
+  // every owner keeps its own hint
+  ASSERT_EQ(0, vio.get_slot_hint(ObVIO::SLOT_OWNER_TUNNEL, 4));
+
+  // an out of range hint never indexes out of the table
+  vio.set_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 255);
+  ASSERT_EQ(3, vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 4));
+}
+
+TEST(TestVIOSlotHint, vc_table_find_entry)
+{
+  ObMysqlVCTable table;
+  ObVIO read_vio(ObVIO::READ);
+  ObVIO write_vio(ObVIO::WRITE);
+  ObVIO other_vio(ObVIO::READ);
+  ASSERT_EQ(4, ObMysqlVCTable::VC_TABLE_MAX_ENTRIES);
+
+  ObMysqlVCTableEntry *e = table.vc_table_ + 2;
+  e->vc_ = fake_vc(2);
+  e->read_vio_ = &read_vio;
+  e->write_vio_ = &write_vio;
+
+  // hint points to an empty slot, the scan finds the entry and refreshes the hint
+  ASSERT_EQ(e, table.find_entry(&read_vio));
+  ASSERT_EQ(2, read_vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, ObMysqlVCTable::VC_TABLE_MAX_ENTRIES));
+  ASSERT_EQ(e, table.find_entry(&write_vio));
+  ASSERT_EQ(2, write_vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, ObMysqlVCTable::VC_TABLE_MAX_ENTRIES));
+
+  // fast path, the hinted slot matches
+  ASSERT_EQ(e, table.find_entry(&read_vio));
+  ASSERT_EQ(2, read_vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, ObMysqlVCTable::VC_TABLE_MAX_ENTRIES));
+
+  // the entry is reused for another vc in another slot, the stale hint falls back to the scan
+  memset(e, 0, sizeof(*e));
+  ObMysqlVCTableEntry *new_e = table.vc_table_ + 1;
+  new_e->vc_ = fake_vc(1);
+  new_e->read_vio_ = &read_vio;
+  ASSERT_EQ(new_e, table.find_entry(&read_vio));
+  ASSERT_EQ(1, read_vio.get_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, ObMysqlVCTable::VC_TABLE_MAX_ENTRIES));
+
+  // a hinted slot which holds another vio is not trusted
+  other_vio.set_slot_hint(ObVIO::SLOT_OWNER_VC_TABLE, 1);
+  ASSERT_TRUE(NULL == table.find_entry(&other_vio));
+  ASSERT_TRUE(NULL == table.find_entry(static_cast<ObVIO *>(NULL)));
+
+  // a slot whose vc is gone is not matched even if its vio is left
+  new_e->vc_ = NULL;
+  ASSERT_TRUE(NULL == table.find_entry(&read_vio));
+}
+
+TEST(TestVIOSlotHint, tunnel_producer_consumer)
+{
+  ObMysqlTunnel tunnel;
+  ObVIO read_vio(ObVIO::READ);
+  ObVIO write_vio(ObVIO::WRITE);
+  ObVIO other_vio(ObVIO::WRITE);
+
+  tunnel.producers_[1].read_vio_ = &read_vio;
+  tunnel.consumers_[3].write_vio_ = &write_vio;
+
+  // fallback, then fast path with the refreshed hint
+  ASSERT_EQ(tunnel.producers_ + 1, tunnel.get_producer(&read_vio));
+  ASSERT_EQ(1, read_vio.get_slot_hint(ObVIO::SLOT_OWNER_TUNNEL, ObMysqlTunnel::MAX_PRODUCERS));
+  ASSERT_EQ(tunnel.producers_ + 1, tunnel.get_producer(&read_vio));
+  ASSERT_EQ(tunnel.consumers_ + 3, tunnel.get_consumer(&write_vio));
+  ASSERT_EQ(3, write_vio.get_slot_hint(ObVIO::SLOT_OWNER_TUNNEL, ObMysqlTunnel::MAX_CONSUMERS));
+  ASSERT_EQ(tunnel.consumers_ + 3, tunnel.get_consumer(&write_vio));
+
+  // the consumer hint 3 is masked to a valid producer slot, and is not trusted there
+  ASSERT_TRUE(NULL == tunnel.get_producer(&write_vio));
+  ASSERT_EQ(3, write_vio.get_slot_hint(ObVIO::SLOT_OWNER_TUNNEL, ObMysqlTunnel::MAX_CONSUMERS));
+
+  // the consumer moves to another slot
+  tunnel.consumers_[3].write_vio_ = NULL;
+  tunnel.consumers_[0].write_vio_ = &write_vio;
+  ASSERT_EQ(tunnel.consumers_, tunnel.get_consumer(&write_vio));
+  ASSERT_EQ(0, write_vio.get_slot_hint(ObVIO::SLOT_OWNER_TUNNEL, ObMysqlTunnel::MAX_CONSUMERS));
+
+  ASSERT_TRUE(NULL == tunnel.get_consumer(&other_vio));
+  ASSERT_TRUE(NULL == tunnel.get_consumer(static_cast<ObVIO *>(NULL)));
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}